@@ -0,0 +1,273 @@
+/*
+** bench/bench.c -- Benchmark driver: option parsing, timing, statistics
+**                  and CSV/JSON output.
+**
+** Usage: ds_bench [--format=csv|json] [--min-size=N] [--max-size=N]
+**                 [--reps=R] [--seed=S] [--filter=SUBSTR]
+*/
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_MIN_SIZE 1000
+#define BENCH_DEFAULT_MAX_SIZE 1000000
+#define BENCH_DEFAULT_REPS     5
+#define BENCH_DEFAULT_SEED     0x9E3779B97F4A7C15ull
+
+static const char *const g_pattern_names[BENCH_NUM_PATTERNS] = {
+  "sequential", "random", "reversed"
+};
+
+/* ===================== Helpers shared with the cases ===================== */
+
+int bench_key_compare(const void *a, const void *b) {
+  intptr_t x = BENCH_VAL(a), y = BENCH_VAL(b);
+  return (x > y) - (x < y);
+}
+
+uint64_t bench_rand(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *state = x;
+  return x * 0x2545F4914F6CDD1Dull;
+}
+
+static const void *volatile g_sink;
+
+void bench_sink(const void *p) {
+  g_sink = p;
+}
+
+/* ===================== Counting allocator ===================== */
+
+typedef struct {
+  size_t live;
+  size_t peak;
+} bench_mem_t;
+
+static void mem_track(bench_mem_t *mem, size_t add, size_t sub) {
+  mem->live = mem->live + add - sub;
+  if (mem->live > mem->peak) mem->peak = mem->live;
+}
+
+static void *mem_alloc(void *ctx, size_t size) {
+  void *p = malloc(size);
+  if (p) mem_track(ctx, size, 0);
+  return p;
+}
+
+static void *mem_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  void *p = realloc(ptr, new_size);
+  if (p) mem_track(ctx, new_size, old_size);
+  return p;
+}
+
+static void mem_free(void *ctx, void *ptr, size_t size) {
+  if (!ptr) return;
+  free(ptr);
+  mem_track(ctx, 0, size);
+}
+
+/* ===================== Timing and statistics ===================== */
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int double_compare(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, size_t count, double p) {
+  if (count == 0) return 0.0;
+  size_t idx = (size_t)(p * (double)(count - 1) + 0.5);
+  return sorted[idx];
+}
+
+typedef struct {
+  double ops_per_sec;
+  double p50, p90, p99;
+  double bytes_per_elem;
+} bench_result_t;
+
+/**
+ * @brief Fill keys[0..n) with 1..n in the requested order.
+ */
+static void make_keys(intptr_t *keys, size_t n, bench_pattern_t pattern, uint64_t seed) {
+  for (size_t i = 0; i < n; ++ i) {
+    keys[i] = pattern == BENCH_REVERSED ? (intptr_t)(n - i) : (intptr_t)(i + 1);
+  }
+  if (pattern == BENCH_RANDOM) {
+    uint64_t state = seed ? seed : 1;   // xorshift never leaves 0
+    for (size_t i = n - 1; i > 0; -- i) {
+      size_t j = (size_t)(bench_rand(&state) % (i + 1));
+      intptr_t tmp = keys[i];
+      keys[i] = keys[j];
+      keys[j] = tmp;
+    }
+  }
+}
+
+/**
+ * @brief Run one case for one (n, pattern) and compute its statistics.
+ *
+ * @return false if the case could not be set up.
+ */
+static bool run_case(const bench_case_t *bc, bench_env_t *env, size_t reps, bench_result_t *out) {
+  size_t chunk = bc->whole ? env->n : BENCH_CHUNK;
+  size_t chunks_per_rep = (env->n + chunk - 1) / chunk;
+  double *samples = malloc(sizeof(double) * chunks_per_rep * reps);
+  if (!samples) return false;
+
+  bench_mem_t mem = { 0, 0 };
+  ds_allocator_t alloc = { mem_alloc, mem_realloc, mem_free, &mem };
+  env->alloc = &alloc;
+
+  size_t count = 0;
+  size_t peak = 0;
+  double total_ns = 0.0;
+
+  for (size_t r = 0; r < reps; ++ r) {
+    mem.live = mem.peak = 0;
+    void *state = bc->setup(env);
+    if (!state) {
+      free(samples);
+      return false;
+    }
+
+    for (size_t begin = 0; begin < env->n; begin += chunk) {
+      size_t end = begin + chunk < env->n ? begin + chunk : env->n;
+      double t0 = now_ns();
+      bc->run(state, begin, end);
+      double dt = now_ns() - t0;
+      total_ns += dt;
+      samples[count ++] = dt / (double)(end - begin);
+    }
+
+    if (mem.peak > peak) peak = mem.peak;
+    bc->teardown(state);
+  }
+
+  qsort(samples, count, sizeof(double), double_compare);
+  out->ops_per_sec = total_ns > 0.0 ? (double)(env->n * reps) * 1e9 / total_ns : 0.0;
+  out->p50 = percentile(samples, count, 0.50);
+  out->p90 = percentile(samples, count, 0.90);
+  out->p99 = percentile(samples, count, 0.99);
+  out->bytes_per_elem = (double)peak / (double)env->n;
+
+  free(samples);
+  return true;
+}
+
+/* ===================== Output ===================== */
+
+typedef enum { FORMAT_CSV, FORMAT_JSON } bench_format_t;
+
+static void print_header(bench_format_t format) {
+  if (format == FORMAT_CSV) {
+    printf("name,pattern,n,reps,ops_per_sec,ns_p50,ns_p90,ns_p99,bytes_per_elem\n");
+  } else {
+    printf("[\n");
+  }
+}
+
+static void print_result(bench_format_t format, bool first, const char *name, const char *pattern,
+                         size_t n, size_t reps, const bench_result_t *res) {
+  if (format == FORMAT_CSV) {
+    printf("%s,%s,%zu,%zu,%.0f,%.2f,%.2f,%.2f,%.2f\n",
+           name, pattern, n, reps, res->ops_per_sec, res->p50, res->p90, res->p99,
+           res->bytes_per_elem);
+  } else {
+    printf("%s  {\"name\": \"%s\", \"pattern\": \"%s\", \"n\": %zu, \"reps\": %zu, "
+           "\"ops_per_sec\": %.0f, \"ns_p50\": %.2f, \"ns_p90\": %.2f, \"ns_p99\": %.2f, "
+           "\"bytes_per_elem\": %.2f}",
+           first ? "" : ",\n", name, pattern, n, reps, res->ops_per_sec,
+           res->p50, res->p90, res->p99, res->bytes_per_elem);
+  }
+  fflush(stdout);
+}
+
+static void print_footer(bench_format_t format) {
+  if (format == FORMAT_JSON) printf("\n]\n");
+}
+
+/* ===================== main ===================== */
+
+static bool parse_size(const char *arg, const char *prefix, size_t *out) {
+  size_t len = strlen(prefix);
+  if (strncmp(arg, prefix, len) != 0) return false;
+  *out = (size_t)strtoull(arg + len, NULL, 0);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  bench_format_t format = FORMAT_CSV;
+  size_t min_size = BENCH_DEFAULT_MIN_SIZE;
+  size_t max_size = BENCH_DEFAULT_MAX_SIZE;
+  size_t reps = BENCH_DEFAULT_REPS;
+  size_t seed = (size_t)BENCH_DEFAULT_SEED;
+  const char *filter = NULL;
+
+  for (int i = 1; i < argc; ++ i) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "--format=csv") == 0) format = FORMAT_CSV;
+    else if (strcmp(arg, "--format=json") == 0) format = FORMAT_JSON;
+    else if (strncmp(arg, "--filter=", 9) == 0) filter = arg + 9;
+    else if (parse_size(arg, "--min-size=", &min_size)) {}
+    else if (parse_size(arg, "--max-size=", &max_size)) {}
+    else if (parse_size(arg, "--reps=", &reps)) {}
+    else if (parse_size(arg, "--seed=", &seed)) {}
+    else {
+      fprintf(stderr, "usage: %s [--format=csv|json] [--min-size=N] [--max-size=N] "
+                      "[--reps=R] [--seed=S] [--filter=SUBSTR]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (reps == 0) reps = 1;
+  if (min_size == 0) min_size = 1;
+
+  intptr_t *keys = malloc(sizeof(intptr_t) * max_size);
+  if (!keys) {
+    fprintf(stderr, "cannot allocate %zu keys\n", max_size);
+    return 1;
+  }
+
+  print_header(format);
+  bool first = true;
+
+  // Sizes go up by decades: 1K, 10K, ..., max_size
+  for (size_t n = min_size; n <= max_size; n = n > max_size / 10 ? max_size + 1 : n * 10) {
+    for (int p = 0; p < BENCH_NUM_PATTERNS; ++ p) {
+      make_keys(keys, n, (bench_pattern_t)p, (uint64_t)seed);
+      bench_env_t env = { n, (bench_pattern_t)p, keys, NULL, (uint64_t)seed };
+
+      for (size_t c = 0; c < bench_num_cases; ++ c) {
+        const bench_case_t *bc = &bench_cases[c];
+        if (filter && !strstr(bc->name, filter)) continue;
+        if (!bc->patterned && p != BENCH_SEQUENTIAL) continue;
+        if (bc->max_sorted_n && p != BENCH_RANDOM && n > bc->max_sorted_n) continue;
+
+        bench_result_t res;
+        if (!run_case(bc, &env, reps, &res)) {
+          fprintf(stderr, "%s: setup failed for n=%zu\n", bc->name, n);
+          continue;
+        }
+        print_result(format, first, bc->name, bc->patterned ? g_pattern_names[p] : "-",
+                     n, reps, &res);
+        first = false;
+      }
+    }
+  }
+
+  print_footer(format);
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+** bench/bench.h -- A small microbenchmark harness for the containers.
+*/
+
+#ifndef DS_BENCH_H
+#define DS_BENCH_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Benchmark harness
+ * -------------------------------------------------------------------------
+ *
+ * A benchmark case is three callbacks:
+ *
+ *   setup(env)              -> state   (not timed; builds the container)
+ *   run(state, begin, end)             (timed; performs ops [begin, end))
+ *   teardown(state)                    (not timed)
+ *
+ * For every case, input size n and key pattern, the harness runs `reps`
+ * repetitions. Each repetition calls run() in chunks of BENCH_CHUNK ops and
+ * times every chunk, which gives:
+ *   - ops/sec          total ops / total timed seconds
+ *   - ns/op p50/p90/p99 over all chunks of all repetitions
+ *   - bytes/element    peak bytes held through env->alloc, divided by n
+ *
+ * Cases whose work cannot be split (a sort) set `whole`: run(state, 0, n)
+ * is timed once per repetition, and the percentiles are over the
+ * repetitions' per-element times.
+ *
+ * Keys are non-zero integers stored directly in the `void *` element
+ * (BENCH_KEY / BENCH_VAL), so the containers are measured without one
+ * malloc per element. Patterns:
+ *   - sequential  1, 2, ..., n     (sorted input: the adversarial case
+ *                                   for unbalanced trees)
+ *   - random      a fixed-seed shuffle of 1..n
+ *   - reversed    n, ..., 2, 1     (worst case for sift-up in a min-heap)
+ * -------------------------------------------------------------------------
+ */
+
+#define BENCH_CHUNK 256
+
+#define BENCH_KEY(v) ((void *)(intptr_t)(v))
+#define BENCH_VAL(p) ((intptr_t)(p))
+
+typedef enum {
+  BENCH_SEQUENTIAL,
+  BENCH_RANDOM,
+  BENCH_REVERSED,
+  BENCH_NUM_PATTERNS
+} bench_pattern_t;
+
+/**
+ * @brief Everything a case needs to build its input.
+ */
+typedef struct {
+  size_t n;                      // Number of elements / operations
+  bench_pattern_t pattern;
+  const intptr_t *keys;          // n keys in pattern order
+  const ds_allocator_t *alloc;   // Counting allocator; pass to *_create_ex
+  uint64_t seed;
+} bench_env_t;
+
+typedef struct {
+  const char *name;
+  bool patterned;                // false: only run with BENCH_SEQUENTIAL
+  size_t max_sorted_n;           // If non-zero, skip non-random patterns above this n
+  void *(*setup)(const bench_env_t *env);
+  void (*run)(void *state, size_t begin, size_t end);
+  void (*teardown)(void *state);
+  bool whole;                    // true: one run(state, 0, n) per repetition
+} bench_case_t;
+
+/* Defined by the bench_*.c files */
+extern const bench_case_t bench_cases[];
+extern const size_t bench_num_cases;
+
+/**
+ * @brief Compare two BENCH_KEY elements (ascending).
+ */
+int bench_key_compare(const void *a, const void *b);
+
+/**
+ * @brief xorshift64* step; deterministic for a given seed.
+ */
+uint64_t bench_rand(uint64_t *state);
+
+/**
+ * @brief Keep the compiler from discarding a computed value.
+ */
+void bench_sink(const void *p);
+
+#endif // !DS_BENCH_H
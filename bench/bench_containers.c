@@ -0,0 +1,664 @@
+/*
+** bench/bench_containers.c -- Benchmark cases for the containers and for
+**                             plain C array baselines.
+*/
+
+#include "bench.h"
+#include "ds_bst.h"
+#include "ds_deque.h"
+#include "ds_deque_inline.h"
+#include "ds_generic.h"
+#include "ds_hashmap.h"
+#include "ds_heap.h"
+#include "ds_ilist.h"
+#include "ds_itree.h"
+#include "ds_list.h"
+#include "ds_rbtree.h"
+#include "ds_simd.h"
+#include "ds_ulist.h"
+#include "ds_vec.h"
+#include "ds_vector.h"
+#include "ds_vector_inline.h"
+#include <stdlib.h>
+
+/*
+ * Caller-owned element for the intrusive containers: the key and the
+ * links live in one object, as they would in user code.
+ */
+typedef struct {
+  intptr_t key;
+  ds_itree_link_t tlink;
+  ds_ilist_link_t llink;
+} bench_item_t;
+
+/*
+ * One state type for every case; each case uses the fields it needs.
+ */
+typedef struct {
+  const bench_env_t *env;
+  void *container;
+  ds_list_iter_t it;             // List traversal cursor
+  ds_ulist_iter_t uit;           // Unrolled list traversal cursor
+  bench_item_t *items;           // Elements for the intrusive containers
+  ds_ilist_t ilist;
+  ds_ilist_link_t *ilink;        // Intrusive list traversal cursor
+  ds_itree_t itree;
+  intptr_t *array;               // Baseline storage
+  size_t len, cap;
+  intptr_t acc;                  // Accumulator fed to bench_sink()
+} bench_state_t;
+
+static bench_state_t *state_new(const bench_env_t *env) {
+  bench_state_t *s = calloc(1, sizeof(bench_state_t));
+  if (s) s->env = env;
+  return s;
+}
+
+static void state_sink(bench_state_t *s) {
+  bench_sink((const void *)s->acc);
+  free(s);
+}
+
+/* ===================== Baseline: plain C array ===================== */
+
+static void *array_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->cap = 16;
+  s->array = ds_mem_alloc(env->alloc, sizeof(intptr_t) * s->cap);
+  if (!s->array) { free(s); return NULL; }
+  return s;
+}
+
+static void *array_setup_full(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->cap = s->len = env->n;
+  s->array = ds_mem_alloc(env->alloc, sizeof(intptr_t) * s->cap);
+  if (!s->array) { free(s); return NULL; }
+  for (size_t i = 0; i < env->n; ++ i) s->array[i] = env->keys[i];
+  return s;
+}
+
+static void array_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    if (s->len == s->cap) {
+      s->array = ds_mem_realloc(s->env->alloc, s->array, sizeof(intptr_t) * s->cap,
+                                sizeof(intptr_t) * s->cap * 2);
+      s->cap *= 2;
+    }
+    s->array[s->len ++] = s->env->keys[i];
+  }
+}
+
+static void array_index_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) s->acc += s->array[(size_t)s->env->keys[i] - 1];
+}
+
+/*
+ * Sort cases are `whole`: one call sorts all n elements, and ns/op is the
+ * time per element sorted.
+ */
+static int intptr_compare(const void *a, const void *b) {
+  intptr_t x = *(const intptr_t *)a, y = *(const intptr_t *)b;
+  return (x > y) - (x < y);
+}
+
+static void array_qsort_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  (void)begin; (void)end;
+  qsort(s->array, s->len, sizeof(intptr_t), intptr_compare);
+}
+
+static void array_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_mem_free(s->env->alloc, s->array, sizeof(intptr_t) * s->cap);
+  state_sink(s);
+}
+
+/* ===================== ds_vector ===================== */
+
+static void *vector_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_vector_create_ex(0, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void *vector_setup_full(const bench_env_t *env) {
+  bench_state_t *s = vector_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_vector_push_back(s->container, BENCH_KEY(env->keys[i]));
+  return s;
+}
+
+static void vector_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_vector_push_back(s->container, BENCH_KEY(s->env->keys[i]));
+}
+
+static void vector_get_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += BENCH_VAL(ds_vector_get(s->container, (size_t)s->env->keys[i] - 1));
+  }
+}
+
+static void vector_get_unsafe_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += BENCH_VAL(ds_vector_get_unsafe(s->container, (size_t)s->env->keys[i] - 1));
+  }
+}
+
+static void vector_sort_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  (void)begin; (void)end;
+  ds_vector_sort(s->container, bench_key_compare);
+}
+
+static void vector_sort_addr_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  (void)begin; (void)end;
+  ds_vector_sort(s->container, NULL);
+}
+
+static void vector_parallel_sort_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  (void)begin; (void)end;
+  ds_vector_parallel_sort(s->container, bench_key_compare, 0);
+}
+
+static void vector_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_vector_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+/* ===================== ds_vec (by value) ===================== */
+
+DS_VEC_DEFINE(bench_ivec, intptr_t)
+
+static void *vec_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_vec_create_ex(sizeof(intptr_t), 0, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void vec_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) bench_ivec_push(s->container, s->env->keys[i]);
+}
+
+static void vec_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_vec_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+/*
+ * Column scan: each op is one element of an int32 ds_vec column passed
+ * through ds_simd_count_i32, once with the dispatched kernels and once
+ * forced to the scalar ones.
+ */
+static void *vec_setup_column(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_vec_create_ex(sizeof(int32_t), env->n, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  for (size_t i = 0; i < env->n; ++ i) {
+    int32_t v = (int32_t)(env->keys[i] & 15);
+    ds_vec_push_back(s->container, &v);
+  }
+  return s;
+}
+
+static void *vec_setup_column_scalar(const bench_env_t *env) {
+  ds_simd_force_isa(DS_SIMD_SCALAR);
+  return vec_setup_column(env);
+}
+
+static void vec_count_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  const int32_t *col = ds_vec_data(s->container);
+  s->acc += ds_simd_count_i32(col + begin, end - begin, 7);
+}
+
+static void vec_column_teardown(void *p) {
+  // Undo a forced ISA: the widest one is always the default
+  const ds_simd_isa_t order[] = { DS_SIMD_AVX2, DS_SIMD_NEON, DS_SIMD_SSE2 };
+  for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); ++ i) {
+    if (ds_simd_force_isa(order[i]) == DS_OK) break;
+  }
+  vec_teardown(p);
+}
+
+/* ===================== ds_deque ===================== */
+
+static void *deque_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_deque_create_ex(0, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void deque_push_front_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_deque_push_front(s->container, BENCH_KEY(s->env->keys[i]));
+}
+
+/* FIFO churn: one push_back and one pop_front per op, queue depth ~64 */
+static void deque_fifo_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    ds_deque_push_back(s->container, BENCH_KEY(s->env->keys[i]));
+    if (i >= 64) s->acc += BENCH_VAL(ds_deque_pop_front(s->container));
+  }
+}
+
+static void deque_fifo_fast_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    ds_deque_push_back_fast(s->container, BENCH_KEY(s->env->keys[i]));
+    if (i >= 64) s->acc += BENCH_VAL(ds_deque_pop_front_unsafe(s->container));
+  }
+}
+
+static void deque_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_deque_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+/* ===================== ds_heap ===================== */
+
+static void *heap_setup_arity(const bench_env_t *env, size_t arity, bool fill) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_heap_create_ex(bench_key_compare, 0, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  ds_heap_set_arity(s->container, arity);
+  if (fill) {
+    for (size_t i = 0; i < env->n; ++ i) ds_heap_push(s->container, BENCH_KEY(env->keys[i]));
+  }
+  return s;
+}
+
+static void *heap_setup_empty(const bench_env_t *env)  { return heap_setup_arity(env, 2, false); }
+static void *heap_setup_full(const bench_env_t *env)   { return heap_setup_arity(env, 2, true); }
+static void *heap4_setup_empty(const bench_env_t *env) { return heap_setup_arity(env, 4, false); }
+static void *heap4_setup_full(const bench_env_t *env)  { return heap_setup_arity(env, 4, true); }
+static void *heap8_setup_empty(const bench_env_t *env) { return heap_setup_arity(env, 8, false); }
+static void *heap8_setup_full(const bench_env_t *env)  { return heap_setup_arity(env, 8, true); }
+
+static void heap_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_heap_push(s->container, BENCH_KEY(s->env->keys[i]));
+}
+
+static void heap_pop_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) s->acc += BENCH_VAL(ds_heap_pop(s->container));
+}
+
+static void heap_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_heap_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+/* ===================== DS_DEFINE_HEAP (inlined comparison) ===================== */
+
+DS_DEFINE_HEAP(bench_gheap, intptr_t, a < b)
+
+static void *gheap_setup(const bench_env_t *env, bool fill) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  bench_gheap_t *h = malloc(sizeof(bench_gheap_t));
+  if (!h) { free(s); return NULL; }
+  bench_gheap_init(h, env->alloc);
+  if (fill) {
+    for (size_t i = 0; i < env->n; ++ i) bench_gheap_push(h, env->keys[i]);
+  }
+  s->container = h;
+  return s;
+}
+
+static void *gheap_setup_empty(const bench_env_t *env) { return gheap_setup(env, false); }
+static void *gheap_setup_full(const bench_env_t *env)  { return gheap_setup(env, true); }
+
+static void gheap_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) bench_gheap_push(s->container, s->env->keys[i]);
+}
+
+static void gheap_pop_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  intptr_t v = 0;
+  for (size_t i = begin; i < end; ++ i) {
+    bench_gheap_pop(s->container, &v);
+    s->acc += v;
+  }
+}
+
+static void gheap_teardown(void *p) {
+  bench_state_t *s = p;
+  bench_gheap_destroy(s->container);
+  free(s->container);
+  state_sink(s);
+}
+
+/* ===================== ds_bst / ds_rbtree ===================== */
+
+static void *bst_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_bst_create_ex(bench_key_compare, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void *bst_setup_full(const bench_env_t *env) {
+  bench_state_t *s = bst_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_bst_insert(s->container, BENCH_KEY(env->keys[i]));
+  return s;
+}
+
+static void bst_insert_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_bst_insert(s->container, BENCH_KEY(s->env->keys[i]));
+}
+
+static void bst_search_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += BENCH_VAL(ds_bst_search(s->container, BENCH_KEY(s->env->keys[i])));
+  }
+}
+
+static void bst_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_bst_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+static void *rbtree_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_rbtree_create_ex(bench_key_compare, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void *rbtree_setup_full(const bench_env_t *env) {
+  bench_state_t *s = rbtree_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_rbtree_insert(s->container, BENCH_KEY(env->keys[i]));
+  return s;
+}
+
+static void rbtree_insert_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_rbtree_insert(s->container, BENCH_KEY(s->env->keys[i]));
+}
+
+static void rbtree_search_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += BENCH_VAL(ds_rbtree_search(s->container, BENCH_KEY(s->env->keys[i])));
+  }
+}
+
+static void rbtree_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_rbtree_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+/* ===================== ds_hashmap ===================== */
+
+static size_t bench_key_hash(const void *k) {
+  return (size_t)BENCH_VAL(k);
+}
+
+static bool bench_key_equal(const void *a, const void *b) {
+  return a == b;
+}
+
+static void *hashmap_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_hashmap_create_ex(bench_key_hash, bench_key_equal, 0, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void *hashmap_setup_full(const bench_env_t *env) {
+  bench_state_t *s = hashmap_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_hashmap_insert(s->container, BENCH_KEY(env->keys[i]), NULL);
+  return s;
+}
+
+static void hashmap_insert_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_hashmap_insert(s->container, BENCH_KEY(s->env->keys[i]), NULL);
+}
+
+static void hashmap_search_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += ds_hashmap_contains(s->container, BENCH_KEY(s->env->keys[i]));
+  }
+}
+
+static void hashmap_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_hashmap_destroy(s->container, NULL, NULL);
+  state_sink(s);
+}
+
+/* ===================== ds_itree / ds_ilist ===================== */
+
+static int itree_compare(const ds_itree_link_t *a, const ds_itree_link_t *b) {
+  intptr_t x = DS_CONTAINER_OF(a, bench_item_t, tlink)->key;
+  intptr_t y = DS_CONTAINER_OF(b, bench_item_t, tlink)->key;
+  return (x > y) - (x < y);
+}
+
+static int itree_key_compare(const void *key, const ds_itree_link_t *l) {
+  intptr_t x = BENCH_VAL(key), y = DS_CONTAINER_OF(l, bench_item_t, tlink)->key;
+  return (x > y) - (x < y);
+}
+
+/* Elements are allocated up front and outside env->alloc, so bytes/element
+ * reports what the container itself allocates: nothing. */
+static void *intrusive_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->items = malloc(sizeof(bench_item_t) * (env->n ? env->n : 1));
+  if (!s->items) { free(s); return NULL; }
+  for (size_t i = 0; i < env->n; ++ i) {
+    s->items[i].key = env->keys[i];
+    ds_ilist_link_init(&s->items[i].llink);
+  }
+  ds_itree_init(&s->itree, itree_compare);
+  ds_ilist_init(&s->ilist);
+  return s;
+}
+
+static void *itree_setup_full(const bench_env_t *env) {
+  bench_state_t *s = intrusive_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_itree_insert(&s->itree, &s->items[i].tlink);
+  return s;
+}
+
+static void itree_insert_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_itree_insert(&s->itree, &s->items[i].tlink);
+}
+
+static void itree_search_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    ds_itree_link_t *l = ds_itree_find(&s->itree, BENCH_KEY(s->env->keys[i]), itree_key_compare);
+    s->acc += DS_CONTAINER_OF(l, bench_item_t, tlink)->key;
+  }
+}
+
+static void *ilist_setup_full(const bench_env_t *env) {
+  bench_state_t *s = intrusive_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_ilist_push_back(&s->ilist, &s->items[i].llink);
+  s->ilink = ds_ilist_front(&s->ilist);
+  return s;
+}
+
+static void ilist_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_ilist_push_back(&s->ilist, &s->items[i].llink);
+}
+
+static void ilist_traverse_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += DS_CONTAINER_OF(s->ilink, bench_item_t, llink)->key;
+    s->ilink = ds_ilist_next(&s->ilist, s->ilink);
+  }
+}
+
+static void intrusive_teardown(void *p) {
+  bench_state_t *s = p;
+  free(s->items);
+  state_sink(s);
+}
+
+/* ===================== ds_list ===================== */
+
+static void *list_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_list_create_ex(env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void *list_setup_full(const bench_env_t *env) {
+  bench_state_t *s = list_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_list_push_back(s->container, BENCH_KEY(env->keys[i]));
+  s->it = ds_list_iter_begin(s->container);
+  return s;
+}
+
+static void list_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_list_push_back(s->container, BENCH_KEY(s->env->keys[i]));
+}
+
+/* One op = visit one node; the cursor carries over between chunks */
+static void list_traverse_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += BENCH_VAL(ds_list_iter_get(s->it));
+    s->it = ds_list_iter_next(s->it);
+  }
+}
+
+static void list_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_list_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+/* ===================== ds_ulist ===================== */
+
+static void *ulist_setup_empty(const bench_env_t *env) {
+  bench_state_t *s = state_new(env);
+  if (!s) return NULL;
+  s->container = ds_ulist_create_ex(0, env->alloc);
+  if (!s->container) { free(s); return NULL; }
+  return s;
+}
+
+static void *ulist_setup_full(const bench_env_t *env) {
+  bench_state_t *s = ulist_setup_empty(env);
+  if (!s) return NULL;
+  for (size_t i = 0; i < env->n; ++ i) ds_ulist_push_back(s->container, BENCH_KEY(env->keys[i]));
+  s->uit = ds_ulist_iter_begin(s->container);
+  return s;
+}
+
+static void ulist_push_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) ds_ulist_push_back(s->container, BENCH_KEY(s->env->keys[i]));
+}
+
+static void ulist_traverse_run(void *p, size_t begin, size_t end) {
+  bench_state_t *s = p;
+  for (size_t i = begin; i < end; ++ i) {
+    s->acc += BENCH_VAL(ds_ulist_iter_get(s->uit));
+    s->uit = ds_ulist_iter_next(s->uit);
+  }
+}
+
+static void ulist_teardown(void *p) {
+  bench_state_t *s = p;
+  ds_ulist_destroy(s->container, NULL);
+  state_sink(s);
+}
+
+/* ===================== Case table ===================== */
+
+/* Unbalanced BST on sorted input is O(n^2): cap the non-random sizes. */
+#define BST_MAX_SORTED_N 10000
+
+const bench_case_t bench_cases[] = {
+  { "baseline_array_push", false, 0, array_setup_empty,  array_push_run,       array_teardown,  false },
+  { "baseline_array_index", true, 0, array_setup_full,   array_index_run,      array_teardown,  false },
+  { "vector_push_back",    false, 0, vector_setup_empty, vector_push_run,      vector_teardown, false },
+  { "vector_get",           true, 0, vector_setup_full,  vector_get_run,       vector_teardown, false },
+  { "vector_get_unsafe",    true, 0, vector_setup_full,  vector_get_unsafe_run, vector_teardown, false },
+  { "baseline_array_qsort", true, 0, array_setup_full,   array_qsort_run,      array_teardown,  true },
+  { "vector_sort",          true, 0, vector_setup_full,  vector_sort_run,      vector_teardown, true },
+  { "vector_sort_addr",     true, 0, vector_setup_full,  vector_sort_addr_run, vector_teardown, true },
+  { "vector_parallel_sort", true, 0, vector_setup_full,  vector_parallel_sort_run, vector_teardown, true },
+  { "vec_count_simd",      false, 0, vec_setup_column,   vec_count_run,        vec_column_teardown, false },
+  { "vec_count_scalar",    false, 0, vec_setup_column_scalar, vec_count_run,   vec_column_teardown, false },
+  { "vec_push_back",       false, 0, vec_setup_empty,    vec_push_run,         vec_teardown,    false },
+  { "deque_push_front",    false, 0, deque_setup_empty,  deque_push_front_run, deque_teardown,  false },
+  { "deque_fifo",          false, 0, deque_setup_empty,  deque_fifo_run,       deque_teardown,  false },
+  { "deque_fifo_fast",     false, 0, deque_setup_empty,  deque_fifo_fast_run,  deque_teardown,  false },
+  { "heap_push",            true, 0, heap_setup_empty,   heap_push_run,        heap_teardown,   false },
+  { "heap_pop",             true, 0, heap_setup_full,    heap_pop_run,         heap_teardown,   false },
+  { "heap4_push",           true, 0, heap4_setup_empty,  heap_push_run,        heap_teardown,   false },
+  { "heap4_pop",            true, 0, heap4_setup_full,   heap_pop_run,         heap_teardown,   false },
+  { "heap8_push",           true, 0, heap8_setup_empty,  heap_push_run,        heap_teardown,   false },
+  { "heap8_pop",            true, 0, heap8_setup_full,   heap_pop_run,         heap_teardown,   false },
+  { "gheap_push",           true, 0, gheap_setup_empty,  gheap_push_run,       gheap_teardown,  false },
+  { "gheap_pop",            true, 0, gheap_setup_full,   gheap_pop_run,        gheap_teardown,  false },
+  { "bst_insert",           true, BST_MAX_SORTED_N, bst_setup_empty, bst_insert_run, bst_teardown, false },
+  { "bst_search",           true, BST_MAX_SORTED_N, bst_setup_full,  bst_search_run, bst_teardown, false },
+  { "rbtree_insert",        true, 0, rbtree_setup_empty, rbtree_insert_run,    rbtree_teardown, false },
+  { "rbtree_search",        true, 0, rbtree_setup_full,  rbtree_search_run,    rbtree_teardown, false },
+  { "hashmap_insert",       true, 0, hashmap_setup_empty, hashmap_insert_run,  hashmap_teardown, false },
+  { "hashmap_search",       true, 0, hashmap_setup_full,  hashmap_search_run,  hashmap_teardown, false },
+  { "itree_insert",         true, 0, intrusive_setup_empty, itree_insert_run, intrusive_teardown, false },
+  { "itree_search",         true, 0, itree_setup_full,   itree_search_run,     intrusive_teardown, false },
+  { "list_push_back",      false, 0, list_setup_empty,   list_push_run,        list_teardown,   false },
+  { "list_traverse",       false, 0, list_setup_full,    list_traverse_run,    list_teardown,   false },
+  { "ilist_push_back",     false, 0, intrusive_setup_empty, ilist_push_run,   intrusive_teardown, false },
+  { "ilist_traverse",      false, 0, ilist_setup_full,   ilist_traverse_run,   intrusive_teardown, false },
+  { "ulist_push_back",     false, 0, ulist_setup_empty,  ulist_push_run,       ulist_teardown,  false },
+  { "ulist_traverse",      false, 0, ulist_setup_full,   ulist_traverse_run,   ulist_teardown,  false },
+};
+
+const size_t bench_num_cases = sizeof(bench_cases) / sizeof(bench_cases[0]);
@@ -0,0 +1,209 @@
+#ifndef DS_BPTREE_H
+#define DS_BPTREE_H
+
+#include "ds_common.h"
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Cache-friendly B+tree
+ * -------------------------------------------------------------------------
+ *
+ * `ds_bptree_t` is an ordered container with the same semantics as
+ * `ds_bst_t` (opaque `void *` elements ordered by `ds_compare_f`,
+ * duplicate keys rejected, "Dummy Key" lookups, `ds_free_f` ownership),
+ * but a very different memory layout:
+ *
+ *   - Every node holds up to DS_BPTREE_ORDER - 1 element pointers packed
+ *     contiguously, so one node spans a few cache lines instead of one
+ *     24-byte heap block per element.
+ *   - All elements live in the leaves. Internal nodes only hold
+ *     separators (each separator is the minimum element of the subtree to
+ *     its right, so it always points to live data).
+ *   - Leaves are doubly linked, which makes in-order iteration and range
+ *     scans a linear walk over packed arrays.
+ *
+ * With the default order of 32, a million elements fit in a tree of
+ * height 4-5 instead of the ~20 levels of a balanced binary tree.
+ *
+ * Complexity:
+ *   - insert / search / remove / min / max / lower_bound: O(log n)
+ *   - traverse_inorder:                                  O(n)
+ *   - traverse_range:                                    O(log n + k)
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque B+tree type.
+ *
+ * The internal structure is hidden from users.
+ * All operations must be performed through the provided API.
+ */
+typedef struct ds_bptree ds_bptree_t;
+
+/**
+ * @brief B+tree Iterator.
+ *
+ * Passed by value. The fields are private; use the ds_bptree_iter_*()
+ * functions. An iterator is invalidated by any insert or remove.
+ */
+typedef struct {
+  const void *leaf;   // Current leaf, NULL represents the End Iterator
+  size_t index;       // Slot inside the leaf
+} ds_bptree_iter_t;
+
+/**
+ * @brief Create a new B+tree.
+ *
+ * @param compare  Function used to compare elements.
+ * Required to maintain the order of the tree.
+ * - Returns < 0 if a < b
+ * - Returns 0 if a == b
+ * - Returns > 0 if a > b
+ *
+ * @return Pointer to a new B+tree on success, or NULL on failure.
+ */
+ds_bptree_t *ds_bptree_create(ds_compare_f compare);
+
+/**
+ * @brief Create a new B+tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new B+tree on success, or NULL on failure.
+ */
+ds_bptree_t *ds_bptree_create_ex(ds_compare_f compare, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a B+tree and optionally free its elements.
+ *
+ * @param tree       Pointer to the B+tree.
+ * @param free_func  Optional element destructor.
+ *                   - If non-NULL, it is called for each stored element.
+ *                   - If NULL, only the B+tree itself is freed.
+ */
+void ds_bptree_destroy(ds_bptree_t *tree, ds_free_f free_func);
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_bptree_size(const ds_bptree_t *tree);
+
+/**
+ * @brief Get the height of the tree (0 for an empty tree, 1 for a single leaf).
+ */
+size_t ds_bptree_height(const ds_bptree_t *tree);
+
+/**
+ * @brief Insert a new element into the B+tree.
+ *
+ * @param tree  Pointer to the B+tree.
+ * @param data  Pointer to the data to insert.
+ *
+ * @return
+ * - DS_OK:        On success.
+ * - DS_ERR_EXIST: If the data already exists (Duplicate keys are not allowed).
+ * - DS_ERR_MEM:   If memory allocation fails. The tree is left unchanged.
+ */
+ds_status_t ds_bptree_insert(ds_bptree_t *tree, void *data);
+
+/**
+ * @brief Search for data matching a key.
+ *
+ * @param tree  Pointer to the B+tree.
+ * @param key   Pointer to a dummy object or key used for comparison.
+ *
+ * @return Pointer to the stored data if found, NULL otherwise.
+ */
+void *ds_bptree_search(const ds_bptree_t *tree, const void *key);
+
+/**
+ * @brief Remove the element matching the key.
+ *
+ * @param tree       Pointer to the B+tree.
+ * @param key        Pointer to the key to identify the element.
+ * @param free_func  Optional destructor.
+ * If found, this is called on the data being removed.
+ *
+ * @return
+ * - DS_OK:            If the element was found and removed.
+ * - DS_ERR_NOT_FOUND: If the key was not found.
+ * - DS_ERR_*:         On invalid arguments.
+ */
+ds_status_t ds_bptree_remove(ds_bptree_t *tree, const void *key, ds_free_f free_func);
+
+/**
+ * @brief Get the minimum element.
+ *
+ * @return Pointer to the minimum data, or NULL if tree is empty.
+ */
+void *ds_bptree_min(const ds_bptree_t *tree);
+
+/**
+ * @brief Get the maximum element.
+ *
+ * @return Pointer to the maximum data, or NULL if tree is empty.
+ */
+void *ds_bptree_max(const ds_bptree_t *tree);
+
+/**
+ * @brief Perform an In-order traversal (strictly increasing order).
+ *
+ * Walks the linked leaves, no recursion or helper allocation.
+ *
+ * @param tree   Pointer to the B+tree.
+ * @param visit  Callback function to process each element.
+ */
+void ds_bptree_traverse_inorder(const ds_bptree_t *tree, ds_visit_f visit);
+
+/**
+ * @brief Visit every element in the half-open range [lo, hi) in order.
+ *
+ * @param tree   Pointer to the B+tree.
+ * @param lo     Inclusive lower bound key, or NULL for "from the minimum".
+ * @param hi     Exclusive upper bound key, or NULL for "up to the maximum".
+ * @param visit  Callback function to process each element.
+ */
+void ds_bptree_traverse_range(const ds_bptree_t *tree, const void *lo, const void *hi, ds_visit_f visit);
+
+/**
+ * @brief Get an iterator pointing to the minimum element.
+ *
+ * @return The End Iterator if the tree is empty.
+ */
+ds_bptree_iter_t ds_bptree_iter_begin(const ds_bptree_t *tree);
+
+/**
+ * @brief Get an iterator to the first element that is not less than key.
+ *
+ * @return The End Iterator if every element is less than key.
+ */
+ds_bptree_iter_t ds_bptree_lower_bound(const ds_bptree_t *tree, const void *key);
+
+/**
+ * @brief Move the iterator forward by one element.
+ *
+ * @return The next iterator, or the End Iterator past the maximum.
+ */
+ds_bptree_iter_t ds_bptree_iter_next(ds_bptree_iter_t it);
+
+/**
+ * @brief Move the iterator backward by one element.
+ *
+ * @return The previous iterator, or the End Iterator before the minimum.
+ */
+ds_bptree_iter_t ds_bptree_iter_prev(ds_bptree_iter_t it);
+
+/**
+ * @brief Check whether the iterator is the End Iterator.
+ */
+bool ds_bptree_iter_is_end(ds_bptree_iter_t it);
+
+/**
+ * @brief Get the data pointed to by the iterator.
+ *
+ * @return Data pointed to by the iterator, or NULL for the End Iterator.
+ */
+void *ds_bptree_iter_get(ds_bptree_iter_t it);
+
+#endif // !DS_BPTREE_H
@@ -2,6 +2,7 @@
 #define DS_BST_H
 
 #include "ds_common.h"
+#include "ds_stats.h"
 
 /** -------------------------------------------------------------------------
  * 🧠 ARCHITECTURE: The "Key" vs "Data" Model
@@ -42,6 +43,23 @@
  */
 typedef struct ds_bst ds_bst_t;
 
+/**
+ * @brief Opaque BST node type.
+ */
+typedef struct ds_bst_node ds_bst_node_t;
+
+/**
+ * @brief BST iterator.
+ *
+ * A pointer to a node, passed by value. NULL is the End iterator.
+ * Nodes keep a parent pointer, so stepping needs neither recursion nor
+ * a helper stack (amortized O(1) per step over a full walk).
+ *
+ * An iterator is invalidated when its element is removed; other
+ * insertions and removals leave it valid.
+ */
+typedef ds_bst_node_t *ds_bst_iter_t;
+
 /**
  * @brief Create a new binary search tree.
  *
@@ -55,6 +73,75 @@ typedef struct ds_bst ds_bst_t;
  */
 ds_bst_t *ds_bst_create(ds_compare_f compare);
 
+/**
+ * @brief Create a new binary search tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure.
+ */
+ds_bst_t *ds_bst_create_ex(ds_compare_f compare, const ds_allocator_t *allocator);
+
+/**
+ * @brief Create a new binary search tree whose nodes come from a node pool.
+ *
+ * Nodes are carved out of contiguous slabs (see ds_pool.h) instead of one
+ * malloc per element. ds_bst_destroy() releases all nodes at once; the
+ * tree is only walked when a free_func is given.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure.
+ */
+ds_bst_t *ds_bst_create_pooled(ds_compare_f compare, size_t slab_hint);
+
+/**
+ * @brief Create a pooled binary search tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the tree and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure.
+ */
+ds_bst_t *ds_bst_create_pooled_ex(ds_compare_f compare, size_t slab_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Build a balanced tree from elements in ascending order, in O(n).
+ *
+ * No insert descents: the middle element becomes the root, recursively,
+ * so the height is ceil(log2(n + 1)). Used to reload a saved tree (see
+ * ds_snapshot.h) without n * log(n) comparisons.
+ *
+ * @param compare  Function used to compare elements.
+ * @param items    Array of `n` non-NULL elements, strictly ascending
+ *                 under `compare`. The pointers are copied.
+ * @param n        Number of elements.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure or if the
+ *         elements are not strictly ascending.
+ */
+ds_bst_t *ds_bst_create_from_sorted(ds_compare_f compare, void *const *items, size_t n);
+
+/**
+ * @brief Build a balanced tree from sorted elements using a custom
+ *        allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param items      Array of `n` non-NULL elements, strictly ascending.
+ * @param n          Number of elements.
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure.
+ */
+ds_bst_t *ds_bst_create_from_sorted_ex(ds_compare_f compare, void *const *items, size_t n,
+                                       const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a binary search tree and optionally free its elements.
  *
@@ -70,6 +157,19 @@ void ds_bst_destroy(ds_bst_t *bst, ds_free_f free_func);
  */
 size_t ds_bst_size(const ds_bst_t *bst);
 
+/**
+ * @brief Get the instrumentation counters (see ds_stats.h).
+ *
+ * Allocator traffic, searches, comparisons made by insert, search and
+ * remove, and the deepest level an insert has reached (root = 1).
+ *
+ * @return
+ *   - DS_OK               On success.
+ *   - DS_ERR_NULL         If bst or out is NULL.
+ *   - DS_ERR_UNSUPPORTED  If built without DS_ENABLE_STATS.
+ */
+ds_status_t ds_bst_stats(const ds_bst_t *bst, ds_stats_t *out);
+
 /**
  * @brief Insert a new element into the BST.
  *
@@ -134,4 +234,101 @@ void *ds_bst_max(const ds_bst_t *bst);
  */
 void ds_bst_traverse_inorder(const ds_bst_t *bst, ds_visit_f visit);
 
+/**
+ * @brief Get an iterator pointing to the smallest element.
+ *
+ * @return Returns NULL (End) if the tree is empty.
+ */
+ds_bst_iter_t ds_bst_iter_begin(const ds_bst_t *bst);
+
+/**
+ * @brief Get an iterator pointing to the largest element.
+ *
+ * @note Helper for reverse traversal.
+ *
+ * @return Returns NULL if the tree is empty.
+ */
+ds_bst_iter_t ds_bst_iter_last(const ds_bst_t *bst);
+
+/**
+ * @brief Move to the next element in sorted order.
+ *
+ * @return The next iterator, or NULL after the largest element.
+ */
+ds_bst_iter_t ds_bst_iter_next(ds_bst_iter_t it);
+
+/**
+ * @brief Move to the previous element in sorted order.
+ *
+ * @return The previous iterator, or NULL before the smallest element.
+ */
+ds_bst_iter_t ds_bst_iter_prev(ds_bst_iter_t it);
+
+/**
+ * @brief Get the data pointed to by the iterator.
+ *
+ * @return The data, or NULL for the End iterator.
+ */
+void *ds_bst_iter_get(ds_bst_iter_t it);
+
+/**
+ * @brief Find the first element that is not less than key (>= key).
+ *
+ * @param bst  Pointer to the BST.
+ * @param key  Pointer to a dummy object or key used for comparison.
+ *
+ * @return The iterator, or NULL if every element is less than key.
+ */
+ds_bst_iter_t ds_bst_lower_bound(const ds_bst_t *bst, const void *key);
+
+/**
+ * @brief Find the first element that is greater than key (> key).
+ *
+ * @param bst  Pointer to the BST.
+ * @param key  Pointer to a dummy object or key used for comparison.
+ *
+ * @return The iterator, or NULL if no element is greater than key.
+ */
+ds_bst_iter_t ds_bst_upper_bound(const ds_bst_t *bst, const void *key);
+
+/**
+ * @brief Visit, in increasing order, every element in the range [lo, hi).
+ *
+ * Only the path to lo and the matching nodes are touched:
+ * O(h + k) for k visited elements.
+ *
+ * @param bst    Pointer to the BST.
+ * @param lo     Inclusive lower bound (dummy object or key).
+ * @param hi     Exclusive upper bound (dummy object or key).
+ * @param visit  Callback function to process each element.
+ *
+ * @return The number of elements visited.
+ */
+size_t ds_bst_range(const ds_bst_t *bst, const void *lo, const void *hi, ds_visit_f visit);
+
+/**
+ * @brief Get the k-th smallest element (order statistic).
+ *
+ * Every node keeps the size of its subtree, so this takes O(h).
+ *
+ * @param bst  Pointer to the BST.
+ * @param k    0-based position in sorted order.
+ *
+ * @return The element, or NULL if k >= size.
+ */
+void *ds_bst_select(const ds_bst_t *bst, size_t k);
+
+/**
+ * @brief Count the elements that are less than key.
+ *
+ * If key is stored, this is its 0-based position, so
+ * ds_bst_select(bst, ds_bst_rank(bst, key)) returns it. O(h).
+ *
+ * @param bst  Pointer to the BST.
+ * @param key  Pointer to a dummy object or key used for comparison.
+ *
+ * @return The number of elements less than key.
+ */
+size_t ds_bst_rank(const ds_bst_t *bst, const void *key);
+
 #endif // !DS_BST_H
@@ -23,6 +23,46 @@ typedef struct ds_btree ds_btree_t;
  */
 ds_btree_t *ds_btree_create();
 
+/**
+ * @brief Create a binary tree using a custom allocator.
+ *
+ * Nodes of such a tree must be created with ds_btree_node_alloc() on that
+ * tree, so that they are released through the same allocator.
+ *
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new binary tree on success, or NULL on failure.
+ */
+ds_btree_t *ds_btree_create_ex(const ds_allocator_t *allocator);
+
+/**
+ * @brief Create a binary tree whose nodes come from a node pool.
+ *
+ * Nodes of a pooled tree must be created with ds_btree_node_alloc() on
+ * that tree, never with ds_btree_node_create(). They are carved out of
+ * contiguous slabs (see ds_pool.h); ds_btree_clear() and
+ * ds_btree_destroy() release all of them at once and only walk the tree
+ * when a free_func is given. Nodes detached from a pooled tree stay owned
+ * by its pool and must not be attached to another tree.
+ *
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new binary tree on success, or NULL on failure.
+ */
+ds_btree_t *ds_btree_create_pooled(size_t slab_hint);
+
+/**
+ * @brief Create a pooled binary tree using a custom allocator.
+ *
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the tree and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new binary tree on success, or NULL on failure.
+ */
+ds_btree_t *ds_btree_create_pooled_ex(size_t slab_hint, const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a binary tree and optionally free its elements.
  *
@@ -59,6 +99,15 @@ size_t ds_btree_height(const ds_btree_t *tree);
  */
 ds_btree_node_t *ds_btree_node_create(void *data);
 
+/**
+ * @brief Create a standalone node owned by `tree` (not attached yet).
+ *
+ * The node comes from the tree's node pool if it has one, otherwise from
+ * the tree's allocator (with the default allocator this is equivalent to
+ * ds_btree_node_create()).
+ */
+ds_btree_node_t *ds_btree_node_alloc(ds_btree_t *tree, void *data);
+
 /**
  * @brief Set the root of the tree. If root already exists, returns error. 
  */
@@ -88,9 +137,17 @@ ds_status_t ds_btree_attach_node_right(ds_btree_t *tree, ds_btree_node_t *parent
  * The ownership of nodes in `subtree` is transferred to `tree`.
  * The `subtree` object becomes empty (root=NULL, size=0).
  *
+ * Nodes must be releasable by `tree`: neither tree may be pooled or
+ * compacted, and both must use the same allocator (free and ctx).
+ *
  * @param tree     The destination tree.
  * @param parent   Target node in the destination tree.
  * @param subtree  The source tree to be attached. 
+ *
+ * @return
+ *  - DS_OK         On success (or if `subtree` is empty).
+ *  - DS_ERR_EXIST  If the parent already has that child.
+ *  - DS_ERR_ARG    On incompatible trees or invalid arguments.
  */
 ds_status_t ds_btree_attach_tree_left(ds_btree_t *tree, ds_btree_node_t *parent, ds_btree_t *subtree);
 ds_status_t ds_btree_attach_tree_right(ds_btree_t *tree, ds_btree_node_t *parent, ds_btree_t *subtree);
@@ -106,6 +163,48 @@ ds_btree_node_t *ds_btree_detach_right(ds_btree_t *tree, ds_btree_node_t *parent
  */
 void *ds_btree_node_get(ds_btree_node_t *node);
 
+/* -------------------------------------------------------------------------
+ * Compaction
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Node order used by ds_btree_compact().
+ */
+typedef enum {
+  DS_BTREE_LAYOUT_BFS = 0,    // Level by level: good for top-down walks and level-order
+  DS_BTREE_LAYOUT_VEB,        // van Emde Boas: recursive halves of the height, cache-oblivious
+} ds_btree_layout_t;
+
+/**
+ * @brief Move every node of the tree into one contiguous array.
+ *
+ * Unlike one allocation per node, the array has no per-node allocator
+ * overhead, and a walk touches neighbouring cache lines instead of
+ * nodes scattered over the heap. The tree keeps its shape and the
+ * `ds_btree_node_t *` API keeps working on the new nodes.
+ *
+ * - Every node pointer into the tree obtained before the call is
+ *   invalidated.
+ * - Nodes attached afterwards are allocated as usual (one by one, or from
+ *   the pool); calling compact again folds them in.
+ * - Array nodes that get detached stay owned by the tree; the next
+ *   compact, clear or destroy releases them with the array.
+ * - The array is freed as a whole by ds_btree_clear() and
+ *   ds_btree_destroy().
+ *
+ * Needs O(n) temporary memory; on failure the tree is left untouched.
+ *
+ * @param tree    Pointer to the binary tree.
+ * @param layout  DS_BTREE_LAYOUT_BFS or DS_BTREE_LAYOUT_VEB.
+ *
+ * @return
+ *   - DS_OK       On success.
+ *   - DS_ERR_MEM  If the new array cannot be allocated.
+ *   - DS_ERR_*    On invalid arguments.
+ */
+ds_status_t ds_btree_compact(ds_btree_t *tree, ds_btree_layout_t layout);
+
 /* -------------------------------------------------------------------------
  * Traversal (Callback based)
  * -------------------------------------------------------------------------
@@ -134,4 +233,88 @@ void ds_btree_traverse_postorder_iterative(const ds_btree_t *tree, ds_visit_f vi
  */
 void ds_btree_traverse_levelorder(const ds_btree_t *tree, ds_visit_f visit);
 
+/**
+ * @brief Morris (threaded) in-order / pre-order traversal.
+ *
+ * Same visiting order as the functions above, with O(1) extra memory and
+ * no allocation: the NULL right pointers of in-order predecessors are
+ * temporarily threaded back to their successors while the walk is in
+ * progress and restored before returning.
+ *
+ * Because the tree is modified during the walk, `visit` must not change
+ * the tree's shape and the tree must not be read concurrently.
+ */
+void ds_btree_traverse_inorder_morris(const ds_btree_t *tree, ds_visit_f visit);
+void ds_btree_traverse_preorder_morris(const ds_btree_t *tree, ds_visit_f visit);
+
+/* -------------------------------------------------------------------------
+ * Parallel traversal
+ * -------------------------------------------------------------------------
+ *
+ * The tree is cut at a small depth (about log2(threads) + 2). Every
+ * subtree below the cut becomes one task on a ds_threadpool_t; the few
+ * nodes above it are handled by the calling thread. Trees that are very
+ * lopsided parallelize poorly, since one subtree ends up as one task.
+ *
+ * Tasks walk their subtree with the Morris walk, so the same rules as for
+ * ds_btree_traverse_inorder_morris() apply: callbacks must not change the
+ * tree's shape, and nobody else may read the tree during the call.
+ *
+ * The pool runs on the default allocator; the tree's allocator is only
+ * called from the calling thread, so it need not be thread-safe.
+ *
+ * nthreads: 0 = one thread per online CPU, 1 = sequential walk on the
+ * calling thread. If the pool cannot be started the call also falls back
+ * to a sequential walk.
+ */
+
+/**
+ * @brief Map callback: turn one element into a partial result.
+ */
+typedef void *(*ds_btree_map_f)(void *data, void *ctx);
+
+/**
+ * @brief Combine callback: merge two partial results (left then right).
+ */
+typedef void *(*ds_btree_combine_f)(void *left, void *right, void *ctx);
+
+/**
+ * @brief Visit every element exactly once, from several threads.
+ *
+ * Ordering: none. `visit` is called concurrently from different threads
+ * in an unspecified order, so it must be thread-safe. Every call has
+ * returned when this function returns.
+ *
+ * @return
+ *   - DS_OK      On success (also for an empty tree).
+ *   - DS_ERR_*   On invalid arguments.
+ */
+ds_status_t ds_btree_parallel_for_each(const ds_btree_t *tree, ds_visit_f visit, size_t nthreads);
+
+/**
+ * @brief Map every element and combine the partial results, from several
+ *        threads.
+ *
+ * Ordering: partial results are only ever combined with their in-order
+ * neighbours, left operand first. If `combine` is associative, the result
+ * equals the sequential fold combine(...combine(map(e0), map(e1))..., map(en))
+ * over the in-order sequence e0..en; commutativity is not required.
+ * `map` and `combine` run concurrently and must be thread-safe.
+ *
+ * @param tree      Pointer to the binary tree.
+ * @param map       Called once per element.
+ * @param combine   Merges two partial results into one.
+ * @param ctx       Passed through to both callbacks.
+ * @param nthreads  Number of worker threads (0 = CPU count).
+ * @param out       Receives the final result.
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_EMPTY  If the tree is empty (*out is untouched).
+ *   - DS_ERR_*      On invalid arguments.
+ */
+ds_status_t ds_btree_parallel_map_reduce(const ds_btree_t *tree, ds_btree_map_f map,
+                                         ds_btree_combine_f combine, void *ctx,
+                                         size_t nthreads, void **out);
+
 #endif // !DS_BTREE_H
@@ -0,0 +1,202 @@
+/*
+** include/ds_cmap.h -- Concurrent ordered map (skip list) for read-mostly
+**                      workloads: lock-free readers, serialized writers,
+**                      epoch-based reclamation of removed nodes.
+*/
+
+#ifndef DS_CMAP_H
+#define DS_CMAP_H
+
+#include "ds_common.h"
+#include "ds_ebr.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Concurrent skip list
+ * -------------------------------------------------------------------------
+ *
+ *   level 3:  head ----------------------------> [40] ------------> NULL
+ *   level 2:  head ------------> [17] ---------> [40] ------------> NULL
+ *   level 1:  head ---> [ 5] --> [17] --> [23] -> [40] --> [61] --> NULL
+ *
+ * Elements are `void *` ordered by a ds_compare_f, as in ds_bst_t, and
+ * stored once each (duplicates are rejected).
+ *
+ * Readers take no lock and never wait:
+ *   - Links are atomics. A writer fills in a new node completely, then
+ *     publishes it with release stores from the bottom level up, so a
+ *     reader that reaches a node (acquire loads) sees it initialized.
+ *   - Removal unlinks a node from the top level down but leaves its own
+ *     links intact, so a reader standing on it still walks forward.
+ *   - The node, and its element, are handed to an epoch-based
+ *     reclamation domain (ds_ebr.h) and freed only after every reader
+ *     that might hold them has left its critical section.
+ *
+ * Writers (insert/remove/clear) serialize on one mutex: this favors many
+ * readers and occasional writers, where a lock-free writer path would
+ * cost every reader extra checks for marked links.
+ *
+ * Reader protocol, once per thread and per lookup burst:
+ *
+ *   ds_ebr_thread_t *th = ds_cmap_register(map);   // thread start
+ *   ds_ebr_enter(th);
+ *   user_t *u = ds_cmap_get(map, &key);            // valid until leave
+ *   ...
+ *   ds_ebr_leave(th);
+ *   ds_cmap_unregister(map, th);                   // thread exit
+ *
+ * Memory reclamation: removed elements are passed to the map's
+ * free_func (if any) when reclaimed. Writers run a collection every
+ * few removals; ds_cmap_collect() runs one on demand and
+ * ds_cmap_synchronize() waits for all pending reclamation.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque concurrent map type.
+ */
+typedef struct ds_cmap ds_cmap_t;
+
+/**
+ * @brief Create a new concurrent map.
+ *
+ * @param compare    Element order.
+ * @param free_func  Optional destructor applied to removed elements once
+ *                   no reader can see them, and to the elements left at
+ *                   destroy.
+ *
+ * @return Pointer to a new map on success, or NULL on failure.
+ */
+ds_cmap_t *ds_cmap_create(ds_compare_f compare, ds_free_f free_func);
+
+/**
+ * @brief Create a new concurrent map using a custom allocator.
+ *
+ * @param compare    Element order.
+ * @param free_func  Optional element destructor.
+ * @param allocator  Allocator for the map and its nodes. It is copied.
+ *                   It is only called under the map's lock (writers,
+ *                   reader registration and reclamation all take it).
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new map on success, or NULL on failure.
+ */
+ds_cmap_t *ds_cmap_create_ex(ds_compare_f compare, ds_free_f free_func, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a map, freeing every element (retired or not) with the
+ *        map's free_func. No other thread may be using the map.
+ */
+void ds_cmap_destroy(ds_cmap_t *map);
+
+/**
+ * @brief Register the calling thread as a reader.
+ *
+ * @return The record to pass to ds_ebr_enter()/ds_ebr_leave(), or NULL
+ *         on failure.
+ */
+ds_ebr_thread_t *ds_cmap_register(ds_cmap_t *map);
+
+/**
+ * @brief Unregister a reader record (outside any critical section).
+ */
+void ds_cmap_unregister(ds_cmap_t *map, ds_ebr_thread_t *th);
+
+/**
+ * @brief Get a snapshot of the number of elements.
+ */
+size_t ds_cmap_size(const ds_cmap_t *map);
+
+/**
+ * @brief Insert an element.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_EXIST  If an equal element is already present.
+ *  - DS_ERR_MEM    If the node could not be allocated.
+ *  - DS_ERR_*      On invalid arguments.
+ */
+ds_status_t ds_cmap_insert(ds_cmap_t *map, void *element);
+
+/**
+ * @brief Remove the element equal to `key`.
+ *
+ * The element is passed to free_func only after concurrent readers are
+ * done with it.
+ *
+ * @return
+ *  - DS_OK             On success.
+ *  - DS_ERR_NOT_FOUND  If no element matches.
+ *  - DS_ERR_*          On invalid arguments.
+ */
+ds_status_t ds_cmap_remove(ds_cmap_t *map, const void *key);
+
+/**
+ * @brief Remove every element (each is reclaimed like a remove).
+ */
+void ds_cmap_clear(ds_cmap_t *map);
+
+/**
+ * @brief Find the element equal to `key`.
+ *
+ * Inside a critical section (ds_ebr_enter()) of a registered thread, or
+ * from a writer thread while no other writer runs.
+ *
+ * @return The element, or NULL if not found. It stays valid until the
+ *         caller leaves the critical section.
+ */
+void *ds_cmap_get(const ds_cmap_t *map, const void *key);
+
+/**
+ * @brief Check whether an element equal to `key` is present. Same rules
+ *        as ds_cmap_get().
+ */
+bool ds_cmap_contains(const ds_cmap_t *map, const void *key);
+
+/**
+ * @brief Find the first element not less than `key`. Same rules as
+ *        ds_cmap_get().
+ *
+ * @return The element, or NULL if every element is less than key.
+ */
+void *ds_cmap_lower_bound(const ds_cmap_t *map, const void *key);
+
+/**
+ * @brief Visit, in increasing order, the elements in [lo, hi). Same rules
+ *        as ds_cmap_get().
+ *
+ * Elements inserted or removed during the walk may or may not be seen;
+ * every element present throughout is visited exactly once.
+ *
+ * @param map    Pointer to the map.
+ * @param lo     Inclusive lower bound, or NULL for the first element.
+ * @param hi     Exclusive upper bound, or NULL for no bound.
+ * @param visit  Callback for each element.
+ *
+ * @return The number of elements visited.
+ */
+size_t ds_cmap_range(const ds_cmap_t *map, const void *lo, const void *hi, ds_visit_f visit);
+
+/**
+ * @brief Reclaim removed elements whose grace period has passed. Never
+ *        waits for readers.
+ *
+ * @return The number of elements reclaimed.
+ */
+size_t ds_cmap_collect(ds_cmap_t *map);
+
+/**
+ * @brief Wait until every element removed so far has been reclaimed.
+ *        Must not be called inside a critical section.
+ *
+ * @return The number of elements reclaimed.
+ */
+size_t ds_cmap_synchronize(ds_cmap_t *map);
+
+/**
+ * @brief Get the number of removed elements not reclaimed yet.
+ */
+size_t ds_cmap_pending(const ds_cmap_t *map);
+
+#endif // !DS_CMAP_H
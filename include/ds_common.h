@@ -21,9 +21,12 @@ typedef enum {
     DS_ERR_EMPTY  = -4,             // Empty container (e.g., pop_front on empty, as required by API)
     DS_ERR_EXIST  = -5,             // A resource already exists
     DS_ERR_NOT_FOUND = -6,
+    DS_ERR_FULL   = -8,             // A bounded container has no free slot
+    DS_ERR_UNSUPPORTED = -9,        // Feature not compiled into this build
 
     /* Resource/System Errors */
     DS_ERR_MEM    = -7,             // Memory allocation failed
+    DS_ERR_IO     = -10,            // File could not be read/written, or is malformed
 } ds_status_t;
 
 /*
@@ -40,5 +43,108 @@ typedef void (*ds_free_f)(void *data);
 typedef int (*ds_compare_f)(const void *a, const void *b);
 // Element visit callback function. 
 typedef void (*ds_visit_f)(void *data);
+// Key hash callback function. Equal keys must hash equally; the
+// containers mix the result, so an identity hash is acceptable.
+typedef size_t (*ds_hash_f)(const void *key);
+// Key equality callback function.
+typedef bool (*ds_equal_f)(const void *a, const void *b);
+
+/*
+ * Intrusive Containers
+ * ds_ilist_t and ds_itree_t link structures embedded in the caller's own
+ * objects. DS_CONTAINER_OF maps a link pointer back to its enclosing object.
+ *
+ *   struct job { int id; ds_ilist_link_t link; };
+ *   struct job *j = DS_CONTAINER_OF(l, struct job, link);
+ */
+#define DS_CONTAINER_OF(ptr, type, member) \
+  ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/*
+ * Allocator Interface
+ * Every container obtains its memory through one of these, so the library
+ * can be routed through arenas, per-thread or NUMA-local allocators, or
+ * huge-page backed regions without modification.
+ *
+ * - alloc:    Return `size` bytes aligned for any type, or NULL.
+ * - realloc:  Resize a block previously returned by this allocator
+ *             (contents preserved up to the smaller size), or return NULL
+ *             and leave the block untouched. May be NULL, in which case
+ *             alloc + copy + free is used instead.
+ * - free:     Release a block. `size` is the size it was requested with.
+ * - ctx:      Opaque user context, passed to every callback.
+ *
+ * Containers copy the allocator at creation time; `ctx` must outlive them.
+ */
+typedef struct {
+  void *(*alloc)(void *ctx, size_t size);
+  void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+  void  (*free)(void *ctx, void *ptr, size_t size);
+  void *ctx;
+} ds_allocator_t;
+
+/**
+ * @brief Get the default allocator (malloc / realloc / free).
+ */
+const ds_allocator_t *ds_allocator_default(void);
+
+/**
+ * @brief Allocate, resize and release memory through an allocator.
+ *
+ * These are the helpers containers use internally. They are exported so
+ * that user code sharing an allocator goes through the same rules.
+ */
+void *ds_mem_alloc(const ds_allocator_t *allocator, size_t size);
+void *ds_mem_realloc(const ds_allocator_t *allocator, void *ptr, size_t old_size, size_t new_size);
+void  ds_mem_free(const ds_allocator_t *allocator, void *ptr, size_t size);
+
+/*
+ * Growth Policy
+ * Controls how array-backed containers (vector, deque, heap, and the
+ * stack/queue built on the deque) resize their storage.
+ *
+ * - growth_factor:  Capacity multiplier applied when the container is
+ *                   full. Must be > 1.0.
+ * - max_step:       Upper bound on the number of slots added by a single
+ *                   growth, 0 for no bound. Turns geometric growth into
+ *                   linear growth for very large containers.
+ * - shrink_ratio:   Automatic shrink threshold. After a removal, when
+ *                   size < capacity * shrink_ratio, the capacity is
+ *                   reduced to twice the size. Must be in [0, 0.5); the
+ *                   gap to 0.5 is the hysteresis that keeps alternating
+ *                   push/pop from resizing every time. 0 disables it.
+ * - min_capacity:   Automatic shrink never goes below this capacity.
+ */
+typedef struct {
+  double growth_factor;
+  size_t max_step;
+  double shrink_ratio;
+  size_t min_capacity;
+} ds_growth_policy_t;
+
+/**
+ * @brief Get the default growth policy (2x growth, no automatic shrink).
+ */
+const ds_growth_policy_t *ds_growth_policy_default(void);
+
+/**
+ * @brief Check that every field of a growth policy is in range.
+ */
+bool ds_growth_policy_is_valid(const ds_growth_policy_t *policy);
+
+/**
+ * @brief Capacity to grow to so that at least `needed` slots fit.
+ *
+ * @return The new capacity (>= needed), or 0 on overflow.
+ */
+size_t ds_growth_next_capacity(const ds_growth_policy_t *policy, size_t capacity, size_t needed);
+
+/**
+ * @brief Capacity to shrink to after a removal.
+ *
+ * @return A capacity smaller than `capacity` if the policy asks for a
+ *         shrink, otherwise `capacity` itself.
+ */
+size_t ds_growth_shrink_capacity(const ds_growth_policy_t *policy, size_t size, size_t capacity);
 
 #endif // !DS_COMMON_H
@@ -2,6 +2,8 @@
 #define DS_DEQUE_H
 
 #include "ds_common.h"
+#include "ds_span.h"
+#include "ds_stats.h"
 #include <stddef.h>
 
 /**
@@ -22,6 +24,18 @@ typedef struct ds_deque ds_deque_t;
  */
 ds_deque_t *ds_deque_create(size_t capacity_hint);
 
+/**
+ * @brief Create a new dynamic deque using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the deque and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new deque on success, or NULL on failure.
+ */
+ds_deque_t *ds_deque_create_ex(size_t capacity_hint, const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a deque and optionally free its elements.
  *
@@ -42,6 +56,19 @@ size_t ds_deque_size(const ds_deque_t *deque);
  */
 size_t ds_deque_capacity(const ds_deque_t *deque);
 
+/**
+ * @brief Get the instrumentation counters (see ds_stats.h).
+ *
+ * Buffer resizes and their latency, allocator traffic. A deque embedded
+ * in a stack or queue reports for that container.
+ *
+ * @return
+ *   - DS_OK               On success.
+ *   - DS_ERR_NULL         If deque or out is NULL.
+ *   - DS_ERR_UNSUPPORTED  If built without DS_ENABLE_STATS.
+ */
+ds_status_t ds_deque_stats(const ds_deque_t *deque, ds_stats_t *out);
+
 /**
  * @brief Check if the deque is empty.
  */
@@ -119,6 +146,25 @@ void *ds_deque_front(const ds_deque_t *deque);
  */
 void *ds_deque_back(const ds_deque_t *deque);
 
+/**
+ * @brief Get the elements as the (at most two) contiguous segments of
+ *        the ring buffer, front to back (see ds_span.h).
+ *
+ *   ds_span_t s[2];
+ *   size_t n = ds_deque_as_spans(deque, s);
+ *   // s[0] = [head, end of buffer), s[1] = [0, tail) if the ring wraps
+ *
+ * Nothing is copied, so the spans can go straight to writev() or
+ * memcpy(). They are invalidated by any push, pop or resize.
+ *
+ * @param deque  Pointer to the deque.
+ * @param spans  Array of two spans to fill. Unused entries are set to
+ *               empty spans.
+ *
+ * @return The number of non-empty spans: 0 (empty or NULL deque), 1 or 2.
+ */
+size_t ds_deque_as_spans(const ds_deque_t *deque, ds_span_t spans[2]);
+
 /**
  * @brief Remove all elements from the deque.
  *
@@ -130,5 +176,31 @@ void *ds_deque_back(const ds_deque_t *deque);
  */
 void ds_deque_clear(ds_deque_t *deque, ds_free_f free_func);
 
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param deque  Pointer to the deque.
+ *
+ * @return
+ *   - DS_OK on success (an empty deque keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the deque is unchanged.
+ */
+ds_status_t ds_deque_shrink_to_fit(ds_deque_t *deque);
+
+/**
+ * @brief Set the growth policy of the deque.
+ *
+ * The policy decides how much the deque grows when full and whether it
+ * shrinks automatically after pop/clear (see ds_growth_policy_t).
+ *
+ * @param deque   Pointer to the deque.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_deque_set_growth_policy(ds_deque_t *deque, const ds_growth_policy_t *policy);
+
 #endif // !DS_DEQUE_H
 
@@ -0,0 +1,140 @@
+/*
+** include/ds_deque_inline.h -- Layout of ds_deque_t, in-place init for
+**                              embedding it by value, and unchecked inline
+**                              accessors for hot loops.
+*/
+
+#ifndef DS_DEQUE_INLINE_H
+#define DS_DEQUE_INLINE_H
+
+#include "ds_common.h"
+#include "ds_deque.h"
+#include "ds_stats.h"
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Inline fast paths
+ * -------------------------------------------------------------------------
+ *
+ * Same conventions as ds_vector_inline.h:
+ *
+ *   *_unsafe  No checks. The deque must be valid and, for pops and
+ *             peeks, non-empty; indices must be < size.
+ *   *_fast    Inlined when there is room, otherwise the checked push.
+ *             `element` must not be NULL.
+ *
+ * Unchecked pops never shrink the buffer automatically.
+ *
+ * With the layout visible a deque can also live inside another struct
+ * (ds_stack_t and ds_queue_t do this): ds_deque_init() sets one up in
+ * place and ds_deque_fini() releases its buffer, without a separate
+ * allocation for the deque itself.
+ * -------------------------------------------------------------------------
+ */
+
+struct ds_deque {
+  void **items;     // A dynamic array
+  size_t capacity;  // Total capacity of array
+  size_t size;      // Number of the current array
+
+  size_t head;      // Points to the first valid element
+  size_t tail;      // Points to the next writable position 
+                    // (one past the tail element)
+
+  ds_allocator_t alloc;
+  ds_growth_policy_t policy;
+  DS_STATS_FIELD
+};
+
+/**
+ * @brief Initialize a deque in caller-provided memory.
+ *
+ * @param deque          Memory for the deque.
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the storage. It is copied. If NULL,
+ *                       the default allocator is used.
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_NULL   If deque is NULL.
+ *   - DS_ERR_ARG    If the allocator is incomplete.
+ *   - DS_ERR_MEM    If the buffer could not be allocated.
+ */
+ds_status_t ds_deque_init(ds_deque_t *deque, size_t capacity_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Release the buffer of a deque set up with ds_deque_init().
+ *
+ * @param deque      Pointer to the deque. Its own memory is not freed.
+ * @param free_func  Optional element destructor.
+ */
+void ds_deque_fini(ds_deque_t *deque, ds_free_f free_func);
+
+/**
+ * @brief Element `index` positions from the front (index < size).
+ */
+static inline void *ds_deque_get_unsafe(const ds_deque_t *deque, size_t index) {
+  size_t i = deque->head + index;
+  if (i >= deque->capacity) i -= deque->capacity;
+  return deque->items[i];
+}
+
+/**
+ * @brief First element (size > 0).
+ */
+static inline void *ds_deque_front_unsafe(const ds_deque_t *deque) {
+  return deque->items[deque->head];
+}
+
+/**
+ * @brief Last element (size > 0).
+ */
+static inline void *ds_deque_back_unsafe(const ds_deque_t *deque) {
+  return deque->items[(deque->tail == 0 ? deque->capacity : deque->tail) - 1];
+}
+
+/**
+ * @brief Remove and return the first element (size > 0).
+ */
+static inline void *ds_deque_pop_front_unsafe(ds_deque_t *deque) {
+  void *ret = deque->items[deque->head];
+  if (++ deque->head == deque->capacity) deque->head = 0;
+  deque->size --;
+  return ret;
+}
+
+/**
+ * @brief Remove and return the last element (size > 0).
+ */
+static inline void *ds_deque_pop_back_unsafe(ds_deque_t *deque) {
+  if (deque->tail == 0) deque->tail = deque->capacity;
+  deque->size --;
+  return deque->items[-- deque->tail];
+}
+
+/**
+ * @brief ds_deque_push_back() with the no-growth case inlined.
+ */
+static inline ds_status_t ds_deque_push_back_fast(ds_deque_t *deque, void *element) {
+  if (deque->size == deque->capacity) return ds_deque_push_back(deque, element);
+
+  deque->items[deque->tail] = element;
+  if (++ deque->tail == deque->capacity) deque->tail = 0;
+  deque->size ++;
+  return DS_OK;
+}
+
+/**
+ * @brief ds_deque_push_front() with the no-growth case inlined.
+ */
+static inline ds_status_t ds_deque_push_front_fast(ds_deque_t *deque, void *element) {
+  if (deque->size == deque->capacity) return ds_deque_push_front(deque, element);
+
+  deque->head = (deque->head == 0 ? deque->capacity : deque->head) - 1;
+  deque->items[deque->head] = element;
+  deque->size ++;
+  return DS_OK;
+}
+
+#endif // !DS_DEQUE_INLINE_H
@@ -0,0 +1,163 @@
+/*
+** include/ds_ebr.h -- Epoch-based reclamation: deferred freeing of memory
+**                     that lock-free readers may still be looking at.
+*/
+
+#ifndef DS_EBR_H
+#define DS_EBR_H
+
+#include "ds_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Epoch-based reclamation
+ * -------------------------------------------------------------------------
+ *
+ * Readers traverse shared structures without locks, so a writer that
+ * unlinks a node cannot free it at once. Instead:
+ *
+ *   reader:  ds_ebr_enter(th) ... read shared pointers ... ds_ebr_leave(th)
+ *   writer:  unlink node; ds_ebr_retire(ebr, &node->ebr, reclaim)
+ *            ... later: ds_ebr_collect(ebr) runs reclaim(node)
+ *
+ * A global epoch counter advances only when every thread inside a
+ * critical section has observed the current value. A node retired in
+ * epoch e is unreachable for any reader that enters after the retire, so
+ * once the epoch reaches e + 2 every reader that could have seen it has
+ * left, and it is reclaimed.
+ *
+ * - enter/leave touch only the thread's own record (one store and one
+ *   fence): readers never wait for writers or for each other. They nest.
+ * - A reader that stays inside a critical section holds back
+ *   reclamation, not other threads: memory is freed later, not never.
+ * - retire() is intrusive (the ds_ebr_node_t lives in the retired
+ *   object) and never allocates, so it cannot fail.
+ * - Reclaim callbacks run in ds_ebr_collect(), ds_ebr_synchronize() and
+ *   ds_ebr_destroy(), outside the internal lock; they may retire more.
+ *
+ * Each thread that reads registers once and keeps its ds_ebr_thread_t;
+ * a record must be used by one thread at a time.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque reclamation domain.
+ */
+typedef struct ds_ebr ds_ebr_t;
+
+/**
+ * @brief Opaque per-thread participant record.
+ */
+typedef struct ds_ebr_thread ds_ebr_thread_t;
+
+typedef struct ds_ebr_node ds_ebr_node_t;
+
+/**
+ * @brief Called once a retired object can no longer be read.
+ *
+ * @param node  The link passed to ds_ebr_retire(); use DS_CONTAINER_OF()
+ *              to get back to the object.
+ * @param ctx   The context passed to ds_ebr_retire().
+ */
+typedef void (*ds_ebr_reclaim_f)(ds_ebr_node_t *node, void *ctx);
+
+/**
+ * @brief Link embedded in objects waiting to be reclaimed. Filled in by
+ *        ds_ebr_retire(); needs no initialization.
+ */
+struct ds_ebr_node {
+  ds_ebr_node_t *next;
+  uint64_t epoch;               // Global epoch at retire time
+  ds_ebr_reclaim_f reclaim;
+  void *ctx;
+};
+
+/**
+ * @brief Create a reclamation domain.
+ *
+ * @return Pointer to a new domain on success, or NULL on failure.
+ */
+ds_ebr_t *ds_ebr_create(void);
+
+/**
+ * @brief Create a reclamation domain using a custom allocator.
+ *
+ * @param allocator  Allocator for the domain and thread records. It is
+ *                   copied and called under the domain's lock. If NULL,
+ *                   the default allocator is used.
+ *
+ * @return Pointer to a new domain on success, or NULL on failure.
+ */
+ds_ebr_t *ds_ebr_create_ex(const ds_allocator_t *allocator);
+
+/**
+ * @brief Reclaim everything still retired and destroy the domain.
+ *
+ * No thread may be inside a critical section. Thread records that were
+ * not unregistered are freed too.
+ */
+void ds_ebr_destroy(ds_ebr_t *ebr);
+
+/**
+ * @brief Register the calling thread.
+ *
+ * @return The thread's record, or NULL on failure.
+ */
+ds_ebr_thread_t *ds_ebr_register(ds_ebr_t *ebr);
+
+/**
+ * @brief Unregister a thread record. It must not be inside a critical
+ *        section.
+ */
+void ds_ebr_unregister(ds_ebr_thread_t *th);
+
+/**
+ * @brief Enter a read-side critical section. Pointers loaded from the
+ *        protected structure stay valid until the matching leave.
+ */
+void ds_ebr_enter(ds_ebr_thread_t *th);
+
+/**
+ * @brief Leave a read-side critical section.
+ */
+void ds_ebr_leave(ds_ebr_thread_t *th);
+
+/**
+ * @brief Hand an unlinked object over for deferred reclamation.
+ *
+ * The object must already be unreachable for readers that enter from
+ * now on.
+ *
+ * @param ebr      The domain.
+ * @param node     Link embedded in the object.
+ * @param reclaim  Called once the object is safe to free.
+ * @param ctx      Passed to reclaim.
+ */
+void ds_ebr_retire(ds_ebr_t *ebr, ds_ebr_node_t *node, ds_ebr_reclaim_f reclaim, void *ctx);
+
+/**
+ * @brief Try to advance the epoch and reclaim what has become safe.
+ *
+ * Never waits for readers.
+ *
+ * @return The number of objects reclaimed.
+ */
+size_t ds_ebr_collect(ds_ebr_t *ebr);
+
+/**
+ * @brief Wait until everything retired so far has been reclaimed.
+ *
+ * Yields while readers are still inside critical sections. Must not be
+ * called from inside one (it would wait for itself).
+ *
+ * @return The number of objects reclaimed.
+ */
+size_t ds_ebr_synchronize(ds_ebr_t *ebr);
+
+/**
+ * @brief Get the number of objects retired but not yet reclaimed.
+ */
+size_t ds_ebr_pending(const ds_ebr_t *ebr);
+
+#endif // !DS_EBR_H
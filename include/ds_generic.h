@@ -0,0 +1,539 @@
+/*
+** include/ds_generic.h -- Header-only, type-specialized containers.
+**                         Each DS_DEFINE_* macro generates a struct and a
+**                         set of static inline functions for one element
+**                         type and one comparison.
+*/
+
+#ifndef DS_GENERIC_H
+#define DS_GENERIC_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Macro templates
+ * -------------------------------------------------------------------------
+ *
+ * The regular containers store `void *` and compare through a
+ * `ds_compare_f` pointer, so every comparison is an indirect call and
+ * every element is boxed. The macros below stamp out the same algorithms
+ * for a concrete type T with the comparison written as an expression:
+ *
+ *   DS_DEFINE_HEAP(minheap, int, a < b)
+ *     -> minheap_t, minheap_init(), minheap_push(), minheap_pop(), ...
+ *
+ * - Elements are stored by value (T, not T *).
+ * - `less_expr` is any expression over two T values named `a` and `b`
+ *   that is true when `a` must come before `b`. It is compiled into the
+ *   sift / search loops, so the compiler can inline it.
+ * - Structs are transparent and live wherever the caller puts them:
+ *   `name_init()` sets one up, `name_destroy()` releases its storage.
+ *   Storage comes from the allocator given to init (NULL = default).
+ * - Error handling follows the rest of the library: ds_status_t codes,
+ *   DS_ERR_EMPTY when popping an empty container, etc.
+ *
+ * Equivalence: two values are equal when neither is less than the other.
+ * -------------------------------------------------------------------------
+ */
+
+/* ========================================================================== */
+/*                                  Vector                                    */
+/* ========================================================================== */
+
+/**
+ * @brief Generate `name##_t`, a growable array of T.
+ *
+ *   ds_status_t name_init(name_t *v, const ds_allocator_t *allocator);
+ *   void        name_destroy(name_t *v);
+ *   ds_status_t name_reserve(name_t *v, size_t capacity);
+ *   ds_status_t name_push(name_t *v, T value);
+ *   ds_status_t name_pop(name_t *v, T *out);
+ *   T          *name_at(name_t *v, size_t index);    // NULL if out of range
+ *   size_t      name_size(const name_t *v);
+ *   void        name_clear(name_t *v);
+ */
+#define DS_DEFINE_VECTOR(name, T)                                                      \
+  typedef struct {                                                                     \
+    T *data;                                                                           \
+    size_t size;                                                                       \
+    size_t capacity;                                                                   \
+    ds_allocator_t alloc;                                                              \
+  } name##_t;                                                                          \
+                                                                                       \
+  static inline ds_status_t name##_init(name##_t *v, const ds_allocator_t *allocator) { \
+    if (!v) return DS_ERR_NULL;                                                        \
+    if (!allocator) allocator = ds_allocator_default();                                \
+    v->data = NULL;                                                                    \
+    v->size = v->capacity = 0;                                                         \
+    v->alloc = *allocator;                                                             \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_destroy(name##_t *v) {                                     \
+    if (!v) return;                                                                    \
+    if (v->data) ds_mem_free(&v->alloc, v->data, sizeof(T) * v->capacity);             \
+    v->data = NULL;                                                                    \
+    v->size = v->capacity = 0;                                                         \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_reserve(name##_t *v, size_t capacity) {             \
+    if (!v) return DS_ERR_NULL;                                                        \
+    if (capacity <= v->capacity) return DS_OK;                                         \
+    if (capacity > SIZE_MAX / sizeof(T)) return DS_ERR_MEM;                            \
+    T *data = ds_mem_realloc(&v->alloc, v->data, sizeof(T) * v->capacity,              \
+                             sizeof(T) * capacity);                                    \
+    if (!data) return DS_ERR_MEM;                                                      \
+    v->data = data;                                                                    \
+    v->capacity = capacity;                                                            \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_push(name##_t *v, T value) {                        \
+    if (!v) return DS_ERR_NULL;                                                        \
+    if (v->size == v->capacity) {                                                      \
+      size_t cap = ds_growth_next_capacity(ds_growth_policy_default(),                 \
+                                           v->capacity, v->capacity + 1);              \
+      if (cap == 0) return DS_ERR_MEM;                                                 \
+      ds_status_t ret = name##_reserve(v, cap);                                        \
+      if (ret != DS_OK) return ret;                                                    \
+    }                                                                                  \
+    v->data[v->size ++] = value;                                                       \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_pop(name##_t *v, T *out) {                          \
+    if (!v) return DS_ERR_NULL;                                                        \
+    if (v->size == 0) return DS_ERR_EMPTY;                                             \
+    v->size --;                                                                        \
+    if (out) *out = v->data[v->size];                                                  \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline T *name##_at(name##_t *v, size_t index) {                              \
+    if (!v || index >= v->size) return NULL;                                           \
+    return &v->data[index];                                                            \
+  }                                                                                    \
+                                                                                       \
+  static inline size_t name##_size(const name##_t *v) {                                \
+    return v ? v->size : 0;                                                            \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_clear(name##_t *v) {                                       \
+    if (v) v->size = 0;                                                                \
+  }
+
+/* ========================================================================== */
+/*                                   Heap                                     */
+/* ========================================================================== */
+
+/**
+ * @brief Generate `name##_t`, a binary heap of T ordered by `less_expr`.
+ *
+ * The "least" element (per less_expr) is on top: `a < b` gives a min-heap,
+ * `a > b` a max-heap.
+ *
+ *   ds_status_t name_init(name_t *h, const ds_allocator_t *allocator);
+ *   void        name_destroy(name_t *h);
+ *   ds_status_t name_push(name_t *h, T value);
+ *   ds_status_t name_pop(name_t *h, T *out);
+ *   T          *name_top(name_t *h);                 // NULL if empty
+ *   ds_status_t name_assign(name_t *h, const T *items, size_t n);  // O(n) heapify
+ *   size_t      name_size(const name_t *h);
+ */
+#define DS_DEFINE_HEAP(name, T, less_expr)                                             \
+  typedef struct {                                                                     \
+    T *items;                                                                          \
+    size_t size;                                                                       \
+    size_t capacity;                                                                   \
+    ds_allocator_t alloc;                                                              \
+  } name##_t;                                                                          \
+                                                                                       \
+  static inline bool name##_less(T a, T b) {                                           \
+    return (less_expr);                                                                \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_init(name##_t *h, const ds_allocator_t *allocator) { \
+    if (!h) return DS_ERR_NULL;                                                        \
+    if (!allocator) allocator = ds_allocator_default();                                \
+    h->items = NULL;                                                                   \
+    h->size = h->capacity = 0;                                                         \
+    h->alloc = *allocator;                                                             \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_destroy(name##_t *h) {                                     \
+    if (!h) return;                                                                    \
+    if (h->items) ds_mem_free(&h->alloc, h->items, sizeof(T) * h->capacity);           \
+    h->items = NULL;                                                                   \
+    h->size = h->capacity = 0;                                                         \
+  }                                                                                    \
+                                                                                       \
+  static inline size_t name##_size(const name##_t *h) {                                \
+    return h ? h->size : 0;                                                            \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_reserve(name##_t *h, size_t needed) {               \
+    if (needed <= h->capacity) return DS_OK;                                           \
+    size_t cap = ds_growth_next_capacity(ds_growth_policy_default(), h->capacity, needed); \
+    if (cap == 0 || cap > SIZE_MAX / sizeof(T)) return DS_ERR_MEM;                     \
+    T *items = ds_mem_realloc(&h->alloc, h->items, sizeof(T) * h->capacity,            \
+                              sizeof(T) * cap);                                        \
+    if (!items) return DS_ERR_MEM;                                                     \
+    h->items = items;                                                                  \
+    h->capacity = cap;                                                                 \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_shift_down(name##_t *h, size_t i) {                        \
+    size_t n = h->size;                                                                \
+    T x = h->items[i];                                                                 \
+    for (;;) {                                                                         \
+      size_t best = 2 * i + 1;                                                         \
+      if (best >= n) break;                                                            \
+      if (best + 1 < n && name##_less(h->items[best + 1], h->items[best])) best ++;    \
+      if (!name##_less(h->items[best], x)) break;                                      \
+      h->items[i] = h->items[best];                                                    \
+      i = best;                                                                        \
+    }                                                                                  \
+    h->items[i] = x;                                                                   \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_push(name##_t *h, T value) {                        \
+    if (!h) return DS_ERR_NULL;                                                        \
+    ds_status_t ret = name##_reserve(h, h->size + 1);                                  \
+    if (ret != DS_OK) return ret;                                                      \
+    size_t i = h->size ++;                                                             \
+    while (i > 0) {                                                                    \
+      size_t p = (i - 1) >> 1;                                                         \
+      if (!name##_less(value, h->items[p])) break;                                     \
+      h->items[i] = h->items[p];                                                       \
+      i = p;                                                                           \
+    }                                                                                  \
+    h->items[i] = value;                                                               \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_pop(name##_t *h, T *out) {                          \
+    if (!h) return DS_ERR_NULL;                                                        \
+    if (h->size == 0) return DS_ERR_EMPTY;                                             \
+    if (out) *out = h->items[0];                                                       \
+    h->items[0] = h->items[-- h->size];                                                \
+    if (h->size > 1) name##_shift_down(h, 0);                                          \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline T *name##_top(name##_t *h) {                                           \
+    if (!h || h->size == 0) return NULL;                                               \
+    return &h->items[0];                                                               \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_assign(name##_t *h, const T *items, size_t n) {     \
+    if (!h) return DS_ERR_NULL;                                                        \
+    if (n > 0 && !items) return DS_ERR_ARG;                                            \
+    ds_status_t ret = name##_reserve(h, n);                                            \
+    if (ret != DS_OK) return ret;                                                      \
+    for (size_t i = 0; i < n; ++ i) h->items[i] = items[i];                            \
+    h->size = n;                                                                       \
+    for (size_t i = n / 2; i-- > 0; ) name##_shift_down(h, i);                         \
+    return DS_OK;                                                                      \
+  }
+
+/* ========================================================================== */
+/*                                   Sort                                     */
+/* ========================================================================== */
+
+/**
+ * @brief Generate `name##_sort()`, an in-place introsort of a T array.
+ *
+ *   void name_sort(T *data, size_t n);
+ *
+ * Quicksort with a median-of-three pivot, insertion sort for runs of at
+ * most 16 elements, and a switch to heapsort once the recursion passes
+ * 2*log2(n) levels, so the worst case stays O(n log n). The smaller
+ * partition is recursed into and the larger one looped on, which bounds
+ * the stack at O(log n). Not stable.
+ */
+#define DS_DEFINE_SORT(name, T, less_expr)                                             \
+  DS_SORT_IMPL_(name, T, const void *, less_expr)                                      \
+                                                                                       \
+  static inline void name##_sort(T *data, size_t n) {                                  \
+    name##_sort_ctx_(data, n, NULL);                                                   \
+  }
+
+/**
+ * @brief Same as DS_DEFINE_SORT, with a context value of type C that
+ *        `less_expr` can use under the name `ctx`.
+ *
+ *   void name_sort(T *data, size_t n, C ctx);
+ *
+ *   DS_DEFINE_SORT_CTX(by_cb, void *, ds_compare_f, ctx(a, b) < 0)
+ */
+#define DS_DEFINE_SORT_CTX(name, T, C, less_expr)                                      \
+  DS_SORT_IMPL_(name, T, C, less_expr)                                                 \
+                                                                                       \
+  static inline void name##_sort(T *data, size_t n, C ctx) {                           \
+    name##_sort_ctx_(data, n, ctx);                                                    \
+  }
+
+/*
+ * Shared body of DS_DEFINE_SORT and DS_DEFINE_SORT_CTX. `ctx` is unused by
+ * the plain variant.
+ */
+#define DS_SORT_IMPL_(name, T, C, less_expr)                                           \
+  static inline bool name##_sort_less_(T a, T b, C ctx) {                              \
+    (void)ctx;                                                                         \
+    return (less_expr);                                                                \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_sort_insertion_(T *d, size_t n, C ctx) {                   \
+    for (size_t i = 1; i < n; ++ i) {                                                  \
+      T x = d[i];                                                                      \
+      size_t j = i;                                                                    \
+      while (j > 0 && name##_sort_less_(x, d[j - 1], ctx)) {                           \
+        d[j] = d[j - 1];                                                               \
+        j --;                                                                          \
+      }                                                                                \
+      d[j] = x;                                                                        \
+    }                                                                                  \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_sort_sift_(T *d, size_t i, size_t n, C ctx) {              \
+    T x = d[i];                                                                        \
+    for (;;) {                                                                         \
+      size_t c = 2 * i + 1;                                                            \
+      if (c >= n) break;                                                               \
+      if (c + 1 < n && name##_sort_less_(d[c], d[c + 1], ctx)) c ++;                   \
+      if (!name##_sort_less_(x, d[c], ctx)) break;                                     \
+      d[i] = d[c];                                                                     \
+      i = c;                                                                           \
+    }                                                                                  \
+    d[i] = x;                                                                          \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_sort_heap_(T *d, size_t n, C ctx) {                        \
+    for (size_t i = n / 2; i-- > 0; ) name##_sort_sift_(d, i, n, ctx);                 \
+    while (n > 1) {                                                                    \
+      T x = d[0];                                                                      \
+      d[0] = d[-- n];                                                                  \
+      d[n] = x;                                                                        \
+      name##_sort_sift_(d, 0, n, ctx);                                                 \
+    }                                                                                  \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_sort_loop_(T *d, size_t n, size_t depth, C ctx) {          \
+    while (n > 16) {                                                                   \
+      if (depth -- == 0) {                                                             \
+        name##_sort_heap_(d, n, ctx);                                                  \
+        return;                                                                        \
+      }                                                                                \
+      /* Median of three: d[0] <= d[mid] <= d[n - 1] act as sentinels */               \
+      size_t mid = n / 2;                                                              \
+      T t;                                                                             \
+      if (name##_sort_less_(d[mid], d[0], ctx)) { t = d[mid]; d[mid] = d[0]; d[0] = t; } \
+      if (name##_sort_less_(d[n - 1], d[mid], ctx)) {                                  \
+        t = d[mid]; d[mid] = d[n - 1]; d[n - 1] = t;                                   \
+        if (name##_sort_less_(d[mid], d[0], ctx)) { t = d[mid]; d[mid] = d[0]; d[0] = t; } \
+      }                                                                                \
+      /* Hoare partition: [0, i) <= pivot <= [i, n) */                                 \
+      T pivot = d[mid];                                                                \
+      size_t i = 0, j = n - 1;                                                         \
+      for (;;) {                                                                       \
+        while (name##_sort_less_(d[++ i], pivot, ctx)) {}                              \
+        while (name##_sort_less_(pivot, d[-- j], ctx)) {}                              \
+        if (i >= j) break;                                                             \
+        t = d[i]; d[i] = d[j]; d[j] = t;                                               \
+      }                                                                                \
+      if (i < n - i) {                                                                 \
+        name##_sort_loop_(d, i, depth, ctx);                                           \
+        d += i;                                                                        \
+        n -= i;                                                                        \
+      } else {                                                                         \
+        name##_sort_loop_(d + i, n - i, depth, ctx);                                   \
+        n = i;                                                                         \
+      }                                                                                \
+    }                                                                                  \
+    name##_sort_insertion_(d, n, ctx);                                                 \
+  }                                                                                    \
+                                                                                       \
+  static inline void name##_sort_ctx_(T *d, size_t n, C ctx) {                         \
+    size_t depth = 0;                                                                  \
+    for (size_t m = n; m > 1; m >>= 1) depth += 2;                                     \
+    name##_sort_loop_(d, n, depth, ctx);                                               \
+  }
+
+/* ========================================================================== */
+/*                            Binary search tree                              */
+/* ========================================================================== */
+
+/**
+ * @brief Generate `name##_t`, an (unbalanced) binary search tree of T.
+ *
+ * Same semantics as ds_bst_t: duplicates are rejected with DS_ERR_EXIST.
+ * All operations are iterative, so degenerate (sorted-input) trees do not
+ * overflow the stack.
+ *
+ *   ds_status_t name_init(name_t *t, const ds_allocator_t *allocator);
+ *   void        name_destroy(name_t *t);
+ *   ds_status_t name_insert(name_t *t, T value);
+ *   T          *name_search(const name_t *t, T key);  // NULL if absent
+ *   ds_status_t name_remove(name_t *t, T key);
+ *   T          *name_min(const name_t *t);
+ *   T          *name_max(const name_t *t);
+ *   size_t      name_size(const name_t *t);
+ *
+ *   DS_GENERIC_BST_FOREACH(name, t, var) { ... }        // in-order walk
+ */
+#define DS_DEFINE_BST(name, T, less_expr)                                              \
+  typedef struct name##_node {                                                         \
+    T value;                                                                           \
+    struct name##_node *left;                                                          \
+    struct name##_node *right;                                                         \
+  } name##_node_t;                                                                     \
+                                                                                       \
+  typedef struct {                                                                     \
+    name##_node_t *root;                                                               \
+    size_t size;                                                                       \
+    ds_allocator_t alloc;                                                              \
+  } name##_t;                                                                          \
+                                                                                       \
+  static inline bool name##_less(T a, T b) {                                           \
+    return (less_expr);                                                                \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_init(name##_t *t, const ds_allocator_t *allocator) { \
+    if (!t) return DS_ERR_NULL;                                                        \
+    if (!allocator) allocator = ds_allocator_default();                                \
+    t->root = NULL;                                                                    \
+    t->size = 0;                                                                       \
+    t->alloc = *allocator;                                                             \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  /* Rotate left children up until none is left, freeing as we go: O(n), O(1) space */ \
+  static inline void name##_destroy(name##_t *t) {                                     \
+    if (!t) return;                                                                    \
+    name##_node_t *node = t->root;                                                     \
+    while (node) {                                                                     \
+      if (node->left) {                                                                \
+        name##_node_t *l = node->left;                                                 \
+        node->left = l->right;                                                         \
+        l->right = node;                                                               \
+        node = l;                                                                      \
+      } else {                                                                         \
+        name##_node_t *next = node->right;                                             \
+        ds_mem_free(&t->alloc, node, sizeof(name##_node_t));                           \
+        node = next;                                                                   \
+      }                                                                                \
+    }                                                                                  \
+    t->root = NULL;                                                                    \
+    t->size = 0;                                                                       \
+  }                                                                                    \
+                                                                                       \
+  static inline size_t name##_size(const name##_t *t) {                                \
+    return t ? t->size : 0;                                                            \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_insert(name##_t *t, T value) {                      \
+    if (!t) return DS_ERR_NULL;                                                        \
+    name##_node_t **link = &t->root;                                                   \
+    while (*link) {                                                                    \
+      if (name##_less(value, (*link)->value)) link = &(*link)->left;                   \
+      else if (name##_less((*link)->value, value)) link = &(*link)->right;             \
+      else return DS_ERR_EXIST;                                                        \
+    }                                                                                  \
+    name##_node_t *node = ds_mem_alloc(&t->alloc, sizeof(name##_node_t));              \
+    if (!node) return DS_ERR_MEM;                                                      \
+    node->value = value;                                                               \
+    node->left = node->right = NULL;                                                   \
+    *link = node;                                                                      \
+    t->size ++;                                                                        \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline T *name##_search(const name##_t *t, T key) {                           \
+    if (!t) return NULL;                                                               \
+    name##_node_t *node = t->root;                                                     \
+    while (node) {                                                                     \
+      if (name##_less(key, node->value)) node = node->left;                            \
+      else if (name##_less(node->value, key)) node = node->right;                      \
+      else return &node->value;                                                        \
+    }                                                                                  \
+    return NULL;                                                                       \
+  }                                                                                    \
+                                                                                       \
+  static inline ds_status_t name##_remove(name##_t *t, T key) {                        \
+    if (!t) return DS_ERR_NULL;                                                        \
+    name##_node_t **link = &t->root;                                                   \
+    while (*link) {                                                                    \
+      if (name##_less(key, (*link)->value)) link = &(*link)->left;                     \
+      else if (name##_less((*link)->value, key)) link = &(*link)->right;               \
+      else break;                                                                      \
+    }                                                                                  \
+    name##_node_t *node = *link;                                                       \
+    if (!node) return DS_ERR_NOT_FOUND;                                                \
+    if (node->left && node->right) {                                                   \
+      /* Unlink the in-order successor and move its value here */                      \
+      name##_node_t **succ = &node->right;                                             \
+      while ((*succ)->left) succ = &(*succ)->left;                                     \
+      name##_node_t *s = *succ;                                                        \
+      node->value = s->value;                                                          \
+      *succ = s->right;                                                                \
+      node = s;                                                                        \
+    } else {                                                                           \
+      *link = node->left ? node->left : node->right;                                   \
+    }                                                                                  \
+    ds_mem_free(&t->alloc, node, sizeof(name##_node_t));                               \
+    t->size --;                                                                        \
+    return DS_OK;                                                                      \
+  }                                                                                    \
+                                                                                       \
+  static inline T *name##_min(const name##_t *t) {                                     \
+    if (!t || !t->root) return NULL;                                                   \
+    name##_node_t *node = t->root;                                                     \
+    while (node->left) node = node->left;                                              \
+    return &node->value;                                                               \
+  }                                                                                    \
+                                                                                       \
+  static inline T *name##_max(const name##_t *t) {                                     \
+    if (!t || !t->root) return NULL;                                                   \
+    name##_node_t *node = t->root;                                                     \
+    while (node->right) node = node->right;                                            \
+    return &node->value;                                                               \
+  }                                                                                    \
+                                                                                       \
+  /* In-order successor of `node` for DS_GENERIC_BST_FOREACH (O(h) per step) */        \
+  static inline name##_node_t *name##_next_node(const name##_t *t, name##_node_t *node) { \
+    if (node->right) {                                                                 \
+      node = node->right;                                                              \
+      while (node->left) node = node->left;                                            \
+      return node;                                                                     \
+    }                                                                                  \
+    name##_node_t *succ = NULL, *cur = t->root;                                        \
+    while (cur != node) {                                                              \
+      if (name##_less(node->value, cur->value)) { succ = cur; cur = cur->left; }       \
+      else cur = cur->right;                                                           \
+    }                                                                                  \
+    return succ;                                                                       \
+  }                                                                                    \
+                                                                                       \
+  static inline name##_node_t *name##_first_node(const name##_t *t) {                  \
+    name##_node_t *node = t ? t->root : NULL;                                          \
+    while (node && node->left) node = node->left;                                      \
+    return node;                                                                       \
+  }
+
+/**
+ * @brief In-order loop over a DS_DEFINE_BST tree; `var` is a `T *`.
+ *
+ * The body is plain inline code, so there is no visit callback. The tree
+ * must not be modified inside the loop.
+ */
+#define DS_GENERIC_BST_FOREACH(name, tree, var)                                        \
+  for (name##_node_t *var##_node_ = name##_first_node(tree);                           \
+       var##_node_ && ((var) = &var##_node_->value, 1);                                \
+       var##_node_ = name##_next_node((tree), var##_node_))
+
+#endif // !DS_GENERIC_H
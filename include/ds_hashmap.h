@@ -0,0 +1,226 @@
+/*
+** include/ds_hashmap.h -- Open-addressing hash map (Swiss-table layout)
+**                         with incremental resizing.
+*/
+
+#ifndef DS_HASHMAP_H
+#define DS_HASHMAP_H
+
+#include "ds_common.h"
+#include "ds_stats.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Swiss table
+ * -------------------------------------------------------------------------
+ *
+ *   ctrl:   [h2|h2|EM|h2|DL|EM|..16..] [ group 1 ] ...   1 byte per slot
+ *   slots:  [k,v  |k,v  |     |k,v  |     |     ]  ...   16 bytes per slot
+ *
+ * The mixed hash is split into h1 (which group to start at) and h2
+ * (7 bits stored in the control byte of a full slot). A lookup loads a
+ * group of 16 control bytes and compares all of them against h2 at once
+ * (SSE2 when available, a portable loop otherwise); only slots whose
+ * byte matches are compared with the user's equality callback. A group
+ * containing an EMPTY byte ends the probe. Groups are probed in
+ * triangular order, which visits every group of a power-of-two table.
+ *
+ * Removal leaves a DELETED tombstone unless the slot's group still has an
+ * EMPTY byte (then no probe can have passed through it). The table holds
+ * at most 7/8 of its slots in use, tombstones included.
+ *
+ * Incremental resize:
+ *   When the table fills up, a new one is allocated (twice the size, or
+ *   the same size if tombstones are the problem) and the old one is kept.
+ *   Every insert/put/remove then moves one group of old slots over, so no
+ *   single call pays for the whole rehash. Lookups check both tables
+ *   until the old one is drained. ds_hashmap_reserve() and
+ *   ds_hashmap_rehash() resize synchronously instead.
+ *
+ * Ownership: keys and values are `void *` and are never copied. The
+ * map frees them only through the ds_free_f callbacks passed to remove,
+ * clear and destroy.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque hash map type.
+ */
+typedef struct ds_hashmap ds_hashmap_t;
+
+/**
+ * @brief Create a new hash map.
+ *
+ * @param hash           Key hash function.
+ * @param equal          Key equality function.
+ * @param capacity_hint  Number of entries to size the table for. If zero,
+ *                       a default is used.
+ *
+ * @return Pointer to a new map on success, or NULL on failure.
+ */
+ds_hashmap_t *ds_hashmap_create(ds_hash_f hash, ds_equal_f equal, size_t capacity_hint);
+
+/**
+ * @brief Create a new hash map using a custom allocator.
+ *
+ * @param allocator  Allocator for the map and its tables. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new map on success, or NULL on failure.
+ */
+ds_hashmap_t *ds_hashmap_create_ex(ds_hash_f hash, ds_equal_f equal, size_t capacity_hint,
+                                   const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a map and optionally free its keys and values.
+ *
+ * @param map         Pointer to the map.
+ * @param key_free    Optional key destructor.
+ * @param value_free  Optional value destructor.
+ */
+void ds_hashmap_destroy(ds_hashmap_t *map, ds_free_f key_free, ds_free_f value_free);
+
+/**
+ * @brief Get the current number of entries.
+ */
+size_t ds_hashmap_size(const ds_hashmap_t *map);
+
+/**
+ * @brief Check if the map is empty.
+ */
+bool ds_hashmap_is_empty(const ds_hashmap_t *map);
+
+/**
+ * @brief Get the number of slots in the current table.
+ */
+size_t ds_hashmap_capacity(const ds_hashmap_t *map);
+
+/**
+ * @brief Get the instrumentation counters (see ds_stats.h).
+ *
+ * Allocator traffic, table resizes (the latency covers allocating the
+ * new table, not the incremental migration), lookups, equality calls and
+ * probe lengths in groups of 16 slots.
+ *
+ * @return
+ *   - DS_OK               On success.
+ *   - DS_ERR_NULL         If map or out is NULL.
+ *   - DS_ERR_UNSUPPORTED  If built without DS_ENABLE_STATS.
+ */
+ds_status_t ds_hashmap_stats(const ds_hashmap_t *map, ds_stats_t *out);
+
+/**
+ * @brief Insert a new entry.
+ *
+ * @param map    Pointer to the map.
+ * @param key    Pointer to the key. Must not be NULL.
+ * @param value  Pointer to the value. May be NULL.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_EXIST  If an equal key is already in the map.
+ *  - DS_ERR_MEM    If the table could not grow.
+ *  - DS_ERR_*      On invalid arguments.
+ */
+ds_status_t ds_hashmap_insert(ds_hashmap_t *map, void *key, void *value);
+
+/**
+ * @brief Insert an entry, or replace the value of an existing one.
+ *
+ * When the key is already present the stored key is kept, only the
+ * value is replaced.
+ *
+ * @param map             Pointer to the map.
+ * @param key             Pointer to the key. Must not be NULL.
+ * @param value           Pointer to the value. May be NULL.
+ * @param old_value_free  Optional destructor for a replaced value.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_hashmap_put(ds_hashmap_t *map, void *key, void *value, ds_free_f old_value_free);
+
+/**
+ * @brief Get the value stored for a key.
+ *
+ * @return The value, or NULL if the key is not present (or maps to NULL;
+ *         use ds_hashmap_contains() to tell the two apart).
+ */
+void *ds_hashmap_get(const ds_hashmap_t *map, const void *key);
+
+/**
+ * @brief Check whether a key is present.
+ */
+bool ds_hashmap_contains(const ds_hashmap_t *map, const void *key);
+
+/**
+ * @brief Remove the entry for a key.
+ *
+ * @param map         Pointer to the map.
+ * @param key         Key to remove.
+ * @param key_free    Optional destructor for the stored key.
+ * @param value_free  Optional destructor for the stored value.
+ *
+ * @return
+ *  - DS_OK             On success.
+ *  - DS_ERR_NOT_FOUND  If the key is not present.
+ *  - DS_ERR_*          On invalid arguments.
+ */
+ds_status_t ds_hashmap_remove(ds_hashmap_t *map, const void *key, ds_free_f key_free, ds_free_f value_free);
+
+/**
+ * @brief Remove all entries. The table keeps its capacity.
+ *
+ * @param map         Pointer to the map.
+ * @param key_free    Optional key destructor.
+ * @param value_free  Optional value destructor.
+ */
+void ds_hashmap_clear(ds_hashmap_t *map, ds_free_f key_free, ds_free_f value_free);
+
+/**
+ * @brief Make room for `count` entries without any further resize.
+ *
+ * Finishes a pending incremental resize and, if needed, rehashes
+ * synchronously into a larger table.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_hashmap_reserve(ds_hashmap_t *map, size_t count);
+
+/**
+ * @brief Rebuild the table synchronously, dropping all tombstones.
+ *
+ * @param map    Pointer to the map.
+ * @param count  Entries to size the new table for. Values below the
+ *               current size are raised to it, so 0 shrinks to fit.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_hashmap_rehash(ds_hashmap_t *map, size_t count);
+
+/**
+ * @brief Step through the entries in unspecified order.
+ *
+ * Start with *cursor == 0. Any insert, put or remove invalidates the
+ * cursor.
+ *
+ *   size_t cursor = 0;
+ *   void *k, *v;
+ *   while (ds_hashmap_next(map, &cursor, &k, &v)) { ... }
+ *
+ * @param map     Pointer to the map.
+ * @param cursor  Iteration state.
+ * @param key     Optional output for the key.
+ * @param value   Optional output for the value.
+ *
+ * @return true if an entry was produced, false at the end.
+ */
+bool ds_hashmap_next(const ds_hashmap_t *map, size_t *cursor, void **key, void **value);
+
+#endif // !DS_HASHMAP_H
@@ -2,6 +2,8 @@
 #define DS_HEAP_H
 
 #include "ds_common.h"
+#include "ds_span.h"
+#include "ds_stats.h"
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -26,6 +28,48 @@ typedef struct ds_heap ds_heap_t;
  */
 ds_heap_t *ds_heap_create(ds_compare_f compare, size_t capacity_hint);
 
+/**
+ * @brief Create a binary heap using a custom allocator.
+ *
+ * @param compare        Used to determine if the heap is a max-heap or min-heap.
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the heap and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_heap_t *ds_heap_create_ex(ds_compare_f compare, size_t capacity_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Create a heap from an array of elements in O(n).
+ *
+ * Runs Floyd's bottom-up heapify instead of n pushes (O(n log n)), and
+ * allocates storage once.
+ *
+ * @param compare  Comparison function, as for ds_heap_create().
+ * @param items    Array of `n` non-NULL elements. The pointers are copied;
+ *                 the array itself is not adopted.
+ * @param n        Number of elements.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_heap_t *ds_heap_create_from(ds_compare_f compare, void *const *items, size_t n);
+
+/**
+ * @brief Create a heap from an array of elements using a custom allocator.
+ *
+ * @param compare    Comparison function, as for ds_heap_create().
+ * @param items      Array of `n` non-NULL elements (copied).
+ * @param n          Number of elements.
+ * @param allocator  Allocator for the heap and its storage. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_heap_t *ds_heap_create_from_ex(ds_compare_f compare, void *const *items, size_t n,
+                                  const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a heap and optionally free its elements.
  *
@@ -46,6 +90,30 @@ size_t ds_heap_size(const ds_heap_t *heap);
  */
 size_t ds_heap_capacity(const ds_heap_t *heap);
 
+/**
+ * @brief Get the instrumentation counters (see ds_stats.h).
+ *
+ * Storage resizes and their latency, allocator traffic and calls to the
+ * comparison function.
+ *
+ * @return
+ *   - DS_OK               On success.
+ *   - DS_ERR_NULL         If heap or out is NULL.
+ *   - DS_ERR_UNSUPPORTED  If built without DS_ENABLE_STATS.
+ */
+ds_status_t ds_heap_stats(const ds_heap_t *heap, ds_stats_t *out);
+
+/**
+ * @brief Get a read-only span over the elements in storage (heap) order.
+ *
+ * Feeding the pointers back to ds_heap_create_from() rebuilds the same
+ * heap with no element moves. The span is invalidated by any push, pop
+ * or resize; the slots must not be written through it.
+ *
+ * @return A span of size() pointers, or an empty span if heap is NULL.
+ */
+ds_span_t ds_heap_as_span(const ds_heap_t *heap);
+
 /**
  * @brief Check if the heap is empty.
  */
@@ -63,6 +131,52 @@ bool ds_heap_is_empty(const ds_heap_t *heap);
  */
 ds_status_t ds_heap_push(ds_heap_t *heap, void *element);
 
+/**
+ * @brief Insert `count` elements at once.
+ *
+ * Storage grows at most once. When the batch is at least as large as the
+ * heap already is, the whole array is re-heapified in O(size + count);
+ * otherwise each new element is sifted up.
+ *
+ * @param heap      Pointer to the heap.
+ * @param elements  Array of `count` non-NULL elements.
+ * @param count     Number of elements.
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_ARG    If elements is NULL or contains NULL; nothing is inserted.
+ *   - DS_ERR_MEM    If memory allocation fails; nothing is inserted.
+ */
+ds_status_t ds_heap_push_batch(ds_heap_t *heap, void *const *elements, size_t count);
+
+/**
+ * @brief Push an element, then pop the top, with at most one sift.
+ *
+ * Equivalent to push() followed by pop(), but if the element is at least
+ * as good as the current top (or the heap is empty), it is returned right
+ * away and the heap is untouched. Useful for top-K selection.
+ *
+ * @param heap     Pointer to the heap.
+ * @param element  Element to insert.
+ *
+ * @return The element that leaves the heap, or NULL on invalid arguments.
+ */
+void *ds_heap_pushpop(ds_heap_t *heap, void *element);
+
+/**
+ * @brief Pop the top, then push an element, with one sift.
+ *
+ * Unlike ds_heap_pushpop(), the returned element is always the old top,
+ * even if the new element is better.
+ *
+ * @param heap     Pointer to the heap.
+ * @param element  Element to insert.
+ *
+ * @return The previous top element, or NULL if the heap is empty (the
+ *         element is then not inserted) or on invalid arguments.
+ */
+void *ds_heap_replace_top(ds_heap_t *heap, void *element);
+
 /**
  * @brief Remove the top element of the heap and return that element.
  *
@@ -97,4 +211,55 @@ void *ds_heap_top(ds_heap_t *heap);
  */
 void ds_heap_clear(ds_heap_t *heap, ds_free_f free_func);
 
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param heap  Pointer to the heap.
+ *
+ * @return
+ *   - DS_OK on success (an empty heap keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the heap is unchanged.
+ */
+ds_status_t ds_heap_shrink_to_fit(ds_heap_t *heap);
+
+/**
+ * @brief Set the growth policy of the heap.
+ *
+ * The policy decides how much the heap grows when full and whether it
+ * shrinks automatically after pop/clear (see ds_growth_policy_t).
+ *
+ * @param heap    Pointer to the heap.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_heap_set_growth_policy(ds_heap_t *heap, const ds_growth_policy_t *policy);
+
+/**
+ * @brief Get the number of children per node (2 for a new heap).
+ */
+size_t ds_heap_arity(const ds_heap_t *heap);
+
+/**
+ * @brief Set the number of children per node.
+ *
+ * A d-ary heap is log2(d) times shallower than a binary one, and the d
+ * children of a node are adjacent in memory (8 pointers = one 64-byte
+ * line), so pop touches fewer cache lines at the cost of d - 1 compares
+ * per level instead of 1. Push gets cheaper too (fewer levels to climb).
+ * 4 or 8 usually beats 2 for large heaps with a cheap compare.
+ *
+ * Existing elements are re-heapified in O(n).
+ *
+ * @param heap   Pointer to the heap.
+ * @param arity  2, 4, 8 or 16.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if arity is not one of the supported values.
+ */
+ds_status_t ds_heap_set_arity(ds_heap_t *heap, size_t arity);
+
 #endif // !DS_HEAP_H
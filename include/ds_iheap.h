@@ -0,0 +1,194 @@
+/*
+** include/ds_iheap.h -- An addressable (indexed) binary heap. push()
+**                       returns a handle that can later be used to change
+**                       an element's priority or remove it in O(log n).
+*/
+
+#ifndef DS_IHEAP_H
+#define DS_IHEAP_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Addressable heap
+ * -------------------------------------------------------------------------
+ *
+ * Same array layout and comparison convention as `ds_heap_t` (compare(a,b)
+ * < 0 means a is "better" and rises to the top), plus a handle table:
+ *
+ *   entries: [ {elem, handle} {elem, handle} ... ]   the heap array
+ *   pos:     pos[handle] = index of that handle in `entries`
+ *
+ * Every move done by shift_up/shift_down also updates `pos`, so a handle
+ * finds its element in O(1) and re-sifts it in O(log n).
+ *
+ * Handles are small integers. A handle becomes invalid once its element
+ * leaves the heap (pop/remove/clear) and may then be reused by a later
+ * push, so callers must forget handles of removed elements.
+ *
+ * Changing priority:
+ *   - decrease_key: the element got better (e.g. a shorter distance in
+ *     Dijkstra) -> sifted up.
+ *   - increase_key: the element got worse -> sifted down.
+ *   - update:       direction unknown -> sifted whichever way is needed.
+ * The element may be mutated in place before the call, or replaced by a
+ * new pointer passed to the call.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque addressable heap type.
+ */
+typedef struct ds_iheap ds_iheap_t;
+
+/**
+ * @brief Handle of an element stored in a ds_iheap_t.
+ */
+typedef size_t ds_iheap_handle_t;
+
+/** Never returned by push(); safe as a "no handle" marker. */
+#define DS_IHEAP_INVALID_HANDLE SIZE_MAX
+
+/**
+ * @brief Create an addressable heap.
+ *
+ * @param compare        Used to determine if the heap is a max-heap or min-heap.
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_iheap_t *ds_iheap_create(ds_compare_f compare, size_t capacity_hint);
+
+/**
+ * @brief Create an addressable heap using a custom allocator.
+ *
+ * @param compare        Used to determine if the heap is a max-heap or min-heap.
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the heap and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_iheap_t *ds_iheap_create_ex(ds_compare_f compare, size_t capacity_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a heap and optionally free its elements.
+ *
+ * @param heap       Pointer to the heap.
+ * @param free_func  Optional element destructor.
+ */
+void ds_iheap_destroy(ds_iheap_t *heap, ds_free_f free_func);
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_iheap_size(const ds_iheap_t *heap);
+
+/**
+ * @brief Check if the heap is empty.
+ */
+bool ds_iheap_is_empty(const ds_iheap_t *heap);
+
+/**
+ * @brief Insert a new element.
+ *
+ * @param heap        Pointer to the heap.
+ * @param element     Pointer to the element to insert.
+ * @param out_handle  Where to store the element's handle. May be NULL.
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_*      On failure.
+ */
+ds_status_t ds_iheap_push(ds_iheap_t *heap, void *element, ds_iheap_handle_t *out_handle);
+
+/**
+ * @brief Get the top element without removing it.
+ *
+ * @return The top element, or NULL if the heap is empty.
+ */
+void *ds_iheap_top(const ds_iheap_t *heap);
+
+/**
+ * @brief Get the handle of the top element.
+ *
+ * @return The handle, or DS_IHEAP_INVALID_HANDLE if the heap is empty.
+ */
+ds_iheap_handle_t ds_iheap_top_handle(const ds_iheap_t *heap);
+
+/**
+ * @brief Remove the top element and return it.
+ *
+ * Its handle becomes invalid.
+ *
+ * @return The removed element, or NULL if the heap is empty.
+ */
+void *ds_iheap_pop(ds_iheap_t *heap);
+
+/**
+ * @brief Check whether a handle refers to an element in the heap.
+ */
+bool ds_iheap_contains(const ds_iheap_t *heap, ds_iheap_handle_t handle);
+
+/**
+ * @brief Get the element of a handle.
+ *
+ * @return The element, or NULL if the handle is not in the heap.
+ */
+void *ds_iheap_get(const ds_iheap_t *heap, ds_iheap_handle_t handle);
+
+/**
+ * @brief Restore heap order after an element got better.
+ *
+ * @param heap     Pointer to the heap.
+ * @param handle   Handle of the element.
+ * @param element  The element's new value: the same pointer (mutated in
+ *                 place) or a replacement. It must not be worse than
+ *                 before; use ds_iheap_update() if unsure.
+ *
+ * @return
+ *   - DS_OK          On success.
+ *   - DS_ERR_NOT_FOUND If the handle is not in the heap.
+ *   - DS_ERR_*       On invalid arguments.
+ */
+ds_status_t ds_iheap_decrease_key(ds_iheap_t *heap, ds_iheap_handle_t handle, void *element);
+
+/**
+ * @brief Restore heap order after an element got worse.
+ *
+ * Same as ds_iheap_decrease_key(), in the other direction.
+ */
+ds_status_t ds_iheap_increase_key(ds_iheap_t *heap, ds_iheap_handle_t handle, void *element);
+
+/**
+ * @brief Restore heap order after an element changed in either direction.
+ *
+ * Same as ds_iheap_decrease_key(), without the direction requirement.
+ */
+ds_status_t ds_iheap_update(ds_iheap_t *heap, ds_iheap_handle_t handle, void *element);
+
+/**
+ * @brief Remove the element of a handle and return it.
+ *
+ * The handle becomes invalid.
+ *
+ * @return The removed element, or NULL if the handle is not in the heap.
+ */
+void *ds_iheap_remove(ds_iheap_t *heap, ds_iheap_handle_t handle);
+
+/**
+ * @brief Remove all elements from the heap.
+ *
+ * Every handle becomes invalid.
+ *
+ * @param heap       Pointer to the heap.
+ * @param free_func  Optional element destructor.
+ */
+void ds_iheap_clear(ds_iheap_t *heap, ds_free_f free_func);
+
+#endif // !DS_IHEAP_H
@@ -0,0 +1,183 @@
+/*
+** include/ds_ilist.h -- Intrusive doubly linked list. The caller embeds a
+**                       ds_ilist_link_t in its own objects, so the list
+**                       never allocates.
+*/
+
+#ifndef DS_ILIST_H
+#define DS_ILIST_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Intrusive list
+ * -------------------------------------------------------------------------
+ *
+ *   struct job { int id; ds_ilist_link_t link; };
+ *
+ *   +-> [head] <-> [job.link] <-> [job.link] <-> ... --+
+ *   +--------------------------------------------------+
+ *
+ * `ds_list_t` stores a `void *` in a separately allocated node, so each
+ * element costs two allocations and two cache misses to reach. Here the
+ * link lives inside the element:
+ *   - push/insert/remove allocate nothing and cannot fail for lack of memory.
+ *   - Reaching the element from a link is pointer arithmetic
+ *     (DS_CONTAINER_OF), not a load.
+ *   - remove takes the link itself, O(1), no search.
+ *
+ * The list is a circular chain through an embedded sentinel `head`, so
+ * no operation has an empty/head/tail special case. The list and its
+ * links are plain structs owned by the caller; ds_ilist_init() is the
+ * only setup.
+ *
+ * Ownership: the list never frees anything. An element must outlive its
+ * membership and may be in at most one list per embedded link.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Link embedded in an element.
+ *
+ * Both pointers are NULL while the link is in no list.
+ */
+typedef struct ds_ilist_link {
+  struct ds_ilist_link *prev;
+  struct ds_ilist_link *next;
+} ds_ilist_link_t;
+
+/**
+ * @brief Intrusive list. Initialize with ds_ilist_init() before use.
+ */
+typedef struct {
+  ds_ilist_link_t head;       // Sentinel: head.next is the front, head.prev the back
+  size_t size;
+} ds_ilist_t;
+
+/**
+ * @brief Callback applied to each link by ds_ilist_clear().
+ */
+typedef void (*ds_ilist_visit_f)(ds_ilist_link_t *link);
+
+/**
+ * @brief Initialize an empty list.
+ */
+void ds_ilist_init(ds_ilist_t *list);
+
+/**
+ * @brief Initialize a link as "in no list".
+ */
+void ds_ilist_link_init(ds_ilist_link_t *link);
+
+/**
+ * @brief Check whether a link is currently in a list.
+ */
+bool ds_ilist_link_is_linked(const ds_ilist_link_t *link);
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_ilist_size(const ds_ilist_t *list);
+
+/**
+ * @brief Check if the list is empty.
+ */
+bool ds_ilist_is_empty(const ds_ilist_t *list);
+
+/**
+ * @brief Append a link to the end of the list.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_ARG    If the link is already in a list.
+ *  - DS_ERR_*      On other failures.
+ */
+ds_status_t ds_ilist_push_back(ds_ilist_t *list, ds_ilist_link_t *link);
+
+/**
+ * @brief Prepend a link to the front of the list.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_ARG    If the link is already in a list.
+ *  - DS_ERR_*      On other failures.
+ */
+ds_status_t ds_ilist_push_front(ds_ilist_t *list, ds_ilist_link_t *link);
+
+/**
+ * @brief Insert a link before the specified position.
+ *
+ * @param list  Pointer to the list.
+ * @param pos   A link in the list, or NULL to append.
+ * @param link  Link to insert. Must not be in a list.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_ilist_insert(ds_ilist_t *list, ds_ilist_link_t *pos, ds_ilist_link_t *link);
+
+/**
+ * @brief Unlink a link from the list.
+ *
+ * @param list  Pointer to the list.
+ * @param link  A link in this list.
+ *
+ * @return The link after the removed one, or NULL if it was the last.
+ */
+ds_ilist_link_t *ds_ilist_remove(ds_ilist_t *list, ds_ilist_link_t *link);
+
+/**
+ * @brief Unlink and return the first link.
+ *
+ * @return The removed link, or NULL if the list is empty.
+ */
+ds_ilist_link_t *ds_ilist_pop_front(ds_ilist_t *list);
+
+/**
+ * @brief Unlink and return the last link.
+ *
+ * @return The removed link, or NULL if the list is empty.
+ */
+ds_ilist_link_t *ds_ilist_pop_back(ds_ilist_t *list);
+
+/**
+ * @brief Unlink every link.
+ *
+ * @param list   Pointer to the list.
+ * @param visit  Optional callback, called on each link after it is
+ *               unlinked (e.g. to free the enclosing element).
+ */
+void ds_ilist_clear(ds_ilist_t *list, ds_ilist_visit_f visit);
+
+/**
+ * @brief Get the first link.
+ *
+ * @return Returns NULL if the list is empty.
+ */
+ds_ilist_link_t *ds_ilist_front(const ds_ilist_t *list);
+
+/**
+ * @brief Get the last link.
+ *
+ * @return Returns NULL if the list is empty.
+ */
+ds_ilist_link_t *ds_ilist_back(const ds_ilist_t *list);
+
+/**
+ * @brief Get the link after `link`.
+ *
+ * @return Returns NULL after the last link.
+ */
+ds_ilist_link_t *ds_ilist_next(const ds_ilist_t *list, const ds_ilist_link_t *link);
+
+/**
+ * @brief Get the link before `link`.
+ *
+ * @return Returns NULL before the first link.
+ */
+ds_ilist_link_t *ds_ilist_prev(const ds_ilist_t *list, const ds_ilist_link_t *link);
+
+#endif // !DS_ILIST_H
@@ -0,0 +1,167 @@
+/*
+** include/ds_itree.h -- Intrusive red-black tree. The caller embeds a
+**                       ds_itree_link_t in its own objects, so the tree
+**                       never allocates.
+*/
+
+#ifndef DS_ITREE_H
+#define DS_ITREE_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Intrusive tree
+ * -------------------------------------------------------------------------
+ *
+ *   struct item { int key; ds_itree_link_t link; };
+ *
+ *                 [item.link]
+ *                  /       \
+ *         [item.link]     [item.link]
+ *
+ * Same balancing as `ds_rbtree_t`, but the node is the link inside the
+ * caller's element instead of a separate allocation holding `void *data`:
+ *   - insert allocates nothing, so it only fails on a duplicate key.
+ *   - A lookup compares against the element the link is embedded in, so
+ *     each visited level costs one cache line instead of node + payload.
+ *   - remove takes the link itself: O(log n) rebalancing, no search.
+ *
+ * Comparators receive links; use DS_CONTAINER_OF to reach the element.
+ * Lookups take a separate key comparator, so a search needs no dummy
+ * element.
+ *
+ * Ownership: the tree never frees anything. An element must outlive its
+ * membership, and its key must not change while it is in the tree.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Link embedded in an element.
+ */
+typedef struct ds_itree_link {
+  struct ds_itree_link *left;
+  struct ds_itree_link *right;
+  struct ds_itree_link *parent;
+  int color;
+} ds_itree_link_t;
+
+/**
+ * @brief Order two linked elements (< 0, 0, > 0 as for ds_compare_f).
+ */
+typedef int (*ds_itree_compare_f)(const ds_itree_link_t *a, const ds_itree_link_t *b);
+
+/**
+ * @brief Order a key against a linked element (< 0, 0, > 0).
+ */
+typedef int (*ds_itree_key_compare_f)(const void *key, const ds_itree_link_t *link);
+
+/**
+ * @brief Callback applied to each link by ds_itree_clear().
+ */
+typedef void (*ds_itree_visit_f)(ds_itree_link_t *link);
+
+/**
+ * @brief Intrusive tree. Initialize with ds_itree_init() before use.
+ */
+typedef struct {
+  ds_itree_link_t *root;
+  size_t size;
+  ds_itree_compare_f compare;
+} ds_itree_t;
+
+/**
+ * @brief Initialize an empty tree.
+ *
+ * @param tree     Pointer to the tree.
+ * @param compare  Orders two linked elements.
+ */
+void ds_itree_init(ds_itree_t *tree, ds_itree_compare_f compare);
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_itree_size(const ds_itree_t *tree);
+
+/**
+ * @brief Check if the tree is empty.
+ */
+bool ds_itree_is_empty(const ds_itree_t *tree);
+
+/**
+ * @brief Insert a link.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_EXIST  If an equal element is already in the tree.
+ *  - DS_ERR_*      On invalid arguments.
+ */
+ds_status_t ds_itree_insert(ds_itree_t *tree, ds_itree_link_t *link);
+
+/**
+ * @brief Find the element equal to a key.
+ *
+ * @param tree         Pointer to the tree.
+ * @param key          Key to look for.
+ * @param key_compare  Orders `key` against a linked element.
+ *
+ * @return The matching link, or NULL if not found.
+ */
+ds_itree_link_t *ds_itree_find(const ds_itree_t *tree, const void *key, ds_itree_key_compare_f key_compare);
+
+/**
+ * @brief Find the first element not less than a key.
+ *
+ * @return The link, or NULL if every element is less than `key`.
+ */
+ds_itree_link_t *ds_itree_lower_bound(const ds_itree_t *tree, const void *key, ds_itree_key_compare_f key_compare);
+
+/**
+ * @brief Unlink a link from the tree.
+ *
+ * @param tree  Pointer to the tree.
+ * @param link  A link in this tree.
+ */
+void ds_itree_remove(ds_itree_t *tree, ds_itree_link_t *link);
+
+/**
+ * @brief Unlink every link.
+ *
+ * Walks the tree in post-order without recursion or extra memory.
+ *
+ * @param tree   Pointer to the tree.
+ * @param visit  Optional callback, called on each link once its subtree
+ *               is done (e.g. to free the enclosing element).
+ */
+void ds_itree_clear(ds_itree_t *tree, ds_itree_visit_f visit);
+
+/**
+ * @brief Get the smallest element.
+ *
+ * @return Returns NULL if the tree is empty.
+ */
+ds_itree_link_t *ds_itree_first(const ds_itree_t *tree);
+
+/**
+ * @brief Get the largest element.
+ *
+ * @return Returns NULL if the tree is empty.
+ */
+ds_itree_link_t *ds_itree_last(const ds_itree_t *tree);
+
+/**
+ * @brief Get the in-order successor.
+ *
+ * @return Returns NULL after the largest element.
+ */
+ds_itree_link_t *ds_itree_next(const ds_itree_link_t *link);
+
+/**
+ * @brief Get the in-order predecessor.
+ *
+ * @return Returns NULL before the smallest element.
+ */
+ds_itree_link_t *ds_itree_prev(const ds_itree_link_t *link);
+
+#endif // !DS_ITREE_H
@@ -34,6 +34,40 @@ typedef ds_list_node_t* ds_list_iter_t;
  */
 ds_list_t *ds_list_create();
 
+/**
+ * @brief Create a new doubly linked list using a custom allocator.
+ *
+ * @param allocator  Allocator for the list and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_list_t *ds_list_create_ex(const ds_allocator_t *allocator);
+
+/**
+ * @brief Create a new doubly linked list whose nodes come from a node pool.
+ *
+ * Nodes are carved out of contiguous slabs (see ds_pool.h) instead of one
+ * malloc per element. ds_list_clear() and ds_list_destroy() release all
+ * nodes at once; the list is only walked when a free_func is given.
+ *
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_list_t *ds_list_create_pooled(size_t slab_hint);
+
+/**
+ * @brief Create a pooled doubly linked list using a custom allocator.
+ *
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the list and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_list_t *ds_list_create_pooled_ex(size_t slab_hint, const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a list and optionally free its elements.
  *
@@ -161,6 +195,68 @@ ds_list_iter_t ds_list_remove(ds_list_t *list, ds_list_iter_t it, ds_free_f free
  */
 void ds_list_clear(ds_list_t *list, ds_free_f free_func);
 
+/**
+ * @brief Sort the list in place with a stable merge sort.
+ *
+ * Bottom-up merge sort that relinks the existing nodes: O(n log n)
+ * comparisons, O(1) extra space, no allocation. Iterators stay valid
+ * and keep pointing to the same elements.
+ *
+ * @param list     Pointer to the list.
+ * @param compare  Element comparison function.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_list_sort(ds_list_t *list, ds_compare_f compare);
+
+/**
+ * @brief Move the range [first, last) of src in front of pos in dst.
+ *
+ * Nodes are relinked, never copied or allocated, so iterators into the
+ * range stay valid and now belong to dst.
+ *
+ * Nodes must be releasable by dst: either dst == src, or both lists are
+ * non-pooled and use the same allocator (same free function and ctx).
+ *
+ * Relinking is O(1). Moving the whole of src, or moving within a single
+ * list, is O(1) overall; otherwise the range is walked once to update
+ * both sizes.
+ *
+ * @param dst    Destination list.
+ * @param pos    Iterator into dst. The range is inserted before it.
+ *               ds_list_iter_end(dst) appends.
+ * @param src    Source list.
+ * @param first  First node of the range. End means an empty range.
+ * @param last   One past the last node of the range. End means up to
+ *               the end of src. If dst == src, pos must not lie in
+ *               [first, last).
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_list_splice(ds_list_t *dst, ds_list_iter_t pos, ds_list_t *src,
+                           ds_list_iter_t first, ds_list_iter_t last);
+
+/**
+ * @brief Merge the sorted list src into the sorted list dst.
+ *
+ * Stable: equal elements keep their order and elements of dst come
+ * before equal elements of src. src ends up empty. Nodes are relinked
+ * without allocation, under the same rules as ds_list_splice().
+ *
+ * @param dst      Destination list, sorted by compare.
+ * @param src      Source list, sorted by compare.
+ * @param compare  Element comparison function.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_list_merge(ds_list_t *dst, ds_list_t *src, ds_compare_f compare);
+
 /**
  * @brief Get an iterator pointing to the first element
  *
@@ -0,0 +1,96 @@
+/*
+** include/ds_pool.h -- A fixed-size block allocator (node pool).
+**                      Blocks are carved out of large contiguous slabs and
+**                      recycled through an intrusive free list.
+*/
+
+#ifndef DS_POOL_H
+#define DS_POOL_H
+
+#include "ds_common.h"
+
+/**
+ * @brief Opaque pool type.
+ *
+ * A pool hands out blocks of one fixed size. It is meant to back the
+ * nodes of node-based containers (list, bst, rbtree, btree):
+ *   - ds_pool_alloc/ds_pool_free are O(1) and never touch the system
+ *     allocator except when a new slab is needed.
+ *   - Consecutive allocations are adjacent in memory.
+ *   - ds_pool_reset/ds_pool_destroy release every block at once,
+ *     without visiting them one by one.
+ *
+ * A pool is not thread-safe.
+ */
+typedef struct ds_pool ds_pool_t;
+
+/**
+ * @brief Create a new pool.
+ *
+ * @param block_size  Size in bytes of each block. It is rounded up so that
+ *                    every block is suitably aligned for any type.
+ * @param slab_hint   Number of blocks per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new pool on success, or NULL on failure
+ *         (including block_size == 0, or a block or slab too large for
+ *         size_t).
+ */
+ds_pool_t *ds_pool_create(size_t block_size, size_t slab_hint);
+
+/**
+ * @brief Create a new pool whose slabs come from a custom allocator.
+ *
+ * @param block_size  Size in bytes of each block.
+ * @param slab_hint   Number of blocks per slab. If zero, a default is used.
+ * @param allocator   Allocator for the slabs and the pool itself. It is
+ *                    copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new pool on success, or NULL on failure.
+ */
+ds_pool_t *ds_pool_create_ex(size_t block_size, size_t slab_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a pool and release all of its slabs.
+ *
+ * Every block handed out by the pool becomes invalid.
+ */
+void ds_pool_destroy(ds_pool_t *pool);
+
+/**
+ * @brief Allocate one block.
+ *
+ * @return Pointer to an uninitialized block, or NULL on failure.
+ */
+void *ds_pool_alloc(ds_pool_t *pool);
+
+/**
+ * @brief Return one block to the pool.
+ *
+ * @param pool   Pointer to the pool.
+ * @param block  Block obtained from ds_pool_alloc() on this pool, or NULL.
+ */
+void ds_pool_free(ds_pool_t *pool, void *block);
+
+/**
+ * @brief Mark every block as free while keeping the slabs for reuse.
+ *
+ * Every block handed out by the pool becomes invalid.
+ */
+void ds_pool_reset(ds_pool_t *pool);
+
+/**
+ * @brief Get the (rounded) size of a block.
+ */
+size_t ds_pool_block_size(const ds_pool_t *pool);
+
+/**
+ * @brief Get the number of blocks currently handed out.
+ */
+size_t ds_pool_in_use(const ds_pool_t *pool);
+
+/**
+ * @brief Get the number of slabs currently owned by the pool.
+ */
+size_t ds_pool_slab_count(const ds_pool_t *pool);
+
+#endif // !DS_POOL_H
@@ -2,6 +2,7 @@
 #define QUEUE_H
 
 #include "ds_common.h"
+#include "ds_stats.h"
 #include <stddef.h>
 
 /**
@@ -22,6 +23,18 @@ typedef struct ds_queue ds_queue_t;
  */
 ds_queue_t *ds_queue_create(size_t capacity_hint);
 
+/**
+ * @brief Create a new dynamic queue using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the queue and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new queue on success, or NULL on failure.
+ */
+ds_queue_t *ds_queue_create_ex(size_t capacity_hint, const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a queue and optionally free its elements.
  *
@@ -37,6 +50,17 @@ void ds_queue_destroy(ds_queue_t *queue, ds_free_f free_func);
  */
 size_t ds_queue_size(const ds_queue_t *queue);
 
+/**
+ * @brief Get the instrumentation counters of the underlying deque
+ *        (see ds_stats.h).
+ *
+ * @return
+ *   - DS_OK               On success.
+ *   - DS_ERR_NULL         If queue or out is NULL.
+ *   - DS_ERR_UNSUPPORTED  If built without DS_ENABLE_STATS.
+ */
+ds_status_t ds_queue_stats(const ds_queue_t *queue, ds_stats_t *out);
+
 /**
  * @brief Get the currently allocated capacity.
  */
@@ -94,4 +118,30 @@ void *ds_queue_front(ds_queue_t *queue);
  */
 void ds_queue_clear(ds_queue_t *queue, ds_free_f free_func);
 
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param queue  Pointer to the queue.
+ *
+ * @return
+ *   - DS_OK on success (an empty queue keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the queue is unchanged.
+ */
+ds_status_t ds_queue_shrink_to_fit(ds_queue_t *queue);
+
+/**
+ * @brief Set the growth policy of the queue.
+ *
+ * The policy decides how much the queue grows when full and whether it
+ * shrinks automatically after pop/clear (see ds_growth_policy_t).
+ *
+ * @param queue   Pointer to the queue.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_queue_set_growth_policy(ds_queue_t *queue, const ds_growth_policy_t *policy);
+
 #endif // !QUEUE_H
@@ -0,0 +1,46 @@
+/*
+** include/ds_queue_inline.h -- Layout of ds_queue_t and unchecked inline
+**                              accessors for hot loops.
+*/
+
+#ifndef DS_QUEUE_INLINE_H
+#define DS_QUEUE_INLINE_H
+
+#include "ds_common.h"
+#include "ds_deque_inline.h"
+#include "ds_queue.h"
+#include <stddef.h>
+
+/*
+ * A queue is a deque pushed at the back and popped at the front,
+ * embedded by value so there is no second pointer to follow. The
+ * *_unsafe / *_fast conventions are those of ds_deque_inline.h.
+ */
+
+struct ds_queue {
+  ds_deque_t deque;
+};
+
+/**
+ * @brief ds_queue_push() with the no-growth case inlined. `element`
+ *        must not be NULL.
+ */
+static inline ds_status_t ds_queue_push_fast(ds_queue_t *queue, void *element) {
+  return ds_deque_push_back_fast(&queue->deque, element);
+}
+
+/**
+ * @brief Remove and return the front element (size > 0).
+ */
+static inline void *ds_queue_pop_unsafe(ds_queue_t *queue) {
+  return ds_deque_pop_front_unsafe(&queue->deque);
+}
+
+/**
+ * @brief Front element (size > 0).
+ */
+static inline void *ds_queue_front_unsafe(const ds_queue_t *queue) {
+  return ds_deque_front_unsafe(&queue->deque);
+}
+
+#endif // !DS_QUEUE_INLINE_H
@@ -0,0 +1,201 @@
+#ifndef DS_RBTREE_H
+#define DS_RBTREE_H
+
+#include "ds_common.h"
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Self-balancing ordered map
+ * -------------------------------------------------------------------------
+ *
+ * `ds_rbtree_t` is a drop-in replacement for `ds_bst_t` that keeps its
+ * height bounded by 2 * log2(n + 1), no matter in which order the keys
+ * arrive. Sorted or nearly sorted input (timestamps, monotonically issued
+ * IDs) therefore no longer degrades lookups to a linear scan.
+ *
+ * The API mirrors `ds_bst.h` one to one:
+ *   - Elements are opaque `void *` pointers ordered by a `ds_compare_f`.
+ *   - The "Dummy Key" pattern works the same way for search/remove.
+ *   - Duplicate keys are rejected with DS_ERR_EXIST and the caller keeps
+ *     ownership of the rejected element.
+ *   - Ownership of stored elements is released through `ds_free_f`.
+ *
+ * Guarantees:
+ *   - insert / search / remove / min / max: O(log n) worst case.
+ *   - select / rank:                        O(log n) worst case.
+ *   - traverse_inorder:                     O(n), sorted order.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque Red-Black Tree type.
+ *
+ * The internal structure is hidden from users.
+ * All operations must be performed through the provided API.
+ */
+typedef struct ds_rbtree ds_rbtree_t;
+
+/**
+ * @brief Create a new red-black tree.
+ *
+ * @param compare  Function used to compare elements.
+ * Required to maintain the order of the tree.
+ * - Returns < 0 if a < b
+ * - Returns 0 if a == b
+ * - Returns > 0 if a > b
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create(ds_compare_f compare);
+
+/**
+ * @brief Create a new red-black tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create_ex(ds_compare_f compare, const ds_allocator_t *allocator);
+
+/**
+ * @brief Create a new red-black tree whose nodes come from a node pool.
+ *
+ * Nodes are carved out of contiguous slabs (see ds_pool.h) instead of one
+ * malloc per element. ds_rbtree_destroy() releases all nodes at once; the
+ * tree is only walked when a free_func is given.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create_pooled(ds_compare_f compare, size_t slab_hint);
+
+/**
+ * @brief Create a pooled red-black tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the tree and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create_pooled_ex(ds_compare_f compare, size_t slab_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a red-black tree and optionally free its elements.
+ *
+ * @param tree       Pointer to the red-black tree.
+ * @param free_func  Optional element destructor.
+ *                   - If non-NULL, it is called for each stored element.
+ *                   - If NULL, only the red-black tree itself is freed.
+ */
+void ds_rbtree_destroy(ds_rbtree_t *tree, ds_free_f free_func);
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_rbtree_size(const ds_rbtree_t *tree);
+
+/**
+ * @brief Get the height of the tree (0 for an empty tree).
+ *
+ * Mainly useful for diagnostics: the height never exceeds
+ * 2 * log2(size + 1).
+ */
+size_t ds_rbtree_height(const ds_rbtree_t *tree);
+
+/**
+ * @brief Insert a new element into the tree.
+ *
+ * @param tree  Pointer to the red-black tree.
+ * @param data  Pointer to the data to insert.
+ *
+ * @return
+ * - DS_OK:        On success.
+ * - DS_ERR_EXIST: If the data already exists (Duplicate keys are not allowed).
+ * - DS_ERR_MEM:   If memory allocation fails.
+ */
+ds_status_t ds_rbtree_insert(ds_rbtree_t *tree, void *data);
+
+/**
+ * @brief Search for data matching a key.
+ *
+ * @param tree  Pointer to the red-black tree.
+ * @param key   Pointer to a dummy object or key used for comparison.
+ *
+ * @return Pointer to the stored data if found, NULL otherwise.
+ */
+void *ds_rbtree_search(const ds_rbtree_t *tree, const void *key);
+
+/**
+ * @brief Remove the node matching the key.
+ *
+ * @param tree       Pointer to the red-black tree.
+ * @param key        Pointer to the key to identify the node.
+ * @param free_func  Optional destructor.
+ * If found, this is called on the data being removed.
+ *
+ * @return
+ * - DS_OK:            If the node was found and removed.
+ * - DS_ERR_NOT_FOUND: If the key was not found.
+ * - DS_ERR_*:         On invalid arguments.
+ */
+ds_status_t ds_rbtree_remove(ds_rbtree_t *tree, const void *key, ds_free_f free_func);
+
+/**
+ * @brief Get the minimum element (the "left-most" node).
+ *
+ * @param tree  Pointer to the red-black tree.
+ *
+ * @return Pointer to the minimum data, or NULL if tree is empty.
+ */
+void *ds_rbtree_min(const ds_rbtree_t *tree);
+
+/**
+ * @brief Get the maximum element (the "right-most" node).
+ *
+ * @param tree  Pointer to the red-black tree.
+ *
+ * @return Pointer to the maximum data, or NULL if tree is empty.
+ */
+void *ds_rbtree_max(const ds_rbtree_t *tree);
+
+/**
+ * @brief Perform an In-order traversal.
+ *
+ * Elements are visited in strictly increasing order (Sorted).
+ *
+ * @param tree   Pointer to the red-black tree.
+ * @param visit  Callback function to process each element.
+ */
+void ds_rbtree_traverse_inorder(const ds_rbtree_t *tree, ds_visit_f visit);
+
+/**
+ * @brief Get the k-th smallest element (order statistic).
+ *
+ * Every node keeps the size of its subtree, so this takes O(log n).
+ *
+ * @param tree  Pointer to the red-black tree.
+ * @param k     0-based position in sorted order.
+ *
+ * @return The element, or NULL if k >= size.
+ */
+void *ds_rbtree_select(const ds_rbtree_t *tree, size_t k);
+
+/**
+ * @brief Count the elements that are less than key.
+ *
+ * If key is stored, this is its 0-based position, so
+ * ds_rbtree_select(tree, ds_rbtree_rank(tree, key)) returns it. O(log n).
+ *
+ * @param tree  Pointer to the red-black tree.
+ * @param key   Pointer to a dummy object or key used for comparison.
+ *
+ * @return The number of elements less than key.
+ */
+size_t ds_rbtree_rank(const ds_rbtree_t *tree, const void *key);
+
+#endif // !DS_RBTREE_H
@@ -0,0 +1,210 @@
+/*
+** include/ds_ring.h -- Bounded concurrent ring-buffer queues storing opaque
+**                      pointers (void *): a wait-free single-producer /
+**                      single-consumer ring and a lock-free multi-producer /
+**                      multi-consumer ring.
+*/
+
+#ifndef DS_RING_H
+#define DS_RING_H
+
+#include "ds_common.h"
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Concurrent rings
+ * -------------------------------------------------------------------------
+ *
+ * Both rings have the same circular layout as `ds_deque_t`, with three
+ * differences:
+ *   - The capacity is fixed and rounded up to a power of two, so
+ *     `index % capacity` becomes `index & mask`.
+ *   - Head and tail are free-running counters placed on separate cache
+ *     lines, so producers and consumers never false-share.
+ *   - A full ring refuses new elements (DS_ERR_FULL) instead of growing.
+ *
+ * ds_spsc_ring_t: exactly one producer thread and one consumer thread.
+ *   Every operation is wait-free (a bounded number of steps). Each side
+ *   keeps a cached copy of the other side's index and only re-reads the
+ *   shared one when the cached value says full/empty.
+ *
+ * ds_mpmc_ring_t: any number of producers and consumers.
+ *   Each slot carries a sequence number telling whether it is ready to be
+ *   written or read for a given lap. Producers and consumers claim a
+ *   position with one CAS, so the ring is lock-free (some thread always
+ *   makes progress).
+ *
+ * As everywhere in the library, NULL elements are rejected: try_pop
+ * returns NULL to mean "empty".
+ *
+ * create/destroy are not thread-safe. size() is a snapshot and may be
+ * stale by the time it returns.
+ * -------------------------------------------------------------------------
+ */
+
+/* ========================================================================== */
+/*                     Single-producer / single-consumer                      */
+/* ========================================================================== */
+
+/**
+ * @brief Opaque SPSC ring type.
+ */
+typedef struct ds_spsc_ring ds_spsc_ring_t;
+
+/**
+ * @brief Create a new SPSC ring.
+ *
+ * @param capacity_hint  Minimum capacity, rounded up to a power of two
+ *                       (at least 2). If zero, a default is used.
+ *
+ * @return Pointer to a new ring on success, or NULL on failure.
+ */
+ds_spsc_ring_t *ds_spsc_ring_create(size_t capacity_hint);
+
+/**
+ * @brief Create a new SPSC ring using a custom allocator.
+ *
+ * @param capacity_hint  Minimum capacity, rounded up to a power of two.
+ * @param allocator      Allocator for the ring. It is copied. If NULL,
+ *                       the default allocator is used.
+ *
+ * @return Pointer to a new ring on success, or NULL on failure.
+ */
+ds_spsc_ring_t *ds_spsc_ring_create_ex(size_t capacity_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a ring and optionally free the elements still queued.
+ *
+ * No other thread may be using the ring.
+ */
+void ds_spsc_ring_destroy(ds_spsc_ring_t *ring, ds_free_f free_func);
+
+/**
+ * @brief Get the (power of two) capacity.
+ */
+size_t ds_spsc_ring_capacity(const ds_spsc_ring_t *ring);
+
+/**
+ * @brief Get a snapshot of the number of queued elements.
+ */
+size_t ds_spsc_ring_size(const ds_spsc_ring_t *ring);
+
+/**
+ * @brief Enqueue one element (producer thread only).
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_FULL   If the ring is full.
+ *   - DS_ERR_*      On invalid arguments.
+ */
+ds_status_t ds_spsc_ring_try_push(ds_spsc_ring_t *ring, void *element);
+
+/**
+ * @brief Dequeue one element (consumer thread only).
+ *
+ * @return The oldest element, or NULL if the ring is empty.
+ */
+void *ds_spsc_ring_try_pop(ds_spsc_ring_t *ring);
+
+/**
+ * @brief Enqueue up to `count` elements at once (producer thread only).
+ *
+ * The elements are published together with a single release store.
+ * None of them may be NULL.
+ *
+ * @return Number of elements enqueued (0 if the ring is full or on
+ *         invalid arguments).
+ */
+size_t ds_spsc_ring_try_push_batch(ds_spsc_ring_t *ring, void *const *elements, size_t count);
+
+/**
+ * @brief Dequeue up to `max` elements at once (consumer thread only).
+ *
+ * @return Number of elements written to `out`.
+ */
+size_t ds_spsc_ring_try_pop_batch(ds_spsc_ring_t *ring, void **out, size_t max);
+
+/* ========================================================================== */
+/*                      Multi-producer / multi-consumer                       */
+/* ========================================================================== */
+
+/**
+ * @brief Opaque MPMC ring type.
+ */
+typedef struct ds_mpmc_ring ds_mpmc_ring_t;
+
+/**
+ * @brief Create a new MPMC ring.
+ *
+ * @param capacity_hint  Minimum capacity, rounded up to a power of two
+ *                       (at least 2). If zero, a default is used.
+ *
+ * @return Pointer to a new ring on success, or NULL on failure.
+ */
+ds_mpmc_ring_t *ds_mpmc_ring_create(size_t capacity_hint);
+
+/**
+ * @brief Create a new MPMC ring using a custom allocator.
+ *
+ * @param capacity_hint  Minimum capacity, rounded up to a power of two.
+ * @param allocator      Allocator for the ring. It is copied. If NULL,
+ *                       the default allocator is used.
+ *
+ * @return Pointer to a new ring on success, or NULL on failure.
+ */
+ds_mpmc_ring_t *ds_mpmc_ring_create_ex(size_t capacity_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a ring and optionally free the elements still queued.
+ *
+ * No other thread may be using the ring.
+ */
+void ds_mpmc_ring_destroy(ds_mpmc_ring_t *ring, ds_free_f free_func);
+
+/**
+ * @brief Get the (power of two) capacity.
+ */
+size_t ds_mpmc_ring_capacity(const ds_mpmc_ring_t *ring);
+
+/**
+ * @brief Get a snapshot of the number of queued elements.
+ */
+size_t ds_mpmc_ring_size(const ds_mpmc_ring_t *ring);
+
+/**
+ * @brief Enqueue one element (any thread).
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_FULL   If the ring is full.
+ *   - DS_ERR_*      On invalid arguments.
+ */
+ds_status_t ds_mpmc_ring_try_push(ds_mpmc_ring_t *ring, void *element);
+
+/**
+ * @brief Dequeue one element (any thread).
+ *
+ * @return The oldest element, or NULL if the ring is empty.
+ */
+void *ds_mpmc_ring_try_pop(ds_mpmc_ring_t *ring);
+
+/**
+ * @brief Enqueue up to `count` elements (any thread).
+ *
+ * Positions are claimed in one CAS for the whole run of free slots, so a
+ * batch from one producer lands contiguously. None of the elements may
+ * be NULL.
+ *
+ * @return Number of elements enqueued.
+ */
+size_t ds_mpmc_ring_try_push_batch(ds_mpmc_ring_t *ring, void *const *elements, size_t count);
+
+/**
+ * @brief Dequeue up to `max` elements (any thread).
+ *
+ * Positions are claimed in one CAS for the whole run of ready slots.
+ *
+ * @return Number of elements written to `out`.
+ */
+size_t ds_mpmc_ring_try_pop_batch(ds_mpmc_ring_t *ring, void **out, size_t max);
+
+#endif // !DS_RING_H
@@ -0,0 +1,141 @@
+/*
+** include/ds_simd.h -- Vectorized search and bulk kernels over contiguous
+**                      arrays, with runtime instruction-set dispatch.
+*/
+
+#ifndef DS_SIMD_H
+#define DS_SIMD_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Kernel dispatch
+ * -------------------------------------------------------------------------
+ *
+ *   ds_simd_find_i32(...) --> active kernel table --> avx2 | sse2 | neon | scalar
+ *
+ * Every kernel exists in a scalar version and in vector versions for
+ * SSE2, AVX2 (x86, selected at run time with CPUID) and NEON (AArch64,
+ * where it is always present). The first call picks the widest
+ * instruction set the CPU supports; ds_simd_force_isa() overrides the
+ * choice, mainly for tests and benchmarks. Where an instruction set
+ * lacks an operation (64-bit compares on SSE2), that kernel falls back
+ * to the scalar one.
+ *
+ * The kernels work on plain arrays, so they apply to `ds_vec_t` storage
+ * directly:
+ *
+ *   const int32_t *col = ds_vec_data(vec);
+ *   size_t hits = ds_simd_count_i32(col, ds_vec_size(vec), 42);
+ *
+ * ds_vec_find/count/fill and ds_vector_find/count wrap them for the
+ * element sizes they cover.
+ *
+ * Search results are indices; SIZE_MAX means "not found".
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Instruction sets the kernels are implemented for.
+ */
+typedef enum {
+  DS_SIMD_SCALAR = 0,
+  DS_SIMD_SSE2,
+  DS_SIMD_AVX2,
+  DS_SIMD_NEON,
+} ds_simd_isa_t;
+
+/**
+ * @brief Get the instruction set the kernels currently dispatch to.
+ */
+ds_simd_isa_t ds_simd_active_isa(void);
+
+/**
+ * @brief Check whether this build and CPU can run an instruction set.
+ */
+bool ds_simd_isa_supported(ds_simd_isa_t isa);
+
+/**
+ * @brief Dispatch all later calls to one instruction set.
+ *
+ * Not meant to be called while other threads run kernels.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_ARG    If the instruction set is not supported.
+ */
+ds_status_t ds_simd_force_isa(ds_simd_isa_t isa);
+
+/**
+ * @brief Get a printable name ("scalar", "sse2", "avx2", "neon").
+ */
+const char *ds_simd_isa_name(ds_simd_isa_t isa);
+
+/**
+ * @brief Index of the first element equal to `value`.
+ *
+ * @return The index, or SIZE_MAX if no element matches.
+ */
+size_t ds_simd_find_i32(const int32_t *array, size_t n, int32_t value);
+
+/**
+ * @brief Number of elements equal to `value`.
+ */
+size_t ds_simd_count_i32(const int32_t *array, size_t n, int32_t value);
+
+/**
+ * @brief Smallest and largest element.
+ *
+ * @param array  Elements.
+ * @param n      Number of elements.
+ * @param min    Optional output for the minimum.
+ * @param max    Optional output for the maximum.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_EMPTY  If n == 0 (outputs untouched).
+ *  - DS_ERR_NULL   If array is NULL.
+ */
+ds_status_t ds_simd_minmax_i32(const int32_t *array, size_t n, int32_t *min, int32_t *max);
+
+/**
+ * @brief Set all `n` elements to `value`.
+ */
+void ds_simd_fill_i32(int32_t *array, size_t n, int32_t value);
+
+/**
+ * @brief First index whose element is not less than `value` in an
+ *        ascending array.
+ *
+ * Branch-free binary search down to a small window, then a vector
+ * count of the window's elements below `value`.
+ *
+ * @return An index in [0, n].
+ */
+size_t ds_simd_lower_bound_i32(const int32_t *array, size_t n, int32_t value);
+
+/**
+ * @brief 64-bit variants of the kernels above.
+ */
+size_t ds_simd_find_i64(const int64_t *array, size_t n, int64_t value);
+size_t ds_simd_count_i64(const int64_t *array, size_t n, int64_t value);
+ds_status_t ds_simd_minmax_i64(const int64_t *array, size_t n, int64_t *min, int64_t *max);
+void ds_simd_fill_i64(int64_t *array, size_t n, int64_t value);
+size_t ds_simd_lower_bound_i64(const int64_t *array, size_t n, int64_t value);
+
+/**
+ * @brief Index of the first pointer identical to `value`.
+ *
+ * @return The index, or SIZE_MAX if no pointer matches.
+ */
+size_t ds_simd_find_ptr(void *const *array, size_t n, const void *value);
+
+/**
+ * @brief Number of pointers identical to `value`.
+ */
+size_t ds_simd_count_ptr(void *const *array, size_t n, const void *value);
+
+#endif // !DS_SIMD_H
@@ -0,0 +1,265 @@
+/*
+** include/ds_snapshot.h -- On-disk snapshots: flat files that are mapped
+**                          and used in place, and streamed record files
+**                          for pointer containers.
+*/
+
+#ifndef DS_SNAPSHOT_H
+#define DS_SNAPSHOT_H
+
+#include "ds_bst.h"
+#include "ds_common.h"
+#include "ds_heap.h"
+#include "ds_span.h"
+#include "ds_vec.h"
+#include "ds_vector.h"
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Snapshots
+ * -------------------------------------------------------------------------
+ *
+ * Every file starts with the same 64-byte header (magic, version, kind,
+ * element size, count, payload offset and length, byte-order tag). Files
+ * are read back only on a machine with the same byte order.
+ *
+ * Flat snapshots (by-value elements of a ds_vec_t):
+ *
+ *   [ header | pad to 64 | elem 0 | elem 1 | ... ]
+ *
+ *   The payload holds no pointers, so ds_snapshot_map() can mmap the
+ *   file read-only and hand out its elements immediately; pages are
+ *   read in by the kernel as they are touched, nothing is parsed.
+ *
+ *   DS_SNAPSHOT_ARRAY  The elements in vector order.
+ *   DS_SNAPSHOT_TREE   The elements sorted and stored in Eytzinger (BFS)
+ *                      order: slot k's children are 2k+1 and 2k+2. A
+ *                      search follows one path down the implicit tree,
+ *                      and the first few levels share a handful of cache
+ *                      lines, so ds_snapshot_find() on a mapped file
+ *                      needs no index and no warm-up.
+ *
+ * Record snapshots (pointer containers: ds_vector, ds_heap, ds_bst):
+ *
+ *   [ header | len | bytes | len | bytes | ... ]
+ *
+ *   Each element is turned into bytes by a user ds_snapshot_encode_f
+ *   and back into an element by a ds_snapshot_decode_f. Heaps are
+ *   written in storage order and trees in ascending order, so loading
+ *   rebuilds them in O(n) (ds_heap_create_from(),
+ *   ds_bst_create_from_sorted()) rather than by n pushes or inserts.
+ *
+ * Files are written in place; write to a temporary path and rename()
+ * it when a crash must not leave a torn snapshot behind.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief What a snapshot file contains.
+ */
+typedef enum {
+  DS_SNAPSHOT_ARRAY = 1,    // Flat by-value elements, vector order
+  DS_SNAPSHOT_TREE = 2,     // Flat by-value elements, Eytzinger order
+  DS_SNAPSHOT_RECORDS = 3,  // Length-prefixed encoded elements
+} ds_snapshot_kind_t;
+
+/* ===================== Flat snapshots ===================== */
+
+/**
+ * @brief Opaque read-only mapping of a flat snapshot.
+ */
+typedef struct ds_snapshot ds_snapshot_t;
+
+/**
+ * @brief Write the elements of a by-value vector as a DS_SNAPSHOT_ARRAY.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_NULL   If path or vec is NULL.
+ *  - DS_ERR_IO     If the file could not be written.
+ */
+ds_status_t ds_snapshot_save_vec(const char *path, const ds_vec_t *vec);
+
+/**
+ * @brief Write the elements of a by-value vector as a DS_SNAPSHOT_TREE.
+ *
+ * The vector itself is left untouched; its elements are sorted through a
+ * temporary array of pointers.
+ *
+ * @param path     Output file.
+ * @param vec      Elements, in any order. Keys should be unique; with
+ *                 duplicates ds_snapshot_find() returns one of them.
+ * @param compare  Compares two element pointers.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_NULL   If an argument is NULL.
+ *  - DS_ERR_MEM    If the temporary array could not be allocated.
+ *  - DS_ERR_IO     If the file could not be written.
+ */
+ds_status_t ds_snapshot_save_tree(const char *path, const ds_vec_t *vec, ds_compare_f compare);
+
+/**
+ * @brief Map a flat snapshot read-only.
+ *
+ * The header and sizes are checked against the file; element bytes are
+ * not read until they are used.
+ *
+ * @return The mapping, or NULL if the file cannot be opened or is not a
+ *         flat snapshot of this byte order.
+ */
+ds_snapshot_t *ds_snapshot_map(const char *path);
+
+/**
+ * @brief Unmap a snapshot. Spans and pointers obtained from it become
+ *        invalid.
+ */
+void ds_snapshot_unmap(ds_snapshot_t *snap);
+
+/**
+ * @brief Get the kind of a mapped snapshot (0 if snap is NULL).
+ */
+ds_snapshot_kind_t ds_snapshot_kind(const ds_snapshot_t *snap);
+
+/**
+ * @brief Get a span over the mapped elements, in file order.
+ *
+ * The memory is mapped read-only: writing through the span faults.
+ *
+ * @return The span, or an empty span if snap is NULL.
+ */
+ds_span_t ds_snapshot_span(const ds_snapshot_t *snap);
+
+/**
+ * @brief First element not less than `key` in a DS_SNAPSHOT_TREE.
+ *
+ * @param snap     The mapping.
+ * @param key      Pointer to a key, passed as the second argument of
+ *                 `compare`.
+ * @param compare  The function the snapshot was saved with.
+ *
+ * @return Pointer into the mapping, or NULL if every element is less
+ *         than key or the snapshot is not a tree.
+ */
+const void *ds_snapshot_lower_bound(const ds_snapshot_t *snap, const void *key, ds_compare_f compare);
+
+/**
+ * @brief Element equal to `key` in a DS_SNAPSHOT_TREE.
+ *
+ * @return Pointer into the mapping, or NULL if not found.
+ */
+const void *ds_snapshot_find(const ds_snapshot_t *snap, const void *key, ds_compare_f compare);
+
+/**
+ * @brief Copy a mapped snapshot's elements (file order) into a new
+ *        writable by-value vector.
+ *
+ * @param snap       The mapping.
+ * @param allocator  Allocator for the vector. If NULL, the default
+ *                   allocator is used.
+ *
+ * @return The vector, or NULL on failure.
+ */
+ds_vec_t *ds_snapshot_to_vec(const ds_snapshot_t *snap, const ds_allocator_t *allocator);
+
+/* ===================== Record snapshots ===================== */
+
+/**
+ * @brief Output handle given to encode callbacks.
+ */
+typedef struct ds_snapshot_writer ds_snapshot_writer_t;
+
+/**
+ * @brief Append bytes to the record being encoded.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_NULL   If w is NULL, or bytes is NULL with n > 0.
+ *  - DS_ERR_MEM    If the record buffer could not grow.
+ */
+ds_status_t ds_snapshot_write(ds_snapshot_writer_t *w, const void *bytes, size_t n);
+
+/**
+ * @brief Encode one element by calling ds_snapshot_write() any number
+ *        of times. A non-DS_OK return aborts the save.
+ */
+typedef ds_status_t (*ds_snapshot_encode_f)(ds_snapshot_writer_t *w, const void *element, void *ctx);
+
+/**
+ * @brief Rebuild one element from the bytes its encoder wrote.
+ *
+ * @return The new element, or NULL to abort the load.
+ */
+typedef void *(*ds_snapshot_decode_f)(const void *bytes, size_t n, void *ctx);
+
+/**
+ * @brief Save the elements of a pointer vector, in order.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_NULL   If an argument (other than ctx) is NULL.
+ *  - DS_ERR_IO     If the file could not be written.
+ *  - Any status returned by `encode`.
+ */
+ds_status_t ds_snapshot_save_vector(const char *path, const ds_vector_t *vec,
+                                    ds_snapshot_encode_f encode, void *ctx);
+
+/**
+ * @brief Save the elements of a heap in storage order.
+ */
+ds_status_t ds_snapshot_save_heap(const char *path, const ds_heap_t *heap,
+                                  ds_snapshot_encode_f encode, void *ctx);
+
+/**
+ * @brief Save the elements of a tree in ascending order.
+ */
+ds_status_t ds_snapshot_save_bst(const char *path, const ds_bst_t *bst,
+                                 ds_snapshot_encode_f encode, void *ctx);
+
+/**
+ * @brief Load a record snapshot into a new pointer vector.
+ *
+ * @param path       Input file.
+ * @param decode     Element decoder.
+ * @param ctx        Passed to decode.
+ * @param free_func  Frees already decoded elements if the load fails.
+ *                   May be NULL.
+ * @param allocator  Allocator for the vector. If NULL, the default
+ *                   allocator is used.
+ * @param out        Receives the vector on success.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_NULL   If path, decode or out is NULL.
+ *  - DS_ERR_IO     If the file is missing, truncated or malformed.
+ *  - DS_ERR_ARG    If decode returned NULL.
+ *  - DS_ERR_MEM    On allocation failure.
+ */
+ds_status_t ds_snapshot_load_vector(const char *path, ds_snapshot_decode_f decode, void *ctx,
+                                    ds_free_f free_func, const ds_allocator_t *allocator,
+                                    ds_vector_t **out);
+
+/**
+ * @brief Load a record snapshot into a new heap.
+ *
+ * Same as ds_snapshot_load_vector(), plus the heap's compare function.
+ * Any record file works; one saved from a heap needs no element moves.
+ */
+ds_status_t ds_snapshot_load_heap(const char *path, ds_compare_f compare,
+                                  ds_snapshot_decode_f decode, void *ctx,
+                                  ds_free_f free_func, const ds_allocator_t *allocator,
+                                  ds_heap_t **out);
+
+/**
+ * @brief Load a record snapshot into a new balanced tree.
+ *
+ * Same as ds_snapshot_load_vector(), plus the tree's compare function.
+ * The records must be strictly ascending (as ds_snapshot_save_bst()
+ * writes them); otherwise DS_ERR_ARG is returned.
+ */
+ds_status_t ds_snapshot_load_bst(const char *path, ds_compare_f compare,
+                                 ds_snapshot_decode_f decode, void *ctx,
+                                 ds_free_f free_func, const ds_allocator_t *allocator,
+                                 ds_bst_t **out);
+
+#endif // !DS_SNAPSHOT_H
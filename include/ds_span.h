@@ -0,0 +1,81 @@
+/*
+** include/ds_span.h -- A non-owning view of contiguous container storage.
+*/
+
+#ifndef DS_SPAN_H
+#define DS_SPAN_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Spans
+ * -------------------------------------------------------------------------
+ *
+ *   ds_vector_as_span(v)      -> [ p0 | p1 | ... | pn-1 ]          1 span
+ *   ds_deque_as_spans(d, s)   -> [ head .. end ) [ 0 .. tail )     <= 2 spans
+ *   ds_vec_as_span(v)         -> [ e0 | e1 | ... | en-1 ]          1 span
+ *
+ * A span is a pointer, an element count and an element size, passed by
+ * value. It points straight into the container's storage: nothing is
+ * copied, so it can go to memcpy(), writev() (as data / ds_span_bytes())
+ * or a SIMD kernel as is. Writing through it changes the container.
+ *
+ * A span does not own its memory and is not tracked by the container.
+ * It is invalidated by any operation that may reallocate or move the
+ * storage (push, insert, reserve, shrink, automatic shrinking after a
+ * removal, destroy). The helpers below do the bounds checks; the fields
+ * may also be read directly.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief View of `size` contiguous elements of `elem_size` bytes each.
+ */
+typedef struct {
+  void *data;         // First element (NULL for an empty span)
+  size_t size;        // Number of elements
+  size_t elem_size;   // Bytes per element
+} ds_span_t;
+
+/**
+ * @brief Build a span over existing memory.
+ */
+static inline ds_span_t ds_span_make(void *data, size_t size, size_t elem_size) {
+  ds_span_t span = { size ? data : NULL, data ? size : 0, elem_size };
+  return span;
+}
+
+/**
+ * @brief Check if a span has no elements.
+ */
+static inline bool ds_span_is_empty(ds_span_t span) {
+  return span.size == 0;
+}
+
+/**
+ * @brief Length of the span in bytes.
+ */
+static inline size_t ds_span_bytes(ds_span_t span) {
+  return span.size * span.elem_size;
+}
+
+/**
+ * @brief Pointer to the element at `index`, or NULL if out of range.
+ */
+static inline void *ds_span_at(ds_span_t span, size_t index) {
+  if (index >= span.size) return NULL;
+  return (char *)span.data + index * span.elem_size;
+}
+
+/**
+ * @brief The elements [offset, offset + count), clamped to the span.
+ */
+static inline ds_span_t ds_span_subspan(ds_span_t span, size_t offset, size_t count) {
+  if (offset >= span.size) return ds_span_make(NULL, 0, span.elem_size);
+  if (count > span.size - offset) count = span.size - offset;
+  return ds_span_make((char *)span.data + offset * span.elem_size, count, span.elem_size);
+}
+
+#endif // !DS_SPAN_H
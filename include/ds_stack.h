@@ -2,6 +2,7 @@
 #define STACK_H
 
 #include "ds_common.h"
+#include "ds_stats.h"
 #include <stddef.h>
 
 /**
@@ -22,6 +23,18 @@ typedef struct ds_stack ds_stack_t;
  */
 ds_stack_t *ds_stack_create(size_t capacity_hint);
 
+/**
+ * @brief Create a new dynamic stack using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the stack and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new stack on success, or NULL on failure.
+ */
+ds_stack_t *ds_stack_create_ex(size_t capacity_hint, const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a stack and optionally free its elements.
  *
@@ -37,6 +50,17 @@ void ds_stack_destroy(ds_stack_t *stack, ds_free_f free_func);
  */
 size_t ds_stack_size(const ds_stack_t *stack);
 
+/**
+ * @brief Get the instrumentation counters of the underlying deque
+ *        (see ds_stats.h).
+ *
+ * @return
+ *   - DS_OK               On success.
+ *   - DS_ERR_NULL         If stack or out is NULL.
+ *   - DS_ERR_UNSUPPORTED  If built without DS_ENABLE_STATS.
+ */
+ds_status_t ds_stack_stats(const ds_stack_t *stack, ds_stats_t *out);
+
 /**
  * @brief Get the currently allocated capacity.
  */
@@ -94,4 +118,30 @@ void *ds_stack_top(ds_stack_t *stack);
  */
 void ds_stack_clear(ds_stack_t *stack, ds_free_f free_func);
 
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param stack  Pointer to the stack.
+ *
+ * @return
+ *   - DS_OK on success (an empty stack keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the stack is unchanged.
+ */
+ds_status_t ds_stack_shrink_to_fit(ds_stack_t *stack);
+
+/**
+ * @brief Set the growth policy of the stack.
+ *
+ * The policy decides how much the stack grows when full and whether it
+ * shrinks automatically after pop/clear (see ds_growth_policy_t).
+ *
+ * @param stack   Pointer to the stack.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_stack_set_growth_policy(ds_stack_t *stack, const ds_growth_policy_t *policy);
+
 #endif // !STACK_H
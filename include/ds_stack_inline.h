@@ -0,0 +1,46 @@
+/*
+** include/ds_stack_inline.h -- Layout of ds_stack_t and unchecked inline
+**                              accessors for hot loops.
+*/
+
+#ifndef DS_STACK_INLINE_H
+#define DS_STACK_INLINE_H
+
+#include "ds_common.h"
+#include "ds_deque_inline.h"
+#include "ds_stack.h"
+#include <stddef.h>
+
+/*
+ * A stack is a deque used from the back, embedded by value so there is
+ * no second pointer to follow. The *_unsafe / *_fast conventions are
+ * those of ds_deque_inline.h.
+ */
+
+struct ds_stack {
+  ds_deque_t deque;
+};
+
+/**
+ * @brief ds_stack_push() with the no-growth case inlined. `element`
+ *        must not be NULL.
+ */
+static inline ds_status_t ds_stack_push_fast(ds_stack_t *stack, void *element) {
+  return ds_deque_push_back_fast(&stack->deque, element);
+}
+
+/**
+ * @brief Remove and return the top element (size > 0).
+ */
+static inline void *ds_stack_pop_unsafe(ds_stack_t *stack) {
+  return ds_deque_pop_back_unsafe(&stack->deque);
+}
+
+/**
+ * @brief Top element (size > 0).
+ */
+static inline void *ds_stack_top_unsafe(const ds_stack_t *stack) {
+  return ds_deque_back_unsafe(&stack->deque);
+}
+
+#endif // !DS_STACK_INLINE_H
@@ -0,0 +1,198 @@
+/*
+** include/ds_stats.h -- Optional per-container instrumentation: counters,
+**                       resize latency histograms and a global registry.
+*/
+
+#ifndef DS_STATS_H
+#define DS_STATS_H
+
+#include "ds_common.h"
+#include "ds_ilist.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Instrumentation
+ * -------------------------------------------------------------------------
+ *
+ * Compile-time gated. Without DS_ENABLE_STATS (the default) every hook
+ * below expands to nothing, containers carry no extra field, and the
+ * ds_*_stats() getters return DS_ERR_UNSUPPORTED. Build with
+ * `make STATS=1` (or -DDS_ENABLE_STATS) to turn it on. The macro must be
+ * set the same way for the library and for any code that includes a
+ * *_inline.h header, since it changes the container layouts.
+ *
+ * When enabled, each instrumented container (ds_vector, ds_deque and the
+ * stack/queue built on it, ds_heap, ds_bst, ds_hashmap) embeds a
+ * ds_stats_node_t:
+ *
+ *   container->alloc  --->  stats node  --->  allocator given at creation
+ *                          (counts calls)
+ *
+ *   - Memory counters come from wrapping the container's allocator, so
+ *     every block it allocates, resizes or frees is seen, including
+ *     scratch memory and helper containers created with it.
+ *   - Resizes (regrowth, shrink, rehash) are timed with a monotonic
+ *     clock into a log2 histogram of nanoseconds.
+ *   - Comparisons, search depth and probe lengths are counted where the
+ *     container performs them.
+ *
+ * Every node is linked into one global registry while its container
+ * lives; ds_stats_foreach() / ds_stats_dump() walk it under a mutex,
+ * e.g. from a periodic reporting thread. Allocator counters are updated
+ * with relaxed atomics (parallel operations allocate from worker
+ * threads); the others are plain integers owned by whichever thread
+ * owns the container, so a snapshot taken while the container is busy
+ * is only approximate.
+ * -------------------------------------------------------------------------
+ */
+
+#define DS_STATS_HIST_BUCKETS 32
+
+/**
+ * @brief Latency histogram. buckets[b] counts samples in [2^b, 2^(b+1))
+ *        nanoseconds; the last bucket also takes everything above.
+ */
+typedef struct {
+  uint64_t count;
+  uint64_t total_ns;
+  uint64_t max_ns;
+  uint64_t buckets[DS_STATS_HIST_BUCKETS];
+} ds_stats_hist_t;
+
+/**
+ * @brief Counters of one container.
+ */
+typedef struct {
+  // Allocator traffic
+  uint64_t allocs;          // alloc calls
+  uint64_t reallocs;        // realloc calls
+  uint64_t frees;           // free calls
+  uint64_t bytes_live;      // Currently allocated
+  uint64_t bytes_peak;      // High-water mark of bytes_live
+  uint64_t bytes_total;     // Sum of all allocation sizes
+
+  // Storage resizes: vector/deque/heap regrowth and shrink, hashmap rehash
+  uint64_t resizes;
+  ds_stats_hist_t resize_latency;
+
+  // Work done by the algorithms
+  uint64_t comparisons;     // ds_compare_f / ds_equal_f calls
+  uint64_t searches;        // Lookups and insert descents (bst, hashmap)
+  uint64_t max_depth;       // Deepest node reached by one bst descent
+  uint64_t probes;          // Groups probed over all hashmap lookups
+  uint64_t max_probe;       // Longest probe sequence of one lookup
+} ds_stats_t;
+
+/**
+ * @brief Check whether this build was compiled with DS_ENABLE_STATS.
+ */
+bool ds_stats_enabled(void);
+
+/**
+ * @brief Callback for ds_stats_foreach().
+ *
+ * @param kind   Container type name, e.g. "ds_vector".
+ * @param owner  The container.
+ * @param stats  Its counters. Valid only during the call.
+ * @param ctx    User context.
+ */
+typedef void (*ds_stats_visit_f)(const char *kind, const void *owner, const ds_stats_t *stats, void *ctx);
+
+/**
+ * @brief Visit every live instrumented container.
+ *
+ * The registry lock is held during the walk, so `visit` must not create
+ * or destroy containers. Does nothing when stats are disabled.
+ *
+ * @return The number of containers visited.
+ */
+size_t ds_stats_foreach(ds_stats_visit_f visit, void *ctx);
+
+/**
+ * @brief Print one line per live instrumented container.
+ *
+ * @param out  Output stream. If NULL, stderr is used.
+ *
+ * @return The number of containers printed.
+ */
+size_t ds_stats_dump(FILE *out);
+
+/**
+ * @brief Upper bound (in ns) of the bucket holding the q-quantile.
+ *
+ * @param hist  Histogram.
+ * @param q     Quantile in [0, 1], e.g. 0.99.
+ *
+ * @return The bound, or 0 for an empty histogram.
+ */
+uint64_t ds_stats_hist_quantile(const ds_stats_hist_t *hist, double q);
+
+/* -------------------------------------------------------------------------
+ * Hooks used by the container implementations
+ * ------------------------------------------------------------------------- */
+
+#ifdef DS_ENABLE_STATS
+
+/**
+ * @brief Stats block embedded in an instrumented container.
+ */
+typedef struct {
+  ds_ilist_link_t link;     // Registry membership
+  const char *kind;
+  const void *owner;
+  ds_allocator_t inner;     // Allocator the container was created with
+  ds_stats_t stats;
+} ds_stats_node_t;
+
+/**
+ * @brief Register a node and route `*alloc` through it.
+ */
+void ds_stats_attach(ds_stats_node_t *node, const char *kind, const void *owner, ds_allocator_t *alloc);
+
+/**
+ * @brief Unregister a node and restore `*alloc` to the original allocator.
+ */
+void ds_stats_detach(ds_stats_node_t *node, ds_allocator_t *alloc);
+
+/**
+ * @brief Monotonic clock in nanoseconds.
+ */
+uint64_t ds_stats_now_ns(void);
+
+/**
+ * @brief Count one resize that started at `start_ns`.
+ */
+void ds_stats_record_resize(ds_stats_node_t *node, uint64_t start_ns);
+
+#define DS_STATS_FIELD                          ds_stats_node_t stats_node;
+#define DS_STATS_ATTACH(obj, kind, alloc)       ds_stats_attach(&(obj)->stats_node, (kind), (obj), (alloc))
+#define DS_STATS_DETACH(obj, alloc)             ds_stats_detach(&(obj)->stats_node, (alloc))
+#define DS_STATS_ADD(obj, field, n)             ((obj)->stats_node.stats.field += (n))
+#define DS_STATS_MAX(obj, field, v)                                            \
+  do {                                                                         \
+    uint64_t ds_stats_v_ = (v);                                                \
+    if (ds_stats_v_ > (obj)->stats_node.stats.field)                           \
+      (obj)->stats_node.stats.field = ds_stats_v_;                             \
+  } while (0)
+#define DS_STATS_TIMER(var)                     uint64_t var = ds_stats_now_ns()
+#define DS_STATS_RESIZE_DONE(obj, var)          ds_stats_record_resize(&(obj)->stats_node, (var))
+#define DS_STATS_COPY(obj, out)                 (*(out) = (obj)->stats_node.stats, DS_OK)
+#define DS_STATS_ONLY(...)                      __VA_ARGS__
+
+#else
+
+#define DS_STATS_FIELD
+#define DS_STATS_ATTACH(obj, kind, alloc)       ((void)0)
+#define DS_STATS_DETACH(obj, alloc)             ((void)0)
+#define DS_STATS_ADD(obj, field, n)             ((void)0)
+#define DS_STATS_MAX(obj, field, v)             ((void)0)
+#define DS_STATS_TIMER(var)                     ((void)0)
+#define DS_STATS_RESIZE_DONE(obj, var)          ((void)0)
+#define DS_STATS_COPY(obj, out)                 ((void)(obj), (void)(out), DS_ERR_UNSUPPORTED)
+#define DS_STATS_ONLY(...)
+
+#endif
+
+#endif // !DS_STATS_H
@@ -0,0 +1,97 @@
+/*
+** include/ds_threadpool.h -- A fixed-size thread pool that schedules tasks
+**                            over per-worker work-stealing deques.
+*/
+
+#ifndef DS_THREADPOOL_H
+#define DS_THREADPOOL_H
+
+#include "ds_common.h"
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Thread pool
+ * -------------------------------------------------------------------------
+ *
+ *   submit() from outside  ->  injection queue (ds_queue_t + mutex)
+ *   submit() from a task   ->  the running worker's own ds_wsdeque_t
+ *
+ * Each worker looks for its next task in this order:
+ *   1. pop() from its own deque (newest first, cache-warm, no contention)
+ *   2. the shared injection queue
+ *   3. steal() from the other workers' deques (oldest first)
+ * and sleeps on a condition variable when all three are empty.
+ *
+ * Recursive jobs (e.g. one task per subtree) should therefore submit
+ * their children from inside the task: the children stay on the local
+ * deque and idle workers steal the big, old ones.
+ *
+ * Each task is allocated with the pool's allocator from whichever thread
+ * submits it, so a custom allocator must be thread-safe.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque thread pool type.
+ */
+typedef struct ds_threadpool ds_threadpool_t;
+
+/**
+ * @brief Task function run by a worker thread.
+ */
+typedef void (*ds_task_f)(void *arg);
+
+/**
+ * @brief Create a thread pool and start its workers.
+ *
+ * @param num_threads  Number of worker threads. If zero, one per online
+ *                     CPU is started.
+ *
+ * @return Pointer to a new pool on success, or NULL on failure.
+ */
+ds_threadpool_t *ds_threadpool_create(size_t num_threads);
+
+/**
+ * @brief Create a thread pool using a custom (thread-safe) allocator.
+ *
+ * @param num_threads  Number of worker threads. If zero, one per online
+ *                     CPU is started.
+ * @param allocator    Allocator for the pool and its tasks. It is copied.
+ *                     If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new pool on success, or NULL on failure.
+ */
+ds_threadpool_t *ds_threadpool_create_ex(size_t num_threads, const ds_allocator_t *allocator);
+
+/**
+ * @brief Run all pending tasks, stop the workers and free the pool.
+ *
+ * Must not be called from a task.
+ */
+void ds_threadpool_destroy(ds_threadpool_t *pool);
+
+/**
+ * @brief Get the number of worker threads.
+ */
+size_t ds_threadpool_size(const ds_threadpool_t *pool);
+
+/**
+ * @brief Schedule `func(arg)` to run on a worker thread.
+ *
+ * May be called from any thread, including from inside a task.
+ *
+ * @return
+ *   - DS_OK       On success.
+ *   - DS_ERR_MEM  If the task could not be allocated or queued.
+ *   - DS_ERR_*    On invalid arguments.
+ */
+ds_status_t ds_threadpool_submit(ds_threadpool_t *pool, ds_task_f func, void *arg);
+
+/**
+ * @brief Block until every submitted task, including tasks submitted by
+ *        other tasks, has finished.
+ *
+ * Must not be called from a task.
+ */
+void ds_threadpool_wait(ds_threadpool_t *pool);
+
+#endif // !DS_THREADPOOL_H
@@ -0,0 +1,229 @@
+/*
+** include/ds_ulist.h -- Unrolled doubly linked list. Each node holds a
+**                       small array of elements, so memory overhead and
+**                       pointer chasing are paid per block, not per item.
+*/
+
+#ifndef DS_ULIST_H
+#define DS_ULIST_H
+
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Unrolled list
+ * -------------------------------------------------------------------------
+ *
+ *   NULL <- [prev|next|count| e0 e1 e2 .. e31 ] <-> [ ... ] -> NULL
+ *
+ * Same element model and iterator style as `ds_list_t`, with up to
+ * `node_capacity` elements per node (default 32):
+ *   - Memory: ~8 bytes per element plus one node header per block,
+ *     instead of a 24-byte node and one allocation per element.
+ *   - Iteration: next/prev mostly step within one array.
+ *
+ * push_back fills the tail node before starting a new one. Insert splits
+ * a full node into two halves, and remove folds a node's successor into
+ * it once both fit, which keeps most nodes at least half full.
+ *
+ * Iterator stability (differs from ds_list_t!):
+ *   - Iterators are (node, index) pairs and are passed by value.
+ *   - insert and remove may shift elements inside the affected node, split
+ *     it or merge it with its successor. Every iterator into that node or
+ *     its successor is invalidated; iterators into other nodes stay valid.
+ *   - push/pop at either end only affect the first/last node.
+ *   - set never invalidates iterators.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque unrolled list node type.
+ */
+typedef struct ds_ulist_node ds_ulist_node_t;
+
+/**
+ * @brief Opaque unrolled list type.
+ */
+typedef struct ds_ulist ds_ulist_t;
+
+/**
+ * @brief Unrolled list iterator.
+ *
+ * Passed by value. The End iterator is { NULL, 0 }.
+ */
+typedef struct {
+  ds_ulist_node_t *node;
+  size_t index;
+} ds_ulist_iter_t;
+
+/**
+ * @brief Create a new unrolled list.
+ *
+ * @param node_capacity  Elements per node. If zero, a default is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_ulist_t *ds_ulist_create(size_t node_capacity);
+
+/**
+ * @brief Create a new unrolled list using a custom allocator.
+ *
+ * @param node_capacity  Elements per node. If zero, a default is used.
+ * @param allocator      Allocator for the list and its nodes. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_ulist_t *ds_ulist_create_ex(size_t node_capacity, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a list and optionally free its elements.
+ *
+ * @param list       Pointer to the list.
+ * @param free_func  Optional element destructor.
+ */
+void ds_ulist_destroy(ds_ulist_t *list, ds_free_f free_func);
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_ulist_size(const ds_ulist_t *list);
+
+/**
+ * @brief Check if the list is empty.
+ */
+bool ds_ulist_is_empty(const ds_ulist_t *list);
+
+/**
+ * @brief Replace the element at the specified iterator.
+ *
+ * @param list              Pointer to the list.
+ * @param it                Element iterator.
+ * @param element           Pointer to the new element.
+ * @param old_element_free  Optional destructor for the old element.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_ulist_set(ds_ulist_t *list, ds_ulist_iter_t it, void *element, ds_free_f old_element_free);
+
+/**
+ * @brief Append an element to the end of the list.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_ulist_push_back(ds_ulist_t *list, void *element);
+
+/**
+ * @brief Prepend an element to the front of the list.
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_ulist_push_front(ds_ulist_t *list, void *element);
+
+/**
+ * @brief Insert an element before the specified position.
+ *
+ * @param list     Pointer to the list.
+ * @param it       Iterator to the target position.
+ *                 - If it == ds_ulist_iter_end(list), equivalent to push_back.
+ *                 - Otherwise, insert before the element pointed to by it.
+ * @param element  Pointer to the element to insert.
+ *
+ * Invalidates iterators into the node of `it` (see the stability rules above).
+ *
+ * @return
+ *  - DS_OK         On success.
+ *  - DS_ERR_*      On failure.
+ */
+ds_status_t ds_ulist_insert(ds_ulist_t *list, ds_ulist_iter_t it, void *element);
+
+/**
+ * @brief Remove and return the last element.
+ *
+ * @return Pointer to the removed element, or NULL if the list is empty.
+ */
+void *ds_ulist_pop_back(ds_ulist_t *list);
+
+/**
+ * @brief Remove and return the first element.
+ *
+ * @return Pointer to the removed element, or NULL if the list is empty.
+ */
+void *ds_ulist_pop_front(ds_ulist_t *list);
+
+/**
+ * @brief Remove the element at the specified iterator.
+ *
+ * Invalidates iterators into the node of `it` and its successor, except the
+ * returned one.
+ *
+ * @param list       Pointer to the list.
+ * @param it         Element iterator.
+ * @param free_func  Optional element destructor.
+ *
+ * @return The iterator pointing to the element after the removed one,
+ *         or End if the last element was removed.
+ */
+ds_ulist_iter_t ds_ulist_remove(ds_ulist_t *list, ds_ulist_iter_t it, ds_free_f free_func);
+
+/**
+ * @brief Remove all elements from the list.
+ *
+ * @param list       Pointer to the list.
+ * @param free_func  Optional element destructor.
+ */
+void ds_ulist_clear(ds_ulist_t *list, ds_free_f free_func);
+
+/**
+ * @brief Get an iterator pointing to the first element.
+ *
+ * @return Returns End if the list is empty.
+ */
+ds_ulist_iter_t ds_ulist_iter_begin(ds_ulist_t *list);
+
+/**
+ * @brief Get the End iterator.
+ */
+ds_ulist_iter_t ds_ulist_iter_end(ds_ulist_t *list);
+
+/**
+ * @brief Get an iterator pointing to the last element (Tail).
+ *
+ * @return Returns End if the list is empty.
+ */
+ds_ulist_iter_t ds_ulist_iter_tail(ds_ulist_t *list);
+
+/**
+ * @brief Move forward by one position.
+ *
+ * @return The next iterator, or End after the last element.
+ */
+ds_ulist_iter_t ds_ulist_iter_next(ds_ulist_iter_t it);
+
+/**
+ * @brief Move backward by one position.
+ *
+ * @return The previous iterator, or End before the first element.
+ */
+ds_ulist_iter_t ds_ulist_iter_prev(ds_ulist_iter_t it);
+
+/**
+ * @brief Get the data pointed to by the iterator.
+ *
+ * @return The element, or NULL for End.
+ */
+void *ds_ulist_iter_get(ds_ulist_iter_t it);
+
+/**
+ * @brief Determine if two iterators point to the same position.
+ */
+bool ds_ulist_iter_equal(ds_ulist_iter_t a, ds_ulist_iter_t b);
+
+#endif // !DS_ULIST_H
@@ -0,0 +1,297 @@
+/*
+** include/ds_vec.h -- A dynamic array storing elements by value.
+**                     Elements of one fixed size are kept contiguously,
+**                     without a heap allocation or pointer per element.
+*/
+
+#ifndef DS_VEC_H
+#define DS_VEC_H
+
+#include "ds_common.h"
+#include "ds_span.h"
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: By-value vector
+ * -------------------------------------------------------------------------
+ *
+ * `ds_vector_t` stores `void *` pointers, so a vector of ints costs one
+ * allocation per element and one pointer chase per access. `ds_vec_t`
+ * stores the elements themselves:
+ *
+ *   data -> [ elem 0 | elem 1 | elem 2 | ... | (capacity - size) unused ]
+ *
+ * - The element size is fixed at creation time.
+ * - Elements are copied in and out with memcpy. Pointers returned by
+ *   ds_vec_get()/ds_vec_data() stay valid until the next operation that
+ *   may reallocate (push, insert, reserve).
+ * - Destructors (`ds_free_f`) receive a pointer to the element slot, not
+ *   the element value, so elements owning resources can release them.
+ *
+ * The semantics of get/set/push/insert/remove/reserve follow `ds_vector.h`.
+ * DS_VEC_DEFINE() generates typed inline wrappers on top of this API.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque by-value vector type.
+ *
+ * The internal structure is hidden from users.
+ * All operations must be performed through the provided API.
+ */
+typedef struct ds_vec ds_vec_t;
+
+/**
+ * @brief Create a new by-value vector.
+ *
+ * @param elem_size      Size in bytes of one element. Must be non-zero.
+ * @param capacity_hint  Suggested initial capacity (in elements). If zero,
+ *                       a default capacity is used.
+ *
+ * @return Pointer to a new vector on success, or NULL on failure.
+ */
+ds_vec_t *ds_vec_create(size_t elem_size, size_t capacity_hint);
+
+/**
+ * @brief Create a new by-value vector using a custom allocator.
+ *
+ * @param elem_size      Size in bytes of one element. Must be non-zero.
+ * @param capacity_hint  Suggested initial capacity (in elements). If zero,
+ *                       a default capacity is used.
+ * @param allocator      Allocator for the vector and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new vector on success, or NULL on failure.
+ */
+ds_vec_t *ds_vec_create_ex(size_t elem_size, size_t capacity_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a vector and optionally release its elements.
+ *
+ * @param vec        Pointer to the vector.
+ * @param free_func  Optional element destructor.
+ *                   - If non-NULL, it is called with a pointer to each
+ *                     element slot.
+ *                   - If NULL, only the vector itself is freed.
+ */
+void ds_vec_destroy(ds_vec_t *vec, ds_free_f free_func);
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_vec_size(const ds_vec_t *vec);
+
+/**
+ * @brief Get the currently allocated capacity (in elements).
+ */
+size_t ds_vec_capacity(const ds_vec_t *vec);
+
+/**
+ * @brief Get the size in bytes of one element.
+ */
+size_t ds_vec_elem_size(const ds_vec_t *vec);
+
+/**
+ * @brief Check if the vector is empty.
+ */
+bool ds_vec_is_empty(const ds_vec_t *vec);
+
+/**
+ * @brief Get a pointer to the contiguous element storage.
+ *
+ * @return Pointer to the first element, or NULL if vec is NULL.
+ *         The pointer is invalidated by any reallocation.
+ */
+void *ds_vec_data(const ds_vec_t *vec);
+
+/**
+ * @brief Get a span over the elements (see ds_span.h).
+ *
+ * @return A span of size() elements of elem_size bytes, or an empty span
+ *         if vec is NULL.
+ */
+ds_span_t ds_vec_as_span(const ds_vec_t *vec);
+
+/**
+ * @brief Reserve capacity for at least new_capacity elements.
+ *
+ * @param vec           Pointer to the vector.
+ * @param new_capacity  Desired minimum capacity.
+ *
+ * @return
+ *   - DS_OK on success, or if new_capacity is less than or equal to
+ *     the current capacity.
+ *   - DS_ERR_BOUNDS if new_capacity is smaller than the current size.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vec_reserve(ds_vec_t *vec, size_t new_capacity);
+
+/**
+ * @brief Get a pointer to the element at the specified index.
+ *
+ * @param vec    Pointer to the vector.
+ * @param index  Element index.
+ *
+ * @return Pointer to the element slot, or NULL if index is out of range.
+ */
+void *ds_vec_get(const ds_vec_t *vec, size_t index);
+
+/**
+ * @brief Overwrite the element at the specified index.
+ *
+ * @param vec               Pointer to the vector.
+ * @param index             Element index.
+ * @param element           Pointer to the value to copy in.
+ * @param old_element_free  Optional destructor for the old element.
+ *                          - If non-NULL, it is called on the slot before
+ *                            it is overwritten.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ *   - DS_ERR_ARG if element is NULL.
+ */
+ds_status_t ds_vec_set(ds_vec_t *vec, size_t index, const void *element, ds_free_f old_element_free);
+
+/**
+ * @brief Append a copy of an element to the end of the vector.
+ *
+ * @param vec      Pointer to the vector.
+ * @param element  Pointer to the value to copy in.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if element is NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vec_push_back(ds_vec_t *vec, const void *element);
+
+/**
+ * @brief Append one uninitialized element and return its slot.
+ *
+ * Lets callers construct the element in place instead of copying it.
+ *
+ * @return Pointer to the new slot, or NULL on failure.
+ */
+void *ds_vec_emplace_back(ds_vec_t *vec);
+
+/**
+ * @brief Insert a copy of an element at the specified position.
+ *
+ * @param vec      Pointer to the vector.
+ * @param index    Insertion position in the range [0, size].
+ * @param element  Pointer to the value to copy in.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ *   - DS_ERR_ARG if element is NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vec_insert(ds_vec_t *vec, size_t index, const void *element);
+
+/**
+ * @brief Remove the last element, copying it out.
+ *
+ * @param vec  Pointer to the vector.
+ * @param out  Where to copy the removed element. May be NULL to discard it.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_EMPTY if the vector is empty.
+ */
+ds_status_t ds_vec_pop_back(ds_vec_t *vec, void *out);
+
+/**
+ * @brief Remove the element at the specified index.
+ *
+ * @param vec        Pointer to the vector.
+ * @param index      Element index.
+ * @param free_func  Optional element destructor, called on the slot
+ *                   before it is removed.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ */
+ds_status_t ds_vec_remove(ds_vec_t *vec, size_t index, ds_free_f free_func);
+
+/**
+ * @brief Remove all elements from the vector (capacity is kept).
+ *
+ * @param vec        Pointer to the vector.
+ * @param free_func  Optional element destructor, called on each slot.
+ */
+void ds_vec_clear(ds_vec_t *vec, ds_free_f free_func);
+
+/**
+ * @brief Index of the first element whose bytes equal `element`.
+ *
+ * 4- and 8-byte elements use the vector kernels of ds_simd.h, other
+ * sizes a memcmp loop. For typed min/max/lower_bound, call the
+ * ds_simd_* kernels on ds_vec_data() directly.
+ *
+ * @return The index, or SIZE_MAX if no element matches.
+ */
+size_t ds_vec_find(const ds_vec_t *vec, const void *element);
+
+/**
+ * @brief Number of elements whose bytes equal `element`.
+ */
+size_t ds_vec_count(const ds_vec_t *vec, const void *element);
+
+/**
+ * @brief Overwrite every element with a copy of `element`.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_NULL if vec or element is NULL.
+ */
+ds_status_t ds_vec_fill(ds_vec_t *vec, const void *element);
+
+/**
+ * @brief Generate type-specialized inline wrappers over ds_vec_t.
+ *
+ * DS_VEC_DEFINE(ivec, int) defines:
+ *   ds_vec_t   *ivec_create(size_t capacity_hint);
+ *   ds_status_t ivec_push(ds_vec_t *vec, int value);
+ *   int        *ivec_at(const ds_vec_t *vec, size_t index);
+ *   ds_status_t ivec_set(ds_vec_t *vec, size_t index, int value);
+ *   ds_status_t ivec_pop(ds_vec_t *vec, int *out);
+ *   int        *ivec_data(const ds_vec_t *vec);
+ *
+ * Copies are plain assignments of T, so the compiler sees the element
+ * size and emits them inline instead of calling memcpy.
+ */
+#define DS_VEC_DEFINE(name, T)                                                \
+  static inline ds_vec_t *name##_create(size_t capacity_hint) {               \
+    return ds_vec_create(sizeof(T), capacity_hint);                           \
+  }                                                                           \
+  static inline ds_status_t name##_push(ds_vec_t *vec, T value) {             \
+    if (!vec) return DS_ERR_NULL;                                             \
+    T *slot = (T *)ds_vec_emplace_back(vec);                                  \
+    if (!slot) return DS_ERR_MEM;                                             \
+    *slot = value;                                                            \
+    return DS_OK;                                                             \
+  }                                                                           \
+  static inline T *name##_at(const ds_vec_t *vec, size_t index) {             \
+    return (T *)ds_vec_get(vec, index);                                       \
+  }                                                                           \
+  static inline ds_status_t name##_set(ds_vec_t *vec, size_t index, T value) { \
+    if (!vec) return DS_ERR_NULL;                                             \
+    T *slot = (T *)ds_vec_get(vec, index);                                    \
+    if (!slot) return DS_ERR_BOUNDS;                                          \
+    *slot = value;                                                            \
+    return DS_OK;                                                             \
+  }                                                                           \
+  static inline ds_status_t name##_pop(ds_vec_t *vec, T *out) {               \
+    if (!vec) return DS_ERR_NULL;                                             \
+    size_t n = ds_vec_size(vec);                                              \
+    if (n == 0) return DS_ERR_EMPTY;                                          \
+    if (out) *out = ((T *)ds_vec_data(vec))[n - 1];                           \
+    return ds_vec_pop_back(vec, NULL);                                        \
+  }                                                                           \
+  static inline T *name##_data(const ds_vec_t *vec) {                         \
+    return (T *)ds_vec_data(vec);                                             \
+  }
+
+#endif // !DS_VEC_H
@@ -7,6 +7,8 @@
 #define DS_VECTOR_H
 
 #include "ds_common.h"
+#include "ds_span.h"
+#include "ds_stats.h"
 
 /**
  * @brief Opaque vector type.
@@ -26,6 +28,18 @@ typedef struct ds_vector ds_vector_t;
  */
 ds_vector_t *ds_vector_create(size_t capacity_hint);
 
+/**
+ * @brief Create a new dynamic vector using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the vector and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new vector on success, or NULL on failure.
+ */
+ds_vector_t *ds_vector_create_ex(size_t capacity_hint, const ds_allocator_t *allocator);
+
 /**
  * @brief Destroy a vector and optionally free its elements.
  *
@@ -68,6 +82,32 @@ bool ds_vector_is_empty(const ds_vector_t *vec);
  */
 ds_status_t ds_vector_reserve(ds_vector_t *vec, size_t new_capacity);
 
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param vec  Pointer to the vector.
+ *
+ * @return
+ *   - DS_OK on success (an empty vector keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the vector is unchanged.
+ */
+ds_status_t ds_vector_shrink_to_fit(ds_vector_t *vec);
+
+/**
+ * @brief Set the growth policy of the vector.
+ *
+ * The policy decides how much the vector grows when full and whether it
+ * shrinks automatically after pop/remove/clear (see ds_growth_policy_t).
+ *
+ * @param vec     Pointer to the vector.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_vector_set_growth_policy(ds_vector_t *vec, const ds_growth_policy_t *policy);
+
 /**
  * @brief Get the element at the specified index.
  *
@@ -78,6 +118,24 @@ ds_status_t ds_vector_reserve(ds_vector_t *vec, size_t new_capacity);
  */
 void *ds_vector_get(const ds_vector_t *vec, size_t index);
 
+/**
+ * @brief Get the contiguous array of element pointers.
+ *
+ * Elements [0, size) can be read, and overwritten in place, without
+ * going through ds_vector_get()/ds_vector_set().
+ *
+ * @return Pointer to the first slot, or NULL if vec is NULL. The pointer
+ *         is invalidated by any reallocation.
+ */
+void **ds_vector_data(const ds_vector_t *vec);
+
+/**
+ * @brief Get a span over the elements (see ds_span.h).
+ *
+ * @return A span of size() pointers, or an empty span if vec is NULL.
+ */
+ds_span_t ds_vector_as_span(const ds_vector_t *vec);
+
 /**
  * @brief Replace the element at the specified index.
  *
@@ -123,6 +181,43 @@ ds_status_t ds_vector_push_back(ds_vector_t *vec, void *element);
  */
 ds_status_t ds_vector_insert(ds_vector_t *vec, size_t index, void *element);
 
+/**
+ * @brief Append `count` elements to the end of the vector.
+ *
+ * Storage is grown at most once and the pointers are copied in one block.
+ *
+ * @param vec       Pointer to the vector.
+ * @param elements  Array of `count` element pointers. None may be NULL.
+ * @param count     Number of elements to append. Zero is a no-op.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if elements is NULL (with count > 0) or contains NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ *   On error the vector is left unchanged.
+ */
+ds_status_t ds_vector_append_range(ds_vector_t *vec, void *const *elements, size_t count);
+
+/**
+ * @brief Insert `count` elements at the specified position.
+ *
+ * Storage is grown at most once and the tail is shifted with a single
+ * memmove, so inserting a batch costs O(size + count).
+ *
+ * @param vec       Pointer to the vector.
+ * @param index     Insertion position in the range [0, size].
+ * @param elements  Array of `count` element pointers. None may be NULL.
+ * @param count     Number of elements to insert. Zero is a no-op.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ *   - DS_ERR_ARG if elements is NULL (with count > 0) or contains NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ *   On error the vector is left unchanged.
+ */
+ds_status_t ds_vector_insert_range(ds_vector_t *vec, size_t index, void *const *elements, size_t count);
+
 /**
  * @brief Remove and return the last element.
  *
@@ -151,6 +246,23 @@ void *ds_vector_pop_back(ds_vector_t *vec);
  */
 ds_status_t ds_vector_remove(ds_vector_t *vec, size_t index, ds_free_f free_func);
 
+/**
+ * @brief Remove the elements in [index, index + count).
+ *
+ * The tail is shifted with a single memmove.
+ *
+ * @param vec        Pointer to the vector.
+ * @param index      Index of the first element to remove.
+ * @param count      Number of elements to remove. Zero is a no-op.
+ * @param free_func  Optional element destructor, called on each removed
+ *                   element.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if the range does not lie within [0, size].
+ */
+ds_status_t ds_vector_remove_range(ds_vector_t *vec, size_t index, size_t count, ds_free_f free_func);
+
 /**
  * @brief Remove all elements from the vector.
  *
@@ -162,4 +274,93 @@ ds_status_t ds_vector_remove(ds_vector_t *vec, size_t index, ds_free_f free_func
  */
 void ds_vector_clear(ds_vector_t *vec, ds_free_f free_func);
 
+/**
+ * @brief Get the instrumentation counters (see ds_stats.h).
+ *
+ * Reallocations and their latency, allocator traffic. Comparisons are
+ * not counted: they run in the caller's compare function.
+ *
+ * @return
+ *   - DS_OK               On success.
+ *   - DS_ERR_NULL         If vec or out is NULL.
+ *   - DS_ERR_UNSUPPORTED  If built without DS_ENABLE_STATS.
+ */
+ds_status_t ds_vector_stats(const ds_vector_t *vec, ds_stats_t *out);
+
+/**
+ * @brief Index of the first element identical to `element` (pointer
+ *        identity, not ds_compare_f equality). Uses ds_simd_find_ptr().
+ *
+ * @return The index, or SIZE_MAX if no element matches.
+ */
+size_t ds_vector_find(const ds_vector_t *vec, const void *element);
+
+/**
+ * @brief Number of elements identical to `element` (pointer identity).
+ */
+size_t ds_vector_count(const ds_vector_t *vec, const void *element);
+
+/**
+ * @brief Sort the elements in place (introsort, not stable).
+ *
+ * Built from DS_DEFINE_SORT (see ds_generic.h): O(n log n) worst case,
+ * no allocation.
+ *
+ * @param vec      Pointer to the vector.
+ * @param compare  Element comparison. If NULL, elements are ordered by
+ *                 address, with the comparison inlined instead of called.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_NULL if vec is NULL.
+ */
+ds_status_t ds_vector_sort(ds_vector_t *vec, ds_compare_f compare);
+
+/* -------------------------------------------------------------------------
+ * Parallel operations
+ * -------------------------------------------------------------------------
+ *
+ * Each call starts a ds_threadpool_t with the default allocator, splits
+ * the array into contiguous chunks (a few per worker) and waits for all
+ * of them before returning. The vector must not be modified by anyone
+ * else during the call. The vector's own allocator is only called from
+ * the calling thread (for scratch memory), so it need not be thread-safe.
+ *
+ * nthreads: 0 = one thread per online CPU, 1 = sequential on the calling
+ * thread. If the pool or the scratch memory cannot be allocated the call
+ * also falls back to the sequential version, so these never fail for
+ * lack of resources.
+ */
+
+/**
+ * @brief Sort the elements in place, from several threads.
+ *
+ * Every worker introsorts one run, then the runs are merged pairwise;
+ * each merge is itself split across the workers. Needs a scratch array
+ * of size() pointers. Small vectors are sorted sequentially. Not stable.
+ * `compare` is called concurrently and must be thread-safe.
+ *
+ * @param vec       Pointer to the vector.
+ * @param compare   Element comparison, or NULL for address order.
+ * @param nthreads  Number of worker threads (0 = CPU count).
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_NULL if vec is NULL.
+ */
+ds_status_t ds_vector_parallel_sort(ds_vector_t *vec, ds_compare_f compare, size_t nthreads);
+
+/**
+ * @brief Visit every element exactly once, from several threads.
+ *
+ * Ordering: none across chunks; within a chunk elements are visited in
+ * index order. `visit` must be thread-safe.
+ *
+ * @return
+ *   - DS_OK on success (also for an empty vector).
+ *   - DS_ERR_NULL if vec is NULL.
+ *   - DS_ERR_ARG if visit is NULL.
+ */
+ds_status_t ds_vector_parallel_for_each(const ds_vector_t *vec, ds_visit_f visit, size_t nthreads);
+
 #endif // !DS_VECTOR_H
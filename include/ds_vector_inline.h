@@ -0,0 +1,80 @@
+/*
+** include/ds_vector_inline.h -- Layout of ds_vector_t and unchecked inline
+**                               accessors for hot loops. Opt-in: include it
+**                               instead of (or after) ds_vector.h.
+*/
+
+#ifndef DS_VECTOR_INLINE_H
+#define DS_VECTOR_INLINE_H
+
+#include "ds_common.h"
+#include "ds_stats.h"
+#include "ds_vector.h"
+#include <stddef.h>
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Inline fast paths
+ * -------------------------------------------------------------------------
+ *
+ * The functions in ds_vector.h live in ds_vector.c and check every
+ * argument. This header exposes the struct so the hottest operations
+ * can be inlined into the caller:
+ *
+ *   *_unsafe  No checks at all. The caller guarantees a valid vector and
+ *             an in-range index / non-empty vector; anything else is
+ *             undefined behaviour.
+ *   *_fast    Same result as the checked call for valid arguments: the
+ *             common case (room left) is inlined, everything else goes
+ *             to the checked function. `element` must not be NULL.
+ *
+ * Neither variant shrinks the storage automatically; call
+ * ds_vector_shrink_to_fit() if the growth policy asks for shrinking.
+ *
+ * Code that includes this header depends on the struct layout, which
+ * may change between versions. The checked API stays the default.
+ * -------------------------------------------------------------------------
+ */
+
+struct ds_vector {
+  void **items;     // Dynamic array, store `void *` pointer
+  size_t capacity;  // Capacity of current array
+  size_t size;      // Element count of current array
+  ds_allocator_t alloc;
+  ds_growth_policy_t policy;
+  DS_STATS_FIELD
+};
+
+/**
+ * @brief Element at `index` (index < size).
+ */
+static inline void *ds_vector_get_unsafe(const ds_vector_t *vec, size_t index) {
+  return vec->items[index];
+}
+
+/**
+ * @brief Overwrite the element at `index` (index < size); the old one is
+ *        not freed.
+ */
+static inline void ds_vector_set_unsafe(ds_vector_t *vec, size_t index, void *element) {
+  vec->items[index] = element;
+}
+
+/**
+ * @brief Remove and return the last element (size > 0).
+ */
+static inline void *ds_vector_pop_back_unsafe(ds_vector_t *vec) {
+  return vec->items[-- vec->size];
+}
+
+/**
+ * @brief ds_vector_push_back() with the no-growth case inlined.
+ */
+static inline ds_status_t ds_vector_push_back_fast(ds_vector_t *vec, void *element) {
+  if (vec->size < vec->capacity) {
+    vec->items[vec->size ++] = element;
+    return DS_OK;
+  }
+  return ds_vector_push_back(vec, element);
+}
+
+#endif // !DS_VECTOR_INLINE_H
@@ -0,0 +1,102 @@
+/*
+** include/ds_wsdeque.h -- A work-stealing deque (Chase-Lev) storing opaque
+**                         pointers (void *). One owner thread pushes and
+**                         pops at the back; any thread may steal from the
+**                         front.
+*/
+
+#ifndef DS_WSDEQUE_H
+#define DS_WSDEQUE_H
+
+#include "ds_common.h"
+
+/** -------------------------------------------------------------------------
+ * 🧠 ARCHITECTURE: Work-stealing deque
+ * -------------------------------------------------------------------------
+ *
+ * Same circular, power-of-two buffer as the rings in `ds_ring.h`, but it
+ * grows like `ds_deque_t` and the two ends have different owners:
+ *
+ *        steal() ->  [ top ... ... ... bottom )  <- push() / pop()
+ *        any thread                               owner thread only
+ *
+ * - push() and pop() on the owner side are plain loads and stores in the
+ *   common case; only pop() of the very last element races with thieves
+ *   and resolves it with a CAS on `top`.
+ * - steal() claims the front element with one CAS. It returns NULL when
+ *   the deque is empty *or* when it lost a race with another thread, so a
+ *   NULL result only means "nothing stolen this time".
+ * - When the buffer is full, push() copies it into one twice as large.
+ *   The old buffer may still be read by a concurrent thief, so it is kept
+ *   until ds_wsdeque_destroy().
+ *
+ * NULL elements are rejected, as everywhere in the library.
+ * create/destroy are not thread-safe.
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Opaque work-stealing deque type.
+ */
+typedef struct ds_wsdeque ds_wsdeque_t;
+
+/**
+ * @brief Create a new work-stealing deque.
+ *
+ * @param capacity_hint  Initial capacity, rounded up to a power of two.
+ *                       If zero, a default is used.
+ *
+ * @return Pointer to a new deque on success, or NULL on failure.
+ */
+ds_wsdeque_t *ds_wsdeque_create(size_t capacity_hint);
+
+/**
+ * @brief Create a new work-stealing deque using a custom allocator.
+ *
+ * @param capacity_hint  Initial capacity, rounded up to a power of two.
+ * @param allocator      Allocator for the deque. It is copied and called
+ *                       only from the owner thread. If NULL, the default
+ *                       allocator is used.
+ *
+ * @return Pointer to a new deque on success, or NULL on failure.
+ */
+ds_wsdeque_t *ds_wsdeque_create_ex(size_t capacity_hint, const ds_allocator_t *allocator);
+
+/**
+ * @brief Destroy a deque and optionally free the elements still queued.
+ *
+ * No other thread may be using the deque.
+ */
+void ds_wsdeque_destroy(ds_wsdeque_t *deque, ds_free_f free_func);
+
+/**
+ * @brief Get a snapshot of the number of queued elements.
+ */
+size_t ds_wsdeque_size(const ds_wsdeque_t *deque);
+
+/**
+ * @brief Push an element at the back (owner thread only).
+ *
+ * @return
+ *   - DS_OK       On success.
+ *   - DS_ERR_MEM  If the buffer had to grow and allocation failed.
+ *   - DS_ERR_*    On invalid arguments.
+ */
+ds_status_t ds_wsdeque_push(ds_wsdeque_t *deque, void *element);
+
+/**
+ * @brief Pop the most recently pushed element (owner thread only).
+ *
+ * @return The element, or NULL if the deque is empty.
+ */
+void *ds_wsdeque_pop(ds_wsdeque_t *deque);
+
+/**
+ * @brief Steal the oldest element (any thread).
+ *
+ * @return The element, or NULL if the deque is empty or another thread
+ *         took the element first.
+ */
+void *ds_wsdeque_steal(ds_wsdeque_t *deque);
+
+#endif // !DS_WSDEQUE_H
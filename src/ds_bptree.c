@@ -0,0 +1,758 @@
+#include "ds_bptree.h"
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Maximum number of children of an internal node.
+// 32 pointers = 256 bytes = 4 cache lines of packed keys per node.
+#ifndef DS_BPTREE_ORDER
+#define DS_BPTREE_ORDER 32
+#endif
+
+#if DS_BPTREE_ORDER < 4
+#error "DS_BPTREE_ORDER must be at least 4"
+#endif
+
+#define BPT_MAX_KEYS   (DS_BPTREE_ORDER - 1)
+#define BPT_MIN_KEYS   (BPT_MAX_KEYS / 2)
+// Every level has at least 2 children, so the height never exceeds
+// the number of bits in size_t.
+#define BPT_MAX_HEIGHT (sizeof(size_t) * 8)
+
+/*
+ * Node layout:
+ *   - Both node kinds share a header with the key array. It has one spare
+ *     slot so that a node may temporarily hold MAX + 1 keys right before
+ *     it is split.
+ *   - Leaf:     keys[0..n) are the stored elements.
+ *   - Internal: n keys, n + 1 children.
+ *               keys[i] is the minimum element of children[i + 1].
+ */
+typedef struct bpt_node {
+  size_t nkeys;
+  bool is_leaf;
+  void *keys[BPT_MAX_KEYS + 1];
+} bpt_node_t;
+
+typedef struct bpt_inner {
+  bpt_node_t base;
+  bpt_node_t *children[BPT_MAX_KEYS + 2];
+} bpt_inner_t;
+
+typedef struct bpt_leaf {
+  bpt_node_t base;
+  struct bpt_leaf *prev;
+  struct bpt_leaf *next;
+} bpt_leaf_t;
+
+struct ds_bptree {
+  bpt_node_t *root;
+  size_t size;
+  size_t height;
+  ds_compare_f compare;
+  ds_allocator_t alloc;
+};
+
+#define AS_INNER(n) ((bpt_inner_t *)(n))
+#define AS_LEAF(n)  ((bpt_leaf_t *)(n))
+
+/**
+ * @brief Allocate an empty leaf.
+ */
+static bpt_leaf_t *bpt_leaf_create(ds_bptree_t *tree) {
+  bpt_leaf_t *leaf = ds_mem_alloc(&tree->alloc, sizeof(bpt_leaf_t));
+  if (!leaf) return NULL;
+
+  leaf->base.nkeys = 0;
+  leaf->base.is_leaf = true;
+  leaf->prev = NULL;
+  leaf->next = NULL;
+
+  return leaf;
+}
+
+/**
+ * @brief Allocate an empty internal node.
+ */
+static bpt_inner_t *bpt_inner_create(ds_bptree_t *tree) {
+  bpt_inner_t *inner = ds_mem_alloc(&tree->alloc, sizeof(bpt_inner_t));
+  if (!inner) return NULL;
+
+  inner->base.nkeys = 0;
+  inner->base.is_leaf = false;
+
+  return inner;
+}
+
+/**
+ * @brief Release a leaf or internal node.
+ */
+static void bpt_node_free(ds_bptree_t *tree, bpt_node_t *node) {
+  ds_mem_free(&tree->alloc, node, node->is_leaf ? sizeof(bpt_leaf_t) : sizeof(bpt_inner_t));
+}
+
+/**
+ * @brief Index of the first key >= key (binary search over packed keys).
+ */
+static size_t lower_bound_idx(const ds_bptree_t *tree, const bpt_node_t *node, const void *key) {
+  size_t lo = 0, hi = node->nkeys;
+  while (lo < hi) {
+    size_t mid = lo + ((hi - lo) >> 1);
+    if (tree->compare(node->keys[mid], key) < 0) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * @brief Index of the first key > key, i.e. the child to descend into.
+ */
+static size_t upper_bound_idx(const ds_bptree_t *tree, const bpt_node_t *node, const void *key) {
+  size_t lo = 0, hi = node->nkeys;
+  while (lo < hi) {
+    size_t mid = lo + ((hi - lo) >> 1);
+    if (tree->compare(node->keys[mid], key) <= 0) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * @brief Descend to the leaf that may contain key.
+ */
+static bpt_leaf_t *find_leaf(const ds_bptree_t *tree, const void *key) {
+  bpt_node_t *node = tree->root;
+  if (!node) return NULL;
+
+  while (!node->is_leaf) {
+    node = AS_INNER(node)->children[upper_bound_idx(tree, node, key)];
+  }
+
+  return AS_LEAF(node);
+}
+
+/**
+ * @brief Left-most / right-most leaf of a subtree.
+ */
+static bpt_leaf_t *leftmost_leaf(bpt_node_t *node) {
+  while (!node->is_leaf) node = AS_INNER(node)->children[0];
+  return AS_LEAF(node);
+}
+
+static bpt_leaf_t *rightmost_leaf(bpt_node_t *node) {
+  while (!node->is_leaf) node = AS_INNER(node)->children[node->nkeys];
+  return AS_LEAF(node);
+}
+
+/**
+ * @brief Minimum element of a subtree.
+ */
+static void *subtree_min(bpt_node_t *node) {
+  return leftmost_leaf(node)->base.keys[0];
+}
+
+/**
+ * @brief Insert key into slot `pos` of a node's key array.
+ */
+static void keys_insert(bpt_node_t *node, size_t pos, void *key) {
+  memmove(&node->keys[pos + 1], &node->keys[pos], (node->nkeys - pos) * sizeof(void *));
+  node->keys[pos] = key;
+  node->nkeys ++;
+}
+
+/**
+ * @brief Remove slot `pos` from a node's key array.
+ */
+static void keys_remove(bpt_node_t *node, size_t pos) {
+  memmove(&node->keys[pos], &node->keys[pos + 1], (node->nkeys - pos - 1) * sizeof(void *));
+  node->nkeys --;
+}
+
+/**
+ * @brief Insert child into slot `pos` of an internal node's child array.
+ *        Must be called before the matching keys_insert().
+ */
+static void children_insert(bpt_inner_t *inner, size_t pos, bpt_node_t *child) {
+  memmove(&inner->children[pos + 1], &inner->children[pos],
+          (inner->base.nkeys + 1 - pos) * sizeof(bpt_node_t *));
+  inner->children[pos] = child;
+}
+
+/**
+ * @brief Remove slot `pos` from an internal node's child array.
+ *        Must be called before the matching keys_remove().
+ */
+static void children_remove(bpt_inner_t *inner, size_t pos) {
+  memmove(&inner->children[pos], &inner->children[pos + 1],
+          (inner->base.nkeys - pos) * sizeof(bpt_node_t *));
+}
+
+/**
+ * @brief Split an overfull leaf into `leaf` and `right`.
+ *
+ * @return The separator to push up (minimum of `right`).
+ */
+static void *split_leaf(bpt_leaf_t *leaf, bpt_leaf_t *right) {
+  size_t n = leaf->base.nkeys;
+  size_t keep = n / 2;
+
+  memcpy(right->base.keys, &leaf->base.keys[keep], (n - keep) * sizeof(void *));
+  right->base.nkeys = n - keep;
+  leaf->base.nkeys = keep;
+
+  // Link: leaf <-> right <-> old next
+  right->next = leaf->next;
+  right->prev = leaf;
+  if (leaf->next) leaf->next->prev = right;
+  leaf->next = right;
+
+  return right->base.keys[0];
+}
+
+/**
+ * @brief Split an overfull internal node into `inner` and `right`.
+ *
+ * The middle key moves up, it is already the minimum of `right`.
+ *
+ * @return The separator to push up.
+ */
+static void *split_inner(bpt_inner_t *inner, bpt_inner_t *right) {
+  size_t n = inner->base.nkeys;
+  size_t mid = n / 2;
+  void *sep = inner->base.keys[mid];
+
+  memcpy(right->base.keys, &inner->base.keys[mid + 1], (n - mid - 1) * sizeof(void *));
+  memcpy(right->children, &inner->children[mid + 1], (n - mid) * sizeof(bpt_node_t *));
+  right->base.nkeys = n - mid - 1;
+  inner->base.nkeys = mid;
+
+  return sep;
+}
+
+/**
+ * @brief Create a new B+tree.
+ *
+ * @param compare  Function used to compare elements.
+ *
+ * @return Pointer to a new B+tree on success, or NULL on failure.
+ */
+ds_bptree_t *ds_bptree_create(ds_compare_f compare) {
+  return ds_bptree_create_ex(compare, NULL);
+}
+
+/**
+ * @brief Create a new B+tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new B+tree on success, or NULL on failure.
+ */
+ds_bptree_t *ds_bptree_create_ex(ds_compare_f compare, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!compare) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_bptree_t *tree = ds_mem_alloc(allocator, sizeof(ds_bptree_t));
+  if (!tree) return NULL;
+
+  tree->alloc = *allocator;
+
+  tree->root = NULL;
+  tree->size = 0;
+  tree->height = 0;
+  tree->compare = compare;
+
+  return tree;
+}
+
+/**
+ * @brief Free the node structure of a subtree (elements are not touched).
+ *
+ * The recursion depth is the tree height, which is tiny.
+ */
+static void free_nodes(ds_bptree_t *tree, bpt_node_t *node) {
+  if (!node->is_leaf) {
+    bpt_inner_t *inner = AS_INNER(node);
+    for (size_t i = 0; i <= node->nkeys; ++ i) {
+      free_nodes(tree, inner->children[i]);
+    }
+  }
+  bpt_node_free(tree, node);
+}
+
+/**
+ * @brief Destroy a B+tree and optionally free its elements.
+ *
+ * @param tree       Pointer to the B+tree.
+ * @param free_func  Optional element destructor.
+ *                   - If non-NULL, it is called for each stored element.
+ *                   - If NULL, only the B+tree itself is freed.
+ */
+void ds_bptree_destroy(ds_bptree_t *tree, ds_free_f free_func) {
+  // Check input parameters
+  if (!tree) return;
+
+  if (tree->root) {
+    // Elements are reached through the leaf chain
+    if (free_func) {
+      for (bpt_leaf_t *leaf = leftmost_leaf(tree->root); leaf; leaf = leaf->next) {
+        for (size_t i = 0; i < leaf->base.nkeys; ++ i) {
+          free_func(leaf->base.keys[i]);
+        }
+      }
+    }
+
+    free_nodes(tree, tree->root);
+  }
+
+  ds_mem_free(&tree->alloc, tree, sizeof(ds_bptree_t));
+}
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_bptree_size(const ds_bptree_t *tree) {
+  if (!tree) return 0;
+
+  return tree->size;
+}
+
+/**
+ * @brief Get the height of the tree.
+ */
+size_t ds_bptree_height(const ds_bptree_t *tree) {
+  if (!tree) return 0;
+
+  return tree->height;
+}
+
+/**
+ * @brief Insert a new element into the B+tree.
+ *
+ * Two phases, so that an allocation failure never leaves a half-split tree:
+ *   1. Descend, record the path, reject duplicates and count how many
+ *      nodes (from the leaf upward) are full and will split.
+ *   2. Allocate all required nodes up front, then insert and propagate
+ *      the splits bottom-up.
+ *
+ * @return
+ * - DS_OK:        On success.
+ * - DS_ERR_EXIST: If the data already exists (Duplicate keys are not allowed).
+ * - DS_ERR_MEM:   If memory allocation fails.
+ */
+ds_status_t ds_bptree_insert(ds_bptree_t *tree, void *data) {
+  // Check input parameters
+  if (!tree) return DS_ERR_NULL;
+  if (!data) return DS_ERR_ARG;
+
+  // Empty tree: a single leaf becomes the root
+  if (!tree->root) {
+    bpt_leaf_t *leaf = bpt_leaf_create(tree);
+    if (!leaf) return DS_ERR_MEM;
+
+    leaf->base.keys[0] = data;
+    leaf->base.nkeys = 1;
+    tree->root = &leaf->base;
+    tree->height = 1;
+    tree->size ++;
+    return DS_OK;
+  }
+
+  // Phase 1: Record the path from the root to the leaf
+  bpt_node_t *path[BPT_MAX_HEIGHT];
+  size_t slot[BPT_MAX_HEIGHT];      // Child index taken at each level
+  size_t depth = 0;
+
+  bpt_node_t *node = tree->root;
+  while (!node->is_leaf) {
+    size_t i = upper_bound_idx(tree, node, data);
+    path[depth] = node;
+    slot[depth] = i;
+    depth ++;
+    node = AS_INNER(node)->children[i];
+  }
+
+  bpt_leaf_t *leaf = AS_LEAF(node);
+  size_t pos = lower_bound_idx(tree, node, data);
+  if (pos < node->nkeys && tree->compare(node->keys[pos], data) == 0)
+    return DS_ERR_EXIST;   // Duplicate key not allowed
+
+  // Count the splits: the leaf and every full ancestor directly above it
+  size_t splits = 0;
+  if (node->nkeys == BPT_MAX_KEYS) {
+    splits = 1;
+    while (splits <= depth && path[depth - splits]->nkeys == BPT_MAX_KEYS) splits ++;
+  }
+  bool new_root = splits > depth;
+
+  // Phase 2: Allocate everything that may be needed
+  bpt_leaf_t *spare_leaf = NULL;
+  bpt_inner_t *spare_inner[BPT_MAX_HEIGHT + 1];
+  size_t n_inner = (splits > 0 ? splits - 1 : 0) + (new_root ? 1 : 0);
+
+  if (splits > 0) {
+    spare_leaf = bpt_leaf_create(tree);
+    if (!spare_leaf) return DS_ERR_MEM;
+  }
+  for (size_t i = 0; i < n_inner; ++ i) {
+    spare_inner[i] = bpt_inner_create(tree);
+    if (!spare_inner[i]) {
+      while (i > 0) bpt_node_free(tree, &spare_inner[-- i]->base);
+      if (spare_leaf) bpt_node_free(tree, &spare_leaf->base);
+      return DS_ERR_MEM;
+    }
+  }
+
+  // Insertion into the leaf
+  keys_insert(node, pos, data);
+  tree->size ++;
+
+  if (splits == 0) return DS_OK;
+
+  void *sep = split_leaf(leaf, spare_leaf);
+  bpt_node_t *right = &spare_leaf->base;
+  size_t used = 0;
+
+  // Propagate the split upward
+  while (depth > 0) {
+    depth --;
+    bpt_inner_t *parent = AS_INNER(path[depth]);
+    size_t i = slot[depth];
+
+    children_insert(parent, i + 1, right);
+    keys_insert(&parent->base, i, sep);
+
+    if (parent->base.nkeys <= BPT_MAX_KEYS) return DS_OK;
+
+    bpt_inner_t *sibling = spare_inner[used ++];
+    sep = split_inner(parent, sibling);
+    right = &sibling->base;
+  }
+
+  // The root itself split: grow the tree by one level
+  bpt_inner_t *root = spare_inner[used ++];
+  root->children[0] = tree->root;
+  root->children[1] = right;
+  root->base.keys[0] = sep;
+  root->base.nkeys = 1;
+  tree->root = &root->base;
+  tree->height ++;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Search for data matching a key.
+ *
+ * @param tree  Pointer to the B+tree.
+ * @param key   Pointer to a dummy object or key used for comparison.
+ *
+ * @return Pointer to the stored data if found, NULL otherwise.
+ */
+void *ds_bptree_search(const ds_bptree_t *tree, const void *key) {
+  // Check input parameters
+  if (!tree || !tree->root || !key) return NULL;
+
+  bpt_leaf_t *leaf = find_leaf(tree, key);
+  size_t pos = lower_bound_idx(tree, &leaf->base, key);
+
+  if (pos < leaf->base.nkeys && tree->compare(leaf->base.keys[pos], key) == 0)
+    return leaf->base.keys[pos];
+
+  return NULL;
+}
+
+/**
+ * @brief Merge children[j + 1] of `parent` into children[j].
+ */
+static void merge_children(ds_bptree_t *tree, bpt_inner_t *parent, size_t j) {
+  bpt_node_t *left = parent->children[j];
+  bpt_node_t *right = parent->children[j + 1];
+
+  if (left->is_leaf) {
+    memcpy(&left->keys[left->nkeys], right->keys, right->nkeys * sizeof(void *));
+    left->nkeys += right->nkeys;
+
+    bpt_leaf_t *l = AS_LEAF(left), *r = AS_LEAF(right);
+    l->next = r->next;
+    if (r->next) r->next->prev = l;
+  } else {
+    // The separator comes down between the two key runs. It is recomputed
+    // rather than copied: the parent's copy may still reference the element
+    // that was just removed from `right`.
+    left->keys[left->nkeys] = subtree_min(right);
+    memcpy(&left->keys[left->nkeys + 1], right->keys, right->nkeys * sizeof(void *));
+    memcpy(&AS_INNER(left)->children[left->nkeys + 1], AS_INNER(right)->children,
+           (right->nkeys + 1) * sizeof(bpt_node_t *));
+    left->nkeys += right->nkeys + 1;
+  }
+
+  children_remove(parent, j + 1);
+  keys_remove(&parent->base, j);
+  bpt_node_free(tree, right);
+}
+
+/**
+ * @brief Fix an underfull children[i] by borrowing from a sibling,
+ *        or merging with one when neither can spare a key.
+ */
+static void rebalance_child(ds_bptree_t *tree, bpt_inner_t *parent, size_t i) {
+  bpt_node_t *child = parent->children[i];
+  bpt_node_t *left = i > 0 ? parent->children[i - 1] : NULL;
+  bpt_node_t *right = i < parent->base.nkeys ? parent->children[i + 1] : NULL;
+
+  // Case 1: Borrow the last entry of the left sibling
+  if (left && left->nkeys > BPT_MIN_KEYS) {
+    if (child->is_leaf) {
+      keys_insert(child, 0, left->keys[left->nkeys - 1]);
+      left->nkeys --;
+      parent->base.keys[i - 1] = child->keys[0];
+    } else {
+      bpt_inner_t *c = AS_INNER(child);
+      children_insert(c, 0, AS_INNER(left)->children[left->nkeys]);
+      keys_insert(child, 0, subtree_min(c->children[1]));
+      parent->base.keys[i - 1] = left->keys[left->nkeys - 1];
+      left->nkeys --;
+    }
+    return;
+  }
+
+  // Case 2: Borrow the first entry of the right sibling
+  if (right && right->nkeys > BPT_MIN_KEYS) {
+    if (child->is_leaf) {
+      child->keys[child->nkeys ++] = right->keys[0];
+      keys_remove(right, 0);
+      parent->base.keys[i] = right->keys[0];
+    } else {
+      bpt_inner_t *c = AS_INNER(child);
+      c->children[child->nkeys + 1] = AS_INNER(right)->children[0];
+      child->keys[child->nkeys ++] = parent->base.keys[i];
+      parent->base.keys[i] = right->keys[0];
+      children_remove(AS_INNER(right), 0);
+      keys_remove(right, 0);
+    }
+    return;
+  }
+
+  // Case 3: Merge with a sibling
+  if (left) merge_children(tree, parent, i - 1);
+  else      merge_children(tree, parent, i);
+}
+
+/**
+ * @brief Remove key from the subtree rooted at node.
+ *
+ * @return The removed element, or NULL if key was not found.
+ */
+static void *remove_rec(ds_bptree_t *tree, bpt_node_t *node, const void *key) {
+  if (node->is_leaf) {
+    size_t pos = lower_bound_idx(tree, node, key);
+    if (pos >= node->nkeys || tree->compare(node->keys[pos], key) != 0) return NULL;
+
+    void *data = node->keys[pos];
+    keys_remove(node, pos);
+    return data;
+  }
+
+  bpt_inner_t *inner = AS_INNER(node);
+  size_t i = upper_bound_idx(tree, node, key);
+
+  void *data = remove_rec(tree, inner->children[i], key);
+  if (!data) return NULL;
+
+  if (inner->children[i]->nkeys < BPT_MIN_KEYS) {
+    rebalance_child(tree, inner, i);
+    if (i > node->nkeys) i = node->nkeys;   // A merge may have shifted the slot
+  }
+
+  // The removed element may have been the minimum of children[i],
+  // in which case it is still referenced by a separator. Refresh the
+  // separators around the touched slot so they point to live data.
+  size_t lo = i > 1 ? i - 2 : 0;
+  size_t hi = i + 1 < node->nkeys ? i + 1 : node->nkeys;
+  for (size_t k = lo; k < hi; ++ k) {
+    node->keys[k] = subtree_min(inner->children[k + 1]);
+  }
+
+  return data;
+}
+
+/**
+ * @brief Remove the element matching the key.
+ *
+ * @param tree       Pointer to the B+tree.
+ * @param key        Pointer to the key to identify the element.
+ * @param free_func  Optional destructor.
+ *
+ * @return
+ * - DS_OK:            If the element was found and removed.
+ * - DS_ERR_NOT_FOUND: If the key was not found.
+ * - DS_ERR_*:         On invalid arguments.
+ */
+ds_status_t ds_bptree_remove(ds_bptree_t *tree, const void *key, ds_free_f free_func) {
+  // Check input parameters
+  if (!tree) return DS_ERR_NULL;
+  if (!tree->root) return DS_ERR_NOT_FOUND;
+  if (!key) return DS_ERR_ARG;
+
+  void *data = remove_rec(tree, tree->root, key);
+  if (!data) return DS_ERR_NOT_FOUND;
+
+  // Shrink the tree
+  bpt_node_t *root = tree->root;
+  if (root->is_leaf && root->nkeys == 0) {
+    bpt_node_free(tree, root);
+    tree->root = NULL;
+    tree->height = 0;
+  } else if (!root->is_leaf && root->nkeys == 0) {
+    tree->root = AS_INNER(root)->children[0];
+    tree->height --;
+    bpt_node_free(tree, root);
+  }
+
+  // Free
+  if (free_func) free_func(data);
+  tree->size --;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Get the minimum element.
+ */
+void *ds_bptree_min(const ds_bptree_t *tree) {
+  // Check input parameters
+  if (!tree || !tree->root) return NULL;
+
+  return subtree_min(tree->root);
+}
+
+/**
+ * @brief Get the maximum element.
+ */
+void *ds_bptree_max(const ds_bptree_t *tree) {
+  // Check input parameters
+  if (!tree || !tree->root) return NULL;
+
+  bpt_leaf_t *leaf = rightmost_leaf(tree->root);
+  return leaf->base.keys[leaf->base.nkeys - 1];
+}
+
+/**
+ * @brief Perform an In-order traversal (strictly increasing order).
+ */
+void ds_bptree_traverse_inorder(const ds_bptree_t *tree, ds_visit_f visit) {
+  // Check input parameters
+  if (!tree || !tree->root || !visit) return;
+
+  for (bpt_leaf_t *leaf = leftmost_leaf(tree->root); leaf; leaf = leaf->next) {
+    for (size_t i = 0; i < leaf->base.nkeys; ++ i) {
+      visit(leaf->base.keys[i]);
+    }
+  }
+}
+
+/**
+ * @brief Visit every element in the half-open range [lo, hi) in order.
+ */
+void ds_bptree_traverse_range(const ds_bptree_t *tree, const void *lo, const void *hi, ds_visit_f visit) {
+  // Check input parameters
+  if (!tree || !tree->root || !visit) return;
+
+  ds_bptree_iter_t it = lo ? ds_bptree_lower_bound(tree, lo) : ds_bptree_iter_begin(tree);
+
+  while (!ds_bptree_iter_is_end(it)) {
+    void *data = ds_bptree_iter_get(it);
+    if (hi && tree->compare(data, hi) >= 0) break;
+
+    visit(data);
+    it = ds_bptree_iter_next(it);
+  }
+}
+
+/**
+ * @brief Get an iterator pointing to the minimum element.
+ */
+ds_bptree_iter_t ds_bptree_iter_begin(const ds_bptree_t *tree) {
+  ds_bptree_iter_t it = { NULL, 0 };
+  if (!tree || !tree->root) return it;
+
+  it.leaf = leftmost_leaf(tree->root);
+  return it;
+}
+
+/**
+ * @brief Get an iterator to the first element that is not less than key.
+ */
+ds_bptree_iter_t ds_bptree_lower_bound(const ds_bptree_t *tree, const void *key) {
+  ds_bptree_iter_t it = { NULL, 0 };
+  if (!tree || !tree->root || !key) return it;
+
+  bpt_leaf_t *leaf = find_leaf(tree, key);
+  size_t pos = lower_bound_idx(tree, &leaf->base, key);
+
+  // Key is greater than everything in this leaf: continue in the next one
+  if (pos == leaf->base.nkeys) {
+    leaf = leaf->next;
+    pos = 0;
+  }
+
+  it.leaf = leaf;
+  it.index = leaf ? pos : 0;
+  return it;
+}
+
+/**
+ * @brief Move the iterator forward by one element.
+ */
+ds_bptree_iter_t ds_bptree_iter_next(ds_bptree_iter_t it) {
+  if (!it.leaf) return it;
+
+  const bpt_leaf_t *leaf = it.leaf;
+  if (it.index + 1 < leaf->base.nkeys) {
+    it.index ++;
+  } else {
+    it.leaf = leaf->next;
+    it.index = 0;
+  }
+
+  return it;
+}
+
+/**
+ * @brief Move the iterator backward by one element.
+ */
+ds_bptree_iter_t ds_bptree_iter_prev(ds_bptree_iter_t it) {
+  if (!it.leaf) return it;
+
+  const bpt_leaf_t *leaf = it.leaf;
+  if (it.index > 0) {
+    it.index --;
+  } else {
+    it.leaf = leaf->prev;
+    it.index = leaf->prev ? leaf->prev->base.nkeys - 1 : 0;
+  }
+
+  return it;
+}
+
+/**
+ * @brief Check whether the iterator is the End Iterator.
+ */
+bool ds_bptree_iter_is_end(ds_bptree_iter_t it) {
+  return it.leaf == NULL;
+}
+
+/**
+ * @brief Get the data pointed to by the iterator.
+ */
+void *ds_bptree_iter_get(ds_bptree_iter_t it) {
+  if (!it.leaf) return NULL;
+
+  return ((const bpt_leaf_t *)it.leaf)->base.keys[it.index];
+}
@@ -1,36 +1,63 @@
 #include "ds_bst.h"
+#include "ds_pool.h"
 #include "ds_stack.h"
+#include "ds_stats.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
 
-typedef struct ds_bst_node {
+struct ds_bst_node {
   void *data;
   struct ds_bst_node *left;
   struct ds_bst_node *right;
-} ds_bst_node_t;
+  struct ds_bst_node *parent;   // NULL for the root; lets iterators walk without a stack
+  size_t count;                 // Nodes in this subtree, for rank/select
+};
 
 struct ds_bst {
   ds_bst_node_t *root;
   size_t size;
   ds_compare_f compare;
+  ds_pool_t *pool;        // Node pool, NULL if nodes are allocated one by one
+  ds_allocator_t alloc;
+  DS_STATS_FIELD
 };
 
 /**
  * @brief Create a standalone node (not attached to tree yet).
  */
-static ds_bst_node_t *ds_bst_node_create(void *data) {
+static ds_bst_node_t *ds_bst_node_create(ds_bst_t *bst, void *data, ds_bst_node_t *parent) {
   if (!data) return NULL;
 
-  ds_bst_node_t *node = malloc(sizeof(ds_bst_node_t));
+  ds_bst_node_t *node = bst->pool
+                        ? ds_pool_alloc(bst->pool)
+                        : ds_mem_alloc(&bst->alloc, sizeof(ds_bst_node_t));
   if (!node) return NULL;
 
   node->data = data;
   node->left = NULL;
   node->right = NULL;
+  node->parent = parent;
+  node->count = 1;
 
   return node;
 }
 
+/**
+ * @brief Number of nodes in a subtree (0 for NULL).
+ */
+static inline size_t node_count(const ds_bst_node_t *node) {
+  return node ? node->count : 0;
+}
+
+/**
+ * @brief Release a node to wherever it came from.
+ */
+static void ds_bst_node_free(ds_bst_t *bst, ds_bst_node_t *node) {
+  if (bst->pool) ds_pool_free(bst->pool, node);
+  else ds_mem_free(&bst->alloc, node, sizeof(ds_bst_node_t));
+}
+
 /**
  * @brief Create a new binary search tree.
  *
@@ -43,15 +70,129 @@ static ds_bst_node_t *ds_bst_node_create(void *data) {
  * @return Pointer to a new BST on success, or NULL on failure.
  */
 ds_bst_t *ds_bst_create(ds_compare_f compare) {
+  return ds_bst_create_ex(compare, NULL);
+}
+
+/**
+ * @brief Create a new binary search tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure.
+ */
+ds_bst_t *ds_bst_create_ex(ds_compare_f compare, const ds_allocator_t *allocator) {
   // Check input parameters
   if (!compare) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
 
-  ds_bst_t *bst = malloc(sizeof(ds_bst_t));
+  ds_bst_t *bst = ds_mem_alloc(allocator, sizeof(ds_bst_t));
   if (!bst) return NULL;
 
+  bst->alloc = *allocator;
+  DS_STATS_ATTACH(bst, "ds_bst", &bst->alloc);
+
   bst->root = NULL;
   bst->size = 0;
   bst->compare = compare;
+  bst->pool = NULL;
+
+  return bst;
+}
+
+/**
+ * @brief Create a new binary search tree whose nodes come from a node pool.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure.
+ */
+ds_bst_t *ds_bst_create_pooled(ds_compare_f compare, size_t slab_hint) {
+  return ds_bst_create_pooled_ex(compare, slab_hint, NULL);
+}
+
+/**
+ * @brief Create a pooled binary search tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the tree and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new BST on success, or NULL on failure.
+ */
+ds_bst_t *ds_bst_create_pooled_ex(ds_compare_f compare, size_t slab_hint, const ds_allocator_t *allocator) {
+  ds_bst_t *bst = ds_bst_create_ex(compare, allocator);
+  if (!bst) return NULL;
+
+  bst->pool = ds_pool_create_ex(sizeof(ds_bst_node_t), slab_hint, &bst->alloc);
+  if (!bst->pool) {
+    DS_STATS_DETACH(bst, &bst->alloc);
+    ds_mem_free(&bst->alloc, bst, sizeof(ds_bst_t));
+    return NULL;
+  }
+
+  return bst;
+}
+
+/**
+ * @brief Link items[lo, hi) as a balanced subtree under `parent`.
+ *
+ * Recursion depth is the tree height, O(log n).
+ */
+static ds_bst_node_t *bst_build_sorted(ds_bst_t *bst, void *const *items, size_t lo, size_t hi,
+                                       ds_bst_node_t *parent, bool *ok) {
+  if (lo >= hi || !*ok) return NULL;
+
+  size_t mid = lo + (hi - lo) / 2;
+  ds_bst_node_t *node = ds_bst_node_create(bst, items[mid], parent);
+  if (!node) {
+    *ok = false;
+    return NULL;
+  }
+
+  // Each finished subtree is attached before its sibling is built, so on
+  // failure everything allocated so far is reachable for destroy
+  node->left = bst_build_sorted(bst, items, lo, mid, node, ok);
+  node->right = bst_build_sorted(bst, items, mid + 1, hi, node, ok);
+  node->count = 1 + node_count(node->left) + node_count(node->right);
+  bst->size ++;
+
+  return node;
+}
+
+/**
+ * @brief Build a balanced tree from elements in ascending order, in O(n).
+ */
+ds_bst_t *ds_bst_create_from_sorted(ds_compare_f compare, void *const *items, size_t n) {
+  return ds_bst_create_from_sorted_ex(compare, items, n, NULL);
+}
+
+/**
+ * @brief Build a balanced tree from sorted elements using a custom
+ *        allocator.
+ */
+ds_bst_t *ds_bst_create_from_sorted_ex(ds_compare_f compare, void *const *items, size_t n,
+                                       const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!compare || (n > 0 && !items)) return NULL;
+  for (size_t i = 0; i < n; ++ i) {
+    if (!items[i]) return NULL;
+    if (i > 0 && compare(items[i - 1], items[i]) >= 0) return NULL;
+  }
+
+  ds_bst_t *bst = ds_bst_create_ex(compare, allocator);
+  if (!bst) return NULL;
+
+  bool ok = true;
+  bst->root = bst_build_sorted(bst, items, 0, n, NULL, &ok);
+  if (!ok) {
+    ds_bst_destroy(bst, NULL);
+    return NULL;
+  }
 
   return bst;
 }
@@ -68,17 +209,20 @@ void ds_bst_destroy(ds_bst_t *bst, ds_free_f free_func) {
   // Check input parameters
   if (!bst) return;
 
-  if (!bst->root) {
-    free(bst);
+  // Pooled nodes without elements to free: drop the slabs in one go
+  if (!bst->root || (bst->pool && !free_func)) {
+    ds_pool_destroy(bst->pool);
+    DS_STATS_DETACH(bst, &bst->alloc);
+    ds_mem_free(&bst->alloc, bst, sizeof(ds_bst_t));
     return;
   }
 
   // Helper stack for traversal control
-  ds_stack_t *stack_traverse = ds_stack_create(bst->size);
+  ds_stack_t *stack_traverse = ds_stack_create_ex(bst->size, &bst->alloc);
   if (!stack_traverse) return;
 
   // Helper stack for Stores results
-  ds_stack_t *stack_store = ds_stack_create(bst->size);
+  ds_stack_t *stack_store = ds_stack_create_ex(bst->size, &bst->alloc);
   if (!stack_store) {
     ds_stack_destroy(stack_traverse, NULL);
     return;
@@ -106,12 +250,14 @@ void ds_bst_destroy(ds_bst_t *bst, ds_free_f free_func) {
   while (!ds_stack_is_empty(stack_store)) {
     ds_bst_node_t *tmp = ds_stack_pop(stack_store);
     if (free_func) free_func(tmp->data);
-    free(tmp);
+    ds_bst_node_free(bst, tmp);
   }
 
-  free(bst);
   ds_stack_destroy(stack_traverse, NULL);
   ds_stack_destroy(stack_store, NULL);
+  ds_pool_destroy(bst->pool);
+  DS_STATS_DETACH(bst, &bst->alloc);
+  ds_mem_free(&bst->alloc, bst, sizeof(ds_bst_t));
 }
 
 /**
@@ -123,6 +269,16 @@ size_t ds_bst_size(const ds_bst_t *bst) {
   return bst->size;
 }
 
+/**
+ * @brief Get the instrumentation counters (DS_ENABLE_STATS builds).
+ */
+ds_status_t ds_bst_stats(const ds_bst_t *bst, ds_stats_t *out) {
+  // Check input parameters
+  if (!bst || !out) return DS_ERR_NULL;
+
+  return DS_STATS_COPY(bst, out);
+}
+
 /**
  * @brief Insert a new element into the BST.
  *
@@ -141,11 +297,12 @@ ds_status_t ds_bst_insert(ds_bst_t *bst, void *data) {
 
   // Empty tree: new node becomes root
   if (!bst->root) {
-    ds_bst_node_t *node = ds_bst_node_create(data);
+    ds_bst_node_t *node = ds_bst_node_create(bst, data, NULL);
     if (!node) return DS_ERR_MEM;
 
     bst->root = node;
     bst->size ++;
+    DS_STATS_MAX(bst, max_depth, 1);
 
     return DS_OK;
   }
@@ -153,20 +310,25 @@ ds_status_t ds_bst_insert(ds_bst_t *bst, void *data) {
   // Locate the insertion point
   ds_bst_node_t **link = &bst->root;
   ds_bst_node_t *curr = NULL;
+  DS_STATS_ONLY(uint64_t depth = 1;)
 
   while (*link) {
     curr = *link;
+    DS_STATS_ADD(bst, comparisons, 1);
+    DS_STATS_ONLY(depth ++;)
     int cmp = bst->compare(data, curr->data);
     if (cmp < 0)      link = &curr->left;
     else if (cmp > 0) link = &curr->right;
     else return DS_ERR_EXIST;  // Duplicate key not allowed
   }
+  DS_STATS_MAX(bst, max_depth, depth);
 
-  ds_bst_node_t *node = ds_bst_node_create(data);
+  ds_bst_node_t *node = ds_bst_node_create(bst, data, curr);
   if (!node) return DS_ERR_MEM;
 
   // Insertion
   *link = node;
+  for (ds_bst_node_t *n = curr; n; n = n->parent) n->count ++;
 
   bst->size ++;
   return DS_OK;
@@ -184,8 +346,12 @@ void *ds_bst_search(const ds_bst_t *bst, const void *key) {
   // Check input parameters
   if (!bst || !bst->root || !key) return NULL;
 
+  // Counters are bookkeeping, not logical state
+  DS_STATS_ADD((ds_bst_t *)bst, searches, 1);
+
   const ds_bst_node_t *curr = bst->root;
   while (curr) {
+    DS_STATS_ADD((ds_bst_t *)bst, comparisons, 1);
     int cmp = bst->compare(key, curr->data);
     
     if (cmp < 0) {
@@ -224,6 +390,7 @@ ds_status_t ds_bst_remove(ds_bst_t *bst, const void *key, ds_free_f free_func) {
 
   while (*link) {
     curr = *link;
+    DS_STATS_ADD(bst, comparisons, 1);
     int cmp = bst->compare(key, curr->data);
     if (cmp < 0) link = &curr->left;
     else if (cmp > 0) link = &curr->right;
@@ -241,11 +408,13 @@ ds_status_t ds_bst_remove(ds_bst_t *bst, const void *key, ds_free_f free_func) {
   else if (curr->left && !curr->right) {
     // Replace the node to be deleted with the root node of its left subtree
     *link = curr->left;
+    curr->left->parent = curr->parent;
   }
   // Case 3: The node to delete has only a right subtree
   else if (!curr->left && curr->right) {
     // Replace the node to be deleted with the root node of its right subtree
     *link = curr->right;
+    curr->right->parent = curr->parent;
   }
   // Case 4: The node to be deleted has both a left subtree and a right subtree
   else {
@@ -262,16 +431,25 @@ ds_status_t ds_bst_remove(ds_bst_t *bst, const void *key, ds_free_f free_func) {
     // (if it did, that right child would be larger)
     // If it has a left child, that left child takes its place
     *pred_link = pred->left;
+    if (pred->left) pred->left->parent = pred->parent;
+    for (ds_bst_node_t *n = pred->parent; n != curr; n = n->parent) n->count --;
     
     // 3) Replace the node to be deleted with the maximum node
     *link = pred;
     pred->left = curr->left;
     pred->right = curr->right;
+    pred->parent = curr->parent;
+    pred->count = curr->count - 1;
+    if (pred->left) pred->left->parent = pred;
+    pred->right->parent = pred;
   }
 
+  // Every ancestor lost one node
+  for (ds_bst_node_t *n = curr->parent; n; n = n->parent) n->count --;
+
   // Free
   if (free_func) free_func(curr->data);
-  free(curr);
+  ds_bst_node_free(bst, curr);
 
   bst->size --;
 
@@ -334,3 +512,180 @@ void ds_bst_traverse_inorder(const ds_bst_t *bst, ds_visit_f visit) {
   inorder_node(bst->root, visit);
 }
 
+/**
+ * @brief Left-most node of a subtree.
+ */
+static ds_bst_node_t *subtree_min(ds_bst_node_t *node) {
+  while (node && node->left) node = node->left;
+  return node;
+}
+
+/**
+ * @brief Right-most node of a subtree.
+ */
+static ds_bst_node_t *subtree_max(ds_bst_node_t *node) {
+  while (node && node->right) node = node->right;
+  return node;
+}
+
+/**
+ * @brief Get an iterator pointing to the smallest element.
+ */
+ds_bst_iter_t ds_bst_iter_begin(const ds_bst_t *bst) {
+  if (!bst) return NULL;
+
+  return subtree_min(bst->root);
+}
+
+/**
+ * @brief Get an iterator pointing to the largest element.
+ */
+ds_bst_iter_t ds_bst_iter_last(const ds_bst_t *bst) {
+  if (!bst) return NULL;
+
+  return subtree_max(bst->root);
+}
+
+/**
+ * @brief Move to the in-order successor.
+ */
+ds_bst_iter_t ds_bst_iter_next(ds_bst_iter_t it) {
+  // Check input parameters
+  if (!it) return NULL;
+
+  // Successor is the left-most node of the right subtree, if any...
+  if (it->right) return subtree_min(it->right);
+
+  // ...otherwise the first ancestor we reach from its left side
+  while (it->parent && it == it->parent->right) it = it->parent;
+  return it->parent;
+}
+
+/**
+ * @brief Move to the in-order predecessor.
+ */
+ds_bst_iter_t ds_bst_iter_prev(ds_bst_iter_t it) {
+  // Check input parameters
+  if (!it) return NULL;
+
+  if (it->left) return subtree_max(it->left);
+
+  while (it->parent && it == it->parent->left) it = it->parent;
+  return it->parent;
+}
+
+/**
+ * @brief Get the data pointed to by the iterator.
+ */
+void *ds_bst_iter_get(ds_bst_iter_t it) {
+  if (!it) return NULL;
+
+  return it->data;
+}
+
+/**
+ * @brief First element that is not less than key (>= key).
+ */
+ds_bst_iter_t ds_bst_lower_bound(const ds_bst_t *bst, const void *key) {
+  // Check input parameters
+  if (!bst || !key) return NULL;
+
+  ds_bst_node_t *curr = bst->root;
+  ds_bst_node_t *result = NULL;
+
+  while (curr) {
+    if (bst->compare(curr->data, key) >= 0) {
+      result = curr;          // Candidate; a smaller one may be on the left
+      curr = curr->left;
+    } else {
+      curr = curr->right;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief First element that is greater than key (> key).
+ */
+ds_bst_iter_t ds_bst_upper_bound(const ds_bst_t *bst, const void *key) {
+  // Check input parameters
+  if (!bst || !key) return NULL;
+
+  ds_bst_node_t *curr = bst->root;
+  ds_bst_node_t *result = NULL;
+
+  while (curr) {
+    if (bst->compare(curr->data, key) > 0) {
+      result = curr;
+      curr = curr->left;
+    } else {
+      curr = curr->right;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Visit, in increasing order, every element in [lo, hi).
+ */
+size_t ds_bst_range(const ds_bst_t *bst, const void *lo, const void *hi, ds_visit_f visit) {
+  // Check input parameters
+  if (!bst || !lo || !hi || !visit) return 0;
+
+  size_t count = 0;
+  for (ds_bst_iter_t it = ds_bst_lower_bound(bst, lo);
+       it && bst->compare(it->data, hi) < 0;
+       it = ds_bst_iter_next(it)) {
+    visit(it->data);
+    count ++;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Get the k-th smallest element (0-based).
+ */
+void *ds_bst_select(const ds_bst_t *bst, size_t k) {
+  // Check input parameters
+  if (!bst || k >= bst->size) return NULL;
+
+  const ds_bst_node_t *curr = bst->root;
+  while (curr) {
+    size_t left = node_count(curr->left);
+    if (k < left) {
+      curr = curr->left;
+    } else if (k > left) {
+      k -= left + 1;
+      curr = curr->right;
+    } else {
+      return curr->data;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Count the elements that are less than key.
+ */
+size_t ds_bst_rank(const ds_bst_t *bst, const void *key) {
+  // Check input parameters
+  if (!bst || !key) return 0;
+
+  size_t rank = 0;
+  const ds_bst_node_t *curr = bst->root;
+  while (curr) {
+    int cmp = bst->compare(key, curr->data);
+    if (cmp <= 0) {
+      curr = curr->left;
+    } else {
+      rank += node_count(curr->left) + 1;
+      curr = curr->right;
+    }
+  }
+
+  return rank;
+}
@@ -1,8 +1,12 @@
 #include "ds_btree.h"
 #include "ds_common.h"
+#include "ds_pool.h"
 #include "ds_queue.h"
 #include "ds_stack.h"
+#include "ds_threadpool.h"
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 struct ds_btree_node {
@@ -14,107 +18,188 @@ struct ds_btree_node {
 struct ds_btree {
   ds_btree_node_t *root;
   size_t size;
+  ds_pool_t *pool;        // Node pool, NULL if nodes are allocated one by one
+  ds_btree_node_t *slab;  // Array written by ds_btree_compact(), or NULL
+  size_t slab_len;
+  ds_allocator_t alloc;
 };
 
+/**
+ * @brief Check whether a node lives in the compacted array.
+ */
+static inline bool in_slab(const ds_btree_t *tree, const ds_btree_node_t *node) {
+  return tree->slab && node >= tree->slab && node < tree->slab + tree->slab_len;
+}
+
+/**
+ * @brief Check whether nodes of `src` can be released by `dst`.
+ *
+ * Pooled and compacted nodes belong to their tree's own storage, and
+ * heap nodes must go back to the allocator they came from.
+ */
+static bool btree_nodes_compatible(const ds_btree_t *dst, const ds_btree_t *src) {
+  if (dst == src) return true;
+  if (dst->pool || src->pool || dst->slab || src->slab) return false;
+
+  return dst->alloc.free == src->alloc.free && dst->alloc.ctx == src->alloc.ctx;
+}
+
+/**
+ * @brief Release a node to wherever it came from.
+ *
+ * Nodes in the compacted array are released with the array itself.
+ */
+static void btree_node_free(ds_btree_t *tree, ds_btree_node_t *node) {
+  if (in_slab(tree, node)) return;
+
+  if (tree->pool) ds_pool_free(tree->pool, node);
+  else ds_mem_free(&tree->alloc, node, sizeof(ds_btree_node_t));
+}
+
+/**
+ * @brief Release the compacted array.
+ */
+static void btree_slab_free(ds_btree_t *tree) {
+  if (tree->slab) ds_mem_free(&tree->alloc, tree->slab, sizeof(ds_btree_node_t) * tree->slab_len);
+  tree->slab = NULL;
+  tree->slab_len = 0;
+}
+
 /**
  * @brief Create a binary tree.
  *
  * @return Pointer to a new binary tree on success, or NULL on failure.
  */
 ds_btree_t *ds_btree_create() {
-  ds_btree_t *tree = malloc(sizeof(ds_btree_t));
+  return ds_btree_create_ex(NULL);
+}
+
+/**
+ * @brief Create a binary tree using a custom allocator.
+ *
+ * @param allocator  Allocator for the tree and the nodes handed out by
+ *                   ds_btree_node_alloc(). It is copied. If NULL, the
+ *                   default allocator is used.
+ *
+ * @return Pointer to a new binary tree on success, or NULL on failure.
+ */
+ds_btree_t *ds_btree_create_ex(const ds_allocator_t *allocator) {
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_btree_t *tree = ds_mem_alloc(allocator, sizeof(ds_btree_t));
   if (!tree) return NULL;
 
+  tree->alloc = *allocator;
+
   tree->size = 0;
   tree->root = NULL;
+  tree->pool = NULL;
+  tree->slab = NULL;
+  tree->slab_len = 0;
 
   return tree;
 }
 
 /**
- * @brief Destroy a binary tree and optionally free its elements.
+ * @brief Create a binary tree whose nodes come from a node pool.
  *
- * Use ono-recursive (iterative) post-order traverse (dual-stack method)
- * Post-order sequence: Left -> Right -> Root
- * When reversed:       Left -> Right -> Root
- * Therefore, a dual-stack approach can be adopted:
- *  - First stack:  Used for traversal control (visiting in the reversed order: Root -> Right -> Left)
- *  - Second stack: Stores the "reversed visit sequence"
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
  *
- * @param tree       Pointer to the binary tree.
- * @param free_func  Optional element destructor.
- *                   - If non-NULL, it is called for each stored element.
- *                   - If NULL, only the binary tree itself is freed.
+ * @return Pointer to a new binary tree on success, or NULL on failure.
  */
-void ds_btree_destroy(ds_btree_t *tree, ds_free_f free_func) {
-  // Check input parameters
-  if (!tree) return;
-
-  if (!tree->root) {
-    free(tree);
-    return;
-  }
+ds_btree_t *ds_btree_create_pooled(size_t slab_hint) {
+  return ds_btree_create_pooled_ex(slab_hint, NULL);
+}
 
-  // Helper stack for traversal control
-  ds_stack_t *stack_traverse = ds_stack_create(tree->size);
-  if (!stack_traverse) return;
+/**
+ * @brief Create a pooled binary tree using a custom allocator.
+ *
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the tree and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new binary tree on success, or NULL on failure.
+ */
+ds_btree_t *ds_btree_create_pooled_ex(size_t slab_hint, const ds_allocator_t *allocator) {
+  ds_btree_t *tree = ds_btree_create_ex(allocator);
+  if (!tree) return NULL;
 
-  // Helper stack for Stores results
-  ds_stack_t *stack_store = ds_stack_create(tree->size);
-  if (!stack_store) {
-    ds_stack_destroy(stack_traverse, free_func);
-    return;
+  tree->pool = ds_pool_create_ex(sizeof(ds_btree_node_t), slab_hint, &tree->alloc);
+  if (!tree->pool) {
+    ds_mem_free(&tree->alloc, tree, sizeof(ds_btree_t));
+    return NULL;
   }
 
+  return tree;
+}
+
+/**
+ * @brief Free every node of the tree in O(n) time and O(1) extra space.
+ *
+ * Pointer-rotation teardown: while the current node has a left child,
+ * rotate that child up (right rotation), which moves one node from the
+ * left spine onto the right spine. Once there is no left child the node
+ * can be freed and we continue with its right child. Each node is
+ * rotated up at most once, so the total work is linear, and nothing is
+ * allocated -- the teardown cannot fail under memory pressure.
+ *
+ *       curr              l
+ *       /  \             / \
+ *      l    c    =>     a  curr
+ *     / \                  /  \
+ *    a   b                b    c
+ */
+static void btree_free_nodes(ds_btree_t *tree, ds_free_f free_func) {
   ds_btree_node_t *curr = tree->root;
-  
-  while (curr) {
-    ds_stack_push(stack_store, curr);
 
+  while (curr) {
     if (curr->left) {
-      ds_stack_push(stack_traverse, curr->left);
-    }
-
-    if (curr->right) {
-      curr = curr->right;
-    } else if (!ds_stack_is_empty(stack_traverse)) {
-      curr = ds_stack_pop(stack_traverse);
+      ds_btree_node_t *l = curr->left;
+      curr->left = l->right;
+      l->right = curr;
+      curr = l;
     } else {
-      break;
+      ds_btree_node_t *next = curr->right;
+      if (free_func) free_func(curr->data);
+      btree_node_free(tree, curr);
+      curr = next;
     }
   }
 
-  // Free nodes one by one
-  while (!ds_stack_is_empty(stack_store)) {
-    ds_btree_node_t *tmp = ds_stack_pop(stack_store);
-    if (free_func) free_func(tmp->data);
-    free(tmp);
+  tree->root = NULL;
+  tree->size = 0;
+}
+
+/**
+ * @brief Destroy a binary tree and optionally free its elements.
+ *
+ * Nodes are released by btree_free_nodes(), which needs no helper memory.
+ * Elements are passed to free_func in in-order sequence.
+ *
+ * @param tree       Pointer to the binary tree.
+ * @param free_func  Optional element destructor.
+ *                   - If non-NULL, it is called for each stored element.
+ *                   - If NULL, only the binary tree itself is freed.
+ */
+void ds_btree_destroy(ds_btree_t *tree, ds_free_f free_func) {
+  // Check input parameters
+  if (!tree) return;
+
+  // Pooled nodes without elements to free: drop the slabs in one go
+  if (tree->root && !(tree->pool && !free_func)) {
+    btree_free_nodes(tree, free_func);
   }
 
-  free(tree);
-  ds_stack_destroy(stack_traverse, NULL);
-  ds_stack_destroy(stack_store, NULL);
+  btree_slab_free(tree);
+  ds_pool_destroy(tree->pool);
+  ds_mem_free(&tree->alloc, tree, sizeof(ds_btree_t));
 }
 
 /**
  * @brief Clear all nodes but keep the tree object.
  *
- * Iterative post-order traversal (single stack + last_visited).
- *
- * Idea:
- *   Simulate recursive post-order without explicit state.
- *   The stack stores the path from root to current node.
- *
- *   last_visited records the most recently visited node.
- *   When examining the stack top `u`:
- *     - If u has a right child that has NOT been visited yet
- *       (last_visited != u->right), then descend into u->right.
- *     - Otherwise, both subtrees of u are finished (or absent),
- *       so u can be visited and popped from the stack.
- *
- *   In short:
- *     last_visited == u->right  => just returned from right subtree,
- *                                  safe to visit u (post-order).
+ * Same constant-space teardown as ds_btree_destroy().
  *
  * @param tree       Pointer to the list.
  * @param free_func  Optional element destructor.
@@ -126,37 +211,17 @@ void ds_btree_clear(ds_btree_t *tree, ds_free_f free_func) {
   // Check input parameters
   if (!tree || !tree->root) return;
 
-  // Helper stack
-  ds_stack_t *stack = ds_stack_create(tree->size);
-  if (!stack) return;
-
-  // Core: The node that was last fully visited 
-  ds_btree_node_t *last_visited = NULL;
-
-  ds_btree_node_t *curr = tree->root; 
-  do {
-    while (curr) {
-      ds_stack_push(stack, curr);
-      curr = curr->left;
-    }
-
-    ds_btree_node_t *peek = ds_stack_top(stack);
-    
-    // Right subtree incomplete, switching to process the right subtree
-    if (peek->right && last_visited != peek->right) {
-      curr = peek->right;
-    }
-    // Right subtree does not exist or has been processed, may proceed to access peek 
-    else if (!peek->right || (peek->right && last_visited == peek->right)) {
-      last_visited = ds_stack_pop(stack);
-      if (free_func) free_func(peek->data);
-      free(peek);
-    }
-  } while (!ds_stack_is_empty(stack));
+  // Pooled nodes without elements to free: recycle the slabs in one go
+  if (tree->pool && !free_func) {
+    ds_pool_reset(tree->pool);
+    btree_slab_free(tree);
+    tree->root = NULL;
+    tree->size = 0;
+    return;
+  }
 
-  ds_stack_destroy(stack, NULL);
-  tree->root = NULL;
-  tree->size = 0;
+  btree_free_nodes(tree, free_func);
+  btree_slab_free(tree);
 }
 
 /**
@@ -212,6 +277,25 @@ ds_btree_node_t *ds_btree_node_create(void *data) {
   return node;
 }
 
+/**
+ * @brief Create a standalone node owned by `tree` (not attached yet).
+ */
+ds_btree_node_t *ds_btree_node_alloc(ds_btree_t *tree, void *data) {
+  // Check input parameters
+  if (!tree || !data) return NULL;
+
+  ds_btree_node_t *node = tree->pool
+                          ? ds_pool_alloc(tree->pool)
+                          : ds_mem_alloc(&tree->alloc, sizeof(ds_btree_node_t));
+  if (!node) return NULL;
+
+  node->data = data;
+  node->left = NULL;
+  node->right = NULL;
+
+  return node;
+}
+
 /**
  * @brief Set the root of the tree. If root already exists, returns error. 
  */
@@ -289,6 +373,8 @@ ds_status_t ds_btree_attach_node_right(ds_btree_t *tree, ds_btree_node_t *parent
  *
  * The ownership of nodes in `subtree` is transferred to `tree`.
  * The `subtree` object becomes empty (root=NULL, size=0).
+ * Returns DS_ERR_ARG if either tree is pooled or compacted, or if their
+ * allocators differ: `tree` could not release the moved nodes.
  *
  * @param tree     The destination tree.
  * @param parent   Target node in the destination tree.
@@ -298,6 +384,7 @@ ds_status_t ds_btree_attach_tree_left(ds_btree_t *tree, ds_btree_node_t *parent,
   // Check input parameters
   if (!tree) return DS_ERR_NULL;
   if (!parent || !subtree) return DS_ERR_ARG;
+  if (!btree_nodes_compatible(tree, subtree)) return DS_ERR_ARG;
 
   // Empty tree, do nothing
   if (subtree->root == NULL) return DS_OK; 
@@ -318,6 +405,8 @@ ds_status_t ds_btree_attach_tree_left(ds_btree_t *tree, ds_btree_node_t *parent,
  *
  * The ownership of nodes in `subtree` is transferred to `tree`.
  * The `subtree` object becomes empty (root=NULL, size=0).
+ * Returns DS_ERR_ARG if either tree is pooled or compacted, or if their
+ * allocators differ: `tree` could not release the moved nodes.
  *
  * @param tree     The destination tree.
  * @param parent   Target node in the destination tree.
@@ -327,6 +416,7 @@ ds_status_t ds_btree_attach_tree_right(ds_btree_t *tree, ds_btree_node_t *parent
   // Check input parameters
   if (!tree) return DS_ERR_NULL;
   if (!parent || !subtree) return DS_ERR_ARG;
+  if (!btree_nodes_compatible(tree, subtree)) return DS_ERR_ARG;
 
   // Empty tree, do nothing
   if (subtree->root == NULL) return DS_OK; 
@@ -417,7 +507,7 @@ void ds_btree_traverse_preorder_iterative(const ds_btree_t *tree, ds_visit_f vis
   // Due to the LIFO nature of the stack, the right‑subtree node pushed later is guaranteed to be processed first.
 
   // Helper stack
-  ds_stack_t *stack = ds_stack_create(tree->size);
+  ds_stack_t *stack = ds_stack_create_ex(tree->size, &tree->alloc);
   if (!stack) return;
 
   // DFS preorder
@@ -470,7 +560,7 @@ void ds_btree_traverse_inorder_iterative(const ds_btree_t *tree, ds_visit_f visi
   if (!tree || !tree->root || !visit) return;
 
   // Helper stack
-  ds_stack_t *stack = ds_stack_create(tree->size);
+  ds_stack_t *stack = ds_stack_create_ex(tree->size, &tree->alloc);
   if (!stack)
     return;
 
@@ -499,6 +589,215 @@ void ds_btree_traverse_inorder_iterative(const ds_btree_t *tree, ds_visit_f visi
   ds_stack_destroy(stack, NULL);
 }
 
+/* -------------------------------------------------------------------------
+ * Morris traversals (threaded, O(1) extra space).
+ * -------------------------------------------------------------------------
+ *
+ * Instead of a stack, the right pointer of each node's in-order
+ * predecessor (the right-most node of its left subtree, where that
+ * pointer is always NULL) is temporarily pointed back at the node:
+ *
+ *   - First arrival at curr: no thread yet -> create it, go left.
+ *   - Second arrival (we came back through the thread): remove it,
+ *     go right.
+ *
+ * Every edge is walked at most three times, so both traversals are O(n)
+ * and allocate nothing. The tree is restored before returning.
+ */
+
+/**
+ * @brief Find curr's in-order predecessor, stopping at an existing thread.
+ */
+static ds_btree_node_t *morris_predecessor(ds_btree_node_t *curr) {
+  ds_btree_node_t *pred = curr->left;
+  while (pred->right && pred->right != curr) pred = pred->right;
+  return pred;
+}
+
+/**
+ * @brief Morris in-order walk of the subtree rooted at curr.
+ */
+static void morris_inorder(ds_btree_node_t *curr, ds_visit_f visit) {
+  while (curr) {
+    if (!curr->left) {
+      visit(curr->data);
+      curr = curr->right;
+      continue;
+    }
+
+    ds_btree_node_t *pred = morris_predecessor(curr);
+    if (!pred->right) {
+      pred->right = curr;             // Thread back to curr
+      curr = curr->left;
+    } else {
+      pred->right = NULL;             // Left subtree done: unthread
+      visit(curr->data);
+      curr = curr->right;
+    }
+  }
+}
+
+void ds_btree_traverse_inorder_morris(const ds_btree_t *tree, ds_visit_f visit) {
+  // Check input parameters
+  if (!tree || !tree->root || !visit) return;
+
+  morris_inorder(tree->root, visit);
+}
+
+void ds_btree_traverse_preorder_morris(const ds_btree_t *tree, ds_visit_f visit) {
+  // Check input parameters
+  if (!tree || !tree->root || !visit) return;
+
+  ds_btree_node_t *curr = tree->root;
+
+  while (curr) {
+    if (!curr->left) {
+      visit(curr->data);
+      curr = curr->right;
+      continue;
+    }
+
+    ds_btree_node_t *pred = morris_predecessor(curr);
+    if (!pred->right) {
+      visit(curr->data);              // Pre-order: visit on first arrival
+      pred->right = curr;
+      curr = curr->left;
+    } else {
+      pred->right = NULL;
+      curr = curr->right;
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------
+ * Compaction
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @brief Emit the van Emde Boas order of the part of `node`'s subtree that
+ *        lies less than `h` levels below it.
+ *
+ * Split the h levels into a top half and a bottom half, lay out the top
+ * recursively, then each bottom subtree recursively. The split depth
+ * halves at every level, so the recursion is only O(log h) deep.
+ * `depth` holds the absolute depth of every emitted node, which is how
+ * the roots of the bottom subtrees are found again.
+ */
+static void veb_layout(ds_btree_node_t *node, size_t d0, size_t h,
+                       ds_btree_node_t **order, size_t *depth, size_t *n) {
+  if (h == 1) {
+    order[*n] = node;
+    depth[(*n) ++] = d0;
+    return;
+  }
+
+  size_t top_h = h / 2;
+  size_t start = *n;
+  veb_layout(node, d0, top_h, order, depth, n);
+
+  size_t end = *n;
+  for (size_t i = start; i < end; ++ i) {
+    if (depth[i] != d0 + top_h - 1) continue;
+    ds_btree_node_t *children[2] = { order[i]->left, order[i]->right };
+    for (int c = 0; c < 2; ++ c) {
+      if (children[c]) veb_layout(children[c], d0 + top_h, h - top_h, order, depth, n);
+    }
+  }
+}
+
+/**
+ * @brief Relay out every node into one contiguous array.
+ */
+ds_status_t ds_btree_compact(ds_btree_t *tree, ds_btree_layout_t layout) {
+  // Check input parameters
+  if (!tree) return DS_ERR_NULL;
+  if (layout != DS_BTREE_LAYOUT_BFS && layout != DS_BTREE_LAYOUT_VEB) return DS_ERR_ARG;
+  if (!tree->root) return DS_OK;
+
+  // Count the nodes (tree->size is only a hint after some attach calls)
+  size_t n = 0;
+  for (ds_btree_node_t *curr = tree->root; curr; ) {
+    if (!curr->left) {
+      n ++;
+      curr = curr->right;
+      continue;
+    }
+    ds_btree_node_t *pred = morris_predecessor(curr);
+    if (!pred->right) {
+      pred->right = curr;
+      curr = curr->left;
+    } else {
+      pred->right = NULL;
+      n ++;
+      curr = curr->right;
+    }
+  }
+  if (n > SIZE_MAX / sizeof(ds_btree_node_t) || n > SIZE_MAX / sizeof(size_t)) return DS_ERR_MEM;
+
+  ds_btree_node_t **old = ds_mem_alloc(&tree->alloc, sizeof(ds_btree_node_t *) * n);
+  size_t *depth = ds_mem_alloc(&tree->alloc, sizeof(size_t) * n);
+  ds_btree_node_t *slab = ds_mem_alloc(&tree->alloc, sizeof(ds_btree_node_t) * n);
+  if (!old || !depth || !slab) {
+    if (old) ds_mem_free(&tree->alloc, old, sizeof(ds_btree_node_t *) * n);
+    if (depth) ds_mem_free(&tree->alloc, depth, sizeof(size_t) * n);
+    if (slab) ds_mem_free(&tree->alloc, slab, sizeof(ds_btree_node_t) * n);
+    return DS_ERR_MEM;
+  }
+
+  // BFS order, using `old` itself as the queue
+  size_t tail = 0;
+  old[tail] = tree->root;
+  depth[tail ++] = 0;
+  for (size_t head = 0; head < tail; ++ head) {
+    if (old[head]->left)  { old[tail] = old[head]->left;  depth[tail ++] = depth[head] + 1; }
+    if (old[head]->right) { old[tail] = old[head]->right; depth[tail ++] = depth[head] + 1; }
+  }
+
+  // vEB order needs the height, which is one more than the deepest BFS level
+  ds_btree_node_t **order = old;
+  ds_btree_node_t **veb = NULL;
+  if (layout == DS_BTREE_LAYOUT_VEB) {
+    veb = ds_mem_alloc(&tree->alloc, sizeof(ds_btree_node_t *) * n);
+    if (!veb) {
+      ds_mem_free(&tree->alloc, old, sizeof(ds_btree_node_t *) * n);
+      ds_mem_free(&tree->alloc, depth, sizeof(size_t) * n);
+      ds_mem_free(&tree->alloc, slab, sizeof(ds_btree_node_t) * n);
+      return DS_ERR_MEM;
+    }
+    size_t height = depth[n - 1] + 1;
+    size_t emitted = 0;
+    veb_layout(tree->root, 0, height, veb, depth, &emitted);
+    order = veb;
+  }
+
+  // Copy the payloads, leaving a forwarding pointer in each old node...
+  for (size_t i = 0; i < n; ++ i) {
+    slab[i].data = order[i]->data;
+    order[i]->data = &slab[i];
+  }
+  // ...so links can be translated
+  for (size_t i = 0; i < n; ++ i) {
+    slab[i].left  = order[i]->left  ? order[i]->left->data  : NULL;
+    slab[i].right = order[i]->right ? order[i]->right->data : NULL;
+  }
+
+  // Release the old nodes, then any previous compacted array
+  for (size_t i = 0; i < n; ++ i) btree_node_free(tree, old[i]);
+  btree_slab_free(tree);
+
+  tree->slab = slab;
+  tree->slab_len = n;
+  tree->root = &slab[0];
+  tree->size = n;
+
+  if (veb) ds_mem_free(&tree->alloc, veb, sizeof(ds_btree_node_t *) * n);
+  ds_mem_free(&tree->alloc, old, sizeof(ds_btree_node_t *) * n);
+  ds_mem_free(&tree->alloc, depth, sizeof(size_t) * n);
+
+  return DS_OK;
+}
+
 /* -------------------------------------------------------------------------
  * Traversal Post-order: Left -> Right -> Root.
  * -------------------------------------------------------------------------
@@ -543,7 +842,7 @@ void ds_btree_traverse_postorder_iterative(const ds_btree_t *tree, ds_visit_f vi
   if (!tree || !tree->root || !visit) return;
 
   // Helper stack
-  ds_stack_t *stack = ds_stack_create(tree->size);
+  ds_stack_t *stack = ds_stack_create_ex(tree->size, &tree->alloc);
   if (!stack) return;
 
   btree_post_frame_t *f_root = malloc(sizeof(btree_post_frame_t));
@@ -611,7 +910,7 @@ void ds_btree_traverse_levelorder(const ds_btree_t *tree, ds_visit_f visit) {
   if (!tree || !tree->root || !visit) return;
 
   // Helper queue
-  ds_queue_t *queue = ds_queue_create(tree->size);
+  ds_queue_t *queue = ds_queue_create_ex(tree->size, &tree->alloc);
   if (!queue) return;
 
   ds_queue_push(queue, tree->root);
@@ -626,3 +925,248 @@ void ds_btree_traverse_levelorder(const ds_btree_t *tree, ds_visit_f visit) {
 
   ds_queue_destroy(queue, NULL);
 }
+
+/* -------------------------------------------------------------------------
+ * Parallel traversal / map-reduce.
+ * -------------------------------------------------------------------------
+ *
+ * Split the tree at a cutoff depth:
+ *
+ *   depth < cutoff    "top" nodes, handled by the calling thread
+ *   depth == cutoff   frontier: one pool task per subtree
+ *
+ * Each task walks its subtree with the Morris in-order walk, so tasks
+ * need no stack and only ever touch pointers inside their own subtree.
+ * The cutoff gives about four tasks per thread on a balanced tree.
+ */
+
+typedef struct {
+  ds_btree_node_t *root;            // Frontier subtree
+  ds_visit_f visit;                 // for_each
+  ds_btree_map_f map;               // map_reduce
+  ds_btree_combine_f combine;
+  void *ctx;
+  void *result;                     // Fold of the subtree (map_reduce)
+} btree_task_t;
+
+/**
+ * @brief Depth at which subtrees become tasks: log2(threads) + 2.
+ */
+static size_t parallel_cutoff(size_t threads) {
+  size_t depth = 2;
+  while (threads > 1) {
+    threads >>= 1;
+    depth ++;
+  }
+  return depth;
+}
+
+/**
+ * @brief Count (tasks == NULL) or record the frontier subtrees in
+ *        in-order sequence.
+ */
+static size_t collect_frontier(ds_btree_node_t *node, size_t depth, size_t cutoff,
+                               btree_task_t *tasks, size_t n) {
+  if (!node) return n;
+
+  if (depth == cutoff) {
+    if (tasks) tasks[n].root = node;
+    return n + 1;
+  }
+
+  n = collect_frontier(node->left, depth + 1, cutoff, tasks, n);
+  return collect_frontier(node->right, depth + 1, cutoff, tasks, n);
+}
+
+/**
+ * @brief In-order fold of a subtree with the Morris walk.
+ *
+ * @return false if the subtree is empty (no result).
+ */
+static bool morris_fold(ds_btree_node_t *curr, ds_btree_map_f map, ds_btree_combine_f combine,
+                        void *ctx, void **out) {
+  bool have = false;
+  void *acc = NULL;
+
+  while (curr) {
+    ds_btree_node_t *visit_node = NULL;
+
+    if (!curr->left) {
+      visit_node = curr;
+      curr = curr->right;
+    } else {
+      ds_btree_node_t *pred = morris_predecessor(curr);
+      if (!pred->right) {
+        pred->right = curr;
+        curr = curr->left;
+      } else {
+        pred->right = NULL;
+        visit_node = curr;
+        curr = curr->right;
+      }
+    }
+
+    if (visit_node) {
+      void *v = map(visit_node->data, ctx);
+      acc = have ? combine(acc, v, ctx) : v;
+      have = true;
+    }
+  }
+
+  *out = acc;
+  return have;
+}
+
+static void for_each_task(void *arg) {
+  btree_task_t *task = arg;
+  morris_inorder(task->root, task->visit);
+}
+
+static void map_reduce_task(void *arg) {
+  btree_task_t *task = arg;
+  morris_fold(task->root, task->map, task->combine, task->ctx, &task->result);
+}
+
+/**
+ * @brief Visit the top nodes (depth < cutoff) from the calling thread.
+ */
+static void for_each_top(ds_btree_node_t *node, size_t depth, size_t cutoff, ds_visit_f visit) {
+  if (!node || depth == cutoff) return;
+
+  for_each_top(node->left, depth + 1, cutoff, visit);
+  visit(node->data);
+  for_each_top(node->right, depth + 1, cutoff, visit);
+}
+
+/**
+ * @brief Fold the top nodes together with the finished frontier results:
+ *        fold(left) . map(node) . fold(right).
+ *
+ * Frontier results are taken from `tasks` in the order collect_frontier()
+ * recorded them, which is the same in-order walk.
+ */
+static bool map_reduce_top(ds_btree_node_t *node, size_t depth, size_t cutoff,
+                           const btree_task_t *tasks, size_t *next,
+                           ds_btree_map_f map, ds_btree_combine_f combine, void *ctx, void **out) {
+  if (!node) return false;
+
+  if (depth == cutoff) {
+    const btree_task_t *task = &tasks[(*next) ++];
+    *out = task->result;
+    return true;      // A frontier subtree is never empty
+  }
+
+  void *left = NULL, *right = NULL;
+  bool have_left = map_reduce_top(node->left, depth + 1, cutoff, tasks, next, map, combine, ctx, &left);
+  void *acc = map(node->data, ctx);
+  if (have_left) acc = combine(left, acc, ctx);
+  if (map_reduce_top(node->right, depth + 1, cutoff, tasks, next, map, combine, ctx, &right)) {
+    acc = combine(acc, right, ctx);
+  }
+
+  *out = acc;
+  return true;
+}
+
+/**
+ * @brief Start a pool and lay out the frontier tasks.
+ *
+ * @return The number of tasks, with *pool and *tasks set; 0 with both
+ *         NULL if the tree should be walked sequentially instead.
+ */
+static size_t parallel_setup(const ds_btree_t *tree, size_t nthreads, size_t *cutoff,
+                             ds_threadpool_t **pool, btree_task_t **tasks) {
+  *pool = NULL;
+  *tasks = NULL;
+  if (nthreads == 1) return 0;
+
+  // Workers free their tasks: the tree's allocator stays on this thread
+  *pool = ds_threadpool_create(nthreads);
+  if (!*pool) return 0;
+
+  *cutoff = parallel_cutoff(ds_threadpool_size(*pool));
+  size_t n = collect_frontier(tree->root, 0, *cutoff, NULL, 0);
+  if (n > 0) *tasks = ds_mem_alloc(&tree->alloc, sizeof(btree_task_t) * n);
+  if (!*tasks) {
+    ds_threadpool_destroy(*pool);
+    *pool = NULL;
+    return 0;
+  }
+
+  collect_frontier(tree->root, 0, *cutoff, *tasks, 0);
+  return n;
+}
+
+/**
+ * @brief Visit every element once, from several threads.
+ */
+ds_status_t ds_btree_parallel_for_each(const ds_btree_t *tree, ds_visit_f visit, size_t nthreads) {
+  // Check input parameters
+  if (!tree) return DS_ERR_NULL;
+  if (!visit) return DS_ERR_ARG;
+  if (!tree->root) return DS_OK;
+
+  size_t cutoff = 0;
+  ds_threadpool_t *pool;
+  btree_task_t *tasks;
+  size_t n = parallel_setup(tree, nthreads, &cutoff, &pool, &tasks);
+
+  // Single thread requested, or no resources for threads: walk in place
+  if (n == 0) {
+    morris_inorder(tree->root, visit);
+    return DS_OK;
+  }
+
+  for (size_t i = 0; i < n; ++ i) {
+    tasks[i].visit = visit;
+    if (ds_threadpool_submit(pool, for_each_task, &tasks[i]) != DS_OK) for_each_task(&tasks[i]);
+  }
+
+  // The top of the tree is visited here while the pool works below it
+  for_each_top(tree->root, 0, cutoff, visit);
+
+  ds_threadpool_wait(pool);
+  ds_threadpool_destroy(pool);
+  ds_mem_free(&tree->alloc, tasks, sizeof(btree_task_t) * n);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Map every element and combine the results, from several threads.
+ */
+ds_status_t ds_btree_parallel_map_reduce(const ds_btree_t *tree, ds_btree_map_f map,
+                                         ds_btree_combine_f combine, void *ctx,
+                                         size_t nthreads, void **out) {
+  // Check input parameters
+  if (!tree || !out) return DS_ERR_NULL;
+  if (!map || !combine) return DS_ERR_ARG;
+  if (!tree->root) return DS_ERR_EMPTY;
+
+  size_t cutoff = 0;
+  ds_threadpool_t *pool;
+  btree_task_t *tasks;
+  size_t n = parallel_setup(tree, nthreads, &cutoff, &pool, &tasks);
+
+  if (n == 0) {
+    morris_fold(tree->root, map, combine, ctx, out);
+    return DS_OK;
+  }
+
+  for (size_t i = 0; i < n; ++ i) {
+    tasks[i].map = map;
+    tasks[i].combine = combine;
+    tasks[i].ctx = ctx;
+    if (ds_threadpool_submit(pool, map_reduce_task, &tasks[i]) != DS_OK) map_reduce_task(&tasks[i]);
+  }
+
+  ds_threadpool_wait(pool);
+
+  size_t next = 0;
+  map_reduce_top(tree->root, 0, cutoff, tasks, &next, map, combine, ctx, out);
+
+  ds_threadpool_destroy(pool);
+  ds_mem_free(&tree->alloc, tasks, sizeof(btree_task_t) * n);
+
+  return DS_OK;
+}
@@ -0,0 +1,420 @@
+/*
+** src/ds_cmap.c -- Implementation of the concurrent skip list map.
+*/
+
+#include "ds_cmap.h"
+#include "ds_common.h"
+#include "ds_ebr.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CMAP_MAX_LEVEL      32
+#define CMAP_COLLECT_EVERY  64    // Removals between automatic collections
+
+/*
+ * A node with `level` links; level 1 is the full, ordered list. The head
+ * is a node with CMAP_MAX_LEVEL links and no element.
+ */
+typedef struct cmap_node {
+  ds_ebr_node_t ebr;              // Retire link, unused while linked
+  void *element;
+  unsigned level;
+  _Atomic(struct cmap_node *) next[];
+} cmap_node_t;
+
+struct ds_cmap {
+  cmap_node_t *head;
+  _Atomic unsigned level;         // Highest level in use; a hint for readers
+  atomic_size_t size;
+  ds_compare_f compare;
+  ds_free_f free_func;
+
+  pthread_mutex_t lock;           // Writers and node (de)allocation
+  uint64_t rng;                   // Level generator state, under `lock`
+  size_t retired;                 // Removals since the last collection
+
+  ds_ebr_t *ebr;
+  ds_allocator_t alloc;
+};
+
+/**
+ * @brief Bytes for a node with `level` links.
+ */
+static inline size_t cmap_node_bytes(unsigned level) {
+  return sizeof(cmap_node_t) + (size_t)level * sizeof(_Atomic(cmap_node_t *));
+}
+
+/**
+ * @brief Level of a new node: each extra level with probability 1/4.
+ */
+static unsigned cmap_random_level(ds_cmap_t *map) {
+  // xorshift64
+  uint64_t x = map->rng;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  map->rng = x;
+
+  unsigned level = 1;
+  while ((x & 3) == 0 && level < CMAP_MAX_LEVEL) {
+    level ++;
+    x >>= 2;
+  }
+
+  return level;
+}
+
+/**
+ * @brief Reader-side search: the first node whose element is not less
+ *        than `key`, or NULL.
+ */
+static cmap_node_t *cmap_find_ge(const ds_cmap_t *map, const void *key) {
+  cmap_node_t *x = map->head;
+  cmap_node_t *nx = NULL;
+  unsigned level = atomic_load_explicit(&((ds_cmap_t *)map)->level, memory_order_relaxed);
+
+  for (unsigned i = level; i -- > 0; ) {
+    while ((nx = atomic_load_explicit(&x->next[i], memory_order_acquire))
+           && map->compare(key, nx->element) > 0) {
+      x = nx;
+    }
+  }
+
+  // The node that stopped the level-1 walk, not a reload of x's link: a
+  // smaller key may have been inserted after x since
+  return nx;
+}
+
+/**
+ * @brief Writer-side search: fill preds[i] with the last node before
+ *        `key` on every level. Called with the lock held.
+ */
+static void cmap_find_preds(ds_cmap_t *map, const void *key, cmap_node_t **preds) {
+  cmap_node_t *x = map->head;
+
+  for (unsigned i = CMAP_MAX_LEVEL; i -- > 0; ) {
+    cmap_node_t *nx;
+    while ((nx = atomic_load_explicit(&x->next[i], memory_order_relaxed))
+           && map->compare(key, nx->element) > 0) {
+      x = nx;
+    }
+    preds[i] = x;
+  }
+}
+
+/**
+ * @brief Reclaim callback: the grace period of a removed node is over.
+ */
+static void cmap_reclaim(ds_ebr_node_t *link, void *ctx) {
+  ds_cmap_t *map = ctx;
+  cmap_node_t *node = DS_CONTAINER_OF(link, cmap_node_t, ebr);
+
+  if (map->free_func) map->free_func(node->element);
+
+  pthread_mutex_lock(&map->lock);
+  ds_mem_free(&map->alloc, node, cmap_node_bytes(node->level));
+  pthread_mutex_unlock(&map->lock);
+}
+
+/**
+ * @brief Create a new concurrent map.
+ */
+ds_cmap_t *ds_cmap_create(ds_compare_f compare, ds_free_f free_func) {
+  return ds_cmap_create_ex(compare, free_func, NULL);
+}
+
+/**
+ * @brief Create a new concurrent map using a custom allocator.
+ */
+ds_cmap_t *ds_cmap_create_ex(ds_compare_f compare, ds_free_f free_func, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!compare) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_cmap_t *map = ds_mem_alloc(allocator, sizeof(ds_cmap_t));
+  if (!map) return NULL;
+
+  map->alloc = *allocator;
+  map->head = ds_mem_alloc(&map->alloc, cmap_node_bytes(CMAP_MAX_LEVEL));
+  map->ebr = ds_ebr_create_ex(&map->alloc);
+  if (!map->head || !map->ebr) {
+    ds_ebr_destroy(map->ebr);
+    ds_mem_free(&map->alloc, map->head, cmap_node_bytes(CMAP_MAX_LEVEL));
+    ds_mem_free(allocator, map, sizeof(ds_cmap_t));
+    return NULL;
+  }
+
+  map->head->element = NULL;
+  map->head->level = CMAP_MAX_LEVEL;
+  for (unsigned i = 0; i < CMAP_MAX_LEVEL; ++ i) atomic_init(&map->head->next[i], NULL);
+
+  atomic_init(&map->level, 1);
+  atomic_init(&map->size, 0);
+  map->compare = compare;
+  map->free_func = free_func;
+  pthread_mutex_init(&map->lock, NULL);
+  map->rng = (uint64_t)(uintptr_t)map ^ UINT64_C(0x9E3779B97F4A7C15);
+  map->retired = 0;
+
+  return map;
+}
+
+/**
+ * @brief Destroy a map, freeing every element.
+ */
+void ds_cmap_destroy(ds_cmap_t *map) {
+  // Check input parameters
+  if (!map) return;
+
+  // Live nodes first; no reader remains, so no grace period is needed
+  cmap_node_t *x = atomic_load_explicit(&map->head->next[0], memory_order_relaxed);
+  while (x) {
+    cmap_node_t *next = atomic_load_explicit(&x->next[0], memory_order_relaxed);
+    if (map->free_func) map->free_func(x->element);
+    ds_mem_free(&map->alloc, x, cmap_node_bytes(x->level));
+    x = next;
+  }
+
+  // Then the retired ones, through cmap_reclaim() (which takes the lock)
+  ds_ebr_destroy(map->ebr);
+
+  pthread_mutex_destroy(&map->lock);
+  ds_mem_free(&map->alloc, map->head, cmap_node_bytes(CMAP_MAX_LEVEL));
+  ds_allocator_t alloc = map->alloc;
+  ds_mem_free(&alloc, map, sizeof(ds_cmap_t));
+}
+
+/**
+ * @brief Register the calling thread as a reader.
+ */
+ds_ebr_thread_t *ds_cmap_register(ds_cmap_t *map) {
+  if (!map) return NULL;
+
+  // The record comes from the map's allocator: serialize with writers
+  pthread_mutex_lock(&map->lock);
+  ds_ebr_thread_t *th = ds_ebr_register(map->ebr);
+  pthread_mutex_unlock(&map->lock);
+
+  return th;
+}
+
+/**
+ * @brief Unregister a reader record.
+ */
+void ds_cmap_unregister(ds_cmap_t *map, ds_ebr_thread_t *th) {
+  if (!map) return;
+
+  pthread_mutex_lock(&map->lock);
+  ds_ebr_unregister(th);
+  pthread_mutex_unlock(&map->lock);
+}
+
+/**
+ * @brief Get a snapshot of the number of elements.
+ */
+size_t ds_cmap_size(const ds_cmap_t *map) {
+  if (!map) return 0;
+
+  return atomic_load_explicit(&((ds_cmap_t *)map)->size, memory_order_relaxed);
+}
+
+/**
+ * @brief Insert an element.
+ */
+ds_status_t ds_cmap_insert(ds_cmap_t *map, void *element) {
+  // Check input parameters
+  if (!map) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  cmap_node_t *preds[CMAP_MAX_LEVEL];
+
+  pthread_mutex_lock(&map->lock);
+  cmap_find_preds(map, element, preds);
+
+  cmap_node_t *succ = atomic_load_explicit(&preds[0]->next[0], memory_order_relaxed);
+  if (succ && map->compare(element, succ->element) == 0) {
+    pthread_mutex_unlock(&map->lock);
+    return DS_ERR_EXIST;  // Duplicate key not allowed
+  }
+
+  unsigned level = cmap_random_level(map);
+  cmap_node_t *node = ds_mem_alloc(&map->alloc, cmap_node_bytes(level));
+  if (!node) {
+    pthread_mutex_unlock(&map->lock);
+    return DS_ERR_MEM;
+  }
+
+  // Fully initialize the node before any reader can reach it
+  node->element = element;
+  node->level = level;
+  for (unsigned i = 0; i < level; ++ i) {
+    atomic_init(&node->next[i], atomic_load_explicit(&preds[i]->next[i], memory_order_relaxed));
+  }
+
+  if (level > atomic_load_explicit(&map->level, memory_order_relaxed)) {
+    atomic_store_explicit(&map->level, level, memory_order_relaxed);
+  }
+
+  // Publish bottom-up: once a reader sees the node on any level, it is
+  // already on every level below
+  for (unsigned i = 0; i < level; ++ i) {
+    atomic_store_explicit(&preds[i]->next[i], node, memory_order_release);
+  }
+
+  atomic_fetch_add_explicit(&map->size, 1, memory_order_relaxed);
+  pthread_mutex_unlock(&map->lock);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove the element equal to `key`.
+ */
+ds_status_t ds_cmap_remove(ds_cmap_t *map, const void *key) {
+  // Check input parameters
+  if (!map) return DS_ERR_NULL;
+  if (!key) return DS_ERR_ARG;
+
+  cmap_node_t *preds[CMAP_MAX_LEVEL];
+
+  pthread_mutex_lock(&map->lock);
+  cmap_find_preds(map, key, preds);
+
+  cmap_node_t *target = atomic_load_explicit(&preds[0]->next[0], memory_order_relaxed);
+  if (!target || map->compare(key, target->element) != 0) {
+    pthread_mutex_unlock(&map->lock);
+    return DS_ERR_NOT_FOUND;
+  }
+
+  // Unlink top-down; target keeps its own links for readers standing on it
+  for (unsigned i = target->level; i -- > 0; ) {
+    cmap_node_t *next = atomic_load_explicit(&target->next[i], memory_order_relaxed);
+    atomic_store_explicit(&preds[i]->next[i], next, memory_order_release);
+  }
+
+  unsigned level = atomic_load_explicit(&map->level, memory_order_relaxed);
+  while (level > 1 && !atomic_load_explicit(&map->head->next[level - 1], memory_order_relaxed)) level --;
+  atomic_store_explicit(&map->level, level, memory_order_relaxed);
+
+  atomic_fetch_sub_explicit(&map->size, 1, memory_order_relaxed);
+  ds_ebr_retire(map->ebr, &target->ebr, cmap_reclaim, map);
+
+  bool collect = ++ map->retired >= CMAP_COLLECT_EVERY;
+  if (collect) map->retired = 0;
+  pthread_mutex_unlock(&map->lock);
+
+  // Outside the lock: cmap_reclaim() takes it to free the nodes
+  if (collect) ds_ebr_collect(map->ebr);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove every element.
+ */
+void ds_cmap_clear(ds_cmap_t *map) {
+  // Check input parameters
+  if (!map) return;
+
+  // Detach the whole list at once, then retire its nodes one by one
+  pthread_mutex_lock(&map->lock);
+  cmap_node_t *x = atomic_load_explicit(&map->head->next[0], memory_order_relaxed);
+  for (unsigned i = CMAP_MAX_LEVEL; i -- > 0; ) {
+    atomic_store_explicit(&map->head->next[i], NULL, memory_order_release);
+  }
+  atomic_store_explicit(&map->level, 1, memory_order_relaxed);
+  atomic_store_explicit(&map->size, 0, memory_order_relaxed);
+  map->retired = 0;
+  pthread_mutex_unlock(&map->lock);
+
+  // Detached nodes are unreachable for writers, so no lock is needed
+  while (x) {
+    cmap_node_t *next = atomic_load_explicit(&x->next[0], memory_order_relaxed);
+    ds_ebr_retire(map->ebr, &x->ebr, cmap_reclaim, map);
+    x = next;
+  }
+
+  ds_ebr_collect(map->ebr);
+}
+
+/**
+ * @brief Find the element equal to `key`.
+ */
+void *ds_cmap_get(const ds_cmap_t *map, const void *key) {
+  // Check input parameters
+  if (!map || !key) return NULL;
+
+  cmap_node_t *node = cmap_find_ge(map, key);
+  if (!node || map->compare(key, node->element) != 0) return NULL;
+
+  return node->element;
+}
+
+/**
+ * @brief Check whether an element equal to `key` is present.
+ */
+bool ds_cmap_contains(const ds_cmap_t *map, const void *key) {
+  return ds_cmap_get(map, key) != NULL;
+}
+
+/**
+ * @brief Find the first element not less than `key`.
+ */
+void *ds_cmap_lower_bound(const ds_cmap_t *map, const void *key) {
+  // Check input parameters
+  if (!map || !key) return NULL;
+
+  cmap_node_t *node = cmap_find_ge(map, key);
+  return node ? node->element : NULL;
+}
+
+/**
+ * @brief Visit, in increasing order, the elements in [lo, hi).
+ */
+size_t ds_cmap_range(const ds_cmap_t *map, const void *lo, const void *hi, ds_visit_f visit) {
+  // Check input parameters
+  if (!map || !visit) return 0;
+
+  cmap_node_t *x = lo ? cmap_find_ge(map, lo)
+                      : atomic_load_explicit(&map->head->next[0], memory_order_acquire);
+
+  size_t n = 0;
+  while (x && (!hi || map->compare(hi, x->element) > 0)) {
+    visit(x->element);
+    n ++;
+    x = atomic_load_explicit(&x->next[0], memory_order_acquire);
+  }
+
+  return n;
+}
+
+/**
+ * @brief Reclaim removed elements whose grace period has passed.
+ */
+size_t ds_cmap_collect(ds_cmap_t *map) {
+  if (!map) return 0;
+
+  return ds_ebr_collect(map->ebr);
+}
+
+/**
+ * @brief Wait until every element removed so far has been reclaimed.
+ */
+size_t ds_cmap_synchronize(ds_cmap_t *map) {
+  if (!map) return 0;
+
+  return ds_ebr_synchronize(map->ebr);
+}
+
+/**
+ * @brief Get the number of removed elements not reclaimed yet.
+ */
+size_t ds_cmap_pending(const ds_cmap_t *map) {
+  if (!map) return 0;
+
+  return ds_ebr_pending(map->ebr);
+}
@@ -0,0 +1,152 @@
+/*
+** src/ds_common.c -- Shared runtime support: the default allocator, the
+**                    allocation helpers and the growth policy helpers
+**                    used by every container.
+*/
+
+#include "ds_common.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void *default_alloc(void *ctx, size_t size) {
+  (void) ctx;
+  return malloc(size);
+}
+
+static void *default_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  (void) ctx;
+  (void) old_size;
+  return realloc(ptr, new_size);
+}
+
+static void default_free(void *ctx, void *ptr, size_t size) {
+  (void) ctx;
+  (void) size;
+  free(ptr);
+}
+
+static const ds_allocator_t g_default_allocator = {
+  .alloc   = default_alloc,
+  .realloc = default_realloc,
+  .free    = default_free,
+  .ctx     = NULL,
+};
+
+/**
+ * @brief Get the default allocator (malloc / realloc / free).
+ */
+const ds_allocator_t *ds_allocator_default(void) {
+  return &g_default_allocator;
+}
+
+/**
+ * @brief Allocate `size` bytes through an allocator.
+ */
+void *ds_mem_alloc(const ds_allocator_t *allocator, size_t size) {
+  if (!allocator) allocator = &g_default_allocator;
+
+  return allocator->alloc(allocator->ctx, size);
+}
+
+/**
+ * @brief Resize a block through an allocator.
+ *
+ * Falls back to alloc + copy + free when the allocator has no realloc.
+ * On failure NULL is returned and the original block is left untouched.
+ */
+void *ds_mem_realloc(const ds_allocator_t *allocator, void *ptr, size_t old_size, size_t new_size) {
+  if (!allocator) allocator = &g_default_allocator;
+
+  if (allocator->realloc)
+    return allocator->realloc(allocator->ctx, ptr, old_size, new_size);
+
+  void *new_ptr = allocator->alloc(allocator->ctx, new_size);
+  if (!new_ptr) return NULL;
+
+  if (ptr) {
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    allocator->free(allocator->ctx, ptr, old_size);
+  }
+
+  return new_ptr;
+}
+
+/**
+ * @brief Release a block of `size` bytes through an allocator.
+ */
+void ds_mem_free(const ds_allocator_t *allocator, void *ptr, size_t size) {
+  if (!ptr) return;
+  if (!allocator) allocator = &g_default_allocator;
+
+  allocator->free(allocator->ctx, ptr, size);
+}
+
+#define DS_GROWTH_DEFAULT_FACTOR       2.0
+#define DS_GROWTH_DEFAULT_MIN_CAPACITY 16
+
+static const ds_growth_policy_t g_default_policy = {
+  .growth_factor = DS_GROWTH_DEFAULT_FACTOR,
+  .max_step      = 0,
+  .shrink_ratio  = 0.0,
+  .min_capacity  = DS_GROWTH_DEFAULT_MIN_CAPACITY,
+};
+
+/**
+ * @brief Get the default growth policy (2x growth, no automatic shrink).
+ */
+const ds_growth_policy_t *ds_growth_policy_default(void) {
+  return &g_default_policy;
+}
+
+/**
+ * @brief Check that every field of a growth policy is in range.
+ */
+bool ds_growth_policy_is_valid(const ds_growth_policy_t *policy) {
+  if (!policy) return false;
+
+  return policy->growth_factor > 1.0
+      && policy->shrink_ratio >= 0.0
+      && policy->shrink_ratio < 0.5;
+}
+
+/**
+ * @brief Capacity to grow to so that at least `needed` slots fit.
+ *
+ * @return The new capacity (>= needed), or 0 on overflow.
+ */
+size_t ds_growth_next_capacity(const ds_growth_policy_t *policy, size_t capacity, size_t needed) {
+  if (!policy) policy = &g_default_policy;
+  if (needed <= capacity) return capacity;
+
+  // Geometric step, saturated instead of overflowing
+  double scaled = (double)capacity * policy->growth_factor;
+  size_t grown = scaled >= (double)SIZE_MAX ? SIZE_MAX : (size_t)scaled;
+  if (grown <= capacity) grown = capacity == SIZE_MAX ? 0 : capacity + 1;
+  if (grown == 0) return 0;
+
+  // Bounded step
+  if (policy->max_step > 0 && grown - capacity > policy->max_step)
+    grown = capacity + policy->max_step;
+
+  return grown < needed ? needed : grown;
+}
+
+/**
+ * @brief Capacity to shrink to after a removal.
+ *
+ * @return A capacity smaller than `capacity` if the policy asks for a
+ *         shrink, otherwise `capacity` itself.
+ */
+size_t ds_growth_shrink_capacity(const ds_growth_policy_t *policy, size_t size, size_t capacity) {
+  if (!policy) policy = &g_default_policy;
+  if (policy->shrink_ratio <= 0.0) return capacity;
+  if ((double)size >= (double)capacity * policy->shrink_ratio) return capacity;
+
+  size_t target = size > SIZE_MAX / 2 ? SIZE_MAX : size * 2;
+  if (target < policy->min_capacity) target = policy->min_capacity;
+  if (target == 0) target = 1;
+
+  return target < capacity ? target : capacity;
+}
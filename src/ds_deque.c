@@ -1,11 +1,13 @@
 #include "ds_deque.h"
 #include "ds_common.h"
+#include "ds_deque_inline.h"
+#include "ds_stats.h"
 #include <inttypes.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #define DS_DEQUE_DEFAULT_CAPACITY 16
-#define DS_DEQUE_GROWTH_FACTOR     2
 
 /*
  * Next Index: (index + 1) % capacity
@@ -13,16 +15,6 @@
  * [head, tail)
  */
 
-struct ds_deque {
-  void **items;     // A dynamic array
-  size_t capacity;  // Total capacity of array
-  size_t size;      // Number of the current array
-
-  size_t head;      // Points to the first valid element
-  size_t tail;      // Points to the next writable position 
-                    // (one past the tail element)
-};
-
 /*
  * @brief Helper inline function for getting the next index in a circular buffer.
  */
@@ -38,18 +30,18 @@ static inline size_t prev_idx(size_t i, size_t cap) {
 }
 
 /**
- * @brief Expand the capacity of the deque.
+ * @brief Change the capacity of the deque (new_capacity >= size).
  * Allocate a new array and copy the data linearly into it, 
- * then reset head=0 and tail=size
+ * then reset head=0 and tail=size (mod capacity)
  */
-static ds_status_t ds_deque_grow(ds_deque_t *deque) {
+static ds_status_t ds_deque_resize(ds_deque_t *deque, size_t new_capacity) {
   // 1. Allocate a new array
-  size_t new_capacity = deque->capacity * DS_DEQUE_GROWTH_FACTOR;
   // Check overflow
-  if (new_capacity < deque->capacity) 
+  if (new_capacity > SIZE_MAX / sizeof(void *))
     return DS_ERR_MEM;
 
-  void **new_items = malloc(sizeof(void *) * new_capacity);
+  DS_STATS_TIMER(start);
+  void **new_items = ds_mem_alloc(&deque->alloc, sizeof(void *) * new_capacity);
   if (!new_items) 
     return DS_ERR_MEM;
 
@@ -61,15 +53,37 @@ static ds_status_t ds_deque_grow(ds_deque_t *deque) {
   }
 
   // 3. Reset head and tail
-  free(deque->items);
+  ds_mem_free(&deque->alloc, deque->items, sizeof(void *) * deque->capacity);
   deque->items = new_items;
   deque->capacity = new_capacity;
   deque->head = 0;
-  deque->tail = deque->size;
+  deque->tail = deque->size == new_capacity ? 0 : deque->size;
+  DS_STATS_RESIZE_DONE(deque, start);
 
   return DS_OK;
 }
 
+/**
+ * @brief Expand the capacity of the deque, as the growth policy says.
+ */
+static ds_status_t ds_deque_grow(ds_deque_t *deque) {
+  size_t new_capacity = ds_growth_next_capacity(&deque->policy, deque->capacity, deque->capacity + 1);
+  if (new_capacity == 0)
+    return DS_ERR_MEM;
+
+  return ds_deque_resize(deque, new_capacity);
+}
+
+/**
+ * @brief Give memory back after a removal, if the growth policy asks to.
+ *
+ * A failed shrink is harmless: the deque simply keeps its capacity.
+ */
+static void ds_deque_maybe_shrink(ds_deque_t *deque) {
+  size_t new_capacity = ds_growth_shrink_capacity(&deque->policy, deque->size, deque->capacity);
+  if (new_capacity < deque->capacity) ds_deque_resize(deque, new_capacity);
+}
+
 /**
  * @brief Create a new dynamic deque.
  *
@@ -79,28 +93,78 @@ static ds_status_t ds_deque_grow(ds_deque_t *deque) {
  * @return Pointer to a new deque on success, or NULL on failure.
  */
 ds_deque_t *ds_deque_create(size_t capacity_hint) {
+  return ds_deque_create_ex(capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new dynamic deque using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the deque and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new deque on success, or NULL on failure.
+ */
+ds_deque_t *ds_deque_create_ex(size_t capacity_hint, const ds_allocator_t *allocator) {
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_deque_t *deque = ds_mem_alloc(allocator, sizeof(ds_deque_t));
+  if (!deque)
+    return NULL;
+
+  if (ds_deque_init(deque, capacity_hint, allocator) != DS_OK) {
+    ds_mem_free(allocator, deque, sizeof(ds_deque_t));
+    return NULL;
+  }
+
+  return deque;
+}
+
+/**
+ * @brief Initialize a deque in caller-provided memory.
+ *
+ * @param deque          Memory for the deque.
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the storage. It is copied. If NULL,
+ *                       the default allocator is used.
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_*      On failure.
+ */
+ds_status_t ds_deque_init(ds_deque_t *deque, size_t capacity_hint, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!deque) return DS_ERR_NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return DS_ERR_ARG;
+
   size_t capacity = capacity_hint == 0 
                     ? DS_DEQUE_DEFAULT_CAPACITY
                     : capacity_hint;
+  if (capacity > SIZE_MAX / sizeof(void *))
+    return DS_ERR_MEM;
 
-  ds_deque_t *deque = malloc(sizeof(ds_deque_t));
-  if (!deque)
-    return NULL;
+  deque->alloc = *allocator;
+  DS_STATS_ATTACH(deque, "ds_deque", &deque->alloc);
 
-  deque->items = malloc(sizeof(void *) * capacity);
+  deque->items = ds_mem_alloc(&deque->alloc, sizeof(void *) * capacity);
   if (!deque->items) {
-    free(deque);
-    return NULL;
+    DS_STATS_DETACH(deque, &deque->alloc);
+    return DS_ERR_MEM;
   }
                     
   deque->capacity = capacity;
+  deque->policy = *ds_growth_policy_default();
   deque->size = 0;
 
   // [head, tail)
   deque->head = 0;
   deque->tail = 0;
 
-  return deque;
+  return DS_OK;
 }
 
 /**
@@ -115,6 +179,22 @@ void ds_deque_destroy(ds_deque_t *deque, ds_free_f free_func) {
   // Check input parameters
   if (!deque) return;
 
+  // fini restores the allocator the deque was created with
+  ds_deque_fini(deque, free_func);
+  ds_allocator_t alloc = deque->alloc;
+  ds_mem_free(&alloc, deque, sizeof(ds_deque_t));
+}
+
+/**
+ * @brief Release the buffer of a deque set up with ds_deque_init().
+ *
+ * @param deque      Pointer to the deque. Its own memory is not freed.
+ * @param free_func  Optional element destructor.
+ */
+void ds_deque_fini(ds_deque_t *deque, ds_free_f free_func) {
+  // Check input parameters
+  if (!deque || !deque->items) return;
+
   // Traverse each element for free
   if (free_func) {
     size_t h = deque->head;
@@ -124,8 +204,13 @@ void ds_deque_destroy(ds_deque_t *deque, ds_free_f free_func) {
     }
   }
 
-  free(deque->items);
-  free(deque);
+  ds_mem_free(&deque->alloc, deque->items, sizeof(void *) * deque->capacity);
+  DS_STATS_DETACH(deque, &deque->alloc);
+  deque->items = NULL;
+  deque->capacity = 0;
+  deque->size = 0;
+  deque->head = 0;
+  deque->tail = 0;
 }
 
 /**
@@ -138,6 +223,16 @@ size_t ds_deque_size(const ds_deque_t *deque) {
   return deque->size;
 }
 
+/**
+ * @brief Get the instrumentation counters (DS_ENABLE_STATS builds).
+ */
+ds_status_t ds_deque_stats(const ds_deque_t *deque, ds_stats_t *out) {
+  // Check input parameters
+  if (!deque || !out) return DS_ERR_NULL;
+
+  return DS_STATS_COPY(deque, out);
+}
+
 /**
  * @brief Get the currently allocated capacity.
  */
@@ -240,7 +335,10 @@ void *ds_deque_pop_back(ds_deque_t *deque) {
 
   deque->tail = prev_idx(deque->tail, deque->capacity);
   deque->size --;
-  return deque->items[deque->tail];
+  void *ret = deque->items[deque->tail];
+
+  ds_deque_maybe_shrink(deque);
+  return ret;
 }
 
 /**
@@ -265,6 +363,7 @@ void *ds_deque_pop_front(ds_deque_t *deque) {
   deque->head = next_idx(deque->head, deque->capacity);
   deque->size --;
 
+  ds_deque_maybe_shrink(deque);
   return ret;
 }
 
@@ -308,6 +407,35 @@ void *ds_deque_back(const ds_deque_t *deque) {
   return deque->items[prev_idx(deque->tail, deque->capacity)];
 }
 
+/**
+ * @brief Get the elements as (at most two) contiguous segments.
+ *
+ * @param deque  Pointer to the deque.
+ * @param spans  Receives [head, end of buffer) and [0, tail). Unused
+ *               entries are set to empty spans.
+ *
+ * @return The number of non-empty spans: 0, 1 or 2.
+ */
+size_t ds_deque_as_spans(const ds_deque_t *deque, ds_span_t spans[2]) {
+  // Check input parameters
+  if (!spans) return 0;
+
+  spans[0] = ds_span_make(NULL, 0, sizeof(void *));
+  spans[1] = spans[0];
+  if (!deque || deque->size == 0) return 0;
+
+  // The first segment runs from head up to the end of the buffer at most
+  size_t first = deque->capacity - deque->head;
+  if (first >= deque->size) {
+    spans[0] = ds_span_make(deque->items + deque->head, deque->size, sizeof(void *));
+    return 1;
+  }
+
+  spans[0] = ds_span_make(deque->items + deque->head, first, sizeof(void *));
+  spans[1] = ds_span_make(deque->items, deque->size - first, sizeof(void *));
+  return 2;
+}
+
 /**
  * @brief Remove all elements from the deque.
  *
@@ -333,4 +461,45 @@ void ds_deque_clear(ds_deque_t *deque, ds_free_f free_func) {
   deque->size = 0;
   deque->head = 0;
   deque->tail = 0;
+  ds_deque_maybe_shrink(deque);
+}
+
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param deque  Pointer to the deque.
+ *
+ * @return
+ *   - DS_OK on success (an empty deque keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the deque is unchanged.
+ */
+ds_status_t ds_deque_shrink_to_fit(ds_deque_t *deque) {
+  // Check input parameters
+  if (!deque) return DS_ERR_NULL;
+
+  size_t new_capacity = deque->size > 0 ? deque->size : 1;
+  if (new_capacity >= deque->capacity) return DS_OK;
+
+  return ds_deque_resize(deque, new_capacity);
+}
+
+/**
+ * @brief Set the growth policy of the deque.
+ *
+ * @param deque   Pointer to the deque.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_deque_set_growth_policy(ds_deque_t *deque, const ds_growth_policy_t *policy) {
+  // Check input parameters
+  if (!deque) return DS_ERR_NULL;
+  if (!policy) policy = ds_growth_policy_default();
+  if (!ds_growth_policy_is_valid(policy)) return DS_ERR_ARG;
+
+  deque->policy = *policy;
+
+  return DS_OK;
 }
@@ -0,0 +1,288 @@
+/*
+** src/ds_ebr.c -- Implementation of epoch-based reclamation.
+*/
+
+#define _POSIX_C_SOURCE 200809L  // sched_yield under strict -std=c11
+
+#include "ds_ebr.h"
+#include "ds_common.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * `state` packs the epoch a thread observed when it entered with an
+ * "active" bit: (epoch << 1) | 1 inside a critical section, 0 outside.
+ * Only the owning thread writes it; collectors read it.
+ */
+struct ds_ebr_thread {
+  _Atomic uint64_t state;
+  unsigned depth;               // Nesting level, owner thread only
+  ds_ebr_t *ebr;
+  ds_ebr_thread_t *next;        // Registry, under ebr->lock
+};
+
+struct ds_ebr {
+  _Atomic uint64_t epoch;       // Advanced under `lock`, read anywhere
+  atomic_size_t pending;
+  pthread_mutex_t lock;         // Registry, retire list and epoch advance
+  ds_ebr_thread_t *threads;
+  ds_ebr_node_t *head;          // Retired objects, oldest first
+  ds_ebr_node_t *tail;
+  ds_allocator_t alloc;
+};
+
+/**
+ * @brief Create a reclamation domain.
+ */
+ds_ebr_t *ds_ebr_create(void) {
+  return ds_ebr_create_ex(NULL);
+}
+
+/**
+ * @brief Create a reclamation domain using a custom allocator.
+ */
+ds_ebr_t *ds_ebr_create_ex(const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_ebr_t *ebr = ds_mem_alloc(allocator, sizeof(ds_ebr_t));
+  if (!ebr) return NULL;
+
+  atomic_init(&ebr->epoch, 0);
+  atomic_init(&ebr->pending, 0);
+  pthread_mutex_init(&ebr->lock, NULL);
+  ebr->threads = NULL;
+  ebr->head = NULL;
+  ebr->tail = NULL;
+  ebr->alloc = *allocator;
+
+  return ebr;
+}
+
+/**
+ * @brief Run the reclaim callbacks of a detached list.
+ */
+static size_t ebr_reclaim_list(ds_ebr_node_t *node) {
+  size_t n = 0;
+  while (node) {
+    ds_ebr_node_t *next = node->next;   // reclaim() frees the node
+    node->reclaim(node, node->ctx);
+    node = next;
+    n ++;
+  }
+
+  return n;
+}
+
+/**
+ * @brief Reclaim everything still retired and destroy the domain.
+ */
+void ds_ebr_destroy(ds_ebr_t *ebr) {
+  // Check input parameters
+  if (!ebr) return;
+
+  // Callbacks may retire more objects: drain until the list stays empty
+  while (ebr->head) {
+    ds_ebr_node_t *list = ebr->head;
+    ebr->head = NULL;
+    ebr->tail = NULL;
+    ebr_reclaim_list(list);
+  }
+
+  ds_ebr_thread_t *th = ebr->threads;
+  while (th) {
+    ds_ebr_thread_t *next = th->next;
+    ds_mem_free(&ebr->alloc, th, sizeof(ds_ebr_thread_t));
+    th = next;
+  }
+
+  pthread_mutex_destroy(&ebr->lock);
+  ds_allocator_t alloc = ebr->alloc;
+  ds_mem_free(&alloc, ebr, sizeof(ds_ebr_t));
+}
+
+/**
+ * @brief Register the calling thread.
+ */
+ds_ebr_thread_t *ds_ebr_register(ds_ebr_t *ebr) {
+  // Check input parameters
+  if (!ebr) return NULL;
+
+  pthread_mutex_lock(&ebr->lock);
+  ds_ebr_thread_t *th = ds_mem_alloc(&ebr->alloc, sizeof(ds_ebr_thread_t));
+  if (th) {
+    atomic_init(&th->state, 0);
+    th->depth = 0;
+    th->ebr = ebr;
+    th->next = ebr->threads;
+    ebr->threads = th;
+  }
+  pthread_mutex_unlock(&ebr->lock);
+
+  return th;
+}
+
+/**
+ * @brief Unregister a thread record.
+ */
+void ds_ebr_unregister(ds_ebr_thread_t *th) {
+  // Check input parameters
+  if (!th) return;
+
+  ds_ebr_t *ebr = th->ebr;
+  pthread_mutex_lock(&ebr->lock);
+  ds_ebr_thread_t **link = &ebr->threads;
+  while (*link && *link != th) link = &(*link)->next;
+  if (*link) {
+    *link = th->next;
+    ds_mem_free(&ebr->alloc, th, sizeof(ds_ebr_thread_t));
+  }
+  pthread_mutex_unlock(&ebr->lock);
+}
+
+/**
+ * @brief Enter a read-side critical section.
+ *
+ * The acquire load of the epoch orders this section after every retire
+ * that preceded the last advance; the fence makes the state store
+ * visible to a collector before any shared pointer is read.
+ */
+void ds_ebr_enter(ds_ebr_thread_t *th) {
+  if (!th || th->depth ++ > 0) return;
+
+  uint64_t epoch = atomic_load_explicit(&th->ebr->epoch, memory_order_acquire);
+  atomic_store_explicit(&th->state, (epoch << 1) | 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+}
+
+/**
+ * @brief Leave a read-side critical section.
+ */
+void ds_ebr_leave(ds_ebr_thread_t *th) {
+  if (!th || th->depth == 0 || -- th->depth > 0) return;
+
+  atomic_store_explicit(&th->state, 0, memory_order_release);
+}
+
+/**
+ * @brief Hand an unlinked object over for deferred reclamation.
+ */
+void ds_ebr_retire(ds_ebr_t *ebr, ds_ebr_node_t *node, ds_ebr_reclaim_f reclaim, void *ctx) {
+  // Check input parameters
+  if (!ebr || !node || !reclaim) return;
+
+  node->next = NULL;
+  node->reclaim = reclaim;
+  node->ctx = ctx;
+
+  pthread_mutex_lock(&ebr->lock);
+  node->epoch = atomic_load_explicit(&ebr->epoch, memory_order_relaxed);
+  if (ebr->tail) ebr->tail->next = node;
+  else ebr->head = node;
+  ebr->tail = node;
+  atomic_fetch_add_explicit(&ebr->pending, 1, memory_order_relaxed);
+  pthread_mutex_unlock(&ebr->lock);
+}
+
+/**
+ * @brief Advance the epoch if every active thread has caught up, then
+ *        detach the objects that are now safe. Called with the lock held.
+ */
+static ds_ebr_node_t *ebr_advance_and_detach(ds_ebr_t *ebr, uint64_t *epoch_out) {
+  uint64_t epoch = atomic_load_explicit(&ebr->epoch, memory_order_relaxed);
+
+  // Pairs with the fence in ds_ebr_enter(): either we see the reader as
+  // active, or the reader sees every unlink made before this point
+  atomic_thread_fence(memory_order_seq_cst);
+
+  bool caught_up = true;
+  for (ds_ebr_thread_t *th = ebr->threads; th; th = th->next) {
+    // Acquire pairs with ds_ebr_leave(): the reads of a finished section
+    // happen before anything this collection frees
+    uint64_t s = atomic_load_explicit(&th->state, memory_order_acquire);
+    if ((s & 1) && (s >> 1) != epoch) {
+      caught_up = false;
+      break;
+    }
+  }
+  if (caught_up) {
+    epoch ++;
+    atomic_store_explicit(&ebr->epoch, epoch, memory_order_release);
+  }
+  *epoch_out = epoch;
+
+  // Retired in epoch e -> safe once the epoch reached e + 2
+  ds_ebr_node_t *list = NULL;
+  ds_ebr_node_t **tail = &list;
+  while (ebr->head && ebr->head->epoch + 2 <= epoch) {
+    ds_ebr_node_t *node = ebr->head;
+    ebr->head = node->next;
+    node->next = NULL;
+    *tail = node;
+    tail = &node->next;
+  }
+  if (!ebr->head) ebr->tail = NULL;
+
+  return list;
+}
+
+/**
+ * @brief Try to advance the epoch and reclaim what has become safe.
+ */
+size_t ds_ebr_collect(ds_ebr_t *ebr) {
+  // Check input parameters
+  if (!ebr) return 0;
+
+  uint64_t epoch;
+  pthread_mutex_lock(&ebr->lock);
+  ds_ebr_node_t *list = ebr_advance_and_detach(ebr, &epoch);
+  pthread_mutex_unlock(&ebr->lock);
+
+  size_t n = ebr_reclaim_list(list);
+  atomic_fetch_sub_explicit(&ebr->pending, n, memory_order_relaxed);
+  return n;
+}
+
+/**
+ * @brief Wait until everything retired so far has been reclaimed.
+ */
+size_t ds_ebr_synchronize(ds_ebr_t *ebr) {
+  // Check input parameters
+  if (!ebr) return 0;
+
+  // The newest object retired so far is freed once the epoch passes it
+  pthread_mutex_lock(&ebr->lock);
+  bool any = ebr->tail != NULL;
+  uint64_t target = any ? ebr->tail->epoch + 2 : 0;
+  pthread_mutex_unlock(&ebr->lock);
+  if (!any) return 0;
+
+  size_t n = 0;
+  for (;;) {
+    uint64_t epoch;
+    pthread_mutex_lock(&ebr->lock);
+    ds_ebr_node_t *list = ebr_advance_and_detach(ebr, &epoch);
+    pthread_mutex_unlock(&ebr->lock);
+
+    size_t k = ebr_reclaim_list(list);
+    atomic_fetch_sub_explicit(&ebr->pending, k, memory_order_relaxed);
+    n += k;
+
+    if (epoch >= target) return n;
+    sched_yield();
+  }
+}
+
+/**
+ * @brief Get the number of objects retired but not yet reclaimed.
+ */
+size_t ds_ebr_pending(const ds_ebr_t *ebr) {
+  if (!ebr) return 0;
+
+  return atomic_load_explicit(&((ds_ebr_t *)ebr)->pending, memory_order_relaxed);
+}
@@ -0,0 +1,625 @@
+/*
+** src/ds_hashmap.c -- Implementation of the Swiss-table hash map.
+*/
+
+#include "ds_hashmap.h"
+#include "ds_common.h"
+#include "ds_stats.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define HM_GROUP           16     // Control bytes compared at once
+#define HM_MIGRATE_GROUPS  2      // Old groups moved per mutating call
+
+// Control bytes: full slots hold h2 (0..127), free ones have the high bit set
+#define HM_EMPTY    ((uint8_t)0x80)
+#define HM_DELETED  ((uint8_t)0xFE)
+
+typedef struct {
+  void *key;
+  void *value;
+} hm_slot_t;
+
+/*
+ * One allocation per table: `capacity` control bytes followed by the
+ * slots. capacity is a power of two and a multiple of HM_GROUP.
+ */
+typedef struct {
+  uint8_t *ctrl;              // NULL if the table is not allocated
+  hm_slot_t *slots;
+  size_t capacity;
+  size_t size;                // Full slots
+  size_t growth_left;         // EMPTY slots that may still be filled
+} hm_table_t;
+
+struct ds_hashmap {
+  hm_table_t cur;             // Receives every insert
+  hm_table_t old;             // Being drained by an incremental resize
+  size_t migrate_pos;         // Next old slot to move
+  ds_hash_f hash;
+  ds_equal_f equal;
+  ds_allocator_t alloc;
+  DS_STATS_FIELD
+};
+
+// Lookups take a const map; the counters are bookkeeping, not map state
+#define HM_STATS_PROBE(map, groups)                                            \
+  do {                                                                         \
+    DS_STATS_ADD((ds_hashmap_t *)(map), probes, (groups));                     \
+    DS_STATS_MAX((ds_hashmap_t *)(map), max_probe, (groups));                  \
+  } while (0)
+
+/* ===================== Group matching ===================== */
+
+#if defined(__SSE2__)
+
+static inline uint32_t group_match(const uint8_t *g, uint8_t h2) {
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)g);
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+}
+
+static inline uint32_t group_match_empty(const uint8_t *g) {
+  return group_match(g, HM_EMPTY);
+}
+
+static inline uint32_t group_match_free(const uint8_t *g) {
+  return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)g));
+}
+
+#else
+
+static inline uint32_t group_match(const uint8_t *g, uint8_t h2) {
+  uint32_t mask = 0;
+  for (unsigned i = 0; i < HM_GROUP; ++ i) mask |= (uint32_t)(g[i] == h2) << i;
+  return mask;
+}
+
+static inline uint32_t group_match_empty(const uint8_t *g) {
+  return group_match(g, HM_EMPTY);
+}
+
+static inline uint32_t group_match_free(const uint8_t *g) {
+  uint32_t mask = 0;
+  for (unsigned i = 0; i < HM_GROUP; ++ i) mask |= (uint32_t)(g[i] >> 7) << i;
+  return mask;
+}
+
+#endif
+
+/**
+ * @brief Index of the lowest set bit (mask != 0).
+ */
+static inline unsigned hm_ctz(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctz(mask);
+#else
+  unsigned n = 0;
+  while (!(mask & 1u)) { mask >>= 1; n ++; }
+  return n;
+#endif
+}
+
+/**
+ * @brief Spread the user hash over all 64 bits (murmur3 finalizer).
+ */
+static inline uint64_t hm_mix(size_t h) {
+  uint64_t x = (uint64_t)h;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+static inline uint8_t hm_h2(uint64_t h) { return (uint8_t)(h & 0x7F); }
+static inline size_t  hm_h1(uint64_t h) { return (size_t)(h >> 7); }
+
+/* ===================== Tables ===================== */
+
+/**
+ * @brief Smallest capacity that holds `count` entries at 7/8 load.
+ *
+ * @return The capacity, or 0 on overflow.
+ */
+static size_t hm_capacity_for(size_t count) {
+  size_t cap = HM_GROUP;
+  while (cap - cap / 8 < count) {
+    if (cap > SIZE_MAX / 2 / (sizeof(hm_slot_t) + 1)) return 0;
+    cap <<= 1;
+  }
+  return cap;
+}
+
+static inline size_t hm_table_bytes(size_t capacity) {
+  return capacity + capacity * sizeof(hm_slot_t);
+}
+
+/**
+ * @brief Allocate an empty table of `capacity` slots.
+ */
+static ds_status_t hm_table_alloc(ds_hashmap_t *map, hm_table_t *t, size_t capacity) {
+  uint8_t *block = ds_mem_alloc(&map->alloc, hm_table_bytes(capacity));
+  if (!block) return DS_ERR_MEM;
+
+  memset(block, HM_EMPTY, capacity);
+  t->ctrl = block;
+  t->slots = (hm_slot_t *)(block + capacity);
+  t->capacity = capacity;
+  t->size = 0;
+  t->growth_left = capacity - capacity / 8;
+
+  return DS_OK;
+}
+
+static void hm_table_free(ds_hashmap_t *map, hm_table_t *t) {
+  if (!t->ctrl) return;
+
+  ds_mem_free(&map->alloc, t->ctrl, hm_table_bytes(t->capacity));
+  t->ctrl = NULL;
+  t->slots = NULL;
+  t->capacity = 0;
+  t->size = 0;
+  t->growth_left = 0;
+}
+
+/**
+ * @brief Slot index holding `key`, or SIZE_MAX.
+ */
+static size_t hm_find(const ds_hashmap_t *map, const hm_table_t *t, const void *key, uint64_t h) {
+  if (!t->ctrl || t->size == 0) return SIZE_MAX;
+
+  size_t gmask = t->capacity / HM_GROUP - 1;
+  size_t g = hm_h1(h) & gmask;
+  uint8_t h2 = hm_h2(h);
+
+  // Triangular probing over groups: g, g+1, g+3, g+6, ...
+  for (size_t step = 1; ; ++ step) {
+    const uint8_t *ctrl = t->ctrl + g * HM_GROUP;
+
+    for (uint32_t m = group_match(ctrl, h2); m; m &= m - 1) {
+      size_t i = g * HM_GROUP + hm_ctz(m);
+      DS_STATS_ADD((ds_hashmap_t *)map, comparisons, 1);
+      if (map->equal(key, t->slots[i].key)) {
+        HM_STATS_PROBE(map, step);
+        return i;
+      }
+    }
+    if (group_match_empty(ctrl)) {
+      HM_STATS_PROBE(map, step);
+      return SIZE_MAX;
+    }
+
+    g = (g + step) & gmask;
+  }
+}
+
+/**
+ * @brief First EMPTY or DELETED slot on the probe path of `h`.
+ */
+static size_t hm_find_free(const hm_table_t *t, uint64_t h) {
+  size_t gmask = t->capacity / HM_GROUP - 1;
+  size_t g = hm_h1(h) & gmask;
+
+  for (size_t step = 1; ; ++ step) {
+    uint32_t m = group_match_free(t->ctrl + g * HM_GROUP);
+    if (m) return g * HM_GROUP + hm_ctz(m);
+
+    g = (g + step) & gmask;
+  }
+}
+
+static inline void hm_place(hm_table_t *t, size_t i, uint64_t h, void *key, void *value) {
+  if (t->ctrl[i] == HM_EMPTY) t->growth_left --;
+  t->ctrl[i] = hm_h2(h);
+  t->slots[i].key = key;
+  t->slots[i].value = value;
+  t->size ++;
+}
+
+/**
+ * @brief Free slot i. It can go back to EMPTY when its group already has
+ *        an EMPTY byte, since no probe continues past such a group.
+ */
+static inline void hm_erase(hm_table_t *t, size_t i) {
+  if (group_match_empty(t->ctrl + (i & ~(size_t)(HM_GROUP - 1)))) {
+    t->ctrl[i] = HM_EMPTY;
+    t->growth_left ++;
+  } else {
+    t->ctrl[i] = HM_DELETED;
+  }
+  t->size --;
+}
+
+/* ===================== Resizing ===================== */
+
+/**
+ * @brief Move up to `max_slots` old slots into the current table.
+ */
+static void hm_migrate(ds_hashmap_t *map, size_t max_slots) {
+  hm_table_t *old = &map->old;
+  if (!old->ctrl) return;
+
+  size_t end = old->capacity - map->migrate_pos > max_slots
+               ? map->migrate_pos + max_slots
+               : old->capacity;
+
+  for (size_t i = map->migrate_pos; i < end && old->size > 0; ++ i) {
+    if (old->ctrl[i] & 0x80) continue;
+
+    hm_slot_t s = old->slots[i];
+    uint64_t h = hm_mix(map->hash(s.key));
+    hm_place(&map->cur, hm_find_free(&map->cur, h), h, s.key, s.value);
+
+    // A tombstone keeps probe paths through this slot intact for lookups
+    old->ctrl[i] = HM_DELETED;
+    old->size --;
+  }
+  map->migrate_pos = end;
+
+  if (old->size == 0 || map->migrate_pos == old->capacity) {
+    hm_table_free(map, old);
+    map->migrate_pos = 0;
+  }
+}
+
+/**
+ * @brief Replace the current table with one of `capacity` slots and start
+ *        draining the old one. The caller decides whether to finish the
+ *        migration at once.
+ */
+static ds_status_t hm_begin_resize(ds_hashmap_t *map, size_t capacity) {
+  // Only one resize at a time
+  hm_migrate(map, SIZE_MAX);
+
+  DS_STATS_TIMER(start);
+  hm_table_t next;
+  ds_status_t st = hm_table_alloc(map, &next, capacity);
+  if (st != DS_OK) return st;
+
+  map->old = map->cur;
+  map->cur = next;
+  map->migrate_pos = 0;
+  DS_STATS_RESIZE_DONE(map, start);
+
+  return DS_OK;
+}
+
+/**
+ * @brief The current table ran out of EMPTY slots: double it, or rebuild
+ *        it at the same size when tombstones, not entries, filled it.
+ */
+static ds_status_t hm_grow(ds_hashmap_t *map) {
+  size_t cap = map->cur.capacity;
+  size_t live = map->cur.size + map->old.size;
+  size_t max_load = cap - cap / 8;
+
+  if (live >= max_load / 2) {
+    if (cap > SIZE_MAX / 2 / (sizeof(hm_slot_t) + 1)) return DS_ERR_MEM;
+    cap *= 2;
+  }
+
+  return hm_begin_resize(map, cap);
+}
+
+/* ===================== API ===================== */
+
+/**
+ * @brief Create a new hash map.
+ */
+ds_hashmap_t *ds_hashmap_create(ds_hash_f hash, ds_equal_f equal, size_t capacity_hint) {
+  return ds_hashmap_create_ex(hash, equal, capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new hash map using a custom allocator.
+ */
+ds_hashmap_t *ds_hashmap_create_ex(ds_hash_f hash, ds_equal_f equal, size_t capacity_hint,
+                                   const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!hash || !equal) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  size_t capacity = hm_capacity_for(capacity_hint);
+  if (capacity == 0) return NULL;
+
+  ds_hashmap_t *map = ds_mem_alloc(allocator, sizeof(ds_hashmap_t));
+  if (!map) return NULL;
+
+  map->hash = hash;
+  map->equal = equal;
+  map->alloc = *allocator;
+  DS_STATS_ATTACH(map, "ds_hashmap", &map->alloc);
+  map->old = (hm_table_t){ 0 };
+  map->migrate_pos = 0;
+
+  if (hm_table_alloc(map, &map->cur, capacity) != DS_OK) {
+    DS_STATS_DETACH(map, &map->alloc);
+    ds_mem_free(allocator, map, sizeof(ds_hashmap_t));
+    return NULL;
+  }
+
+  return map;
+}
+
+/**
+ * @brief Free the keys and values of every full slot of a table.
+ */
+static void hm_table_free_entries(hm_table_t *t, ds_free_f key_free, ds_free_f value_free) {
+  if (!t->ctrl || (!key_free && !value_free)) return;
+
+  for (size_t i = 0; i < t->capacity; ++ i) {
+    if (t->ctrl[i] & 0x80) continue;
+    if (key_free) key_free(t->slots[i].key);
+    if (value_free) value_free(t->slots[i].value);
+  }
+}
+
+/**
+ * @brief Destroy a map and optionally free its keys and values.
+ */
+void ds_hashmap_destroy(ds_hashmap_t *map, ds_free_f key_free, ds_free_f value_free) {
+  // Check input parameters
+  if (!map) return;
+
+  hm_table_free_entries(&map->cur, key_free, value_free);
+  hm_table_free_entries(&map->old, key_free, value_free);
+  hm_table_free(map, &map->cur);
+  hm_table_free(map, &map->old);
+  DS_STATS_DETACH(map, &map->alloc);
+
+  ds_allocator_t alloc = map->alloc;
+  ds_mem_free(&alloc, map, sizeof(ds_hashmap_t));
+}
+
+/**
+ * @brief Get the current number of entries.
+ */
+size_t ds_hashmap_size(const ds_hashmap_t *map) {
+  if (!map) return 0;
+
+  return map->cur.size + map->old.size;
+}
+
+/**
+ * @brief Check if the map is empty.
+ */
+bool ds_hashmap_is_empty(const ds_hashmap_t *map) {
+  return ds_hashmap_size(map) == 0;
+}
+
+/**
+ * @brief Get the number of slots in the current table.
+ */
+size_t ds_hashmap_capacity(const ds_hashmap_t *map) {
+  if (!map) return 0;
+
+  return map->cur.capacity;
+}
+
+/**
+ * @brief Get the instrumentation counters (DS_ENABLE_STATS builds).
+ */
+ds_status_t ds_hashmap_stats(const ds_hashmap_t *map, ds_stats_t *out) {
+  // Check input parameters
+  if (!map || !out) return DS_ERR_NULL;
+
+  return DS_STATS_COPY(map, out);
+}
+
+/**
+ * @brief Shared body of insert and put.
+ */
+static ds_status_t hm_upsert(ds_hashmap_t *map, void *key, void *value, bool replace, ds_free_f old_value_free) {
+  // Check input parameters
+  if (!map) return DS_ERR_NULL;
+  if (!key) return DS_ERR_ARG;
+
+  hm_migrate(map, HM_MIGRATE_GROUPS * HM_GROUP);
+
+  uint64_t h = hm_mix(map->hash(key));
+
+  // An existing entry may still sit in the old table
+  hm_table_t *t = &map->cur;
+  size_t i = hm_find(map, t, key, h);
+  if (i == SIZE_MAX) {
+    t = &map->old;
+    i = hm_find(map, t, key, h);
+  }
+
+  if (i != SIZE_MAX) {
+    if (!replace) return DS_ERR_EXIST;
+
+    void *old_value = t->slots[i].value;
+    t->slots[i].value = value;
+    if (old_value_free && old_value != value) old_value_free(old_value);
+    return DS_OK;
+  }
+
+  // Reusing a tombstone costs no growth; taking an EMPTY slot might
+  i = hm_find_free(&map->cur, h);
+  if (map->cur.ctrl[i] == HM_EMPTY && map->cur.growth_left == 0) {
+    ds_status_t st = hm_grow(map);
+    if (st != DS_OK) return st;
+    i = hm_find_free(&map->cur, h);
+  }
+
+  hm_place(&map->cur, i, h, key, value);
+  return DS_OK;
+}
+
+/**
+ * @brief Insert a new entry.
+ */
+ds_status_t ds_hashmap_insert(ds_hashmap_t *map, void *key, void *value) {
+  return hm_upsert(map, key, value, false, NULL);
+}
+
+/**
+ * @brief Insert an entry, or replace the value of an existing one.
+ */
+ds_status_t ds_hashmap_put(ds_hashmap_t *map, void *key, void *value, ds_free_f old_value_free) {
+  return hm_upsert(map, key, value, true, old_value_free);
+}
+
+/**
+ * @brief Locate a key in either table.
+ */
+static hm_slot_t *hm_lookup(const ds_hashmap_t *map, const void *key) {
+  DS_STATS_ADD((ds_hashmap_t *)map, searches, 1);
+  uint64_t h = hm_mix(map->hash(key));
+
+  size_t i = hm_find(map, &map->cur, key, h);
+  if (i != SIZE_MAX) return &map->cur.slots[i];
+
+  i = hm_find(map, &map->old, key, h);
+  if (i != SIZE_MAX) return &map->old.slots[i];
+
+  return NULL;
+}
+
+/**
+ * @brief Get the value stored for a key.
+ */
+void *ds_hashmap_get(const ds_hashmap_t *map, const void *key) {
+  if (!map || !key) return NULL;
+
+  hm_slot_t *s = hm_lookup(map, key);
+  return s ? s->value : NULL;
+}
+
+/**
+ * @brief Check whether a key is present.
+ */
+bool ds_hashmap_contains(const ds_hashmap_t *map, const void *key) {
+  if (!map || !key) return false;
+
+  return hm_lookup(map, key) != NULL;
+}
+
+/**
+ * @brief Remove the entry for a key.
+ */
+ds_status_t ds_hashmap_remove(ds_hashmap_t *map, const void *key, ds_free_f key_free, ds_free_f value_free) {
+  // Check input parameters
+  if (!map) return DS_ERR_NULL;
+  if (!key) return DS_ERR_ARG;
+
+  hm_migrate(map, HM_MIGRATE_GROUPS * HM_GROUP);
+
+  uint64_t h = hm_mix(map->hash(key));
+  hm_table_t *t = &map->cur;
+  size_t i = hm_find(map, t, key, h);
+  if (i == SIZE_MAX) {
+    t = &map->old;
+    i = hm_find(map, t, key, h);
+  }
+  if (i == SIZE_MAX) return DS_ERR_NOT_FOUND;
+
+  hm_slot_t s = t->slots[i];
+  hm_erase(t, i);
+
+  if (key_free) key_free(s.key);
+  if (value_free) value_free(s.value);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove all entries. The table keeps its capacity.
+ */
+void ds_hashmap_clear(ds_hashmap_t *map, ds_free_f key_free, ds_free_f value_free) {
+  // Check input parameters
+  if (!map) return;
+
+  hm_table_free_entries(&map->cur, key_free, value_free);
+  hm_table_free_entries(&map->old, key_free, value_free);
+  hm_table_free(map, &map->old);
+  map->migrate_pos = 0;
+
+  hm_table_t *t = &map->cur;
+  memset(t->ctrl, HM_EMPTY, t->capacity);
+  t->size = 0;
+  t->growth_left = t->capacity - t->capacity / 8;
+}
+
+/**
+ * @brief Rebuild into a table of `capacity` slots and finish at once.
+ */
+static ds_status_t hm_resize_now(ds_hashmap_t *map, size_t capacity) {
+  ds_status_t st = hm_begin_resize(map, capacity);
+  if (st != DS_OK) return st;
+
+  hm_migrate(map, SIZE_MAX);
+  return DS_OK;
+}
+
+/**
+ * @brief Make room for `count` entries without any further resize.
+ */
+ds_status_t ds_hashmap_reserve(ds_hashmap_t *map, size_t count) {
+  // Check input parameters
+  if (!map) return DS_ERR_NULL;
+
+  hm_migrate(map, SIZE_MAX);
+
+  // Inserts into tombstones are free, so only EMPTY slots need counting
+  size_t size = map->cur.size;
+  if (count <= size || count - size <= map->cur.growth_left) return DS_OK;
+
+  size_t capacity = hm_capacity_for(count);
+  if (capacity == 0) return DS_ERR_MEM;
+
+  return hm_resize_now(map, capacity);
+}
+
+/**
+ * @brief Rebuild the table synchronously, dropping all tombstones.
+ */
+ds_status_t ds_hashmap_rehash(ds_hashmap_t *map, size_t count) {
+  // Check input parameters
+  if (!map) return DS_ERR_NULL;
+
+  size_t size = ds_hashmap_size(map);
+  size_t capacity = hm_capacity_for(count > size ? count : size);
+  if (capacity == 0) return DS_ERR_MEM;
+
+  return hm_resize_now(map, capacity);
+}
+
+/**
+ * @brief Step through the entries in unspecified order.
+ *
+ * The cursor runs over the current table's slots and then over the old
+ * table's; moved old slots are tombstones, so nothing is seen twice.
+ */
+bool ds_hashmap_next(const ds_hashmap_t *map, size_t *cursor, void **key, void **value) {
+  // Check input parameters
+  if (!map || !cursor) return false;
+
+  const hm_table_t *tables[2] = { &map->cur, &map->old };
+  size_t base = 0;
+
+  for (int k = 0; k < 2; ++ k) {
+    const hm_table_t *t = tables[k];
+    for (size_t i = *cursor > base ? *cursor - base : 0; t->ctrl && i < t->capacity; ++ i) {
+      if (t->ctrl[i] & 0x80) continue;
+
+      *cursor = base + i + 1;
+      if (key) *key = t->slots[i].key;
+      if (value) *value = t->slots[i].value;
+      return true;
+    }
+    base += t->capacity;
+  }
+
+  *cursor = base;
+  return false;
+}
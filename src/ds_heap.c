@@ -1,30 +1,69 @@
 #include "ds_heap.h"
 #include "ds_common.h"
+#include "ds_stats.h"
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define DS_HEAP_DEFAULT_CAPACITY 16
-#define DS_HEAP_GROWTH_FACTOR     2
+#define DS_HEAP_MAX_ARITY_LOG2   4
 
 struct ds_heap {
   void **items;         // Dynamic array, store `void *` pointer
   size_t capacity;      // Capacity of current array
   size_t size;          // Element count of current array
   ds_compare_f compare; // Comparison function
+  ds_allocator_t alloc;
+  ds_growth_policy_t policy;
+  unsigned arity_log2;  // Children per node = 1 << arity_log2 (binary: 1)
+  DS_STATS_FIELD
 };
 
 
-// Root:        index = 0
-// Parent:      (index - 1) / 2
-// Left Child:  2 * index + 1
-// Right Child: 2 * index + 2
-#define HEAP_PARENT(i)   (((i) - 1) >> 1)
+// For arity d = 1 << k:
+// Root:         index = 0
+// Parent:       (index - 1) / d
+// First child:  d * index + 1
+// Children:     d * index + 1 ... d * index + d
+#define HEAP_PARENT(h, i)   (((i) - 1) >> (h)->arity_log2)
 
-#define HEAP_LCHILD(i)   (((i) << 1) + 1)
-#define HEAP_RCHILD(i)   (((i) << 1) + 2)
+#define HEAP_FCHILD(h, i)   (((i) << (h)->arity_log2) + 1)
 
-#define HEAP_HAS_LCHILD(i, n)  ((((i) << 1) + 1) < (n))
-#define HEAP_HAS_RCHILD(i, n)  ((((i) << 1) + 2) < (n))
+/**
+ * @brief Call the user comparison, counting it in stats builds.
+ */
+static inline int heap_compare(ds_heap_t *heap, const void *a, const void *b) {
+  DS_STATS_ADD(heap, comparisons, 1);
+  return heap->compare(a, b);
+}
+
+/**
+ * @brief Reallocate the storage to exactly `new_cap` slots.
+ */
+static ds_status_t heap_set_capacity(ds_heap_t *heap, size_t new_cap) {
+  if (new_cap > SIZE_MAX / sizeof(void *)) return DS_ERR_MEM;
+
+  DS_STATS_TIMER(start);
+  void **new_arr = ds_mem_realloc(&heap->alloc, heap->items,
+                                  sizeof(void *) * heap->capacity,
+                                  sizeof(void *) * new_cap);
+  if (!new_arr) return DS_ERR_MEM;
+
+  heap->items = new_arr;
+  heap->capacity = new_cap;
+  DS_STATS_RESIZE_DONE(heap, start);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Give memory back after a removal, if the growth policy asks to.
+ */
+static void heap_maybe_shrink(ds_heap_t *heap) {
+  size_t new_cap = ds_growth_shrink_capacity(&heap->policy, heap->size, heap->capacity);
+  if (new_cap < heap->capacity) heap_set_capacity(heap, new_cap);
+}
 
 /**
  * @brief Perform a shift-up operation to adjust the heap.
@@ -44,10 +83,10 @@ static void shift_up(ds_heap_t *heap) {
   // Note: If compare(a, b) returns a value less then 0,
   //       it indicates that a is "better" than b
   while (i > 0) {
-    size_t p = HEAP_PARENT(i);
+    size_t p = HEAP_PARENT(heap, i);
     void *parent = heap->items[p];
 
-    if (heap->compare(x, parent) < 0) {
+    if (heap_compare(heap, x, parent) < 0) {
       heap->items[i] = parent;
       i = p;
     } else {
@@ -59,36 +98,33 @@ static void shift_up(ds_heap_t *heap) {
 }
 
 /**
- * @brief Perform a shift-down operation to adjust the heap.
+ * @brief Perform a shift-down operation starting at index i.
  */
-static void shift_down(ds_heap_t *heap) {
+static void shift_down(ds_heap_t *heap, size_t i) {
   // Check input parameters
-  if (!heap || heap->size == 0) return;
+  if (!heap || i >= heap->size) return;
 
   size_t n = heap->size;
-  size_t i = 0;
   void *x = heap->items[i];
 
+  size_t arity = (size_t)1 << heap->arity_log2;
+
   for (;;) {
-    size_t l = HEAP_LCHILD(i);
-    if (l >= n) break;            // No children -> leaf
-
-    size_t best = l;
-    size_t r = l + 1;
-
-    // Right children exists
-    if (r < n) {
-      void *left = heap->items[l];
-      void *right = heap->items[r];
-      // right is better
-      if (heap->compare(right, left) < 0) {
-        best = r;
+    size_t first = HEAP_FCHILD(heap, i);
+    if (first >= n) break;        // No children -> leaf
+
+    // Pick the best of the (up to `arity`) children
+    size_t best = first;
+    size_t last = n - first > arity ? first + arity : n;
+    for (size_t c = first + 1; c < last; ++ c) {
+      if (heap_compare(heap, heap->items[c], heap->items[best]) < 0) {
+        best = c;
       }
     }
 
     void *child = heap->items[best];
     // child is better -> move child up
-    if (heap->compare(child, x) < 0) {
+    if (heap_compare(heap, child, x) < 0) {
       heap->items[i] = child;
       i = best;
     } else {
@@ -99,6 +135,32 @@ static void shift_down(ds_heap_t *heap) {
   heap->items[i] = x;
 }
 
+/**
+ * @brief Floyd's bottom-up heapify of the whole array, O(n).
+ *
+ * Leaves are already heaps; sift down every inner node from the last
+ * one up to the root.
+ */
+static void heapify(ds_heap_t *heap) {
+  if (heap->size < 2) return;
+
+  for (size_t i = HEAP_PARENT(heap, heap->size - 1) + 1; i-- > 0; ) {
+    shift_down(heap, i);
+  }
+}
+
+/**
+ * @brief Make sure the array can hold `needed` elements.
+ */
+static ds_status_t heap_reserve(ds_heap_t *heap, size_t needed) {
+  if (needed <= heap->capacity) return DS_OK;
+
+  size_t new_cap = ds_growth_next_capacity(&heap->policy, heap->capacity, needed);
+  if (new_cap == 0) return DS_ERR_MEM;
+
+  return heap_set_capacity(heap, new_cap);
+}
+
 /**
  * @brief Create a binary heap, 
  *        whose type is determined by the passed comparision function.
@@ -110,28 +172,94 @@ static void shift_down(ds_heap_t *heap) {
  * @return Pointer to a new heap on success, or NULL on failure.
  */
 ds_heap_t *ds_heap_create(ds_compare_f compare, size_t capacity_hint) {
+  return ds_heap_create_ex(compare, capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a binary heap using a custom allocator.
+ *
+ * @param compare        Used to determine if the heap is a max-heap or min-heap.
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the heap and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_heap_t *ds_heap_create_ex(ds_compare_f compare, size_t capacity_hint, const ds_allocator_t *allocator) {
   // Check input param
   if (!compare) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
 
   size_t capacity = capacity_hint == 0 ?
                     DS_HEAP_DEFAULT_CAPACITY :
                     capacity_hint;
 
   // Allocate heap data structure
-  ds_heap_t *heap = malloc(sizeof(ds_heap_t));
+  ds_heap_t *heap = ds_mem_alloc(allocator, sizeof(ds_heap_t));
   if (!heap)
     return NULL;
 
+  heap->alloc = *allocator;
+  DS_STATS_ATTACH(heap, "ds_heap", &heap->alloc);
+
   // Allocate dynamic array
-  heap->items = malloc(sizeof(void *) * capacity);
+  heap->items = ds_mem_alloc(&heap->alloc, sizeof(void *) * capacity);
   if (!heap->items) {
-    free(heap);
+    DS_STATS_DETACH(heap, &heap->alloc);
+    ds_mem_free(allocator, heap, sizeof(ds_heap_t));
     return NULL;
   }
   
   heap->size = 0;
   heap->capacity = capacity;
+  heap->policy = *ds_growth_policy_default();
   heap->compare = compare;
+  heap->arity_log2 = 1;
+
+  return heap;
+}
+
+/**
+ * @brief Create a heap from an array of elements in O(n).
+ *
+ * @param compare  Comparison function, as for ds_heap_create().
+ * @param items    Array of `n` non-NULL elements. The pointers are copied;
+ *                 the array itself is not adopted.
+ * @param n        Number of elements.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_heap_t *ds_heap_create_from(ds_compare_f compare, void *const *items, size_t n) {
+  return ds_heap_create_from_ex(compare, items, n, NULL);
+}
+
+/**
+ * @brief Create a heap from an array of elements using a custom allocator.
+ *
+ * @param compare    Comparison function, as for ds_heap_create().
+ * @param items      Array of `n` non-NULL elements (copied).
+ * @param n          Number of elements.
+ * @param allocator  Allocator for the heap and its storage. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new heap on success, or NULL on failure.
+ */
+ds_heap_t *ds_heap_create_from_ex(ds_compare_f compare, void *const *items, size_t n,
+                                  const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (n > 0 && !items) return NULL;
+  for (size_t i = 0; i < n; ++ i) {
+    if (!items[i]) return NULL;
+  }
+
+  ds_heap_t *heap = ds_heap_create_ex(compare, n, allocator);
+  if (!heap) return NULL;
+
+  if (n > 0) memcpy(heap->items, items, n * sizeof(void *));
+  heap->size = n;
+  heapify(heap);
 
   return heap;
 }
@@ -155,8 +283,10 @@ void ds_heap_destroy(ds_heap_t *heap, ds_free_f free_func) {
     }
   }
 
-  free(heap->items);
-  free(heap);
+  ds_mem_free(&heap->alloc, heap->items, sizeof(void *) * heap->capacity);
+  DS_STATS_DETACH(heap, &heap->alloc);
+  ds_allocator_t alloc = heap->alloc;
+  ds_mem_free(&alloc, heap, sizeof(ds_heap_t));
   return;
 }
 
@@ -169,6 +299,16 @@ size_t ds_heap_size(const ds_heap_t *heap) {
   return heap->size;
 }
 
+/**
+ * @brief Get the instrumentation counters (DS_ENABLE_STATS builds).
+ */
+ds_status_t ds_heap_stats(const ds_heap_t *heap, ds_stats_t *out) {
+  // Check input parameters
+  if (!heap || !out) return DS_ERR_NULL;
+
+  return DS_STATS_COPY(heap, out);
+}
+
 /**
  * @brief Get the currently allocated capacity.
  */
@@ -178,6 +318,15 @@ size_t ds_heap_capacity(const ds_heap_t *heap) {
   return heap->capacity;
 }
 
+/**
+ * @brief Get a read-only span over the elements in storage order.
+ */
+ds_span_t ds_heap_as_span(const ds_heap_t *heap) {
+  if (!heap) return ds_span_make(NULL, 0, sizeof(void *));
+
+  return ds_span_make(heap->items, heap->size, sizeof(void *));
+}
+
 /**
  * @brief Check if the heap is empty.
  */
@@ -202,15 +351,8 @@ ds_status_t ds_heap_push(ds_heap_t *heap, void *element) {
   if (!element) return DS_ERR_ARG;
 
   // Check capacity of the heap whether full
-  if (heap->size == heap->capacity) {
-    // Expand capacity
-    size_t new_cap = heap->capacity * DS_HEAP_GROWTH_FACTOR;
-    void **new_arr = realloc(heap->items, sizeof(void *) * new_cap);
-    if (!new_arr) return DS_ERR_MEM;
-
-    heap->items = new_arr;
-    heap->capacity = new_cap;
-  }
+  ds_status_t ret = heap_reserve(heap, heap->size + 1);
+  if (ret != DS_OK) return ret;
 
   // Insert the new element at the end of the heap
   heap->items[heap->size ++] = element;
@@ -221,6 +363,96 @@ ds_status_t ds_heap_push(ds_heap_t *heap, void *element) {
   return DS_OK;
 }
 
+/**
+ * @brief Insert `count` elements at once.
+ *
+ * Storage grows at most once. When the batch is at least as large as the
+ * heap already is, the whole array is re-heapified in O(size + count);
+ * otherwise each new element is sifted up.
+ *
+ * @param heap      Pointer to the heap.
+ * @param elements  Array of `count` non-NULL elements.
+ * @param count     Number of elements.
+ *
+ * @return
+ *   - DS_OK         On success.
+ *   - DS_ERR_ARG    If elements is NULL or contains NULL; nothing is inserted.
+ *   - DS_ERR_MEM    If memory allocation fails; nothing is inserted.
+ */
+ds_status_t ds_heap_push_batch(ds_heap_t *heap, void *const *elements, size_t count) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+  if (count == 0) return DS_OK;
+  if (!elements) return DS_ERR_ARG;
+  for (size_t i = 0; i < count; ++ i) {
+    if (!elements[i]) return DS_ERR_ARG;
+  }
+  if (count > SIZE_MAX - heap->size) return DS_ERR_MEM;
+
+  ds_status_t ret = heap_reserve(heap, heap->size + count);
+  if (ret != DS_OK) return ret;
+
+  if (count >= heap->size) {
+    memcpy(heap->items + heap->size, elements, count * sizeof(void *));
+    heap->size += count;
+    heapify(heap);
+  } else {
+    for (size_t i = 0; i < count; ++ i) {
+      heap->items[heap->size ++] = elements[i];
+      shift_up(heap);
+    }
+  }
+
+  return DS_OK;
+}
+
+/**
+ * @brief Push an element, then pop the top, with at most one sift.
+ *
+ * If the element is at least as good as the current top (or the heap is
+ * empty), it is returned right away and the heap is untouched.
+ *
+ * @param heap     Pointer to the heap.
+ * @param element  Element to insert.
+ *
+ * @return The element that leaves the heap, or NULL on invalid arguments.
+ */
+void *ds_heap_pushpop(ds_heap_t *heap, void *element) {
+  // Check input parameters
+  if (!heap || !element) return NULL;
+
+  if (heap->size == 0 || heap_compare(heap, element, heap->items[0]) <= 0) return element;
+
+  void *ret = heap->items[0];
+  heap->items[0] = element;
+  shift_down(heap, 0);
+
+  return ret;
+}
+
+/**
+ * @brief Pop the top, then push an element, with one sift.
+ *
+ * Unlike ds_heap_pushpop(), the returned element is always the old top,
+ * even if the new element is better.
+ *
+ * @param heap     Pointer to the heap.
+ * @param element  Element to insert.
+ *
+ * @return The previous top element, or NULL if the heap is empty (the
+ *         element is then not inserted) or on invalid arguments.
+ */
+void *ds_heap_replace_top(ds_heap_t *heap, void *element) {
+  // Check input parameters
+  if (!heap || !element || heap->size == 0) return NULL;
+
+  void *ret = heap->items[0];
+  heap->items[0] = element;
+  shift_down(heap, 0);
+
+  return ret;
+}
+
 /**
  * @brief Remove the top element of the heap and return that element.
  *
@@ -242,8 +474,9 @@ void *ds_heap_pop(ds_heap_t *heap) {
   heap->size --;
 
   // Shift down 
-  shift_down(heap);
+  shift_down(heap, 0);
 
+  heap_maybe_shrink(heap);
   return ret;
 }
 
@@ -283,5 +516,83 @@ void ds_heap_clear(ds_heap_t *heap, ds_free_f free_func) {
   }
 
   heap->size = 0;
+  heap_maybe_shrink(heap);
   return;
 }
+
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param heap  Pointer to the heap.
+ *
+ * @return
+ *   - DS_OK on success (an empty heap keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the heap is unchanged.
+ */
+ds_status_t ds_heap_shrink_to_fit(ds_heap_t *heap) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+
+  size_t new_cap = heap->size > 0 ? heap->size : 1;
+  if (new_cap >= heap->capacity) return DS_OK;
+
+  return heap_set_capacity(heap, new_cap);
+}
+
+/**
+ * @brief Set the growth policy of the heap.
+ *
+ * @param heap    Pointer to the heap.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_heap_set_growth_policy(ds_heap_t *heap, const ds_growth_policy_t *policy) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+  if (!policy) policy = ds_growth_policy_default();
+  if (!ds_growth_policy_is_valid(policy)) return DS_ERR_ARG;
+
+  heap->policy = *policy;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Get the number of children per node.
+ */
+size_t ds_heap_arity(const ds_heap_t *heap) {
+  if (!heap) return 0;
+
+  return (size_t)1 << heap->arity_log2;
+}
+
+/**
+ * @brief Set the number of children per node.
+ *
+ * @param heap   Pointer to the heap.
+ * @param arity  2, 4, 8 or 16.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if arity is not one of the supported values.
+ */
+ds_status_t ds_heap_set_arity(ds_heap_t *heap, size_t arity) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+
+  if (arity < 2 || arity > ((size_t)1 << DS_HEAP_MAX_ARITY_LOG2)) return DS_ERR_ARG;
+  if (arity & (arity - 1)) return DS_ERR_ARG;   // Not a power of two
+
+  unsigned log2 = 1;
+  while (((size_t)1 << log2) < arity) log2 ++;
+
+  if (log2 != heap->arity_log2) {
+    heap->arity_log2 = log2;
+    heapify(heap);
+  }
+
+  return DS_OK;
+}
@@ -0,0 +1,375 @@
+/*
+** src/ds_iheap.c -- Implementation of the addressable binary heap.
+*/
+
+#include "ds_iheap.h"
+#include "ds_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define DS_IHEAP_DEFAULT_CAPACITY 16
+
+typedef struct {
+  void *element;
+  ds_iheap_handle_t handle;
+} ds_iheap_entry_t;
+
+/*
+ * pos[h] is the index of handle h in `entries` while h is live. Once h is
+ * freed, pos[h] links to the next free handle instead. A handle is live
+ * iff pos[h] < size and entries[pos[h]].handle == h.
+ *
+ * Handles only get created when the free list is empty, so `pos` grows
+ * to the largest size the heap ever had.
+ */
+struct ds_iheap {
+  ds_iheap_entry_t *entries;
+  size_t *pos;
+  size_t capacity;            // Slots in `entries`
+  size_t pos_capacity;        // Slots in `pos`
+  size_t size;
+  size_t num_handles;         // Handles ever handed out (live + free)
+  ds_iheap_handle_t free_head;
+  ds_compare_f compare;
+  ds_allocator_t alloc;
+};
+
+#define IHEAP_PARENT(i)   (((i) - 1) >> 1)
+#define IHEAP_LCHILD(i)   (((i) << 1) + 1)
+
+/**
+ * @brief Place an entry at index i and record its position.
+ */
+static inline void iheap_place(ds_iheap_t *heap, size_t i, ds_iheap_entry_t entry) {
+  heap->entries[i] = entry;
+  heap->pos[entry.handle] = i;
+}
+
+/**
+ * @brief Sift the entry at index i up. Returns its final index.
+ */
+static size_t shift_up(ds_iheap_t *heap, size_t i) {
+  ds_iheap_entry_t x = heap->entries[i];
+
+  while (i > 0) {
+    size_t p = IHEAP_PARENT(i);
+    if (heap->compare(x.element, heap->entries[p].element) >= 0) break;
+    iheap_place(heap, i, heap->entries[p]);
+    i = p;
+  }
+
+  iheap_place(heap, i, x);
+  return i;
+}
+
+/**
+ * @brief Sift the entry at index i down.
+ */
+static void shift_down(ds_iheap_t *heap, size_t i) {
+  size_t n = heap->size;
+  ds_iheap_entry_t x = heap->entries[i];
+
+  for (;;) {
+    size_t best = IHEAP_LCHILD(i);
+    if (best >= n) break;
+
+    if (best + 1 < n &&
+        heap->compare(heap->entries[best + 1].element, heap->entries[best].element) < 0) {
+      best ++;
+    }
+
+    if (heap->compare(heap->entries[best].element, x.element) >= 0) break;
+    iheap_place(heap, i, heap->entries[best]);
+    i = best;
+  }
+
+  iheap_place(heap, i, x);
+}
+
+/**
+ * @brief Grow an array of `*capacity` slots of `elem_size` bytes so that
+ *        one more slot fits.
+ *
+ * @return The grown array (and *capacity updated), or NULL on failure
+ *         with the array left untouched.
+ */
+static void *iheap_grow_array(ds_iheap_t *heap, void *array, size_t *capacity, size_t elem_size) {
+  size_t new_cap = ds_growth_next_capacity(ds_growth_policy_default(), *capacity, *capacity + 1);
+  if (new_cap == 0 || new_cap > SIZE_MAX / elem_size) return NULL;
+
+  void *grown = ds_mem_realloc(&heap->alloc, array, elem_size * *capacity, elem_size * new_cap);
+  if (grown) *capacity = new_cap;
+  return grown;
+}
+
+/**
+ * @brief Remove the entry at index i, returning its element.
+ */
+static void *iheap_remove_at(ds_iheap_t *heap, size_t i) {
+  ds_iheap_entry_t removed = heap->entries[i];
+
+  // Free the handle
+  heap->pos[removed.handle] = heap->free_head;
+  heap->free_head = removed.handle;
+
+  heap->size --;
+  if (i < heap->size) {
+    // Move the last entry into the hole and sift it whichever way is needed
+    iheap_place(heap, i, heap->entries[heap->size]);
+    if (shift_up(heap, i) == i) shift_down(heap, i);
+  }
+
+  return removed.element;
+}
+
+/**
+ * @brief Index of a live handle, or SIZE_MAX.
+ */
+static size_t iheap_index_of(const ds_iheap_t *heap, ds_iheap_handle_t handle) {
+  if (handle >= heap->num_handles) return SIZE_MAX;
+
+  size_t i = heap->pos[handle];
+  if (i >= heap->size || heap->entries[i].handle != handle) return SIZE_MAX;
+  return i;
+}
+
+/**
+ * @brief Create an addressable heap.
+ */
+ds_iheap_t *ds_iheap_create(ds_compare_f compare, size_t capacity_hint) {
+  return ds_iheap_create_ex(compare, capacity_hint, NULL);
+}
+
+/**
+ * @brief Create an addressable heap using a custom allocator.
+ */
+ds_iheap_t *ds_iheap_create_ex(ds_compare_f compare, size_t capacity_hint, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!compare) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  size_t capacity = capacity_hint == 0 ? DS_IHEAP_DEFAULT_CAPACITY : capacity_hint;
+  if (capacity > SIZE_MAX / sizeof(ds_iheap_entry_t)) return NULL;
+
+  ds_iheap_t *heap = ds_mem_alloc(allocator, sizeof(ds_iheap_t));
+  if (!heap) return NULL;
+
+  heap->entries = ds_mem_alloc(allocator, sizeof(ds_iheap_entry_t) * capacity);
+  heap->pos = ds_mem_alloc(allocator, sizeof(size_t) * capacity);
+  if (!heap->entries || !heap->pos) {
+    if (heap->entries) ds_mem_free(allocator, heap->entries, sizeof(ds_iheap_entry_t) * capacity);
+    if (heap->pos) ds_mem_free(allocator, heap->pos, sizeof(size_t) * capacity);
+    ds_mem_free(allocator, heap, sizeof(ds_iheap_t));
+    return NULL;
+  }
+
+  heap->capacity = capacity;
+  heap->pos_capacity = capacity;
+  heap->size = 0;
+  heap->num_handles = 0;
+  heap->free_head = DS_IHEAP_INVALID_HANDLE;
+  heap->compare = compare;
+  heap->alloc = *allocator;
+
+  return heap;
+}
+
+/**
+ * @brief Destroy a heap and optionally free its elements.
+ */
+void ds_iheap_destroy(ds_iheap_t *heap, ds_free_f free_func) {
+  // Check input parameters
+  if (!heap) return;
+
+  if (free_func) {
+    for (size_t i = 0; i < heap->size; ++ i) free_func(heap->entries[i].element);
+  }
+
+  ds_allocator_t alloc = heap->alloc;
+  ds_mem_free(&alloc, heap->entries, sizeof(ds_iheap_entry_t) * heap->capacity);
+  ds_mem_free(&alloc, heap->pos, sizeof(size_t) * heap->pos_capacity);
+  ds_mem_free(&alloc, heap, sizeof(ds_iheap_t));
+}
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_iheap_size(const ds_iheap_t *heap) {
+  if (!heap) return 0;
+
+  return heap->size;
+}
+
+/**
+ * @brief Check if the heap is empty.
+ */
+bool ds_iheap_is_empty(const ds_iheap_t *heap) {
+  if (!heap) return true;
+
+  return heap->size == 0;
+}
+
+/**
+ * @brief Insert a new element.
+ */
+ds_status_t ds_iheap_push(ds_iheap_t *heap, void *element, ds_iheap_handle_t *out_handle) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  if (heap->size == heap->capacity) {
+    ds_iheap_entry_t *entries = iheap_grow_array(heap, heap->entries, &heap->capacity,
+                                                 sizeof(ds_iheap_entry_t));
+    if (!entries) return DS_ERR_MEM;
+    heap->entries = entries;
+  }
+  if (heap->free_head == DS_IHEAP_INVALID_HANDLE && heap->num_handles == heap->pos_capacity) {
+    size_t *pos = iheap_grow_array(heap, heap->pos, &heap->pos_capacity, sizeof(size_t));
+    if (!pos) return DS_ERR_MEM;
+    heap->pos = pos;
+  }
+
+  // Reuse a freed handle, or hand out a new one
+  ds_iheap_handle_t handle;
+  if (heap->free_head != DS_IHEAP_INVALID_HANDLE) {
+    handle = heap->free_head;
+    heap->free_head = heap->pos[handle];
+  } else {
+    handle = heap->num_handles ++;
+  }
+
+  size_t i = heap->size ++;
+  iheap_place(heap, i, (ds_iheap_entry_t){ element, handle });
+  shift_up(heap, i);
+
+  if (out_handle) *out_handle = handle;
+  return DS_OK;
+}
+
+/**
+ * @brief Get the top element without removing it.
+ */
+void *ds_iheap_top(const ds_iheap_t *heap) {
+  if (!heap || heap->size == 0) return NULL;
+
+  return heap->entries[0].element;
+}
+
+/**
+ * @brief Get the handle of the top element.
+ */
+ds_iheap_handle_t ds_iheap_top_handle(const ds_iheap_t *heap) {
+  if (!heap || heap->size == 0) return DS_IHEAP_INVALID_HANDLE;
+
+  return heap->entries[0].handle;
+}
+
+/**
+ * @brief Remove the top element and return it.
+ */
+void *ds_iheap_pop(ds_iheap_t *heap) {
+  // Check input parameters
+  if (!heap || heap->size == 0) return NULL;
+
+  return iheap_remove_at(heap, 0);
+}
+
+/**
+ * @brief Check whether a handle refers to an element in the heap.
+ */
+bool ds_iheap_contains(const ds_iheap_t *heap, ds_iheap_handle_t handle) {
+  if (!heap) return false;
+
+  return iheap_index_of(heap, handle) != SIZE_MAX;
+}
+
+/**
+ * @brief Get the element of a handle.
+ */
+void *ds_iheap_get(const ds_iheap_t *heap, ds_iheap_handle_t handle) {
+  if (!heap) return NULL;
+
+  size_t i = iheap_index_of(heap, handle);
+  return i == SIZE_MAX ? NULL : heap->entries[i].element;
+}
+
+/**
+ * @brief Restore heap order after an element got better.
+ */
+ds_status_t ds_iheap_decrease_key(ds_iheap_t *heap, ds_iheap_handle_t handle, void *element) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  size_t i = iheap_index_of(heap, handle);
+  if (i == SIZE_MAX) return DS_ERR_NOT_FOUND;
+
+  heap->entries[i].element = element;
+  shift_up(heap, i);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Restore heap order after an element got worse.
+ */
+ds_status_t ds_iheap_increase_key(ds_iheap_t *heap, ds_iheap_handle_t handle, void *element) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  size_t i = iheap_index_of(heap, handle);
+  if (i == SIZE_MAX) return DS_ERR_NOT_FOUND;
+
+  heap->entries[i].element = element;
+  shift_down(heap, i);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Restore heap order after an element changed in either direction.
+ */
+ds_status_t ds_iheap_update(ds_iheap_t *heap, ds_iheap_handle_t handle, void *element) {
+  // Check input parameters
+  if (!heap) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  size_t i = iheap_index_of(heap, handle);
+  if (i == SIZE_MAX) return DS_ERR_NOT_FOUND;
+
+  heap->entries[i].element = element;
+  if (shift_up(heap, i) == i) shift_down(heap, i);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove the element of a handle and return it.
+ */
+void *ds_iheap_remove(ds_iheap_t *heap, ds_iheap_handle_t handle) {
+  // Check input parameters
+  if (!heap) return NULL;
+
+  size_t i = iheap_index_of(heap, handle);
+  if (i == SIZE_MAX) return NULL;
+
+  return iheap_remove_at(heap, i);
+}
+
+/**
+ * @brief Remove all elements from the heap.
+ */
+void ds_iheap_clear(ds_iheap_t *heap, ds_free_f free_func) {
+  // Check input parameters
+  if (!heap) return;
+
+  if (free_func) {
+    for (size_t i = 0; i < heap->size; ++ i) free_func(heap->entries[i].element);
+  }
+
+  heap->size = 0;
+  heap->num_handles = 0;
+  heap->free_head = DS_IHEAP_INVALID_HANDLE;
+}
@@ -0,0 +1,216 @@
+/*
+** src/ds_ilist.c -- Implementation of the intrusive doubly linked list.
+*/
+
+#include "ds_ilist.h"
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Link `link` between two adjacent links.
+ */
+static inline void ilist_link_between(ds_ilist_link_t *link, ds_ilist_link_t *prev, ds_ilist_link_t *next) {
+  link->prev = prev;
+  link->next = next;
+  prev->next = link;
+  next->prev = link;
+}
+
+/**
+ * @brief Take `link` out of its chain and mark it unlinked.
+ */
+static inline void ilist_unlink(ds_ilist_link_t *link) {
+  link->prev->next = link->next;
+  link->next->prev = link->prev;
+  link->prev = NULL;
+  link->next = NULL;
+}
+
+/**
+ * @brief Initialize an empty list.
+ */
+void ds_ilist_init(ds_ilist_t *list) {
+  // Check input parameters
+  if (!list) return;
+
+  list->head.prev = &list->head;
+  list->head.next = &list->head;
+  list->size = 0;
+}
+
+/**
+ * @brief Initialize a link as "in no list".
+ */
+void ds_ilist_link_init(ds_ilist_link_t *link) {
+  // Check input parameters
+  if (!link) return;
+
+  link->prev = NULL;
+  link->next = NULL;
+}
+
+/**
+ * @brief Check whether a link is currently in a list.
+ */
+bool ds_ilist_link_is_linked(const ds_ilist_link_t *link) {
+  return link && link->next != NULL;
+}
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_ilist_size(const ds_ilist_t *list) {
+  if (!list) return 0;
+
+  return list->size;
+}
+
+/**
+ * @brief Check if the list is empty.
+ */
+bool ds_ilist_is_empty(const ds_ilist_t *list) {
+  if (!list) return true;
+
+  return list->size == 0;
+}
+
+/**
+ * @brief Append a link to the end of the list.
+ */
+ds_status_t ds_ilist_push_back(ds_ilist_t *list, ds_ilist_link_t *link) {
+  return ds_ilist_insert(list, NULL, link);
+}
+
+/**
+ * @brief Prepend a link to the front of the list.
+ */
+ds_status_t ds_ilist_push_front(ds_ilist_t *list, ds_ilist_link_t *link) {
+  // Check input parameters
+  if (!list || !link) return DS_ERR_NULL;
+  if (link->next) return DS_ERR_ARG;
+
+  ilist_link_between(link, &list->head, list->head.next);
+  list->size ++;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Insert a link before the specified position.
+ */
+ds_status_t ds_ilist_insert(ds_ilist_t *list, ds_ilist_link_t *pos, ds_ilist_link_t *link) {
+  // Check input parameters
+  if (!list || !link) return DS_ERR_NULL;
+  if (link->next || (pos && !pos->next)) return DS_ERR_ARG;
+
+  // End is the sentinel itself
+  if (!pos) pos = &list->head;
+
+  ilist_link_between(link, pos->prev, pos);
+  list->size ++;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Unlink a link from the list.
+ */
+ds_ilist_link_t *ds_ilist_remove(ds_ilist_t *list, ds_ilist_link_t *link) {
+  // Check input parameters
+  if (!list || !link || !link->next) return NULL;
+
+  ds_ilist_link_t *next = link->next;
+  ilist_unlink(link);
+  list->size --;
+
+  return next == &list->head ? NULL : next;
+}
+
+/**
+ * @brief Unlink and return the first link.
+ */
+ds_ilist_link_t *ds_ilist_pop_front(ds_ilist_t *list) {
+  // Check input parameters
+  if (!list || list->size == 0) return NULL;
+
+  ds_ilist_link_t *link = list->head.next;
+  ilist_unlink(link);
+  list->size --;
+
+  return link;
+}
+
+/**
+ * @brief Unlink and return the last link.
+ */
+ds_ilist_link_t *ds_ilist_pop_back(ds_ilist_t *list) {
+  // Check input parameters
+  if (!list || list->size == 0) return NULL;
+
+  ds_ilist_link_t *link = list->head.prev;
+  ilist_unlink(link);
+  list->size --;
+
+  return link;
+}
+
+/**
+ * @brief Unlink every link.
+ *
+ * Each link is reset before `visit` sees it, so the callback may free
+ * the enclosing element or put it straight into another list.
+ */
+void ds_ilist_clear(ds_ilist_t *list, ds_ilist_visit_f visit) {
+  // Check input parameters
+  if (!list) return;
+
+  ds_ilist_link_t *p = list->head.next;
+  while (p != &list->head) {
+    ds_ilist_link_t *next = p->next;
+    p->prev = NULL;
+    p->next = NULL;
+    if (visit) visit(p);
+    p = next;
+  }
+
+  ds_ilist_init(list);
+}
+
+/**
+ * @brief Get the first link.
+ */
+ds_ilist_link_t *ds_ilist_front(const ds_ilist_t *list) {
+  if (!list || list->size == 0) return NULL;
+
+  return list->head.next;
+}
+
+/**
+ * @brief Get the last link.
+ */
+ds_ilist_link_t *ds_ilist_back(const ds_ilist_t *list) {
+  if (!list || list->size == 0) return NULL;
+
+  return list->head.prev;
+}
+
+/**
+ * @brief Get the link after `link`.
+ */
+ds_ilist_link_t *ds_ilist_next(const ds_ilist_t *list, const ds_ilist_link_t *link) {
+  // Check input parameters
+  if (!list || !link || !link->next) return NULL;
+
+  return link->next == &list->head ? NULL : link->next;
+}
+
+/**
+ * @brief Get the link before `link`.
+ */
+ds_ilist_link_t *ds_ilist_prev(const ds_ilist_t *list, const ds_ilist_link_t *link) {
+  // Check input parameters
+  if (!list || !link || !link->prev) return NULL;
+
+  return link->prev == &list->head ? NULL : link->prev;
+}
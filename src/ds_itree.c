@@ -0,0 +1,458 @@
+/*
+** src/ds_itree.c -- Implementation of the intrusive red-black tree.
+*/
+
+#include "ds_itree.h"
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Same red-black rules as ds_rbtree.c (NULL children are black leaves),
+ * applied directly to the embedded links.
+ */
+#define ITREE_RED   0
+#define ITREE_BLACK 1
+
+/**
+ * @brief NULL leaves are black.
+ */
+static inline bool is_red(const ds_itree_link_t *link) {
+  return link && link->color == ITREE_RED;
+}
+
+/**
+ * @brief Left-most link of a subtree.
+ */
+static inline ds_itree_link_t *subtree_min(ds_itree_link_t *link) {
+  while (link->left) link = link->left;
+  return link;
+}
+
+/**
+ * @brief Right-most link of a subtree.
+ */
+static inline ds_itree_link_t *subtree_max(ds_itree_link_t *link) {
+  while (link->right) link = link->right;
+  return link;
+}
+
+/**
+ * @brief Replace the subtree rooted at `u` with the subtree rooted at `v`
+ *        from the point of view of u's parent.
+ */
+static void transplant(ds_itree_t *tree, ds_itree_link_t *u, ds_itree_link_t *v) {
+  if (!u->parent)                 tree->root = v;
+  else if (u == u->parent->left)  u->parent->left = v;
+  else                            u->parent->right = v;
+
+  if (v) v->parent = u->parent;
+}
+
+/**
+ * @brief Left rotation around x.
+ */
+static void rotate_left(ds_itree_t *tree, ds_itree_link_t *x) {
+  ds_itree_link_t *y = x->right;
+
+  x->right = y->left;
+  if (y->left) y->left->parent = x;
+
+  transplant(tree, x, y);
+
+  y->left = x;
+  x->parent = y;
+}
+
+/**
+ * @brief Right rotation around x (mirror of rotate_left).
+ */
+static void rotate_right(ds_itree_t *tree, ds_itree_link_t *x) {
+  ds_itree_link_t *y = x->left;
+
+  x->left = y->right;
+  if (y->right) y->right->parent = x;
+
+  transplant(tree, x, y);
+
+  y->right = x;
+  x->parent = y;
+}
+
+/**
+ * @brief Restore the red-black properties after inserting the red link z.
+ */
+static void insert_fixup(ds_itree_t *tree, ds_itree_link_t *z) {
+  while (is_red(z->parent)) {
+    ds_itree_link_t *p = z->parent;
+    ds_itree_link_t *g = p->parent;   // Exists: a red link is never the root
+
+    if (p == g->left) {
+      ds_itree_link_t *uncle = g->right;
+
+      // Case 1: Uncle is red -> recolor
+      if (is_red(uncle)) {
+        p->color = ITREE_BLACK;
+        uncle->color = ITREE_BLACK;
+        g->color = ITREE_RED;
+        z = g;
+        continue;
+      }
+
+      // Case 2: z is an inner child -> rotate into Case 3
+      if (z == p->right) {
+        z = p;
+        rotate_left(tree, z);
+        p = z->parent;
+      }
+
+      // Case 3: z is an outer child -> rotate grandparent
+      p->color = ITREE_BLACK;
+      g->color = ITREE_RED;
+      rotate_right(tree, g);
+    } else {
+      ds_itree_link_t *uncle = g->left;
+
+      if (is_red(uncle)) {
+        p->color = ITREE_BLACK;
+        uncle->color = ITREE_BLACK;
+        g->color = ITREE_RED;
+        z = g;
+        continue;
+      }
+
+      if (z == p->left) {
+        z = p;
+        rotate_right(tree, z);
+        p = z->parent;
+      }
+
+      p->color = ITREE_BLACK;
+      g->color = ITREE_RED;
+      rotate_left(tree, g);
+    }
+  }
+
+  tree->root->color = ITREE_BLACK;
+}
+
+/**
+ * @brief Restore the red-black properties after removing a black link.
+ *
+ * `x` carries an "extra black" and may be NULL, so its parent is passed
+ * explicitly.
+ */
+static void remove_fixup(ds_itree_t *tree, ds_itree_link_t *x, ds_itree_link_t *parent) {
+  while (x != tree->root && !is_red(x)) {
+    if (x == parent->left) {
+      ds_itree_link_t *w = parent->right;   // Sibling, never NULL here
+
+      // Case 1: Red sibling -> rotate to get a black sibling
+      if (is_red(w)) {
+        w->color = ITREE_BLACK;
+        parent->color = ITREE_RED;
+        rotate_left(tree, parent);
+        w = parent->right;
+      }
+
+      // Case 2: Both nephews black -> push the extra black up
+      if (!is_red(w->left) && !is_red(w->right)) {
+        w->color = ITREE_RED;
+        x = parent;
+        parent = x->parent;
+        continue;
+      }
+
+      // Case 3: Far nephew black -> rotate sibling into Case 4
+      if (!is_red(w->right)) {
+        w->left->color = ITREE_BLACK;
+        w->color = ITREE_RED;
+        rotate_right(tree, w);
+        w = parent->right;
+      }
+
+      // Case 4: Far nephew red -> final rotation
+      w->color = parent->color;
+      parent->color = ITREE_BLACK;
+      w->right->color = ITREE_BLACK;
+      rotate_left(tree, parent);
+      x = tree->root;
+    } else {
+      ds_itree_link_t *w = parent->left;
+
+      if (is_red(w)) {
+        w->color = ITREE_BLACK;
+        parent->color = ITREE_RED;
+        rotate_right(tree, parent);
+        w = parent->left;
+      }
+
+      if (!is_red(w->left) && !is_red(w->right)) {
+        w->color = ITREE_RED;
+        x = parent;
+        parent = x->parent;
+        continue;
+      }
+
+      if (!is_red(w->left)) {
+        w->right->color = ITREE_BLACK;
+        w->color = ITREE_RED;
+        rotate_left(tree, w);
+        w = parent->left;
+      }
+
+      w->color = parent->color;
+      parent->color = ITREE_BLACK;
+      w->left->color = ITREE_BLACK;
+      rotate_right(tree, parent);
+      x = tree->root;
+    }
+  }
+
+  if (x) x->color = ITREE_BLACK;
+}
+
+/**
+ * @brief Initialize an empty tree.
+ */
+void ds_itree_init(ds_itree_t *tree, ds_itree_compare_f compare) {
+  // Check input parameters
+  if (!tree) return;
+
+  tree->root = NULL;
+  tree->size = 0;
+  tree->compare = compare;
+}
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_itree_size(const ds_itree_t *tree) {
+  if (!tree) return 0;
+
+  return tree->size;
+}
+
+/**
+ * @brief Check if the tree is empty.
+ */
+bool ds_itree_is_empty(const ds_itree_t *tree) {
+  if (!tree) return true;
+
+  return tree->size == 0;
+}
+
+/**
+ * @brief Insert a link.
+ */
+ds_status_t ds_itree_insert(ds_itree_t *tree, ds_itree_link_t *link) {
+  // Check input parameters
+  if (!tree || !link) return DS_ERR_NULL;
+  if (!tree->compare) return DS_ERR_ARG;
+
+  // Locate the insertion point
+  ds_itree_link_t **slot = &tree->root;
+  ds_itree_link_t *parent = NULL;
+
+  while (*slot) {
+    parent = *slot;
+    int cmp = tree->compare(link, parent);
+    if (cmp < 0)      slot = &parent->left;
+    else if (cmp > 0) slot = &parent->right;
+    else return DS_ERR_EXIST;  // Duplicate key not allowed
+  }
+
+  // Insertion as a red leaf, then rebalance
+  link->left = NULL;
+  link->right = NULL;
+  link->parent = parent;
+  link->color = ITREE_RED;
+  *slot = link;
+  insert_fixup(tree, link);
+
+  tree->size ++;
+  return DS_OK;
+}
+
+/**
+ * @brief Find the element equal to a key.
+ */
+ds_itree_link_t *ds_itree_find(const ds_itree_t *tree, const void *key, ds_itree_key_compare_f key_compare) {
+  // Check input parameters
+  if (!tree || !key_compare) return NULL;
+
+  ds_itree_link_t *curr = tree->root;
+  while (curr) {
+    int cmp = key_compare(key, curr);
+    if (cmp < 0)      curr = curr->left;
+    else if (cmp > 0) curr = curr->right;
+    else return curr;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Find the first element not less than a key.
+ */
+ds_itree_link_t *ds_itree_lower_bound(const ds_itree_t *tree, const void *key, ds_itree_key_compare_f key_compare) {
+  // Check input parameters
+  if (!tree || !key_compare) return NULL;
+
+  ds_itree_link_t *curr = tree->root;
+  ds_itree_link_t *best = NULL;
+  while (curr) {
+    if (key_compare(key, curr) <= 0) {
+      best = curr;
+      curr = curr->left;
+    } else {
+      curr = curr->right;
+    }
+  }
+
+  return best;
+}
+
+/**
+ * @brief Unlink a link from the tree.
+ */
+void ds_itree_remove(ds_itree_t *tree, ds_itree_link_t *z) {
+  // Check input parameters
+  if (!tree || !z || tree->size == 0) return;
+
+  // `x` moves into the position vacated by the spliced-out link,
+  // `x_parent` is its parent after the splice (x itself may be NULL)
+  ds_itree_link_t *x = NULL;
+  ds_itree_link_t *x_parent = NULL;
+  int removed_color = z->color;
+
+  // Case 1: At most one child -> splice z out directly
+  if (!z->left) {
+    x = z->right;
+    x_parent = z->parent;
+    transplant(tree, z, z->right);
+  } else if (!z->right) {
+    x = z->left;
+    x_parent = z->parent;
+    transplant(tree, z, z->left);
+  }
+  // Case 2: Two children -> the successor takes z's place and color
+  else {
+    ds_itree_link_t *y = subtree_min(z->right);
+
+    removed_color = y->color;
+    x = y->right;
+
+    if (y->parent == z) {
+      x_parent = y;
+    } else {
+      x_parent = y->parent;
+      transplant(tree, y, y->right);
+      y->right = z->right;
+      y->right->parent = y;
+    }
+
+    transplant(tree, z, y);
+    y->left = z->left;
+    y->left->parent = y;
+    y->color = z->color;
+  }
+
+  // Removing a black link shortens some paths: rebalance
+  if (removed_color == ITREE_BLACK) {
+    remove_fixup(tree, x, x_parent);
+  }
+
+  z->left = NULL;
+  z->right = NULL;
+  z->parent = NULL;
+  tree->size --;
+}
+
+/**
+ * @brief Unlink every link.
+ *
+ * Descend to a leaf, detach it from its parent, visit it and continue
+ * from the parent. The parent pointers replace a stack.
+ */
+void ds_itree_clear(ds_itree_t *tree, ds_itree_visit_f visit) {
+  // Check input parameters
+  if (!tree) return;
+
+  ds_itree_link_t *curr = tree->root;
+  while (curr) {
+    if (curr->left) {
+      curr = curr->left;
+    } else if (curr->right) {
+      curr = curr->right;
+    } else {
+      ds_itree_link_t *parent = curr->parent;
+      if (parent) {
+        if (parent->left == curr) parent->left = NULL;
+        else parent->right = NULL;
+      }
+
+      curr->parent = NULL;
+      if (visit) visit(curr);
+      curr = parent;
+    }
+  }
+
+  tree->root = NULL;
+  tree->size = 0;
+}
+
+/**
+ * @brief Get the smallest element.
+ */
+ds_itree_link_t *ds_itree_first(const ds_itree_t *tree) {
+  if (!tree || !tree->root) return NULL;
+
+  return subtree_min(tree->root);
+}
+
+/**
+ * @brief Get the largest element.
+ */
+ds_itree_link_t *ds_itree_last(const ds_itree_t *tree) {
+  if (!tree || !tree->root) return NULL;
+
+  return subtree_max(tree->root);
+}
+
+/**
+ * @brief Get the in-order successor.
+ */
+ds_itree_link_t *ds_itree_next(const ds_itree_link_t *link) {
+  // Check input parameters
+  if (!link) return NULL;
+
+  if (link->right) return subtree_min(link->right);
+
+  // Climb until we arrive from a left child
+  ds_itree_link_t *parent = link->parent;
+  while (parent && link == parent->right) {
+    link = parent;
+    parent = parent->parent;
+  }
+
+  return parent;
+}
+
+/**
+ * @brief Get the in-order predecessor.
+ */
+ds_itree_link_t *ds_itree_prev(const ds_itree_link_t *link) {
+  // Check input parameters
+  if (!link) return NULL;
+
+  if (link->left) return subtree_max(link->left);
+
+  ds_itree_link_t *parent = link->parent;
+  while (parent && link == parent->left) {
+    link = parent;
+    parent = parent->parent;
+  }
+
+  return parent;
+}
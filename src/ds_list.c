@@ -1,5 +1,6 @@
 #include "ds_list.h"
 #include "ds_common.h"
+#include "ds_pool.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -16,20 +17,119 @@ struct ds_list {
   ds_list_node_t *head;
   ds_list_node_t *tail;
   size_t size;
+  ds_pool_t *pool;        // Node pool, NULL if nodes are allocated one by one
+  ds_allocator_t alloc;
 };
 
+/**
+ * @brief Allocate a node, from the pool if the list has one.
+ */
+static ds_list_node_t *list_node_alloc(ds_list_t *list) {
+  if (list->pool) return ds_pool_alloc(list->pool);
+
+  return ds_mem_alloc(&list->alloc, sizeof(ds_list_node_t));
+}
+
+/**
+ * @brief Release a node to wherever it came from.
+ */
+static void list_node_free(ds_list_t *list, ds_list_node_t *node) {
+  if (list->pool) ds_pool_free(list->pool, node);
+  else ds_mem_free(&list->alloc, node, sizeof(ds_list_node_t));
+}
+
+/**
+ * @brief Release every node (and optionally every element) of the list.
+ *
+ * A pooled list only needs to be walked when elements must be freed,
+ * the nodes themselves are dropped together with their slabs.
+ */
+static void list_release_nodes(ds_list_t *list, ds_free_f free_func) {
+  ds_list_node_t *p = list->head;
+
+  if (list->pool) {
+    if (free_func) {
+      for (; p; p = p->next) free_func(p->data);
+    }
+    ds_pool_reset(list->pool);
+    return;
+  }
+
+  while (p != NULL) {
+    if (free_func)
+      free_func(p->data);
+
+    // Copy
+    ds_list_node_t *tmp = p;
+    // Update
+    p = p->next;
+    // Free
+    ds_mem_free(&list->alloc, tmp, sizeof(ds_list_node_t));
+  }
+}
+
 /**
  * @brief Create a new doubly linked list.
  *
  * @return Pointer to a new list on success, or NULL on failure.
  */
 ds_list_t *ds_list_create() {
-  ds_list_t *list = malloc(sizeof(ds_list_t));
+  return ds_list_create_ex(NULL);
+}
+
+/**
+ * @brief Create a new doubly linked list using a custom allocator.
+ *
+ * @param allocator  Allocator for the list and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_list_t *ds_list_create_ex(const ds_allocator_t *allocator) {
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_list_t *list = ds_mem_alloc(allocator, sizeof(ds_list_t));
   if (!list) return NULL;
 
   list->head = NULL;
   list->tail = NULL;
   list->size = 0;
+  list->pool = NULL;
+  list->alloc = *allocator;
+
+  return list;
+}
+
+/**
+ * @brief Create a new doubly linked list whose nodes come from a node pool.
+ *
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_list_t *ds_list_create_pooled(size_t slab_hint) {
+  return ds_list_create_pooled_ex(slab_hint, NULL);
+}
+
+/**
+ * @brief Create a pooled doubly linked list using a custom allocator.
+ *
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the list and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new list on success, or NULL on failure.
+ */
+ds_list_t *ds_list_create_pooled_ex(size_t slab_hint, const ds_allocator_t *allocator) {
+  ds_list_t *list = ds_list_create_ex(allocator);
+  if (!list) return NULL;
+
+  list->pool = ds_pool_create_ex(sizeof(ds_list_node_t), slab_hint, &list->alloc);
+  if (!list->pool) {
+    ds_mem_free(&list->alloc, list, sizeof(ds_list_t));
+    return NULL;
+  }
 
   return list;
 }
@@ -47,20 +147,10 @@ void ds_list_destroy(ds_list_t *list, ds_free_f free_func) {
   if (!list) return;
   
   // Iterate each node for free
-  ds_list_node_t *p = list->head;
-  while (p != NULL) {
-    if (free_func)
-      free_func(p->data);
-
-    // Copy
-    ds_list_node_t *tmp = p;
-    // Update
-    p = p->next;
-    // Free
-    free(tmp);
-  }
+  list_release_nodes(list, free_func);
 
-  free(list);
+  ds_pool_destroy(list->pool);
+  ds_mem_free(&list->alloc, list, sizeof(ds_list_t));
 }
 
 /**
@@ -169,7 +259,7 @@ ds_status_t ds_list_insert(ds_list_t *list, ds_list_iter_t it, void *element) {
   if (!element) return DS_ERR_ARG;
 
   // Construct a new node
-  ds_list_node_t *node = malloc(sizeof(ds_list_node_t));
+  ds_list_node_t *node = list_node_alloc(list);
   if (!node)
     return DS_ERR_MEM;
 
@@ -247,7 +337,7 @@ void *ds_list_pop_back(ds_list_t *list) {
   }
 
   // Free
-  free(tmp);
+  list_node_free(list, tmp);
 
   list->size --;
   return ret;
@@ -289,7 +379,7 @@ void *ds_list_pop_front(ds_list_t *list) {
   }
 
   // Free
-  free(tmp);
+  list_node_free(list, tmp);
   list->size --;
 
   return ret;
@@ -356,7 +446,7 @@ ds_list_iter_t ds_list_remove(ds_list_t *list, ds_list_iter_t it, ds_free_f free
   // Free
   if (free_func)
     free_func(tmp->data);
-  free(tmp);
+  list_node_free(list, tmp);
 
   list->size --;
 
@@ -377,24 +467,164 @@ void ds_list_clear(ds_list_t *list, ds_free_f free_func) {
   if (!list) return;
 
   // Traverse each node for free
-  ds_list_node_t *p = list->head;
-  while (p != NULL) {
-    if (free_func)
-      free_func(p->data);
-
-    // Copy
-    ds_list_node_t *tmp = p;
-    // Update
-    p = p->next;
-    // Free
-    free(tmp);
-  }
+  list_release_nodes(list, free_func);
 
   list->head = NULL;
   list->tail = NULL;
   list->size = 0;
 }
 
+/**
+ * @brief Check whether nodes of src may be released by dst.
+ */
+static bool list_nodes_compatible(const ds_list_t *dst, const ds_list_t *src) {
+  if (dst == src) return true;
+  if (dst->pool || src->pool) return false;
+
+  return dst->alloc.free == src->alloc.free && dst->alloc.ctx == src->alloc.ctx;
+}
+
+/**
+ * @brief Sort the list in place with a stable merge sort.
+ *
+ * Each pass merges neighbouring runs of `width` nodes, doubling the
+ * width until a pass does a single merge. The merged chain is rebuilt
+ * with both links as it goes, so no fix-up pass is needed.
+ */
+ds_status_t ds_list_sort(ds_list_t *list, ds_compare_f compare) {
+  // Check input parameters
+  if (!list || !compare) return DS_ERR_NULL;
+  if (list->size < 2) return DS_OK;
+
+  for (size_t width = 1; ; width *= 2) {
+    ds_list_node_t *p = list->head;
+    ds_list_node_t *head = NULL, *tail = NULL;
+    size_t merges = 0;
+
+    while (p) {
+      merges ++;
+
+      // The right run starts `width` nodes after p
+      ds_list_node_t *q = p;
+      size_t psize = 0;
+      while (q && psize < width) {
+        q = q->next;
+        psize ++;
+      }
+      size_t qsize = width;
+
+      while (psize > 0 || (qsize > 0 && q)) {
+        ds_list_node_t *e;
+        // Take from the left run on ties to stay stable
+        if (psize == 0) {
+          e = q; q = q->next; qsize --;
+        } else if (qsize == 0 || !q || compare(p->data, q->data) <= 0) {
+          e = p; p = p->next; psize --;
+        } else {
+          e = q; q = q->next; qsize --;
+        }
+
+        if (tail) tail->next = e;
+        else head = e;
+        e->prev = tail;
+        tail = e;
+      }
+
+      p = q;
+    }
+
+    tail->next = NULL;
+    list->head = head;
+    list->tail = tail;
+
+    if (merges <= 1) break;
+  }
+
+  return DS_OK;
+}
+
+/**
+ * @brief Move the range [first, last) of src in front of pos in dst.
+ */
+ds_status_t ds_list_splice(ds_list_t *dst, ds_list_iter_t pos, ds_list_t *src,
+                           ds_list_iter_t first, ds_list_iter_t last) {
+  // Check input parameters
+  if (!dst || !src) return DS_ERR_NULL;
+  if (!list_nodes_compatible(dst, src)) return DS_ERR_ARG;
+  if (!first || first == last) return DS_OK;
+
+  ds_list_node_t *end = last ? last->prev : src->tail;  // Last node moved
+  if (dst == src && (pos == first || pos == last)) return DS_OK;
+
+  // Count the range unless its size is already known
+  size_t count = 0;
+  if (dst != src) {
+    if (first == src->head && !last) {
+      count = src->size;
+    } else {
+      for (ds_list_node_t *p = first; p != last; p = p->next) count ++;
+    }
+  }
+
+  // Unlink [first, end] from src
+  if (first->prev) first->prev->next = last;
+  else src->head = last;
+  if (last) last->prev = first->prev;
+  else src->tail = first->prev;
+
+  // Link it in front of pos
+  ds_list_node_t *before = pos ? pos->prev : dst->tail;
+  first->prev = before;
+  end->next = pos;
+  if (before) before->next = first;
+  else dst->head = first;
+  if (pos) pos->prev = end;
+  else dst->tail = end;
+
+  src->size -= count;
+  dst->size += count;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Merge the sorted list src into the sorted list dst.
+ */
+ds_status_t ds_list_merge(ds_list_t *dst, ds_list_t *src, ds_compare_f compare) {
+  // Check input parameters
+  if (!dst || !src || !compare) return DS_ERR_NULL;
+  if (dst == src || !list_nodes_compatible(dst, src)) return DS_ERR_ARG;
+
+  ds_list_node_t *a = dst->head, *b = src->head;
+  ds_list_node_t *tail = NULL;
+  dst->head = NULL;
+
+  while (a || b) {
+    ds_list_node_t *e;
+    // Take from dst on ties to stay stable
+    if (!b || (a && compare(a->data, b->data) <= 0)) {
+      e = a; a = a->next;
+    } else {
+      e = b; b = b->next;
+    }
+
+    if (tail) tail->next = e;
+    else dst->head = e;
+    e->prev = tail;
+    tail = e;
+  }
+
+  if (tail) tail->next = NULL;
+  dst->tail = tail;
+  dst->size += src->size;
+
+  src->head = NULL;
+  src->tail = NULL;
+  src->size = 0;
+
+  return DS_OK;
+}
+
 /**
  * @brief Get an iterator pointing to the first element
  *
@@ -0,0 +1,253 @@
+/*
+** src/ds_pool.c -- Implementation of the ds_pool fixed-size block allocator.
+*/
+
+#include "ds_pool.h"
+#include "ds_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define DS_POOL_DEFAULT_SLAB_BLOCKS 64
+
+/*
+ * Memory layout:
+ *
+ *   slabs -> [ hdr | block | block | ... ] -> [ hdr | block | ... ] -> NULL
+ *
+ * Blocks are handed out in two ways:
+ *   1. From the free list (blocks returned by ds_pool_free), LIFO.
+ *   2. By bumping a cursor through the current slab. Slabs are never
+ *      pre-threaded into a free list, so creating or resetting a pool
+ *      costs O(1) regardless of its size.
+ */
+typedef struct ds_pool_slab {
+  struct ds_pool_slab *next;
+  max_align_t blocks[];        // Keeps the first block maximally aligned
+} ds_pool_slab_t;
+
+typedef struct ds_pool_free_block {
+  struct ds_pool_free_block *next;
+} ds_pool_free_block_t;
+
+struct ds_pool {
+  size_t block_size;           // Rounded block size
+  size_t slab_blocks;          // Blocks per slab
+
+  ds_pool_slab_t *slabs;       // All slabs, in allocation order
+  ds_pool_slab_t *curr;        // Slab currently being bumped through
+  unsigned char *bump;         // Next never-used block in `curr`
+  unsigned char *bump_end;     // One past the last block in `curr`
+
+  ds_pool_free_block_t *free_list;
+  size_t in_use;
+  size_t slab_count;
+
+  ds_allocator_t alloc;        // Source of the slabs and of the pool itself
+};
+
+/**
+ * @brief Round size up to a multiple of the maximal alignment.
+ */
+static size_t round_block_size(size_t size) {
+  size_t align = sizeof(max_align_t);
+  if (size < sizeof(ds_pool_free_block_t)) size = sizeof(ds_pool_free_block_t);
+  return (size + align - 1) / align * align;
+}
+
+/**
+ * @brief Size in bytes of one slab, header included.
+ */
+static size_t pool_slab_bytes(const ds_pool_t *pool) {
+  return sizeof(ds_pool_slab_t) + pool->block_size * pool->slab_blocks;
+}
+
+/**
+ * @brief Start bumping through `slab`.
+ */
+static void pool_use_slab(ds_pool_t *pool, ds_pool_slab_t *slab) {
+  pool->curr = slab;
+  pool->bump = (unsigned char *)slab->blocks;
+  pool->bump_end = pool->bump + pool->block_size * pool->slab_blocks;
+}
+
+/**
+ * @brief Move to the next slab, allocating one if none is left.
+ */
+static ds_status_t pool_next_slab(ds_pool_t *pool) {
+  // Reuse a slab kept by ds_pool_reset()
+  if (pool->curr && pool->curr->next) {
+    pool_use_slab(pool, pool->curr->next);
+    return DS_OK;
+  }
+
+  ds_pool_slab_t *slab = ds_mem_alloc(&pool->alloc, pool_slab_bytes(pool));
+  if (!slab) return DS_ERR_MEM;
+
+  slab->next = NULL;
+  if (pool->curr) pool->curr->next = slab;
+  else            pool->slabs = slab;
+
+  pool->slab_count ++;
+  pool_use_slab(pool, slab);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Create a new pool.
+ *
+ * @param block_size  Size in bytes of each block.
+ * @param slab_hint   Number of blocks per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new pool on success, or NULL on failure.
+ */
+ds_pool_t *ds_pool_create(size_t block_size, size_t slab_hint) {
+  return ds_pool_create_ex(block_size, slab_hint, NULL);
+}
+
+/**
+ * @brief Create a new pool whose slabs come from a custom allocator.
+ *
+ * @param block_size  Size in bytes of each block.
+ * @param slab_hint   Number of blocks per slab. If zero, a default is used.
+ * @param allocator   Allocator for the slabs and the pool itself. It is
+ *                    copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new pool on success, or NULL on failure.
+ */
+ds_pool_t *ds_pool_create_ex(size_t block_size, size_t slab_hint, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (block_size == 0) return NULL;
+  // Rounding must not wrap, and a one-block slab must still fit in size_t
+  if (block_size > SIZE_MAX - sizeof(ds_pool_slab_t) - (sizeof(max_align_t) - 1)) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_pool_t *pool = ds_mem_alloc(allocator, sizeof(ds_pool_t));
+  if (!pool) return NULL;
+
+  pool->alloc = *allocator;
+
+  pool->block_size = round_block_size(block_size);
+  pool->slab_blocks = slab_hint == 0 ? DS_POOL_DEFAULT_SLAB_BLOCKS : slab_hint;
+
+  // A slab size that wraps would be too small for the bump range
+  if (pool->slab_blocks > (SIZE_MAX - sizeof(ds_pool_slab_t)) / pool->block_size) {
+    ds_mem_free(allocator, pool, sizeof(ds_pool_t));
+    return NULL;
+  }
+
+  pool->slabs = NULL;
+  pool->curr = NULL;
+  pool->bump = NULL;
+  pool->bump_end = NULL;
+  pool->free_list = NULL;
+  pool->in_use = 0;
+  pool->slab_count = 0;
+
+  return pool;
+}
+
+/**
+ * @brief Destroy a pool and release all of its slabs.
+ */
+void ds_pool_destroy(ds_pool_t *pool) {
+  // Check input parameters
+  if (!pool) return;
+
+  ds_allocator_t alloc = pool->alloc;
+  size_t slab_bytes = pool_slab_bytes(pool);
+
+  ds_pool_slab_t *slab = pool->slabs;
+  while (slab) {
+    ds_pool_slab_t *tmp = slab;
+    slab = slab->next;
+    ds_mem_free(&alloc, tmp, slab_bytes);
+  }
+
+  ds_mem_free(&alloc, pool, sizeof(ds_pool_t));
+}
+
+/**
+ * @brief Allocate one block.
+ *
+ * @return Pointer to an uninitialized block, or NULL on failure.
+ */
+void *ds_pool_alloc(ds_pool_t *pool) {
+  // Check input parameters
+  if (!pool) return NULL;
+
+  // Fast path: recycle a freed block
+  if (pool->free_list) {
+    ds_pool_free_block_t *block = pool->free_list;
+    pool->free_list = block->next;
+    pool->in_use ++;
+    return block;
+  }
+
+  // Current slab exhausted (or no slab yet)
+  if (pool->bump == pool->bump_end) {
+    if (pool_next_slab(pool) != DS_OK) return NULL;
+  }
+
+  void *block = pool->bump;
+  pool->bump += pool->block_size;
+  pool->in_use ++;
+
+  return block;
+}
+
+/**
+ * @brief Return one block to the pool.
+ */
+void ds_pool_free(ds_pool_t *pool, void *block) {
+  // Check input parameters
+  if (!pool || !block) return;
+
+  ds_pool_free_block_t *node = block;
+  node->next = pool->free_list;
+  pool->free_list = node;
+  pool->in_use --;
+}
+
+/**
+ * @brief Mark every block as free while keeping the slabs for reuse.
+ */
+void ds_pool_reset(ds_pool_t *pool) {
+  // Check input parameters
+  if (!pool) return;
+
+  pool->free_list = NULL;
+  pool->in_use = 0;
+
+  if (pool->slabs) {
+    pool_use_slab(pool, pool->slabs);
+  }
+}
+
+/**
+ * @brief Get the (rounded) size of a block.
+ */
+size_t ds_pool_block_size(const ds_pool_t *pool) {
+  if (!pool) return 0;
+
+  return pool->block_size;
+}
+
+/**
+ * @brief Get the number of blocks currently handed out.
+ */
+size_t ds_pool_in_use(const ds_pool_t *pool) {
+  if (!pool) return 0;
+
+  return pool->in_use;
+}
+
+/**
+ * @brief Get the number of slabs currently owned by the pool.
+ */
+size_t ds_pool_slab_count(const ds_pool_t *pool) {
+  if (!pool) return 0;
+
+  return pool->slab_count;
+}
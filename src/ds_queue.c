@@ -1,13 +1,10 @@
 #include "ds_queue.h"
 #include "ds_common.h"
 #include "ds_deque.h"
+#include "ds_queue_inline.h"
 #include <stdbool.h>
 #include <stdlib.h>
 
-struct ds_queue {
-  ds_deque_t *deque;
-};
-
 /**
  * @brief Create a new dynamic queue.
  *
@@ -17,14 +14,30 @@ struct ds_queue {
  * @return Pointer to a new queue on success, or NULL on failure.
  */
 ds_queue_t *ds_queue_create(size_t capacity_hint) {
-  ds_queue_t *queue = malloc(sizeof(ds_queue_t));
+  return ds_queue_create_ex(capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new dynamic queue using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the queue and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new queue on success, or NULL on failure.
+ */
+ds_queue_t *ds_queue_create_ex(size_t capacity_hint, const ds_allocator_t *allocator) {
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_queue_t *queue = ds_mem_alloc(allocator, sizeof(ds_queue_t));
   if (!queue) return NULL;
 
-  queue->deque = ds_deque_create(capacity_hint);
-  if (!queue->deque) {
-    free(queue);
+  if (ds_deque_init(&queue->deque, capacity_hint, allocator) != DS_OK) {
+    ds_mem_free(allocator, queue, sizeof(ds_queue_t));
     return NULL;
-  } 
+  }
 
   return queue;
 }
@@ -40,8 +53,9 @@ ds_queue_t *ds_queue_create(size_t capacity_hint) {
 void ds_queue_destroy(ds_queue_t *queue, ds_free_f free_func) {
   if (!queue) return;
 
-  ds_deque_destroy(queue->deque, free_func);
-  free(queue);
+  ds_deque_fini(&queue->deque, free_func);
+  ds_allocator_t alloc = queue->deque.alloc;
+  ds_mem_free(&alloc, queue, sizeof(ds_queue_t));
 }
 
 /**
@@ -50,7 +64,16 @@ void ds_queue_destroy(ds_queue_t *queue, ds_free_f free_func) {
 size_t ds_queue_size(const ds_queue_t *queue) {
   if (!queue) return 0;
 
-  return ds_deque_size(queue->deque);
+  return ds_deque_size(&queue->deque);
+}
+
+/**
+ * @brief Get the instrumentation counters of the underlying deque.
+ */
+ds_status_t ds_queue_stats(const ds_queue_t *queue, ds_stats_t *out) {
+  if (!queue) return DS_ERR_NULL;
+
+  return ds_deque_stats(&queue->deque, out);
 }
 
 /**
@@ -59,7 +82,7 @@ size_t ds_queue_size(const ds_queue_t *queue) {
 size_t ds_queue_capacity(const ds_queue_t *queue) {
   if (!queue) return 0;
 
-  return ds_deque_capacity(queue->deque);
+  return ds_deque_capacity(&queue->deque);
 }
 
 /**
@@ -68,7 +91,7 @@ size_t ds_queue_capacity(const ds_queue_t *queue) {
 bool ds_queue_is_empty(ds_queue_t *queue) {
   if (!queue) return true;
 
-  return ds_deque_is_empty(queue->deque);
+  return ds_deque_is_empty(&queue->deque);
 }
 
 /**
@@ -85,7 +108,7 @@ ds_status_t ds_queue_push(ds_queue_t *queue, void *element) {
   if (!queue) return DS_ERR_NULL;
   if (!element) return DS_ERR_ARG;
 
-  return ds_deque_push_back(queue->deque, element);
+  return ds_deque_push_back_fast(&queue->deque, element);
 }
 
 /**
@@ -101,7 +124,7 @@ ds_status_t ds_queue_push(ds_queue_t *queue, void *element) {
 void *ds_queue_pop(ds_queue_t *queue) {
   if (!queue) return NULL;
 
-  return ds_deque_pop_front(queue->deque);
+  return ds_deque_pop_front(&queue->deque);
 }
 
 /**
@@ -117,7 +140,7 @@ void *ds_queue_pop(ds_queue_t *queue) {
 void *ds_queue_front(ds_queue_t *queue) {
   if (!queue) return NULL;
 
-  return ds_deque_front(queue->deque);
+  return ds_deque_front(&queue->deque);
 }
 
 /**
@@ -132,5 +155,36 @@ void *ds_queue_front(ds_queue_t *queue) {
 void ds_queue_clear(ds_queue_t *queue, ds_free_f free_func) {
   if (!queue) return;
 
-  ds_deque_clear(queue->deque, free_func);
+  ds_deque_clear(&queue->deque, free_func);
+}
+
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param queue  Pointer to the queue.
+ *
+ * @return
+ *   - DS_OK on success (an empty queue keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the queue is unchanged.
+ */
+ds_status_t ds_queue_shrink_to_fit(ds_queue_t *queue) {
+  if (!queue) return DS_ERR_NULL;
+
+  return ds_deque_shrink_to_fit(&queue->deque);
+}
+
+/**
+ * @brief Set the growth policy of the queue.
+ *
+ * @param queue   Pointer to the queue.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_queue_set_growth_policy(ds_queue_t *queue, const ds_growth_policy_t *policy) {
+  if (!queue) return DS_ERR_NULL;
+
+  return ds_deque_set_growth_policy(&queue->deque, policy);
 }
@@ -0,0 +1,707 @@
+#include "ds_rbtree.h"
+#include "ds_common.h"
+#include "ds_pool.h"
+#include "ds_stack.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/*
+ * Red-Black properties (NULL children count as black leaves):
+ *   1. Every node is either red or black.
+ *   2. The root is black.
+ *   3. A red node never has a red child.
+ *   4. Every path from a node down to a NULL leaf contains
+ *      the same number of black nodes.
+ */
+typedef enum {
+  RB_RED = 0,
+  RB_BLACK,
+} rb_color_t;
+
+typedef struct ds_rbtree_node {
+  void *data;
+  struct ds_rbtree_node *left;
+  struct ds_rbtree_node *right;
+  struct ds_rbtree_node *parent;
+  size_t count;           // Nodes in this subtree, for rank/select
+  rb_color_t color;
+} ds_rbtree_node_t;
+
+struct ds_rbtree {
+  ds_rbtree_node_t *root;
+  size_t size;
+  ds_compare_f compare;
+  ds_pool_t *pool;        // Node pool, NULL if nodes are allocated one by one
+  ds_allocator_t alloc;
+};
+
+/*
+ * @brief NULL leaves are black.
+ */
+static inline bool is_red(const ds_rbtree_node_t *node) {
+  return node && node->color == RB_RED;
+}
+
+/**
+ * @brief Number of nodes in a subtree (0 for NULL).
+ */
+static inline size_t node_count(const ds_rbtree_node_t *node) {
+  return node ? node->count : 0;
+}
+
+/**
+ * @brief Create a standalone red node (not attached to tree yet).
+ */
+static ds_rbtree_node_t *ds_rbtree_node_create(ds_rbtree_t *tree, void *data) {
+  if (!data) return NULL;
+
+  ds_rbtree_node_t *node = tree->pool
+                           ? ds_pool_alloc(tree->pool)
+                           : ds_mem_alloc(&tree->alloc, sizeof(ds_rbtree_node_t));
+  if (!node) return NULL;
+
+  node->data = data;
+  node->left = NULL;
+  node->right = NULL;
+  node->parent = NULL;
+  node->count = 1;
+  node->color = RB_RED;
+
+  return node;
+}
+
+/**
+ * @brief Release a node to wherever it came from.
+ */
+static void ds_rbtree_node_free(ds_rbtree_t *tree, ds_rbtree_node_t *node) {
+  if (tree->pool) ds_pool_free(tree->pool, node);
+  else ds_mem_free(&tree->alloc, node, sizeof(ds_rbtree_node_t));
+}
+
+/**
+ * @brief Replace the subtree rooted at `u` with the subtree rooted at `v`
+ *        from the point of view of u's parent.
+ */
+static void transplant(ds_rbtree_t *tree, ds_rbtree_node_t *u, ds_rbtree_node_t *v) {
+  if (!u->parent)                 tree->root = v;
+  else if (u == u->parent->left)  u->parent->left = v;
+  else                            u->parent->right = v;
+
+  if (v) v->parent = u->parent;
+}
+
+/**
+ * @brief Left rotation around x.
+ *
+ *     x                y
+ *    / \              / \
+ *   a   y     =>     x   c
+ *      / \          / \
+ *     b   c        a   b
+ */
+static void rotate_left(ds_rbtree_t *tree, ds_rbtree_node_t *x) {
+  ds_rbtree_node_t *y = x->right;
+
+  x->right = y->left;
+  if (y->left) y->left->parent = x;
+
+  transplant(tree, x, y);
+
+  y->left = x;
+  x->parent = y;
+
+  // y now roots what x rooted; x lost y and c
+  y->count = x->count;
+  x->count = node_count(x->left) + node_count(x->right) + 1;
+}
+
+/**
+ * @brief Right rotation around x (mirror of rotate_left).
+ */
+static void rotate_right(ds_rbtree_t *tree, ds_rbtree_node_t *x) {
+  ds_rbtree_node_t *y = x->left;
+
+  x->left = y->right;
+  if (y->right) y->right->parent = x;
+
+  transplant(tree, x, y);
+
+  y->right = x;
+  x->parent = y;
+
+  y->count = x->count;
+  x->count = node_count(x->left) + node_count(x->right) + 1;
+}
+
+/**
+ * @brief Restore the red-black properties after inserting the red node z.
+ *
+ * The only property that can be violated is #3 (red parent, red child).
+ * Walk up while the parent is red:
+ *   - Red uncle:   recolor and continue from the grandparent.
+ *   - Black uncle: one or two rotations terminate the loop.
+ */
+static void insert_fixup(ds_rbtree_t *tree, ds_rbtree_node_t *z) {
+  while (is_red(z->parent)) {
+    ds_rbtree_node_t *p = z->parent;
+    ds_rbtree_node_t *g = p->parent;   // Exists: a red node is never the root
+
+    if (p == g->left) {
+      ds_rbtree_node_t *uncle = g->right;
+
+      // Case 1: Uncle is red -> recolor
+      if (is_red(uncle)) {
+        p->color = RB_BLACK;
+        uncle->color = RB_BLACK;
+        g->color = RB_RED;
+        z = g;
+        continue;
+      }
+
+      // Case 2: z is an inner child -> rotate into Case 3
+      if (z == p->right) {
+        z = p;
+        rotate_left(tree, z);
+        p = z->parent;
+      }
+
+      // Case 3: z is an outer child -> rotate grandparent
+      p->color = RB_BLACK;
+      g->color = RB_RED;
+      rotate_right(tree, g);
+    } else {
+      ds_rbtree_node_t *uncle = g->left;
+
+      if (is_red(uncle)) {
+        p->color = RB_BLACK;
+        uncle->color = RB_BLACK;
+        g->color = RB_RED;
+        z = g;
+        continue;
+      }
+
+      if (z == p->left) {
+        z = p;
+        rotate_right(tree, z);
+        p = z->parent;
+      }
+
+      p->color = RB_BLACK;
+      g->color = RB_RED;
+      rotate_left(tree, g);
+    }
+  }
+
+  tree->root->color = RB_BLACK;
+}
+
+/**
+ * @brief Restore the red-black properties after removing a black node.
+ *
+ * `x` carries an "extra black" and may be NULL, so its parent is passed
+ * explicitly.
+ */
+static void remove_fixup(ds_rbtree_t *tree, ds_rbtree_node_t *x, ds_rbtree_node_t *parent) {
+  while (x != tree->root && !is_red(x)) {
+    if (x == parent->left) {
+      ds_rbtree_node_t *w = parent->right;   // Sibling, never NULL here
+
+      // Case 1: Red sibling -> rotate to get a black sibling
+      if (is_red(w)) {
+        w->color = RB_BLACK;
+        parent->color = RB_RED;
+        rotate_left(tree, parent);
+        w = parent->right;
+      }
+
+      // Case 2: Both nephews black -> push the extra black up
+      if (!is_red(w->left) && !is_red(w->right)) {
+        w->color = RB_RED;
+        x = parent;
+        parent = x->parent;
+        continue;
+      }
+
+      // Case 3: Far nephew black -> rotate sibling into Case 4
+      if (!is_red(w->right)) {
+        w->left->color = RB_BLACK;
+        w->color = RB_RED;
+        rotate_right(tree, w);
+        w = parent->right;
+      }
+
+      // Case 4: Far nephew red -> final rotation
+      w->color = parent->color;
+      parent->color = RB_BLACK;
+      w->right->color = RB_BLACK;
+      rotate_left(tree, parent);
+      x = tree->root;
+    } else {
+      ds_rbtree_node_t *w = parent->left;
+
+      if (is_red(w)) {
+        w->color = RB_BLACK;
+        parent->color = RB_RED;
+        rotate_right(tree, parent);
+        w = parent->left;
+      }
+
+      if (!is_red(w->left) && !is_red(w->right)) {
+        w->color = RB_RED;
+        x = parent;
+        parent = x->parent;
+        continue;
+      }
+
+      if (!is_red(w->left)) {
+        w->right->color = RB_BLACK;
+        w->color = RB_RED;
+        rotate_left(tree, w);
+        w = parent->left;
+      }
+
+      w->color = parent->color;
+      parent->color = RB_BLACK;
+      w->left->color = RB_BLACK;
+      rotate_right(tree, parent);
+      x = tree->root;
+    }
+  }
+
+  if (x) x->color = RB_BLACK;
+}
+
+/**
+ * @brief Create a new red-black tree.
+ *
+ * @param compare  Function used to compare elements.
+ * Required to maintain the order of the tree.
+ * - Returns < 0 if a < b
+ * - Returns 0 if a == b
+ * - Returns > 0 if a > b
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create(ds_compare_f compare) {
+  return ds_rbtree_create_ex(compare, NULL);
+}
+
+/**
+ * @brief Create a new red-black tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param allocator  Allocator for the tree and its nodes. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create_ex(ds_compare_f compare, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!compare) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_rbtree_t *tree = ds_mem_alloc(allocator, sizeof(ds_rbtree_t));
+  if (!tree) return NULL;
+
+  tree->alloc = *allocator;
+
+  tree->root = NULL;
+  tree->size = 0;
+  tree->compare = compare;
+  tree->pool = NULL;
+
+  return tree;
+}
+
+/**
+ * @brief Create a new red-black tree whose nodes come from a node pool.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create_pooled(ds_compare_f compare, size_t slab_hint) {
+  return ds_rbtree_create_pooled_ex(compare, slab_hint, NULL);
+}
+
+/**
+ * @brief Create a pooled red-black tree using a custom allocator.
+ *
+ * @param compare    Function used to compare elements.
+ * @param slab_hint  Number of nodes per slab. If zero, a default is used.
+ * @param allocator  Allocator for the tree and its slabs. It is copied.
+ *                   If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new red-black tree on success, or NULL on failure.
+ */
+ds_rbtree_t *ds_rbtree_create_pooled_ex(ds_compare_f compare, size_t slab_hint, const ds_allocator_t *allocator) {
+  ds_rbtree_t *tree = ds_rbtree_create_ex(compare, allocator);
+  if (!tree) return NULL;
+
+  tree->pool = ds_pool_create_ex(sizeof(ds_rbtree_node_t), slab_hint, &tree->alloc);
+  if (!tree->pool) {
+    ds_mem_free(&tree->alloc, tree, sizeof(ds_rbtree_t));
+    return NULL;
+  }
+
+  return tree;
+}
+
+/**
+ * @brief Destroy a red-black tree and optionally free its elements.
+ *
+ * Same dual-stack iterative post-order teardown as `ds_bst_destroy`:
+ *  - First stack:  Used for traversal control (Root -> Right -> Left)
+ *  - Second stack: Stores the "reversed visit sequence"
+ *
+ * @param tree       Pointer to the red-black tree.
+ * @param free_func  Optional element destructor.
+ *                   - If non-NULL, it is called for each stored element.
+ *                   - If NULL, only the red-black tree itself is freed.
+ */
+void ds_rbtree_destroy(ds_rbtree_t *tree, ds_free_f free_func) {
+  // Check input parameters
+  if (!tree) return;
+
+  // Pooled nodes without elements to free: drop the slabs in one go
+  if (!tree->root || (tree->pool && !free_func)) {
+    ds_pool_destroy(tree->pool);
+    ds_mem_free(&tree->alloc, tree, sizeof(ds_rbtree_t));
+    return;
+  }
+
+  // Helper stack for traversal control
+  ds_stack_t *stack_traverse = ds_stack_create_ex(tree->size, &tree->alloc);
+  if (!stack_traverse) return;
+
+  // Helper stack for Stores results
+  ds_stack_t *stack_store = ds_stack_create_ex(tree->size, &tree->alloc);
+  if (!stack_store) {
+    ds_stack_destroy(stack_traverse, NULL);
+    return;
+  }
+
+  ds_rbtree_node_t *curr = tree->root;
+
+  while (curr) {
+    ds_stack_push(stack_store, curr);
+
+    if (curr->left) {
+      ds_stack_push(stack_traverse, curr->left);
+    }
+
+    if (curr->right) {
+      curr = curr->right;
+    } else if (!ds_stack_is_empty(stack_traverse)) {
+      curr = ds_stack_pop(stack_traverse);
+    } else {
+      break;
+    }
+  }
+
+  // Free nodes one by one
+  while (!ds_stack_is_empty(stack_store)) {
+    ds_rbtree_node_t *tmp = ds_stack_pop(stack_store);
+    if (free_func) free_func(tmp->data);
+    ds_rbtree_node_free(tree, tmp);
+  }
+
+  ds_stack_destroy(stack_traverse, NULL);
+  ds_stack_destroy(stack_store, NULL);
+  ds_pool_destroy(tree->pool);
+  ds_mem_free(&tree->alloc, tree, sizeof(ds_rbtree_t));
+}
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_rbtree_size(const ds_rbtree_t *tree) {
+  if (!tree) return 0;
+
+  return tree->size;
+}
+
+/**
+ * @brief Get the height of the tree (0 for an empty tree).
+ */
+static size_t rbtree_height_node(const ds_rbtree_node_t *node) {
+  if (!node) return 0;
+
+  size_t lh = rbtree_height_node(node->left);
+  size_t rh = rbtree_height_node(node->right);
+
+  return (lh > rh ? lh : rh) + 1;
+}
+
+size_t ds_rbtree_height(const ds_rbtree_t *tree) {
+  if (!tree) return 0;
+
+  return rbtree_height_node(tree->root);
+}
+
+/**
+ * @brief Insert a new element into the tree.
+ *
+ * @param tree  Pointer to the red-black tree.
+ * @param data  Pointer to the data to insert.
+ *
+ * @return
+ * - DS_OK:        On success.
+ * - DS_ERR_EXIST: If the data already exists (Duplicate keys are not allowed).
+ * - DS_ERR_MEM:   If memory allocation fails.
+ */
+ds_status_t ds_rbtree_insert(ds_rbtree_t *tree, void *data) {
+  // Check input parameters
+  if (!tree) return DS_ERR_NULL;
+  if (!data) return DS_ERR_ARG;
+
+  // Locate the insertion point
+  ds_rbtree_node_t **link = &tree->root;
+  ds_rbtree_node_t *parent = NULL;
+
+  while (*link) {
+    parent = *link;
+    int cmp = tree->compare(data, parent->data);
+    if (cmp < 0)      link = &parent->left;
+    else if (cmp > 0) link = &parent->right;
+    else return DS_ERR_EXIST;  // Duplicate key not allowed
+  }
+
+  ds_rbtree_node_t *node = ds_rbtree_node_create(tree, data);
+  if (!node) return DS_ERR_MEM;
+
+  // Insertion as a red leaf, then rebalance
+  node->parent = parent;
+  *link = node;
+  for (ds_rbtree_node_t *n = parent; n; n = n->parent) n->count ++;
+  insert_fixup(tree, node);
+
+  tree->size ++;
+  return DS_OK;
+}
+
+/**
+ * @brief Search for data matching a key.
+ *
+ * @param tree  Pointer to the red-black tree.
+ * @param key   Pointer to a dummy object or key used for comparison.
+ *
+ * @return Pointer to the stored data if found, NULL otherwise.
+ */
+void *ds_rbtree_search(const ds_rbtree_t *tree, const void *key) {
+  // Check input parameters
+  if (!tree || !tree->root || !key) return NULL;
+
+  const ds_rbtree_node_t *curr = tree->root;
+  while (curr) {
+    int cmp = tree->compare(key, curr->data);
+
+    if (cmp < 0) {
+      curr = curr->left;
+    } else if (cmp > 0) {
+      curr = curr->right;
+    } else {
+      // Found it
+      return curr->data;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Remove the node matching the key.
+ *
+ * @param tree       Pointer to the red-black tree.
+ * @param key        Pointer to the key to identify the node.
+ * @param free_func  Optional destructor.
+ * If found, this is called on the data being removed.
+ *
+ * @return
+ * - DS_OK:            If the node was found and removed.
+ * - DS_ERR_NOT_FOUND: If the key was not found.
+ * - DS_ERR_*:         On invalid arguments.
+ */
+ds_status_t ds_rbtree_remove(ds_rbtree_t *tree, const void *key, ds_free_f free_func) {
+  // Check input parameters
+  if (!tree) return DS_ERR_NULL;
+  if (!tree->root) return DS_ERR_NOT_FOUND;
+  if (!key) return DS_ERR_ARG;
+
+  ds_rbtree_node_t *z = tree->root;
+  while (z) {
+    int cmp = tree->compare(key, z->data);
+    if (cmp < 0) z = z->left;
+    else if (cmp > 0) z = z->right;
+    else break;
+  }
+
+  if (!z) return DS_ERR_NOT_FOUND;
+
+  // `x` moves into the position vacated by the spliced-out node,
+  // `x_parent` is its parent after the splice (x itself may be NULL)
+  ds_rbtree_node_t *x = NULL;
+  ds_rbtree_node_t *x_parent = NULL;
+  rb_color_t removed_color = z->color;
+
+  // The node that is physically unlinked is z itself (case 1) or its
+  // successor (case 2); every ancestor of that spot loses one node
+  ds_rbtree_node_t *spot = z;
+  if (z->left && z->right) {
+    spot = z->right;
+    while (spot->left) spot = spot->left;
+  }
+  for (ds_rbtree_node_t *n = spot->parent; n; n = n->parent) n->count --;
+
+  // Case 1: At most one child -> splice z out directly
+  if (!z->left) {
+    x = z->right;
+    x_parent = z->parent;
+    transplant(tree, z, z->right);
+  } else if (!z->right) {
+    x = z->left;
+    x_parent = z->parent;
+    transplant(tree, z, z->left);
+  }
+  // Case 2: Two children -> the successor takes z's place and color
+  else {
+    ds_rbtree_node_t *y = z->right;
+    while (y->left) y = y->left;
+
+    removed_color = y->color;
+    x = y->right;
+
+    if (y->parent == z) {
+      x_parent = y;
+    } else {
+      x_parent = y->parent;
+      transplant(tree, y, y->right);
+      y->right = z->right;
+      y->right->parent = y;
+    }
+
+    transplant(tree, z, y);
+    y->left = z->left;
+    y->left->parent = y;
+    y->color = z->color;
+    y->count = z->count;
+  }
+
+  // Removing a black node shortens some paths: rebalance
+  if (removed_color == RB_BLACK) {
+    remove_fixup(tree, x, x_parent);
+  }
+
+  // Free
+  if (free_func) free_func(z->data);
+  ds_rbtree_node_free(tree, z);
+
+  tree->size --;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Get the minimum element (the "left-most" node).
+ *
+ * @param tree  Pointer to the red-black tree.
+ *
+ * @return Pointer to the minimum data, or NULL if tree is empty.
+ */
+void *ds_rbtree_min(const ds_rbtree_t *tree) {
+  // Check input parameters
+  if (!tree || !tree->root) return NULL;
+
+  ds_rbtree_node_t *curr = tree->root;
+  while (curr->left) curr = curr->left;
+
+  return curr->data;
+}
+
+/**
+ * @brief Get the maximum element (the "right-most" node).
+ *
+ * @param tree  Pointer to the red-black tree.
+ *
+ * @return Pointer to the maximum data, or NULL if tree is empty.
+ */
+void *ds_rbtree_max(const ds_rbtree_t *tree) {
+  // Check input parameters
+  if (!tree || !tree->root) return NULL;
+
+  ds_rbtree_node_t *curr = tree->root;
+  while (curr->right) curr = curr->right;
+
+  return curr->data;
+}
+
+/**
+ * @brief Perform an In-order traversal.
+ *
+ * The height is O(log n), so recursion depth is bounded.
+ *
+ * @param tree   Pointer to the red-black tree.
+ * @param visit  Callback function to process each element.
+ */
+static void inorder_node(const ds_rbtree_node_t *node, ds_visit_f visit) {
+  if (!node) return;
+
+  inorder_node(node->left, visit);
+  visit(node->data);
+  inorder_node(node->right, visit);
+}
+
+void ds_rbtree_traverse_inorder(const ds_rbtree_t *tree, ds_visit_f visit) {
+  // Check input parameters
+  if (!tree || !visit) return;
+
+  inorder_node(tree->root, visit);
+}
+
+/**
+ * @brief Get the k-th smallest element (0-based).
+ */
+void *ds_rbtree_select(const ds_rbtree_t *tree, size_t k) {
+  // Check input parameters
+  if (!tree || k >= tree->size) return NULL;
+
+  const ds_rbtree_node_t *curr = tree->root;
+  while (curr) {
+    size_t left = node_count(curr->left);
+    if (k < left) {
+      curr = curr->left;
+    } else if (k > left) {
+      k -= left + 1;
+      curr = curr->right;
+    } else {
+      return curr->data;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Count the elements that are less than key.
+ */
+size_t ds_rbtree_rank(const ds_rbtree_t *tree, const void *key) {
+  // Check input parameters
+  if (!tree || !key) return 0;
+
+  size_t rank = 0;
+  const ds_rbtree_node_t *curr = tree->root;
+  while (curr) {
+    int cmp = tree->compare(key, curr->data);
+    if (cmp <= 0) {
+      curr = curr->left;
+    } else {
+      rank += node_count(curr->left) + 1;
+      curr = curr->right;
+    }
+  }
+
+  return rank;
+}
@@ -0,0 +1,460 @@
+/*
+** src/ds_ring.c -- Implementation of the SPSC and MPMC bounded rings.
+*/
+
+#include "ds_ring.h"
+#include "ds_common.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DS_RING_DEFAULT_CAPACITY 1024
+#define DS_CACHE_LINE            64
+
+/**
+ * @brief Round up to a power of two (at least 2), or 0 on overflow.
+ */
+static size_t round_pow2(size_t n) {
+  size_t cap = 2;
+  while (cap < n) {
+    if (cap > SIZE_MAX / 2) return 0;
+    cap <<= 1;
+  }
+  return cap;
+}
+
+/* ========================================================================== */
+/*                     Single-producer / single-consumer                      */
+/* ========================================================================== */
+
+/*
+ * head and tail are free-running: size = tail - head, slot = index & mask.
+ * Each group below sits on its own cache line.
+ */
+struct ds_spsc_ring {
+  void **items;
+  size_t mask;
+  ds_allocator_t alloc;
+  char pad0[DS_CACHE_LINE];
+
+  atomic_size_t tail;          // Written by the producer
+  size_t head_cache;           // Producer's last view of head
+  char pad1[DS_CACHE_LINE];
+
+  atomic_size_t head;          // Written by the consumer
+  size_t tail_cache;           // Consumer's last view of tail
+  char pad2[DS_CACHE_LINE];
+};
+
+/**
+ * @brief Create a new SPSC ring.
+ */
+ds_spsc_ring_t *ds_spsc_ring_create(size_t capacity_hint) {
+  return ds_spsc_ring_create_ex(capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new SPSC ring using a custom allocator.
+ */
+ds_spsc_ring_t *ds_spsc_ring_create_ex(size_t capacity_hint, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  size_t capacity = round_pow2(capacity_hint == 0 ? DS_RING_DEFAULT_CAPACITY : capacity_hint);
+  if (capacity == 0 || capacity > SIZE_MAX / sizeof(void *)) return NULL;
+
+  ds_spsc_ring_t *ring = ds_mem_alloc(allocator, sizeof(ds_spsc_ring_t));
+  if (!ring) return NULL;
+
+  ring->items = ds_mem_alloc(allocator, sizeof(void *) * capacity);
+  if (!ring->items) {
+    ds_mem_free(allocator, ring, sizeof(ds_spsc_ring_t));
+    return NULL;
+  }
+
+  ring->mask = capacity - 1;
+  ring->alloc = *allocator;
+  atomic_init(&ring->tail, 0);
+  atomic_init(&ring->head, 0);
+  ring->head_cache = 0;
+  ring->tail_cache = 0;
+
+  return ring;
+}
+
+/**
+ * @brief Destroy a ring and optionally free the elements still queued.
+ */
+void ds_spsc_ring_destroy(ds_spsc_ring_t *ring, ds_free_f free_func) {
+  // Check input parameters
+  if (!ring) return;
+
+  if (free_func) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    for (; head != tail; ++ head) free_func(ring->items[head & ring->mask]);
+  }
+
+  ds_allocator_t alloc = ring->alloc;
+  ds_mem_free(&alloc, ring->items, sizeof(void *) * (ring->mask + 1));
+  ds_mem_free(&alloc, ring, sizeof(ds_spsc_ring_t));
+}
+
+/**
+ * @brief Get the (power of two) capacity.
+ */
+size_t ds_spsc_ring_capacity(const ds_spsc_ring_t *ring) {
+  if (!ring) return 0;
+
+  return ring->mask + 1;
+}
+
+/**
+ * @brief Get a snapshot of the number of queued elements.
+ */
+size_t ds_spsc_ring_size(const ds_spsc_ring_t *ring) {
+  if (!ring) return 0;
+
+  size_t head = atomic_load_explicit(&((ds_spsc_ring_t *)ring)->head, memory_order_acquire);
+  size_t tail = atomic_load_explicit(&((ds_spsc_ring_t *)ring)->tail, memory_order_acquire);
+  return tail - head;
+}
+
+/**
+ * @brief Free slots as seen by the producer, refreshing head only when
+ *        the cached value is not enough.
+ */
+static size_t spsc_free_slots(ds_spsc_ring_t *ring, size_t tail, size_t wanted) {
+  size_t capacity = ring->mask + 1;
+  size_t free_slots = capacity - (tail - ring->head_cache);
+
+  if (free_slots < wanted) {
+    ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+    free_slots = capacity - (tail - ring->head_cache);
+  }
+  return free_slots;
+}
+
+/**
+ * @brief Queued elements as seen by the consumer, refreshing tail only
+ *        when the cached value is not enough.
+ */
+static size_t spsc_ready_slots(ds_spsc_ring_t *ring, size_t head, size_t wanted) {
+  size_t ready = ring->tail_cache - head;
+
+  if (ready < wanted) {
+    ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    ready = ring->tail_cache - head;
+  }
+  return ready;
+}
+
+/**
+ * @brief Enqueue one element (producer thread only).
+ */
+ds_status_t ds_spsc_ring_try_push(ds_spsc_ring_t *ring, void *element) {
+  // Check input parameters
+  if (!ring) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  if (spsc_free_slots(ring, tail, 1) == 0) return DS_ERR_FULL;
+
+  ring->items[tail & ring->mask] = element;
+  atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Dequeue one element (consumer thread only).
+ */
+void *ds_spsc_ring_try_pop(ds_spsc_ring_t *ring) {
+  // Check input parameters
+  if (!ring) return NULL;
+
+  size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  if (spsc_ready_slots(ring, head, 1) == 0) return NULL;
+
+  void *element = ring->items[head & ring->mask];
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+  return element;
+}
+
+/**
+ * @brief Enqueue up to `count` elements at once (producer thread only).
+ */
+size_t ds_spsc_ring_try_push_batch(ds_spsc_ring_t *ring, void *const *elements, size_t count) {
+  // Check input parameters
+  if (!ring || !elements || count == 0) return 0;
+  for (size_t i = 0; i < count; ++ i) {
+    if (!elements[i]) return 0;
+  }
+
+  size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  size_t free_slots = spsc_free_slots(ring, tail, count);
+  size_t n = count < free_slots ? count : free_slots;
+  if (n == 0) return 0;
+
+  // At most two runs: up to the end of the buffer, then from its start
+  size_t start = tail & ring->mask;
+  size_t first = ring->mask + 1 - start;
+  if (first > n) first = n;
+  memcpy(&ring->items[start], elements, first * sizeof(void *));
+  memcpy(ring->items, elements + first, (n - first) * sizeof(void *));
+
+  atomic_store_explicit(&ring->tail, tail + n, memory_order_release);
+
+  return n;
+}
+
+/**
+ * @brief Dequeue up to `max` elements at once (consumer thread only).
+ */
+size_t ds_spsc_ring_try_pop_batch(ds_spsc_ring_t *ring, void **out, size_t max) {
+  // Check input parameters
+  if (!ring || !out || max == 0) return 0;
+
+  size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  size_t ready = spsc_ready_slots(ring, head, max);
+  size_t n = max < ready ? max : ready;
+  if (n == 0) return 0;
+
+  size_t start = head & ring->mask;
+  size_t first = ring->mask + 1 - start;
+  if (first > n) first = n;
+  memcpy(out, &ring->items[start], first * sizeof(void *));
+  memcpy(out + first, ring->items, (n - first) * sizeof(void *));
+
+  atomic_store_explicit(&ring->head, head + n, memory_order_release);
+
+  return n;
+}
+
+/* ========================================================================== */
+/*                      Multi-producer / multi-consumer                       */
+/* ========================================================================== */
+
+/*
+ * Slot protocol, for position `pos` mapping to cell `pos & mask`:
+ *   seq == pos            the cell is free for the producer claiming pos
+ *   seq == pos + 1        the cell holds data for the consumer claiming pos
+ *   seq == pos + mask + 1 the consumer is done; free for the next lap
+ */
+typedef struct {
+  atomic_size_t seq;
+  void *data;
+} ds_mpmc_cell_t;
+
+struct ds_mpmc_ring {
+  ds_mpmc_cell_t *cells;
+  size_t mask;
+  ds_allocator_t alloc;
+  char pad0[DS_CACHE_LINE];
+
+  atomic_size_t enqueue_pos;   // Next position to be claimed by a producer
+  char pad1[DS_CACHE_LINE];
+
+  atomic_size_t dequeue_pos;   // Next position to be claimed by a consumer
+  char pad2[DS_CACHE_LINE];
+};
+
+/**
+ * @brief Create a new MPMC ring.
+ */
+ds_mpmc_ring_t *ds_mpmc_ring_create(size_t capacity_hint) {
+  return ds_mpmc_ring_create_ex(capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new MPMC ring using a custom allocator.
+ */
+ds_mpmc_ring_t *ds_mpmc_ring_create_ex(size_t capacity_hint, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  size_t capacity = round_pow2(capacity_hint == 0 ? DS_RING_DEFAULT_CAPACITY : capacity_hint);
+  if (capacity == 0 || capacity > SIZE_MAX / sizeof(ds_mpmc_cell_t)) return NULL;
+
+  ds_mpmc_ring_t *ring = ds_mem_alloc(allocator, sizeof(ds_mpmc_ring_t));
+  if (!ring) return NULL;
+
+  ring->cells = ds_mem_alloc(allocator, sizeof(ds_mpmc_cell_t) * capacity);
+  if (!ring->cells) {
+    ds_mem_free(allocator, ring, sizeof(ds_mpmc_ring_t));
+    return NULL;
+  }
+
+  for (size_t i = 0; i < capacity; ++ i) {
+    atomic_init(&ring->cells[i].seq, i);
+    ring->cells[i].data = NULL;
+  }
+
+  ring->mask = capacity - 1;
+  ring->alloc = *allocator;
+  atomic_init(&ring->enqueue_pos, 0);
+  atomic_init(&ring->dequeue_pos, 0);
+
+  return ring;
+}
+
+/**
+ * @brief Destroy a ring and optionally free the elements still queued.
+ */
+void ds_mpmc_ring_destroy(ds_mpmc_ring_t *ring, ds_free_f free_func) {
+  // Check input parameters
+  if (!ring) return;
+
+  if (free_func) {
+    void *element;
+    while ((element = ds_mpmc_ring_try_pop(ring)) != NULL) free_func(element);
+  }
+
+  ds_allocator_t alloc = ring->alloc;
+  ds_mem_free(&alloc, ring->cells, sizeof(ds_mpmc_cell_t) * (ring->mask + 1));
+  ds_mem_free(&alloc, ring, sizeof(ds_mpmc_ring_t));
+}
+
+/**
+ * @brief Get the (power of two) capacity.
+ */
+size_t ds_mpmc_ring_capacity(const ds_mpmc_ring_t *ring) {
+  if (!ring) return 0;
+
+  return ring->mask + 1;
+}
+
+/**
+ * @brief Get a snapshot of the number of queued elements.
+ */
+size_t ds_mpmc_ring_size(const ds_mpmc_ring_t *ring) {
+  if (!ring) return 0;
+
+  ds_mpmc_ring_t *r = (ds_mpmc_ring_t *)ring;
+  size_t deq = atomic_load_explicit(&r->dequeue_pos, memory_order_acquire);
+  size_t enq = atomic_load_explicit(&r->enqueue_pos, memory_order_acquire);
+
+  // Claimed-but-unpublished positions may make deq run ahead briefly
+  return enq > deq ? enq - deq : 0;
+}
+
+/**
+ * @brief Claim a run of up to `max` consecutive positions.
+ *
+ * A cell at position `pos + i` is usable when its sequence equals
+ * `pos + i + offset` (offset 0 for producers, 1 for consumers).
+ *
+ * @return Number of positions claimed (0 if the ring is full/empty),
+ *         the first one being stored in *first.
+ */
+static size_t mpmc_claim(ds_mpmc_ring_t *ring, atomic_size_t *counter, size_t offset,
+                         size_t max, size_t *first) {
+  size_t pos = atomic_load_explicit(counter, memory_order_relaxed);
+
+  for (;;) {
+    ds_mpmc_cell_t *cell = &ring->cells[pos & ring->mask];
+    size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    intptr_t dif = (intptr_t)seq - (intptr_t)(pos + offset);
+
+    if (dif < 0) return 0;                 // Full (producer) / empty (consumer)
+    if (dif > 0) {                         // Another thread claimed pos
+      pos = atomic_load_explicit(counter, memory_order_relaxed);
+      continue;
+    }
+
+    // Extend the run over the following usable cells
+    size_t n = 1;
+    while (n < max && n <= ring->mask) {
+      ds_mpmc_cell_t *next = &ring->cells[(pos + n) & ring->mask];
+      if (atomic_load_explicit(&next->seq, memory_order_acquire) != pos + n + offset) break;
+      n ++;
+    }
+
+    if (atomic_compare_exchange_weak_explicit(counter, &pos, pos + n,
+                                              memory_order_relaxed, memory_order_relaxed)) {
+      *first = pos;
+      return n;
+    }
+    // CAS failure reloaded pos; retry
+  }
+}
+
+/**
+ * @brief Enqueue one element (any thread).
+ */
+ds_status_t ds_mpmc_ring_try_push(ds_mpmc_ring_t *ring, void *element) {
+  // Check input parameters
+  if (!ring) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  size_t pos;
+  if (mpmc_claim(ring, &ring->enqueue_pos, 0, 1, &pos) == 0) return DS_ERR_FULL;
+
+  ds_mpmc_cell_t *cell = &ring->cells[pos & ring->mask];
+  cell->data = element;
+  atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Dequeue one element (any thread).
+ */
+void *ds_mpmc_ring_try_pop(ds_mpmc_ring_t *ring) {
+  // Check input parameters
+  if (!ring) return NULL;
+
+  size_t pos;
+  if (mpmc_claim(ring, &ring->dequeue_pos, 1, 1, &pos) == 0) return NULL;
+
+  ds_mpmc_cell_t *cell = &ring->cells[pos & ring->mask];
+  void *element = cell->data;
+  atomic_store_explicit(&cell->seq, pos + ring->mask + 1, memory_order_release);
+
+  return element;
+}
+
+/**
+ * @brief Enqueue up to `count` elements (any thread).
+ */
+size_t ds_mpmc_ring_try_push_batch(ds_mpmc_ring_t *ring, void *const *elements, size_t count) {
+  // Check input parameters
+  if (!ring || !elements || count == 0) return 0;
+  for (size_t i = 0; i < count; ++ i) {
+    if (!elements[i]) return 0;
+  }
+
+  size_t pos;
+  size_t n = mpmc_claim(ring, &ring->enqueue_pos, 0, count, &pos);
+
+  for (size_t i = 0; i < n; ++ i) {
+    ds_mpmc_cell_t *cell = &ring->cells[(pos + i) & ring->mask];
+    cell->data = elements[i];
+    atomic_store_explicit(&cell->seq, pos + i + 1, memory_order_release);
+  }
+
+  return n;
+}
+
+/**
+ * @brief Dequeue up to `max` elements (any thread).
+ */
+size_t ds_mpmc_ring_try_pop_batch(ds_mpmc_ring_t *ring, void **out, size_t max) {
+  // Check input parameters
+  if (!ring || !out || max == 0) return 0;
+
+  size_t pos;
+  size_t n = mpmc_claim(ring, &ring->dequeue_pos, 1, max, &pos);
+
+  for (size_t i = 0; i < n; ++ i) {
+    ds_mpmc_cell_t *cell = &ring->cells[(pos + i) & ring->mask];
+    out[i] = cell->data;
+    atomic_store_explicit(&cell->seq, pos + i + ring->mask + 1, memory_order_release);
+  }
+
+  return n;
+}
@@ -0,0 +1,908 @@
+/*
+** src/ds_simd.c -- Scalar, SSE2, AVX2 and NEON kernels and the runtime
+**                  dispatcher choosing between them.
+*/
+
+#include "ds_simd.h"
+#include "ds_common.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// AVX2 kernels are compiled for that target only, and picked at run time
+#if defined(DS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define DS_SIMD_HAVE_AVX2 1
+#define DS_AVX2 __attribute__((target("avx2")))
+#endif
+
+#define LOWER_BOUND_WINDOW 16   // Elements left to the vector count
+
+// Vector counters are folded into a size_t before their lanes can wrap
+#define COUNT_BLOCK ((size_t)1 << 20)
+
+typedef struct {
+  ds_simd_isa_t isa;
+  size_t (*find_i32)(const int32_t *a, size_t n, int32_t v);
+  size_t (*count_i32)(const int32_t *a, size_t n, int32_t v);
+  void   (*minmax_i32)(const int32_t *a, size_t n, int32_t *min, int32_t *max);   // n > 0
+  void   (*fill_i32)(int32_t *a, size_t n, int32_t v);
+  size_t (*count_less_i32)(const int32_t *a, size_t n, int32_t v);
+  size_t (*find_i64)(const int64_t *a, size_t n, int64_t v);
+  size_t (*count_i64)(const int64_t *a, size_t n, int64_t v);
+  void   (*minmax_i64)(const int64_t *a, size_t n, int64_t *min, int64_t *max);   // n > 0
+  void   (*fill_i64)(int64_t *a, size_t n, int64_t v);
+  size_t (*count_less_i64)(const int64_t *a, size_t n, int64_t v);
+} simd_kernels_t;
+
+/**
+ * @brief Index of the lowest set bit (mask != 0).
+ */
+static inline unsigned simd_ctz(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctz(mask);
+#else
+  unsigned n = 0;
+  while (!(mask & 1u)) { mask >>= 1; n ++; }
+  return n;
+#endif
+}
+
+/* ===================== Scalar ===================== */
+
+static size_t scalar_find_i32(const int32_t *a, size_t n, int32_t v) {
+  for (size_t i = 0; i < n; ++ i) if (a[i] == v) return i;
+  return SIZE_MAX;
+}
+
+static size_t scalar_count_i32(const int32_t *a, size_t n, int32_t v) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++ i) c += a[i] == v;
+  return c;
+}
+
+static void scalar_minmax_i32(const int32_t *a, size_t n, int32_t *min, int32_t *max) {
+  int32_t lo = a[0], hi = a[0];
+  for (size_t i = 1; i < n; ++ i) {
+    if (a[i] < lo) lo = a[i];
+    if (a[i] > hi) hi = a[i];
+  }
+  *min = lo;
+  *max = hi;
+}
+
+static void scalar_fill_i32(int32_t *a, size_t n, int32_t v) {
+  for (size_t i = 0; i < n; ++ i) a[i] = v;
+}
+
+static size_t scalar_count_less_i32(const int32_t *a, size_t n, int32_t v) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++ i) c += a[i] < v;
+  return c;
+}
+
+static size_t scalar_find_i64(const int64_t *a, size_t n, int64_t v) {
+  for (size_t i = 0; i < n; ++ i) if (a[i] == v) return i;
+  return SIZE_MAX;
+}
+
+static size_t scalar_count_i64(const int64_t *a, size_t n, int64_t v) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++ i) c += a[i] == v;
+  return c;
+}
+
+static void scalar_minmax_i64(const int64_t *a, size_t n, int64_t *min, int64_t *max) {
+  int64_t lo = a[0], hi = a[0];
+  for (size_t i = 1; i < n; ++ i) {
+    if (a[i] < lo) lo = a[i];
+    if (a[i] > hi) hi = a[i];
+  }
+  *min = lo;
+  *max = hi;
+}
+
+static void scalar_fill_i64(int64_t *a, size_t n, int64_t v) {
+  for (size_t i = 0; i < n; ++ i) a[i] = v;
+}
+
+static size_t scalar_count_less_i64(const int64_t *a, size_t n, int64_t v) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++ i) c += a[i] < v;
+  return c;
+}
+
+static const simd_kernels_t scalar_kernels = {
+  DS_SIMD_SCALAR,
+  scalar_find_i32, scalar_count_i32, scalar_minmax_i32, scalar_fill_i32, scalar_count_less_i32,
+  scalar_find_i64, scalar_count_i64, scalar_minmax_i64, scalar_fill_i64, scalar_count_less_i64,
+};
+
+/* ===================== SSE2 ===================== */
+
+#if defined(__SSE2__)
+
+static size_t sse2_find_i32(const int32_t *a, size_t n, int32_t v) {
+  __m128i x = _mm_set1_epi32(v);
+  size_t i = 0;
+
+  for (; i + 16 <= n; i += 16) {
+    __m128i e0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a + i)), x);
+    __m128i e1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a + i + 4)), x);
+    __m128i e2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a + i + 8)), x);
+    __m128i e3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a + i + 12)), x);
+    __m128i any = _mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3));
+    if (!_mm_movemask_epi8(any)) continue;
+
+    // Hit somewhere in these 16: find the first vector that has it
+    uint32_t m;
+    if ((m = (uint32_t)_mm_movemask_epi8(e0))) return i + simd_ctz(m) / 4;
+    if ((m = (uint32_t)_mm_movemask_epi8(e1))) return i + 4 + simd_ctz(m) / 4;
+    if ((m = (uint32_t)_mm_movemask_epi8(e2))) return i + 8 + simd_ctz(m) / 4;
+    m = (uint32_t)_mm_movemask_epi8(e3);
+    return i + 12 + simd_ctz(m) / 4;
+  }
+
+  size_t tail = scalar_find_i32(a + i, n - i, v);
+  return tail == SIZE_MAX ? SIZE_MAX : i + tail;
+}
+
+/**
+ * @brief Sum the four 32-bit lanes of a counter.
+ */
+static inline size_t sse2_hsum_u32(__m128i acc) {
+  uint32_t lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, acc);
+  return (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+static size_t sse2_count_i32(const int32_t *a, size_t n, int32_t v) {
+  __m128i x = _mm_set1_epi32(v);
+  size_t c = 0, i = 0;
+
+  while (i + 4 <= n) {
+    size_t stop = n - i > COUNT_BLOCK ? i + COUNT_BLOCK : n;
+    __m128i acc = _mm_setzero_si128();
+    // A matching lane is -1, so subtracting counts it
+    for (; i + 4 <= stop; i += 4) {
+      acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a + i)), x));
+    }
+    c += sse2_hsum_u32(acc);
+  }
+
+  return c + scalar_count_i32(a + i, n - i, v);
+}
+
+static void sse2_minmax_i32(const int32_t *a, size_t n, int32_t *min, int32_t *max) {
+  size_t i = 0;
+  int32_t lo = a[0], hi = a[0];
+
+  if (n >= 4) {
+    __m128i vlo = _mm_loadu_si128((const __m128i *)a), vhi = vlo;
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+      // No pminsd/pmaxsd before SSE4.1: select through a compare mask
+      __m128i lt = _mm_cmplt_epi32(x, vlo);
+      __m128i gt = _mm_cmpgt_epi32(x, vhi);
+      vlo = _mm_or_si128(_mm_and_si128(lt, x), _mm_andnot_si128(lt, vlo));
+      vhi = _mm_or_si128(_mm_and_si128(gt, x), _mm_andnot_si128(gt, vhi));
+    }
+
+    int32_t l[4], h[4];
+    _mm_storeu_si128((__m128i *)l, vlo);
+    _mm_storeu_si128((__m128i *)h, vhi);
+    lo = l[0];
+    hi = h[0];
+    for (int k = 1; k < 4; ++ k) {
+      if (l[k] < lo) lo = l[k];
+      if (h[k] > hi) hi = h[k];
+    }
+  }
+
+  for (; i < n; ++ i) {
+    if (a[i] < lo) lo = a[i];
+    if (a[i] > hi) hi = a[i];
+  }
+  *min = lo;
+  *max = hi;
+}
+
+static void sse2_fill_i32(int32_t *a, size_t n, int32_t v) {
+  __m128i x = _mm_set1_epi32(v);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm_storeu_si128((__m128i *)(a + i), x);
+  for (; i < n; ++ i) a[i] = v;
+}
+
+static size_t sse2_count_less_i32(const int32_t *a, size_t n, int32_t v) {
+  __m128i x = _mm_set1_epi32(v);
+  __m128i acc = _mm_setzero_si128();
+  size_t i = 0;
+
+  // Only used on lower_bound windows, far below COUNT_BLOCK
+  for (; i + 4 <= n; i += 4) {
+    acc = _mm_sub_epi32(acc, _mm_cmplt_epi32(_mm_loadu_si128((const __m128i *)(a + i)), x));
+  }
+
+  return sse2_hsum_u32(acc) + scalar_count_less_i32(a + i, n - i, v);
+}
+
+/**
+ * @brief 64-bit equality from 32-bit compares: both halves must match.
+ */
+static inline __m128i sse2_cmpeq_epi64(__m128i a, __m128i b) {
+  __m128i e = _mm_cmpeq_epi32(a, b);
+  return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+static size_t sse2_find_i64(const int64_t *a, size_t n, int64_t v) {
+  __m128i x = _mm_set1_epi64x(v);
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    __m128i e0 = sse2_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(a + i)), x);
+    __m128i e1 = sse2_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(a + i + 2)), x);
+    __m128i e2 = sse2_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(a + i + 4)), x);
+    __m128i e3 = sse2_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(a + i + 6)), x);
+    __m128i any = _mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3));
+    if (!_mm_movemask_epi8(any)) continue;
+
+    uint32_t m;
+    if ((m = (uint32_t)_mm_movemask_epi8(e0))) return i + simd_ctz(m) / 8;
+    if ((m = (uint32_t)_mm_movemask_epi8(e1))) return i + 2 + simd_ctz(m) / 8;
+    if ((m = (uint32_t)_mm_movemask_epi8(e2))) return i + 4 + simd_ctz(m) / 8;
+    m = (uint32_t)_mm_movemask_epi8(e3);
+    return i + 6 + simd_ctz(m) / 8;
+  }
+
+  size_t tail = scalar_find_i64(a + i, n - i, v);
+  return tail == SIZE_MAX ? SIZE_MAX : i + tail;
+}
+
+static size_t sse2_count_i64(const int64_t *a, size_t n, int64_t v) {
+  __m128i x = _mm_set1_epi64x(v);
+  __m128i acc = _mm_setzero_si128();
+  size_t i = 0;
+
+  // 64-bit lanes cannot wrap
+  for (; i + 2 <= n; i += 2) {
+    acc = _mm_sub_epi64(acc, sse2_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(a + i)), x));
+  }
+
+  uint64_t lanes[2];
+  _mm_storeu_si128((__m128i *)lanes, acc);
+  return (size_t)(lanes[0] + lanes[1]) + scalar_count_i64(a + i, n - i, v);
+}
+
+static void sse2_fill_i64(int64_t *a, size_t n, int64_t v) {
+  __m128i x = _mm_set1_epi64x(v);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) _mm_storeu_si128((__m128i *)(a + i), x);
+  for (; i < n; ++ i) a[i] = v;
+}
+
+// SSE2 has no 64-bit ordered compare: minmax and count_less stay scalar
+static const simd_kernels_t sse2_kernels = {
+  DS_SIMD_SSE2,
+  sse2_find_i32, sse2_count_i32, sse2_minmax_i32, sse2_fill_i32, sse2_count_less_i32,
+  sse2_find_i64, sse2_count_i64, scalar_minmax_i64, sse2_fill_i64, scalar_count_less_i64,
+};
+
+#endif // __SSE2__
+
+/* ===================== AVX2 ===================== */
+
+#if defined(DS_SIMD_HAVE_AVX2)
+
+DS_AVX2 static size_t avx2_find_i32(const int32_t *a, size_t n, int32_t v) {
+  __m256i x = _mm256_set1_epi32(v);
+  size_t i = 0;
+
+  for (; i + 32 <= n; i += 32) {
+    __m256i e0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a + i)), x);
+    __m256i e1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a + i + 8)), x);
+    __m256i e2 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a + i + 16)), x);
+    __m256i e3 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a + i + 24)), x);
+    __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+    if (_mm256_testz_si256(any, any)) continue;
+
+    uint32_t m;
+    if ((m = (uint32_t)_mm256_movemask_epi8(e0))) return i + simd_ctz(m) / 4;
+    if ((m = (uint32_t)_mm256_movemask_epi8(e1))) return i + 8 + simd_ctz(m) / 4;
+    if ((m = (uint32_t)_mm256_movemask_epi8(e2))) return i + 16 + simd_ctz(m) / 4;
+    m = (uint32_t)_mm256_movemask_epi8(e3);
+    return i + 24 + simd_ctz(m) / 4;
+  }
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i e = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a + i)), x);
+    uint32_t m = (uint32_t)_mm256_movemask_epi8(e);
+    if (m) return i + simd_ctz(m) / 4;
+  }
+
+  size_t tail = scalar_find_i32(a + i, n - i, v);
+  return tail == SIZE_MAX ? SIZE_MAX : i + tail;
+}
+
+DS_AVX2 static inline size_t avx2_hsum_u32(__m256i acc) {
+  uint32_t lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, acc);
+  size_t s = 0;
+  for (int k = 0; k < 8; ++ k) s += lanes[k];
+  return s;
+}
+
+DS_AVX2 static size_t avx2_count_i32(const int32_t *a, size_t n, int32_t v) {
+  __m256i x = _mm256_set1_epi32(v);
+  size_t c = 0, i = 0;
+
+  while (i + 8 <= n) {
+    size_t stop = n - i > COUNT_BLOCK ? i + COUNT_BLOCK : n;
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 8 <= stop; i += 8) {
+      acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a + i)), x));
+    }
+    c += avx2_hsum_u32(acc);
+  }
+
+  return c + scalar_count_i32(a + i, n - i, v);
+}
+
+DS_AVX2 static void avx2_minmax_i32(const int32_t *a, size_t n, int32_t *min, int32_t *max) {
+  size_t i = 0;
+  int32_t lo = a[0], hi = a[0];
+
+  if (n >= 8) {
+    __m256i vlo = _mm256_loadu_si256((const __m256i *)a), vhi = vlo;
+    for (i = 8; i + 8 <= n; i += 8) {
+      __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+      vlo = _mm256_min_epi32(vlo, x);
+      vhi = _mm256_max_epi32(vhi, x);
+    }
+
+    int32_t l[8], h[8];
+    _mm256_storeu_si256((__m256i *)l, vlo);
+    _mm256_storeu_si256((__m256i *)h, vhi);
+    lo = l[0];
+    hi = h[0];
+    for (int k = 1; k < 8; ++ k) {
+      if (l[k] < lo) lo = l[k];
+      if (h[k] > hi) hi = h[k];
+    }
+  }
+
+  for (; i < n; ++ i) {
+    if (a[i] < lo) lo = a[i];
+    if (a[i] > hi) hi = a[i];
+  }
+  *min = lo;
+  *max = hi;
+}
+
+DS_AVX2 static void avx2_fill_i32(int32_t *a, size_t n, int32_t v) {
+  __m256i x = _mm256_set1_epi32(v);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) _mm256_storeu_si256((__m256i *)(a + i), x);
+  for (; i < n; ++ i) a[i] = v;
+}
+
+DS_AVX2 static size_t avx2_count_less_i32(const int32_t *a, size_t n, int32_t v) {
+  __m256i x = _mm256_set1_epi32(v);
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(x, _mm256_loadu_si256((const __m256i *)(a + i))));
+  }
+
+  return avx2_hsum_u32(acc) + scalar_count_less_i32(a + i, n - i, v);
+}
+
+DS_AVX2 static size_t avx2_find_i64(const int64_t *a, size_t n, int64_t v) {
+  __m256i x = _mm256_set1_epi64x(v);
+  size_t i = 0;
+
+  for (; i + 16 <= n; i += 16) {
+    __m256i e0 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a + i)), x);
+    __m256i e1 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a + i + 4)), x);
+    __m256i e2 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a + i + 8)), x);
+    __m256i e3 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a + i + 12)), x);
+    __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+    if (_mm256_testz_si256(any, any)) continue;
+
+    uint32_t m;
+    if ((m = (uint32_t)_mm256_movemask_epi8(e0))) return i + simd_ctz(m) / 8;
+    if ((m = (uint32_t)_mm256_movemask_epi8(e1))) return i + 4 + simd_ctz(m) / 8;
+    if ((m = (uint32_t)_mm256_movemask_epi8(e2))) return i + 8 + simd_ctz(m) / 8;
+    m = (uint32_t)_mm256_movemask_epi8(e3);
+    return i + 12 + simd_ctz(m) / 8;
+  }
+
+  for (; i + 4 <= n; i += 4) {
+    __m256i e = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a + i)), x);
+    uint32_t m = (uint32_t)_mm256_movemask_epi8(e);
+    if (m) return i + simd_ctz(m) / 8;
+  }
+
+  size_t tail = scalar_find_i64(a + i, n - i, v);
+  return tail == SIZE_MAX ? SIZE_MAX : i + tail;
+}
+
+DS_AVX2 static inline size_t avx2_hsum_u64(__m256i acc) {
+  uint64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, acc);
+  return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+DS_AVX2 static size_t avx2_count_i64(const int64_t *a, size_t n, int64_t v) {
+  __m256i x = _mm256_set1_epi64x(v);
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    acc = _mm256_sub_epi64(acc, _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a + i)), x));
+  }
+
+  return avx2_hsum_u64(acc) + scalar_count_i64(a + i, n - i, v);
+}
+
+DS_AVX2 static void avx2_minmax_i64(const int64_t *a, size_t n, int64_t *min, int64_t *max) {
+  size_t i = 0;
+  int64_t lo = a[0], hi = a[0];
+
+  if (n >= 4) {
+    __m256i vlo = _mm256_loadu_si256((const __m256i *)a), vhi = vlo;
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+      // No 64-bit min/max before AVX-512: blend on a compare mask
+      vlo = _mm256_blendv_epi8(vlo, x, _mm256_cmpgt_epi64(vlo, x));
+      vhi = _mm256_blendv_epi8(vhi, x, _mm256_cmpgt_epi64(x, vhi));
+    }
+
+    int64_t l[4], h[4];
+    _mm256_storeu_si256((__m256i *)l, vlo);
+    _mm256_storeu_si256((__m256i *)h, vhi);
+    lo = l[0];
+    hi = h[0];
+    for (int k = 1; k < 4; ++ k) {
+      if (l[k] < lo) lo = l[k];
+      if (h[k] > hi) hi = h[k];
+    }
+  }
+
+  for (; i < n; ++ i) {
+    if (a[i] < lo) lo = a[i];
+    if (a[i] > hi) hi = a[i];
+  }
+  *min = lo;
+  *max = hi;
+}
+
+DS_AVX2 static void avx2_fill_i64(int64_t *a, size_t n, int64_t v) {
+  __m256i x = _mm256_set1_epi64x(v);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm256_storeu_si256((__m256i *)(a + i), x);
+  for (; i < n; ++ i) a[i] = v;
+}
+
+DS_AVX2 static size_t avx2_count_less_i64(const int64_t *a, size_t n, int64_t v) {
+  __m256i x = _mm256_set1_epi64x(v);
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    acc = _mm256_sub_epi64(acc, _mm256_cmpgt_epi64(x, _mm256_loadu_si256((const __m256i *)(a + i))));
+  }
+
+  return avx2_hsum_u64(acc) + scalar_count_less_i64(a + i, n - i, v);
+}
+
+static const simd_kernels_t avx2_kernels = {
+  DS_SIMD_AVX2,
+  avx2_find_i32, avx2_count_i32, avx2_minmax_i32, avx2_fill_i32, avx2_count_less_i32,
+  avx2_find_i64, avx2_count_i64, avx2_minmax_i64, avx2_fill_i64, avx2_count_less_i64,
+};
+
+#endif // DS_SIMD_HAVE_AVX2
+
+/* ===================== NEON ===================== */
+
+#if defined(__aarch64__)
+
+static size_t neon_find_i32(const int32_t *a, size_t n, int32_t v) {
+  int32x4_t x = vdupq_n_s32(v);
+  size_t i = 0;
+
+  for (; i + 16 <= n; i += 16) {
+    uint32x4_t e0 = vceqq_s32(vld1q_s32(a + i), x);
+    uint32x4_t e1 = vceqq_s32(vld1q_s32(a + i + 4), x);
+    uint32x4_t e2 = vceqq_s32(vld1q_s32(a + i + 8), x);
+    uint32x4_t e3 = vceqq_s32(vld1q_s32(a + i + 12), x);
+    uint32x4_t any = vorrq_u32(vorrq_u32(e0, e1), vorrq_u32(e2, e3));
+    if (vmaxvq_u32(any) == 0) continue;
+
+    // No movemask on NEON: let the scalar loop locate the hit
+    return i + scalar_find_i32(a + i, 16, v);
+  }
+
+  size_t tail = scalar_find_i32(a + i, n - i, v);
+  return tail == SIZE_MAX ? SIZE_MAX : i + tail;
+}
+
+static size_t neon_count_i32(const int32_t *a, size_t n, int32_t v) {
+  int32x4_t x = vdupq_n_s32(v);
+  size_t c = 0, i = 0;
+
+  while (i + 4 <= n) {
+    size_t stop = n - i > COUNT_BLOCK ? i + COUNT_BLOCK : n;
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (; i + 4 <= stop; i += 4) acc = vsubq_u32(acc, vceqq_s32(vld1q_s32(a + i), x));
+    c += vaddvq_u32(acc);
+  }
+
+  return c + scalar_count_i32(a + i, n - i, v);
+}
+
+static void neon_minmax_i32(const int32_t *a, size_t n, int32_t *min, int32_t *max) {
+  size_t i = 0;
+  int32_t lo = a[0], hi = a[0];
+
+  if (n >= 4) {
+    int32x4_t vlo = vld1q_s32(a), vhi = vlo;
+    for (i = 4; i + 4 <= n; i += 4) {
+      int32x4_t x = vld1q_s32(a + i);
+      vlo = vminq_s32(vlo, x);
+      vhi = vmaxq_s32(vhi, x);
+    }
+    lo = vminvq_s32(vlo);
+    hi = vmaxvq_s32(vhi);
+  }
+
+  for (; i < n; ++ i) {
+    if (a[i] < lo) lo = a[i];
+    if (a[i] > hi) hi = a[i];
+  }
+  *min = lo;
+  *max = hi;
+}
+
+static void neon_fill_i32(int32_t *a, size_t n, int32_t v) {
+  int32x4_t x = vdupq_n_s32(v);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) vst1q_s32(a + i, x);
+  for (; i < n; ++ i) a[i] = v;
+}
+
+static size_t neon_count_less_i32(const int32_t *a, size_t n, int32_t v) {
+  int32x4_t x = vdupq_n_s32(v);
+  uint32x4_t acc = vdupq_n_u32(0);
+  size_t i = 0;
+
+  for (; i + 4 <= n; i += 4) acc = vsubq_u32(acc, vcltq_s32(vld1q_s32(a + i), x));
+
+  return vaddvq_u32(acc) + scalar_count_less_i32(a + i, n - i, v);
+}
+
+static size_t neon_find_i64(const int64_t *a, size_t n, int64_t v) {
+  int64x2_t x = vdupq_n_s64(v);
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    uint64x2_t e0 = vceqq_s64(vld1q_s64(a + i), x);
+    uint64x2_t e1 = vceqq_s64(vld1q_s64(a + i + 2), x);
+    uint64x2_t e2 = vceqq_s64(vld1q_s64(a + i + 4), x);
+    uint64x2_t e3 = vceqq_s64(vld1q_s64(a + i + 6), x);
+    uint64x2_t any = vorrq_u64(vorrq_u64(e0, e1), vorrq_u64(e2, e3));
+    if (vmaxvq_u32(vreinterpretq_u32_u64(any)) == 0) continue;
+
+    return i + scalar_find_i64(a + i, 8, v);
+  }
+
+  size_t tail = scalar_find_i64(a + i, n - i, v);
+  return tail == SIZE_MAX ? SIZE_MAX : i + tail;
+}
+
+static size_t neon_count_i64(const int64_t *a, size_t n, int64_t v) {
+  int64x2_t x = vdupq_n_s64(v);
+  uint64x2_t acc = vdupq_n_u64(0);
+  size_t i = 0;
+
+  for (; i + 2 <= n; i += 2) acc = vsubq_u64(acc, vceqq_s64(vld1q_s64(a + i), x));
+
+  return (size_t)vaddvq_u64(acc) + scalar_count_i64(a + i, n - i, v);
+}
+
+static void neon_minmax_i64(const int64_t *a, size_t n, int64_t *min, int64_t *max) {
+  size_t i = 0;
+  int64_t lo = a[0], hi = a[0];
+
+  if (n >= 2) {
+    int64x2_t vlo = vld1q_s64(a), vhi = vlo;
+    for (i = 2; i + 2 <= n; i += 2) {
+      int64x2_t x = vld1q_s64(a + i);
+      vlo = vbslq_s64(vcgtq_s64(vlo, x), x, vlo);
+      vhi = vbslq_s64(vcgtq_s64(x, vhi), x, vhi);
+    }
+    int64_t l0 = vgetq_lane_s64(vlo, 0), l1 = vgetq_lane_s64(vlo, 1);
+    int64_t h0 = vgetq_lane_s64(vhi, 0), h1 = vgetq_lane_s64(vhi, 1);
+    lo = l0 < l1 ? l0 : l1;
+    hi = h0 > h1 ? h0 : h1;
+  }
+
+  for (; i < n; ++ i) {
+    if (a[i] < lo) lo = a[i];
+    if (a[i] > hi) hi = a[i];
+  }
+  *min = lo;
+  *max = hi;
+}
+
+static void neon_fill_i64(int64_t *a, size_t n, int64_t v) {
+  int64x2_t x = vdupq_n_s64(v);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) vst1q_s64(a + i, x);
+  for (; i < n; ++ i) a[i] = v;
+}
+
+static size_t neon_count_less_i64(const int64_t *a, size_t n, int64_t v) {
+  int64x2_t x = vdupq_n_s64(v);
+  uint64x2_t acc = vdupq_n_u64(0);
+  size_t i = 0;
+
+  for (; i + 2 <= n; i += 2) acc = vsubq_u64(acc, vcltq_s64(vld1q_s64(a + i), x));
+
+  return (size_t)vaddvq_u64(acc) + scalar_count_less_i64(a + i, n - i, v);
+}
+
+static const simd_kernels_t neon_kernels = {
+  DS_SIMD_NEON,
+  neon_find_i32, neon_count_i32, neon_minmax_i32, neon_fill_i32, neon_count_less_i32,
+  neon_find_i64, neon_count_i64, neon_minmax_i64, neon_fill_i64, neon_count_less_i64,
+};
+
+#endif // __aarch64__
+
+/* ===================== Dispatch ===================== */
+
+static _Atomic(const simd_kernels_t *) g_kernels = NULL;
+
+/**
+ * @brief Kernel table of an instruction set, or NULL if unavailable.
+ */
+static const simd_kernels_t *kernels_for(ds_simd_isa_t isa) {
+  switch (isa) {
+    case DS_SIMD_SCALAR:
+      return &scalar_kernels;
+#if defined(__SSE2__)
+    case DS_SIMD_SSE2:
+      return &sse2_kernels;
+#endif
+#if defined(DS_SIMD_HAVE_AVX2)
+    case DS_SIMD_AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? &avx2_kernels : NULL;
+#endif
+#if defined(__aarch64__)
+    case DS_SIMD_NEON:
+      return &neon_kernels;
+#endif
+    default:
+      return NULL;
+  }
+}
+
+/**
+ * @brief The active table, picking the widest one on first use.
+ *
+ * Racing first calls all store the same table, so a relaxed store is enough.
+ */
+static inline const simd_kernels_t *kernels(void) {
+  const simd_kernels_t *k = atomic_load_explicit(&g_kernels, memory_order_relaxed);
+  if (k) return k;
+
+  static const ds_simd_isa_t preference[] = { DS_SIMD_AVX2, DS_SIMD_NEON, DS_SIMD_SSE2 };
+  k = &scalar_kernels;
+  for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); ++ i) {
+    const simd_kernels_t *cand = kernels_for(preference[i]);
+    if (cand) { k = cand; break; }
+  }
+
+  atomic_store_explicit(&g_kernels, k, memory_order_relaxed);
+  return k;
+}
+
+/**
+ * @brief Get the instruction set the kernels currently dispatch to.
+ */
+ds_simd_isa_t ds_simd_active_isa(void) {
+  return kernels()->isa;
+}
+
+/**
+ * @brief Check whether this build and CPU can run an instruction set.
+ */
+bool ds_simd_isa_supported(ds_simd_isa_t isa) {
+  return kernels_for(isa) != NULL;
+}
+
+/**
+ * @brief Dispatch all later calls to one instruction set.
+ */
+ds_status_t ds_simd_force_isa(ds_simd_isa_t isa) {
+  const simd_kernels_t *k = kernels_for(isa);
+  if (!k) return DS_ERR_ARG;
+
+  atomic_store_explicit(&g_kernels, k, memory_order_relaxed);
+  return DS_OK;
+}
+
+/**
+ * @brief Get a printable name.
+ */
+const char *ds_simd_isa_name(ds_simd_isa_t isa) {
+  switch (isa) {
+    case DS_SIMD_SCALAR: return "scalar";
+    case DS_SIMD_SSE2:   return "sse2";
+    case DS_SIMD_AVX2:   return "avx2";
+    case DS_SIMD_NEON:   return "neon";
+    default:             return "unknown";
+  }
+}
+
+/* ===================== API ===================== */
+
+/**
+ * @brief Index of the first element equal to `value`.
+ */
+size_t ds_simd_find_i32(const int32_t *array, size_t n, int32_t value) {
+  if (!array || n == 0) return SIZE_MAX;
+
+  return kernels()->find_i32(array, n, value);
+}
+
+/**
+ * @brief Number of elements equal to `value`.
+ */
+size_t ds_simd_count_i32(const int32_t *array, size_t n, int32_t value) {
+  if (!array || n == 0) return 0;
+
+  return kernels()->count_i32(array, n, value);
+}
+
+/**
+ * @brief Smallest and largest element.
+ */
+ds_status_t ds_simd_minmax_i32(const int32_t *array, size_t n, int32_t *min, int32_t *max) {
+  // Check input parameters
+  if (!array) return DS_ERR_NULL;
+  if (n == 0) return DS_ERR_EMPTY;
+
+  int32_t lo, hi;
+  kernels()->minmax_i32(array, n, &lo, &hi);
+  if (min) *min = lo;
+  if (max) *max = hi;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Set all `n` elements to `value`.
+ */
+void ds_simd_fill_i32(int32_t *array, size_t n, int32_t value) {
+  if (!array || n == 0) return;
+
+  kernels()->fill_i32(array, n, value);
+}
+
+/**
+ * @brief First index whose element is not less than `value`.
+ *
+ * The answer always lies in [base, base + len]. Each halving step keeps
+ * that invariant without a data-dependent branch; once the window is
+ * small, the elements below `value` form its prefix and counting them
+ * gives the answer.
+ */
+size_t ds_simd_lower_bound_i32(const int32_t *array, size_t n, int32_t value) {
+  if (!array || n == 0) return 0;
+
+  size_t base = 0, len = n;
+  while (len > LOWER_BOUND_WINDOW) {
+    size_t half = len / 2;
+    base = array[base + half] < value ? base + half : base;
+    len -= half;
+  }
+
+  return base + kernels()->count_less_i32(array + base, len, value);
+}
+
+/**
+ * @brief 64-bit variants.
+ */
+size_t ds_simd_find_i64(const int64_t *array, size_t n, int64_t value) {
+  if (!array || n == 0) return SIZE_MAX;
+
+  return kernels()->find_i64(array, n, value);
+}
+
+size_t ds_simd_count_i64(const int64_t *array, size_t n, int64_t value) {
+  if (!array || n == 0) return 0;
+
+  return kernels()->count_i64(array, n, value);
+}
+
+ds_status_t ds_simd_minmax_i64(const int64_t *array, size_t n, int64_t *min, int64_t *max) {
+  // Check input parameters
+  if (!array) return DS_ERR_NULL;
+  if (n == 0) return DS_ERR_EMPTY;
+
+  int64_t lo, hi;
+  kernels()->minmax_i64(array, n, &lo, &hi);
+  if (min) *min = lo;
+  if (max) *max = hi;
+
+  return DS_OK;
+}
+
+void ds_simd_fill_i64(int64_t *array, size_t n, int64_t value) {
+  if (!array || n == 0) return;
+
+  kernels()->fill_i64(array, n, value);
+}
+
+size_t ds_simd_lower_bound_i64(const int64_t *array, size_t n, int64_t value) {
+  if (!array || n == 0) return 0;
+
+  size_t base = 0, len = n;
+  while (len > LOWER_BOUND_WINDOW) {
+    size_t half = len / 2;
+    base = array[base + half] < value ? base + half : base;
+    len -= half;
+  }
+
+  return base + kernels()->count_less_i64(array + base, len, value);
+}
+
+/**
+ * @brief Index of the first pointer identical to `value`.
+ *
+ * Pointers are compared by their bits through the integer kernel of
+ * the same width.
+ */
+size_t ds_simd_find_ptr(void *const *array, size_t n, const void *value) {
+  if (!array || n == 0) return SIZE_MAX;
+
+#if UINTPTR_MAX == UINT64_MAX
+  return kernels()->find_i64((const int64_t *)(const void *)array, n, (int64_t)(intptr_t)value);
+#elif UINTPTR_MAX == UINT32_MAX
+  return kernels()->find_i32((const int32_t *)(const void *)array, n, (int32_t)(intptr_t)value);
+#else
+  for (size_t i = 0; i < n; ++ i) if (array[i] == value) return i;
+  return SIZE_MAX;
+#endif
+}
+
+/**
+ * @brief Number of pointers identical to `value`.
+ */
+size_t ds_simd_count_ptr(void *const *array, size_t n, const void *value) {
+  if (!array || n == 0) return 0;
+
+#if UINTPTR_MAX == UINT64_MAX
+  return kernels()->count_i64((const int64_t *)(const void *)array, n, (int64_t)(intptr_t)value);
+#elif UINTPTR_MAX == UINT32_MAX
+  return kernels()->count_i32((const int32_t *)(const void *)array, n, (int32_t)(intptr_t)value);
+#else
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++ i) c += array[i] == value;
+  return c;
+#endif
+}
@@ -0,0 +1,622 @@
+/*
+** src/ds_snapshot.c -- Flat (mappable) and record snapshots.
+*/
+
+#define _POSIX_C_SOURCE 200809L  // fstat/mmap/fileno under strict -std=c11
+
+#include "ds_snapshot.h"
+#include "ds_bst.h"
+#include "ds_common.h"
+#include "ds_heap.h"
+#include "ds_span.h"
+#include "ds_vec.h"
+#include "ds_vector.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SNAP_VERSION     1
+#define SNAP_BYTE_ORDER  0x01020304u
+#define SNAP_ALIGN       64          // Payload offset alignment
+
+static const char SNAP_MAGIC[8] = "DSSNAP1";
+
+/*
+ * File header, 64 bytes, native byte order. `byte_order` reads back as
+ * SNAP_BYTE_ORDER only on a machine with the writer's endianness.
+ */
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t kind;          // ds_snapshot_kind_t
+  uint64_t elem_size;     // Flat: bytes per element. Records: 0
+  uint64_t count;         // Elements or records
+  uint64_t data_offset;   // Start of the payload
+  uint64_t data_bytes;    // Length of the payload
+  uint32_t byte_order;
+  uint32_t reserved0;
+  uint64_t reserved1;
+} snap_header_t;
+
+struct ds_snapshot {
+  void *base;             // Whole file, mapped read-only
+  size_t length;
+  ds_snapshot_kind_t kind;
+  ds_span_t span;         // Payload
+};
+
+struct ds_snapshot_writer {
+  FILE *fp;
+  unsigned char *buf;     // Record being encoded
+  size_t len;
+  size_t cap;
+  uint64_t count;         // Records written so far
+  uint64_t bytes;         // Payload bytes written so far
+};
+
+/* ===================== Header ===================== */
+
+/**
+ * @brief Fill a header for `kind`.
+ */
+static snap_header_t snap_header(ds_snapshot_kind_t kind, size_t elem_size, size_t count, size_t data_bytes) {
+  snap_header_t h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, SNAP_MAGIC, sizeof(h.magic));
+  h.version = SNAP_VERSION;
+  h.kind = (uint32_t)kind;
+  h.elem_size = elem_size;
+  h.count = count;
+  h.data_offset = SNAP_ALIGN;
+  h.data_bytes = data_bytes;
+  h.byte_order = SNAP_BYTE_ORDER;
+  return h;
+}
+
+/**
+ * @brief Check the parts of a header common to every kind.
+ */
+static bool snap_header_valid(const snap_header_t *h) {
+  return memcmp(h->magic, SNAP_MAGIC, sizeof(h->magic)) == 0
+         && h->version == SNAP_VERSION
+         && h->byte_order == SNAP_BYTE_ORDER
+         && h->data_offset >= sizeof(snap_header_t)
+         && h->data_offset % SNAP_ALIGN == 0;
+}
+
+/**
+ * @brief fwrite() that reports short writes.
+ */
+static ds_status_t snap_fwrite(FILE *fp, const void *p, size_t n) {
+  if (n == 0) return DS_OK;
+  return fwrite(p, 1, n, fp) == n ? DS_OK : DS_ERR_IO;
+}
+
+/**
+ * @brief Write the header and pad up to the payload.
+ */
+static ds_status_t snap_write_header(FILE *fp, const snap_header_t *h) {
+  static const unsigned char zeros[SNAP_ALIGN];
+
+  ds_status_t st = snap_fwrite(fp, h, sizeof(*h));
+  if (st != DS_OK) return st;
+
+  return snap_fwrite(fp, zeros, (size_t)h->data_offset - sizeof(*h));
+}
+
+/**
+ * @brief Close a file being written, turning any earlier write error or a
+ *        failed close into DS_ERR_IO. Returns `st` if it already failed.
+ */
+static ds_status_t snap_close(FILE *fp, ds_status_t st) {
+  if (fclose(fp) != 0 && st == DS_OK) st = DS_ERR_IO;
+  return st;
+}
+
+/* ===================== Flat snapshots ===================== */
+
+/**
+ * @brief Write the elements of a by-value vector as a DS_SNAPSHOT_ARRAY.
+ */
+ds_status_t ds_snapshot_save_vec(const char *path, const ds_vec_t *vec) {
+  // Check input parameters
+  if (!path || !vec) return DS_ERR_NULL;
+
+  FILE *fp = fopen(path, "wb");
+  if (!fp) return DS_ERR_IO;
+
+  ds_span_t span = ds_vec_as_span(vec);
+  snap_header_t h = snap_header(DS_SNAPSHOT_ARRAY, ds_vec_elem_size(vec), span.size, ds_span_bytes(span));
+
+  ds_status_t st = snap_write_header(fp, &h);
+  if (st == DS_OK) st = snap_fwrite(fp, span.data, ds_span_bytes(span));
+
+  return snap_close(fp, st);
+}
+
+/**
+ * @brief Place sorted[*next...] into the implicit tree rooted at slot k,
+ *        in order, so an in-order walk of `eyt` is ascending.
+ */
+static void snap_eytzinger_fill(void *const *sorted, void **eyt, size_t n, size_t k, size_t *next) {
+  if (k >= n) return;
+
+  snap_eytzinger_fill(sorted, eyt, n, 2 * k + 1, next);
+  eyt[k] = sorted[(*next) ++];
+  snap_eytzinger_fill(sorted, eyt, n, 2 * k + 2, next);
+}
+
+/**
+ * @brief Write the elements of a by-value vector as a DS_SNAPSHOT_TREE.
+ */
+ds_status_t ds_snapshot_save_tree(const char *path, const ds_vec_t *vec, ds_compare_f compare) {
+  // Check input parameters
+  if (!path || !vec || !compare) return DS_ERR_NULL;
+
+  ds_span_t span = ds_vec_as_span(vec);
+  size_t n = span.size;
+
+  // Sort pointers to the elements, then lay them out level by level
+  ds_vector_t *sorted = ds_vector_create(n);
+  ds_vector_t *eyt = ds_vector_create(n);
+  ds_status_t st = sorted && eyt ? DS_OK : DS_ERR_MEM;
+  for (size_t i = 0; i < n && st == DS_OK; ++ i) {
+    st = ds_vector_push_back(sorted, ds_span_at(span, i));
+    if (st == DS_OK) st = ds_vector_push_back(eyt, ds_span_at(span, i));
+  }
+  if (st == DS_OK) st = ds_vector_sort(sorted, compare);
+
+  if (st == DS_OK) {
+    size_t next = 0;
+    snap_eytzinger_fill(ds_vector_data(sorted), ds_vector_data(eyt), n, 0, &next);
+
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+      st = DS_ERR_IO;
+    } else {
+      snap_header_t h = snap_header(DS_SNAPSHOT_TREE, span.elem_size, n, ds_span_bytes(span));
+      st = snap_write_header(fp, &h);
+
+      void **slots = ds_vector_data(eyt);
+      for (size_t k = 0; k < n && st == DS_OK; ++ k) {
+        st = snap_fwrite(fp, slots[k], span.elem_size);
+      }
+      st = snap_close(fp, st);
+    }
+  }
+
+  ds_vector_destroy(eyt, NULL);
+  ds_vector_destroy(sorted, NULL);
+  return st;
+}
+
+/**
+ * @brief Map a flat snapshot read-only.
+ */
+ds_snapshot_t *ds_snapshot_map(const char *path) {
+  // Check input parameters
+  if (!path) return NULL;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+
+  struct stat sb;
+  if (fstat(fd, &sb) != 0 || sb.st_size < (off_t)sizeof(snap_header_t)
+      || (uintmax_t)sb.st_size > SIZE_MAX) {
+    close(fd);
+    return NULL;
+  }
+
+  size_t length = (size_t)sb.st_size;
+  void *base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // The mapping keeps the file referenced
+  if (base == MAP_FAILED) return NULL;
+
+  // Validate the header against the file before trusting any size
+  const snap_header_t *h = base;
+  bool ok = snap_header_valid(h)
+            && (h->kind == DS_SNAPSHOT_ARRAY || h->kind == DS_SNAPSHOT_TREE)
+            && h->elem_size > 0
+            && h->data_offset <= length
+            && h->data_bytes <= length - h->data_offset
+            && h->count <= h->data_bytes / h->elem_size
+            && h->count * h->elem_size == h->data_bytes;
+
+  ds_snapshot_t *snap = ok ? ds_mem_alloc(ds_allocator_default(), sizeof(ds_snapshot_t)) : NULL;
+  if (!snap) {
+    munmap(base, length);
+    return NULL;
+  }
+
+  snap->base = base;
+  snap->length = length;
+  snap->kind = (ds_snapshot_kind_t)h->kind;
+  snap->span = ds_span_make((char *)base + h->data_offset, (size_t)h->count, (size_t)h->elem_size);
+
+  return snap;
+}
+
+/**
+ * @brief Unmap a snapshot.
+ */
+void ds_snapshot_unmap(ds_snapshot_t *snap) {
+  // Check input parameters
+  if (!snap) return;
+
+  munmap(snap->base, snap->length);
+  ds_mem_free(ds_allocator_default(), snap, sizeof(ds_snapshot_t));
+}
+
+/**
+ * @brief Get the kind of a mapped snapshot.
+ */
+ds_snapshot_kind_t ds_snapshot_kind(const ds_snapshot_t *snap) {
+  if (!snap) return (ds_snapshot_kind_t)0;
+
+  return snap->kind;
+}
+
+/**
+ * @brief Get a span over the mapped elements, in file order.
+ */
+ds_span_t ds_snapshot_span(const ds_snapshot_t *snap) {
+  if (!snap) return ds_span_make(NULL, 0, 0);
+
+  return snap->span;
+}
+
+/**
+ * @brief First element not less than `key` in a DS_SNAPSHOT_TREE.
+ *
+ * Walk down the implicit tree, remembering the last slot where we went
+ * left: that is the smallest element >= key seen on the path.
+ */
+const void *ds_snapshot_lower_bound(const ds_snapshot_t *snap, const void *key, ds_compare_f compare) {
+  // Check input parameters
+  if (!snap || !compare || snap->kind != DS_SNAPSHOT_TREE) return NULL;
+
+  const ds_span_t span = snap->span;
+  const void *best = NULL;
+  size_t k = 0;
+  while (k < span.size) {
+    const void *elem = (const char *)span.data + k * span.elem_size;
+    if (compare(elem, key) < 0) {
+      k = 2 * k + 2;
+    } else {
+      best = elem;
+      k = 2 * k + 1;
+    }
+  }
+
+  return best;
+}
+
+/**
+ * @brief Element equal to `key` in a DS_SNAPSHOT_TREE.
+ */
+const void *ds_snapshot_find(const ds_snapshot_t *snap, const void *key, ds_compare_f compare) {
+  const void *elem = ds_snapshot_lower_bound(snap, key, compare);
+  if (!elem || compare(elem, key) != 0) return NULL;
+
+  return elem;
+}
+
+/**
+ * @brief Copy a mapped snapshot's elements into a new by-value vector.
+ */
+ds_vec_t *ds_snapshot_to_vec(const ds_snapshot_t *snap, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!snap) return NULL;
+
+  ds_vec_t *vec = ds_vec_create_ex(snap->span.elem_size, snap->span.size, allocator);
+  if (!vec) return NULL;
+
+  for (size_t i = 0; i < snap->span.size; ++ i) {
+    if (ds_vec_push_back(vec, ds_span_at(snap->span, i)) != DS_OK) {
+      ds_vec_destroy(vec, NULL);
+      return NULL;
+    }
+  }
+
+  return vec;
+}
+
+/* ===================== Record snapshots ===================== */
+
+/**
+ * @brief Append bytes to the record being encoded.
+ */
+ds_status_t ds_snapshot_write(ds_snapshot_writer_t *w, const void *bytes, size_t n) {
+  // Check input parameters
+  if (!w || (!bytes && n > 0)) return DS_ERR_NULL;
+  if (n == 0) return DS_OK;
+
+  if (n > w->cap - w->len) {
+    if (n > SIZE_MAX / 2 - w->len) return DS_ERR_MEM;
+
+    size_t new_cap = w->cap ? w->cap : 64;
+    while (new_cap < w->len + n) new_cap *= 2;
+
+    unsigned char *buf = ds_mem_realloc(ds_allocator_default(), w->buf, w->cap, new_cap);
+    if (!buf) return DS_ERR_MEM;
+
+    w->buf = buf;
+    w->cap = new_cap;
+  }
+
+  memcpy(w->buf + w->len, bytes, n);
+  w->len += n;
+  return DS_OK;
+}
+
+/**
+ * @brief Open `path` and reserve room for the header.
+ */
+static ds_status_t snap_records_begin(ds_snapshot_writer_t *w, const char *path) {
+  memset(w, 0, sizeof(*w));
+
+  w->fp = fopen(path, "wb");
+  if (!w->fp) return DS_ERR_IO;
+
+  // The real header, with count and length, is written at the end
+  snap_header_t h = snap_header(DS_SNAPSHOT_RECORDS, 0, 0, 0);
+  return snap_write_header(w->fp, &h);
+}
+
+/**
+ * @brief Encode one element and write it as a length-prefixed record.
+ */
+static ds_status_t snap_records_put(ds_snapshot_writer_t *w, const void *element,
+                                    ds_snapshot_encode_f encode, void *ctx) {
+  w->len = 0;
+  ds_status_t st = encode(w, element, ctx);
+  if (st != DS_OK) return st;
+
+  uint64_t len = w->len;
+  st = snap_fwrite(w->fp, &len, sizeof(len));
+  if (st == DS_OK) st = snap_fwrite(w->fp, w->buf, w->len);
+  if (st != DS_OK) return st;
+
+  w->count ++;
+  w->bytes += sizeof(len) + len;
+  return DS_OK;
+}
+
+/**
+ * @brief Write the final header, close the file and release the writer.
+ */
+static ds_status_t snap_records_end(ds_snapshot_writer_t *w, ds_status_t st) {
+  if (w->fp) {
+    if (st == DS_OK) {
+      snap_header_t h = snap_header(DS_SNAPSHOT_RECORDS, 0, 0, 0);
+      h.count = w->count;
+      h.data_bytes = w->bytes;
+      st = fseek(w->fp, 0, SEEK_SET) == 0 ? snap_fwrite(w->fp, &h, sizeof(h)) : DS_ERR_IO;
+    }
+    st = snap_close(w->fp, st);
+  }
+
+  ds_mem_free(ds_allocator_default(), w->buf, w->cap);
+  return st;
+}
+
+/**
+ * @brief Save `n` elements from an array of pointers.
+ */
+static ds_status_t snap_save_array(const char *path, void *const *items, size_t n,
+                                   ds_snapshot_encode_f encode, void *ctx) {
+  ds_snapshot_writer_t w;
+  ds_status_t st = snap_records_begin(&w, path);
+  for (size_t i = 0; i < n && st == DS_OK; ++ i) {
+    st = snap_records_put(&w, items[i], encode, ctx);
+  }
+
+  return snap_records_end(&w, st);
+}
+
+/**
+ * @brief Save the elements of a pointer vector, in order.
+ */
+ds_status_t ds_snapshot_save_vector(const char *path, const ds_vector_t *vec,
+                                    ds_snapshot_encode_f encode, void *ctx) {
+  // Check input parameters
+  if (!path || !vec || !encode) return DS_ERR_NULL;
+
+  return snap_save_array(path, ds_vector_data(vec), ds_vector_size(vec), encode, ctx);
+}
+
+/**
+ * @brief Save the elements of a heap in storage order.
+ */
+ds_status_t ds_snapshot_save_heap(const char *path, const ds_heap_t *heap,
+                                  ds_snapshot_encode_f encode, void *ctx) {
+  // Check input parameters
+  if (!path || !heap || !encode) return DS_ERR_NULL;
+
+  ds_span_t span = ds_heap_as_span(heap);
+  return snap_save_array(path, span.data, span.size, encode, ctx);
+}
+
+/**
+ * @brief Save the elements of a tree in ascending order.
+ */
+ds_status_t ds_snapshot_save_bst(const char *path, const ds_bst_t *bst,
+                                 ds_snapshot_encode_f encode, void *ctx) {
+  // Check input parameters
+  if (!path || !bst || !encode) return DS_ERR_NULL;
+
+  ds_snapshot_writer_t w;
+  ds_status_t st = snap_records_begin(&w, path);
+  for (ds_bst_iter_t it = ds_bst_iter_begin(bst); it && st == DS_OK; it = ds_bst_iter_next(it)) {
+    st = snap_records_put(&w, ds_bst_iter_get(it), encode, ctx);
+  }
+
+  return snap_records_end(&w, st);
+}
+
+/**
+ * @brief Read and decode every record of `path` into a new vector.
+ *
+ * On failure the decoded elements are freed with `free_func`.
+ */
+static ds_status_t snap_load_records(const char *path, ds_snapshot_decode_f decode, void *ctx,
+                                     ds_free_f free_func, const ds_allocator_t *allocator,
+                                     ds_vector_t **out) {
+  FILE *fp = fopen(path, "rb");
+  if (!fp) return DS_ERR_IO;
+
+  snap_header_t h;
+  ds_status_t st = DS_OK;
+  if (fread(&h, sizeof(h), 1, fp) != 1 || !snap_header_valid(&h) || h.kind != DS_SNAPSHOT_RECORDS
+      || fseek(fp, (long)h.data_offset, SEEK_SET) != 0) {
+    fclose(fp);
+    return DS_ERR_IO;
+  }
+
+  // Validate the payload size against the file before trusting any size
+  struct stat sb;
+  if (fstat(fileno(fp), &sb) != 0 || sb.st_size < 0
+      || h.data_offset > (uintmax_t)sb.st_size
+      || h.data_bytes > (uintmax_t)sb.st_size - h.data_offset) {
+    fclose(fp);
+    return DS_ERR_IO;
+  }
+
+  // Each record takes at least its length prefix: bounds the reservation
+  size_t hint = h.count <= h.data_bytes / sizeof(uint64_t) ? (size_t)h.count : 0;
+  ds_vector_t *vec = ds_vector_create_ex(hint, allocator);
+  if (!vec) {
+    fclose(fp);
+    return DS_ERR_MEM;
+  }
+
+  unsigned char *buf = NULL;
+  size_t cap = 0;
+  uint64_t left = h.data_bytes;
+
+  for (uint64_t r = 0; r < h.count && st == DS_OK; ++ r) {
+    uint64_t len;
+    if (left < sizeof(len) || fread(&len, sizeof(len), 1, fp) != 1) {
+      st = DS_ERR_IO;
+      break;
+    }
+    left -= sizeof(len);
+    if (len > left) {
+      st = DS_ERR_IO;
+      break;
+    }
+    left -= len;
+
+    if (len > cap) {
+      unsigned char *nbuf = ds_mem_realloc(ds_allocator_default(), buf, cap, (size_t)len);
+      if (!nbuf) {
+        st = DS_ERR_MEM;
+        break;
+      }
+      buf = nbuf;
+      cap = (size_t)len;
+    }
+    if (len > 0 && fread(buf, 1, (size_t)len, fp) != len) {
+      st = DS_ERR_IO;
+      break;
+    }
+
+    void *element = decode(buf, (size_t)len, ctx);
+    if (!element) {
+      st = DS_ERR_ARG;
+      break;
+    }
+
+    st = ds_vector_push_back(vec, element);
+    if (st != DS_OK && free_func) free_func(element);
+  }
+
+  ds_mem_free(ds_allocator_default(), buf, cap);
+  fclose(fp);
+
+  if (st != DS_OK) {
+    ds_vector_destroy(vec, free_func);
+    return st;
+  }
+
+  *out = vec;
+  return DS_OK;
+}
+
+/**
+ * @brief Load a record snapshot into a new pointer vector.
+ */
+ds_status_t ds_snapshot_load_vector(const char *path, ds_snapshot_decode_f decode, void *ctx,
+                                    ds_free_f free_func, const ds_allocator_t *allocator,
+                                    ds_vector_t **out) {
+  // Check input parameters
+  if (!path || !decode || !out) return DS_ERR_NULL;
+
+  return snap_load_records(path, decode, ctx, free_func, allocator, out);
+}
+
+/**
+ * @brief Load a record snapshot into a new heap.
+ */
+ds_status_t ds_snapshot_load_heap(const char *path, ds_compare_f compare,
+                                  ds_snapshot_decode_f decode, void *ctx,
+                                  ds_free_f free_func, const ds_allocator_t *allocator,
+                                  ds_heap_t **out) {
+  // Check input parameters
+  if (!path || !compare || !decode || !out) return DS_ERR_NULL;
+
+  ds_vector_t *items = NULL;
+  ds_status_t st = snap_load_records(path, decode, ctx, free_func, allocator, &items);
+  if (st != DS_OK) return st;
+
+  ds_heap_t *heap = ds_heap_create_from_ex(compare, ds_vector_data(items), ds_vector_size(items), allocator);
+  if (!heap) {
+    ds_vector_destroy(items, free_func);
+    return DS_ERR_MEM;
+  }
+
+  ds_vector_destroy(items, NULL);
+  *out = heap;
+  return DS_OK;
+}
+
+/**
+ * @brief Load a record snapshot into a new balanced tree.
+ */
+ds_status_t ds_snapshot_load_bst(const char *path, ds_compare_f compare,
+                                 ds_snapshot_decode_f decode, void *ctx,
+                                 ds_free_f free_func, const ds_allocator_t *allocator,
+                                 ds_bst_t **out) {
+  // Check input parameters
+  if (!path || !compare || !decode || !out) return DS_ERR_NULL;
+
+  ds_vector_t *items = NULL;
+  ds_status_t st = snap_load_records(path, decode, ctx, free_func, allocator, &items);
+  if (st != DS_OK) return st;
+
+  void **data = ds_vector_data(items);
+  size_t n = ds_vector_size(items);
+
+  // Tell an unsorted file apart from an allocation failure
+  for (size_t i = 1; i < n; ++ i) {
+    if (compare(data[i - 1], data[i]) >= 0) {
+      ds_vector_destroy(items, free_func);
+      return DS_ERR_ARG;
+    }
+  }
+
+  ds_bst_t *bst = ds_bst_create_from_sorted_ex(compare, data, n, allocator);
+  if (!bst) {
+    ds_vector_destroy(items, free_func);
+    return DS_ERR_MEM;
+  }
+
+  ds_vector_destroy(items, NULL);
+  *out = bst;
+  return DS_OK;
+}
@@ -1,13 +1,10 @@
 #include "ds_stack.h"
 #include "ds_common.h"
 #include "ds_deque.h"
+#include "ds_stack_inline.h"
 #include <stdbool.h>
 #include <stdlib.h>
 
-struct ds_stack {
-  ds_deque_t *deque; 
-};
-
 /**
  * @brief Create a new dynamic stack.
  *
@@ -17,12 +14,28 @@ struct ds_stack {
  * @return Pointer to a new stack on success, or NULL on failure.
  */
 ds_stack_t *ds_stack_create(size_t capacity_hint) {
-  ds_stack_t *stack = malloc(sizeof(ds_stack_t));
+  return ds_stack_create_ex(capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new dynamic stack using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the stack and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new stack on success, or NULL on failure.
+ */
+ds_stack_t *ds_stack_create_ex(size_t capacity_hint, const ds_allocator_t *allocator) {
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  ds_stack_t *stack = ds_mem_alloc(allocator, sizeof(ds_stack_t));
   if (!stack) return NULL;
 
-  stack->deque = ds_deque_create(capacity_hint);
-  if (!stack->deque) {
-    free(stack);
+  if (ds_deque_init(&stack->deque, capacity_hint, allocator) != DS_OK) {
+    ds_mem_free(allocator, stack, sizeof(ds_stack_t));
     return NULL;
   }
 
@@ -40,8 +53,9 @@ ds_stack_t *ds_stack_create(size_t capacity_hint) {
 void ds_stack_destroy(ds_stack_t *stack, ds_free_f free_func) {
   if (!stack) return;
   
-  ds_deque_destroy(stack->deque, free_func);
-  free(stack);
+  ds_deque_fini(&stack->deque, free_func);
+  ds_allocator_t alloc = stack->deque.alloc;
+  ds_mem_free(&alloc, stack, sizeof(ds_stack_t));
 }
 
 /**
@@ -50,7 +64,16 @@ void ds_stack_destroy(ds_stack_t *stack, ds_free_f free_func) {
 size_t ds_stack_size(const ds_stack_t *stack) {
   if (!stack) return 0;
 
-  return ds_deque_size(stack->deque);
+  return ds_deque_size(&stack->deque);
+}
+
+/**
+ * @brief Get the instrumentation counters of the underlying deque.
+ */
+ds_status_t ds_stack_stats(const ds_stack_t *stack, ds_stats_t *out) {
+  if (!stack) return DS_ERR_NULL;
+
+  return ds_deque_stats(&stack->deque, out);
 }
 
 /**
@@ -59,7 +82,7 @@ size_t ds_stack_size(const ds_stack_t *stack) {
 size_t ds_stack_capacity(const ds_stack_t *stack) {
   if (!stack) return 0;
 
-  return ds_deque_capacity(stack->deque);
+  return ds_deque_capacity(&stack->deque);
 }
 
 /**
@@ -68,7 +91,7 @@ size_t ds_stack_capacity(const ds_stack_t *stack) {
 bool ds_stack_is_empty(ds_stack_t *stack) {
   if (!stack) return true;
 
-  return ds_deque_is_empty(stack->deque);
+  return ds_deque_is_empty(&stack->deque);
 }
 
 /**
@@ -85,7 +108,7 @@ ds_status_t ds_stack_push(ds_stack_t *stack, void *element) {
   if (!stack) return DS_ERR_NULL;
   if (!element) return DS_ERR_ARG;
 
-  return ds_deque_push_back(stack->deque, element);  
+  return ds_deque_push_back_fast(&stack->deque, element);  
 }
 
 /**
@@ -101,7 +124,7 @@ ds_status_t ds_stack_push(ds_stack_t *stack, void *element) {
 void *ds_stack_pop(ds_stack_t *stack) {
   if (!stack) return NULL;
 
-  return ds_deque_pop_back(stack->deque);
+  return ds_deque_pop_back(&stack->deque);
 }
 
 /**
@@ -117,7 +140,7 @@ void *ds_stack_pop(ds_stack_t *stack) {
 void *ds_stack_top(ds_stack_t *stack) {
   if (!stack) return NULL;
 
-  return ds_deque_back(stack->deque);
+  return ds_deque_back(&stack->deque);
 }
 
 /**
@@ -132,5 +155,36 @@ void *ds_stack_top(ds_stack_t *stack) {
 void ds_stack_clear(ds_stack_t *stack, ds_free_f free_func) {
   if (!stack) return;
 
-  ds_deque_clear(stack->deque, free_func);
+  ds_deque_clear(&stack->deque, free_func);
+}
+
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param stack  Pointer to the stack.
+ *
+ * @return
+ *   - DS_OK on success (an empty stack keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the stack is unchanged.
+ */
+ds_status_t ds_stack_shrink_to_fit(ds_stack_t *stack) {
+  if (!stack) return DS_ERR_NULL;
+
+  return ds_deque_shrink_to_fit(&stack->deque);
+}
+
+/**
+ * @brief Set the growth policy of the stack.
+ *
+ * @param stack   Pointer to the stack.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_stack_set_growth_policy(ds_stack_t *stack, const ds_growth_policy_t *policy) {
+  if (!stack) return DS_ERR_NULL;
+
+  return ds_deque_set_growth_policy(&stack->deque, policy);
 }
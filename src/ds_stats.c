@@ -0,0 +1,207 @@
+/*
+** src/ds_stats.c -- Registry, allocator wrapper and histograms for the
+**                   optional container instrumentation.
+*/
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime under strict -std=c11
+
+#include "ds_stats.h"
+#include "ds_common.h"
+#include "ds_ilist.h"
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief Check whether this build was compiled with DS_ENABLE_STATS.
+ */
+bool ds_stats_enabled(void) {
+#ifdef DS_ENABLE_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Upper bound (in ns) of the bucket holding the q-quantile.
+ */
+uint64_t ds_stats_hist_quantile(const ds_stats_hist_t *hist, double q) {
+  // Check input parameters
+  if (!hist || hist->count == 0) return 0;
+  if (q < 0.0) q = 0.0;
+  if (q > 1.0) q = 1.0;
+
+  // Rank of the sample we are looking for, 1-based
+  uint64_t rank = (uint64_t)(q * (double)hist->count);
+  if (rank == 0) rank = 1;
+
+  uint64_t seen = 0;
+  for (size_t b = 0; b < DS_STATS_HIST_BUCKETS; ++ b) {
+    seen += hist->buckets[b];
+    if (seen >= rank) {
+      uint64_t bound = b + 1 < 64 ? (UINT64_C(1) << (b + 1)) : UINT64_MAX;
+      return bound < hist->max_ns ? bound : hist->max_ns;
+    }
+  }
+
+  return hist->max_ns;
+}
+
+#ifdef DS_ENABLE_STATS
+
+static ds_ilist_t g_registry = { { &g_registry.head, &g_registry.head }, 0 };
+static pthread_mutex_t g_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define STATS_ADD(field, n) __atomic_fetch_add(&(field), (n), __ATOMIC_RELAXED)
+#define STATS_SUB(field, n) __atomic_fetch_sub(&(field), (n), __ATOMIC_RELAXED)
+
+/**
+ * @brief Raise bytes_peak to bytes_live if needed.
+ */
+static void stats_update_peak(ds_stats_t *s) {
+  uint64_t live = __atomic_load_n(&s->bytes_live, __ATOMIC_RELAXED);
+  uint64_t peak = __atomic_load_n(&s->bytes_peak, __ATOMIC_RELAXED);
+  while (live > peak
+         && !__atomic_compare_exchange_n(&s->bytes_peak, &peak, live, true,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+}
+
+static void *stats_alloc(void *ctx, size_t size) {
+  ds_stats_node_t *node = ctx;
+  void *p = ds_mem_alloc(&node->inner, size);
+  if (p) {
+    STATS_ADD(node->stats.allocs, 1);
+    STATS_ADD(node->stats.bytes_total, size);
+    STATS_ADD(node->stats.bytes_live, size);
+    stats_update_peak(&node->stats);
+  }
+  return p;
+}
+
+static void *stats_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  ds_stats_node_t *node = ctx;
+  void *p = ds_mem_realloc(&node->inner, ptr, old_size, new_size);
+  if (p) {
+    STATS_ADD(node->stats.reallocs, 1);
+    if (new_size > old_size) STATS_ADD(node->stats.bytes_total, new_size - old_size);
+    STATS_ADD(node->stats.bytes_live, new_size);
+    STATS_SUB(node->stats.bytes_live, old_size);
+    stats_update_peak(&node->stats);
+  }
+  return p;
+}
+
+static void stats_free(void *ctx, void *ptr, size_t size) {
+  ds_stats_node_t *node = ctx;
+  STATS_ADD(node->stats.frees, 1);
+  STATS_SUB(node->stats.bytes_live, size);
+  ds_mem_free(&node->inner, ptr, size);
+}
+
+/**
+ * @brief Register a node and route `*alloc` through it.
+ */
+void ds_stats_attach(ds_stats_node_t *node, const char *kind, const void *owner, ds_allocator_t *alloc) {
+  *node = (ds_stats_node_t){ .kind = kind, .owner = owner, .inner = *alloc };
+  ds_ilist_link_init(&node->link);
+
+  alloc->alloc = stats_alloc;
+  alloc->realloc = stats_realloc;
+  alloc->free = stats_free;
+  alloc->ctx = node;
+
+  pthread_mutex_lock(&g_registry_lock);
+  ds_ilist_push_back(&g_registry, &node->link);
+  pthread_mutex_unlock(&g_registry_lock);
+}
+
+/**
+ * @brief Unregister a node and restore `*alloc` to the original allocator.
+ */
+void ds_stats_detach(ds_stats_node_t *node, ds_allocator_t *alloc) {
+  pthread_mutex_lock(&g_registry_lock);
+  if (ds_ilist_link_is_linked(&node->link)) ds_ilist_remove(&g_registry, &node->link);
+  pthread_mutex_unlock(&g_registry_lock);
+
+  *alloc = node->inner;
+}
+
+/**
+ * @brief Monotonic clock in nanoseconds.
+ */
+uint64_t ds_stats_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Count one resize that started at `start_ns`.
+ */
+void ds_stats_record_resize(ds_stats_node_t *node, uint64_t start_ns) {
+  uint64_t ns = ds_stats_now_ns() - start_ns;
+  ds_stats_hist_t *h = &node->stats.resize_latency;
+
+  // floor(log2(ns)), with 0 and 1 ns both in bucket 0
+  size_t b = 0;
+  while (b + 1 < DS_STATS_HIST_BUCKETS && (ns >> (b + 1)) != 0) b ++;
+
+  node->stats.resizes ++;
+  h->count ++;
+  h->total_ns += ns;
+  if (ns > h->max_ns) h->max_ns = ns;
+  h->buckets[b] ++;
+}
+
+#endif
+
+/**
+ * @brief Visit every live instrumented container.
+ */
+size_t ds_stats_foreach(ds_stats_visit_f visit, void *ctx) {
+#ifdef DS_ENABLE_STATS
+  // Check input parameters
+  if (!visit) return 0;
+
+  size_t n = 0;
+  pthread_mutex_lock(&g_registry_lock);
+  for (ds_ilist_link_t *l = ds_ilist_front(&g_registry); l; l = ds_ilist_next(&g_registry, l)) {
+    const ds_stats_node_t *node = DS_CONTAINER_OF(l, ds_stats_node_t, link);
+    visit(node->kind, node->owner, &node->stats, ctx);
+    n ++;
+  }
+  pthread_mutex_unlock(&g_registry_lock);
+
+  return n;
+#else
+  (void)visit;
+  (void)ctx;
+  return 0;
+#endif
+}
+
+static void stats_print(const char *kind, const void *owner, const ds_stats_t *s, void *ctx) {
+  FILE *out = ctx;
+  const ds_stats_hist_t *h = &s->resize_latency;
+
+  fprintf(out,
+          "%s@%p allocs=%" PRIu64 " reallocs=%" PRIu64 " frees=%" PRIu64
+          " bytes_live=%" PRIu64 " bytes_peak=%" PRIu64
+          " resizes=%" PRIu64 " resize_ns_p50=%" PRIu64 " resize_ns_p99=%" PRIu64 " resize_ns_max=%" PRIu64
+          " comparisons=%" PRIu64 " searches=%" PRIu64 " max_depth=%" PRIu64
+          " probes=%" PRIu64 " max_probe=%" PRIu64 "\n",
+          kind, owner, s->allocs, s->reallocs, s->frees, s->bytes_live, s->bytes_peak,
+          s->resizes, ds_stats_hist_quantile(h, 0.5), ds_stats_hist_quantile(h, 0.99), h->max_ns,
+          s->comparisons, s->searches, s->max_depth, s->probes, s->max_probe);
+}
+
+/**
+ * @brief Print one line per live instrumented container.
+ */
+size_t ds_stats_dump(FILE *out) {
+  return ds_stats_foreach(stats_print, out ? out : stderr);
+}
@@ -0,0 +1,289 @@
+/*
+** src/ds_threadpool.c -- Implementation of the work-stealing thread pool.
+*/
+
+#include "ds_threadpool.h"
+#include "ds_common.h"
+#include "ds_queue.h"
+#include "ds_wsdeque.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <unistd.h>
+
+typedef struct {
+  ds_task_f func;
+  void *arg;
+} ds_task_t;
+
+typedef struct {
+  pthread_t thread;
+  ds_wsdeque_t *deque;           // Tasks submitted by this worker's tasks
+  ds_threadpool_t *pool;
+  size_t index;
+} ds_worker_t;
+
+struct ds_threadpool {
+  ds_worker_t *workers;
+  size_t num_workers;
+  ds_allocator_t alloc;
+
+  pthread_mutex_t inject_lock;   // Guards `inject`
+  ds_queue_t *inject;            // Tasks submitted from outside the pool
+
+  pthread_mutex_t lock;          // Guards sleeping and `shutdown`
+  pthread_cond_t work_cond;      // Signaled when a task is queued
+  pthread_cond_t done_cond;      // Signaled when `pending` drops to zero
+  bool shutdown;
+
+  atomic_size_t queued;          // Submitted, not yet picked up
+  atomic_size_t pending;         // Submitted, not yet finished
+  atomic_size_t sleepers;        // Workers blocked on work_cond
+};
+
+/* The worker running on this thread, if any (used to route submissions). */
+static _Thread_local ds_worker_t *tls_worker = NULL;
+
+/**
+ * @brief Account for one finished (or failed) task.
+ */
+static void pool_task_done(ds_threadpool_t *pool) {
+  if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->done_cond);
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
+
+/**
+ * @brief Find the next task: own deque, then injection queue, then steal.
+ */
+static ds_task_t *worker_find_task(ds_worker_t *worker) {
+  ds_threadpool_t *pool = worker->pool;
+
+  ds_task_t *task = ds_wsdeque_pop(worker->deque);
+  if (task) return task;
+
+  pthread_mutex_lock(&pool->inject_lock);
+  task = ds_queue_pop(pool->inject);
+  pthread_mutex_unlock(&pool->inject_lock);
+  if (task) return task;
+
+  for (size_t i = 1; i < pool->num_workers; ++ i) {
+    ds_worker_t *victim = &pool->workers[(worker->index + i) % pool->num_workers];
+    task = ds_wsdeque_steal(victim->deque);
+    if (task) return task;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Worker thread main loop.
+ */
+static void *worker_main(void *arg) {
+  ds_worker_t *worker = arg;
+  ds_threadpool_t *pool = worker->pool;
+  tls_worker = worker;
+
+  for (;;) {
+    ds_task_t *task = worker_find_task(worker);
+    if (task) {
+      atomic_fetch_sub(&pool->queued, 1);
+      task->func(task->arg);
+      ds_mem_free(&pool->alloc, task, sizeof(ds_task_t));
+      pool_task_done(pool);
+      continue;
+    }
+
+    // Nothing found. Sleep unless a task was queued meanwhile (then retry)
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add(&pool->sleepers, 1);
+    while (!pool->shutdown && atomic_load(&pool->queued) == 0) {
+      pthread_cond_wait(&pool->work_cond, &pool->lock);
+    }
+    atomic_fetch_sub(&pool->sleepers, 1);
+    bool stop = pool->shutdown && atomic_load(&pool->queued) == 0;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (stop) break;
+  }
+
+  tls_worker = NULL;
+  return NULL;
+}
+
+/**
+ * @brief Stop and join the first `started` workers, then free everything.
+ */
+static void pool_teardown(ds_threadpool_t *pool, size_t started) {
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->work_cond);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (size_t i = 0; i < started; ++ i) {
+    pthread_join(pool->workers[i].thread, NULL);
+  }
+  for (size_t i = 0; i < pool->num_workers; ++ i) {
+    ds_wsdeque_destroy(pool->workers[i].deque, NULL);
+  }
+
+  ds_queue_destroy(pool->inject, NULL);
+  pthread_cond_destroy(&pool->done_cond);
+  pthread_cond_destroy(&pool->work_cond);
+  pthread_mutex_destroy(&pool->lock);
+  pthread_mutex_destroy(&pool->inject_lock);
+
+  ds_allocator_t alloc = pool->alloc;
+  ds_mem_free(&alloc, pool->workers, sizeof(ds_worker_t) * pool->num_workers);
+  ds_mem_free(&alloc, pool, sizeof(ds_threadpool_t));
+}
+
+/**
+ * @brief Create a thread pool and start its workers.
+ */
+ds_threadpool_t *ds_threadpool_create(size_t num_threads) {
+  return ds_threadpool_create_ex(num_threads, NULL);
+}
+
+/**
+ * @brief Create a thread pool using a custom (thread-safe) allocator.
+ */
+ds_threadpool_t *ds_threadpool_create_ex(size_t num_threads, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  if (num_threads == 0) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    num_threads = cpus > 0 ? (size_t)cpus : 1;
+  }
+  if (num_threads > SIZE_MAX / sizeof(ds_worker_t)) return NULL;
+
+  ds_threadpool_t *pool = ds_mem_alloc(allocator, sizeof(ds_threadpool_t));
+  if (!pool) return NULL;
+
+  pool->alloc = *allocator;
+  pool->num_workers = num_threads;
+  pool->shutdown = false;
+  atomic_init(&pool->queued, 0);
+  atomic_init(&pool->pending, 0);
+  atomic_init(&pool->sleepers, 0);
+
+  pool->workers = ds_mem_alloc(allocator, sizeof(ds_worker_t) * num_threads);
+  pool->inject = ds_queue_create_ex(0, allocator);
+  if (!pool->workers || !pool->inject) {
+    ds_queue_destroy(pool->inject, NULL);
+    if (pool->workers) ds_mem_free(allocator, pool->workers, sizeof(ds_worker_t) * num_threads);
+    ds_mem_free(allocator, pool, sizeof(ds_threadpool_t));
+    return NULL;
+  }
+
+  pthread_mutex_init(&pool->inject_lock, NULL);
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work_cond, NULL);
+  pthread_cond_init(&pool->done_cond, NULL);
+
+  // All deques must exist before any worker may try to steal
+  bool ok = true;
+  for (size_t i = 0; i < num_threads; ++ i) {
+    pool->workers[i].pool = pool;
+    pool->workers[i].index = i;
+    pool->workers[i].deque = ds_wsdeque_create_ex(0, allocator);
+    if (!pool->workers[i].deque) ok = false;
+  }
+  if (!ok) {
+    pool_teardown(pool, 0);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < num_threads; ++ i) {
+    if (pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]) != 0) {
+      pool_teardown(pool, i);
+      return NULL;
+    }
+  }
+
+  return pool;
+}
+
+/**
+ * @brief Run all pending tasks, stop the workers and free the pool.
+ */
+void ds_threadpool_destroy(ds_threadpool_t *pool) {
+  // Check input parameters
+  if (!pool) return;
+
+  ds_threadpool_wait(pool);
+  pool_teardown(pool, pool->num_workers);
+}
+
+/**
+ * @brief Get the number of worker threads.
+ */
+size_t ds_threadpool_size(const ds_threadpool_t *pool) {
+  if (!pool) return 0;
+
+  return pool->num_workers;
+}
+
+/**
+ * @brief Schedule `func(arg)` to run on a worker thread.
+ */
+ds_status_t ds_threadpool_submit(ds_threadpool_t *pool, ds_task_f func, void *arg) {
+  // Check input parameters
+  if (!pool) return DS_ERR_NULL;
+  if (!func) return DS_ERR_ARG;
+
+  ds_task_t *task = ds_mem_alloc(&pool->alloc, sizeof(ds_task_t));
+  if (!task) return DS_ERR_MEM;
+  task->func = func;
+  task->arg = arg;
+
+  atomic_fetch_add(&pool->pending, 1);
+  atomic_fetch_add(&pool->queued, 1);
+
+  ds_status_t ret;
+  ds_worker_t *self = tls_worker;
+  if (self && self->pool == pool) {
+    ret = ds_wsdeque_push(self->deque, task);
+  } else {
+    pthread_mutex_lock(&pool->inject_lock);
+    ret = ds_queue_push(pool->inject, task);
+    pthread_mutex_unlock(&pool->inject_lock);
+  }
+
+  if (ret != DS_OK) {
+    atomic_fetch_sub(&pool->queued, 1);
+    ds_mem_free(&pool->alloc, task, sizeof(ds_task_t));
+    pool_task_done(pool);
+    return DS_ERR_MEM;
+  }
+
+  // A worker going to sleep bumps `sleepers` before re-checking `queued`,
+  // so either it sees this task or we see it and wake it up.
+  if (atomic_load(&pool->sleepers) > 0) {
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  return DS_OK;
+}
+
+/**
+ * @brief Block until every submitted task has finished.
+ */
+void ds_threadpool_wait(ds_threadpool_t *pool) {
+  // Check input parameters
+  if (!pool) return;
+
+  pthread_mutex_lock(&pool->lock);
+  while (atomic_load(&pool->pending) > 0) {
+    pthread_cond_wait(&pool->done_cond, &pool->lock);
+  }
+  pthread_mutex_unlock(&pool->lock);
+}
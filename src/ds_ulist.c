@@ -0,0 +1,390 @@
+/*
+** src/ds_ulist.c -- Implementation of the unrolled linked list.
+*/
+
+#include "ds_ulist.h"
+#include "ds_common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DS_ULIST_DEFAULT_NODE_CAPACITY 32
+
+struct ds_ulist_node {
+  struct ds_ulist_node *prev;
+  struct ds_ulist_node *next;
+  size_t count;                 // Used slots in items[]
+  void *items[];                // node_capacity slots
+};
+
+struct ds_ulist {
+  ds_ulist_node_t *head;
+  ds_ulist_node_t *tail;
+  size_t size;
+  size_t node_capacity;
+  ds_allocator_t alloc;
+};
+
+static const ds_ulist_iter_t ULIST_END = { NULL, 0 };
+
+static inline size_t node_bytes(const ds_ulist_t *list) {
+  return sizeof(ds_ulist_node_t) + sizeof(void *) * list->node_capacity;
+}
+
+/**
+ * @brief Allocate an empty node and link it after `prev` (NULL = at the front).
+ */
+static ds_ulist_node_t *ulist_node_insert_after(ds_ulist_t *list, ds_ulist_node_t *prev) {
+  ds_ulist_node_t *node = ds_mem_alloc(&list->alloc, node_bytes(list));
+  if (!node) return NULL;
+
+  node->count = 0;
+  node->prev = prev;
+  node->next = prev ? prev->next : list->head;
+
+  if (node->next) node->next->prev = node;
+  else list->tail = node;
+
+  if (prev) prev->next = node;
+  else list->head = node;
+
+  return node;
+}
+
+/**
+ * @brief Unlink and free a node (its elements are not touched).
+ */
+static void ulist_node_unlink(ds_ulist_t *list, ds_ulist_node_t *node) {
+  if (node->prev) node->prev->next = node->next;
+  else list->head = node->next;
+
+  if (node->next) node->next->prev = node->prev;
+  else list->tail = node->prev;
+
+  ds_mem_free(&list->alloc, node, node_bytes(list));
+}
+
+/**
+ * @brief Create a new unrolled list.
+ */
+ds_ulist_t *ds_ulist_create(size_t node_capacity) {
+  return ds_ulist_create_ex(node_capacity, NULL);
+}
+
+/**
+ * @brief Create a new unrolled list using a custom allocator.
+ */
+ds_ulist_t *ds_ulist_create_ex(size_t node_capacity, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  if (node_capacity == 0) node_capacity = DS_ULIST_DEFAULT_NODE_CAPACITY;
+  if (node_capacity < 2) node_capacity = 2;   // Splitting needs two halves
+  if (node_capacity > (SIZE_MAX - sizeof(ds_ulist_node_t)) / sizeof(void *)) return NULL;
+
+  ds_ulist_t *list = ds_mem_alloc(allocator, sizeof(ds_ulist_t));
+  if (!list) return NULL;
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->size = 0;
+  list->node_capacity = node_capacity;
+  list->alloc = *allocator;
+
+  return list;
+}
+
+/**
+ * @brief Destroy a list and optionally free its elements.
+ */
+void ds_ulist_destroy(ds_ulist_t *list, ds_free_f free_func) {
+  // Check input parameters
+  if (!list) return;
+
+  ds_ulist_clear(list, free_func);
+  ds_mem_free(&list->alloc, list, sizeof(ds_ulist_t));
+}
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_ulist_size(const ds_ulist_t *list) {
+  if (!list) return 0;
+
+  return list->size;
+}
+
+/**
+ * @brief Check if the list is empty.
+ */
+bool ds_ulist_is_empty(const ds_ulist_t *list) {
+  if (!list) return true;
+
+  return list->size == 0;
+}
+
+/**
+ * @brief Replace the element at the specified iterator.
+ */
+ds_status_t ds_ulist_set(ds_ulist_t *list, ds_ulist_iter_t it, void *element, ds_free_f old_element_free) {
+  // Check input parameters
+  if (!list) return DS_ERR_NULL;
+  if (!it.node || it.index >= it.node->count || !element) return DS_ERR_ARG;
+
+  void *old_element = it.node->items[it.index];
+  it.node->items[it.index] = element;
+  if (old_element_free) old_element_free(old_element);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Append an element to the end of the list.
+ */
+ds_status_t ds_ulist_push_back(ds_ulist_t *list, void *element) {
+  // Check input parameters
+  if (!list) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  return ds_ulist_insert(list, ULIST_END, element);
+}
+
+/**
+ * @brief Prepend an element to the front of the list.
+ */
+ds_status_t ds_ulist_push_front(ds_ulist_t *list, void *element) {
+  // Check input parameters
+  if (!list) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  ds_ulist_node_t *node = list->head;
+  if (!node || node->count == list->node_capacity) {
+    // A fresh front node: filling it never shifts the old head
+    node = ulist_node_insert_after(list, NULL);
+    if (!node) return DS_ERR_MEM;
+  }
+
+  memmove(&node->items[1], &node->items[0], sizeof(void *) * node->count);
+  node->items[0] = element;
+  node->count ++;
+  list->size ++;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Insert an element before the specified position.
+ *
+ * Appending fills the tail node and then starts a new one, so a list
+ * built with push_back has full nodes. Inserting into a full node splits
+ * it into two halves first.
+ */
+ds_status_t ds_ulist_insert(ds_ulist_t *list, ds_ulist_iter_t it, void *element) {
+  // Check input parameters
+  if (!list) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+  if (it.node && it.index >= it.node->count) return DS_ERR_ARG;
+
+  ds_ulist_node_t *node = it.node;
+  size_t index = it.index;
+
+  // End: append to the tail node
+  if (!node) {
+    node = list->tail;
+    if (!node || node->count == list->node_capacity) {
+      node = ulist_node_insert_after(list, list->tail);
+      if (!node) return DS_ERR_MEM;
+    }
+    node->items[node->count ++] = element;
+    list->size ++;
+    return DS_OK;
+  }
+
+  if (node->count == list->node_capacity) {
+    ds_ulist_node_t *right = ulist_node_insert_after(list, node);
+    if (!right) return DS_ERR_MEM;
+
+    // Move the upper half into the new node
+    size_t keep = node->count / 2;
+    right->count = node->count - keep;
+    memcpy(right->items, &node->items[keep], sizeof(void *) * right->count);
+    node->count = keep;
+
+    if (index > keep) {
+      node = right;
+      index -= keep;
+    }
+  }
+
+  memmove(&node->items[index + 1], &node->items[index], sizeof(void *) * (node->count - index));
+  node->items[index] = element;
+  node->count ++;
+  list->size ++;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove and return the last element.
+ */
+void *ds_ulist_pop_back(ds_ulist_t *list) {
+  // Check input parameters
+  if (!list || !list->tail) return NULL;
+
+  ds_ulist_node_t *node = list->tail;
+  void *element = node->items[-- node->count];
+  if (node->count == 0) ulist_node_unlink(list, node);
+  list->size --;
+
+  return element;
+}
+
+/**
+ * @brief Remove and return the first element.
+ */
+void *ds_ulist_pop_front(ds_ulist_t *list) {
+  // Check input parameters
+  if (!list || !list->head) return NULL;
+
+  ds_ulist_node_t *node = list->head;
+  void *element = node->items[0];
+  node->count --;
+  memmove(&node->items[0], &node->items[1], sizeof(void *) * node->count);
+  if (node->count == 0) ulist_node_unlink(list, node);
+  list->size --;
+
+  return element;
+}
+
+/**
+ * @brief Remove the element at the specified iterator.
+ */
+ds_ulist_iter_t ds_ulist_remove(ds_ulist_t *list, ds_ulist_iter_t it, ds_free_f free_func) {
+  // Check input parameters
+  if (!list || !it.node || it.index >= it.node->count) return ULIST_END;
+
+  ds_ulist_node_t *node = it.node;
+  size_t index = it.index;
+
+  void *element = node->items[index];
+  node->count --;
+  memmove(&node->items[index], &node->items[index + 1], sizeof(void *) * (node->count - index));
+  list->size --;
+  if (free_func) free_func(element);
+
+  if (node->count == 0) {
+    ds_ulist_node_t *next = node->next;
+    ulist_node_unlink(list, node);
+    return (ds_ulist_iter_t){ next, 0 };
+  }
+
+  // Fold the successor in once both fit, so nodes stay at least half full
+  ds_ulist_node_t *next = node->next;
+  if (next && node->count + next->count <= list->node_capacity) {
+    memcpy(&node->items[node->count], next->items, sizeof(void *) * next->count);
+    node->count += next->count;
+    ulist_node_unlink(list, next);
+  }
+
+  if (index < node->count) return (ds_ulist_iter_t){ node, index };
+  return (ds_ulist_iter_t){ node->next, 0 };
+}
+
+/**
+ * @brief Remove all elements from the list.
+ */
+void ds_ulist_clear(ds_ulist_t *list, ds_free_f free_func) {
+  // Check input parameters
+  if (!list) return;
+
+  ds_ulist_node_t *node = list->head;
+  while (node) {
+    ds_ulist_node_t *next = node->next;
+    if (free_func) {
+      for (size_t i = 0; i < node->count; ++ i) free_func(node->items[i]);
+    }
+    ds_mem_free(&list->alloc, node, node_bytes(list));
+    node = next;
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->size = 0;
+}
+
+/**
+ * @brief Get an iterator pointing to the first element.
+ */
+ds_ulist_iter_t ds_ulist_iter_begin(ds_ulist_t *list) {
+  if (!list || !list->head) return ULIST_END;
+
+  return (ds_ulist_iter_t){ list->head, 0 };
+}
+
+/**
+ * @brief Get the End iterator.
+ */
+ds_ulist_iter_t ds_ulist_iter_end(ds_ulist_t *list) {
+  (void)list;
+
+  return ULIST_END;
+}
+
+/**
+ * @brief Get an iterator pointing to the last element (Tail).
+ */
+ds_ulist_iter_t ds_ulist_iter_tail(ds_ulist_t *list) {
+  if (!list || !list->tail) return ULIST_END;
+
+  return (ds_ulist_iter_t){ list->tail, list->tail->count - 1 };
+}
+
+/**
+ * @brief Move forward by one position.
+ */
+ds_ulist_iter_t ds_ulist_iter_next(ds_ulist_iter_t it) {
+  // Check input parameters
+  if (!it.node) return ULIST_END;
+
+  if (it.index + 1 < it.node->count) {
+    it.index ++;
+    return it;
+  }
+
+  return (ds_ulist_iter_t){ it.node->next, 0 };
+}
+
+/**
+ * @brief Move backward by one position.
+ */
+ds_ulist_iter_t ds_ulist_iter_prev(ds_ulist_iter_t it) {
+  // Check input parameters
+  if (!it.node) return ULIST_END;
+
+  if (it.index > 0) {
+    it.index --;
+    return it;
+  }
+
+  ds_ulist_node_t *prev = it.node->prev;
+  if (!prev) return ULIST_END;
+  return (ds_ulist_iter_t){ prev, prev->count - 1 };
+}
+
+/**
+ * @brief Get the data pointed to by the iterator.
+ */
+void *ds_ulist_iter_get(ds_ulist_iter_t it) {
+  if (!it.node || it.index >= it.node->count) return NULL;
+
+  return it.node->items[it.index];
+}
+
+/**
+ * @brief Determine if two iterators point to the same position.
+ */
+bool ds_ulist_iter_equal(ds_ulist_iter_t a, ds_ulist_iter_t b) {
+  return a.node == b.node && (a.node == NULL || a.index == b.index);
+}
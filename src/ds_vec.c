@@ -0,0 +1,430 @@
+/*
+** src/ds_vec.c -- Implementation of the ds_vec by-value dynamic array.
+*/
+
+#include "ds_vec.h"
+#include "ds_common.h"
+#include "ds_simd.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DS_VEC_DEFAULT_CAPACITY 16
+#define DS_VEC_GROWTH_FACTOR     2
+
+struct ds_vec {
+  unsigned char *data;  // Contiguous element storage
+  size_t elem_size;     // Size in bytes of one element
+  size_t capacity;      // Capacity in elements
+  size_t size;          // Element count
+  ds_allocator_t alloc;
+};
+
+/**
+ * @brief Address of slot `index` (no bounds check).
+ */
+static inline unsigned char *vec_slot(const ds_vec_t *vec, size_t index) {
+  return vec->data + index * vec->elem_size;
+}
+
+/**
+ * @brief Make room for at least one more element.
+ */
+static ds_status_t vec_grow_for_one(ds_vec_t *vec) {
+  if (vec->size < vec->capacity) return DS_OK;
+
+  return ds_vec_reserve(vec, vec->capacity * DS_VEC_GROWTH_FACTOR);
+}
+
+/**
+ * @brief Create a new by-value vector.
+ *
+ * @param elem_size      Size in bytes of one element. Must be non-zero.
+ * @param capacity_hint  Suggested initial capacity (in elements). If zero,
+ *                       a default capacity is used.
+ *
+ * @return Pointer to a new vector on success, or NULL on failure.
+ */
+ds_vec_t *ds_vec_create(size_t elem_size, size_t capacity_hint) {
+  return ds_vec_create_ex(elem_size, capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new by-value vector using a custom allocator.
+ *
+ * @param elem_size      Size in bytes of one element. Must be non-zero.
+ * @param capacity_hint  Suggested initial capacity (in elements). If zero,
+ *                       a default capacity is used.
+ * @param allocator      Allocator for the vector and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new vector on success, or NULL on failure.
+ */
+ds_vec_t *ds_vec_create_ex(size_t elem_size, size_t capacity_hint, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (elem_size == 0) return NULL;
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  size_t capacity = capacity_hint == 0 ? DS_VEC_DEFAULT_CAPACITY : capacity_hint;
+  if (capacity > SIZE_MAX / elem_size) return NULL;
+
+  ds_vec_t *vec = ds_mem_alloc(allocator, sizeof(ds_vec_t));
+  if (!vec) return NULL;
+
+  vec->alloc = *allocator;
+
+  vec->data = ds_mem_alloc(allocator, elem_size * capacity);
+  if (!vec->data) {
+    ds_mem_free(allocator, vec, sizeof(ds_vec_t));
+    return NULL;
+  }
+
+  vec->elem_size = elem_size;
+  vec->capacity = capacity;
+  vec->size = 0;
+
+  return vec;
+}
+
+/**
+ * @brief Destroy a vector and optionally release its elements.
+ *
+ * @param vec        Pointer to the vector.
+ * @param free_func  Optional element destructor, called on each slot.
+ */
+void ds_vec_destroy(ds_vec_t *vec, ds_free_f free_func) {
+  // Check input parameters
+  if (!vec) return;
+
+  if (free_func) {
+    for (size_t i = 0; i < vec->size; ++ i) {
+      free_func(vec_slot(vec, i));
+    }
+  }
+
+  ds_allocator_t alloc = vec->alloc;
+  ds_mem_free(&alloc, vec->data, vec->elem_size * vec->capacity);
+  ds_mem_free(&alloc, vec, sizeof(ds_vec_t));
+}
+
+/**
+ * @brief Get the current number of elements.
+ */
+size_t ds_vec_size(const ds_vec_t *vec) {
+  if (!vec) return 0;
+
+  return vec->size;
+}
+
+/**
+ * @brief Get the currently allocated capacity (in elements).
+ */
+size_t ds_vec_capacity(const ds_vec_t *vec) {
+  if (!vec) return 0;
+
+  return vec->capacity;
+}
+
+/**
+ * @brief Get the size in bytes of one element.
+ */
+size_t ds_vec_elem_size(const ds_vec_t *vec) {
+  if (!vec) return 0;
+
+  return vec->elem_size;
+}
+
+/**
+ * @brief Check if the vector is empty.
+ */
+bool ds_vec_is_empty(const ds_vec_t *vec) {
+  if (!vec) return true;
+
+  return vec->size == 0;
+}
+
+/**
+ * @brief Get a pointer to the contiguous element storage.
+ */
+void *ds_vec_data(const ds_vec_t *vec) {
+  if (!vec) return NULL;
+
+  return vec->data;
+}
+
+/**
+ * @brief Get a span over the elements.
+ */
+ds_span_t ds_vec_as_span(const ds_vec_t *vec) {
+  if (!vec) return ds_span_make(NULL, 0, 0);
+
+  return ds_span_make(vec->data, vec->size, vec->elem_size);
+}
+
+/**
+ * @brief Reserve capacity for at least new_capacity elements.
+ *
+ * @param vec           Pointer to the vector.
+ * @param new_capacity  Desired minimum capacity.
+ *
+ * @return
+ *   - DS_OK on success, or if new_capacity is less than or equal to
+ *     the current capacity.
+ *   - DS_ERR_BOUNDS if new_capacity is smaller than the current size.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vec_reserve(ds_vec_t *vec, size_t new_capacity) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+  if (new_capacity < vec->size) return DS_ERR_BOUNDS;
+  if (new_capacity <= vec->capacity) return DS_OK;
+  if (new_capacity > SIZE_MAX / vec->elem_size) return DS_ERR_MEM;
+
+  unsigned char *new_data = ds_mem_realloc(&vec->alloc, vec->data,
+                                           vec->elem_size * vec->capacity,
+                                           vec->elem_size * new_capacity);
+  if (!new_data) return DS_ERR_MEM;
+
+  vec->data = new_data;
+  vec->capacity = new_capacity;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Get a pointer to the element at the specified index.
+ *
+ * @return Pointer to the element slot, or NULL if index is out of range.
+ */
+void *ds_vec_get(const ds_vec_t *vec, size_t index) {
+  // Check input parameters
+  if (!vec || index >= vec->size) return NULL;
+
+  return vec_slot(vec, index);
+}
+
+/**
+ * @brief Overwrite the element at the specified index.
+ *
+ * @param vec               Pointer to the vector.
+ * @param index             Element index.
+ * @param element           Pointer to the value to copy in.
+ * @param old_element_free  Optional destructor for the old element.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ *   - DS_ERR_ARG if element is NULL.
+ */
+ds_status_t ds_vec_set(ds_vec_t *vec, size_t index, const void *element, ds_free_f old_element_free) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+  if (index >= vec->size) return DS_ERR_BOUNDS;
+  if (!element) return DS_ERR_ARG;
+
+  unsigned char *slot = vec_slot(vec, index);
+  if (old_element_free) old_element_free(slot);
+  memcpy(slot, element, vec->elem_size);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Append a copy of an element to the end of the vector.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if element is NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vec_push_back(ds_vec_t *vec, const void *element) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  ds_status_t ret = vec_grow_for_one(vec);
+  if (ret != DS_OK) return ret;
+
+  memcpy(vec_slot(vec, vec->size), element, vec->elem_size);
+  vec->size ++;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Append one uninitialized element and return its slot.
+ *
+ * @return Pointer to the new slot, or NULL on failure.
+ */
+void *ds_vec_emplace_back(ds_vec_t *vec) {
+  // Check input parameters
+  if (!vec) return NULL;
+
+  if (vec_grow_for_one(vec) != DS_OK) return NULL;
+
+  return vec_slot(vec, vec->size ++);
+}
+
+/**
+ * @brief Insert a copy of an element at the specified position.
+ *
+ * @param vec      Pointer to the vector.
+ * @param index    Insertion position in the range [0, size].
+ * @param element  Pointer to the value to copy in.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ *   - DS_ERR_ARG if element is NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vec_insert(ds_vec_t *vec, size_t index, const void *element) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+  if (index > vec->size) return DS_ERR_BOUNDS;
+  if (!element) return DS_ERR_ARG;
+
+  ds_status_t ret = vec_grow_for_one(vec);
+  if (ret != DS_OK) return ret;
+
+  // Move elements
+  if (index < vec->size) {
+    memmove(vec_slot(vec, index + 1),
+            vec_slot(vec, index),
+            (vec->size - index) * vec->elem_size);
+  }
+
+  memcpy(vec_slot(vec, index), element, vec->elem_size);
+  vec->size ++;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove the last element, copying it out.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_EMPTY if the vector is empty.
+ */
+ds_status_t ds_vec_pop_back(ds_vec_t *vec, void *out) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+  if (vec->size == 0) return DS_ERR_EMPTY;
+
+  vec->size --;
+  if (out) memcpy(out, vec_slot(vec, vec->size), vec->elem_size);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove the element at the specified index.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ */
+ds_status_t ds_vec_remove(ds_vec_t *vec, size_t index, ds_free_f free_func) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+  if (index >= vec->size) return DS_ERR_BOUNDS;
+
+  if (free_func) free_func(vec_slot(vec, index));
+
+  // Move
+  memmove(vec_slot(vec, index),
+          vec_slot(vec, index + 1),
+          (vec->size - index - 1) * vec->elem_size);
+  vec->size --;
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove all elements from the vector (capacity is kept).
+ */
+void ds_vec_clear(ds_vec_t *vec, ds_free_f free_func) {
+  // Check input parameters
+  if (!vec) return;
+
+  if (free_func) {
+    for (size_t i = 0; i < vec->size; ++ i) {
+      free_func(vec_slot(vec, i));
+    }
+  }
+
+  vec->size = 0;
+}
+
+/**
+ * @brief Index of the first element whose bytes equal `element`.
+ */
+size_t ds_vec_find(const ds_vec_t *vec, const void *element) {
+  // Check input parameters
+  if (!vec || !element || vec->size == 0) return SIZE_MAX;
+
+  if (vec->elem_size == sizeof(int32_t)) {
+    int32_t v;
+    memcpy(&v, element, sizeof(v));
+    return ds_simd_find_i32((const int32_t *)(void *)vec->data, vec->size, v);
+  }
+  if (vec->elem_size == sizeof(int64_t)) {
+    int64_t v;
+    memcpy(&v, element, sizeof(v));
+    return ds_simd_find_i64((const int64_t *)(void *)vec->data, vec->size, v);
+  }
+
+  for (size_t i = 0; i < vec->size; ++ i) {
+    if (memcmp(vec_slot(vec, i), element, vec->elem_size) == 0) return i;
+  }
+  return SIZE_MAX;
+}
+
+/**
+ * @brief Number of elements whose bytes equal `element`.
+ */
+size_t ds_vec_count(const ds_vec_t *vec, const void *element) {
+  // Check input parameters
+  if (!vec || !element || vec->size == 0) return 0;
+
+  if (vec->elem_size == sizeof(int32_t)) {
+    int32_t v;
+    memcpy(&v, element, sizeof(v));
+    return ds_simd_count_i32((const int32_t *)(void *)vec->data, vec->size, v);
+  }
+  if (vec->elem_size == sizeof(int64_t)) {
+    int64_t v;
+    memcpy(&v, element, sizeof(v));
+    return ds_simd_count_i64((const int64_t *)(void *)vec->data, vec->size, v);
+  }
+
+  size_t count = 0;
+  for (size_t i = 0; i < vec->size; ++ i) {
+    count += memcmp(vec_slot(vec, i), element, vec->elem_size) == 0;
+  }
+  return count;
+}
+
+/**
+ * @brief Overwrite every element with a copy of `element`.
+ */
+ds_status_t ds_vec_fill(ds_vec_t *vec, const void *element) {
+  // Check input parameters
+  if (!vec || !element) return DS_ERR_NULL;
+
+  if (vec->elem_size == sizeof(int32_t)) {
+    int32_t v;
+    memcpy(&v, element, sizeof(v));
+    ds_simd_fill_i32((int32_t *)(void *)vec->data, vec->size, v);
+  } else if (vec->elem_size == sizeof(int64_t)) {
+    int64_t v;
+    memcpy(&v, element, sizeof(v));
+    ds_simd_fill_i64((int64_t *)(void *)vec->data, vec->size, v);
+  } else {
+    for (size_t i = 0; i < vec->size; ++ i) memcpy(vec_slot(vec, i), element, vec->elem_size);
+  }
+
+  return DS_OK;
+}
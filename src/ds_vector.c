@@ -5,18 +5,63 @@
 
 #include "ds_vector.h"
 #include "ds_common.h"
+#include "ds_generic.h"
+#include "ds_simd.h"
+#include "ds_stats.h"
+#include "ds_threadpool.h"
+#include "ds_vector_inline.h"
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define DS_VECTOR_DEFAULT_CAPACITY 16
-#define DS_VECTOR_GROWTH_FACTOR     2
 
-typedef struct ds_vector {
-  void **items;     // Dynamic array, store `void *` pointer
-  size_t capacity;  // Capacity of current array
-  size_t size;      // Element count of current array
-} ds_vector_t;
+/**
+ * @brief Reallocate the storage to exactly `new_capacity` slots.
+ */
+static ds_status_t vector_set_capacity(ds_vector_t *vec, size_t new_capacity) {
+  if (new_capacity > SIZE_MAX / sizeof(void *)) return DS_ERR_MEM;
+
+  DS_STATS_TIMER(start);
+  void **new_items = ds_mem_realloc(&vec->alloc, vec->items,
+                                    sizeof(void *) * vec->capacity,
+                                    sizeof(void *) * new_capacity);
+  if (!new_items)
+    return DS_ERR_MEM;
+
+  vec->items = new_items;
+  vec->capacity = new_capacity;
+  DS_STATS_RESIZE_DONE(vec, start);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Make room for `extra` more elements, as the growth policy says.
+ */
+static ds_status_t vector_grow_for(ds_vector_t *vec, size_t extra) {
+  if (extra > SIZE_MAX - vec->size) return DS_ERR_MEM;
+
+  size_t needed = vec->size + extra;
+  if (needed <= vec->capacity) return DS_OK;
+
+  size_t new_capacity = ds_growth_next_capacity(&vec->policy, vec->capacity, needed);
+  if (new_capacity == 0) return DS_ERR_MEM;
+
+  return vector_set_capacity(vec, new_capacity);
+}
+
+/**
+ * @brief Give memory back after a removal, if the growth policy asks to.
+ *
+ * A failed shrink is harmless: the vector simply keeps its capacity.
+ */
+static void vector_maybe_shrink(ds_vector_t *vec) {
+  size_t new_capacity = ds_growth_shrink_capacity(&vec->policy, vec->size, vec->capacity);
+  if (new_capacity < vec->capacity) vector_set_capacity(vec, new_capacity);
+}
 
 /**
  * @brief Create a new dynamic vector.
@@ -27,26 +72,48 @@ typedef struct ds_vector {
  * @return Pointer to a new vector on success, or NULL on failure.
  */
 ds_vector_t *ds_vector_create(size_t capacity_hint) {
+  return ds_vector_create_ex(capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new dynamic vector using a custom allocator.
+ *
+ * @param capacity_hint  Suggested initial capacity. If zero, a default
+ *                       capacity is used.
+ * @param allocator      Allocator for the vector and its storage. It is
+ *                       copied. If NULL, the default allocator is used.
+ *
+ * @return Pointer to a new vector on success, or NULL on failure.
+ */
+ds_vector_t *ds_vector_create_ex(size_t capacity_hint, const ds_allocator_t *allocator) {
   // Check input paraments
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
   size_t capacity = \
     capacity_hint == 0 \
     ? DS_VECTOR_DEFAULT_CAPACITY \
     : capacity_hint;
   
   // Allocate memory spaces for `ds_vector_t`
-  ds_vector_t *vec = malloc(sizeof(ds_vector_t));
+  ds_vector_t *vec = ds_mem_alloc(allocator, sizeof(ds_vector_t));
   if (!vec) 
     return NULL;
 
+  vec->alloc = *allocator;
+  DS_STATS_ATTACH(vec, "ds_vector", &vec->alloc);
+
   // Allocate memory spaces for `items`
-  vec->items = malloc(sizeof(void *) * capacity);
+  vec->items = ds_mem_alloc(&vec->alloc, sizeof(void *) * capacity);
   if (!vec->items) {
-    free(vec);
+    DS_STATS_DETACH(vec, &vec->alloc);
+    ds_mem_free(allocator, vec, sizeof(ds_vector_t));
     return NULL;
   }
 
   vec->size = 0;
   vec->capacity = capacity;
+  vec->policy = *ds_growth_policy_default();
   
   // Success
   return vec;
@@ -72,8 +139,10 @@ void ds_vector_destroy(ds_vector_t *vec, ds_free_f free_func) {
   }
 
   // Free the memory of the vector
-  free(vec->items);
-  free(vec);
+  ds_mem_free(&vec->alloc, vec->items, sizeof(void *) * vec->capacity);
+  DS_STATS_DETACH(vec, &vec->alloc);
+  ds_allocator_t alloc = vec->alloc;
+  ds_mem_free(&alloc, vec, sizeof(ds_vector_t));
 }
 
 /**
@@ -127,13 +196,46 @@ ds_status_t ds_vector_reserve(ds_vector_t *vec, size_t new_capacity) {
   if ( new_capacity < vec->size) return DS_ERR_BOUNDS;
   if (new_capacity <= vec->capacity) return DS_OK;
 
-  void **new_items = realloc(vec->items, sizeof(void *) * new_capacity);
-  if (!new_items)
-    return DS_ERR_MEM;
-  
-  vec->items = new_items;
-  vec->capacity = new_capacity;
-  
+  return vector_set_capacity(vec, new_capacity);
+}
+
+/**
+ * @brief Release unused capacity so that capacity == size.
+ *
+ * @param vec  Pointer to the vector.
+ *
+ * @return
+ *   - DS_OK on success (an empty vector keeps a single slot).
+ *   - DS_ERR_MEM if memory allocation fails; the vector is unchanged.
+ */
+ds_status_t ds_vector_shrink_to_fit(ds_vector_t *vec) {
+  // Check input paraments
+  if (!vec) return DS_ERR_NULL;
+
+  size_t new_capacity = vec->size > 0 ? vec->size : 1;
+  if (new_capacity >= vec->capacity) return DS_OK;
+
+  return vector_set_capacity(vec, new_capacity);
+}
+
+/**
+ * @brief Set the growth policy of the vector.
+ *
+ * @param vec     Pointer to the vector.
+ * @param policy  New policy. It is copied. If NULL, the default is restored.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if the policy is out of range.
+ */
+ds_status_t ds_vector_set_growth_policy(ds_vector_t *vec, const ds_growth_policy_t *policy) {
+  // Check input paraments
+  if (!vec) return DS_ERR_NULL;
+  if (!policy) policy = ds_growth_policy_default();
+  if (!ds_growth_policy_is_valid(policy)) return DS_ERR_ARG;
+
+  vec->policy = *policy;
+
   return DS_OK;
 }
 
@@ -152,6 +254,24 @@ void *ds_vector_get(const ds_vector_t *vec, size_t index) {
   return vec->items[index];
 }
 
+/**
+ * @brief Get the contiguous array of element pointers.
+ */
+void **ds_vector_data(const ds_vector_t *vec) {
+  if (!vec) return NULL;
+
+  return vec->items;
+}
+
+/**
+ * @brief Get a span over the elements.
+ */
+ds_span_t ds_vector_as_span(const ds_vector_t *vec) {
+  if (!vec) return ds_span_make(NULL, 0, sizeof(void *));
+
+  return ds_span_make(vec->items, vec->size, sizeof(void *));
+}
+
 /**
  * @brief Replace the element at the specified index. 
  *
@@ -225,15 +345,9 @@ ds_status_t ds_vector_insert(ds_vector_t *vec, size_t index, void *element) {
   if (!element) return DS_ERR_ARG;
 
   // Check the capacity of vector
-  if (vec->size == vec->capacity) {
-    // Capacity expansion
-    int growth_factor = DS_VECTOR_GROWTH_FACTOR;
-    size_t new_capacity = vec->capacity * growth_factor;
-
-    ds_status_t ret = ds_vector_reserve(vec, new_capacity);
-    if (ret != DS_OK)
-      return ret;
-  }
+  ds_status_t ret = vector_grow_for(vec, 1);
+  if (ret != DS_OK)
+    return ret;
 
   // Move elements
   if (index < vec->size) {
@@ -248,6 +362,66 @@ ds_status_t ds_vector_insert(ds_vector_t *vec, size_t index, void *element) {
   return DS_OK;
 }
 
+/**
+ * @brief Append `count` elements to the end of the vector.
+ *
+ * @param vec       Pointer to the vector.
+ * @param elements  Array of `count` element pointers. None may be NULL.
+ * @param count     Number of elements to append. Zero is a no-op.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_ARG if elements is NULL (with count > 0) or contains NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vector_append_range(ds_vector_t *vec, void *const *elements, size_t count) {
+  // Check input paraments
+  if (!vec) return DS_ERR_NULL;
+
+  return ds_vector_insert_range(vec, vec->size, elements, count);
+}
+
+/**
+ * @brief Insert `count` elements at the specified position.
+ *
+ * @param vec       Pointer to the vector.
+ * @param index     Insertion position in the range [0, size].
+ * @param elements  Array of `count` element pointers. None may be NULL.
+ * @param count     Number of elements to insert. Zero is a no-op.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if index is out of range.
+ *   - DS_ERR_ARG if elements is NULL (with count > 0) or contains NULL.
+ *   - DS_ERR_MEM if memory allocation fails.
+ */
+ds_status_t ds_vector_insert_range(ds_vector_t *vec, size_t index, void *const *elements, size_t count) {
+  // Check input paraments
+  if (!vec) return DS_ERR_NULL;
+  if (index > vec->size) return DS_ERR_BOUNDS;
+  if (count == 0) return DS_OK;
+  if (!elements) return DS_ERR_ARG;
+  for (size_t i = 0; i < count; ++ i) {
+    if (!elements[i]) return DS_ERR_ARG;
+  }
+
+  // Grow once for the whole batch
+  ds_status_t ret = vector_grow_for(vec, count);
+  if (ret != DS_OK) return ret;
+
+  // Shift the tail once
+  if (index < vec->size) {
+    memmove(&vec->items[index + count],
+            &vec->items[index],
+            (vec->size - index) * sizeof(void *));
+  }
+
+  memcpy(&vec->items[index], elements, count * sizeof(void *));
+  vec->size += count;
+
+  return DS_OK;
+}
+
 /**
  * @brief Remove and return the last element.
  *
@@ -264,6 +438,7 @@ void *ds_vector_pop_back(ds_vector_t *vec) {
 
   void *val = vec->items[vec->size-1];
   vec->size --;
+  vector_maybe_shrink(vec);
 
   return val;
 }
@@ -302,6 +477,42 @@ ds_status_t ds_vector_remove(ds_vector_t *vec, size_t index, ds_free_f free_func
   }
 
   vec->size --;
+  vector_maybe_shrink(vec);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Remove the elements in [index, index + count).
+ *
+ * @param vec        Pointer to the vector.
+ * @param index      Index of the first element to remove.
+ * @param count      Number of elements to remove. Zero is a no-op.
+ * @param free_func  Optional element destructor.
+ *
+ * @return
+ *   - DS_OK on success.
+ *   - DS_ERR_BOUNDS if the range does not lie within [0, size].
+ */
+ds_status_t ds_vector_remove_range(ds_vector_t *vec, size_t index, size_t count, ds_free_f free_func) {
+  // Check input paraments
+  if (!vec) return DS_ERR_NULL;
+  if (index > vec->size || count > vec->size - index) return DS_ERR_BOUNDS;
+  if (count == 0) return DS_OK;
+
+  // Free
+  if (free_func) {
+    for (size_t i = index; i < index + count; ++ i) {
+      free_func(vec->items[i]);
+    }
+  }
+
+  // Shift the tail once
+  memmove(&vec->items[index],
+          &vec->items[index + count],
+          (vec->size - index - count) * sizeof(void *));
+  vec->size -= count;
+  vector_maybe_shrink(vec);
 
   return DS_OK;
 }
@@ -326,6 +537,281 @@ void ds_vector_clear(ds_vector_t *vec, ds_free_f free_func) {
   }
 
   vec->size = 0;
+  vector_maybe_shrink(vec);
 
   return;
 }
+
+/**
+ * @brief Get the instrumentation counters (DS_ENABLE_STATS builds).
+ */
+ds_status_t ds_vector_stats(const ds_vector_t *vec, ds_stats_t *out) {
+  // Check input parameters
+  if (!vec || !out) return DS_ERR_NULL;
+
+  return DS_STATS_COPY(vec, out);
+}
+
+/**
+ * @brief Index of the first element identical to `element`.
+ */
+size_t ds_vector_find(const ds_vector_t *vec, const void *element) {
+  // Check input parameters
+  if (!vec) return SIZE_MAX;
+
+  return ds_simd_find_ptr(vec->items, vec->size, element);
+}
+
+/**
+ * @brief Number of elements identical to `element`.
+ */
+size_t ds_vector_count(const ds_vector_t *vec, const void *element) {
+  // Check input parameters
+  if (!vec) return 0;
+
+  return ds_simd_count_ptr(vec->items, vec->size, element);
+}
+
+/* -------------------------------------------------------------------------
+ * Sorting
+ * -------------------------------------------------------------------------
+ *
+ * Both introsorts come from the DS_DEFINE_SORT templates: one calls the
+ * user's comparison, the other orders by address with the comparison
+ * inlined (compare == NULL).
+ */
+
+DS_DEFINE_SORT_CTX(vector_cmp, void *, ds_compare_f, ctx(a, b) < 0)
+DS_DEFINE_SORT(vector_addr, void *, (uintptr_t)a < (uintptr_t)b)
+
+/*
+ * Parallel sort:
+ *   1. Cut the array into a power-of-two number of runs (at least one
+ *      per worker) and introsort every run in its own task.
+ *   2. Merge neighbouring runs pairwise, doubling the run length each
+ *      round and ping-ponging between the vector and a scratch array.
+ *      Every merge is split into output segments of equal length; a
+ *      task finds where its segment starts in both inputs by binary
+ *      search (merge path), so the last rounds use all workers too.
+ * The runs are sorted into whichever buffer makes the final round write
+ * back into the vector.
+ */
+#define VECTOR_PARALLEL_MIN_RUN  4096
+#define VECTOR_TASKS_PER_THREAD  4
+
+typedef struct {
+  void **src;
+  void **dst;
+  size_t lo, mid, hi;       // Runs [lo, mid) and [mid, hi) of src (sort: [lo, hi))
+  size_t out_lo, out_hi;    // Output segment within [lo, hi) (merge)
+  ds_compare_f compare;
+  ds_visit_f visit;
+} vector_task_t;
+
+static inline bool vector_less(ds_compare_f compare, const void *a, const void *b) {
+  return compare ? compare(a, b) < 0 : (uintptr_t)a < (uintptr_t)b;
+}
+
+static void vector_sort_range(void **data, size_t n, ds_compare_f compare) {
+  if (compare) vector_cmp_sort(data, n, compare);
+  else vector_addr_sort(data, n);
+}
+
+/**
+ * @brief Number of elements taken from `a` among the first k outputs of
+ *        merging a[0, na) with b[0, nb) (ties go to `a`).
+ */
+static size_t vector_merge_split(void *const *a, size_t na, void *const *b, size_t nb,
+                                 size_t k, ds_compare_f compare) {
+  size_t lo = k > nb ? k - nb : 0;
+  size_t hi = k < na ? k : na;
+
+  while (lo < hi) {
+    size_t i = lo + (hi - lo) / 2;
+    if (!vector_less(compare, b[k - i - 1], a[i])) lo = i + 1;
+    else hi = i;
+  }
+
+  return lo;
+}
+
+/**
+ * @brief Start of run r when n elements are cut into `runs` runs.
+ */
+static size_t vector_run_bound(size_t n, size_t runs, size_t r) {
+  return n / runs * r + (r < n % runs ? r : n % runs);
+}
+
+static void vector_sort_task(void *arg) {
+  vector_task_t *task = arg;
+
+  if (task->src != task->dst) {
+    memcpy(task->dst + task->lo, task->src + task->lo, sizeof(void *) * (task->hi - task->lo));
+  }
+  vector_sort_range(task->dst + task->lo, task->hi - task->lo, task->compare);
+}
+
+static void vector_merge_task(void *arg) {
+  vector_task_t *task = arg;
+  void *const *a = task->src + task->lo;
+  void *const *b = task->src + task->mid;
+  size_t na = task->mid - task->lo;
+  size_t nb = task->hi - task->mid;
+
+  size_t k_lo = task->out_lo - task->lo;
+  size_t k_hi = task->out_hi - task->lo;
+  size_t i = vector_merge_split(a, na, b, nb, k_lo, task->compare);
+  size_t i_end = vector_merge_split(a, na, b, nb, k_hi, task->compare);
+  size_t j = k_lo - i;
+  size_t j_end = k_hi - i_end;
+
+  void **out = task->dst + task->out_lo;
+  while (i < i_end && j < j_end) {
+    if (vector_less(task->compare, b[j], a[i])) *out ++ = b[j ++];
+    else *out ++ = a[i ++];
+  }
+  while (i < i_end) *out ++ = a[i ++];
+  while (j < j_end) *out ++ = b[j ++];
+}
+
+static void vector_for_each_task(void *arg) {
+  vector_task_t *task = arg;
+
+  for (size_t i = task->lo; i < task->hi; ++ i) task->visit(task->src[i]);
+}
+
+static void vector_run_task(ds_threadpool_t *pool, ds_task_f func, vector_task_t *task) {
+  if (ds_threadpool_submit(pool, func, task) != DS_OK) func(task);
+}
+
+/**
+ * @brief Sort the elements in place.
+ */
+ds_status_t ds_vector_sort(ds_vector_t *vec, ds_compare_f compare) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+
+  vector_sort_range(vec->items, vec->size, compare);
+  return DS_OK;
+}
+
+/**
+ * @brief Sort the elements in place, from several threads.
+ */
+ds_status_t ds_vector_parallel_sort(ds_vector_t *vec, ds_compare_f compare, size_t nthreads) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+
+  size_t n = vec->size;
+  if (nthreads == 1 || n < 2 * VECTOR_PARALLEL_MIN_RUN) {
+    vector_sort_range(vec->items, n, compare);
+    return DS_OK;
+  }
+
+  // Workers free their tasks: keep the (maybe not thread-safe) vector
+  // allocator off the pool and use it only on this thread
+  ds_threadpool_t *pool = ds_threadpool_create(nthreads);
+  if (!pool) {
+    vector_sort_range(vec->items, n, compare);
+    return DS_OK;
+  }
+
+  // Runs: the next power of two >= threads, but no shorter than MIN_RUN
+  size_t threads = ds_threadpool_size(pool);
+  size_t runs = 1, rounds = 0;
+  while (runs < threads && n / (runs << 1) >= VECTOR_PARALLEL_MIN_RUN) {
+    runs <<= 1;
+    rounds ++;
+  }
+
+  size_t segment = (n + threads * VECTOR_TASKS_PER_THREAD - 1) / (threads * VECTOR_TASKS_PER_THREAD);
+  if (segment < VECTOR_PARALLEL_MIN_RUN) segment = VECTOR_PARALLEL_MIN_RUN;
+  size_t max_tasks = runs + (n + segment - 1) / segment;
+
+  void **tmp = runs > 1 ? ds_mem_alloc(&vec->alloc, sizeof(void *) * n) : NULL;
+  vector_task_t *tasks = tmp ? ds_mem_alloc(&vec->alloc, sizeof(vector_task_t) * max_tasks) : NULL;
+  if (!tasks) {
+    if (tmp) ds_mem_free(&vec->alloc, tmp, sizeof(void *) * n);
+    ds_threadpool_destroy(pool);
+    vector_sort_range(vec->items, n, compare);
+    return DS_OK;
+  }
+
+  void **bufs[2] = { vec->items, tmp };
+  size_t cur = rounds & 1;
+
+  // Phase 1: sort every run (into tmp when an odd number of rounds follows)
+  for (size_t r = 0; r < runs; ++ r) {
+    tasks[r] = (vector_task_t){ .src = vec->items, .dst = bufs[cur], .compare = compare,
+                                .lo = vector_run_bound(n, runs, r),
+                                .hi = vector_run_bound(n, runs, r + 1) };
+    vector_run_task(pool, vector_sort_task, &tasks[r]);
+  }
+  ds_threadpool_wait(pool);
+
+  // Phase 2: merge rounds, each split into equal output segments
+  for (size_t step = 1; step < runs; step <<= 1) {
+    size_t t = 0;
+    for (size_t r = 0; r < runs; r += 2 * step) {
+      size_t lo = vector_run_bound(n, runs, r);
+      size_t mid = vector_run_bound(n, runs, r + step);
+      size_t hi = vector_run_bound(n, runs, r + 2 * step);
+
+      for (size_t out = lo; out < hi; out += segment) {
+        tasks[t] = (vector_task_t){ .src = bufs[cur], .dst = bufs[cur ^ 1], .compare = compare,
+                                    .lo = lo, .mid = mid, .hi = hi, .out_lo = out,
+                                    .out_hi = hi - out > segment ? out + segment : hi };
+        vector_run_task(pool, vector_merge_task, &tasks[t ++]);
+      }
+    }
+    ds_threadpool_wait(pool);
+    cur ^= 1;
+  }
+
+  ds_threadpool_destroy(pool);
+  ds_mem_free(&vec->alloc, tasks, sizeof(vector_task_t) * max_tasks);
+  ds_mem_free(&vec->alloc, tmp, sizeof(void *) * n);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Visit every element once, from several threads.
+ */
+ds_status_t ds_vector_parallel_for_each(const ds_vector_t *vec, ds_visit_f visit, size_t nthreads) {
+  // Check input parameters
+  if (!vec) return DS_ERR_NULL;
+  if (!visit) return DS_ERR_ARG;
+
+  size_t n = vec->size;
+  ds_threadpool_t *pool = NULL;
+  vector_task_t *tasks = NULL;
+  size_t chunks = 0;
+
+  if (nthreads != 1 && n > 1) pool = ds_threadpool_create(nthreads);  // See parallel_sort
+  if (pool) {
+    chunks = ds_threadpool_size(pool) * VECTOR_TASKS_PER_THREAD;
+    if (chunks > n) chunks = n;
+    tasks = ds_mem_alloc(&vec->alloc, sizeof(vector_task_t) * chunks);
+  }
+
+  // Single thread requested, or no resources for threads: walk in place
+  if (!tasks) {
+    if (pool) ds_threadpool_destroy(pool);
+    for (size_t i = 0; i < n; ++ i) visit(vec->items[i]);
+    return DS_OK;
+  }
+
+  for (size_t c = 0; c < chunks; ++ c) {
+    tasks[c] = (vector_task_t){ .src = vec->items, .visit = visit,
+                                .lo = vector_run_bound(n, chunks, c),
+                                .hi = vector_run_bound(n, chunks, c + 1) };
+    vector_run_task(pool, vector_for_each_task, &tasks[c]);
+  }
+
+  ds_threadpool_wait(pool);
+  ds_threadpool_destroy(pool);
+  ds_mem_free(&vec->alloc, tasks, sizeof(vector_task_t) * chunks);
+
+  return DS_OK;
+}
@@ -0,0 +1,242 @@
+/*
+** src/ds_wsdeque.c -- Implementation of the Chase-Lev work-stealing deque.
+*/
+
+#include "ds_wsdeque.h"
+#include "ds_common.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DS_WSDEQUE_DEFAULT_CAPACITY 64
+#define DS_CACHE_LINE               64
+
+/*
+ * Circular buffer. Slots are atomics only so a thief reading a slot the
+ * owner is overwriting is not a data race; all accesses are relaxed and
+ * ordering comes from top/bottom.
+ */
+typedef struct ds_wsdeque_buf {
+  size_t mask;
+  struct ds_wsdeque_buf *prev;   // Smaller buffer this one replaced
+  _Atomic(void *) slots[];
+} ds_wsdeque_buf_t;
+
+/*
+ * top and bottom are free-running: size = bottom - top.
+ */
+struct ds_wsdeque {
+  atomic_size_t top;                   // Next element to steal
+  char pad0[DS_CACHE_LINE];
+
+  atomic_size_t bottom;                // Next free slot (owner side)
+  _Atomic(ds_wsdeque_buf_t *) buf;
+  ds_allocator_t alloc;
+  char pad1[DS_CACHE_LINE];
+};
+
+/**
+ * @brief Allocate a buffer of `capacity` (a power of two) slots.
+ */
+static ds_wsdeque_buf_t *wsdeque_buf_create(const ds_allocator_t *alloc, size_t capacity) {
+  if (capacity > (SIZE_MAX - sizeof(ds_wsdeque_buf_t)) / sizeof(void *)) return NULL;
+
+  ds_wsdeque_buf_t *buf = ds_mem_alloc(alloc, sizeof(ds_wsdeque_buf_t) + capacity * sizeof(void *));
+  if (!buf) return NULL;
+
+  buf->mask = capacity - 1;
+  buf->prev = NULL;
+  return buf;
+}
+
+/**
+ * @brief Free a buffer.
+ */
+static void wsdeque_buf_free(const ds_allocator_t *alloc, ds_wsdeque_buf_t *buf) {
+  ds_mem_free(alloc, buf, sizeof(ds_wsdeque_buf_t) + (buf->mask + 1) * sizeof(void *));
+}
+
+/**
+ * @brief Copy [top, bottom) into a buffer twice as large (owner only).
+ *
+ * The old buffer is chained on `prev` instead of freed, since a thief may
+ * have loaded it just before the swap.
+ */
+static ds_wsdeque_buf_t *wsdeque_grow(ds_wsdeque_t *deque, ds_wsdeque_buf_t *old,
+                                      size_t top, size_t bottom) {
+  if (old->mask + 1 > SIZE_MAX / 2) return NULL;
+
+  ds_wsdeque_buf_t *buf = wsdeque_buf_create(&deque->alloc, (old->mask + 1) * 2);
+  if (!buf) return NULL;
+
+  for (size_t i = top; i != bottom; ++ i) {
+    void *element = atomic_load_explicit(&old->slots[i & old->mask], memory_order_relaxed);
+    atomic_store_explicit(&buf->slots[i & buf->mask], element, memory_order_relaxed);
+  }
+
+  buf->prev = old;
+  atomic_store_explicit(&deque->buf, buf, memory_order_release);
+  return buf;
+}
+
+/**
+ * @brief Create a new work-stealing deque.
+ */
+ds_wsdeque_t *ds_wsdeque_create(size_t capacity_hint) {
+  return ds_wsdeque_create_ex(capacity_hint, NULL);
+}
+
+/**
+ * @brief Create a new work-stealing deque using a custom allocator.
+ */
+ds_wsdeque_t *ds_wsdeque_create_ex(size_t capacity_hint, const ds_allocator_t *allocator) {
+  // Check input parameters
+  if (!allocator) allocator = ds_allocator_default();
+  if (!allocator->alloc || !allocator->free) return NULL;
+
+  size_t capacity = 2;
+  size_t wanted = capacity_hint == 0 ? DS_WSDEQUE_DEFAULT_CAPACITY : capacity_hint;
+  while (capacity < wanted) {
+    if (capacity > SIZE_MAX / 2) return NULL;
+    capacity <<= 1;
+  }
+
+  ds_wsdeque_t *deque = ds_mem_alloc(allocator, sizeof(ds_wsdeque_t));
+  if (!deque) return NULL;
+
+  ds_wsdeque_buf_t *buf = wsdeque_buf_create(allocator, capacity);
+  if (!buf) {
+    ds_mem_free(allocator, deque, sizeof(ds_wsdeque_t));
+    return NULL;
+  }
+
+  deque->alloc = *allocator;
+  atomic_init(&deque->top, 0);
+  atomic_init(&deque->bottom, 0);
+  atomic_init(&deque->buf, buf);
+
+  return deque;
+}
+
+/**
+ * @brief Destroy a deque and optionally free the elements still queued.
+ */
+void ds_wsdeque_destroy(ds_wsdeque_t *deque, ds_free_f free_func) {
+  // Check input parameters
+  if (!deque) return;
+
+  ds_wsdeque_buf_t *buf = atomic_load_explicit(&deque->buf, memory_order_relaxed);
+
+  if (free_func) {
+    size_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    size_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    for (size_t i = top; i != bottom; ++ i) {
+      free_func(atomic_load_explicit(&buf->slots[i & buf->mask], memory_order_relaxed));
+    }
+  }
+
+  ds_allocator_t alloc = deque->alloc;
+  while (buf) {
+    ds_wsdeque_buf_t *prev = buf->prev;
+    wsdeque_buf_free(&alloc, buf);
+    buf = prev;
+  }
+  ds_mem_free(&alloc, deque, sizeof(ds_wsdeque_t));
+}
+
+/**
+ * @brief Get a snapshot of the number of queued elements.
+ */
+size_t ds_wsdeque_size(const ds_wsdeque_t *deque) {
+  if (!deque) return 0;
+
+  ds_wsdeque_t *d = (ds_wsdeque_t *)deque;
+  size_t top = atomic_load_explicit(&d->top, memory_order_acquire);
+  size_t bottom = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+  // pop() briefly moves bottom below top on an empty deque
+  ptrdiff_t size = (ptrdiff_t)(bottom - top);
+  return size > 0 ? (size_t)size : 0;
+}
+
+/**
+ * @brief Push an element at the back (owner thread only).
+ */
+ds_status_t ds_wsdeque_push(ds_wsdeque_t *deque, void *element) {
+  // Check input parameters
+  if (!deque) return DS_ERR_NULL;
+  if (!element) return DS_ERR_ARG;
+
+  size_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+  size_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  ds_wsdeque_buf_t *buf = atomic_load_explicit(&deque->buf, memory_order_relaxed);
+
+  if (bottom - top > buf->mask) {
+    buf = wsdeque_grow(deque, buf, top, bottom);
+    if (!buf) return DS_ERR_MEM;
+  }
+
+  atomic_store_explicit(&buf->slots[bottom & buf->mask], element, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+  return DS_OK;
+}
+
+/**
+ * @brief Pop the most recently pushed element (owner thread only).
+ */
+void *ds_wsdeque_pop(ds_wsdeque_t *deque) {
+  // Check input parameters
+  if (!deque) return NULL;
+
+  size_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+  ds_wsdeque_buf_t *buf = atomic_load_explicit(&deque->buf, memory_order_relaxed);
+
+  // Reserve the slot first, then look at top: thieves do the opposite
+  atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  size_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+  if ((ptrdiff_t)(bottom - top) < 0) {
+    // Empty
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return NULL;
+  }
+
+  void *element = atomic_load_explicit(&buf->slots[bottom & buf->mask], memory_order_relaxed);
+  if (bottom != top) return element;
+
+  // Last element: race the thieves for it
+  if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                               memory_order_seq_cst, memory_order_relaxed)) {
+    element = NULL;
+  }
+  atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+  return element;
+}
+
+/**
+ * @brief Steal the oldest element (any thread).
+ */
+void *ds_wsdeque_steal(ds_wsdeque_t *deque) {
+  // Check input parameters
+  if (!deque) return NULL;
+
+  size_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  size_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+  if ((ptrdiff_t)(bottom - top) <= 0) return NULL;
+
+  ds_wsdeque_buf_t *buf = atomic_load_explicit(&deque->buf, memory_order_acquire);
+  void *element = atomic_load_explicit(&buf->slots[top & buf->mask], memory_order_relaxed);
+
+  if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                               memory_order_seq_cst, memory_order_relaxed)) {
+    return NULL;
+  }
+
+  return element;
+}
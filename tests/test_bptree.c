@@ -0,0 +1,376 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ds_bptree.h"
+#include "ds_common.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+static int *mk_int(int v) {
+  int *p = (int *)malloc(sizeof(int));
+  if (!p) return NULL;
+  *p = v;
+  return p;
+}
+
+static int int_val(const void *p) {
+  return p ? *(const int *)p : 0;
+}
+
+/* compare for ints stored as int* */
+static int int_compare(const void *a, const void *b) {
+  int x = *(const int *)a;
+  int y = *(const int *)b;
+  if (x < y) return -1;
+  if (x > y) return 1;
+  return 0;
+}
+
+static int g_free_count = 0;
+static void counted_free(void *p) {
+  if (p) g_free_count++;
+  free(p);
+}
+
+/* collect inorder output */
+static int g_out[4096];
+static size_t g_out_n = 0;
+
+static void out_reset(void) {
+  g_out_n = 0;
+  memset(g_out, 0, sizeof(g_out));
+}
+
+static void visit_collect(void *data) {
+  if (g_out_n < sizeof(g_out)/sizeof(g_out[0])) {
+    g_out[g_out_n++] = *(int *)data;
+  }
+}
+
+static void assert_sorted_strict_increasing(const int *arr, size_t n, const char *msg) {
+  if (n == 0) { ASSERT(1, msg); return; }
+  for (size_t i = 1; i < n; i++) {
+    if (!(arr[i-1] < arr[i])) {
+      ASSERT(0, msg);
+      return;
+    }
+  }
+  ASSERT(1, msg);
+}
+
+/* Counting allocator: tracks live bytes so leaks and size mismatches show up. */
+typedef struct {
+  size_t live_bytes;
+  size_t allocs;
+  size_t frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  counting_ctx_t *c = ctx;
+  void *p = malloc(size);
+  if (p) { c->live_bytes += size; c->allocs ++; }
+  return p;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  counting_ctx_t *c = ctx;
+  void *p = realloc(ptr, new_size);
+  if (p) c->live_bytes = c->live_bytes - old_size + new_size;
+  return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+  counting_ctx_t *c = ctx;
+  if (!ptr) return;
+  c->live_bytes -= size;
+  c->frees ++;
+  free(ptr);
+}
+
+static ds_allocator_t counting_allocator(counting_ctx_t *ctx) {
+  ds_allocator_t a = { counting_alloc, counting_realloc, counting_free, ctx };
+  return a;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_bptree_create_basic) {
+  ds_bptree_t *t = ds_bptree_create(NULL);
+  ASSERT_NULL(t, "create(NULL compare) returns NULL");
+
+  t = ds_bptree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create(compare) non-NULL");
+  ASSERT_EQ(ds_bptree_size(t), 0u, "new tree size==0");
+  ASSERT_EQ(ds_bptree_height(t), 0u, "new tree height==0");
+  ASSERT_NULL(ds_bptree_min(t), "min(empty)==NULL");
+  ASSERT_NULL(ds_bptree_max(t), "max(empty)==NULL");
+  ASSERT(ds_bptree_iter_is_end(ds_bptree_iter_begin(t)), "begin(empty)==end");
+
+  int key = 1;
+  ASSERT_NULL(ds_bptree_search(t, &key), "search(empty)==NULL");
+
+  ds_bptree_destroy(t, NULL);
+}
+
+TEST_FUNC(test_bptree_insert_search_min_max_inorder) {
+  ds_bptree_t *t = ds_bptree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  int vals[] = {5, 3, 7, 2, 4, 6, 8};
+  for (size_t i = 0; i < sizeof(vals)/sizeof(vals[0]); i++) {
+    ASSERT_EQ(ds_bptree_insert(t, mk_int(vals[i])), DS_OK, "insert OK");
+  }
+  ASSERT_EQ(ds_bptree_size(t), 7u, "size==7");
+
+  int k2 = 2, k8 = 8, k4 = 4, k10 = 10;
+  ASSERT_EQ(int_val(ds_bptree_search(t, &k2)), 2, "search 2 found");
+  ASSERT_EQ(int_val(ds_bptree_search(t, &k8)), 8, "search 8 found");
+  ASSERT_EQ(int_val(ds_bptree_search(t, &k4)), 4, "search 4 found");
+  ASSERT_NULL(ds_bptree_search(t, &k10), "search 10 not found");
+
+  ASSERT_EQ(int_val(ds_bptree_min(t)), 2, "min==2");
+  ASSERT_EQ(int_val(ds_bptree_max(t)), 8, "max==8");
+
+  out_reset();
+  ds_bptree_traverse_inorder(t, visit_collect);
+  ASSERT_EQ(g_out_n, 7u, "inorder visits 7");
+  assert_sorted_strict_increasing(g_out, g_out_n, "inorder is strictly increasing");
+
+  int *dup = mk_int(5);
+  ASSERT_EQ(ds_bptree_insert(t, dup), DS_ERR_EXIST, "insert duplicate => DS_ERR_EXIST");
+  free(dup);
+  ASSERT_EQ(ds_bptree_insert(NULL, &k2), DS_ERR_NULL, "insert(NULL tree) => DS_ERR_NULL");
+  ASSERT_EQ(ds_bptree_insert(t, NULL), DS_ERR_ARG, "insert(NULL data) => DS_ERR_ARG");
+
+  ds_bptree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_bptree_iterators_and_range) {
+  ds_bptree_t *t = ds_bptree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  /* even keys 0..998, enough to span several leaves */
+  enum { N = 500 };
+  for (int i = N - 1; i >= 0; i--) ds_bptree_insert(t, mk_int(i * 2));
+  ASSERT_EQ(ds_bptree_size(t), (size_t)N, "size==N");
+  ASSERT(ds_bptree_height(t) > 1u, "multi-level tree");
+
+  /* forward iteration */
+  int expect = 0, ok = 1;
+  size_t n = 0;
+  for (ds_bptree_iter_t it = ds_bptree_iter_begin(t); !ds_bptree_iter_is_end(it); it = ds_bptree_iter_next(it)) {
+    if (int_val(ds_bptree_iter_get(it)) != expect) ok = 0;
+    expect += 2;
+    n++;
+  }
+  ASSERT(ok, "forward iteration yields sorted keys");
+  ASSERT_EQ(n, (size_t)N, "forward iteration visits N");
+
+  /* lower_bound on a present and a missing key */
+  int k100 = 100, k101 = 101, kbig = 5000, kneg = -5;
+  ASSERT_EQ(int_val(ds_bptree_iter_get(ds_bptree_lower_bound(t, &k100))), 100, "lower_bound(100)==100");
+  ASSERT_EQ(int_val(ds_bptree_iter_get(ds_bptree_lower_bound(t, &k101))), 102, "lower_bound(101)==102");
+  ASSERT(ds_bptree_iter_is_end(ds_bptree_lower_bound(t, &kbig)), "lower_bound(past max)==end");
+  ASSERT_EQ(int_val(ds_bptree_iter_get(ds_bptree_lower_bound(t, &kneg))), 0, "lower_bound(before min)==min");
+
+  /* backward iteration from the lower bound */
+  ds_bptree_iter_t it = ds_bptree_lower_bound(t, &k100);
+  expect = 100;
+  ok = 1;
+  n = 0;
+  for (; !ds_bptree_iter_is_end(it); it = ds_bptree_iter_prev(it)) {
+    if (int_val(ds_bptree_iter_get(it)) != expect) ok = 0;
+    expect -= 2;
+    n++;
+  }
+  ASSERT(ok, "backward iteration yields sorted keys");
+  ASSERT_EQ(n, 51u, "backward iteration from 100 visits 51");
+
+  /* range [101, 121) */
+  int lo = 101, hi = 121;
+  out_reset();
+  ds_bptree_traverse_range(t, &lo, &hi, visit_collect);
+  ASSERT_EQ(g_out_n, 10u, "range [101,121) visits 10");
+  ASSERT_EQ(g_out[0], 102, "range first==102");
+  ASSERT_EQ(g_out[9], 120, "range last==120");
+
+  /* open-ended ranges */
+  out_reset();
+  ds_bptree_traverse_range(t, NULL, &lo, visit_collect);
+  ASSERT_EQ(g_out_n, 51u, "range [-inf,101) visits 51");
+  out_reset();
+  ds_bptree_traverse_range(t, NULL, NULL, visit_collect);
+  ASSERT_EQ(g_out_n, (size_t)N, "range [-inf,+inf) visits all");
+
+  ds_bptree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_bptree_remove_errors) {
+  ds_bptree_t *t = ds_bptree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  int k = 1;
+  ASSERT_EQ(ds_bptree_remove(NULL, &k, NULL), DS_ERR_NULL, "remove(NULL tree) => DS_ERR_NULL");
+  ASSERT_EQ(ds_bptree_remove(t, &k, NULL), DS_ERR_NOT_FOUND, "remove(empty) => DS_ERR_NOT_FOUND");
+
+  ASSERT_EQ(ds_bptree_insert(t, mk_int(1)), DS_OK, "insert 1");
+  ASSERT_EQ(ds_bptree_remove(t, NULL, NULL), DS_ERR_ARG, "remove(NULL key) => DS_ERR_ARG when non-empty");
+
+  int k2 = 2;
+  ASSERT_EQ(ds_bptree_remove(t, &k2, NULL), DS_ERR_NOT_FOUND, "remove(nonexistent) => DS_ERR_NOT_FOUND");
+
+  int free_before = g_free_count;
+  ASSERT_EQ(ds_bptree_remove(t, &k, counted_free), DS_OK, "remove last element");
+  ASSERT_EQ(g_free_count, free_before + 1, "remove frees one");
+  ASSERT_EQ(ds_bptree_height(t), 0u, "height==0 after emptying");
+  ASSERT_NULL(ds_bptree_min(t), "min(empty)==NULL after emptying");
+
+  ds_bptree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_bptree_random_insert_delete_inorder_sorted) {
+  ds_bptree_t *t = ds_bptree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  enum { MAXK = 4000 };
+  unsigned char present[MAXK];
+  memset(present, 0, sizeof(present));
+
+  uint32_t seed = 0x12345678u;
+  const int OPS = 40000;
+  int ok = 1;
+
+  for (int step = 0; step < OPS; step++) {
+    seed = seed * 1664525u + 1013904223u;
+    int key = (int)(seed % MAXK);
+
+    /* bias towards inserts in the first half, removes in the second */
+    int op = ((seed >> 16) % 4) < (step < OPS / 2 ? 3u : 1u) ? 0 : 1;
+    if (op == 0) {
+      if (!present[key]) {
+        if (ds_bptree_insert(t, mk_int(key)) != DS_OK) ok = 0;
+        present[key] = 1;
+      } else {
+        int *dup = mk_int(key);
+        if (ds_bptree_insert(t, dup) != DS_ERR_EXIST) ok = 0;
+        free(dup);
+      }
+    } else {
+      if (present[key]) {
+        int free_before = g_free_count;
+        if (ds_bptree_remove(t, &key, counted_free) != DS_OK) ok = 0;
+        if (g_free_count != free_before + 1) ok = 0;
+        present[key] = 0;
+      } else {
+        if (ds_bptree_remove(t, &key, NULL) != DS_ERR_NOT_FOUND) ok = 0;
+      }
+    }
+
+    if (step % 500 == 0) {
+      out_reset();
+      ds_bptree_traverse_inorder(t, visit_collect);
+      assert_sorted_strict_increasing(g_out, g_out_n, "inorder strictly increasing (random)");
+    }
+  }
+  ASSERT(ok, "random ops return expected status codes");
+
+  size_t cnt = 0;
+  for (int i = 0; i < MAXK; i++) if (present[i]) cnt++;
+  ASSERT_EQ(ds_bptree_size(t), cnt, "size matches reference count");
+
+  for (int i = 0; i < MAXK; i++) {
+    if (present[i] != (ds_bptree_search(t, &i) != NULL)) ok = 0;
+  }
+  ASSERT(ok, "search agrees with reference set");
+
+  /* drain everything */
+  for (int i = 0; i < MAXK; i++) {
+    if (present[i] && ds_bptree_remove(t, &i, counted_free) != DS_OK) ok = 0;
+  }
+  ASSERT(ok, "drain removes all");
+  ASSERT_EQ(ds_bptree_size(t), 0u, "size==0 after drain");
+
+  ds_bptree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_bptree_custom_allocator) {
+  counting_ctx_t ctx = {0};
+  ds_allocator_t a = counting_allocator(&ctx);
+
+  ds_bptree_t *t = ds_bptree_create_ex(int_compare, &a);
+  ASSERT_NOT_NULL(t, "create_ex with custom allocator returns non-NULL");
+
+  for (int i = 0; i < 1000; ++ i) ds_bptree_insert(t, mk_int(i));
+  ASSERT(ds_bptree_height(t) > 1, "tree grew internal levels");
+  for (int i = 0; i < 1000; i += 2) {
+    int key = i;
+    ds_bptree_remove(t, &key, free);
+  }
+  ASSERT_EQ(ds_bptree_size(t), 500, "half of the elements removed");
+
+  ds_bptree_destroy(t, free);
+  ASSERT_EQ(ctx.live_bytes, 0, "leaves and internal nodes freed with their own sizes");
+  ASSERT_EQ(ctx.allocs, ctx.frees, "alloc/free calls balanced");
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"bptree_create_basic", test_bptree_create_basic},
+    {"bptree_insert_search_min_max_inorder", test_bptree_insert_search_min_max_inorder},
+    {"bptree_iterators_and_range", test_bptree_iterators_and_range},
+    {"bptree_remove_errors", test_bptree_remove_errors},
+    {"bptree_random_insert_delete_inorder_sorted", test_bptree_random_insert_delete_inorder_sorted},
+    {"bptree_custom_allocator", test_bptree_custom_allocator},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
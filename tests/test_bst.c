@@ -297,6 +297,195 @@ TEST_FUNC(test_bst_random_insert_delete_inorder_sorted) {
   ds_bst_destroy(b, counted_free);
 }
 
+TEST_FUNC(test_bst_pooled_behaves_like_bst) {
+  ds_bst_t *b = ds_bst_create_pooled(NULL, 0);
+  ASSERT_NULL(b, "create_pooled(NULL compare) returns NULL");
+
+  b = ds_bst_create_pooled(int_compare, 8);
+  ASSERT_NOT_NULL(b, "create_pooled non-NULL");
+
+  int vals[] = {50, 30, 70, 20, 40, 60, 80, 35, 45};
+  for (size_t i = 0; i < sizeof(vals)/sizeof(vals[0]); i++) {
+    ASSERT_EQ(ds_bst_insert(b, mk_int(vals[i])), DS_OK, "pooled insert");
+  }
+  int k30 = 30, k50 = 50;
+  ASSERT_EQ(ds_bst_remove(b, &k30, counted_free), DS_OK, "pooled remove two-children node");
+  ASSERT_EQ(ds_bst_remove(b, &k50, counted_free), DS_OK, "pooled remove root");
+  ASSERT_EQ(ds_bst_insert(b, mk_int(30)), DS_OK, "pooled insert reuses freed node");
+  ASSERT_EQ(ds_bst_size(b), 8u, "pooled size==8");
+
+  out_reset();
+  ds_bst_traverse_inorder(b, visit_collect);
+  ASSERT_EQ(g_out_n, 8u, "pooled inorder visits 8");
+  assert_sorted_strict_increasing(g_out, g_out_n, "pooled inorder sorted");
+
+  int free_before = g_free_count;
+  ds_bst_destroy(b, counted_free);
+  ASSERT_EQ(g_free_count, free_before + 8, "pooled destroy frees all data");
+
+  /* destroy without free_func: no walk needed */
+  static int stack_vals[100];
+  b = ds_bst_create_pooled(int_compare, 0);
+  for (int i = 0; i < 100; i++) {
+    stack_vals[i] = i;
+    ds_bst_insert(b, &stack_vals[i]);
+  }
+  ds_bst_destroy(b, NULL);
+  ASSERT(1, "pooled destroy(NULL) does not crash");
+}
+
+TEST_FUNC(test_bst_iterator_bounds_range) {
+  ds_bst_t *b = ds_bst_create(int_compare);
+  ASSERT_NULL(ds_bst_iter_begin(b), "begin on empty is End");
+  int k0 = 0;
+  ASSERT_NULL(ds_bst_lower_bound(b, &k0), "lower_bound on empty is End");
+
+  /* Even keys 0..398, then remove every 6th so removals rewire parents */
+  enum { MAXK = 400 };
+  unsigned char present[MAXK];
+  memset(present, 0, sizeof(present));
+  uint32_t seed = 0xC0FFEEu;
+  for (int i = 0; i < 200; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    int key = (int)(seed % (MAXK / 2)) * 2;
+    if (!present[key] && ds_bst_insert(b, mk_int(key)) == DS_OK) present[key] = 1;
+  }
+  for (int key = 0; key < MAXK; key += 6) {
+    if (present[key]) {
+      ds_bst_remove(b, &key, free);
+      present[key] = 0;
+    }
+  }
+
+  /* Forward walk matches the reference, backward walk mirrors it */
+  int ok = 1;
+  size_t n = 0;
+  int expect = -1;
+  for (ds_bst_iter_t it = ds_bst_iter_begin(b); it; it = ds_bst_iter_next(it)) {
+    do expect++; while (expect < MAXK && !present[expect]);
+    if (int_val(ds_bst_iter_get(it)) != expect) ok = 0;
+    n++;
+  }
+  ASSERT(ok && n == ds_bst_size(b), "forward iteration is sorted and complete");
+
+  ok = 1;
+  n = 0;
+  expect = MAXK;
+  for (ds_bst_iter_t it = ds_bst_iter_last(b); it; it = ds_bst_iter_prev(it)) {
+    do expect--; while (expect >= 0 && !present[expect]);
+    if (int_val(ds_bst_iter_get(it)) != expect) ok = 0;
+    n++;
+  }
+  ASSERT(ok && n == ds_bst_size(b), "backward iteration is reverse sorted and complete");
+
+  /* lower_bound / upper_bound against a linear scan */
+  ok = 1;
+  for (int key = -1; key <= MAXK; key++) {
+    int lb = -1, ub = -1;
+    for (int j = key < 0 ? 0 : key; j < MAXK; j++) if (present[j]) { lb = j; break; }
+    for (int j = key + 1 < 0 ? 0 : key + 1; j < MAXK; j++) if (present[j]) { ub = j; break; }
+    ds_bst_iter_t l = ds_bst_lower_bound(b, &key);
+    ds_bst_iter_t u = ds_bst_upper_bound(b, &key);
+    if ((lb < 0 ? l != NULL : int_val(ds_bst_iter_get(l)) != lb)) ok = 0;
+    if ((ub < 0 ? u != NULL : int_val(ds_bst_iter_get(u)) != ub)) ok = 0;
+  }
+  ASSERT(ok, "lower_bound/upper_bound match a linear scan");
+
+  /* range [lo, hi) */
+  int lo = 101, hi = 251;
+  size_t want = 0;
+  for (int j = lo; j < hi; j++) want += present[j];
+  out_reset();
+  size_t got = ds_bst_range(b, &lo, &hi, visit_collect);
+  ASSERT_EQ(got, want, "range visits exactly the keys in [lo, hi)");
+  ASSERT_EQ(g_out_n, want, "range callback count");
+  assert_sorted_strict_increasing(g_out, g_out_n, "range visits in order");
+  ASSERT(g_out_n == 0 || (g_out[0] >= lo && g_out[g_out_n - 1] < hi), "range stays within bounds");
+  ASSERT_EQ(ds_bst_range(b, &hi, &lo, visit_collect), 0u, "empty range visits nothing");
+
+  ds_bst_destroy(b, free);
+}
+
+TEST_FUNC(test_bst_rank_select) {
+  ds_bst_t *t = ds_bst_create(int_compare);
+  ASSERT_NULL(ds_bst_select(t, 0), "select on empty is NULL");
+  int k0 = 5;
+  ASSERT_EQ(ds_bst_rank(t, &k0), 0u, "rank on empty is 0");
+
+  enum { MAXK = 500 };
+  unsigned char present[MAXK];
+  memset(present, 0, sizeof(present));
+
+  /* Mixed inserts/removes so subtree sizes go through every removal case */
+  uint32_t seed = 0xBADC0DEu;
+  int ok = 1;
+  for (int step = 0; step < 4000; step++) {
+    seed = seed * 1664525u + 1013904223u;
+    int key = (int)(seed % MAXK);
+    if ((seed >> 16) % 3 != 0) {
+      if (!present[key] && ds_bst_insert(t, mk_int(key)) == DS_OK) present[key] = 1;
+    } else if (present[key]) {
+      ds_bst_remove(t, &key, free);
+      present[key] = 0;
+    }
+
+    if (step % 50 == 0) {
+      size_t below = 0, k = 0;
+      for (int i = 0; i < MAXK; i++) {
+        if (ds_bst_rank(t, &i) != below) ok = 0;
+        if (present[i]) {
+          if (int_val(ds_bst_select(t, k)) != i) ok = 0;
+          k++;
+          below++;
+        }
+      }
+      if (ds_bst_select(t, k) != NULL) ok = 0;
+    }
+  }
+  ASSERT(ok, "rank/select agree with the reference set throughout");
+
+  size_t n = ds_bst_size(t);
+  if (n > 0) {
+    void *median = ds_bst_select(t, n / 2);
+    ASSERT_EQ(ds_bst_rank(t, median), n / 2, "rank(select(k)) == k");
+  }
+
+  ds_bst_destroy(t, free);
+}
+
+TEST_FUNC(test_bst_create_from_sorted) {
+  int keys[100];
+  void *items[100];
+  for (int i = 0; i < 100; ++ i) {
+    keys[i] = i;
+    items[i] = &keys[i];
+  }
+
+  ds_bst_t *t = ds_bst_create_from_sorted(int_compare, items, 100);
+  ASSERT_NOT_NULL(t, "build from sorted");
+  ASSERT_EQ(ds_bst_size(t), 100, "size");
+  int ok = 1;
+  for (int i = 0; i < 100; ++ i) {
+    if (ds_bst_search(t, &keys[i]) != &keys[i]) ok = 0;
+    if (ds_bst_select(t, (size_t)i) != &keys[i]) ok = 0;
+  }
+  ASSERT(ok, "every key found at its rank");
+  ASSERT_EQ(ds_bst_remove(t, &keys[50], NULL), DS_OK, "remove from built tree");
+  ASSERT_EQ(ds_bst_size(t), 99, "size after remove");
+  ds_bst_destroy(t, NULL);
+
+  ds_bst_t *e = ds_bst_create_from_sorted(int_compare, NULL, 0);
+  ASSERT_NOT_NULL(e, "build empty");
+  ASSERT_EQ(ds_bst_size(e), 0, "empty size");
+  ds_bst_destroy(e, NULL);
+
+  items[3] = &keys[2];
+  ASSERT_NULL(ds_bst_create_from_sorted(int_compare, items, 100), "duplicates rejected");
+  items[3] = &keys[4];
+  ASSERT_NULL(ds_bst_create_from_sorted(int_compare, items, 100), "unsorted rejected");
+  ASSERT_NULL(ds_bst_create_from_sorted(NULL, items, 1), "NULL compare rejected");
+}
+
 /* ===================== main ===================== */
 
 int main() {
@@ -307,6 +496,10 @@ int main() {
     {"bst_remove_leaf_one_child_two_children", test_bst_remove_leaf_one_child_two_children},
     {"bst_remove_errors", test_bst_remove_errors},
     {"bst_random_insert_delete_inorder_sorted", test_bst_random_insert_delete_inorder_sorted},
+    {"bst_pooled_behaves_like_bst", test_bst_pooled_behaves_like_bst},
+    {"bst_iterator_bounds_range", test_bst_iterator_bounds_range},
+    {"bst_rank_select", test_bst_rank_select},
+    {"bst_create_from_sorted", test_bst_create_from_sorted},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
@@ -1,3 +1,6 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -84,6 +87,12 @@ static void visit_collect(void *data) {
   }
 }
 
+static size_t g_count_visits = 0;
+static void visit_count(void *data) {
+  (void)data;
+  g_count_visits++;
+}
+
 static void assert_out_equals(const int *exp, size_t n, const char *msg) {
   ASSERT_EQ(g_out_n, n, msg);
   for (size_t i = 0; i < n && i < g_out_n; i++) {
@@ -232,6 +241,19 @@ TEST_FUNC(test_btree_traversals_match_expected) {
   ds_btree_traverse_levelorder(bt.tree, visit_collect);
   assert_out_equals(exp_level, 6, "levelorder");
 
+  out_reset();
+  ds_btree_traverse_preorder_morris(bt.tree, visit_collect);
+  assert_out_equals(exp_pre, 6, "preorder morris");
+
+  out_reset();
+  ds_btree_traverse_inorder_morris(bt.tree, visit_collect);
+  assert_out_equals(exp_in, 6, "inorder morris");
+
+  /* Morris threads must be gone again */
+  out_reset();
+  ds_btree_traverse_postorder(bt.tree, visit_collect);
+  assert_out_equals(exp_post, 6, "tree restored after morris");
+
   ds_btree_destroy(bt.tree, counted_free);
 }
 
@@ -282,6 +304,34 @@ TEST_FUNC(test_btree_attach_tree_left_right_transfer_ownership) {
   /* destroy empty subtree object */
   ds_btree_destroy(sub.tree, counted_free);
 
+  /* pooled or compacted subtrees keep their nodes in their own storage */
+  ds_btree_t *pooled = ds_btree_create_pooled(4);
+  ds_btree_set_root(pooled, ds_btree_node_alloc(pooled, mk_int(7)));
+  ds_btree_node_t *leaf = ds_btree_node_create(mk_int(8));
+  ASSERT_EQ(ds_btree_attach_tree_left(t, leaf, pooled), DS_ERR_ARG, "attach pooled subtree rejected");
+  ASSERT_EQ(ds_btree_attach_tree_right(t, leaf, pooled), DS_ERR_ARG, "attach pooled subtree right rejected");
+  ASSERT_EQ(ds_btree_size(pooled), 1u, "rejected pooled subtree keeps its nodes");
+  ds_btree_destroy(pooled, counted_free);
+
+  built_tree_t cmp = build_sample_tree();
+  ASSERT_EQ(ds_btree_compact(cmp.tree, DS_BTREE_LAYOUT_BFS), DS_OK, "compact subtree");
+  ASSERT_EQ(ds_btree_attach_tree_left(t, leaf, cmp.tree), DS_ERR_ARG, "attach compacted subtree rejected");
+  ASSERT_EQ(ds_btree_attach_tree_right(t, leaf, cmp.tree), DS_ERR_ARG, "attach compacted subtree right rejected");
+  ASSERT_EQ(ds_btree_size(cmp.tree), 6u, "rejected compacted subtree keeps its nodes");
+  ds_btree_destroy(cmp.tree, counted_free);
+
+  /* nor can a pooled tree take heap nodes */
+  ds_btree_t *pdst = ds_btree_create_pooled(4);
+  ds_btree_node_t *proot = ds_btree_node_alloc(pdst, mk_int(9));
+  ds_btree_set_root(pdst, proot);
+  built_tree_t heap = build_sample_tree();
+  ASSERT_EQ(ds_btree_attach_tree_left(pdst, proot, heap.tree), DS_ERR_ARG, "pooled destination rejected");
+  ds_btree_destroy(heap.tree, counted_free);
+  ds_btree_destroy(pdst, counted_free);
+
+  free(ds_btree_node_get(leaf));
+  free(leaf);
+
   /* destroy main tree should free everything */
   ds_btree_destroy(t, counted_free);
 }
@@ -308,6 +358,274 @@ TEST_FUNC(test_btree_detach_left_right_current_behavior) {
   ds_btree_destroy(bt.tree, counted_free);
 }
 
+TEST_FUNC(test_btree_pooled_node_alloc_clear_destroy) {
+  ds_btree_t *t = ds_btree_create_pooled(2);
+  ASSERT_NOT_NULL(t, "create_pooled non-NULL");
+  ASSERT_NULL(ds_btree_node_alloc(t, NULL), "node_alloc(NULL data) == NULL");
+  int dummy = 0;
+  ASSERT_NULL(ds_btree_node_alloc(NULL, &dummy), "node_alloc(NULL tree) == NULL");
+
+  /* same shape as build_sample_tree */
+  ds_btree_node_t *n[7];
+  for (int i = 1; i <= 6; i++) n[i] = ds_btree_node_alloc(t, mk_int(i));
+  ASSERT_EQ(ds_btree_set_root(t, n[1]), DS_OK, "set_root");
+  ds_btree_attach_node_left(t, n[1], n[2]);
+  ds_btree_attach_node_right(t, n[1], n[3]);
+  ds_btree_attach_node_left(t, n[2], n[4]);
+  ds_btree_attach_node_right(t, n[2], n[5]);
+  ds_btree_attach_node_right(t, n[3], n[6]);
+  ASSERT_EQ(ds_btree_size(t), 6u, "pooled size==6");
+  ASSERT_EQ(ds_btree_height(t), 3u, "pooled height==3");
+
+  out_reset();
+  ds_btree_traverse_preorder(t, visit_collect);
+  int exp_pre[] = {1,2,4,5,3,6};
+  assert_out_equals(exp_pre, 6, "pooled preorder");
+
+  int free_before = g_free_count;
+  ds_btree_clear(t, counted_free);
+  ASSERT_EQ(g_free_count, free_before + 6, "pooled clear frees all data");
+  ASSERT_EQ(ds_btree_size(t), 0u, "pooled size==0 after clear");
+  ASSERT_NULL(ds_btree_root(t), "pooled root NULL after clear");
+
+  /* reuse after clear, then destroy */
+  ds_btree_node_t *r = ds_btree_node_alloc(t, mk_int(9));
+  ASSERT_NOT_NULL(r, "node_alloc after clear");
+  ASSERT_EQ(ds_btree_set_root(t, r), DS_OK, "set_root after clear");
+  ASSERT_EQ(int_val(ds_btree_node_get(ds_btree_root(t))), 9, "root data==9");
+
+  free_before = g_free_count;
+  ds_btree_destroy(t, counted_free);
+  ASSERT_EQ(g_free_count, free_before + 1, "pooled destroy frees data");
+
+  /* unpooled tree: node_alloc falls back to node_create */
+  ds_btree_t *u = ds_btree_create();
+  ds_btree_node_t *un = ds_btree_node_alloc(u, mk_int(1));
+  ASSERT_NOT_NULL(un, "node_alloc on unpooled tree");
+  ds_btree_set_root(u, un);
+  ds_btree_destroy(u, counted_free);
+}
+
+/* Allocator that counts calls, to prove traversal/teardown allocate nothing */
+static size_t g_alloc_calls = 0;
+static void *tracking_alloc(void *ctx, size_t size) { (void)ctx; g_alloc_calls++; return malloc(size); }
+static void *tracking_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  (void)ctx; (void)old_size; g_alloc_calls++; return realloc(ptr, new_size);
+}
+static void tracking_free(void *ctx, void *ptr, size_t size) { (void)ctx; (void)size; free(ptr); }
+
+TEST_FUNC(test_btree_morris_and_teardown_constant_space) {
+  ds_allocator_t a = { tracking_alloc, tracking_realloc, tracking_free, NULL };
+  ds_btree_t *t = ds_btree_create_ex(&a);
+  ASSERT_NOT_NULL(t, "create_ex");
+
+  /* A zig-zag chain deep enough to overflow a recursive walk */
+  enum { DEPTH = 200000 };
+  static int vals[DEPTH];
+  ds_btree_node_t *prev = NULL;
+  for (int i = 0; i < DEPTH; i++) {
+    vals[i] = i;
+    ds_btree_node_t *n = ds_btree_node_alloc(t, &vals[i]);
+    if (!prev) ds_btree_set_root(t, n);
+    else if (i % 2) ds_btree_attach_node_left(t, prev, n);
+    else ds_btree_attach_node_right(t, prev, n);
+    prev = n;
+  }
+  ASSERT_EQ(ds_btree_size(t), (size_t)DEPTH, "deep chain built");
+
+  g_count_visits = 0;
+  size_t allocs_before = g_alloc_calls;
+  ds_btree_traverse_inorder_morris(t, visit_count);
+  ASSERT_EQ(g_count_visits, (size_t)DEPTH, "morris inorder visits every node");
+  ds_btree_traverse_preorder_morris(t, visit_count);
+  ASSERT_EQ(g_count_visits, (size_t)(2 * DEPTH), "morris preorder visits every node");
+
+  ds_btree_clear(t, NULL);
+  ASSERT_EQ(g_alloc_calls, allocs_before, "morris and clear allocate nothing");
+  ASSERT_EQ(ds_btree_size(t), 0u, "clear of deep chain");
+
+  ds_btree_destroy(t, NULL);
+}
+
+/* Parallel traversal: a perfect tree whose in-order sequence is 0..N-1 */
+enum { PAR_DEPTH = 13, PAR_N = (1 << PAR_DEPTH) - 1 };
+static int g_par_vals[PAR_N];
+static atomic_size_t g_par_visits;
+static atomic_llong g_par_sum;
+
+static ds_btree_node_t *build_perfect(ds_btree_t *t, int lo, int hi) {
+  if (lo > hi) return NULL;
+  int mid = lo + (hi - lo) / 2;
+  g_par_vals[mid] = mid;
+  ds_btree_node_t *n = ds_btree_node_alloc(t, &g_par_vals[mid]);
+  ds_btree_node_t *l = build_perfect(t, lo, mid - 1);
+  ds_btree_node_t *r = build_perfect(t, mid + 1, hi);
+  if (l) ds_btree_attach_node_left(t, n, l);
+  if (r) ds_btree_attach_node_right(t, n, r);
+  return n;
+}
+
+/* Allocator that flags calls from any thread but its creator */
+static pthread_t g_alloc_owner;
+static int g_alloc_foreign = 0;
+
+static void *owner_alloc(void *ctx, size_t size) {
+  (void)ctx;
+  if (!pthread_equal(pthread_self(), g_alloc_owner)) g_alloc_foreign = 1;
+  return malloc(size);
+}
+
+static void *owner_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  (void)ctx; (void)old_size;
+  if (!pthread_equal(pthread_self(), g_alloc_owner)) g_alloc_foreign = 1;
+  return realloc(ptr, new_size);
+}
+
+static void owner_free(void *ctx, void *ptr, size_t size) {
+  (void)ctx; (void)size;
+  if (!pthread_equal(pthread_self(), g_alloc_owner)) g_alloc_foreign = 1;
+  free(ptr);
+}
+
+static void visit_par(void *data) {
+  atomic_fetch_add(&g_par_visits, 1);
+  atomic_fetch_add(&g_par_sum, *(int *)data);
+}
+
+/* Affine maps x -> a*x + b (mod 251), packed as (a << 16) | b.
+ * Composition is associative but not commutative, so the result checks
+ * that partial results are combined in in-order sequence. */
+static intptr_t affine_of(int v) { return ((intptr_t)(v % 250 + 1) << 16) | (v * 7 % 251); }
+static intptr_t affine_then(intptr_t f, intptr_t g) {
+  intptr_t fa = f >> 16, fb = f & 0xFFFF, ga = g >> 16, gb = g & 0xFFFF;
+  return ((ga * fa % 251) << 16) | ((ga * fb + gb) % 251);
+}
+static void *map_affine(void *data, void *ctx) { (void)ctx; return (void *)affine_of(*(int *)data); }
+static void *combine_affine(void *l, void *r, void *ctx) {
+  (void)ctx;
+  return (void *)affine_then((intptr_t)l, (intptr_t)r);
+}
+
+TEST_FUNC(test_btree_parallel_for_each_map_reduce) {
+  ds_btree_t *t = ds_btree_create();
+  void *out = NULL;
+  ASSERT_EQ(ds_btree_parallel_map_reduce(t, map_affine, combine_affine, NULL, 2, &out), DS_ERR_EMPTY,
+            "map_reduce on empty tree");
+  ASSERT_EQ(ds_btree_parallel_for_each(t, NULL, 2), DS_ERR_ARG, "for_each NULL visit");
+
+  ds_btree_set_root(t, build_perfect(t, 0, PAR_N - 1));
+  ASSERT_EQ(ds_btree_size(t), (size_t)PAR_N, "perfect tree built");
+
+  intptr_t expect = affine_of(0);
+  for (int i = 1; i < PAR_N; i++) expect = affine_then(expect, affine_of(i));
+  long long expect_sum = (long long)PAR_N * (PAR_N - 1) / 2;
+
+  size_t threads[] = { 0, 1, 3, 8 };
+  int ok_visit = 1, ok_reduce = 1;
+  for (size_t k = 0; k < sizeof(threads) / sizeof(threads[0]); k++) {
+    atomic_store(&g_par_visits, 0);
+    atomic_store(&g_par_sum, 0);
+    if (ds_btree_parallel_for_each(t, visit_par, threads[k]) != DS_OK) ok_visit = 0;
+    if (atomic_load(&g_par_visits) != (size_t)PAR_N || atomic_load(&g_par_sum) != expect_sum) ok_visit = 0;
+
+    out = NULL;
+    if (ds_btree_parallel_map_reduce(t, map_affine, combine_affine, NULL, threads[k], &out) != DS_OK) ok_reduce = 0;
+    if ((intptr_t)out != expect) ok_reduce = 0;
+  }
+  ASSERT(ok_visit, "parallel_for_each visits every element once");
+  ASSERT(ok_reduce, "parallel_map_reduce equals the sequential in-order fold");
+
+  /* Tree must be intact afterwards */
+  g_count_visits = 0;
+  ds_btree_traverse_inorder(t, visit_count);
+  ASSERT_EQ(g_count_visits, (size_t)PAR_N, "tree restored after parallel walks");
+  ASSERT_EQ(ds_btree_height(t), (size_t)PAR_DEPTH, "shape unchanged");
+
+  ds_btree_destroy(t, NULL);
+
+  /* The tree's allocator is never called from a worker */
+  ds_allocator_t oa = { owner_alloc, owner_realloc, owner_free, NULL };
+  g_alloc_owner = pthread_self();
+  g_alloc_foreign = 0;
+  ds_btree_t *ot = ds_btree_create_ex(&oa);
+  ds_btree_set_root(ot, build_perfect(ot, 0, PAR_N - 1));
+  ASSERT_EQ(ds_btree_parallel_for_each(ot, visit_par, 4), DS_OK, "parallel_for_each with custom allocator");
+  ASSERT_EQ(ds_btree_parallel_map_reduce(ot, map_affine, combine_affine, NULL, 4, &out), DS_OK,
+            "parallel_map_reduce with custom allocator");
+  ds_btree_destroy(ot, NULL);
+  ASSERT(!g_alloc_foreign, "tree allocator only used on the calling thread");
+}
+
+/* Record pre/in/level order of a tree into one buffer, for shape checks */
+static size_t snapshot(ds_btree_t *t, int *buf, size_t cap) {
+  out_reset();
+  ds_btree_traverse_preorder(t, visit_collect);
+  ds_btree_traverse_inorder(t, visit_collect);
+  ds_btree_traverse_levelorder(t, visit_collect);
+  size_t n = g_out_n < cap ? g_out_n : cap;
+  memcpy(buf, g_out, n * sizeof(int));
+  return n;
+}
+
+TEST_FUNC(test_btree_compact_bfs_veb) {
+  ASSERT_EQ(ds_btree_compact(NULL, DS_BTREE_LAYOUT_BFS), DS_ERR_NULL, "compact(NULL)");
+
+  ds_btree_layout_t layouts[] = { DS_BTREE_LAYOUT_BFS, DS_BTREE_LAYOUT_VEB };
+  for (size_t k = 0; k < 2; k++) {
+    /* Irregular shape: root 0 whose left subtree is the sample tree with
+     * a left spine hanging under n6; the root's right slot stays free */
+    built_tree_t bt = build_sample_tree();
+    ds_btree_node_t *p = bt.n6;
+    for (int v = 7; v < 20; v++) {
+      ds_btree_node_t *n = ds_btree_node_create(mk_int(v));
+      ds_btree_attach_node_left(bt.tree, p, n);
+      p = n;
+    }
+    ds_btree_t *t = ds_btree_create();
+    ds_btree_set_root(t, ds_btree_node_create(mk_int(0)));
+    ds_btree_attach_tree_left(t, ds_btree_root(t), bt.tree);
+    ds_btree_destroy(bt.tree, NULL);
+    ASSERT_EQ(ds_btree_compact(t, (ds_btree_layout_t)7), DS_ERR_ARG, "bad layout rejected");
+
+    static int before[256], after[256];
+    size_t nb = snapshot(t, before, 256);
+    size_t height = ds_btree_height(t);
+
+    ASSERT_EQ(ds_btree_compact(t, layouts[k]), DS_OK, "compact");
+    size_t na = snapshot(t, after, 256);
+    ASSERT(na == nb && memcmp(before, after, nb * sizeof(int)) == 0, "compact keeps shape and order");
+    ASSERT_EQ(ds_btree_height(t), height, "height unchanged");
+    ASSERT_EQ(ds_btree_size(t), 20u, "size unchanged");
+
+    /* Node API keeps working: attach a fresh node, then compact again */
+    ds_btree_node_t *root = ds_btree_root(t);
+    ASSERT_EQ(int_val(ds_btree_node_get(root)), 0, "root data after compact");
+    ASSERT_EQ(ds_btree_attach_node_right(t, root, ds_btree_node_create(mk_int(99))), DS_OK,
+              "attach after compact");
+    ASSERT_EQ(ds_btree_compact(t, layouts[k]), DS_OK, "re-compact");
+    out_reset();
+    ds_btree_traverse_inorder(t, visit_collect);
+    ASSERT(g_out_n == 21 && g_out[19] == 0 && g_out[20] == 99, "re-compact folds the new node in");
+
+    int free_before = g_free_count;
+    ds_btree_destroy(t, counted_free);
+    ASSERT_EQ(g_free_count, free_before + 21, "destroy frees every element of a compacted tree");
+  }
+
+  /* Pooled tree: compacts away from the pool, clear releases the array */
+  ds_btree_t *pt = ds_btree_create_pooled(4);
+  ds_btree_node_t *r = ds_btree_node_alloc(pt, mk_int(1));
+  ds_btree_set_root(pt, r);
+  ds_btree_attach_node_left(pt, r, ds_btree_node_alloc(pt, mk_int(2)));
+  ds_btree_attach_node_right(pt, r, ds_btree_node_alloc(pt, mk_int(3)));
+  ASSERT_EQ(ds_btree_compact(pt, DS_BTREE_LAYOUT_VEB), DS_OK, "compact pooled tree");
+  int free_before = g_free_count;
+  ds_btree_clear(pt, counted_free);
+  ASSERT_EQ(g_free_count, free_before + 3, "clear frees compacted elements");
+  ds_btree_set_root(pt, ds_btree_node_alloc(pt, mk_int(4)));
+  ds_btree_destroy(pt, counted_free);
+}
+
 /* ===================== main ===================== */
 
 int main() {
@@ -319,6 +637,10 @@ int main() {
     {"btree_clear_resets_tree_and_frees_data", test_btree_clear_resets_tree_and_frees_data},
     {"btree_attach_tree_left_right_transfer_ownership", test_btree_attach_tree_left_right_transfer_ownership},
     {"btree_detach_left_right_current_behavior", test_btree_detach_left_right_current_behavior},
+    {"btree_pooled_node_alloc_clear_destroy", test_btree_pooled_node_alloc_clear_destroy},
+    {"btree_morris_and_teardown_constant_space", test_btree_morris_and_teardown_constant_space},
+    {"btree_parallel_for_each_map_reduce", test_btree_parallel_for_each_map_reduce},
+    {"btree_compact_bfs_veb", test_btree_compact_bfs_veb},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
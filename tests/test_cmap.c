@@ -0,0 +1,287 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sched.h>
+
+#include "ds_common.h"
+#include "ds_cmap.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+static int int_compare(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static int *mk_int(int v) {
+  int *p = (int *)malloc(sizeof(int));
+  if (p) *p = v;
+  return p;
+}
+
+static atomic_int freed_count;
+
+static void counting_free(void *p) {
+  atomic_fetch_add(&freed_count, 1);
+  free(p);
+}
+
+static int visited[64];
+static int visited_n;
+
+static void collect_visit(void *p) {
+  if (visited_n < 64) visited[visited_n ++] = *(int *)p;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_cmap_basic) {
+  atomic_store(&freed_count, 0);
+  ds_cmap_t *map = ds_cmap_create(int_compare, counting_free);
+  ASSERT_NOT_NULL(map, "cmap_create");
+  ASSERT_EQ(ds_cmap_size(map), 0, "empty size");
+
+  // Insert 0, 3, ..., 57 in a scrambled order
+  for (int i = 0; i < 20; ++ i) {
+    int v = ((i * 7) % 20) * 3;
+    ASSERT_EQ(ds_cmap_insert(map, mk_int(v)), DS_OK, "insert");
+  }
+  ASSERT_EQ(ds_cmap_size(map), 20, "size after inserts");
+
+  int *dup = mk_int(9);
+  ASSERT_EQ(ds_cmap_insert(map, dup), DS_ERR_EXIST, "duplicate rejected");
+  free(dup);
+
+  int k = 12;
+  int *got = ds_cmap_get(map, &k);
+  ASSERT(got && *got == 12, "get existing");
+  k = 13;
+  ASSERT_NULL(ds_cmap_get(map, &k), "get missing");
+  ASSERT(!ds_cmap_contains(map, &k), "contains missing");
+  int *lb = ds_cmap_lower_bound(map, &k);
+  ASSERT(lb && *lb == 15, "lower_bound rounds up");
+  k = 58;
+  ASSERT_NULL(ds_cmap_lower_bound(map, &k), "lower_bound past the end");
+
+  // Range [10, 22)
+  int lo = 10, hi = 22;
+  visited_n = 0;
+  ASSERT_EQ(ds_cmap_range(map, &lo, &hi, collect_visit), 4, "range count");
+  ASSERT(visited[0] == 12 && visited[1] == 15 && visited[2] == 18 && visited[3] == 21, "range order");
+
+  visited_n = 0;
+  ASSERT_EQ(ds_cmap_range(map, NULL, NULL, collect_visit), 20, "full range");
+  int sorted = 1;
+  for (int i = 1; i < visited_n; ++ i) if (visited[i - 1] >= visited[i]) sorted = 0;
+  ASSERT(sorted, "full range is ascending");
+
+  // Removal defers the free until reclamation
+  k = 12;
+  ASSERT_EQ(ds_cmap_remove(map, &k), DS_OK, "remove");
+  ASSERT_EQ(ds_cmap_remove(map, &k), DS_ERR_NOT_FOUND, "remove twice");
+  ASSERT_NULL(ds_cmap_get(map, &k), "removed is gone");
+  ASSERT_EQ(ds_cmap_size(map), 19, "size after remove");
+  ASSERT_EQ(ds_cmap_pending(map), 1, "removed element pending");
+  ASSERT_EQ(atomic_load(&freed_count), 0, "not freed yet");
+  ASSERT_EQ(ds_cmap_synchronize(map), 1, "synchronize reclaims");
+  ASSERT_EQ(atomic_load(&freed_count), 1, "freed after synchronize");
+
+  // Clear retires everything; destroy frees what is still pending
+  ds_cmap_clear(map);
+  ASSERT_EQ(ds_cmap_size(map), 0, "size after clear");
+  visited_n = 0;
+  ASSERT_EQ(ds_cmap_range(map, NULL, NULL, collect_visit), 0, "empty after clear");
+  ASSERT_EQ(ds_cmap_insert(map, mk_int(5)), DS_OK, "insert after clear");
+  ds_cmap_destroy(map);
+  ASSERT_EQ(atomic_load(&freed_count), 21, "every element freed once");
+
+  // Invalid arguments
+  ASSERT_NULL(ds_cmap_create(NULL, NULL), "create without compare");
+  ASSERT_EQ(ds_cmap_insert(NULL, &k), DS_ERR_NULL, "insert NULL map");
+  ASSERT_EQ(ds_cmap_remove(NULL, &k), DS_ERR_NULL, "remove NULL map");
+  ASSERT_EQ(ds_cmap_size(NULL), 0, "size NULL map");
+}
+
+TEST_FUNC(test_cmap_many) {
+  atomic_store(&freed_count, 0);
+  ds_cmap_t *map = ds_cmap_create(int_compare, counting_free);
+  const int n = 5000;
+
+  for (int i = 0; i < n; ++ i) ds_cmap_insert(map, mk_int((int)(((unsigned)i * 2654435761u) % 100000u)));
+  size_t size = ds_cmap_size(map);
+  ASSERT(size > 0 && size <= (size_t)n, "many inserts");
+
+  // Remove the even keys; collection runs along the way
+  int removed = 0;
+  for (int v = 0; v < 100000; v += 2) if (ds_cmap_remove(map, &v) == DS_OK) removed ++;
+  ASSERT_EQ(ds_cmap_size(map), size - (size_t)removed, "size after removals");
+  ASSERT(ds_cmap_pending(map) < (size_t)removed || removed == 0, "writers collect as they go");
+
+  int odd = 1;
+  for (int v = 0; v < 100000; v += 2) if (ds_cmap_contains(map, &v)) odd = 0;
+  ASSERT(odd, "only odd keys remain");
+
+  ds_cmap_destroy(map);
+  ASSERT_EQ((size_t)atomic_load(&freed_count), size, "destroy frees everything");
+}
+
+/* --------- Concurrent readers and a writer --------- */
+
+#define CMAP_READERS 3
+#define CMAP_KEYS    256
+#define CMAP_ROUNDS  20000
+
+typedef struct {
+  ds_cmap_t *map;
+  atomic_int stop;
+  atomic_int bad;
+  atomic_long lookups;
+} cmap_shared_t;
+
+static _Thread_local int range_prev;
+static _Thread_local int range_bad;
+
+static void range_check(void *p) {
+  int v = *(int *)p;
+  if (v <= range_prev || v >= CMAP_KEYS) range_bad = 1;
+  range_prev = v;
+}
+
+static void *cmap_reader_main(void *arg) {
+  cmap_shared_t *s = arg;
+  ds_ebr_thread_t *th = ds_cmap_register(s->map);
+  unsigned seed = (unsigned)(uintptr_t)th;
+  long n = 0;
+
+  while (!atomic_load(&s->stop)) {
+    ds_ebr_enter(th);
+    seed = seed * 1103515245u + 12345u;
+    int k = (int)((seed >> 8) % CMAP_KEYS);
+    int *got = ds_cmap_get(s->map, &k);
+    if (got && *got != k) atomic_fetch_add(&s->bad, 1);
+
+    // Odd keys are never removed: a full walk must see all of them
+    if ((n & 63) == 0) {
+      range_prev = -1;
+      range_bad = 0;
+      ds_cmap_range(s->map, NULL, NULL, range_check);
+      if (range_bad) atomic_fetch_add(&s->bad, 1);
+      for (int v = 1; v < CMAP_KEYS; v += 2) {
+        if (!ds_cmap_contains(s->map, &v)) {
+          atomic_fetch_add(&s->bad, 1);
+          break;
+        }
+      }
+    }
+    ds_ebr_leave(th);
+    n ++;
+  }
+
+  atomic_fetch_add(&s->lookups, n);
+  ds_cmap_unregister(s->map, th);
+  return NULL;
+}
+
+TEST_FUNC(test_cmap_concurrent) {
+  atomic_store(&freed_count, 0);
+  cmap_shared_t s;
+  s.map = ds_cmap_create(int_compare, counting_free);
+  atomic_init(&s.stop, 0);
+  atomic_init(&s.bad, 0);
+  atomic_init(&s.lookups, 0);
+
+  for (int v = 1; v < CMAP_KEYS; v += 2) ds_cmap_insert(s.map, mk_int(v));
+
+  pthread_t readers[CMAP_READERS];
+  for (int i = 0; i < CMAP_READERS; ++ i) pthread_create(&readers[i], NULL, cmap_reader_main, &s);
+
+  // The writer churns the even keys
+  int inserted = 0;
+  for (int r = 0; r < CMAP_ROUNDS; ++ r) {
+    int k = (r * 37 % (CMAP_KEYS / 2)) * 2;
+    if (ds_cmap_contains(s.map, &k)) {
+      ds_cmap_remove(s.map, &k);
+    } else {
+      int *p = mk_int(k);
+      if (ds_cmap_insert(s.map, p) == DS_OK) inserted ++;
+      else free(p);
+    }
+    if ((r & 255) == 0) sched_yield();
+  }
+
+  atomic_store(&s.stop, 1);
+  for (int i = 0; i < CMAP_READERS; ++ i) pthread_join(readers[i], NULL);
+
+  ASSERT_EQ(atomic_load(&s.bad), 0, "readers saw consistent data");
+  ASSERT(atomic_load(&s.lookups) > 0, "readers made progress");
+
+  ds_cmap_synchronize(s.map);
+  ASSERT_EQ(ds_cmap_pending(s.map), 0, "nothing pending after synchronize");
+
+  ds_cmap_destroy(s.map);
+  ASSERT_EQ((size_t)atomic_load(&freed_count), (size_t)(CMAP_KEYS / 2 + inserted), "every element freed once");
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"cmap_basic", test_cmap_basic},
+    {"cmap_many", test_cmap_many},
+    {"cmap_concurrent", test_cmap_concurrent},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
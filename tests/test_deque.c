@@ -4,6 +4,7 @@
 
 #include "ds_deque.h"
 #include "ds_common.h"
+#include "ds_deque_inline.h"
 
 /* ------------ Colored output ------------ */
 #define COLOR_GREEN "\033[32m"
@@ -147,6 +148,40 @@ static int ref_back(ref_deque_t *r, int *ok) {
   return r->a[idx];
 }
 
+/* Counting allocator: tracks live bytes so leaks and size mismatches show up. */
+typedef struct {
+  size_t live_bytes;
+  size_t allocs;
+  size_t frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  counting_ctx_t *c = ctx;
+  void *p = malloc(size);
+  if (p) { c->live_bytes += size; c->allocs ++; }
+  return p;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  counting_ctx_t *c = ctx;
+  void *p = realloc(ptr, new_size);
+  if (p) c->live_bytes = c->live_bytes - old_size + new_size;
+  return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+  counting_ctx_t *c = ctx;
+  if (!ptr) return;
+  c->live_bytes -= size;
+  c->frees ++;
+  free(ptr);
+}
+
+static ds_allocator_t counting_allocator(counting_ctx_t *ctx) {
+  ds_allocator_t a = { counting_alloc, counting_realloc, counting_free, ctx };
+  return a;
+}
+
 /* ===================== Tests ===================== */
 
 TEST_FUNC(test_deque_create_destroy_basic) {
@@ -397,8 +432,161 @@ TEST_FUNC(test_deque_random_ops_against_reference) {
   ref_free(&r);
 }
 
+TEST_FUNC(test_deque_custom_allocator) {
+  counting_ctx_t ctx = {0};
+  ds_allocator_t a = counting_allocator(&ctx);
+
+  ds_deque_t *dq = ds_deque_create_ex(2, &a);
+  ASSERT_NOT_NULL(dq, "create_ex with custom allocator returns non-NULL");
+
+  for (int i = 0; i < 50; ++ i) {
+    ds_deque_push_back(dq, mk_int(i));
+    ds_deque_push_front(dq, mk_int(-i));
+  }
+  ASSERT_EQ(ds_deque_size(dq), 100, "growth works through custom allocator");
+  ASSERT(ctx.live_bytes > 0, "storage accounted by the allocator");
+
+  ds_deque_destroy(dq, free);
+  ASSERT_EQ(ctx.live_bytes, 0, "every byte returned with the size it was allocated with");
+  ASSERT_EQ(ctx.allocs, ctx.frees, "alloc/free calls balanced");
+}
+
+TEST_FUNC(test_deque_growth_policy_and_shrink) {
+  ds_deque_t *dq = ds_deque_create(8);
+  ds_growth_policy_t p = { 1.5, 0, 0.25, 8 };
+  ASSERT_EQ(ds_deque_set_growth_policy(dq, &p), DS_OK, "policy accepted");
+
+  for (int i = 0; i < 9; ++ i) ds_deque_push_back(dq, mk_int(i));
+  ASSERT_EQ(ds_deque_capacity(dq), 12, "grows by growth_factor 1.5");
+
+  // Wrap the ring around, then shrink while wrapped
+  for (int i = 0; i < 300; ++ i) {
+    ds_deque_push_front(dq, mk_int(-1 - i));
+    ds_deque_push_back(dq, mk_int(9 + i));
+  }
+  size_t peak = ds_deque_capacity(dq);
+  while (ds_deque_size(dq) > 20) {
+    free(ds_deque_pop_front(dq));
+    if (ds_deque_size(dq) > 20) free(ds_deque_pop_back(dq));
+  }
+  ASSERT(ds_deque_capacity(dq) < peak, "capacity given back after draining");
+
+  int ok = 1;
+  int prev = int_val(ds_deque_front(dq)) - 1;
+  while (!ds_deque_is_empty(dq)) {
+    int *v = ds_deque_pop_front(dq);
+    if (*v != prev + 1) ok = 0;
+    prev = *v;
+    free(v);
+  }
+  ASSERT(ok, "order preserved across shrinks of a wrapped ring");
+  ASSERT_EQ(ds_deque_capacity(dq), 8, "empty deque shrinks to min_capacity");
+
+  // Explicit shrink on a full ring
+  ds_deque_set_growth_policy(dq, NULL);
+  for (int i = 0; i < 5; ++ i) ds_deque_push_front(dq, mk_int(4 - i));
+  ASSERT_EQ(ds_deque_shrink_to_fit(dq), DS_OK, "shrink_to_fit ok");
+  ASSERT_EQ(ds_deque_capacity(dq), 5, "capacity == size");
+  ds_deque_push_back(dq, mk_int(5));
+  ds_deque_push_front(dq, mk_int(-1));
+  ok = 1;
+  for (int i = -1; i <= 5; ++ i) {
+    int *v = ds_deque_pop_front(dq);
+    if (!v || *v != i) ok = 0;
+    free(v);
+  }
+  ASSERT(ok, "deque works after shrink_to_fit on a full ring");
+
+  ASSERT_EQ(ds_deque_shrink_to_fit(NULL), DS_ERR_NULL, "shrink_to_fit(NULL) -> DS_ERR_NULL");
+  ds_deque_destroy(dq, free);
+}
+
 /* ===================== main ===================== */
 
+TEST_FUNC(test_deque_as_spans) {
+  ds_span_t s[2];
+  ASSERT_EQ(ds_deque_as_spans(NULL, s), 0u, "NULL deque -> 0 spans");
+  ASSERT(ds_span_is_empty(s[0]) && ds_span_is_empty(s[1]), "spans cleared for NULL deque");
+
+  ds_deque_t *d = ds_deque_create(4);
+  ASSERT_EQ(ds_deque_as_spans(d, s), 0u, "empty deque -> 0 spans");
+
+  /* [1,2,3] from index 0: one segment */
+  for (int i = 1; i <= 3; i++) ds_deque_push_back(d, mk_int(i));
+  ASSERT_EQ(ds_deque_as_spans(d, s), 1u, "unwrapped -> 1 span");
+  ASSERT_EQ(s[0].size, 3u, "span covers all elements");
+  ASSERT_EQ(s[0].elem_size, sizeof(void *), "span of pointers");
+  ASSERT_EQ(ds_span_bytes(s[0]), 3 * sizeof(void *), "span bytes");
+  ASSERT_EQ(int_val(*(void **)ds_span_at(s[0], 2)), 3, "span element 2");
+  ASSERT_NULL(ds_span_at(s[0], 3), "span_at out of range");
+  ASSERT(ds_span_is_empty(s[1]), "second span empty");
+
+  /* Pop 2, push 3 more: [3 | 4,5,6] wraps around the end */
+  free(ds_deque_pop_front(d));
+  free(ds_deque_pop_front(d));
+  for (int i = 4; i <= 6; i++) ds_deque_push_back(d, mk_int(i));
+  ASSERT_EQ(ds_deque_capacity(d), 4u, "no growth");
+  ASSERT_EQ(ds_deque_as_spans(d, s), 2u, "wrapped -> 2 spans");
+  ASSERT_EQ(s[0].size + s[1].size, 4u, "spans cover the whole deque");
+
+  int exp[] = {3, 4, 5, 6}, k = 0, ok = 1;
+  for (int j = 0; j < 2; j++) {
+    void **items = s[j].data;
+    for (size_t i = 0; i < s[j].size; i++) if (int_val(items[i]) != exp[k ++]) ok = 0;
+  }
+  ASSERT(ok && k == 4, "spans are front to back");
+
+  ds_span_t tail = ds_span_subspan(s[0], 1, 10);
+  ASSERT_EQ(tail.size, s[0].size - 1, "subspan clamped to the span");
+  ASSERT(ds_span_is_empty(ds_span_subspan(s[0], 9, 1)), "subspan past the end is empty");
+
+  ds_deque_destroy(d, counted_free);
+}
+
+TEST_FUNC(test_deque_inline_and_embedded) {
+  /* Embedded by value: no allocation for the deque itself */
+  ds_deque_t d;
+  ASSERT_EQ(ds_deque_init(NULL, 0, NULL), DS_ERR_NULL, "init(NULL) -> DS_ERR_NULL");
+  ASSERT_EQ(ds_deque_init(&d, 3, NULL), DS_OK, "init in place");
+  ASSERT_EQ(ds_deque_capacity(&d), 3u, "capacity hint honoured");
+
+  /* [-1 | 0, 1] then wrap; the 4th push grows through the checked path */
+  ASSERT_EQ(ds_deque_push_back_fast(&d, mk_int(0)), DS_OK, "push_back_fast");
+  ASSERT_EQ(ds_deque_push_back_fast(&d, mk_int(1)), DS_OK, "push_back_fast");
+  ASSERT_EQ(ds_deque_push_front_fast(&d, mk_int(-1)), DS_OK, "push_front_fast wraps head");
+  ASSERT_EQ(ds_deque_push_back_fast(&d, mk_int(2)), DS_OK, "push_back_fast grows");
+  ASSERT_EQ(ds_deque_size(&d), 4u, "size 4");
+
+  int ok = 1;
+  for (size_t i = 0; i < 4; i++) if (int_val(ds_deque_get_unsafe(&d, i)) != (int)i - 1) ok = 0;
+  ASSERT(ok, "get_unsafe in front-to-back order");
+  ASSERT_EQ(int_val(ds_deque_front_unsafe(&d)), -1, "front_unsafe");
+  ASSERT_EQ(int_val(ds_deque_back_unsafe(&d)), 2, "back_unsafe");
+
+  int *p = ds_deque_pop_front_unsafe(&d);
+  ASSERT_EQ(*p, -1, "pop_front_unsafe");
+  free(p);
+  p = ds_deque_pop_back_unsafe(&d);
+  ASSERT_EQ(*p, 2, "pop_back_unsafe");
+  free(p);
+  ASSERT_EQ(int_val(ds_deque_front(&d)), 0, "checked front agrees");
+  ASSERT_EQ(int_val(ds_deque_back(&d)), 1, "checked back agrees");
+
+  /* Pop across the wrap point at the end of the buffer */
+  ds_deque_t w;
+  ds_deque_init(&w, 2, NULL);
+  ds_deque_push_front_fast(&w, mk_int(7));
+  ASSERT_EQ(int_val(ds_deque_back_unsafe(&w)), 7, "back_unsafe with tail at 0");
+  p = ds_deque_pop_back_unsafe(&w);
+  ASSERT_EQ(*p, 7, "pop_back_unsafe with tail at 0");
+  free(p);
+  ds_deque_fini(&w, counted_free);
+
+  ds_deque_fini(&d, counted_free);
+  ASSERT_NULL(d.items, "fini releases the buffer");
+  ds_deque_fini(&d, counted_free);
+}
+
 int main() {
   test_case_t tests[] = {
     {"deque_create_destroy_basic", test_deque_create_destroy_basic},
@@ -409,6 +597,10 @@ int main() {
     {"deque_grow_preserves_order", test_deque_grow_preserves_order},
     {"deque_clear_and_destroy_free", test_deque_clear_and_destroy_free},
     {"deque_random_ops_against_reference", test_deque_random_ops_against_reference},
+    {"deque_custom_allocator", test_deque_custom_allocator},
+    {"deque_growth_policy_and_shrink", test_deque_growth_policy_and_shrink},
+    {"deque_as_spans", test_deque_as_spans},
+    {"deque_inline_and_embedded", test_deque_inline_and_embedded},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
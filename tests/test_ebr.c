@@ -0,0 +1,195 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sched.h>
+
+#include "ds_common.h"
+#include "ds_ebr.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+typedef struct {
+  int value;
+  ds_ebr_node_t link;
+} obj_t;
+
+static atomic_int reclaimed_count;
+
+static void obj_reclaim(ds_ebr_node_t *link, void *ctx) {
+  (void)ctx;
+  obj_t *o = DS_CONTAINER_OF(link, obj_t, link);
+  free(o);
+  atomic_fetch_add(&reclaimed_count, 1);
+}
+
+static obj_t *mk_obj(int v) {
+  obj_t *o = (obj_t *)malloc(sizeof(obj_t));
+  if (o) o->value = v;
+  return o;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_ebr_basic) {
+  atomic_store(&reclaimed_count, 0);
+  ds_ebr_t *ebr = ds_ebr_create();
+  ASSERT_NOT_NULL(ebr, "ebr_create");
+
+  ds_ebr_thread_t *th = ds_ebr_register(ebr);
+  ASSERT_NOT_NULL(th, "register");
+
+  // A retire with no active reader is freed after the epoch moves twice
+  ds_ebr_retire(ebr, &mk_obj(1)->link, obj_reclaim, NULL);
+  ASSERT_EQ(ds_ebr_pending(ebr), 1, "one pending");
+  ds_ebr_collect(ebr);
+  ds_ebr_collect(ebr);
+  ASSERT_EQ(ds_ebr_pending(ebr), 0, "idle: reclaimed after two collects");
+  ASSERT_EQ(atomic_load(&reclaimed_count), 1, "callback ran");
+
+  // An active reader holds reclamation back
+  ds_ebr_enter(th);
+  ds_ebr_enter(th);   // nested
+  ds_ebr_retire(ebr, &mk_obj(2)->link, obj_reclaim, NULL);
+  for (int i = 0; i < 5; ++ i) ds_ebr_collect(ebr);
+  ASSERT_EQ(ds_ebr_pending(ebr), 1, "held back by an active reader");
+  ds_ebr_leave(th);
+  for (int i = 0; i < 5; ++ i) ds_ebr_collect(ebr);
+  ASSERT_EQ(ds_ebr_pending(ebr), 1, "still held inside the outer section");
+  ds_ebr_leave(th);
+  ASSERT_EQ(ds_ebr_synchronize(ebr), 1, "synchronize reclaims it");
+  ASSERT_EQ(ds_ebr_pending(ebr), 0, "nothing pending");
+  ASSERT_EQ(ds_ebr_synchronize(ebr), 0, "synchronize with nothing pending");
+
+  // Destroy reclaims what is left, including unregistered records
+  ds_ebr_retire(ebr, &mk_obj(3)->link, obj_reclaim, NULL);
+  ds_ebr_unregister(th);
+  ds_ebr_register(ebr);
+  ds_ebr_destroy(ebr);
+  ASSERT_EQ(atomic_load(&reclaimed_count), 3, "destroy reclaims pending");
+
+  // NULL safety
+  ds_ebr_enter(NULL);
+  ds_ebr_leave(NULL);
+  ASSERT_EQ(ds_ebr_collect(NULL), 0, "collect NULL");
+  ASSERT_NULL(ds_ebr_register(NULL), "register NULL");
+}
+
+/* --------- Concurrent readers --------- */
+
+#define EBR_READERS 3
+#define EBR_ROUNDS  20000
+
+typedef struct {
+  ds_ebr_t *ebr;
+  _Atomic(obj_t *) shared;
+  atomic_int stop;
+  atomic_int bad;
+} ebr_shared_t;
+
+static void *ebr_reader_main(void *arg) {
+  ebr_shared_t *s = arg;
+  ds_ebr_thread_t *th = ds_ebr_register(s->ebr);
+
+  while (!atomic_load(&s->stop)) {
+    ds_ebr_enter(th);
+    obj_t *o = atomic_load_explicit(&s->shared, memory_order_acquire);
+    if (o && o->value < 0) atomic_fetch_add(&s->bad, 1);
+    ds_ebr_leave(th);
+  }
+
+  ds_ebr_unregister(th);
+  return NULL;
+}
+
+TEST_FUNC(test_ebr_concurrent) {
+  atomic_store(&reclaimed_count, 0);
+  ebr_shared_t s;
+  s.ebr = ds_ebr_create();
+  atomic_init(&s.shared, mk_obj(0));
+  atomic_init(&s.stop, 0);
+  atomic_init(&s.bad, 0);
+
+  pthread_t readers[EBR_READERS];
+  for (int i = 0; i < EBR_READERS; ++ i) pthread_create(&readers[i], NULL, ebr_reader_main, &s);
+
+  // Swap the shared object; retire the old one (ASan catches early frees)
+  for (int i = 1; i <= EBR_ROUNDS; ++ i) {
+    obj_t *old = atomic_exchange_explicit(&s.shared, mk_obj(i), memory_order_acq_rel);
+    ds_ebr_retire(s.ebr, &old->link, obj_reclaim, NULL);
+    if (i % 64 == 0) ds_ebr_collect(s.ebr);
+  }
+
+  atomic_store(&s.stop, 1);
+  for (int i = 0; i < EBR_READERS; ++ i) pthread_join(readers[i], NULL);
+
+  ds_ebr_synchronize(s.ebr);
+  ASSERT_EQ(ds_ebr_pending(s.ebr), 0, "all retired objects reclaimed");
+  ASSERT_EQ(atomic_load(&reclaimed_count), EBR_ROUNDS, "every object reclaimed once");
+  ASSERT_EQ(atomic_load(&s.bad), 0, "readers saw only valid objects");
+
+  free(atomic_load(&s.shared));
+  ds_ebr_destroy(s.ebr);
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"ebr_basic", test_ebr_basic},
+    {"ebr_concurrent", test_ebr_concurrent},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -0,0 +1,236 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ds_common.h"
+#include "ds_generic.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Instantiations ===================== */
+
+typedef struct {
+  int key;
+  int id;
+} pair_t;
+
+DS_DEFINE_VECTOR(ivec, int)
+DS_DEFINE_HEAP(minheap, int, a < b)
+DS_DEFINE_HEAP(maxpair, pair_t, a.key > b.key)
+DS_DEFINE_BST(itree, int, a < b)
+DS_DEFINE_SORT(isort, int, a < b)
+DS_DEFINE_SORT_CTX(psort, pair_t, const int *, ctx[a.key] < ctx[b.key])
+
+/* ===================== Vector ===================== */
+
+TEST_FUNC(test_generic_vector) {
+  ivec_t v;
+  ASSERT_EQ(ivec_init(&v, NULL), DS_OK, "init");
+  ASSERT_EQ(ivec_size(&v), 0u, "empty after init");
+  ASSERT_EQ(ivec_pop(&v, NULL), DS_ERR_EMPTY, "pop on empty");
+  ASSERT_NULL(ivec_at(&v, 0), "at on empty");
+
+  int ok = 1;
+  for (int i = 0; i < 1000; ++ i) ok &= ivec_push(&v, i * 3) == DS_OK;
+  ASSERT(ok, "1000 pushes");
+  ASSERT_EQ(ivec_size(&v), 1000u, "size 1000");
+  ASSERT(v.capacity >= 1000, "capacity grew");
+  ASSERT_EQ(*ivec_at(&v, 500), 1500, "at(500)");
+  ASSERT_NULL(ivec_at(&v, 1000), "at out of range");
+
+  int out = 0;
+  ASSERT_EQ(ivec_pop(&v, &out), DS_OK, "pop");
+  ASSERT_EQ(out, 2997, "pop returns last");
+
+  ivec_clear(&v);
+  ASSERT_EQ(ivec_size(&v), 0u, "clear");
+  ASSERT_EQ(ivec_reserve(&v, 4096), DS_OK, "reserve");
+  ASSERT(v.capacity >= 4096, "reserve grows capacity");
+  ivec_destroy(&v);
+  ASSERT_NULL(v.data, "destroy releases storage");
+}
+
+/* ===================== Heap ===================== */
+
+TEST_FUNC(test_generic_heap) {
+  minheap_t h;
+  minheap_init(&h, NULL);
+  ASSERT_NULL(minheap_top(&h), "top on empty");
+  ASSERT_EQ(minheap_pop(&h, NULL), DS_ERR_EMPTY, "pop on empty");
+
+  srand(7);
+  for (int i = 0; i < 2000; ++ i) minheap_push(&h, rand() % 500);
+  ASSERT_EQ(minheap_size(&h), 2000u, "size after pushes");
+
+  int ok = 1, last = -1, x;
+  while (minheap_pop(&h, &x) == DS_OK) {
+    if (x < last) ok = 0;
+    last = x;
+  }
+  ASSERT(ok, "pops in ascending order");
+
+  int items[] = { 5, 1, 9, 3, 7, 2, 8 };
+  ASSERT_EQ(minheap_assign(&h, items, 7), DS_OK, "assign");
+  ASSERT_EQ(*minheap_top(&h), 1, "heapified top");
+  ok = 1;
+  for (int want = 1, got; minheap_pop(&h, &got) == DS_OK; ) {
+    if (got < want) ok = 0;
+    want = got;
+  }
+  ASSERT(ok, "assign produces a valid heap");
+  minheap_destroy(&h);
+
+  maxpair_t m;
+  maxpair_init(&m, NULL);
+  for (int i = 0; i < 10; ++ i) maxpair_push(&m, (pair_t){ (i * 7) % 10, i });
+  pair_t p = { 0, 0 };
+  maxpair_pop(&m, &p);
+  ASSERT_EQ(p.key, 9, "struct values, max-heap expression");
+  maxpair_destroy(&m);
+}
+
+/* ===================== BST ===================== */
+
+TEST_FUNC(test_generic_bst) {
+  itree_t t;
+  itree_init(&t, NULL);
+  ASSERT_NULL(itree_min(&t), "min on empty");
+  ASSERT_EQ(itree_remove(&t, 1), DS_ERR_NOT_FOUND, "remove on empty");
+
+  int keys[] = { 50, 30, 70, 20, 40, 60, 80, 35, 45, 65 };
+  for (size_t i = 0; i < 10; ++ i) itree_insert(&t, keys[i]);
+  ASSERT_EQ(itree_insert(&t, 40), DS_ERR_EXIST, "duplicate rejected");
+  ASSERT_EQ(itree_size(&t), 10u, "size 10");
+  ASSERT_NOT_NULL(itree_search(&t, 65), "search hit");
+  ASSERT_NULL(itree_search(&t, 66), "search miss");
+  ASSERT_EQ(*itree_min(&t), 20, "min");
+  ASSERT_EQ(*itree_max(&t), 80, "max");
+
+  ASSERT_EQ(itree_remove(&t, 30), DS_OK, "remove two-child node");
+  ASSERT_EQ(itree_remove(&t, 80), DS_OK, "remove leaf");
+  ASSERT_EQ(itree_remove(&t, 50), DS_OK, "remove root");
+  ASSERT_NULL(itree_search(&t, 30), "removed key gone");
+
+  int expect[] = { 20, 35, 40, 45, 60, 65, 70 };
+  int ok = 1;
+  size_t n = 0;
+  int *it;
+  DS_GENERIC_BST_FOREACH(itree, &t, it) {
+    if (n >= 7 || *it != expect[n]) ok = 0;
+    n ++;
+  }
+  ASSERT(ok && n == 7, "in-order walk after removals");
+  itree_destroy(&t);
+
+  // Sorted input degenerates into a list; destroy must not recurse
+  itree_init(&t, NULL);
+  for (int i = 0; i < 100000; ++ i) itree_insert(&t, 100000 - i);
+  ASSERT_EQ(itree_size(&t), 100000u, "degenerate tree size");
+  itree_destroy(&t);
+  ASSERT_NULL(t.root, "degenerate tree destroyed");
+}
+
+/* ===================== Sort ===================== */
+
+TEST_FUNC(test_generic_sort) {
+  enum { N = 5000 };
+  static int a[N];
+  unsigned seed = 7;
+
+  // Random, few distinct keys, sorted, reversed and organ-pipe inputs
+  for (int pattern = 0; pattern < 5; ++ pattern) {
+    for (int i = 0; i < N; ++ i) {
+      seed = seed * 1103515245u + 12345u;
+      switch (pattern) {
+        case 0: a[i] = (int)(seed >> 8); break;
+        case 1: a[i] = (int)(seed >> 8) % 3; break;
+        case 2: a[i] = i; break;
+        case 3: a[i] = N - i; break;
+        default: a[i] = i < N / 2 ? i : N - i; break;
+      }
+    }
+    long sum = 0;
+    for (int i = 0; i < N; ++ i) sum += a[i];
+
+    isort_sort(a, N);
+    int ok = 1;
+    long sum_after = 0;
+    for (int i = 0; i < N; ++ i) {
+      if (i > 0 && a[i - 1] > a[i]) ok = 0;
+      sum_after += a[i];
+    }
+    ASSERT(ok && sum == sum_after, "sorted permutation for every pattern");
+  }
+
+  isort_sort(a, 0);
+  isort_sort(NULL, 0);
+  int one[1] = { 5 };
+  isort_sort(one, 1);
+  ASSERT_EQ(one[0], 5, "single element untouched");
+
+  // The context variant orders by a lookup table
+  const int rank[4] = { 3, 1, 0, 2 };
+  pair_t p[4] = { {0, 0}, {1, 1}, {2, 2}, {3, 3} };
+  psort_sort(p, 4, rank);
+  ASSERT(p[0].key == 2 && p[1].key == 1 && p[2].key == 3 && p[3].key == 0, "sort with context");
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"generic_vector", test_generic_vector},
+    {"generic_heap", test_generic_heap},
+    {"generic_bst", test_generic_bst},
+    {"generic_sort", test_generic_sort},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
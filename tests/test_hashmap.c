@@ -0,0 +1,238 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_common.h"
+#include "ds_hashmap.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+/* Integer keys are stored directly in the pointer */
+#define KEY(v) ((void *)(intptr_t)(v))
+#define VAL(p) ((intptr_t)(p))
+
+static size_t hash_int(const void *k) {
+  return (size_t)VAL(k);
+}
+
+static size_t hash_const(const void *k) {
+  (void)k;
+  return 42;          /* every key collides */
+}
+
+static bool equal_int(const void *a, const void *b) {
+  return a == b;
+}
+
+static int g_free_count = 0;
+static void counted_free(void *p) {
+  if (p) g_free_count ++;
+  free(p);
+}
+
+static int *mk_int(int v) {
+  int *p = malloc(sizeof(int));
+  *p = v;
+  return p;
+}
+
+static size_t hash_str(const void *k) {
+  size_t h = 5381;
+  for (const unsigned char *s = k; *s; ++ s) h = h * 33 + *s;
+  return h;
+}
+
+static bool equal_str(const void *a, const void *b) {
+  return strcmp(a, b) == 0;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_hashmap_basic) {
+  ASSERT_NULL(ds_hashmap_create(NULL, equal_int, 0), "hash required");
+  ds_hashmap_t *m = ds_hashmap_create(hash_int, equal_int, 0);
+  ASSERT_NOT_NULL(m, "create");
+  ASSERT(ds_hashmap_is_empty(m), "new map is empty");
+
+  ASSERT_EQ(ds_hashmap_insert(m, KEY(1), mk_int(10)), DS_OK, "insert 1");
+  ASSERT_EQ(ds_hashmap_insert(m, KEY(2), mk_int(20)), DS_OK, "insert 2");
+  ASSERT_EQ(ds_hashmap_insert(m, KEY(2), NULL), DS_ERR_EXIST, "duplicate insert");
+  ASSERT_EQ(ds_hashmap_insert(m, NULL, NULL), DS_ERR_ARG, "NULL key");
+  ASSERT_EQ(ds_hashmap_insert(NULL, KEY(3), NULL), DS_ERR_NULL, "NULL map");
+  ASSERT_EQ(ds_hashmap_size(m), 2u, "size 2");
+  ASSERT_EQ(*(int *)ds_hashmap_get(m, KEY(2)), 20, "get 2");
+  ASSERT_NULL(ds_hashmap_get(m, KEY(3)), "get missing");
+
+  /* put replaces the value and frees the old one */
+  g_free_count = 0;
+  ASSERT_EQ(ds_hashmap_put(m, KEY(2), mk_int(21), counted_free), DS_OK, "put existing");
+  ASSERT_EQ(g_free_count, 1, "old value freed");
+  ASSERT_EQ(*(int *)ds_hashmap_get(m, KEY(2)), 21, "value replaced");
+  ASSERT_EQ(ds_hashmap_put(m, KEY(3), NULL, counted_free), DS_OK, "put new, NULL value");
+  ASSERT(ds_hashmap_contains(m, KEY(3)), "NULL value is still present");
+  ASSERT_EQ(ds_hashmap_size(m), 3u, "size 3");
+
+  ASSERT_EQ(ds_hashmap_remove(m, KEY(1), NULL, counted_free), DS_OK, "remove 1");
+  ASSERT_EQ(g_free_count, 2, "removed value freed");
+  ASSERT_EQ(ds_hashmap_remove(m, KEY(1), NULL, NULL), DS_ERR_NOT_FOUND, "remove again");
+  ASSERT(!ds_hashmap_contains(m, KEY(1)), "1 gone");
+
+  ds_hashmap_destroy(m, NULL, counted_free);
+  ASSERT_EQ(g_free_count, 3, "destroy frees the remaining value");
+
+  /* string keys owned by the map */
+  m = ds_hashmap_create(hash_str, equal_str, 4);
+  const char *words[] = {"alpha", "beta", "gamma", "delta"};
+  for (int i = 0; i < 4; ++ i) ds_hashmap_insert(m, strdup(words[i]), KEY(i + 1));
+  ASSERT_EQ(VAL(ds_hashmap_get(m, "gamma")), 3, "lookup by an equal, distinct string");
+  g_free_count = 0;
+  ASSERT_EQ(ds_hashmap_remove(m, "beta", counted_free, NULL), DS_OK, "remove frees the stored key");
+  ds_hashmap_clear(m, counted_free, NULL);
+  ASSERT_EQ(g_free_count, 4, "clear frees every key");
+  ASSERT(ds_hashmap_is_empty(m), "empty after clear");
+  ds_hashmap_destroy(m, NULL, NULL);
+}
+
+TEST_FUNC(test_hashmap_random_ops_incremental_resize) {
+  enum { N = 5000 };
+  static bool present[N];
+  ds_hashmap_t *m = ds_hashmap_create(hash_int, equal_int, 0);
+  size_t count = 0, max_capacity = 0;
+  int ok = 1;
+  unsigned seed = 7;
+
+  for (int step = 0; step < 100000; ++ step) {
+    seed = seed * 1103515245u + 12345u;
+    int k = 1 + (int)((seed >> 8) % N);
+    bool remove = ((seed >> 4) & 3) == 0;   /* 1 in 4 ops removes */
+
+    if (remove) {
+      ok &= ds_hashmap_remove(m, KEY(k), NULL, NULL) == (present[k - 1] ? DS_OK : DS_ERR_NOT_FOUND);
+      if (present[k - 1]) count --;
+      present[k - 1] = false;
+    } else {
+      ok &= ds_hashmap_put(m, KEY(k), KEY(k * 2), NULL) == DS_OK;
+      if (!present[k - 1]) count ++;
+      present[k - 1] = true;
+    }
+    if (ds_hashmap_capacity(m) > max_capacity) max_capacity = ds_hashmap_capacity(m);
+  }
+  ASSERT(ok, "every op returns the expected status");
+  ASSERT_EQ(ds_hashmap_size(m), count, "size matches reference");
+  ASSERT(max_capacity <= 8192, "tombstone churn does not keep growing the table");
+
+  ok = 1;
+  for (int k = 1; k <= N; ++ k) {
+    ok &= ds_hashmap_contains(m, KEY(k)) == present[k - 1];
+    if (present[k - 1]) ok &= VAL(ds_hashmap_get(m, KEY(k))) == k * 2;
+  }
+  ASSERT(ok, "contents match reference");
+
+  /* iteration sees every entry exactly once, even mid-resize */
+  ds_hashmap_t *g = ds_hashmap_create(hash_int, equal_int, 0);
+  static int seen[N];
+  size_t cap0 = ds_hashmap_capacity(g);
+  int k = 1;
+  while (ds_hashmap_capacity(g) == cap0) ds_hashmap_insert(g, KEY(k), NULL), k ++;
+  ds_hashmap_insert(g, KEY(k), NULL);   /* one step into the migration */
+  size_t cursor = 0, n = 0;
+  void *key;
+  while (ds_hashmap_next(g, &cursor, &key, NULL)) {
+    seen[VAL(key) - 1] ++;
+    n ++;
+  }
+  ok = n == ds_hashmap_size(g) && n == (size_t)k;
+  for (int i = 0; i < k; ++ i) ok &= seen[i] == 1;
+  ASSERT(ok, "iteration during migration is exact");
+
+  ds_hashmap_destroy(g, NULL, NULL);
+  ds_hashmap_destroy(m, NULL, NULL);
+}
+
+TEST_FUNC(test_hashmap_reserve_rehash_collisions) {
+  ds_hashmap_t *m = ds_hashmap_create(hash_int, equal_int, 0);
+  ASSERT_EQ(ds_hashmap_reserve(m, 1000), DS_OK, "reserve 1000");
+  size_t cap = ds_hashmap_capacity(m);
+  ASSERT(cap - cap / 8 >= 1000, "reserved capacity holds 1000 at max load");
+  for (int i = 1; i <= 1000; ++ i) ds_hashmap_insert(m, KEY(i), NULL);
+  ASSERT_EQ(ds_hashmap_capacity(m), cap, "no resize after reserve");
+
+  for (int i = 1; i <= 990; ++ i) ds_hashmap_remove(m, KEY(i), NULL, NULL);
+  ASSERT_EQ(ds_hashmap_rehash(m, 0), DS_OK, "rehash to fit");
+  ASSERT_EQ(ds_hashmap_capacity(m), 16u, "shrunk to the minimum table");
+  int ok = 1;
+  for (int i = 991; i <= 1000; ++ i) ok &= ds_hashmap_contains(m, KEY(i));
+  ASSERT(ok && ds_hashmap_size(m) == 10, "entries survive rehash");
+  ds_hashmap_destroy(m, NULL, NULL);
+
+  /* a degenerate hash still works, probing every group */
+  m = ds_hashmap_create(hash_const, equal_int, 0);
+  for (int i = 1; i <= 200; ++ i) ds_hashmap_insert(m, KEY(i), KEY(i));
+  for (int i = 1; i <= 200; i += 2) ds_hashmap_remove(m, KEY(i), NULL, NULL);
+  ok = 1;
+  for (int i = 1; i <= 200; ++ i) ok &= ds_hashmap_contains(m, KEY(i)) == (i % 2 == 0);
+  ASSERT(ok && ds_hashmap_size(m) == 100, "constant hash: contents correct");
+  ds_hashmap_destroy(m, NULL, NULL);
+}
+
+int main() {
+  test_case_t tests[] = {
+    {"hashmap_basic", test_hashmap_basic},
+    {"hashmap_random_ops_incremental_resize", test_hashmap_random_ops_incremental_resize},
+    {"hashmap_reserve_rehash_collisions", test_hashmap_reserve_rehash_collisions},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -251,6 +251,180 @@ TEST_FUNC(test_heap_push_arg_checks) {
   ds_heap_destroy(h, counted_free);
 }
 
+TEST_FUNC(test_heap_growth_policy_and_shrink) {
+  ds_heap_t *heap = ds_heap_create(int_compare_min, 4);
+  ds_growth_policy_t p = { 2.0, 0, 0.25, 4 };
+  ASSERT_EQ(ds_heap_set_growth_policy(heap, &p), DS_OK, "policy accepted");
+
+  for (int i = 500; i > 0; -- i) ds_heap_push(heap, mk_int(i));
+  size_t peak = ds_heap_capacity(heap);
+
+  int ok = 1;
+  for (int i = 1; i <= 490; ++ i) {
+    int *v = ds_heap_pop(heap);
+    if (!v || *v != i) ok = 0;
+    free(v);
+  }
+  ASSERT(ok, "pop order correct while shrinking");
+  ASSERT(ds_heap_capacity(heap) < peak, "capacity given back after pops");
+  ASSERT(ds_heap_capacity(heap) >= ds_heap_size(heap), "capacity still holds every element");
+
+  ASSERT_EQ(ds_heap_shrink_to_fit(heap), DS_OK, "shrink_to_fit ok");
+  ASSERT_EQ(ds_heap_capacity(heap), 10, "capacity == size");
+  ASSERT_EQ(int_val(ds_heap_top(heap)), 491, "top intact");
+
+  ds_heap_clear(heap, free);
+  ASSERT_EQ(ds_heap_capacity(heap), 4, "clear shrinks down to min_capacity");
+  ASSERT_EQ(ds_heap_set_growth_policy(heap, &(ds_growth_policy_t){ 0.5, 0, 0.0, 0 }), DS_ERR_ARG, "bad policy rejected");
+  ds_heap_destroy(heap, free);
+}
+
+TEST_FUNC(test_heap_create_from_and_push_batch) {
+  void *items[1000];
+  uint32_t seed = 12345u;
+  for (int i = 0; i < 1000; ++ i) {
+    seed = seed * 1664525u + 1013904223u;
+    items[i] = mk_int((int)(seed % 5000));
+  }
+
+  ds_heap_t *h = ds_heap_create_from(int_compare_min, items, 600);
+  ASSERT_NOT_NULL(h, "create_from non-NULL");
+  ASSERT_EQ(ds_heap_size(h), 600u, "create_from size");
+
+  ASSERT_EQ(ds_heap_push_batch(h, items + 600, 100), DS_OK, "small batch (sift-up path)");
+  ASSERT_EQ(ds_heap_push_batch(h, items + 700, 300), DS_OK, "batch onto heap");
+  ASSERT_EQ(ds_heap_size(h), 1000u, "size after batches");
+  ASSERT_EQ(ds_heap_push_batch(h, NULL, 3), DS_ERR_ARG, "push_batch(NULL) -> DS_ERR_ARG");
+  void *bad[2] = { items[0], NULL };
+  ASSERT_EQ(ds_heap_push_batch(h, bad, 2), DS_ERR_ARG, "push_batch with NULL element -> DS_ERR_ARG");
+  ASSERT_EQ(ds_heap_size(h), 1000u, "failed batch inserts nothing");
+
+  int ok = 1, last = -1;
+  for (int i = 0; i < 1000; ++ i) {
+    int *p = ds_heap_pop(h);
+    if (!p || *p < last) ok = 0;
+    last = p ? *p : last;
+    free(p);
+  }
+  ASSERT(ok, "pops come out sorted");
+  ds_heap_destroy(h, NULL);
+
+  // Large batch onto an empty heap takes the heapify path
+  h = ds_heap_create(int_compare_max, 0);
+  int vals[] = { 3, 9, 1, 7, 5 };
+  void *ptrs[5];
+  for (int i = 0; i < 5; ++ i) ptrs[i] = mk_int(vals[i]);
+  ASSERT_EQ(ds_heap_push_batch(h, ptrs, 5), DS_OK, "batch onto empty heap");
+  ASSERT_EQ(int_val(ds_heap_top(h)), 9, "max on top after heapify");
+  ds_heap_destroy(h, counted_free);
+
+  ASSERT_NULL(ds_heap_create_from(int_compare_min, NULL, 3), "create_from(NULL items) -> NULL");
+  h = ds_heap_create_from(int_compare_min, NULL, 0);
+  ASSERT(h && ds_heap_is_empty(h), "create_from with n == 0 gives an empty heap");
+  ds_heap_destroy(h, NULL);
+}
+
+TEST_FUNC(test_heap_pushpop_replace_top) {
+  ds_heap_t *h = ds_heap_create(int_compare_min, 0);
+  int *one = mk_int(1);
+  ASSERT_EQ(ds_heap_pushpop(h, one), one, "pushpop on empty returns the element");
+  ASSERT_NULL(ds_heap_replace_top(h, one), "replace_top on empty -> NULL");
+  ASSERT_EQ(ds_heap_size(h), 0u, "heap still empty");
+  free(one);
+
+  for (int i = 10; i <= 50; i += 10) ds_heap_push(h, mk_int(i));
+
+  int *small = mk_int(5);
+  ASSERT_EQ(ds_heap_pushpop(h, small), small, "pushpop of a better element returns it");
+  free(small);
+
+  int *mid = mk_int(25);
+  int *out = ds_heap_pushpop(h, mid);
+  ASSERT_EQ(int_val(out), 10, "pushpop returns the old top");
+  ASSERT_EQ(int_val(ds_heap_top(h)), 20, "new top after pushpop");
+  free(out);
+
+  int *tiny = mk_int(1);
+  out = ds_heap_replace_top(h, tiny);
+  ASSERT_EQ(int_val(out), 20, "replace_top returns the old top even if the new one is better");
+  ASSERT_EQ(int_val(ds_heap_top(h)), 1, "replacement is the new top");
+  ASSERT_EQ(ds_heap_size(h), 5u, "size unchanged by pushpop/replace_top");
+  free(out);
+
+  int expect[] = { 1, 25, 30, 40, 50 };
+  int ok = 1;
+  for (int i = 0; i < 5; ++ i) {
+    int *p = ds_heap_pop(h);
+    if (int_val(p) != expect[i]) ok = 0;
+    free(p);
+  }
+  ASSERT(ok, "heap order intact");
+  ds_heap_destroy(h, NULL);
+}
+
+TEST_FUNC(test_heap_arity) {
+  ds_heap_t *h = ds_heap_create(int_compare_min, 0);
+  ASSERT_EQ(ds_heap_arity(h), 2u, "binary by default");
+  ASSERT_EQ(ds_heap_set_arity(h, 3), DS_ERR_ARG, "arity 3 rejected");
+  ASSERT_EQ(ds_heap_set_arity(h, 1), DS_ERR_ARG, "arity 1 rejected");
+  ASSERT_EQ(ds_heap_set_arity(h, 32), DS_ERR_ARG, "arity 32 rejected");
+
+  uint32_t seed = 777u;
+  for (int i = 0; i < 3000; ++ i) {
+    seed = seed * 1664525u + 1013904223u;
+    ds_heap_push(h, mk_int((int)(seed % 10000)));
+  }
+
+  // Switch layouts with elements inside, and keep pushing/popping
+  size_t arities[] = { 4, 8, 16, 2, 8 };
+  int ok = 1, last = -1;
+  for (size_t a = 0; a < 5; ++ a) {
+    if (ds_heap_set_arity(h, arities[a]) != DS_OK || ds_heap_arity(h) != arities[a]) ok = 0;
+    last = -1;
+    for (int i = 0; i < 200; ++ i) {
+      int *p = ds_heap_pop(h);
+      if (!p || *p < last) ok = 0;
+      last = p ? *p : last;
+      free(p);
+    }
+    for (int i = 0; i < 100; ++ i) {
+      seed = seed * 1664525u + 1013904223u;
+      ds_heap_push(h, mk_int((int)(seed % 10000)));
+    }
+  }
+  ASSERT(ok, "heap order kept across arity changes");
+
+  last = -1;
+  while (!ds_heap_is_empty(h)) {
+    int *p = ds_heap_pop(h);
+    if (*p < last) ok = 0;
+    last = *p;
+    free(p);
+  }
+  ASSERT(ok, "8-ary heap drains in sorted order");
+  ds_heap_destroy(h, NULL);
+}
+
+TEST_FUNC(test_heap_as_span) {
+  ds_span_t empty = ds_heap_as_span(NULL);
+  ASSERT_EQ(empty.size, 0, "span of NULL heap is empty");
+
+  ds_heap_t *h = ds_heap_create(int_compare_min, 0);
+  for (int i = 10; i > 0; -- i) ds_heap_push(h, mk_int(i));
+  ds_span_t span = ds_heap_as_span(h);
+  ASSERT_EQ(span.size, 10, "span covers every element");
+  ASSERT_EQ(span.elem_size, sizeof(void *), "span of pointers");
+  ASSERT_EQ(*(int *)((void **)span.data)[0], 1, "slot 0 is the top");
+
+  ds_heap_t *copy = ds_heap_create_from(int_compare_min, span.data, span.size);
+  ASSERT_NOT_NULL(copy, "rebuild from span");
+  ds_span_t again = ds_heap_as_span(copy);
+  ASSERT(memcmp(again.data, span.data, ds_span_bytes(span)) == 0, "rebuild keeps storage order");
+
+  ds_heap_destroy(copy, NULL);
+  ds_heap_destroy(h, free);
+}
+
 /* ===================== main ===================== */
 
 int main() {
@@ -264,6 +438,11 @@ int main() {
     {"heap_clear_frees", test_heap_clear_frees},
     {"heap_bulk_random_sorted_by_popping", test_heap_bulk_random_sorted_by_popping},
     {"heap_push_arg_checks", test_heap_push_arg_checks},
+    {"heap_growth_policy_and_shrink", test_heap_growth_policy_and_shrink},
+    {"heap_create_from_and_push_batch", test_heap_create_from_and_push_batch},
+    {"heap_pushpop_replace_top", test_heap_pushpop_replace_top},
+    {"heap_arity", test_heap_arity},
+    {"heap_as_span", test_heap_as_span},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
@@ -0,0 +1,192 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "ds_common.h"
+#include "ds_iheap.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+typedef struct {
+  int key;
+  int id;
+} item_t;
+
+static int item_compare(const void *a, const void *b) {
+  int x = ((const item_t *)a)->key;
+  int y = ((const item_t *)b)->key;
+  return (x > y) - (x < y);
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_iheap_basic) {
+  ASSERT_NULL(ds_iheap_create(NULL, 0), "create(NULL compare) -> NULL");
+
+  ds_iheap_t *h = ds_iheap_create(item_compare, 2);
+  ASSERT_NOT_NULL(h, "create non-NULL");
+  ASSERT(ds_iheap_is_empty(h), "new heap empty");
+  ASSERT_NULL(ds_iheap_pop(h), "pop(empty) -> NULL");
+  ASSERT_EQ(ds_iheap_top_handle(h), DS_IHEAP_INVALID_HANDLE, "top_handle(empty) invalid");
+  ASSERT_EQ(ds_iheap_push(h, NULL, NULL), DS_ERR_ARG, "push(NULL element) -> DS_ERR_ARG");
+
+  item_t items[5] = { {50, 0}, {10, 1}, {40, 2}, {20, 3}, {30, 4} };
+  ds_iheap_handle_t hd[5];
+  for (int i = 0; i < 5; ++ i) ds_iheap_push(h, &items[i], &hd[i]);
+  ASSERT_EQ(ds_iheap_size(h), 5u, "size after pushes");
+  ASSERT_EQ(ds_iheap_top(h), &items[1], "top is the smallest key");
+  ASSERT_EQ(ds_iheap_top_handle(h), hd[1], "top_handle matches");
+  ASSERT_EQ(ds_iheap_get(h, hd[2]), &items[2], "get by handle");
+
+  // decrease_key on an element mutated in place
+  items[0].key = 5;
+  ASSERT_EQ(ds_iheap_decrease_key(h, hd[0], &items[0]), DS_OK, "decrease_key ok");
+  ASSERT_EQ(ds_iheap_top(h), &items[0], "decreased element rises to the top");
+
+  items[0].key = 45;
+  ASSERT_EQ(ds_iheap_increase_key(h, hd[0], &items[0]), DS_OK, "increase_key ok");
+  ASSERT_EQ(ds_iheap_top(h), &items[1], "increased element sinks");
+
+  items[2].key = 1;
+  ASSERT_EQ(ds_iheap_update(h, hd[2], &items[2]), DS_OK, "update ok");
+  ASSERT_EQ(ds_iheap_top(h), &items[2], "update moves up");
+
+  ASSERT_EQ(ds_iheap_remove(h, hd[3]), &items[3], "remove by handle");
+  ASSERT(!ds_iheap_contains(h, hd[3]), "removed handle is no longer contained");
+  ASSERT_NULL(ds_iheap_remove(h, hd[3]), "second remove -> NULL");
+  ASSERT_EQ(ds_iheap_decrease_key(h, hd[3], &items[3]), DS_ERR_NOT_FOUND, "decrease_key(stale) -> DS_ERR_NOT_FOUND");
+  ASSERT(!ds_iheap_contains(h, 12345), "unknown handle not contained");
+
+  int expect[] = { 1, 10, 30, 45 };
+  int ok = 1;
+  for (int i = 0; i < 4; ++ i) {
+    item_t *it = ds_iheap_pop(h);
+    if (!it || it->key != expect[i]) ok = 0;
+  }
+  ASSERT(ok, "pop order after updates");
+  ASSERT(ds_iheap_is_empty(h), "empty after pops");
+
+  // Freed handles get reused
+  ds_iheap_handle_t again;
+  ds_iheap_push(h, &items[4], &again);
+  ASSERT(again < 5, "handle reused after removal");
+  ds_iheap_clear(h, NULL);
+  ASSERT(!ds_iheap_contains(h, again), "clear invalidates handles");
+
+  ds_iheap_destroy(h, NULL);
+}
+
+TEST_FUNC(test_iheap_random_ops) {
+  enum { N = 2000 };
+  static item_t items[N];
+  static ds_iheap_handle_t hd[N];
+  static int live[N];
+  ds_iheap_t *h = ds_iheap_create(item_compare, 0);
+
+  uint32_t seed = 0xBEEFu;
+  for (int i = 0; i < N; ++ i) {
+    seed = seed * 1664525u + 1013904223u;
+    items[i] = (item_t){ (int)(seed % 100000), i };
+    ds_iheap_push(h, &items[i], &hd[i]);
+    live[i] = 1;
+  }
+
+  // Random mix of key changes and removals
+  size_t live_count = N;
+  for (int r = 0; r < 5000; ++ r) {
+    seed = seed * 1664525u + 1013904223u;
+    int i = (int)(seed % N);
+    if (!live[i]) continue;
+    seed = seed * 1664525u + 1013904223u;
+    switch (seed % 3) {
+      case 0:
+        items[i].key -= (int)(seed % 1000);
+        ds_iheap_decrease_key(h, hd[i], &items[i]);
+        break;
+      case 1:
+        items[i].key += (int)(seed % 1000);
+        ds_iheap_increase_key(h, hd[i], &items[i]);
+        break;
+      default:
+        ds_iheap_remove(h, hd[i]);
+        live[i] = 0;
+        live_count --;
+        break;
+    }
+  }
+  ASSERT_EQ(ds_iheap_size(h), live_count, "size tracks removals");
+
+  int ok = 1, last = -2147483647 - 1;
+  size_t popped = 0;
+  item_t *it;
+  while ((it = ds_iheap_pop(h)) != NULL) {
+    if (it->key < last || !live[it->id]) ok = 0;
+    last = it->key;
+    popped ++;
+  }
+  ASSERT(ok, "pops sorted and only live elements");
+  ASSERT_EQ(popped, live_count, "every live element popped once");
+
+  ds_iheap_destroy(h, NULL);
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"iheap_basic", test_iheap_basic},
+    {"iheap_random_ops", test_iheap_random_ops},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
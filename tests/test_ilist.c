@@ -0,0 +1,198 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ds_common.h"
+#include "ds_ilist.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+typedef struct {
+  int id;
+  ds_ilist_link_t link;
+} job_t;
+
+static job_t *job_of(ds_ilist_link_t *l) {
+  return l ? DS_CONTAINER_OF(l, job_t, link) : NULL;
+}
+
+static int g_visits = 0;
+static void count_visit(ds_ilist_link_t *l) {
+  ASSERT(!ds_ilist_link_is_linked(l), "clear resets the link before the visit");
+  g_visits ++;
+}
+
+/* Check the list holds jobs[ids[0..n)] in order, walking both ways */
+static void assert_ilist_ids(ds_ilist_t *list, const int *ids, size_t n, const char *msg) {
+  ASSERT_EQ(ds_ilist_size(list), n, msg);
+
+  ds_ilist_link_t *l = ds_ilist_front(list);
+  for (size_t i = 0; i < n; ++ i) {
+    ASSERT_NOT_NULL(l, msg);
+    ASSERT_EQ(job_of(l)->id, ids[i], msg);
+    l = ds_ilist_next(list, l);
+  }
+  ASSERT_NULL(l, msg);
+
+  l = ds_ilist_back(list);
+  for (size_t i = n; i-- > 0; ) {
+    ASSERT_NOT_NULL(l, msg);
+    ASSERT_EQ(job_of(l)->id, ids[i], msg);
+    l = ds_ilist_prev(list, l);
+  }
+  ASSERT_NULL(l, msg);
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_ilist_basic) {
+  ds_ilist_t list;
+  ds_ilist_init(&list);
+  ASSERT(ds_ilist_is_empty(&list), "new list is empty");
+  ASSERT_NULL(ds_ilist_front(&list), "front of empty list");
+  ASSERT_NULL(ds_ilist_pop_back(&list), "pop_back of empty list");
+
+  job_t jobs[6];
+  for (int i = 0; i < 6; ++ i) {
+    jobs[i].id = i;
+    ds_ilist_link_init(&jobs[i].link);
+  }
+
+  ASSERT_EQ(ds_ilist_push_back(&list, &jobs[1].link), DS_OK, "push_back 1");
+  ASSERT_EQ(ds_ilist_push_back(&list, &jobs[3].link), DS_OK, "push_back 3");
+  ASSERT_EQ(ds_ilist_push_front(&list, &jobs[0].link), DS_OK, "push_front 0");
+  ASSERT_EQ(ds_ilist_insert(&list, &jobs[3].link, &jobs[2].link), DS_OK, "insert 2 before 3");
+  ASSERT_EQ(ds_ilist_insert(&list, NULL, &jobs[4].link), DS_OK, "insert at end");
+  int e1[] = {0, 1, 2, 3, 4};
+  assert_ilist_ids(&list, e1, 5, "after inserts");
+
+  ASSERT_EQ(ds_ilist_push_back(&list, &jobs[2].link), DS_ERR_ARG, "linked link rejected");
+  ASSERT_EQ(ds_ilist_insert(&list, &jobs[5].link, &jobs[5].link), DS_ERR_ARG, "unlinked pos rejected");
+  ASSERT_EQ(ds_ilist_push_back(NULL, &jobs[5].link), DS_ERR_NULL, "NULL list rejected");
+
+  /* remove returns the successor */
+  ASSERT(job_of(ds_ilist_remove(&list, &jobs[2].link)) == &jobs[3], "remove middle -> next");
+  ASSERT(!ds_ilist_link_is_linked(&jobs[2].link), "removed link is unlinked");
+  ASSERT_NULL(ds_ilist_remove(&list, &jobs[4].link), "remove last -> NULL");
+  ASSERT(job_of(ds_ilist_pop_front(&list)) == &jobs[0], "pop_front");
+  int e2[] = {1, 3};
+  assert_ilist_ids(&list, e2, 2, "after removes");
+
+  /* a removed element can be reinserted right away */
+  ASSERT_EQ(ds_ilist_push_front(&list, &jobs[4].link), DS_OK, "reinsert");
+  int e3[] = {4, 1, 3};
+  assert_ilist_ids(&list, e3, 3, "after reinsert");
+
+  g_visits = 0;
+  ds_ilist_clear(&list, count_visit);
+  ASSERT_EQ(g_visits, 3, "clear visits every link");
+  ASSERT(ds_ilist_is_empty(&list), "empty after clear");
+  ASSERT_NULL(ds_ilist_front(&list), "no front after clear");
+}
+
+TEST_FUNC(test_ilist_heap_elements_two_lists) {
+  /* an element with two links can sit in two lists at once */
+  typedef struct {
+    int id;
+    ds_ilist_link_t all;
+    ds_ilist_link_t even;
+  } item_t;
+
+  ds_ilist_t all, even;
+  ds_ilist_init(&all);
+  ds_ilist_init(&even);
+
+  for (int i = 0; i < 100; ++ i) {
+    item_t *it = calloc(1, sizeof(item_t));   /* one allocation per element */
+    it->id = i;
+    ds_ilist_push_back(&all, &it->all);
+    if (i % 2 == 0) ds_ilist_push_front(&even, &it->even);
+  }
+  ASSERT_EQ(ds_ilist_size(&all), 100u, "all holds 100");
+  ASSERT_EQ(ds_ilist_size(&even), 50u, "even holds 50");
+
+  int expect = 98, ok = 1;
+  for (ds_ilist_link_t *l = ds_ilist_front(&even); l; l = ds_ilist_next(&even, l)) {
+    ok &= DS_CONTAINER_OF(l, item_t, even)->id == expect;
+    expect -= 2;
+  }
+  ASSERT(ok, "even list in reverse order via its own link");
+
+  /* drop the even ones from both lists, then free the rest */
+  ds_ilist_link_t *l;
+  while ((l = ds_ilist_pop_front(&even))) {
+    item_t *it = DS_CONTAINER_OF(l, item_t, even);
+    ds_ilist_remove(&all, &it->all);
+    free(it);
+  }
+  ASSERT_EQ(ds_ilist_size(&all), 50u, "odd ones left");
+
+  ok = 1;
+  expect = 1;
+  while ((l = ds_ilist_pop_front(&all))) {
+    item_t *it = DS_CONTAINER_OF(l, item_t, all);
+    ok &= it->id == expect;
+    expect += 2;
+    free(it);
+  }
+  ASSERT(ok, "odd ones in order");
+  ASSERT(ds_ilist_is_empty(&all), "all empty");
+}
+
+int main() {
+  test_case_t tests[] = {
+    {"ilist_basic", test_ilist_basic},
+    {"ilist_heap_elements_two_lists", test_ilist_heap_elements_two_lists},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -0,0 +1,205 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ds_common.h"
+#include "ds_itree.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+typedef struct {
+  int key;
+  ds_itree_link_t link;
+} item_t;
+
+static int key_of(const ds_itree_link_t *l) {
+  return DS_CONTAINER_OF(l, item_t, link)->key;
+}
+
+static int cmp_items(const ds_itree_link_t *a, const ds_itree_link_t *b) {
+  int x = key_of(a), y = key_of(b);
+  return (x > y) - (x < y);
+}
+
+static int cmp_key_item(const void *key, const ds_itree_link_t *l) {
+  int x = *(const int *)key, y = key_of(l);
+  return (x > y) - (x < y);
+}
+
+/* Black height of a subtree, or -1 if a red-black rule is broken */
+static int rb_check(const ds_itree_link_t *n, const ds_itree_link_t *parent) {
+  if (!n) return 1;
+  if (n->parent != parent) return -1;
+  if (n->color == 0 && ((n->left && n->left->color == 0) || (n->right && n->right->color == 0))) return -1;
+  if (n->left && cmp_items(n->left, n) >= 0) return -1;
+  if (n->right && cmp_items(n->right, n) <= 0) return -1;
+
+  int l = rb_check(n->left, n), r = rb_check(n->right, n);
+  if (l < 0 || r < 0 || l != r) return -1;
+  return l + (n->color != 0);
+}
+
+static size_t g_visits = 0;
+static void count_visit(ds_itree_link_t *l) {
+  (void)l;
+  g_visits ++;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_itree_basic) {
+  ds_itree_t tree;
+  ds_itree_init(&tree, cmp_items);
+  ASSERT(ds_itree_is_empty(&tree), "new tree is empty");
+  ASSERT_NULL(ds_itree_first(&tree), "first of empty tree");
+
+  item_t items[10];
+  for (int i = 0; i < 10; ++ i) {
+    items[i].key = (i * 7) % 10;    /* 0 7 4 1 8 5 2 9 6 3 */
+    ASSERT_EQ(ds_itree_insert(&tree, &items[i].link), DS_OK, "insert");
+  }
+  ASSERT_EQ(ds_itree_size(&tree), 10u, "size 10");
+  ASSERT(rb_check(tree.root, NULL) > 0, "red-black invariants hold");
+
+  item_t dup = { 4, {0} };
+  ASSERT_EQ(ds_itree_insert(&tree, &dup.link), DS_ERR_EXIST, "duplicate rejected");
+  ASSERT_EQ(ds_itree_insert(NULL, &dup.link), DS_ERR_NULL, "NULL tree rejected");
+
+  int k = 8;
+  ds_itree_link_t *l = ds_itree_find(&tree, &k, cmp_key_item);
+  ASSERT(l == &items[4].link, "find returns the embedded link");
+  k = 42;
+  ASSERT_NULL(ds_itree_find(&tree, &k, cmp_key_item), "missing key");
+  ASSERT_NULL(ds_itree_lower_bound(&tree, &k, cmp_key_item), "lower_bound past the end");
+  k = -5;
+  ASSERT(ds_itree_lower_bound(&tree, &k, cmp_key_item) == ds_itree_first(&tree), "lower_bound before the start");
+
+  /* in-order both ways */
+  int expect = 0, ok = 1;
+  for (l = ds_itree_first(&tree); l; l = ds_itree_next(l)) ok &= key_of(l) == expect ++;
+  ASSERT(ok && expect == 10, "forward in order");
+  expect = 9;
+  for (l = ds_itree_last(&tree); l; l = ds_itree_prev(l)) ok &= key_of(l) == expect --;
+  ASSERT(ok && expect == -1, "backward in order");
+
+  /* remove by link, no search */
+  ds_itree_remove(&tree, &items[0].link);   /* key 0 */
+  ds_itree_remove(&tree, &items[7].link);   /* key 9 */
+  ds_itree_remove(&tree, &items[2].link);   /* key 4 */
+  ASSERT_EQ(ds_itree_size(&tree), 7u, "size after removes");
+  ASSERT(rb_check(tree.root, NULL) > 0, "invariants after removes");
+  k = 4;
+  ASSERT(key_of(ds_itree_lower_bound(&tree, &k, cmp_key_item)) == 5, "lower_bound skips the removed key");
+  ASSERT_EQ(ds_itree_insert(&tree, &items[2].link), DS_OK, "removed link can be reinserted");
+
+  g_visits = 0;
+  ds_itree_clear(&tree, count_visit);
+  ASSERT_EQ(g_visits, 8u, "clear visits every link");
+  ASSERT(ds_itree_is_empty(&tree), "empty after clear");
+}
+
+TEST_FUNC(test_itree_random_ops) {
+  enum { N = 2000 };
+  item_t *items = calloc(N, sizeof(item_t));
+  bool in_tree[N] = {0};
+  ds_itree_t tree;
+  ds_itree_init(&tree, cmp_items);
+  for (int i = 0; i < N; ++ i) items[i].key = i;
+
+  unsigned seed = 2024;
+  size_t count = 0;
+  int ok = 1;
+  for (int step = 0; step < 20000; ++ step) {
+    seed = seed * 1103515245u + 12345u;
+    int i = (int)((seed >> 8) % N);
+    if (in_tree[i]) {
+      ds_itree_remove(&tree, &items[i].link);
+      in_tree[i] = false;
+      count --;
+    } else {
+      ok &= ds_itree_insert(&tree, &items[i].link) == DS_OK;
+      in_tree[i] = true;
+      count ++;
+    }
+    if (step % 1000 == 0) ok &= rb_check(tree.root, NULL) > 0;
+  }
+  ASSERT(ok, "inserts succeed and invariants hold throughout");
+  ASSERT_EQ(ds_itree_size(&tree), count, "size matches reference");
+
+  /* iteration matches the reference set, find agrees with membership */
+  ds_itree_link_t *l = ds_itree_first(&tree);
+  for (int i = 0; i < N; ++ i) {
+    if (!in_tree[i]) {
+      ok &= ds_itree_find(&tree, &i, cmp_key_item) == NULL;
+      continue;
+    }
+    ok &= l == &items[i].link;
+    ok &= ds_itree_find(&tree, &i, cmp_key_item) == &items[i].link;
+    l = ds_itree_next(l);
+  }
+  ASSERT(ok && l == NULL, "contents match reference");
+
+  g_visits = 0;
+  ds_itree_clear(&tree, count_visit);
+  ASSERT_EQ(g_visits, count, "clear visits every link");
+  free(items);
+}
+
+int main() {
+  test_case_t tests[] = {
+    {"itree_basic", test_itree_basic},
+    {"itree_random_ops", test_itree_random_ops},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -87,6 +87,40 @@ static void assert_list_equals(ds_list_t *list, const int *arr, size_t n, const
   ASSERT_NULL(it, "iterator reaches end after n steps");
 }
 
+/* Counting allocator: tracks live bytes so leaks and size mismatches show up. */
+typedef struct {
+  size_t live_bytes;
+  size_t allocs;
+  size_t frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  counting_ctx_t *c = ctx;
+  void *p = malloc(size);
+  if (p) { c->live_bytes += size; c->allocs ++; }
+  return p;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  counting_ctx_t *c = ctx;
+  void *p = realloc(ptr, new_size);
+  if (p) c->live_bytes = c->live_bytes - old_size + new_size;
+  return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+  counting_ctx_t *c = ctx;
+  if (!ptr) return;
+  c->live_bytes -= size;
+  c->frees ++;
+  free(ptr);
+}
+
+static ds_allocator_t counting_allocator(counting_ctx_t *ctx) {
+  ds_allocator_t a = { counting_alloc, counting_realloc, counting_free, ctx };
+  return a;
+}
+
 /* ===================== Tests ===================== */
 
 TEST_FUNC(test_list_create_destroy_basic) {
@@ -367,6 +401,190 @@ TEST_FUNC(test_list_pop_front_back_behavior) {
   ds_list_destroy(l, counted_free);
 }
 
+TEST_FUNC(test_list_pooled_behaves_like_list) {
+  ds_list_t *l = ds_list_create_pooled(4);
+  ASSERT_NOT_NULL(l, "create_pooled non-NULL");
+
+  for (int i = 0; i < 10; i++) ds_list_push_back(l, mk_int(i));
+  ds_list_push_front(l, mk_int(-1));
+  ASSERT_EQ(ds_list_size(l), 11u, "pooled size==11");
+
+  /* remove odd values, nodes go back to the pool */
+  int free_before = g_free_count;
+  ds_list_iter_t it = ds_list_iter_begin(l);
+  while (it) {
+    int v = int_val(ds_list_iter_get(it));
+    if (v % 2 != 0) it = ds_list_remove(l, it, counted_free);
+    else it = ds_list_iter_next(it);
+  }
+  ASSERT_EQ(g_free_count, free_before + 6, "removed 6 odd values (incl. -1)");
+  int exp[] = {0, 2, 4, 6, 8};
+  assert_list_equals(l, exp, 5, "pooled after removes");
+
+  /* clear with free_func, then reuse */
+  free_before = g_free_count;
+  ds_list_clear(l, counted_free);
+  ASSERT_EQ(g_free_count, free_before + 5, "pooled clear frees all data");
+  ASSERT(ds_list_is_empty(l), "pooled list empty after clear");
+
+  int a = 1, b = 2;
+  ds_list_push_back(l, &a);
+  ds_list_push_back(l, &b);
+  int exp2[] = {1, 2};
+  assert_list_equals(l, exp2, 2, "pooled reuse after clear");
+
+  /* destroy without free_func drops the slabs at once */
+  ds_list_destroy(l, NULL);
+  ASSERT(1, "pooled destroy(NULL) does not crash");
+}
+
+TEST_FUNC(test_list_custom_allocator) {
+  counting_ctx_t ctx = {0};
+  ds_allocator_t a = counting_allocator(&ctx);
+
+  ds_list_t *list = ds_list_create_ex(&a);
+  ASSERT_NOT_NULL(list, "create_ex with custom allocator returns non-NULL");
+  for (int i = 0; i < 20; ++ i) ds_list_push_back(list, mk_int(i));
+  ASSERT_EQ(ctx.allocs, 21, "one allocation for the list, one per node");
+  free(ds_list_pop_front(list));
+  ds_list_destroy(list, free);
+  ASSERT_EQ(ctx.live_bytes, 0, "plain list: every byte returned");
+  ASSERT_EQ(ctx.allocs, ctx.frees, "plain list: alloc/free calls balanced");
+
+  counting_ctx_t pctx = {0};
+  ds_allocator_t pa = counting_allocator(&pctx);
+  list = ds_list_create_pooled_ex(8, &pa);
+  ASSERT_NOT_NULL(list, "create_pooled_ex returns non-NULL");
+  for (int i = 0; i < 20; ++ i) ds_list_push_back(list, mk_int(i));
+  ASSERT_EQ(pctx.allocs, 5, "list + pool + three slabs of 8 nodes");
+  ds_list_destroy(list, free);
+  ASSERT_EQ(pctx.live_bytes, 0, "pooled list: every byte returned");
+}
+
+static int cmp_int(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+/* Compare by value / 10 only, so equal keys expose stability */
+static int cmp_tens(const void *a, const void *b) {
+  int x = *(const int *)a / 10, y = *(const int *)b / 10;
+  return (x > y) - (x < y);
+}
+
+/* Walk tail -> head and check the prev links mirror the next links */
+static void assert_list_backward(ds_list_t *list, const int *arr, size_t n, const char *msg) {
+  ds_list_iter_t it = ds_list_iter_tail(list);
+  for (size_t i = n; i-- > 0; ) {
+    ASSERT_NOT_NULL(it, msg);
+    ASSERT_EQ(int_val(ds_list_iter_get(it)), arr[i], msg);
+    it = ds_list_iter_prev(it);
+  }
+  ASSERT_NULL(it, msg);
+}
+
+TEST_FUNC(test_list_sort_stable) {
+  ds_list_t *l = ds_list_create();
+  ASSERT_EQ(ds_list_sort(NULL, cmp_tens), DS_ERR_NULL, "sort(NULL) rejected");
+  ASSERT_EQ(ds_list_sort(l, cmp_tens), DS_OK, "sort empty list");
+
+  /* tens digit is the key, ones digit the insertion order per key */
+  int in[] = {30, 10, 31, 0, 11, 20, 1, 32, 2, 33, 12};
+  int exp[] = {0, 1, 2, 10, 11, 12, 20, 30, 31, 32, 33};
+  for (size_t i = 0; i < 11; i++) ds_list_push_back(l, mk_int(in[i]));
+
+  ds_list_iter_t first = ds_list_iter_begin(l);
+  ASSERT_EQ(ds_list_sort(l, cmp_tens), DS_OK, "sort ok");
+  assert_list_equals(l, exp, 11, "sorted");
+  assert_list_backward(l, exp, 11, "sorted backward");
+  ASSERT_EQ(int_val(ds_list_iter_get(first)), 30, "iterator still points to its element");
+
+  /* a larger pseudo-random list */
+  ds_list_clear(l, free);
+  unsigned seed = 12345;
+  for (int i = 0; i < 1000; i++) {
+    seed = seed * 1103515245u + 12345u;
+    ds_list_push_back(l, mk_int((int)(seed >> 16) % 5000));
+  }
+  ASSERT_EQ(ds_list_sort(l, cmp_int), DS_OK, "sort 1000");
+  ASSERT_EQ(ds_list_size(l), 1000u, "size kept");
+  int prev = -1;
+  size_t n = 0;
+  for (ds_list_iter_t it = ds_list_iter_begin(l); it; it = ds_list_iter_next(it), n++) {
+    int v = int_val(ds_list_iter_get(it));
+    ASSERT(v >= prev, "non-decreasing");
+    prev = v;
+  }
+  ASSERT_EQ(n, 1000u, "forward walk sees every node");
+  ASSERT_NULL(ds_list_iter_next(ds_list_iter_tail(l)), "tail is last");
+
+  ds_list_destroy(l, free);
+}
+
+TEST_FUNC(test_list_splice_merge) {
+  counting_ctx_t ctx = {0};
+  ds_allocator_t a = counting_allocator(&ctx);
+  ds_list_t *x = ds_list_create_ex(&a);
+  ds_list_t *y = ds_list_create_ex(&a);
+  for (int i = 0; i < 5; i++) ds_list_push_back(x, mk_int(i));        /* 0..4 */
+  for (int i = 10; i < 15; i++) ds_list_push_back(y, mk_int(i));      /* 10..14 */
+  size_t allocs = ctx.allocs;
+
+  /* move [11, 13) of y in front of 2 in x */
+  ds_list_iter_t y1 = ds_list_iter_next(ds_list_iter_begin(y));
+  ds_list_iter_t y3 = ds_list_iter_next(ds_list_iter_next(y1));
+  ds_list_iter_t x2 = ds_list_iter_next(ds_list_iter_next(ds_list_iter_begin(x)));
+  ASSERT_EQ(ds_list_splice(x, x2, y, y1, y3), DS_OK, "splice middle range");
+  int e1[] = {0, 1, 11, 12, 2, 3, 4};
+  int f1[] = {10, 13, 14};
+  assert_list_equals(x, e1, 7, "dst after splice");
+  assert_list_backward(x, e1, 7, "dst after splice backward");
+  assert_list_equals(y, f1, 3, "src after splice");
+  assert_list_backward(y, f1, 3, "src after splice backward");
+
+  /* move the whole of y to the end of x */
+  ASSERT_EQ(ds_list_splice(x, ds_list_iter_end(x), y, ds_list_iter_begin(y), ds_list_iter_end(y)),
+            DS_OK, "splice whole list");
+  int e2[] = {0, 1, 11, 12, 2, 3, 4, 10, 13, 14};
+  assert_list_equals(x, e2, 10, "dst after whole splice");
+  ASSERT(ds_list_is_empty(y), "src empty");
+  ASSERT_NULL(ds_list_iter_tail(y), "src tail reset");
+
+  /* within one list: move [10, End) to the front */
+  ds_list_iter_t x10 = ds_list_iter_prev(ds_list_iter_prev(ds_list_iter_tail(x)));
+  ASSERT_EQ(ds_list_splice(x, ds_list_iter_begin(x), x, x10, NULL), DS_OK, "splice within list");
+  int e3[] = {10, 13, 14, 0, 1, 11, 12, 2, 3, 4};
+  assert_list_equals(x, e3, 10, "after self splice");
+  assert_list_backward(x, e3, 10, "after self splice backward");
+  ASSERT_EQ(ctx.allocs, allocs, "splice never allocates");
+
+  /* pooled lists cannot hand nodes to another list */
+  ds_list_t *p = ds_list_create_pooled(4);
+  ds_list_push_back(p, mk_int(7));
+  ASSERT_EQ(ds_list_splice(x, NULL, p, ds_list_iter_begin(p), NULL), DS_ERR_ARG, "pooled src rejected");
+  ASSERT_EQ(ds_list_merge(x, p, cmp_int), DS_ERR_ARG, "pooled merge rejected");
+  ASSERT_EQ(ds_list_size(p), 1u, "pooled src untouched");
+  ds_list_destroy(p, free);
+
+  /* merge two sorted lists, dst first on ties */
+  ds_list_clear(x, free);
+  int xa[] = {0, 10, 20, 30};
+  int ya[] = {1, 11, 12, 40, 41};
+  for (size_t i = 0; i < 4; i++) ds_list_push_back(x, mk_int(xa[i]));
+  for (size_t i = 0; i < 5; i++) ds_list_push_back(y, mk_int(ya[i]));
+  allocs = ctx.allocs;
+  ASSERT_EQ(ds_list_merge(x, y, cmp_tens), DS_OK, "merge ok");
+  int e4[] = {0, 1, 10, 11, 12, 20, 30, 40, 41};
+  assert_list_equals(x, e4, 9, "merged");
+  assert_list_backward(x, e4, 9, "merged backward");
+  ASSERT(ds_list_is_empty(y), "merge empties src");
+  ASSERT_EQ(ctx.allocs, allocs, "merge never allocates");
+
+  ds_list_destroy(x, free);
+  ds_list_destroy(y, free);
+  ASSERT_EQ(ctx.live_bytes, 0, "every node freed exactly once");
+}
+
 int main() {
   test_case_t tests[] = {
     {"list_create_destroy_basic", test_list_create_destroy_basic},
@@ -379,6 +597,10 @@ int main() {
     {"list_clear_and_destroy_free_counts", test_list_clear_and_destroy_free_counts},
     {"list_set_replaces_and_frees_old", test_list_set_replaces_and_frees_old},
     {"list_pop_front_back_behavior", test_list_pop_front_back_behavior},
+    {"list_pooled_behaves_like_list", test_list_pooled_behaves_like_list},
+    {"list_custom_allocator", test_list_custom_allocator},
+    {"list_sort_stable", test_list_sort_stable},
+    {"list_splice_merge", test_list_splice_merge},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdalign.h>
+
+#include "ds_pool.h"
+#include "ds_common.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* Counting allocator: tracks live bytes so leaks and size mismatches show up. */
+typedef struct {
+  size_t live_bytes;
+  size_t allocs;
+  size_t frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  counting_ctx_t *c = ctx;
+  void *p = malloc(size);
+  if (p) { c->live_bytes += size; c->allocs ++; }
+  return p;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  counting_ctx_t *c = ctx;
+  void *p = realloc(ptr, new_size);
+  if (p) c->live_bytes = c->live_bytes - old_size + new_size;
+  return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+  counting_ctx_t *c = ctx;
+  if (!ptr) return;
+  c->live_bytes -= size;
+  c->frees ++;
+  free(ptr);
+}
+
+static ds_allocator_t counting_allocator(counting_ctx_t *ctx) {
+  ds_allocator_t a = { counting_alloc, counting_realloc, counting_free, ctx };
+  return a;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_pool_create_basic) {
+  ASSERT_NULL(ds_pool_create(0, 0), "create(block_size 0) returns NULL");
+  ASSERT_NULL(ds_pool_create(48, SIZE_MAX / 16), "create(slab size overflows) returns NULL");
+  ASSERT_NULL(ds_pool_create(SIZE_MAX, 1), "create(block size rounding overflows) returns NULL");
+  ASSERT_NULL(ds_pool_create(SIZE_MAX - 8, 0), "create(block size near SIZE_MAX) returns NULL");
+
+  ds_pool_t *p = ds_pool_create(3, 0);
+  ASSERT_NOT_NULL(p, "create(3, default) non-NULL");
+  ASSERT(ds_pool_block_size(p) >= sizeof(void *), "block size rounded up to hold a pointer");
+  ASSERT_EQ(ds_pool_block_size(p) % alignof(max_align_t), 0u, "block size is a multiple of max alignment");
+  ASSERT_EQ(ds_pool_in_use(p), 0u, "new pool in_use==0");
+  ASSERT_EQ(ds_pool_slab_count(p), 0u, "new pool owns no slab (lazy)");
+
+  ASSERT_EQ(ds_pool_in_use(NULL), 0u, "in_use(NULL)==0");
+  ASSERT_NULL(ds_pool_alloc(NULL), "alloc(NULL)==NULL");
+  ds_pool_free(NULL, NULL);
+  ds_pool_free(p, NULL);
+  ASSERT(1, "free(NULL) does not crash");
+
+  ds_pool_destroy(p);
+  ds_pool_destroy(NULL);
+  ASSERT(1, "destroy does not crash");
+}
+
+TEST_FUNC(test_pool_alloc_free_reuse) {
+  ds_pool_t *p = ds_pool_create(sizeof(int) * 4, 8);
+  ASSERT_NOT_NULL(p, "create");
+
+  /* allocate more than one slab worth, write a pattern into each block */
+  enum { N = 100 };
+  int *blocks[N];
+  int ok = 1;
+  for (int i = 0; i < N; i++) {
+    blocks[i] = ds_pool_alloc(p);
+    if (!blocks[i]) { ok = 0; break; }
+    for (int j = 0; j < 4; j++) blocks[i][j] = i * 4 + j;
+  }
+  ASSERT(ok, "all allocations succeed");
+  ASSERT_EQ(ds_pool_in_use(p), (size_t)N, "in_use==N");
+  ASSERT_EQ(ds_pool_slab_count(p), (size_t)((N + 7) / 8), "slab count == ceil(N / 8)");
+
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < 4; j++)
+      if (blocks[i][j] != i * 4 + j) ok = 0;
+  ASSERT(ok, "blocks do not overlap");
+
+  /* blocks freed last are handed out first */
+  ds_pool_free(p, blocks[10]);
+  ds_pool_free(p, blocks[20]);
+  ASSERT_EQ(ds_pool_in_use(p), (size_t)N - 2, "in_use drops on free");
+  ASSERT(ds_pool_alloc(p) == (void *)blocks[20], "freed block reused (LIFO) #1");
+  ASSERT(ds_pool_alloc(p) == (void *)blocks[10], "freed block reused (LIFO) #2");
+
+  ds_pool_destroy(p);
+}
+
+TEST_FUNC(test_pool_reset_keeps_slabs) {
+  ds_pool_t *p = ds_pool_create(16, 4);
+  ASSERT_NOT_NULL(p, "create");
+
+  void *first = NULL;
+  for (int i = 0; i < 10; i++) {
+    void *b = ds_pool_alloc(p);
+    if (i == 0) first = b;
+  }
+  size_t slabs = ds_pool_slab_count(p);
+  ASSERT_EQ(slabs, 3u, "10 blocks of 4 per slab => 3 slabs");
+
+  ds_pool_reset(p);
+  ASSERT_EQ(ds_pool_in_use(p), 0u, "in_use==0 after reset");
+  ASSERT_EQ(ds_pool_slab_count(p), slabs, "slabs kept after reset");
+  ASSERT(ds_pool_alloc(p) == first, "reset restarts at the first slab");
+
+  for (int i = 1; i < 12; i++) ds_pool_alloc(p);
+  ASSERT_EQ(ds_pool_slab_count(p), slabs, "refill reuses kept slabs");
+  ds_pool_alloc(p);
+  ASSERT_EQ(ds_pool_slab_count(p), slabs + 1, "a new slab is added only when all are full");
+
+  ds_pool_destroy(p);
+}
+
+TEST_FUNC(test_pool_custom_allocator) {
+  counting_ctx_t ctx = {0};
+  ds_allocator_t a = counting_allocator(&ctx);
+
+  ds_pool_t *pool = ds_pool_create_ex(24, 4, &a);
+  ASSERT_NOT_NULL(pool, "create_ex with custom allocator returns non-NULL");
+  ASSERT_EQ(ctx.allocs, 1, "no slab allocated up front");
+
+  for (int i = 0; i < 10; ++ i) ASSERT_NOT_NULL(ds_pool_alloc(pool), "alloc");
+  ASSERT_EQ(ds_pool_slab_count(pool), 3, "three slabs for ten blocks of four");
+  ASSERT_EQ(ctx.allocs, 4, "slabs come from the custom allocator");
+
+  ds_pool_destroy(pool);
+  ASSERT_EQ(ctx.live_bytes, 0, "slabs and pool returned with their sizes");
+  ASSERT_EQ(ctx.allocs, ctx.frees, "alloc/free calls balanced");
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"pool_create_basic", test_pool_create_basic},
+    {"pool_alloc_free_reuse", test_pool_alloc_free_reuse},
+    {"pool_reset_keeps_slabs", test_pool_reset_keeps_slabs},
+    {"pool_custom_allocator", test_pool_custom_allocator},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -4,6 +4,7 @@
 
 #include "ds_queue.h"
 #include "ds_common.h"
+#include "ds_queue_inline.h"
 
 /* ------------ Colored output ------------ */
 #define COLOR_GREEN "\033[32m"
@@ -194,6 +195,48 @@ TEST_FUNC(test_queue_bulk_stress) {
   ds_queue_destroy(q, counted_free);
 }
 
+TEST_FUNC(test_queue_shrink_to_fit) {
+  ds_queue_t *q = ds_queue_create(0);
+  for (int i = 0; i < 1000; ++ i) ds_queue_push(q, mk_int(i));
+  for (int i = 0; i < 990; ++ i) free(ds_queue_pop(q));
+  ASSERT(ds_queue_capacity(q) >= 1000, "default policy keeps the peak capacity");
+
+  ASSERT_EQ(ds_queue_shrink_to_fit(q), DS_OK, "shrink_to_fit ok");
+  ASSERT_EQ(ds_queue_capacity(q), 10, "capacity == size");
+  ASSERT_EQ(int_val(ds_queue_front(q)), 990, "front intact");
+
+  ds_growth_policy_t p = { 2.0, 0, 0.25, 2 };
+  ASSERT_EQ(ds_queue_set_growth_policy(q, &p), DS_OK, "policy forwarded to the deque");
+  for (int i = 0; i < 9; ++ i) free(ds_queue_pop(q));
+  ASSERT_EQ(ds_queue_capacity(q), 4, "automatic shrink through the queue");
+
+  ds_queue_destroy(q, free);
+}
+
+TEST_FUNC(test_queue_inline_fast_paths) {
+  ds_queue_t *q = ds_queue_create(4);
+
+  /* Keep the ring wrapping: push two, pop one, many times over */
+  int next_in = 0, next_out = 0, ok = 1;
+  for (int round = 0; round < 100; round++) {
+    ds_queue_push_fast(q, mk_int(next_in++));
+    ds_queue_push_fast(q, mk_int(next_in++));
+    if (*(int *)ds_queue_front_unsafe(q) != next_out) ok = 0;
+    int *p = ds_queue_pop_unsafe(q);
+    if (*p != next_out++) ok = 0;
+    free(p);
+  }
+  ASSERT(ok, "fast push / unsafe pop keep FIFO order");
+  ASSERT_EQ(ds_queue_size(q), 100u, "size after mixed ops");
+
+  /* Checked pop sees the same contents */
+  int *p = ds_queue_pop(q);
+  ASSERT_EQ(*p, next_out, "checked pop continues the sequence");
+  free(p);
+
+  ds_queue_destroy(q, free);
+}
+
 /* ===================== main ===================== */
 
 int main() {
@@ -204,6 +247,8 @@ int main() {
     {"queue_fifo_basic", test_queue_fifo_basic},
     {"queue_clear_frees", test_queue_clear_frees},
     {"queue_bulk_stress", test_queue_bulk_stress},
+    {"queue_shrink_to_fit", test_queue_shrink_to_fit},
+    {"queue_inline_fast_paths", test_queue_inline_fast_paths},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
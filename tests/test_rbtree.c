@@ -0,0 +1,425 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ds_rbtree.h"
+#include "ds_common.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+static int *mk_int(int v) {
+  int *p = (int *)malloc(sizeof(int));
+  if (!p) return NULL;
+  *p = v;
+  return p;
+}
+
+static int int_val(const void *p) {
+  return p ? *(const int *)p : 0;
+}
+
+/* compare for ints stored as int* */
+static int int_compare(const void *a, const void *b) {
+  int x = *(const int *)a;
+  int y = *(const int *)b;
+  if (x < y) return -1;
+  if (x > y) return 1;
+  return 0;
+}
+
+static int g_free_count = 0;
+static void counted_free(void *p) {
+  if (p) g_free_count++;
+  free(p);
+}
+
+/* collect inorder output */
+static int g_out[4096];
+static size_t g_out_n = 0;
+
+static void out_reset(void) {
+  g_out_n = 0;
+  memset(g_out, 0, sizeof(g_out));
+}
+
+static void visit_collect(void *data) {
+  if (g_out_n < sizeof(g_out)/sizeof(g_out[0])) {
+    g_out[g_out_n++] = *(int *)data;
+  }
+}
+
+static void assert_sorted_strict_increasing(const int *arr, size_t n, const char *msg) {
+  if (n == 0) { ASSERT(1, msg); return; }
+  for (size_t i = 1; i < n; i++) {
+    if (!(arr[i-1] < arr[i])) {
+      ASSERT(0, msg);
+      return;
+    }
+  }
+  ASSERT(1, msg);
+}
+
+/* height bound of a red-black tree: h <= 2 * log2(n + 1) */
+static size_t rb_height_bound(size_t n) {
+  size_t lg = 0;
+  while (((size_t)1 << lg) < n + 1) lg++;
+  return 2 * lg;
+}
+
+/* Counting allocator: tracks live bytes so leaks and size mismatches show up. */
+typedef struct {
+  size_t live_bytes;
+  size_t allocs;
+  size_t frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  counting_ctx_t *c = ctx;
+  void *p = malloc(size);
+  if (p) { c->live_bytes += size; c->allocs ++; }
+  return p;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  counting_ctx_t *c = ctx;
+  void *p = realloc(ptr, new_size);
+  if (p) c->live_bytes = c->live_bytes - old_size + new_size;
+  return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+  counting_ctx_t *c = ctx;
+  if (!ptr) return;
+  c->live_bytes -= size;
+  c->frees ++;
+  free(ptr);
+}
+
+static ds_allocator_t counting_allocator(counting_ctx_t *ctx) {
+  ds_allocator_t a = { counting_alloc, counting_realloc, counting_free, ctx };
+  return a;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_rbtree_create_basic) {
+  ds_rbtree_t *t = ds_rbtree_create(NULL);
+  ASSERT_NULL(t, "create(NULL compare) returns NULL");
+
+  t = ds_rbtree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create(compare) non-NULL");
+  ASSERT_EQ(ds_rbtree_size(t), 0u, "new tree size==0");
+  ASSERT_EQ(ds_rbtree_height(t), 0u, "new tree height==0");
+  ASSERT_NULL(ds_rbtree_min(t), "min(empty)==NULL");
+  ASSERT_NULL(ds_rbtree_max(t), "max(empty)==NULL");
+
+  int key = 1;
+  ASSERT_NULL(ds_rbtree_search(t, &key), "search(empty)==NULL");
+
+  ds_rbtree_destroy(t, NULL);
+}
+
+TEST_FUNC(test_rbtree_insert_search_min_max_inorder) {
+  ds_rbtree_t *t = ds_rbtree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  int vals[] = {5, 3, 7, 2, 4, 6, 8};
+  for (size_t i = 0; i < sizeof(vals)/sizeof(vals[0]); i++) {
+    ASSERT_EQ(ds_rbtree_insert(t, mk_int(vals[i])), DS_OK, "insert OK");
+  }
+  ASSERT_EQ(ds_rbtree_size(t), 7u, "size==7");
+
+  int k2 = 2, k8 = 8, k4 = 4, k10 = 10;
+  ASSERT_EQ(int_val(ds_rbtree_search(t, &k2)), 2, "search 2 found");
+  ASSERT_EQ(int_val(ds_rbtree_search(t, &k8)), 8, "search 8 found");
+  ASSERT_EQ(int_val(ds_rbtree_search(t, &k4)), 4, "search 4 found");
+  ASSERT_NULL(ds_rbtree_search(t, &k10), "search 10 not found");
+
+  ASSERT_EQ(int_val(ds_rbtree_min(t)), 2, "min==2");
+  ASSERT_EQ(int_val(ds_rbtree_max(t)), 8, "max==8");
+
+  out_reset();
+  ds_rbtree_traverse_inorder(t, visit_collect);
+  ASSERT_EQ(g_out_n, 7u, "inorder visits 7");
+  assert_sorted_strict_increasing(g_out, g_out_n, "inorder is strictly increasing");
+
+  ds_rbtree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_rbtree_insert_duplicate_key) {
+  ds_rbtree_t *t = ds_rbtree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  ASSERT_EQ(ds_rbtree_insert(t, mk_int(1)), DS_OK, "insert 1 OK");
+
+  int *dup = mk_int(1);
+  ASSERT_NOT_NULL(dup, "mk_int dup");
+  ASSERT_EQ(ds_rbtree_insert(t, dup), DS_ERR_EXIST, "insert duplicate => DS_ERR_EXIST");
+  /* rejected element stays owned by the caller */
+  free(dup);
+
+  ASSERT_EQ(ds_rbtree_size(t), 1u, "size still 1");
+  ASSERT_EQ(ds_rbtree_insert(NULL, &dup), DS_ERR_NULL, "insert(NULL tree) => DS_ERR_NULL");
+  ASSERT_EQ(ds_rbtree_insert(t, NULL), DS_ERR_ARG, "insert(NULL data) => DS_ERR_ARG");
+
+  ds_rbtree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_rbtree_sorted_input_stays_balanced) {
+  ds_rbtree_t *t = ds_rbtree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  /* ascending keys: the plain BST would degrade into a list here */
+  enum { N = 4096 };
+  int ok = 1;
+  for (int i = 0; i < N; i++) {
+    if (ds_rbtree_insert(t, mk_int(i)) != DS_OK) ok = 0;
+  }
+  ASSERT(ok, "ascending inserts all DS_OK");
+  ASSERT_EQ(ds_rbtree_size(t), (size_t)N, "size==N");
+  ASSERT(ds_rbtree_height(t) <= rb_height_bound(N), "height <= 2*log2(n+1) after ascending inserts");
+
+  /* remove the lower half, also in order */
+  for (int i = 0; i < N / 2; i++) {
+    if (ds_rbtree_remove(t, &i, counted_free) != DS_OK) ok = 0;
+  }
+  ASSERT(ok, "ascending removes all DS_OK");
+  ASSERT_EQ(ds_rbtree_size(t), (size_t)(N / 2), "size==N/2");
+  ASSERT(ds_rbtree_height(t) <= rb_height_bound(N / 2), "height bound holds after removals");
+  ASSERT_EQ(int_val(ds_rbtree_min(t)), N / 2, "min==N/2");
+  ASSERT_EQ(int_val(ds_rbtree_max(t)), N - 1, "max==N-1");
+
+  ds_rbtree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_rbtree_remove_errors) {
+  ds_rbtree_t *t = ds_rbtree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  int k = 1;
+  ASSERT_EQ(ds_rbtree_remove(NULL, &k, NULL), DS_ERR_NULL, "remove(NULL tree) => DS_ERR_NULL");
+  ASSERT_EQ(ds_rbtree_remove(t, &k, NULL), DS_ERR_NOT_FOUND, "remove(empty) => DS_ERR_NOT_FOUND");
+
+  ASSERT_EQ(ds_rbtree_insert(t, mk_int(1)), DS_OK, "insert 1");
+  ASSERT_EQ(ds_rbtree_remove(t, NULL, NULL), DS_ERR_ARG, "remove(NULL key) => DS_ERR_ARG when non-empty");
+
+  int k2 = 2;
+  ASSERT_EQ(ds_rbtree_remove(t, &k2, NULL), DS_ERR_NOT_FOUND, "remove(nonexistent) => DS_ERR_NOT_FOUND");
+
+  ds_rbtree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_rbtree_random_insert_delete_inorder_sorted) {
+  ds_rbtree_t *t = ds_rbtree_create(int_compare);
+  ASSERT_NOT_NULL(t, "create");
+
+  enum { MAXK = 2000 };
+  unsigned char present[MAXK];
+  memset(present, 0, sizeof(present));
+
+  uint32_t seed = 0x12345678u;
+  const int OPS = 20000;
+  int ok = 1;
+
+  for (int step = 0; step < OPS; step++) {
+    seed = seed * 1664525u + 1013904223u;
+    int key = (int)(seed % MAXK);
+
+    int op = (seed >> 16) & 1; /* 0 insert, 1 remove */
+    if (op == 0) {
+      if (!present[key]) {
+        if (ds_rbtree_insert(t, mk_int(key)) != DS_OK) ok = 0;
+        present[key] = 1;
+      } else {
+        int *dup = mk_int(key);
+        if (ds_rbtree_insert(t, dup) != DS_ERR_EXIST) ok = 0;
+        free(dup);
+      }
+    } else {
+      if (present[key]) {
+        int free_before = g_free_count;
+        if (ds_rbtree_remove(t, &key, counted_free) != DS_OK) ok = 0;
+        if (g_free_count != free_before + 1) ok = 0;
+        present[key] = 0;
+      } else {
+        if (ds_rbtree_remove(t, &key, NULL) != DS_ERR_NOT_FOUND) ok = 0;
+      }
+    }
+
+    if (step % 100 == 0) {
+      out_reset();
+      ds_rbtree_traverse_inorder(t, visit_collect);
+      assert_sorted_strict_increasing(g_out, g_out_n, "inorder strictly increasing (random)");
+      ASSERT(ds_rbtree_height(t) <= rb_height_bound(ds_rbtree_size(t)), "height bound (random)");
+    }
+  }
+  ASSERT(ok, "random ops return expected status codes");
+
+  size_t cnt = 0;
+  for (int i = 0; i < MAXK; i++) if (present[i]) cnt++;
+  ASSERT_EQ(ds_rbtree_size(t), cnt, "size matches reference count");
+
+  for (int i = 0; i < MAXK; i++) {
+    if (present[i] != (ds_rbtree_search(t, &i) != NULL)) ok = 0;
+  }
+  ASSERT(ok, "search agrees with reference set");
+
+  ds_rbtree_destroy(t, counted_free);
+}
+
+TEST_FUNC(test_rbtree_pooled_behaves_like_rbtree) {
+  ds_rbtree_t *t = ds_rbtree_create_pooled(int_compare, 16);
+  ASSERT_NOT_NULL(t, "create_pooled non-NULL");
+
+  enum { N = 1000 };
+  int ok = 1;
+  for (int i = 0; i < N; i++) {
+    if (ds_rbtree_insert(t, mk_int(i)) != DS_OK) ok = 0;
+  }
+  for (int i = 0; i < N; i += 3) {
+    if (ds_rbtree_remove(t, &i, counted_free) != DS_OK) ok = 0;
+  }
+  for (int i = 0; i < N; i += 3) {
+    if (ds_rbtree_insert(t, mk_int(i)) != DS_OK) ok = 0;
+  }
+  ASSERT(ok, "pooled insert/remove/reinsert DS_OK");
+  ASSERT_EQ(ds_rbtree_size(t), (size_t)N, "pooled size==N");
+  ASSERT(ds_rbtree_height(t) <= rb_height_bound(N), "pooled tree stays balanced");
+
+  int free_before = g_free_count;
+  ds_rbtree_destroy(t, counted_free);
+  ASSERT_EQ(g_free_count, free_before + N, "pooled destroy frees all data");
+}
+
+TEST_FUNC(test_rbtree_custom_allocator) {
+  for (int pooled = 0; pooled <= 1; ++ pooled) {
+    counting_ctx_t ctx = {0};
+    ds_allocator_t a = counting_allocator(&ctx);
+
+    ds_rbtree_t *t = pooled ? ds_rbtree_create_pooled_ex(int_compare, 16, &a)
+                            : ds_rbtree_create_ex(int_compare, &a);
+    ASSERT_NOT_NULL(t, "create with custom allocator returns non-NULL");
+
+    for (int i = 0; i < 100; ++ i) ds_rbtree_insert(t, mk_int(i));
+    for (int i = 0; i < 100; i += 3) {
+      int key = i;
+      ds_rbtree_remove(t, &key, free);
+    }
+    ASSERT(ctx.live_bytes > 0, "nodes accounted by the allocator");
+
+    ds_rbtree_destroy(t, free);
+    ASSERT_EQ(ctx.live_bytes, 0, "every byte returned with the size it was allocated with");
+    ASSERT_EQ(ctx.allocs, ctx.frees, "alloc/free calls balanced");
+  }
+}
+
+TEST_FUNC(test_rbtree_rank_select) {
+  ds_rbtree_t *t = ds_rbtree_create(int_compare);
+  ASSERT_NULL(ds_rbtree_select(t, 0), "select on empty is NULL");
+  int k0 = 5;
+  ASSERT_EQ(ds_rbtree_rank(t, &k0), 0u, "rank on empty is 0");
+
+  enum { MAXK = 500 };
+  unsigned char present[MAXK];
+  memset(present, 0, sizeof(present));
+
+  /* Mixed inserts/removes so subtree sizes go through every rotation */
+  uint32_t seed = 0xBADC0DEu;
+  int ok = 1;
+  for (int step = 0; step < 4000; step++) {
+    seed = seed * 1664525u + 1013904223u;
+    int key = (int)(seed % MAXK);
+    if ((seed >> 16) % 3 != 0) {
+      if (!present[key] && ds_rbtree_insert(t, mk_int(key)) == DS_OK) present[key] = 1;
+    } else if (present[key]) {
+      ds_rbtree_remove(t, &key, free);
+      present[key] = 0;
+    }
+
+    if (step % 50 == 0) {
+      size_t below = 0, k = 0;
+      for (int i = 0; i < MAXK; i++) {
+        if (ds_rbtree_rank(t, &i) != below) ok = 0;
+        if (present[i]) {
+          if (int_val(ds_rbtree_select(t, k)) != i) ok = 0;
+          k++;
+          below++;
+        }
+      }
+      if (ds_rbtree_select(t, k) != NULL) ok = 0;
+    }
+  }
+  ASSERT(ok, "rank/select agree with the reference set throughout");
+
+  size_t n = ds_rbtree_size(t);
+  if (n > 0) {
+    void *median = ds_rbtree_select(t, n / 2);
+    ASSERT_EQ(ds_rbtree_rank(t, median), n / 2, "rank(select(k)) == k");
+  }
+
+  ds_rbtree_destroy(t, free);
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"rbtree_create_basic", test_rbtree_create_basic},
+    {"rbtree_insert_search_min_max_inorder", test_rbtree_insert_search_min_max_inorder},
+    {"rbtree_insert_duplicate_key", test_rbtree_insert_duplicate_key},
+    {"rbtree_sorted_input_stays_balanced", test_rbtree_sorted_input_stays_balanced},
+    {"rbtree_remove_errors", test_rbtree_remove_errors},
+    {"rbtree_random_insert_delete_inorder_sorted", test_rbtree_random_insert_delete_inorder_sorted},
+    {"rbtree_pooled_behaves_like_rbtree", test_rbtree_pooled_behaves_like_rbtree},
+    {"rbtree_custom_allocator", test_rbtree_custom_allocator},
+    {"rbtree_rank_select", test_rbtree_rank_select},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -0,0 +1,281 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sched.h>
+
+#include "ds_common.h"
+#include "ds_ring.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+static int *mk_int(int v) {
+  int *p = (int *)malloc(sizeof(int));
+  if (!p) return NULL;
+  *p = v;
+  return p;
+}
+
+static int g_free_count = 0;
+
+static void counted_free(void *p) {
+  if (p) g_free_count++;
+  free(p);
+}
+
+/* Values are encoded in the pointer itself so threads never allocate. */
+#define TAG(v)   ((void *)(uintptr_t)((v) + 1))
+#define UNTAG(p) ((size_t)(uintptr_t)(p) - 1)
+
+#define SPSC_ITEMS   200000
+#define MPMC_THREADS 4
+#define MPMC_ITEMS   50000    // Per producer
+
+static void *spsc_producer(void *arg) {
+  ds_spsc_ring_t *ring = arg;
+  size_t i = 0;
+  void *batch[7];
+  while (i < SPSC_ITEMS) {
+    // Alternate single and batch pushes
+    if (i % 2 == 0) {
+      if (ds_spsc_ring_try_push(ring, TAG(i)) == DS_OK) i ++;
+      else sched_yield();
+    } else {
+      size_t k = 0;
+      while (k < 7 && i + k < SPSC_ITEMS) { batch[k] = TAG(i + k); k ++; }
+      size_t n = ds_spsc_ring_try_push_batch(ring, batch, k);
+      if (n == 0) sched_yield();
+      i += n;
+    }
+  }
+  return NULL;
+}
+
+typedef struct {
+  ds_mpmc_ring_t *ring;
+  size_t id;
+  unsigned char *seen;        // Consumers mark every value they pop
+  atomic_size_t *consumed;
+} mpmc_arg_t;
+
+static void *mpmc_producer(void *p) {
+  mpmc_arg_t *a = p;
+  size_t base = a->id * MPMC_ITEMS;
+  size_t i = 0;
+  void *batch[5];
+  while (i < MPMC_ITEMS) {
+    if (i % 3 == 0) {
+      if (ds_mpmc_ring_try_push(a->ring, TAG(base + i)) == DS_OK) i ++;
+      else sched_yield();
+    } else {
+      size_t k = 0;
+      while (k < 5 && i + k < MPMC_ITEMS) { batch[k] = TAG(base + i + k); k ++; }
+      size_t n = ds_mpmc_ring_try_push_batch(a->ring, batch, k);
+      if (n == 0) sched_yield();
+      i += n;
+    }
+  }
+  return NULL;
+}
+
+static void *mpmc_consumer(void *p) {
+  mpmc_arg_t *a = p;
+  const size_t total = MPMC_THREADS * MPMC_ITEMS;
+  void *out[6];
+  while (atomic_load(a->consumed) < total) {
+    size_t n = ds_mpmc_ring_try_pop_batch(a->ring, out, 6);
+    for (size_t i = 0; i < n; ++ i) a->seen[UNTAG(out[i])] ++;
+    if (n) atomic_fetch_add(a->consumed, n);
+    else sched_yield();
+  }
+  return NULL;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_spsc_basic) {
+  ds_spsc_ring_t *ring = ds_spsc_ring_create(5);
+  ASSERT_NOT_NULL(ring, "create returns non-NULL");
+  ASSERT_EQ(ds_spsc_ring_capacity(ring), 8, "capacity rounded up to a power of two");
+  ASSERT_NULL(ds_spsc_ring_try_pop(ring), "pop on empty -> NULL");
+  ASSERT_EQ(ds_spsc_ring_try_push(ring, NULL), DS_ERR_ARG, "push(NULL element) -> DS_ERR_ARG");
+  ASSERT_EQ(ds_spsc_ring_try_push(NULL, ring), DS_ERR_NULL, "push(NULL ring) -> DS_ERR_NULL");
+
+  for (int i = 0; i < 8; ++ i) ASSERT_EQ(ds_spsc_ring_try_push(ring, mk_int(i)), DS_OK, "push within capacity");
+  int *extra = mk_int(8);
+  ASSERT_EQ(ds_spsc_ring_try_push(ring, extra), DS_ERR_FULL, "push on full -> DS_ERR_FULL");
+  ASSERT_EQ(ds_spsc_ring_size(ring), 8, "size == capacity");
+
+  int ok = 1;
+  for (int i = 0; i < 5; ++ i) {
+    int *v = ds_spsc_ring_try_pop(ring);
+    if (!v || *v != i) ok = 0;
+    free(v);
+  }
+  ASSERT(ok, "FIFO order");
+
+  // Wrap around with batches
+  void *batch[6];
+  for (int i = 0; i < 6; ++ i) batch[i] = mk_int(100 + i);
+  ASSERT_EQ(ds_spsc_ring_try_push_batch(ring, batch, 6), 5, "batch push limited by free slots");
+  free(batch[5]);
+  void *out[16];
+  ASSERT_EQ(ds_spsc_ring_try_pop_batch(ring, out, 16), 8, "batch pop drains everything");
+  ok = *(int *)out[0] == 5 && *(int *)out[2] == 7 && *(int *)out[3] == 100 && *(int *)out[7] == 104;
+  ASSERT(ok, "batch pop keeps FIFO order across the wrap");
+  for (int i = 0; i < 8; ++ i) free(out[i]);
+
+  ds_spsc_ring_try_push(ring, extra);
+  g_free_count = 0;
+  ds_spsc_ring_destroy(ring, counted_free);
+  ASSERT_EQ(g_free_count, 1, "destroy frees queued elements");
+}
+
+TEST_FUNC(test_spsc_two_threads) {
+  ds_spsc_ring_t *ring = ds_spsc_ring_create(64);
+  pthread_t producer;
+  pthread_create(&producer, NULL, spsc_producer, ring);
+
+  size_t expected = 0;
+  int ok = 1;
+  void *out[9];
+  while (expected < SPSC_ITEMS) {
+    size_t n = ds_spsc_ring_try_pop_batch(ring, out, 9);
+    for (size_t i = 0; i < n; ++ i) {
+      if (UNTAG(out[i]) != expected) ok = 0;
+      expected ++;
+    }
+    void *one = ds_spsc_ring_try_pop(ring);
+    if (one) {
+      if (UNTAG(one) != expected) ok = 0;
+      expected ++;
+    } else if (n == 0) {
+      sched_yield();
+    }
+  }
+  pthread_join(producer, NULL);
+
+  ASSERT(ok, "consumer sees every element exactly once, in order");
+  ASSERT_EQ(ds_spsc_ring_size(ring), 0, "ring drained");
+  ds_spsc_ring_destroy(ring, NULL);
+}
+
+TEST_FUNC(test_mpmc_basic) {
+  ds_mpmc_ring_t *ring = ds_mpmc_ring_create(3);
+  ASSERT_NOT_NULL(ring, "create returns non-NULL");
+  ASSERT_EQ(ds_mpmc_ring_capacity(ring), 4, "capacity rounded up to a power of two");
+  ASSERT_NULL(ds_mpmc_ring_try_pop(ring), "pop on empty -> NULL");
+  ASSERT_EQ(ds_mpmc_ring_try_push(ring, NULL), DS_ERR_ARG, "push(NULL element) -> DS_ERR_ARG");
+
+  for (int i = 0; i < 4; ++ i) ds_mpmc_ring_try_push(ring, mk_int(i));
+  int *extra = mk_int(4);
+  ASSERT_EQ(ds_mpmc_ring_try_push(ring, extra), DS_ERR_FULL, "push on full -> DS_ERR_FULL");
+  ASSERT_EQ(ds_mpmc_ring_size(ring), 4, "size == capacity");
+
+  void *out[8];
+  ASSERT_EQ(ds_mpmc_ring_try_pop_batch(ring, out, 3), 3, "batch pop");
+  ASSERT(*(int *)out[0] == 0 && *(int *)out[2] == 2, "batch pop FIFO order");
+  for (int i = 0; i < 3; ++ i) free(out[i]);
+
+  void *batch[4] = { extra, mk_int(5), mk_int(6), mk_int(7) };
+  ASSERT_EQ(ds_mpmc_ring_try_push_batch(ring, batch, 4), 3, "batch push limited by free slots");
+  free(batch[3]);
+
+  g_free_count = 0;
+  ds_mpmc_ring_destroy(ring, counted_free);
+  ASSERT_EQ(g_free_count, 4, "destroy frees queued elements");
+}
+
+TEST_FUNC(test_mpmc_many_threads) {
+  ds_mpmc_ring_t *ring = ds_mpmc_ring_create(128);
+  const size_t total = MPMC_THREADS * MPMC_ITEMS;
+  unsigned char *seen = calloc(total, 1);
+  atomic_size_t consumed;
+  atomic_init(&consumed, 0);
+
+  pthread_t producers[MPMC_THREADS], consumers[MPMC_THREADS];
+  mpmc_arg_t pargs[MPMC_THREADS], cargs[MPMC_THREADS];
+  for (size_t i = 0; i < MPMC_THREADS; ++ i) {
+    pargs[i] = (mpmc_arg_t){ ring, i, seen, &consumed };
+    cargs[i] = (mpmc_arg_t){ ring, i, seen, &consumed };
+    pthread_create(&producers[i], NULL, mpmc_producer, &pargs[i]);
+    pthread_create(&consumers[i], NULL, mpmc_consumer, &cargs[i]);
+  }
+  for (size_t i = 0; i < MPMC_THREADS; ++ i) {
+    pthread_join(producers[i], NULL);
+    pthread_join(consumers[i], NULL);
+  }
+
+  int ok = 1;
+  for (size_t i = 0; i < total; ++ i) if (seen[i] != 1) { ok = 0; break; }
+  ASSERT(ok, "every element popped exactly once");
+  ASSERT_EQ(ds_mpmc_ring_size(ring), 0, "ring drained");
+
+  free(seen);
+  ds_mpmc_ring_destroy(ring, NULL);
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"spsc_basic", test_spsc_basic},
+    {"spsc_two_threads", test_spsc_two_threads},
+    {"mpmc_basic", test_mpmc_basic},
+    {"mpmc_many_threads", test_mpmc_many_threads},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -0,0 +1,206 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ds_common.h"
+#include "ds_simd.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+static uint64_t g_rng = 88172645463325252ULL;
+static uint64_t rng(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+/* Reference results, computed with plain loops */
+static size_t ref_find64(const int64_t *a, size_t n, int64_t v) {
+  for (size_t i = 0; i < n; ++ i) if (a[i] == v) return i;
+  return SIZE_MAX;
+}
+
+static size_t ref_count_less64(const int64_t *a, size_t n, int64_t v) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++ i) c += a[i] < v;
+  return c;
+}
+
+#define MAXN 300
+
+/* Run every kernel over sizes 0..MAXN at an odd offset (unaligned) and
+ * compare against the reference loops. */
+static int check_kernels(void) {
+  static int32_t a32[MAXN + 2];
+  static int64_t a64[MAXN + 2];
+  static int64_t s64[MAXN];
+  static int32_t s32[MAXN];
+  int ok = 1;
+
+  for (size_t n = 0; n <= MAXN; ++ n) {
+    int32_t *p32 = a32 + 1;
+    int64_t *p64 = a64 + 1;
+    for (size_t i = 0; i < n; ++ i) {
+      /* small value range so there are duplicates and misses */
+      p32[i] = (int32_t)(rng() % 64) - 32;
+      p64[i] = (int64_t)(rng() % 64) - 32 + ((int64_t)1 << 40) * (int64_t)(rng() % 3);
+    }
+
+    for (int32_t v = -34; v <= 34; v += 3) {
+      size_t f = SIZE_MAX, c = 0;
+      for (size_t i = 0; i < n; ++ i) {
+        if (p32[i] == v) { if (f == SIZE_MAX) f = i; c ++; }
+      }
+      ok &= ds_simd_find_i32(p32, n, v) == f;
+      ok &= ds_simd_count_i32(p32, n, v) == c;
+    }
+    for (size_t k = 0; k < 8 && n > 0; ++ k) {
+      int64_t v = p64[rng() % n];
+      size_t c = 0;
+      for (size_t i = 0; i < n; ++ i) c += p64[i] == v;
+      ok &= ds_simd_find_i64(p64, n, v) == ref_find64(p64, n, v);
+      ok &= ds_simd_count_i64(p64, n, v) == c;
+    }
+    ok &= ds_simd_find_i64(p64, n, INT64_MIN) == SIZE_MAX;
+
+    if (n > 0) {
+      int32_t lo32 = p32[0], hi32 = p32[0], mn32 = 0, mx32 = 0;
+      int64_t lo64 = p64[0], hi64 = p64[0], mn64 = 0, mx64 = 0;
+      for (size_t i = 1; i < n; ++ i) {
+        if (p32[i] < lo32) lo32 = p32[i];
+        if (p32[i] > hi32) hi32 = p32[i];
+        if (p64[i] < lo64) lo64 = p64[i];
+        if (p64[i] > hi64) hi64 = p64[i];
+      }
+      ok &= ds_simd_minmax_i32(p32, n, &mn32, &mx32) == DS_OK && mn32 == lo32 && mx32 == hi32;
+      ok &= ds_simd_minmax_i64(p64, n, &mn64, &mx64) == DS_OK && mn64 == lo64 && mx64 == hi64;
+    } else {
+      ok &= ds_simd_minmax_i32(p32, 0, NULL, NULL) == DS_ERR_EMPTY;
+    }
+
+    /* sorted arrays with runs of duplicates */
+    int64_t x = -100;
+    for (size_t i = 0; i < n; ++ i) {
+      x += (int64_t)(rng() % 3);
+      s64[i] = x;
+      s32[i] = (int32_t)x;
+    }
+    for (int64_t v = -102; v <= x + 2; ++ v) {
+      size_t lb = ref_count_less64(s64, n, v);
+      ok &= ds_simd_lower_bound_i64(s64, n, v) == lb;
+      ok &= ds_simd_lower_bound_i32(s32, n, (int32_t)v) == lb;
+    }
+
+    /* fill must not write outside [0, n) */
+    a32[0] = 7;
+    p32[n] = 7;
+    ds_simd_fill_i32(p32, n, -5);
+    ok &= ds_simd_count_i32(p32, n, -5) == n && a32[0] == 7 && p32[n] == 7;
+    ds_simd_fill_i64(p64, n, 9);
+    ok &= ds_simd_count_i64(p64, n, 9) == n;
+  }
+
+  return ok;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_simd_kernels_every_isa) {
+  ds_simd_isa_t original = ds_simd_active_isa();
+  ASSERT(ds_simd_isa_supported(DS_SIMD_SCALAR), "scalar is always supported");
+  ASSERT(ds_simd_isa_supported(original), "the dispatcher picked a supported ISA");
+  printf("  active isa: %s\n", ds_simd_isa_name(original));
+
+  ds_simd_isa_t isas[] = { DS_SIMD_SCALAR, DS_SIMD_SSE2, DS_SIMD_AVX2, DS_SIMD_NEON };
+  for (size_t k = 0; k < 4; ++ k) {
+    if (!ds_simd_isa_supported(isas[k])) {
+      ASSERT_EQ(ds_simd_force_isa(isas[k]), DS_ERR_ARG, "unsupported ISA rejected");
+      continue;
+    }
+    ASSERT_EQ(ds_simd_force_isa(isas[k]), DS_OK, "force ISA");
+    ASSERT_EQ(ds_simd_active_isa(), isas[k], "forced ISA is active");
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "%s kernels match the reference", ds_simd_isa_name(isas[k]));
+    ASSERT(check_kernels(), msg);
+  }
+
+  ds_simd_force_isa(original);
+}
+
+TEST_FUNC(test_simd_ptr_and_null_inputs) {
+  int objs[5] = {0};
+  void *ptrs[40];
+  for (int i = 0; i < 40; ++ i) ptrs[i] = &objs[i % 4];
+  ptrs[37] = &objs[4];
+
+  ASSERT_EQ(ds_simd_find_ptr(ptrs, 40, &objs[4]), 37u, "find_ptr");
+  ASSERT_EQ(ds_simd_find_ptr(ptrs, 40, &objs[2]), 2u, "find_ptr first occurrence");
+  ASSERT_EQ(ds_simd_count_ptr(ptrs, 40, &objs[1]), 9u, "count_ptr (slot 37 was replaced)");
+  ASSERT_EQ(ds_simd_find_ptr(ptrs, 40, NULL), SIZE_MAX, "find_ptr miss");
+
+  ASSERT_EQ(ds_simd_find_i32(NULL, 10, 0), SIZE_MAX, "NULL array: not found");
+  ASSERT_EQ(ds_simd_count_i64(NULL, 10, 0), 0u, "NULL array: zero count");
+  ASSERT_EQ(ds_simd_lower_bound_i32(NULL, 10, 0), 0u, "NULL array: lower_bound 0");
+  ASSERT_EQ(ds_simd_minmax_i64(NULL, 10, NULL, NULL), DS_ERR_NULL, "NULL array: minmax rejected");
+}
+
+int main() {
+  test_case_t tests[] = {
+    {"simd_kernels_every_isa", test_simd_kernels_every_isa},
+    {"simd_ptr_and_null_inputs", test_simd_ptr_and_null_inputs},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
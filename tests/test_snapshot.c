@@ -0,0 +1,392 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "ds_bst.h"
+#include "ds_common.h"
+#include "ds_heap.h"
+#include "ds_snapshot.h"
+#include "ds_vec.h"
+#include "ds_vector.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+typedef struct {
+  int32_t id;
+  int32_t weight;
+} rec_t;
+
+static int cmp_rec(const void *a, const void *b) {
+  int32_t x = ((const rec_t *)a)->id, y = ((const rec_t *)b)->id;
+  return (x > y) - (x < y);
+}
+
+static int cmp_int(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static int *mk_int(int v) {
+  int *p = (int *)malloc(sizeof(int));
+  if (!p) return NULL;
+  *p = v;
+  return p;
+}
+
+static ds_status_t encode_int(ds_snapshot_writer_t *w, const void *element, void *ctx) {
+  (void)ctx;
+  return ds_snapshot_write(w, element, sizeof(int));
+}
+
+static void *decode_int(const void *bytes, size_t n, void *ctx) {
+  (void)ctx;
+  if (n != sizeof(int)) return NULL;
+  int v;
+  memcpy(&v, bytes, sizeof(v));
+  return mk_int(v);
+}
+
+static int g_decode_budget;
+
+static void *decode_int_limited(const void *bytes, size_t n, void *ctx) {
+  if (g_decode_budget-- <= 0) return NULL;
+  return decode_int(bytes, n, ctx);
+}
+
+static int eytzinger_inorder_ok(ds_span_t span, size_t k, int *next_id) {
+  if (k >= span.size) return 1;
+  if (!eytzinger_inorder_ok(span, 2 * k + 1, next_id)) return 0;
+  if (((const rec_t *)ds_span_at(span, k))->id != *next_id) return 0;
+  *next_id += 2;
+  return eytzinger_inorder_ok(span, 2 * k + 2, next_id);
+}
+
+static void tmp_path(char *buf, size_t n) {
+  snprintf(buf, n, "/tmp/ds_snapshot_XXXXXX");
+  int fd = mkstemp(buf);
+  if (fd >= 0) close(fd);
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_snapshot_null_and_missing) {
+  ds_vec_t *v = ds_vec_create(sizeof(int), 0);
+  ds_vector_t *out = NULL;
+  ASSERT_EQ(ds_snapshot_save_vec(NULL, v), DS_ERR_NULL, "save_vec NULL path");
+  ASSERT_EQ(ds_snapshot_save_tree("/tmp/x", v, NULL), DS_ERR_NULL, "save_tree NULL compare");
+  ASSERT_EQ(ds_snapshot_save_vec("/nonexistent-dir/x", v), DS_ERR_IO, "unwritable path is DS_ERR_IO");
+  ASSERT_NULL(ds_snapshot_map("/nonexistent-dir/x"), "map missing file");
+  ASSERT_EQ(ds_snapshot_load_vector("/nonexistent-dir/x", decode_int, NULL, free, NULL, &out),
+            DS_ERR_IO, "load missing file");
+  ASSERT_EQ(ds_snapshot_load_vector("/tmp/x", NULL, NULL, free, NULL, &out), DS_ERR_NULL, "load NULL decode");
+  ASSERT_EQ(ds_snapshot_kind(NULL), 0, "kind of NULL");
+  ASSERT_EQ(ds_snapshot_span(NULL).size, 0, "span of NULL");
+  ASSERT_NULL(ds_snapshot_find(NULL, &v, cmp_int), "find on NULL");
+  ds_snapshot_unmap(NULL);
+  ds_vec_destroy(v, NULL);
+}
+
+TEST_FUNC(test_snapshot_flat_array) {
+  char path[64];
+  tmp_path(path, sizeof(path));
+
+  ds_vec_t *v = ds_vec_create(sizeof(rec_t), 0);
+  for (int i = 0; i < 1000; ++ i) {
+    rec_t r = { i, i * 3 };
+    ds_vec_push_back(v, &r);
+  }
+  ASSERT_EQ(ds_snapshot_save_vec(path, v), DS_OK, "save array");
+
+  ds_snapshot_t *s = ds_snapshot_map(path);
+  ASSERT_NOT_NULL(s, "map array");
+  ASSERT_EQ(ds_snapshot_kind(s), DS_SNAPSHOT_ARRAY, "kind is array");
+  ds_span_t span = ds_snapshot_span(s);
+  ASSERT_EQ(span.size, 1000, "mapped size");
+  ASSERT_EQ(span.elem_size, sizeof(rec_t), "mapped elem size");
+  ASSERT_EQ((uintptr_t)span.data % 64, 0, "payload is 64-byte aligned");
+  ASSERT(memcmp(span.data, ds_vec_data(v), ds_span_bytes(span)) == 0, "mapped bytes equal vector bytes");
+  rec_t key = { 5, 0 };
+  ASSERT_NULL(ds_snapshot_find(s, &key, cmp_rec), "find needs a tree snapshot");
+
+  ds_vec_t *copy = ds_snapshot_to_vec(s, NULL);
+  ASSERT_NOT_NULL(copy, "to_vec");
+  ASSERT_EQ(ds_vec_size(copy), 1000, "copied size");
+  ASSERT_EQ(((rec_t *)ds_vec_get(copy, 999))->weight, 2997, "copied element");
+  ds_snapshot_unmap(s);
+
+  // The copy outlives the mapping and is writable
+  rec_t r = { -1, -1 };
+  ASSERT_EQ(ds_vec_set(copy, 0, &r, NULL), DS_OK, "copy is writable");
+
+  ds_vec_destroy(copy, NULL);
+  ds_vec_destroy(v, NULL);
+  unlink(path);
+}
+
+TEST_FUNC(test_snapshot_flat_tree) {
+  char path[64];
+  tmp_path(path, sizeof(path));
+
+  // Even ids 0..2*(n-1), shuffled
+  const int n = 777;
+  ds_vec_t *v = ds_vec_create(sizeof(rec_t), n);
+  uint32_t seed = 12345;
+  for (int i = 0; i < n; ++ i) {
+    rec_t r = { 2 * i, i };
+    ds_vec_push_back(v, &r);
+  }
+  for (int i = n - 1; i > 0; -- i) {
+    seed = seed * 1664525u + 1013904223u;
+    size_t j = seed % (uint32_t)(i + 1);
+    rec_t a = *(rec_t *)ds_vec_get(v, (size_t)i), b = *(rec_t *)ds_vec_get(v, j);
+    ds_vec_set(v, (size_t)i, &b, NULL);
+    ds_vec_set(v, j, &a, NULL);
+  }
+  rec_t first = *(rec_t *)ds_vec_get(v, 0);
+
+  ASSERT_EQ(ds_snapshot_save_tree(path, v, cmp_rec), DS_OK, "save tree");
+  ASSERT_EQ(((rec_t *)ds_vec_get(v, 0))->id, first.id, "source vector untouched");
+
+  ds_snapshot_t *s = ds_snapshot_map(path);
+  ASSERT_NOT_NULL(s, "map tree");
+  ASSERT_EQ(ds_snapshot_kind(s), DS_SNAPSHOT_TREE, "kind is tree");
+
+  int ok = 1;
+  for (int i = 0; i < n; ++ i) {
+    rec_t key = { 2 * i, 0 };
+    const rec_t *hit = ds_snapshot_find(s, &key, cmp_rec);
+    if (!hit || hit->id != 2 * i || hit->weight != i) ok = 0;
+
+    key.id = 2 * i - 1;  // Odd: absent, lower bound is 2 * i
+    if (ds_snapshot_find(s, &key, cmp_rec)) ok = 0;
+    const rec_t *lb = ds_snapshot_lower_bound(s, &key, cmp_rec);
+    if (!lb || lb->id != 2 * i) ok = 0;
+  }
+  ASSERT(ok, "every key found, every gap bounded");
+
+  rec_t above = { 2 * n, 0 };
+  ASSERT_NULL(ds_snapshot_lower_bound(s, &above, cmp_rec), "no lower bound above the max");
+
+  // An in-order walk of the implicit tree visits ids in ascending order
+  ds_span_t span = ds_snapshot_span(s);
+  int next_id = 0;
+  ASSERT(eytzinger_inorder_ok(span, 0, &next_id) && next_id == 2 * n, "layout is Eytzinger order");
+  ds_snapshot_unmap(s);
+  ds_vec_destroy(v, NULL);
+  unlink(path);
+}
+
+TEST_FUNC(test_snapshot_rejects_bad_files) {
+  char path[64];
+  tmp_path(path, sizeof(path));
+
+  FILE *fp = fopen(path, "wb");
+  fputs("not a snapshot, but long enough to hold a header of sixty-four bytes....", fp);
+  fclose(fp);
+  ASSERT_NULL(ds_snapshot_map(path), "garbage is rejected");
+  ds_vector_t *out = NULL;
+  ASSERT_EQ(ds_snapshot_load_vector(path, decode_int, NULL, free, NULL, &out), DS_ERR_IO,
+            "garbage record file is rejected");
+
+  // A record file is not mappable, and a flat file is not loadable
+  ds_vector_t *vec = ds_vector_create(0);
+  ds_vector_push_back(vec, mk_int(1));
+  ASSERT_EQ(ds_snapshot_save_vector(path, vec, encode_int, NULL), DS_OK, "save records");
+  ASSERT_NULL(ds_snapshot_map(path), "record file is not mappable");
+
+  // Truncate the last record
+  fp = fopen(path, "rb");
+  char buf[256];
+  size_t len = fread(buf, 1, sizeof(buf), fp);
+  fclose(fp);
+  fp = fopen(path, "wb");
+  fwrite(buf, 1, len - 1, fp);
+  fclose(fp);
+  ASSERT_EQ(ds_snapshot_load_vector(path, decode_int, NULL, free, NULL, &out), DS_ERR_IO,
+            "truncated record file is rejected");
+
+  // A header and record length far larger than the file: fails before
+  // any allocation of that size
+  uint64_t huge = UINT64_C(1) << 40;
+  memcpy(buf + 24, &huge, sizeof(huge));   // count
+  huge = UINT64_C(1) << 60;
+  memcpy(buf + 40, &huge, sizeof(huge));   // data_bytes
+  huge = UINT64_C(1) << 50;
+  memcpy(buf + 64, &huge, sizeof(huge));   // first record length
+  fp = fopen(path, "wb");
+  fwrite(buf, 1, len, fp);
+  fclose(fp);
+  ASSERT_EQ(ds_snapshot_load_vector(path, decode_int, NULL, free, NULL, &out), DS_ERR_IO,
+            "header larger than the file is rejected");
+
+  ds_vec_t *v = ds_vec_create(sizeof(int), 0);
+  int x = 3;
+  ds_vec_push_back(v, &x);
+  ASSERT_EQ(ds_snapshot_save_vec(path, v), DS_OK, "save flat");
+  ASSERT_EQ(ds_snapshot_load_vector(path, decode_int, NULL, free, NULL, &out), DS_ERR_IO,
+            "flat file is not a record file");
+
+  ds_vec_destroy(v, NULL);
+  ds_vector_destroy(vec, free);
+  unlink(path);
+}
+
+TEST_FUNC(test_snapshot_records_vector) {
+  char path[64];
+  tmp_path(path, sizeof(path));
+
+  ds_vector_t *vec = ds_vector_create(0);
+  for (int i = 0; i < 500; ++ i) ds_vector_push_back(vec, mk_int(i * 7));
+  ASSERT_EQ(ds_snapshot_save_vector(path, vec, encode_int, NULL), DS_OK, "save vector");
+
+  ds_vector_t *back = NULL;
+  ASSERT_EQ(ds_snapshot_load_vector(path, decode_int, NULL, free, NULL, &back), DS_OK, "load vector");
+  ASSERT_EQ(ds_vector_size(back), 500, "loaded size");
+  int ok = 1;
+  for (size_t i = 0; i < 500; ++ i) {
+    if (*(int *)ds_vector_get(back, i) != (int)i * 7) ok = 0;
+  }
+  ASSERT(ok, "loaded in order");
+  ds_vector_destroy(back, free);
+
+  // A failing decoder frees what it already produced (checked by ASan)
+  g_decode_budget = 100;
+  back = NULL;
+  ASSERT_EQ(ds_snapshot_load_vector(path, decode_int_limited, NULL, free, NULL, &back), DS_ERR_ARG,
+            "decoder failure is reported");
+  ASSERT_NULL(back, "no vector on failure");
+
+  ds_vector_t *empty = ds_vector_create(0);
+  ASSERT_EQ(ds_snapshot_save_vector(path, empty, encode_int, NULL), DS_OK, "save empty");
+  ASSERT_EQ(ds_snapshot_load_vector(path, decode_int, NULL, free, NULL, &back), DS_OK, "load empty");
+  ASSERT_EQ(ds_vector_size(back), 0, "empty round trip");
+
+  ds_vector_destroy(back, free);
+  ds_vector_destroy(empty, NULL);
+  ds_vector_destroy(vec, free);
+  unlink(path);
+}
+
+TEST_FUNC(test_snapshot_records_heap_bst) {
+  char path[64];
+  tmp_path(path, sizeof(path));
+
+  ds_heap_t *h = ds_heap_create(cmp_int, 0);
+  ds_bst_t *t = ds_bst_create(cmp_int);
+  uint32_t seed = 7;
+  for (int i = 0; i < 300; ++ i) {
+    seed = seed * 1664525u + 1013904223u;
+    int v = (int)(seed % 100000);
+    ds_heap_push(h, mk_int(v));
+    if (!ds_bst_search(t, &v)) ds_bst_insert(t, mk_int(v));
+  }
+
+  // Heap: same storage order after the round trip
+  ASSERT_EQ(ds_snapshot_save_heap(path, h, encode_int, NULL), DS_OK, "save heap");
+  ds_heap_t *h2 = NULL;
+  ASSERT_EQ(ds_snapshot_load_heap(path, cmp_int, decode_int, NULL, free, NULL, &h2), DS_OK, "load heap");
+  ds_span_t a = ds_heap_as_span(h), b = ds_heap_as_span(h2);
+  int ok = a.size == b.size;
+  for (size_t i = 0; ok && i < a.size; ++ i) {
+    if (*(int *)((void **)a.data)[i] != *(int *)((void **)b.data)[i]) ok = 0;
+  }
+  ASSERT(ok, "heap storage order preserved");
+  int last = -1;
+  while (!ds_heap_is_empty(h2)) {
+    int *p = ds_heap_pop(h2);
+    if (*p < last) ok = 0;
+    last = *p;
+    free(p);
+  }
+  ASSERT(ok, "loaded heap pops in order");
+
+  // Tree: balanced rebuild with the same contents
+  ASSERT_EQ(ds_snapshot_save_bst(path, t, encode_int, NULL), DS_OK, "save bst");
+  ds_bst_t *t2 = NULL;
+  ASSERT_EQ(ds_snapshot_load_bst(path, cmp_int, decode_int, NULL, free, NULL, &t2), DS_OK, "load bst");
+  ASSERT_EQ(ds_bst_size(t2), ds_bst_size(t), "bst size preserved");
+  ok = 1;
+  for (size_t k = 0; k < ds_bst_size(t); ++ k) {
+    if (cmp_int(ds_bst_select(t, k), ds_bst_select(t2, k)) != 0) ok = 0;
+  }
+  ASSERT(ok, "bst contents and ranks preserved");
+  int probe = *(int *)ds_bst_select(t, 10);
+  ASSERT_EQ(ds_bst_rank(t2, &probe), 10, "rank works on the rebuilt tree");
+  int fresh = -5;
+  ASSERT_EQ(ds_bst_insert(t2, mk_int(fresh)), DS_OK, "rebuilt tree accepts inserts");
+  ASSERT_EQ(*(int *)ds_bst_min(t2), -5, "new minimum");
+
+  // A heap file is generally not ascending
+  ASSERT_EQ(ds_snapshot_save_heap(path, h, encode_int, NULL), DS_OK, "save heap again");
+  ds_bst_t *t3 = NULL;
+  ASSERT_EQ(ds_snapshot_load_bst(path, cmp_int, decode_int, NULL, free, NULL, &t3), DS_ERR_ARG,
+            "unsorted records rejected for a tree");
+
+  ds_bst_destroy(t2, free);
+  ds_heap_destroy(h2, free);
+  ds_bst_destroy(t, free);
+  ds_heap_destroy(h, free);
+  unlink(path);
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"snapshot_null_and_missing", test_snapshot_null_and_missing},
+    {"snapshot_flat_array", test_snapshot_flat_array},
+    {"snapshot_flat_tree", test_snapshot_flat_tree},
+    {"snapshot_rejects_bad_files", test_snapshot_rejects_bad_files},
+    {"snapshot_records_vector", test_snapshot_records_vector},
+    {"snapshot_records_heap_bst", test_snapshot_records_heap_bst},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -4,6 +4,7 @@
 
 #include "ds_stack.h"
 #include "ds_common.h"
+#include "ds_stack_inline.h"
 
 /* ------------ Colored output ------------ */
 #define COLOR_GREEN "\033[32m"
@@ -69,6 +70,40 @@ static void counted_free(void *p) {
   free(p);
 }
 
+/* Counting allocator: tracks live bytes so leaks and size mismatches show up. */
+typedef struct {
+  size_t live_bytes;
+  size_t allocs;
+  size_t frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  counting_ctx_t *c = ctx;
+  void *p = malloc(size);
+  if (p) { c->live_bytes += size; c->allocs ++; }
+  return p;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  counting_ctx_t *c = ctx;
+  void *p = realloc(ptr, new_size);
+  if (p) c->live_bytes = c->live_bytes - old_size + new_size;
+  return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+  counting_ctx_t *c = ctx;
+  if (!ptr) return;
+  c->live_bytes -= size;
+  c->frees ++;
+  free(ptr);
+}
+
+static ds_allocator_t counting_allocator(counting_ctx_t *ctx) {
+  ds_allocator_t a = { counting_alloc, counting_realloc, counting_free, ctx };
+  return a;
+}
+
 /* ===================== Tests ===================== */
 
 TEST_FUNC(test_stack_create_destroy_basic) {
@@ -197,8 +232,46 @@ TEST_FUNC(test_stack_error_codes_push) {
   ds_stack_destroy(s, NULL);
 }
 
+TEST_FUNC(test_stack_custom_allocator) {
+  counting_ctx_t ctx = {0};
+  ds_allocator_t a = counting_allocator(&ctx);
+
+  ds_stack_t *st = ds_stack_create_ex(0, &a);
+  ASSERT_NOT_NULL(st, "create_ex with custom allocator returns non-NULL");
+
+  for (int i = 0; i < 100; ++ i) ds_stack_push(st, mk_int(i));
+  ASSERT_EQ(*(int *)ds_stack_top(st), 99, "top is last pushed");
+
+  ds_stack_destroy(st, free);
+  ASSERT_EQ(ctx.live_bytes, 0, "stack and its deque released through the allocator");
+  ASSERT_EQ(ctx.allocs, ctx.frees, "alloc/free calls balanced");
+}
+
 /* ===================== main ===================== */
 
+TEST_FUNC(test_stack_inline_fast_paths) {
+  ds_stack_t *s = ds_stack_create(2);
+
+  /* Third push goes through the checked slow path and grows */
+  for (int i = 1; i <= 3; i++) ASSERT_EQ(ds_stack_push_fast(s, mk_int(i)), DS_OK, "push_fast");
+  ASSERT_EQ(ds_stack_size(s), 3u, "size after push_fast");
+  ASSERT(ds_stack_capacity(s) >= 3, "grown through the slow path");
+  ASSERT_EQ(int_val(ds_stack_top_unsafe(s)), 3, "top_unsafe");
+
+  /* Mixed with the checked API */
+  ASSERT_EQ(ds_stack_push(s, mk_int(4)), DS_OK, "checked push");
+  int ok = 1;
+  for (int i = 4; i >= 1; i--) {
+    int *p = ds_stack_pop_unsafe(s);
+    if (*p != i) ok = 0;
+    free(p);
+  }
+  ASSERT(ok, "pop_unsafe is LIFO");
+  ASSERT(ds_stack_is_empty(s), "empty after pops");
+
+  ds_stack_destroy(s, counted_free);
+}
+
 int main() {
   test_case_t tests[] = {
     {"stack_create_destroy_basic", test_stack_create_destroy_basic},
@@ -207,6 +280,8 @@ int main() {
     {"stack_clear_frees_elements", test_stack_clear_frees_elements},
     {"stack_bulk_stress", test_stack_bulk_stress},
     {"stack_error_codes_push", test_stack_error_codes_push},
+    {"stack_custom_allocator", test_stack_custom_allocator},
+    {"stack_inline_fast_paths", test_stack_inline_fast_paths},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ds_bst.h"
+#include "ds_common.h"
+#include "ds_deque.h"
+#include "ds_hashmap.h"
+#include "ds_heap.h"
+#include "ds_queue.h"
+#include "ds_stack.h"
+#include "ds_stats.h"
+#include "ds_vector.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+static size_t hash_int(const void *k) {
+  return (size_t)*(const int *)k;
+}
+
+static bool equal_int(const void *a, const void *b) {
+  return *(const int *)a == *(const int *)b;
+}
+
+typedef struct {
+  size_t seen;
+  const void *want;
+  const char *want_kind;
+  int found;
+} find_ctx_t;
+
+static void find_visit(const char *kind, const void *owner, const ds_stats_t *stats, void *ctx) {
+  find_ctx_t *f = ctx;
+  (void)stats;
+  f->seen ++;
+  if (owner == f->want && strcmp(kind, f->want_kind) == 0) f->found = 1;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_stats_null_args) {
+  ds_stats_t st;
+  ASSERT_EQ(ds_vector_stats(NULL, &st), DS_ERR_NULL, "vector_stats NULL vector");
+  ASSERT_EQ(ds_deque_stats(NULL, &st), DS_ERR_NULL, "deque_stats NULL deque");
+  ASSERT_EQ(ds_stack_stats(NULL, &st), DS_ERR_NULL, "stack_stats NULL stack");
+  ASSERT_EQ(ds_queue_stats(NULL, &st), DS_ERR_NULL, "queue_stats NULL queue");
+  ASSERT_EQ(ds_heap_stats(NULL, &st), DS_ERR_NULL, "heap_stats NULL heap");
+  ASSERT_EQ(ds_bst_stats(NULL, &st), DS_ERR_NULL, "bst_stats NULL bst");
+  ASSERT_EQ(ds_hashmap_stats(NULL, &st), DS_ERR_NULL, "hashmap_stats NULL map");
+
+  ds_vector_t *v = ds_vector_create(0);
+  ASSERT_EQ(ds_vector_stats(v, NULL), DS_ERR_NULL, "vector_stats NULL out");
+  ds_vector_destroy(v, NULL);
+
+  ASSERT_EQ(ds_stats_hist_quantile(NULL, 0.5), 0, "quantile of NULL histogram is 0");
+  ds_stats_hist_t empty = { 0 };
+  ASSERT_EQ(ds_stats_hist_quantile(&empty, 0.5), 0, "quantile of empty histogram is 0");
+}
+
+#ifndef DS_ENABLE_STATS
+
+TEST_FUNC(test_stats_disabled) {
+  ASSERT(!ds_stats_enabled(), "stats reported disabled");
+
+  ds_vector_t *v = ds_vector_create(0);
+  ds_hashmap_t *m = ds_hashmap_create(hash_int, equal_int, 0);
+  ds_stats_t st;
+  ASSERT_EQ(ds_vector_stats(v, &st), DS_ERR_UNSUPPORTED, "vector_stats unsupported");
+  ASSERT_EQ(ds_hashmap_stats(m, &st), DS_ERR_UNSUPPORTED, "hashmap_stats unsupported");
+
+  find_ctx_t f = { 0 };
+  ASSERT_EQ(ds_stats_foreach(find_visit, &f), 0, "foreach visits nothing");
+  ASSERT_EQ(f.seen, 0, "visit not called");
+
+  ds_hashmap_destroy(m, NULL, NULL);
+  ds_vector_destroy(v, NULL);
+}
+
+#else
+
+static int cmp_int(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+TEST_FUNC(test_stats_vector) {
+  ASSERT(ds_stats_enabled(), "stats reported enabled");
+
+  ds_vector_t *v = ds_vector_create(2);
+  int x = 1;
+  for (int i = 0; i < 100; ++ i) ds_vector_push_back(v, &x);
+
+  ds_stats_t st;
+  ASSERT_EQ(ds_vector_stats(v, &st), DS_OK, "vector_stats ok");
+  ASSERT_EQ(st.allocs, 1, "one alloc for the initial storage");
+  ASSERT(st.reallocs >= 5, "growth went through realloc");
+  ASSERT_EQ(st.resizes, st.reallocs, "every realloc is a timed resize");
+  ASSERT_EQ(st.resize_latency.count, st.resizes, "histogram has one sample per resize");
+  ASSERT_EQ(st.bytes_live, sizeof(void *) * ds_vector_capacity(v), "live bytes match capacity");
+  ASSERT(st.bytes_peak >= st.bytes_live, "peak >= live");
+
+  uint64_t sum = 0;
+  for (size_t b = 0; b < DS_STATS_HIST_BUCKETS; ++ b) sum += st.resize_latency.buckets[b];
+  ASSERT_EQ(sum, st.resize_latency.count, "buckets add up to count");
+  ASSERT(ds_stats_hist_quantile(&st.resize_latency, 0.5)
+         <= ds_stats_hist_quantile(&st.resize_latency, 0.99), "p50 <= p99");
+  ASSERT(ds_stats_hist_quantile(&st.resize_latency, 1.0) <= st.resize_latency.max_ns,
+         "quantile bounded by max");
+
+  ds_vector_destroy(v, NULL);
+}
+
+TEST_FUNC(test_stats_heap_bst_hashmap) {
+  int keys[64];
+  for (int i = 0; i < 64; ++ i) keys[i] = (i * 37) % 64;
+
+  ds_heap_t *h = ds_heap_create(cmp_int, 4);
+  ds_bst_t *t = ds_bst_create(cmp_int);
+  ds_hashmap_t *m = ds_hashmap_create(hash_int, equal_int, 0);
+  for (int i = 0; i < 64; ++ i) {
+    ds_heap_push(h, &keys[i]);
+    ds_bst_insert(t, &keys[i]);
+    ds_hashmap_insert(m, &keys[i], NULL);
+  }
+
+  ds_stats_t st;
+  ASSERT_EQ(ds_heap_stats(h, &st), DS_OK, "heap_stats ok");
+  ASSERT(st.comparisons > 0, "heap counted comparisons");
+  ASSERT(st.resizes > 0, "heap grew");
+
+  ASSERT_EQ(ds_bst_stats(t, &st), DS_OK, "bst_stats ok");
+  uint64_t inserts_cmp = st.comparisons;
+  ASSERT(st.max_depth >= 7 && st.max_depth <= 64, "bst depth in range");
+  ASSERT_EQ(st.allocs, 64, "one allocation per bst node");
+  int probe = 5;
+  ASSERT_NOT_NULL(ds_bst_search(t, &probe), "bst search hit");
+  ASSERT_EQ(ds_bst_stats(t, &st), DS_OK, "bst_stats ok again");
+  ASSERT_EQ(st.searches, 1, "bst counted the search");
+  ASSERT(st.comparisons > inserts_cmp, "search added comparisons");
+
+  ASSERT_EQ(ds_hashmap_stats(m, &st), DS_OK, "hashmap_stats ok");
+  uint64_t before = st.searches;
+  ASSERT(ds_hashmap_contains(m, &probe), "hashmap lookup hit");
+  ASSERT_EQ(ds_hashmap_stats(m, &st), DS_OK, "hashmap_stats ok again");
+  ASSERT_EQ(st.searches, before + 1, "hashmap counted the lookup");
+  ASSERT(st.probes >= st.searches, "at least one group per lookup");
+  ASSERT(st.max_probe >= 1, "max probe recorded");
+  ASSERT(st.comparisons >= 1, "equality calls counted");
+
+  ds_hashmap_destroy(m, NULL, NULL);
+  ds_bst_destroy(t, NULL);
+  ds_heap_destroy(h, NULL);
+}
+
+TEST_FUNC(test_stats_registry) {
+  find_ctx_t f = { 0 };
+  size_t base = ds_stats_foreach(find_visit, &f);
+
+  ds_stack_t *s = ds_stack_create(0);
+  ds_queue_t *q = ds_queue_create(0);
+  ds_deque_t *d = ds_deque_create(0);
+
+  f = (find_ctx_t){ .want = d, .want_kind = "ds_deque" };
+  ASSERT_EQ(ds_stats_foreach(find_visit, &f), base + 3, "three new containers registered");
+  ASSERT(f.found, "deque found by owner and kind");
+
+  int x = 0;
+  for (int i = 0; i < 100; ++ i) ds_queue_push(q, &x);
+  ds_stats_t st;
+  ASSERT_EQ(ds_queue_stats(q, &st), DS_OK, "queue_stats ok");
+  ASSERT(st.resizes > 0, "queue's deque resized");
+  ASSERT_EQ(ds_stack_stats(s, &st), DS_OK, "stack_stats ok");
+  ASSERT_EQ(st.resizes, 0, "idle stack never resized");
+
+  FILE *out = tmpfile();
+  ASSERT_EQ(ds_stats_dump(out), base + 3, "dump prints every container");
+  long len = ftell(out);
+  ASSERT(len > 0, "dump wrote something");
+  fclose(out);
+
+  ds_deque_destroy(d, NULL);
+  ds_queue_destroy(q, NULL);
+  ds_stack_destroy(s, NULL);
+  f = (find_ctx_t){ 0 };
+  ASSERT_EQ(ds_stats_foreach(find_visit, &f), base, "destroyed containers unregistered");
+}
+
+#endif
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"stats_null_args", test_stats_null_args},
+#ifndef DS_ENABLE_STATS
+    {"stats_disabled", test_stats_disabled},
+#else
+    {"stats_vector", test_stats_vector},
+    {"stats_heap_bst_hashmap", test_stats_heap_bst_hashmap},
+    {"stats_registry", test_stats_registry},
+#endif
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
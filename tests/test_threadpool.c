@@ -0,0 +1,144 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "ds_common.h"
+#include "ds_threadpool.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+
+/* ===================== Helpers ===================== */
+
+static atomic_size_t g_counter;
+
+static void bump(void *arg) {
+  (void)arg;
+  atomic_fetch_add(&g_counter, 1);
+}
+
+/* Recursive job: a task per node of an implicit binary tree of `depth`. */
+typedef struct {
+  ds_threadpool_t *pool;
+  size_t depth;
+} tree_job_t;
+
+static tree_job_t g_jobs[64];
+
+static void visit_tree(void *arg) {
+  tree_job_t *job = arg;
+  atomic_fetch_add(&g_counter, 1);
+  if (job->depth == 0) return;
+
+  // Children share one preallocated job per depth
+  ds_threadpool_submit(job->pool, visit_tree, &g_jobs[job->depth - 1]);
+  ds_threadpool_submit(job->pool, visit_tree, &g_jobs[job->depth - 1]);
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_threadpool_basic) {
+  ds_threadpool_t *pool = ds_threadpool_create(4);
+  ASSERT_NOT_NULL(pool, "create returns non-NULL");
+  ASSERT_EQ(ds_threadpool_size(pool), 4, "size == requested threads");
+  ASSERT_EQ(ds_threadpool_submit(pool, NULL, NULL), DS_ERR_ARG, "submit(NULL func) -> DS_ERR_ARG");
+  ASSERT_EQ(ds_threadpool_submit(NULL, bump, NULL), DS_ERR_NULL, "submit(NULL pool) -> DS_ERR_NULL");
+
+  atomic_store(&g_counter, 0);
+  int ok = 1;
+  for (int i = 0; i < 10000; ++ i) {
+    if (ds_threadpool_submit(pool, bump, NULL) != DS_OK) ok = 0;
+  }
+  ASSERT(ok, "submit from outside the pool");
+  ds_threadpool_wait(pool);
+  ASSERT_EQ(atomic_load(&g_counter), 10000, "wait() returns after every task ran");
+
+  // The pool is reusable after wait()
+  for (int i = 0; i < 100; ++ i) ds_threadpool_submit(pool, bump, NULL);
+  ds_threadpool_wait(pool);
+  ASSERT_EQ(atomic_load(&g_counter), 10100, "pool reusable after wait()");
+
+  ds_threadpool_destroy(pool);
+
+  pool = ds_threadpool_create(0);
+  ASSERT(pool && ds_threadpool_size(pool) >= 1, "create(0) uses the CPU count");
+  ds_threadpool_destroy(pool);
+}
+
+TEST_FUNC(test_threadpool_recursive) {
+  ds_threadpool_t *pool = ds_threadpool_create(3);
+  const size_t depth = 14;
+  for (size_t i = 0; i <= depth; ++ i) g_jobs[i] = (tree_job_t){ pool, i };
+
+  atomic_store(&g_counter, 0);
+  ds_threadpool_submit(pool, visit_tree, &g_jobs[depth]);
+  ds_threadpool_wait(pool);
+  ASSERT_EQ(atomic_load(&g_counter), ((size_t)1 << (depth + 1)) - 1,
+            "wait() covers tasks submitted by tasks");
+
+  // destroy() drains whatever is still queued
+  atomic_store(&g_counter, 0);
+  ds_threadpool_submit(pool, visit_tree, &g_jobs[10]);
+  ds_threadpool_destroy(pool);
+  ASSERT_EQ(atomic_load(&g_counter), ((size_t)1 << 11) - 1, "destroy() runs pending tasks");
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"threadpool_basic", test_threadpool_basic},
+    {"threadpool_recursive", test_threadpool_recursive},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
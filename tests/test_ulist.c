@@ -0,0 +1,179 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ds_common.h"
+#include "ds_ulist.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+#define KEY(v) ((void *)(intptr_t)(v))
+#define VAL(p) ((int)(intptr_t)(p))
+
+static int g_free_count = 0;
+static void counted_free(void *p) {
+  (void)p;
+  g_free_count++;
+}
+
+/* Compare the list against a reference array, both directions */
+static int matches(ds_ulist_t *l, const int *ref, size_t n) {
+  if (ds_ulist_size(l) != n) return 0;
+  size_t i = 0;
+  for (ds_ulist_iter_t it = ds_ulist_iter_begin(l); it.node; it = ds_ulist_iter_next(it)) {
+    if (i >= n || VAL(ds_ulist_iter_get(it)) != ref[i]) return 0;
+    i++;
+  }
+  if (i != n) return 0;
+  for (ds_ulist_iter_t it = ds_ulist_iter_tail(l); it.node; it = ds_ulist_iter_prev(it)) {
+    if (i == 0 || VAL(ds_ulist_iter_get(it)) != ref[--i]) return 0;
+  }
+  return i == 0;
+}
+
+static ds_ulist_iter_t iter_at(ds_ulist_t *l, size_t pos) {
+  ds_ulist_iter_t it = ds_ulist_iter_begin(l);
+  while (pos-- > 0) it = ds_ulist_iter_next(it);
+  return it;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_ulist_basic) {
+  ds_ulist_t *l = ds_ulist_create(4);
+  ASSERT_NOT_NULL(l, "create");
+  ASSERT(ds_ulist_is_empty(l), "empty after create");
+  ASSERT_NULL(ds_ulist_pop_front(l), "pop_front on empty");
+  ASSERT_NULL(ds_ulist_pop_back(l), "pop_back on empty");
+  ASSERT(ds_ulist_iter_equal(ds_ulist_iter_begin(l), ds_ulist_iter_end(l)), "begin == end on empty");
+  ASSERT_EQ(ds_ulist_push_back(l, NULL), DS_ERR_ARG, "NULL element rejected");
+  ASSERT_EQ(ds_ulist_push_back(NULL, KEY(1)), DS_ERR_NULL, "NULL list rejected");
+
+  for (int i = 2; i <= 11; i++) ds_ulist_push_back(l, KEY(i));
+  ds_ulist_push_front(l, KEY(1));
+  int ref[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+  ASSERT(matches(l, ref, 11), "push_back/push_front order");
+
+  ASSERT_EQ(VAL(ds_ulist_pop_front(l)), 1, "pop_front");
+  ASSERT_EQ(VAL(ds_ulist_pop_back(l)), 11, "pop_back");
+
+  ds_ulist_iter_t it = iter_at(l, 2);
+  ASSERT_EQ(ds_ulist_set(l, it, KEY(33), counted_free), DS_OK, "set");
+  ASSERT_EQ(VAL(ds_ulist_iter_get(it)), 33, "set stores the new element");
+  ASSERT_EQ(g_free_count, 1, "set frees the old element");
+
+  it = ds_ulist_remove(l, iter_at(l, 2), NULL);
+  ASSERT_EQ(VAL(ds_ulist_iter_get(it)), 5, "remove returns the next element");
+  it = ds_ulist_remove(l, ds_ulist_iter_tail(l), NULL);
+  ASSERT(ds_ulist_iter_equal(it, ds_ulist_iter_end(l)), "removing the tail returns End");
+
+  g_free_count = 0;
+  ds_ulist_destroy(l, counted_free);
+  ASSERT_EQ(g_free_count, 7, "destroy frees the remaining elements");
+}
+
+TEST_FUNC(test_ulist_random_ops_match_reference) {
+  enum { CAP = 5000 };
+  static int ref[CAP];
+  size_t n = 0;
+
+  ds_ulist_t *l = ds_ulist_create(8);
+  uint32_t seed = 0xACE1u;
+  int ok = 1, next_val = 1;
+
+  for (int step = 0; step < 20000; step++) {
+    seed = seed * 1664525u + 1013904223u;
+    unsigned op = (seed >> 24) % 6;
+
+    if (op <= 2 && n < CAP) {
+      /* insert at a random position (n == End) */
+      size_t pos = n ? (seed >> 8) % (n + 1) : 0;
+      ds_ulist_iter_t it = pos == n ? ds_ulist_iter_end(l) : iter_at(l, pos);
+      if (ds_ulist_insert(l, it, KEY(next_val)) != DS_OK) ok = 0;
+      memmove(&ref[pos + 1], &ref[pos], sizeof(int) * (n - pos));
+      ref[pos] = next_val++;
+      n++;
+    } else if (op == 3 && n > 0) {
+      size_t pos = (seed >> 8) % n;
+      ds_ulist_iter_t it = ds_ulist_remove(l, iter_at(l, pos), NULL);
+      memmove(&ref[pos], &ref[pos + 1], sizeof(int) * (n - pos - 1));
+      n--;
+      if (pos < n ? VAL(ds_ulist_iter_get(it)) != ref[pos] : it.node != NULL) ok = 0;
+    } else if (op == 4 && n > 0) {
+      if (VAL(ds_ulist_pop_front(l)) != ref[0]) ok = 0;
+      memmove(&ref[0], &ref[1], sizeof(int) * --n);
+    } else if (n > 0) {
+      if (VAL(ds_ulist_pop_back(l)) != ref[--n]) ok = 0;
+    }
+
+    if (step % 500 == 0 && !matches(l, ref, n)) ok = 0;
+  }
+  ASSERT(ok, "random insert/remove/pop agree with a reference array");
+  ASSERT(matches(l, ref, n), "final contents match");
+
+  ds_ulist_clear(l, NULL);
+  ASSERT(ds_ulist_is_empty(l), "clear");
+  ds_ulist_destroy(l, NULL);
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"ulist_basic", test_ulist_basic},
+    {"ulist_random_ops_match_reference", test_ulist_random_ops_match_reference},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
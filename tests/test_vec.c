@@ -0,0 +1,314 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_common.h"
+#include "ds_vec.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+/* ===================== Helpers ===================== */
+
+static int *mk_int(int v) {
+  int *p = (int *)malloc(sizeof(int));
+  if (!p) return NULL;
+  *p = v;
+  return p;
+}
+
+typedef struct {
+  int id;
+  double weight;
+  char tag[4];
+} item_t;
+
+DS_VEC_DEFINE(ivec, int)
+DS_VEC_DEFINE(itemvec, item_t)
+
+static int g_release_count = 0;
+
+/* Destructor for slots holding a heap pointer: receives the slot address. */
+static void release_boxed(void *slot) {
+  int **p = slot;
+  free(*p);
+  g_release_count ++;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_vec_create_basic) {
+  ds_vec_t *v = ds_vec_create(sizeof(int), 0);
+  ASSERT_NOT_NULL(v, "create returns non-NULL");
+  ASSERT_EQ(ds_vec_size(v), 0, "new vec size == 0");
+  ASSERT(ds_vec_capacity(v) > 0, "default capacity > 0");
+  ASSERT_EQ(ds_vec_elem_size(v), sizeof(int), "elem_size recorded");
+  ASSERT(ds_vec_is_empty(v), "new vec is empty");
+  ds_vec_destroy(v, NULL);
+
+  ASSERT_NULL(ds_vec_create(0, 4), "elem_size == 0 rejected");
+  ASSERT_EQ(ds_vec_size(NULL), 0, "size(NULL) == 0");
+  ASSERT(ds_vec_is_empty(NULL), "is_empty(NULL) == true");
+  ASSERT_NULL(ds_vec_get(NULL, 0), "get(NULL) == NULL");
+  ASSERT_NULL(ds_vec_data(NULL), "data(NULL) == NULL");
+  ds_vec_destroy(NULL, NULL);
+}
+
+TEST_FUNC(test_vec_error_codes) {
+  ds_vec_t *v = ds_vec_create(sizeof(int), 2);
+  int x = 1;
+
+  ASSERT_EQ(ds_vec_push_back(NULL, &x), DS_ERR_NULL, "push(NULL) -> DS_ERR_NULL");
+  ASSERT_EQ(ds_vec_push_back(v, NULL), DS_ERR_ARG, "push(elem NULL) -> DS_ERR_ARG");
+  ASSERT_EQ(ds_vec_insert(v, 1, &x), DS_ERR_BOUNDS, "insert past size -> DS_ERR_BOUNDS");
+  ASSERT_EQ(ds_vec_set(v, 0, &x, NULL), DS_ERR_BOUNDS, "set on empty -> DS_ERR_BOUNDS");
+  ASSERT_EQ(ds_vec_remove(v, 0, NULL), DS_ERR_BOUNDS, "remove on empty -> DS_ERR_BOUNDS");
+  ASSERT_EQ(ds_vec_pop_back(v, &x), DS_ERR_EMPTY, "pop on empty -> DS_ERR_EMPTY");
+  ASSERT_EQ(ds_vec_push_back(v, &x), DS_OK, "push ok");
+  ASSERT_EQ(ds_vec_reserve(v, 0), DS_ERR_BOUNDS, "reserve below size -> DS_ERR_BOUNDS");
+
+  ds_vec_destroy(v, NULL);
+}
+
+TEST_FUNC(test_vec_push_get_insert_remove) {
+  ds_vec_t *v = ds_vec_create(sizeof(int), 2);
+
+  for (int i = 0; i < 100; ++ i) ds_vec_push_back(v, &i);
+  ASSERT_EQ(ds_vec_size(v), 100, "size == 100 after pushes");
+  ASSERT(ds_vec_capacity(v) >= 100, "vector grew");
+
+  int ok = 1;
+  const int *data = ds_vec_data(v);
+  for (int i = 0; i < 100; ++ i) {
+    if (data[i] != i || *(int *)ds_vec_get(v, (size_t)i) != i) { ok = 0; break; }
+  }
+  ASSERT(ok, "elements stored contiguously by value");
+
+  int m = -1;
+  ASSERT_EQ(ds_vec_insert(v, 0, &m), DS_OK, "insert at front");
+  ASSERT_EQ(ds_vec_insert(v, 50, &m), DS_OK, "insert in the middle");
+  ASSERT_EQ(*(int *)ds_vec_get(v, 0), -1, "front inserted");
+  ASSERT_EQ(*(int *)ds_vec_get(v, 50), -1, "middle inserted");
+  ASSERT_EQ(*(int *)ds_vec_get(v, 51), 49, "tail shifted");
+
+  ASSERT_EQ(ds_vec_remove(v, 50, NULL), DS_OK, "remove middle");
+  ASSERT_EQ(ds_vec_remove(v, 0, NULL), DS_OK, "remove front");
+  ok = 1;
+  for (int i = 0; i < 100; ++ i) {
+    if (*(int *)ds_vec_get(v, (size_t)i) != i) { ok = 0; break; }
+  }
+  ASSERT(ok, "order restored after removes");
+
+  int seven = 7;
+  ASSERT_EQ(ds_vec_set(v, 3, &seven, NULL), DS_OK, "set ok");
+  ASSERT_EQ(*(int *)ds_vec_get(v, 3), 7, "set overwrote value");
+
+  int out = 0;
+  ASSERT_EQ(ds_vec_pop_back(v, &out), DS_OK, "pop ok");
+  ASSERT_EQ(out, 99, "pop copies out last element");
+  ASSERT_EQ(ds_vec_pop_back(v, NULL), DS_OK, "pop may discard");
+  ASSERT_EQ(ds_vec_size(v), 98, "size after pops");
+
+  size_t cap = ds_vec_capacity(v);
+  ds_vec_clear(v, NULL);
+  ASSERT_EQ(ds_vec_size(v), 0, "clear empties");
+  ASSERT_EQ(ds_vec_capacity(v), cap, "clear keeps capacity");
+
+  ds_vec_destroy(v, NULL);
+}
+
+TEST_FUNC(test_vec_struct_elements_and_emplace) {
+  ds_vec_t *v = ds_vec_create(sizeof(item_t), 0);
+
+  for (int i = 0; i < 40; ++ i) {
+    item_t *slot = ds_vec_emplace_back(v);
+    ASSERT_NOT_NULL(slot, "emplace_back returns a slot");
+    slot->id = i;
+    slot->weight = i * 0.5;
+    slot->tag[0] = 'a' + (char)(i % 26);
+  }
+  ASSERT_EQ(ds_vec_size(v), 40, "size == 40 after emplace");
+
+  int ok = 1;
+  for (int i = 0; i < 40; ++ i) {
+    const item_t *it = ds_vec_get(v, (size_t)i);
+    if (it->id != i || it->weight != i * 0.5 || it->tag[0] != 'a' + (char)(i % 26)) { ok = 0; break; }
+  }
+  ASSERT(ok, "struct elements survive growth intact");
+
+  ds_vec_destroy(v, NULL);
+}
+
+TEST_FUNC(test_vec_free_func_receives_slot) {
+  ds_vec_t *v = ds_vec_create(sizeof(int *), 0);
+  for (int i = 0; i < 10; ++ i) {
+    int *boxed = mk_int(i);
+    ds_vec_push_back(v, &boxed);
+  }
+
+  g_release_count = 0;
+  int *repl = mk_int(100);
+  ASSERT_EQ(ds_vec_set(v, 0, &repl, release_boxed), DS_OK, "set releases old slot");
+  ASSERT_EQ(ds_vec_remove(v, 1, release_boxed), DS_OK, "remove releases slot");
+  ASSERT_EQ(g_release_count, 2, "two slots released");
+
+  ds_vec_clear(v, release_boxed);
+  ASSERT_EQ(g_release_count, 11, "clear releases the remaining nine");
+
+  int *again = mk_int(1);
+  ds_vec_push_back(v, &again);
+  ds_vec_destroy(v, release_boxed);
+  ASSERT_EQ(g_release_count, 12, "destroy releases remaining slots");
+}
+
+TEST_FUNC(test_vec_typed_wrappers) {
+  ds_vec_t *v = ivec_create(0);
+  ASSERT_NOT_NULL(v, "typed create");
+
+  for (int i = 0; i < 1000; ++ i) ivec_push(v, i * 3);
+  ASSERT_EQ(ds_vec_size(v), 1000, "typed push");
+  ASSERT_EQ(*ivec_at(v, 10), 30, "typed at");
+  ASSERT_NULL(ivec_at(v, 1000), "typed at out of range -> NULL");
+  ASSERT_EQ(ivec_set(v, 10, -5), DS_OK, "typed set");
+  ASSERT_EQ(ivec_data(v)[10], -5, "typed data view");
+  ASSERT_EQ(ivec_set(v, 5000, 1), DS_ERR_BOUNDS, "typed set out of range");
+
+  int out = 0;
+  ASSERT_EQ(ivec_pop(v, &out), DS_OK, "typed pop");
+  ASSERT_EQ(out, 999 * 3, "typed pop value");
+  ds_vec_destroy(v, NULL);
+
+  ds_vec_t *items = itemvec_create(4);
+  item_t a = { 1, 2.5, "xy" };
+  ASSERT_EQ(itemvec_push(items, a), DS_OK, "struct typed push");
+  ASSERT_EQ(itemvec_at(items, 0)->weight, 2.5, "struct typed at");
+  item_t b = {0};
+  ASSERT_EQ(itemvec_pop(items, &b), DS_OK, "struct typed pop");
+  ASSERT_EQ(b.id, 1, "struct typed pop value");
+  ASSERT_EQ(itemvec_pop(items, &b), DS_ERR_EMPTY, "struct typed pop on empty");
+  ds_vec_destroy(items, NULL);
+}
+
+TEST_FUNC(test_vec_find_count_fill) {
+  ds_vec_t *v = ivec_create(0);
+  for (int i = 0; i < 100; ++ i) ivec_push(v, i % 10);
+
+  int x = 7;
+  ASSERT_EQ(ds_vec_find(v, &x), 7u, "find first match (4-byte kernel)");
+  ASSERT_EQ(ds_vec_count(v, &x), 10u, "count matches");
+  x = 42;
+  ASSERT_EQ(ds_vec_find(v, &x), SIZE_MAX, "find miss");
+  x = 3;
+  ASSERT_EQ(ds_vec_fill(v, &x), DS_OK, "fill");
+  ASSERT_EQ(ds_vec_count(v, &x), 100u, "every element filled");
+  ASSERT_EQ(ds_vec_fill(v, NULL), DS_ERR_NULL, "fill(NULL element)");
+  ds_vec_destroy(v, NULL);
+
+  /* 8-byte and odd-sized elements take the other paths */
+  ds_vec_t *d = ds_vec_create(sizeof(double), 0);
+  for (int i = 0; i < 50; ++ i) { double f = i * 0.5; ds_vec_push_back(d, &f); }
+  double f = 12.5;
+  ASSERT_EQ(ds_vec_find(d, &f), 25u, "find double (8-byte kernel)");
+  ds_vec_destroy(d, NULL);
+
+  ds_vec_t *items = itemvec_create(4);
+  /* ds_vec_find compares bytes, so zero the padding first */
+  item_t a, b;
+  memset(&a, 0, sizeof(a));
+  memset(&b, 0, sizeof(b));
+  a.id = 1;
+  b.id = 2;
+  itemvec_push(items, a);
+  itemvec_push(items, b);
+  itemvec_push(items, b);
+  ASSERT_EQ(ds_vec_find(items, &b), 1u, "find struct (memcmp)");
+  ASSERT_EQ(ds_vec_count(items, &b), 2u, "count struct");
+  ASSERT_EQ(ds_vec_fill(items, &a), DS_OK, "fill struct");
+  ASSERT_EQ(ds_vec_count(items, &a), 3u, "struct fill copied");
+  ds_vec_destroy(items, NULL);
+}
+
+/* ===================== main ===================== */
+
+TEST_FUNC(test_vec_as_span) {
+  ASSERT(ds_span_is_empty(ds_vec_as_span(NULL)), "as_span(NULL) is empty");
+
+  ds_vec_t *vec = ds_vec_create(sizeof(int32_t), 0);
+  for (int32_t i = 0; i < 8; ++ i) ds_vec_push_back(vec, &i);
+
+  ds_span_t span = ds_vec_as_span(vec);
+  ASSERT(span.data == ds_vec_data(vec), "span over the storage");
+  ASSERT_EQ(span.size, 8u, "span size");
+  ASSERT_EQ(ds_span_bytes(span), 8 * sizeof(int32_t), "span bytes");
+
+  ds_span_t mid = ds_span_subspan(span, 2, 3);
+  ASSERT_EQ(mid.size, 3u, "subspan size");
+  ASSERT_EQ(*(int32_t *)ds_span_at(mid, 0), 2, "subspan starts at offset");
+  ASSERT_NULL(ds_span_at(mid, 3), "subspan bounds");
+
+  ds_vec_destroy(vec, NULL);
+}
+
+int main() {
+  test_case_t tests[] = {
+    {"vec_create_basic", test_vec_create_basic},
+    {"vec_error_codes", test_vec_error_codes},
+    {"vec_push_get_insert_remove", test_vec_push_get_insert_remove},
+    {"vec_struct_elements_and_emplace", test_vec_struct_elements_and_emplace},
+    {"vec_free_func_receives_slot", test_vec_free_func_receives_slot},
+    {"vec_typed_wrappers", test_vec_typed_wrappers},
+    {"vec_find_count_fill", test_vec_find_count_fill},
+    {"vec_as_span", test_vec_as_span},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}
@@ -2,12 +2,16 @@
 ** tests/test.c -- A simple test framework.
 */
 
+#include <pthread.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "ds_common.h"
 #include "ds_vector.h"
+#include "ds_vector_inline.h"
 
 /* ------------ Colored output ------------ */
 #define COLOR_GREEN "\033[32m"
@@ -75,6 +79,67 @@ static int int_val(void *p) {
   return p ? *(int *)p : 0;
 }
 
+/* Counting allocator: tracks live bytes so leaks and size mismatches show up. */
+typedef struct {
+  size_t live_bytes;
+  size_t allocs;
+  size_t frees;
+} counting_ctx_t;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  counting_ctx_t *c = ctx;
+  void *p = malloc(size);
+  if (p) { c->live_bytes += size; c->allocs ++; }
+  return p;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  counting_ctx_t *c = ctx;
+  void *p = realloc(ptr, new_size);
+  if (p) c->live_bytes = c->live_bytes - old_size + new_size;
+  return p;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+  counting_ctx_t *c = ctx;
+  if (!ptr) return;
+  c->live_bytes -= size;
+  c->frees ++;
+  free(ptr);
+}
+
+static ds_allocator_t counting_allocator(counting_ctx_t *ctx) {
+  ds_allocator_t a = { counting_alloc, counting_realloc, counting_free, ctx };
+  return a;
+}
+
+/* Owner-thread allocator: a counting allocator that flags calls made from
+ * any thread other than the one that created it. */
+typedef struct {
+  counting_ctx_t count;
+  pthread_t owner;
+  bool foreign;
+} owner_ctx_t;
+
+static void owner_check(owner_ctx_t *c) {
+  if (!pthread_equal(pthread_self(), c->owner)) c->foreign = true;
+}
+
+static void *owner_alloc(void *ctx, size_t size) {
+  owner_check(ctx);
+  return counting_alloc(&((owner_ctx_t *)ctx)->count, size);
+}
+
+static void *owner_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  owner_check(ctx);
+  return counting_realloc(&((owner_ctx_t *)ctx)->count, ptr, old_size, new_size);
+}
+
+static void owner_free(void *ctx, void *ptr, size_t size) {
+  owner_check(ctx);
+  counting_free(&((owner_ctx_t *)ctx)->count, ptr, size);
+}
+
 /* ===================== Tests ===================== */
 
 TEST_FUNC(test_vector_create_destroy_basic) {
@@ -320,8 +385,298 @@ TEST_FUNC(test_vector_bulk_growth_and_integrity) {
   ds_vector_destroy(v, counted_free);
 }
 
+TEST_FUNC(test_vector_custom_allocator) {
+  counting_ctx_t ctx = {0};
+  ds_allocator_t a = counting_allocator(&ctx);
+
+  ds_vector_t *vec = ds_vector_create_ex(2, &a);
+  ASSERT_NOT_NULL(vec, "create_ex with custom allocator returns non-NULL");
+  ASSERT(ctx.allocs >= 2, "struct and storage come from the custom allocator");
+
+  for (int i = 0; i < 100; ++ i) ds_vector_push_back(vec, mk_int(i));
+  ASSERT_EQ(ds_vector_size(vec), 100, "growth works through allocator realloc");
+  ASSERT_EQ(*(int *)ds_vector_get(vec, 99), 99, "data intact after growth");
+
+  ds_vector_destroy(vec, free);
+  ASSERT_EQ(ctx.live_bytes, 0, "every byte returned with the size it was allocated with");
+  ASSERT_EQ(ctx.allocs, ctx.frees, "alloc/free calls balanced");
+
+  ds_allocator_t broken = { NULL, NULL, counting_free, &ctx };
+  ASSERT_NULL(ds_vector_create_ex(0, &broken), "allocator without alloc is rejected");
+
+  vec = ds_vector_create_ex(0, NULL);
+  ASSERT_NOT_NULL(vec, "NULL allocator selects the default one");
+  ds_vector_destroy(vec, NULL);
+}
+
+TEST_FUNC(test_vector_growth_policy_and_shrink) {
+  ds_vector_t *vec = ds_vector_create(4);
+
+  ds_growth_policy_t bad = *ds_growth_policy_default();
+  bad.growth_factor = 1.0;
+  ASSERT_EQ(ds_vector_set_growth_policy(vec, &bad), DS_ERR_ARG, "growth_factor <= 1 rejected");
+  bad = *ds_growth_policy_default();
+  bad.shrink_ratio = 0.5;
+  ASSERT_EQ(ds_vector_set_growth_policy(vec, &bad), DS_ERR_ARG, "shrink_ratio >= 0.5 rejected");
+  ASSERT_EQ(ds_vector_set_growth_policy(NULL, NULL), DS_ERR_NULL, "set_growth_policy(NULL) -> DS_ERR_NULL");
+
+  // Bounded linear growth
+  ds_growth_policy_t p = { 2.0, 8, 0.0, 4 };
+  ASSERT_EQ(ds_vector_set_growth_policy(vec, &p), DS_OK, "policy accepted");
+  for (int i = 0; i < 5; ++ i) ds_vector_push_back(vec, mk_int(i));
+  ASSERT_EQ(ds_vector_capacity(vec), 8, "4 -> 8 (step within max_step)");
+  for (int i = 5; i < 9; ++ i) ds_vector_push_back(vec, mk_int(i));
+  ASSERT_EQ(ds_vector_capacity(vec), 16, "8 -> 16");
+  for (int i = 9; i < 17; ++ i) ds_vector_push_back(vec, mk_int(i));
+  ASSERT_EQ(ds_vector_capacity(vec), 24, "16 -> 24 (step capped at max_step)");
+
+  // Automatic shrink with hysteresis
+  p.max_step = 0;
+  p.shrink_ratio = 0.25;
+  ds_vector_set_growth_policy(vec, &p);
+  for (int i = 17; i < 200; ++ i) ds_vector_push_back(vec, mk_int(i));
+  size_t peak = ds_vector_capacity(vec);
+  ASSERT(peak >= 200, "grew past 200");
+  ds_vector_remove_range(vec, 20, 180, free);
+  ASSERT(ds_vector_capacity(vec) < peak, "capacity given back after a large removal");
+  ASSERT_EQ(ds_vector_capacity(vec), 40, "shrunk to twice the size");
+  free(ds_vector_pop_back(vec));
+  ASSERT_EQ(ds_vector_capacity(vec), 40, "no resize right after a shrink (hysteresis)");
+  int ok = 1;
+  for (int i = 0; i < 19; ++ i) if (int_val(ds_vector_get(vec, i)) != i) ok = 0;
+  ASSERT(ok, "elements intact after shrink");
+  ds_vector_clear(vec, free);
+  ASSERT_EQ(ds_vector_capacity(vec), 4, "clear shrinks down to min_capacity");
+
+  // Explicit shrink
+  ds_vector_set_growth_policy(vec, NULL);
+  for (int i = 0; i < 100; ++ i) ds_vector_push_back(vec, mk_int(i));
+  ds_vector_remove_range(vec, 10, 90, free);
+  ASSERT(ds_vector_capacity(vec) > 10, "default policy never shrinks by itself");
+  ASSERT_EQ(ds_vector_shrink_to_fit(vec), DS_OK, "shrink_to_fit ok");
+  ASSERT_EQ(ds_vector_capacity(vec), 10, "capacity == size after shrink_to_fit");
+  ASSERT_EQ(int_val(ds_vector_get(vec, 9)), 9, "data intact after shrink_to_fit");
+  ds_vector_push_back(vec, mk_int(10));
+  ASSERT_EQ(ds_vector_size(vec), 11, "vector still grows after shrink_to_fit");
+
+  ds_vector_destroy(vec, free);
+}
+
 /* ===================== main ===================== */
 
+TEST_FUNC(test_vector_range_ops) {
+  ds_vector_t *vec = ds_vector_create(2);
+  void *batch[100];
+  for (int i = 0; i < 100; ++ i) batch[i] = mk_int(i);
+
+  ASSERT_EQ(ds_vector_append_range(NULL, batch, 1), DS_ERR_NULL, "append_range(NULL) -> DS_ERR_NULL");
+  ASSERT_EQ(ds_vector_append_range(vec, NULL, 3), DS_ERR_ARG, "append_range(elements NULL) -> DS_ERR_ARG");
+  ASSERT_EQ(ds_vector_append_range(vec, NULL, 0), DS_OK, "append_range of zero is a no-op");
+
+  // Append the even half, then insert the odd half one block at a time
+  void *evens[50], *odds[50];
+  for (int i = 0; i < 50; ++ i) { evens[i] = batch[2 * i]; odds[i] = batch[2 * i + 1]; }
+  ASSERT_EQ(ds_vector_append_range(vec, evens, 50), DS_OK, "append_range ok");
+  ASSERT_EQ(ds_vector_size(vec), 50, "size after append_range");
+  ASSERT(ds_vector_capacity(vec) >= 50, "capacity grown for batch");
+
+  ASSERT_EQ(ds_vector_insert_range(vec, 51, odds, 1), DS_ERR_BOUNDS, "insert_range past size -> DS_ERR_BOUNDS");
+  void *with_null[2] = { odds[0], NULL };
+  ASSERT_EQ(ds_vector_insert_range(vec, 0, with_null, 2), DS_ERR_ARG, "NULL inside batch -> DS_ERR_ARG");
+  ASSERT_EQ(ds_vector_size(vec), 50, "rejected batch leaves vector unchanged");
+
+  ASSERT_EQ(ds_vector_insert_range(vec, 25, odds, 50), DS_OK, "insert_range in the middle");
+  ASSERT_EQ(ds_vector_size(vec), 100, "size after insert_range");
+  int ok = 1;
+  for (int i = 0; i < 25; ++ i) if (int_val(ds_vector_get(vec, i)) != 2 * i) ok = 0;
+  for (int i = 0; i < 50; ++ i) if (int_val(ds_vector_get(vec, 25 + i)) != 2 * i + 1) ok = 0;
+  for (int i = 25; i < 50; ++ i) if (int_val(ds_vector_get(vec, 50 + i)) != 2 * i) ok = 0;
+  ASSERT(ok, "batch inserted in order and tail shifted once");
+
+  g_free_count = 0;
+  ASSERT_EQ(ds_vector_remove_range(vec, 90, 11, counted_free), DS_ERR_BOUNDS, "remove_range past end -> DS_ERR_BOUNDS");
+  ASSERT_EQ(ds_vector_remove_range(vec, 25, 50, counted_free), DS_OK, "remove_range ok");
+  ASSERT_EQ(g_free_count, 50, "remove_range frees every removed element");
+  ASSERT_EQ(ds_vector_size(vec), 50, "size after remove_range");
+  ok = 1;
+  for (int i = 0; i < 50; ++ i) if (int_val(ds_vector_get(vec, i)) != 2 * i) ok = 0;
+  ASSERT(ok, "remaining elements closed the gap");
+  ASSERT_EQ(ds_vector_remove_range(vec, 50, 0, NULL), DS_OK, "empty range at end is a no-op");
+
+  ds_vector_destroy(vec, free);
+}
+
+TEST_FUNC(test_vector_find_count_identity) {
+  ds_vector_t *vec = ds_vector_create(0);
+  int *a = mk_int(1), *b = mk_int(1);
+  for (int i = 0; i < 70; ++ i) ds_vector_push_back(vec, i % 7 == 6 ? b : a);
+
+  ASSERT_EQ(ds_vector_find(vec, b), 6u, "find by pointer identity");
+  ASSERT_EQ(ds_vector_count(vec, b), 10u, "count by pointer identity");
+  ASSERT_EQ(ds_vector_count(vec, a), 60u, "equal values, different pointers");
+  int c = 1;
+  ASSERT_EQ(ds_vector_find(vec, &c), SIZE_MAX, "equal value is not a match");
+  ASSERT_EQ(ds_vector_find(NULL, a), SIZE_MAX, "find(NULL) -> SIZE_MAX");
+
+  ds_vector_destroy(vec, NULL);
+  free(a);
+  free(b);
+}
+
+TEST_FUNC(test_vector_data_and_span) {
+  ASSERT_NULL(ds_vector_data(NULL), "data(NULL) -> NULL");
+  ASSERT(ds_span_is_empty(ds_vector_as_span(NULL)), "as_span(NULL) is empty");
+
+  ds_vector_t *vec = ds_vector_create(0);
+  ASSERT(ds_span_is_empty(ds_vector_as_span(vec)), "empty vector -> empty span");
+  for (int i = 0; i < 10; ++ i) ds_vector_push_back(vec, mk_int(i));
+
+  void **items = ds_vector_data(vec);
+  ASSERT_NOT_NULL(items, "data non-NULL");
+  int ok = 1;
+  for (int i = 0; i < 10; ++ i) if (items[i] != ds_vector_get(vec, i)) ok = 0;
+  ASSERT(ok, "data matches get()");
+
+  ds_span_t span = ds_vector_as_span(vec);
+  ASSERT(span.data == (void *)items && span.size == 10, "span over the storage");
+  ASSERT_EQ(ds_span_bytes(span), 10 * sizeof(void *), "span bytes");
+
+  // Writes through the span are visible to the vector
+  void *tmp = items[0];
+  ((void **)span.data)[0] = items[9];
+  items[9] = tmp;
+  ASSERT_EQ(int_val(ds_vector_get(vec, 0)), 9, "write through span");
+
+  ds_vector_destroy(vec, free);
+}
+
+TEST_FUNC(test_vector_inline_fast_paths) {
+  ds_vector_t *vec = ds_vector_create(4);
+
+  // Pushes beyond the capacity fall back to the checked path
+  for (int i = 0; i < 20; ++ i) ASSERT_EQ(ds_vector_push_back_fast(vec, mk_int(i)), DS_OK, "push_back_fast");
+  ASSERT_EQ(ds_vector_size(vec), 20u, "size after push_back_fast");
+
+  int ok = 1;
+  for (size_t i = 0; i < 20; ++ i) {
+    if (ds_vector_get_unsafe(vec, i) != ds_vector_get(vec, i)) ok = 0;
+  }
+  ASSERT(ok, "get_unsafe matches get");
+
+  void *first = ds_vector_get_unsafe(vec, 0);
+  ds_vector_set_unsafe(vec, 0, ds_vector_get_unsafe(vec, 19));
+  ds_vector_set_unsafe(vec, 19, first);
+  ASSERT_EQ(int_val(ds_vector_get(vec, 0)), 19, "set_unsafe");
+
+  int *last = ds_vector_pop_back_unsafe(vec);
+  ASSERT_EQ(*last, 0, "pop_back_unsafe");
+  ASSERT_EQ(ds_vector_size(vec), 19u, "size after pop_back_unsafe");
+  free(last);
+
+  ds_vector_destroy(vec, free);
+}
+
+static int cmp_int_ptr(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static bool vector_is_sorted(const ds_vector_t *vec) {
+  for (size_t i = 1; i < ds_vector_size(vec); ++ i) {
+    if (cmp_int_ptr(ds_vector_get(vec, i - 1), ds_vector_get(vec, i)) > 0) return false;
+  }
+  return true;
+}
+
+TEST_FUNC(test_vector_sort) {
+  ds_vector_t *vec = ds_vector_create(0);
+  ASSERT_EQ(ds_vector_sort(NULL, cmp_int_ptr), DS_ERR_NULL, "sort(NULL) -> DS_ERR_NULL");
+  ASSERT_EQ(ds_vector_sort(vec, cmp_int_ptr), DS_OK, "sort empty vector");
+
+  unsigned seed = 1;
+  for (int i = 0; i < 3000; ++ i) {
+    seed = seed * 1103515245u + 12345u;
+    ds_vector_push_back(vec, mk_int((int)(seed >> 16) % 500));
+  }
+  ASSERT_EQ(ds_vector_sort(vec, cmp_int_ptr), DS_OK, "sort ok");
+  ASSERT_EQ(ds_vector_size(vec), 3000u, "size unchanged");
+  ASSERT(vector_is_sorted(vec), "sorted by compare, duplicates included");
+
+  // Without a comparison, elements end up in address order
+  ASSERT_EQ(ds_vector_sort(vec, NULL), DS_OK, "sort by address");
+  bool ok = true;
+  for (size_t i = 1; i < ds_vector_size(vec); ++ i) {
+    if ((uintptr_t)ds_vector_get(vec, i - 1) > (uintptr_t)ds_vector_get(vec, i)) ok = false;
+  }
+  ASSERT(ok, "address order");
+
+  ds_vector_destroy(vec, free);
+}
+
+static _Atomic long g_visit_sum;
+
+static void visit_sum(void *p) {
+  g_visit_sum += *(int *)p;
+}
+
+static void visit_nothing(void *p) {
+  (void)p;
+}
+
+TEST_FUNC(test_vector_parallel_sort_for_each) {
+  ds_vector_t *vec = ds_vector_create(0);
+  ds_vector_t *ref = ds_vector_create(0);
+
+  // Large enough to be split into several runs
+  unsigned seed = 3;
+  long sum = 0;
+  for (int i = 0; i < 100000; ++ i) {
+    seed = seed * 1103515245u + 12345u;
+    int *v = mk_int((int)(seed >> 12) % 20000);
+    sum += *v;
+    ds_vector_push_back(vec, v);
+    ds_vector_push_back(ref, v);
+  }
+
+  ASSERT_EQ(ds_vector_parallel_sort(NULL, cmp_int_ptr, 4), DS_ERR_NULL, "parallel_sort(NULL) -> DS_ERR_NULL");
+  ASSERT_EQ(ds_vector_parallel_sort(vec, cmp_int_ptr, 4), DS_OK, "parallel_sort ok");
+  ASSERT(vector_is_sorted(vec), "parallel sort is sorted");
+  ASSERT_EQ(ds_vector_size(vec), 100000u, "size unchanged");
+
+  // Same multiset of pointers as a sequential sort by address
+  ASSERT_EQ(ds_vector_parallel_sort(vec, NULL, 3), DS_OK, "parallel sort by address");
+  ASSERT_EQ(ds_vector_sort(ref, NULL), DS_OK, "sequential sort by address");
+  bool same = true;
+  for (size_t i = 0; i < ds_vector_size(vec); ++ i) {
+    if (ds_vector_get(vec, i) != ds_vector_get(ref, i)) same = false;
+  }
+  ASSERT(same, "parallel and sequential results match");
+
+  ASSERT_EQ(ds_vector_parallel_sort(vec, cmp_int_ptr, 1), DS_OK, "nthreads = 1 sorts sequentially");
+  ASSERT(vector_is_sorted(vec), "sequential fallback sorted");
+
+  g_visit_sum = 0;
+  ASSERT_EQ(ds_vector_parallel_for_each(vec, visit_sum, 4), DS_OK, "parallel_for_each ok");
+  ASSERT_EQ(g_visit_sum, sum, "every element visited once");
+  ASSERT_EQ(ds_vector_parallel_for_each(vec, NULL, 4), DS_ERR_ARG, "NULL visit -> DS_ERR_ARG");
+  ASSERT_EQ(ds_vector_parallel_for_each(NULL, visit_sum, 4), DS_ERR_NULL, "NULL vector -> DS_ERR_NULL");
+
+  ds_vector_destroy(ref, NULL);
+  ds_vector_destroy(vec, free);
+
+  // The vector's allocator is never called from a worker
+  owner_ctx_t octx = { {0, 0, 0}, pthread_self(), false };
+  ds_allocator_t oa = { owner_alloc, owner_realloc, owner_free, &octx };
+  ds_vector_t *ov = ds_vector_create_ex(0, &oa);
+  for (int i = 0; i < 50000; ++ i) ds_vector_push_back(ov, (void *)(uintptr_t)(50000 - i));
+  ASSERT_EQ(ds_vector_parallel_sort(ov, NULL, 4), DS_OK, "parallel_sort with custom allocator");
+  ASSERT_EQ(ds_vector_get(ov, 0), (void *)(uintptr_t)1, "custom allocator vector sorted");
+  ASSERT_EQ(ds_vector_parallel_for_each(ov, visit_nothing, 4), DS_OK, "parallel_for_each with custom allocator");
+  ds_vector_destroy(ov, NULL);
+  ASSERT(!octx.foreign, "vector allocator only used on the calling thread");
+  ASSERT_EQ(octx.count.live_bytes, 0u, "custom allocator balanced");
+}
+
 int main() {
   test_case_t tests[] = {
     {"vector_create_destroy_basic", test_vector_create_destroy_basic},
@@ -334,6 +689,14 @@ int main() {
     {"vector_remove_and_shift", test_vector_remove_and_shift},
     {"vector_clear_frees_all_and_keeps_capacity", test_vector_clear_frees_all_and_keeps_capacity},
     {"vector_bulk_growth_and_integrity", test_vector_bulk_growth_and_integrity},
+    {"vector_custom_allocator", test_vector_custom_allocator},
+    {"vector_range_ops", test_vector_range_ops},
+    {"vector_growth_policy_and_shrink", test_vector_growth_policy_and_shrink},
+    {"vector_find_count_identity", test_vector_find_count_identity},
+    {"vector_data_and_span", test_vector_data_and_span},
+    {"vector_inline_fast_paths", test_vector_inline_fast_paths},
+    {"vector_sort", test_vector_sort},
+    {"vector_parallel_sort_for_each", test_vector_parallel_sort_for_each},
   };
 
   return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
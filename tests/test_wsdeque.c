@@ -0,0 +1,190 @@
+/*
+** tests/test.c -- A simple test framework.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sched.h>
+
+#include "ds_common.h"
+#include "ds_wsdeque.h"
+
+/* ------------ Colored output ------------ */
+#define COLOR_GREEN "\033[32m"
+#define COLOR_RED   "\033[31m"
+#define COLOR_RESET "\033[0m"
+
+/* ------------ Test statistics ------------ */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* ------------ Test macros ------------ */
+#define ASSERT(cond, msg) \
+  do { \
+    if (cond) { \
+      printf(COLOR_GREEN "[PASS] %s" COLOR_RESET "\n", msg); \
+      tests_passed++; \
+    } else { \
+      printf(COLOR_RED "[FAIL] %s (%s:%d)" COLOR_RESET "\n", msg, __FILE__, __LINE__); \
+      tests_failed++; \
+    } \
+  } while (0)
+
+#define ASSERT_EQ(a, b, msg)     ASSERT((a) == (b), msg)
+#define ASSERT_NE(a, b, msg)     ASSERT((a) != (b), msg)
+#define ASSERT_NULL(p, msg)      ASSERT((p) == NULL, msg)
+#define ASSERT_NOT_NULL(p, msg)  ASSERT((p) != NULL, msg)
+
+#define TEST_FUNC(name) void name()
+
+/* --------- Test function --------- */
+typedef void(*test_fn_t)(void);
+
+typedef struct {
+  const char *name;
+  test_fn_t func;
+} test_case_t;
+
+static int run_tests(const test_case_t *tests, size_t num_tests) {
+  for (size_t i = 0; i < num_tests; ++ i) {
+    printf("Running test: %s\n", tests[i].name);
+    tests[i].func();
+  }
+  printf("\nTotal tests passed: %d, failed: %d\n", tests_passed, tests_failed);
+  return tests_failed > 0 ? 1 : 0;
+}
+
+
+/* ===================== Helpers ===================== */
+
+static int *mk_int(int v) {
+  int *p = (int *)malloc(sizeof(int));
+  if (!p) return NULL;
+  *p = v;
+  return p;
+}
+
+static int g_free_count = 0;
+
+static void counted_free(void *p) {
+  if (p) g_free_count++;
+  free(p);
+}
+
+/* Values are encoded in the pointer itself so threads never allocate. */
+#define TAG(v)   ((void *)(uintptr_t)((v) + 1))
+#define UNTAG(p) ((size_t)(uintptr_t)(p) - 1)
+
+#define STEAL_THIEVES 3
+#define STEAL_ITEMS   100000
+
+typedef struct {
+  ds_wsdeque_t *deque;
+  unsigned char *seen;
+  atomic_size_t *taken;
+  atomic_bool *done;
+} steal_arg_t;
+
+static void *thief_main(void *p) {
+  steal_arg_t *a = p;
+  for (;;) {
+    void *v = ds_wsdeque_steal(a->deque);
+    if (v) {
+      a->seen[UNTAG(v)] ++;
+      atomic_fetch_add(a->taken, 1);
+    } else if (atomic_load(a->done)) {
+      break;
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/* ===================== Tests ===================== */
+
+TEST_FUNC(test_wsdeque_owner_ops) {
+  ds_wsdeque_t *deque = ds_wsdeque_create(2);
+  ASSERT_NOT_NULL(deque, "create returns non-NULL");
+  ASSERT_NULL(ds_wsdeque_pop(deque), "pop on empty -> NULL");
+  ASSERT_NULL(ds_wsdeque_steal(deque), "steal on empty -> NULL");
+  ASSERT_EQ(ds_wsdeque_push(deque, NULL), DS_ERR_ARG, "push(NULL element) -> DS_ERR_ARG");
+  ASSERT_EQ(ds_wsdeque_push(NULL, deque), DS_ERR_NULL, "push(NULL deque) -> DS_ERR_NULL");
+
+  // Push past the initial capacity to force several grows
+  int ok = 1;
+  for (int i = 0; i < 100; ++ i) {
+    if (ds_wsdeque_push(deque, mk_int(i)) != DS_OK) ok = 0;
+  }
+  ASSERT(ok, "push grows the buffer");
+  ASSERT_EQ(ds_wsdeque_size(deque), 100, "size after pushes");
+
+  int *v = ds_wsdeque_pop(deque);
+  ASSERT(v && *v == 99, "pop returns the newest element (LIFO)");
+  free(v);
+  v = ds_wsdeque_steal(deque);
+  ASSERT(v && *v == 0, "steal returns the oldest element (FIFO)");
+  free(v);
+  v = ds_wsdeque_steal(deque);
+  ASSERT(v && *v == 1, "second steal returns the next oldest");
+  free(v);
+  ASSERT_EQ(ds_wsdeque_size(deque), 97, "size after pop and steals");
+
+  g_free_count = 0;
+  ds_wsdeque_destroy(deque, counted_free);
+  ASSERT_EQ(g_free_count, 97, "destroy frees queued elements");
+}
+
+TEST_FUNC(test_wsdeque_concurrent_steal) {
+  ds_wsdeque_t *deque = ds_wsdeque_create(16);
+  unsigned char *seen = calloc(STEAL_ITEMS, 1);
+  atomic_size_t taken;
+  atomic_bool done;
+  atomic_init(&taken, 0);
+  atomic_init(&done, false);
+
+  steal_arg_t arg = { deque, seen, &taken, &done };
+  pthread_t thieves[STEAL_THIEVES];
+  for (int i = 0; i < STEAL_THIEVES; ++ i) pthread_create(&thieves[i], NULL, thief_main, &arg);
+
+  // The owner interleaves pushes with pops while the thieves steal
+  unsigned char *owner_seen = calloc(STEAL_ITEMS, 1);
+  for (size_t i = 0; i < STEAL_ITEMS; ++ i) {
+    ds_wsdeque_push(deque, TAG(i));
+    if (i % 3 == 0) {
+      void *v = ds_wsdeque_pop(deque);
+      if (v) owner_seen[UNTAG(v)] ++;
+    }
+  }
+  void *v;
+  while ((v = ds_wsdeque_pop(deque)) != NULL) owner_seen[UNTAG(v)] ++;
+
+  atomic_store(&done, true);
+  for (int i = 0; i < STEAL_THIEVES; ++ i) pthread_join(thieves[i], NULL);
+
+  int ok = 1;
+  for (size_t i = 0; i < STEAL_ITEMS; ++ i) {
+    if (seen[i] + owner_seen[i] != 1) { ok = 0; break; }
+  }
+  ASSERT(ok, "every element taken exactly once by the owner or a thief");
+  ASSERT_EQ(ds_wsdeque_size(deque), 0, "deque drained");
+
+  free(seen);
+  free(owner_seen);
+  ds_wsdeque_destroy(deque, NULL);
+}
+
+/* ===================== main ===================== */
+
+int main() {
+  test_case_t tests[] = {
+    {"wsdeque_owner_ops", test_wsdeque_owner_ops},
+    {"wsdeque_concurrent_steal", test_wsdeque_concurrent_steal},
+  };
+
+  return run_tests(tests, sizeof(tests)/sizeof(tests[0]));
+}